@@ -0,0 +1,127 @@
+/*
+ * Shared helpers for the CBLAS Level 2 benchmarks.
+ *
+ * Everything is static inline so each bench_*.c stays a single translation
+ * unit, the same way the test_*.c programs are built.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+/* Minimum wall time spent measuring one point, seconds. */
+#define BENCH_MIN_TIME 0.2
+/* Batches shorter than this are too noisy for clock_gettime. */
+#define BENCH_MIN_BATCH 1e-3
+
+typedef void (*bench_fn)(void *arg);
+
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static inline long bench_env_long(const char *name, long def) {
+    const char *s = getenv(name);
+    if (!s || !*s) return def;
+    return strtol(s, NULL, 10);
+}
+
+/* 64-byte aligned, zero-initialised buffer (touches every page once). */
+static inline void *bench_alloc(size_t bytes) {
+    size_t rounded = (bytes + 63) & ~(size_t)63;
+    void *p;
+    if (rounded == 0) rounded = 64;
+#ifdef _WIN32
+    p = _aligned_malloc(rounded, 64);
+#else
+    p = aligned_alloc(64, rounded);
+#endif
+    if (p) memset(p, 0, rounded);
+    return p;
+}
+
+static inline void bench_free(void *p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+/* Deterministic values in [-1, 1) so results never overflow or denormalise. */
+static inline void bench_fill_s(float *p, size_t n, unsigned seed) {
+    unsigned s = seed * 2654435761u + 1u;
+    for (size_t i = 0; i < n; i++) {
+        s = s * 1664525u + 1013904223u;
+        p[i] = (float)((int)(s >> 8) - (1 << 23)) / (float)(1 << 23);
+    }
+}
+
+static inline void bench_fill_d(double *p, size_t n, unsigned seed) {
+    unsigned s = seed * 2654435761u + 1u;
+    for (size_t i = 0; i < n; i++) {
+        s = s * 1664525u + 1013904223u;
+        p[i] = (double)((int)(s >> 8) - (1 << 23)) / (double)(1 << 23);
+    }
+}
+
+/*
+ * Returns the best observed seconds per call of fn(arg).  Calls are grouped
+ * into batches of at least BENCH_MIN_BATCH and batches are repeated until
+ * BENCH_MIN_TIME has elapsed; the fastest batch wins.
+ */
+static inline double bench_run(bench_fn fn, void *arg) {
+    double t0, t1, single, best, start;
+    long inner;
+
+    t0 = bench_now();
+    fn(arg);                                  /* warm-up, also faults pages */
+    t1 = bench_now();
+    single = t1 - t0;
+
+    inner = single > 0.0 ? (long)(BENCH_MIN_BATCH / single) + 1 : 1000;
+    if (inner < 1) inner = 1;
+
+    best = 1e300;
+    start = bench_now();
+    do {
+        t0 = bench_now();
+        for (long r = 0; r < inner; r++) fn(arg);
+        t1 = bench_now();
+        if ((t1 - t0) / (double)inner < best) best = (t1 - t0) / (double)inner;
+    } while (t1 - start < BENCH_MIN_TIME);
+
+    return best;
+}
+
+
+/*
+ * Built into the l2test runner the Makefile defines L2T_BENCH as the
+ * benchmark's name; main() is then renamed and registered under it, so
+ * `./l2test --bench bench_gemv 16 4096` runs it with those arguments.
+ */
+#ifdef L2T_BENCH
+#include "l2test.h"
+
+#define BENCH_CAT_(a, b) a##b
+#define BENCH_CAT(a, b) BENCH_CAT_(a, b)
+#define BENCH_STR_(a) #a
+#define BENCH_STR(a) BENCH_STR_(a)
+
+#define main BENCH_CAT(L2T_BENCH, _main)
+int main(int argc, char **argv);
+
+__attribute__((constructor)) static void bench_register(void) {
+    l2t_register_bench(BENCH_STR(L2T_BENCH), main);
+}
+#endif
+
+#endif /* BENCH_H */
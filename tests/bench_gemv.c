@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+#include "bench.h"
+
+/*
+ * Throughput sweep for cblas_?gemv.
+ *
+ * Usage: bench_gemv [min_size [max_size [precisions]]]
+ *   min_size, max_size  M and N sweep over powers of two (default 16..16384)
+ *   precisions          any of "sdcz" (default all four)
+ *
+ * By default only square M=N points are run; BENCH_GRID=1 sweeps every
+ * (M, N) pair to expose tall/skinny and short/wide behaviour.
+ * Points whose matrix would exceed BENCH_MEM_MB (default 3072) are skipped.
+ * GB/s counts A and x once and y twice (read + write, since beta != 0).
+ */
+
+typedef struct {
+    char prec;
+    enum CBLAS_ORDER order;
+    enum CBLAS_TRANSPOSE trans;
+    int m, n, lda;
+    void *A, *x, *y;
+} gemv_args;
+
+static const float  s_alpha = 1.0f,  s_beta = 0.5f;
+static const double d_alpha = 1.0,   d_beta = 0.5;
+static const float  c_alpha[2] = {1.0f, 0.0f}, c_beta[2] = {0.5f, 0.0f};
+static const double z_alpha[2] = {1.0, 0.0},   z_beta[2] = {0.5, 0.0};
+
+static void call_gemv(void *p) {
+    gemv_args *a = p;
+    switch (a->prec) {
+    case 's':
+        cblas_sgemv(a->order, a->trans, a->m, a->n, s_alpha, a->A, a->lda,
+                    a->x, 1, s_beta, a->y, 1);
+        break;
+    case 'd':
+        cblas_dgemv(a->order, a->trans, a->m, a->n, d_alpha, a->A, a->lda,
+                    a->x, 1, d_beta, a->y, 1);
+        break;
+    case 'c':
+        cblas_cgemv(a->order, a->trans, a->m, a->n, c_alpha, a->A, a->lda,
+                    a->x, 1, c_beta, a->y, 1);
+        break;
+    case 'z':
+        cblas_zgemv(a->order, a->trans, a->m, a->n, z_alpha, a->A, a->lda,
+                    a->x, 1, z_beta, a->y, 1);
+        break;
+    }
+}
+
+static size_t elem_size(char prec) {
+    switch (prec) {
+    case 's': return sizeof(float);
+    case 'd': return sizeof(double);
+    case 'c': return 2 * sizeof(float);
+    default:  return 2 * sizeof(double);
+    }
+}
+
+static void fill(char prec, void *p, size_t count, unsigned seed) {
+    if (prec == 's' || prec == 'c')
+        bench_fill_s(p, count * (prec == 'c' ? 2 : 1), seed);
+    else
+        bench_fill_d(p, count * (prec == 'z' ? 2 : 1), seed);
+}
+
+static void bench_point(char prec, int m, int n, size_t mem_limit) {
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const enum CBLAS_TRANSPOSE transes[3] =
+        {CblasNoTrans, CblasTrans, CblasConjTrans};
+    static const char *order_name[2] = {"Row", "Col"};
+    static const char *trans_name[3] = {"N", "T", "C"};
+
+    size_t es = elem_size(prec);
+    size_t a_bytes = (size_t)m * (size_t)n * es;
+    size_t v_len = (size_t)(m > n ? m : n);
+    gemv_args a;
+
+    if (a_bytes > mem_limit) {
+        printf("%-4c %-3s %-2s %6d %6d   skipped (A needs %zu MB)\n",
+               prec, "-", "-", m, n, a_bytes >> 20);
+        return;
+    }
+
+    a.prec = prec;
+    a.m = m;
+    a.n = n;
+    a.A = bench_alloc(a_bytes);
+    a.x = bench_alloc(v_len * es);
+    a.y = bench_alloc(v_len * es);
+    if (!a.A || !a.x || !a.y) {
+        printf("%-4c %-3s %-2s %6d %6d   skipped (allocation failed)\n",
+               prec, "-", "-", m, n);
+        bench_free(a.A); bench_free(a.x); bench_free(a.y);
+        return;
+    }
+    fill(prec, a.A, (size_t)m * (size_t)n, 1);
+    fill(prec, a.x, v_len, 2);
+    fill(prec, a.y, v_len, 3);
+
+    for (int o = 0; o < 2; o++) {
+        for (int t = 0; t < 3; t++) {
+            int lenx = transes[t] == CblasNoTrans ? n : m;
+            int leny = transes[t] == CblasNoTrans ? m : n;
+            double flops = (prec == 's' || prec == 'd' ? 2.0 : 8.0) *
+                           (double)m * (double)n;
+            double bytes = (double)a_bytes +
+                           (double)es * ((double)lenx + 2.0 * (double)leny);
+            double sec;
+
+            a.order = orders[o];
+            a.trans = transes[t];
+            a.lda = orders[o] == CblasRowMajor ? n : m;
+
+            sec = bench_run(call_gemv, &a);
+            printf("%-4c %-3s %-2s %6d %6d %12.2f %10.3f %10.3f\n",
+                   prec, order_name[o], trans_name[t], m, n,
+                   sec * 1e6, flops / sec * 1e-9, bytes / sec * 1e-9);
+            fflush(stdout);
+        }
+    }
+
+    bench_free(a.A);
+    bench_free(a.x);
+    bench_free(a.y);
+}
+
+int main(int argc, char **argv) {
+    int min_size = argc > 1 ? atoi(argv[1]) : 16;
+    int max_size = argc > 2 ? atoi(argv[2]) : 16384;
+    const char *precs = argc > 3 ? argv[3] : "sdcz";
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+    int grid = (int)bench_env_long("BENCH_GRID", 0);
+
+    if (min_size < 1) min_size = 1;
+
+    printf("=== cblas_?gemv throughput benchmark ===\n");
+    printf("core: %s, threads: %d, sizes: %d..%d\n\n",
+           openblas_get_corename(), openblas_get_num_threads(),
+           min_size, max_size);
+    printf("%-4s %-3s %-2s %6s %6s %12s %10s %10s\n", "prec", "ord", "tr",
+           "M", "N", "time(us)", "GFLOP/s", "GB/s");
+
+    for (const char *p = precs; *p; p++) {
+        for (int m = min_size; m <= max_size; m *= 2) {
+            if (!grid) {
+                bench_point(*p, m, m, mem_limit);
+                continue;
+            }
+            for (int n = min_size; n <= max_size; n *= 2)
+                bench_point(*p, m, n, mem_limit);
+        }
+        printf("\n");
+    }
+    return 0;
+}
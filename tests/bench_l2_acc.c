@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * k rank-1 updates of one N x N matrix issued one by one (OpenBLAS, and
+ * l2blas for ger) against the same k updates queued in an l2_acc and
+ * flushed once.  The loops stream A k times, the flush once, so past the
+ * caches "acc/OB" should approach k until the k FMAs per element, not
+ * memory, set the pace.
+ *
+ * Usage: bench_l2_acc [N [max_k]]   (k = 1, 2, 4, ..., max_k)
+ *
+ * Times are ms per batch of k updates; GB/s counts A read + written once
+ * per update, i.e. the traffic of the one-by-one loop.
+ */
+
+enum { OP_SGER, OP_DGER, OP_SSYR, OP_CHER, OP_ZGERU };
+
+typedef struct {
+    int op, how, n, k;          /* how: 0 OpenBLAS loop, 1 l2 loop, 2 acc */
+    void *A, *x, *y, *work;
+} acc_args;
+
+static void call_acc(void *p) {
+    static const double z_alpha[2] = {1e-4, -1e-4};
+    acc_args *a = p;
+    int n = a->n;
+    size_t es = a->op == OP_SGER || a->op == OP_SSYR ? 4
+              : a->op == OP_ZGERU ? 16 : 8;
+    l2_acc acc;
+
+    if (a->how == 2) {
+        int lwork = L2_ACC_LWORK(n, n, a->k);
+        switch (a->op) {
+        case OP_SGER:  l2_sacc_init_ge(&acc, CblasColMajor, n, n, a->A, n,
+                                       a->work, lwork); break;
+        case OP_DGER:  l2_dacc_init_ge(&acc, CblasColMajor, n, n, a->A, n,
+                                       a->work, lwork); break;
+        case OP_SSYR:  l2_sacc_init_sy(&acc, CblasColMajor, CblasLower, n,
+                                       a->A, n, a->work, lwork); break;
+        case OP_CHER:  l2_cacc_init_he(&acc, CblasColMajor, CblasLower, n,
+                                       a->A, n, a->work, lwork); break;
+        default:       l2_zacc_init_ge(&acc, CblasColMajor, n, n, a->A, n,
+                                       a->work, lwork); break;
+        }
+    }
+    for (int u = 0; u < a->k; u++) {
+        /* a different x and y per update, as a real caller would have */
+        const char *x = (const char *)a->x + (size_t)u * n * es;
+        const char *y = (const char *)a->y + (size_t)u * n * es;
+        switch (a->op * 3 + a->how) {
+        case OP_SGER * 3 + 0:
+            cblas_sger(CblasColMajor, n, n, 1e-4f, (const float *)x, 1,
+                       (const float *)y, 1, a->A, n); break;
+        case OP_SGER * 3 + 1:
+            l2_sger(CblasColMajor, n, n, 1e-4f, (const float *)x, 1,
+                    (const float *)y, 1, a->A, n); break;
+        case OP_SGER * 3 + 2:
+            l2_sacc_ger(&acc, 1e-4f, (const float *)x, 1,
+                        (const float *)y, 1); break;
+        case OP_DGER * 3 + 0:
+            cblas_dger(CblasColMajor, n, n, 1e-4, (const double *)x, 1,
+                       (const double *)y, 1, a->A, n); break;
+        case OP_DGER * 3 + 1:
+            l2_dger(CblasColMajor, n, n, 1e-4, (const double *)x, 1,
+                    (const double *)y, 1, a->A, n); break;
+        case OP_DGER * 3 + 2:
+            l2_dacc_ger(&acc, 1e-4, (const double *)x, 1,
+                        (const double *)y, 1); break;
+        case OP_SSYR * 3 + 0:
+            cblas_ssyr(CblasColMajor, CblasLower, n, 1e-4f,
+                       (const float *)x, 1, a->A, n); break;
+        case OP_SSYR * 3 + 2:
+            l2_sacc_syr(&acc, 1e-4f, (const float *)x, 1); break;
+        case OP_CHER * 3 + 0:
+            cblas_cher(CblasColMajor, CblasLower, n, 1e-4f, x, 1, a->A, n);
+            break;
+        case OP_CHER * 3 + 2:
+            l2_cacc_her(&acc, 1e-4f, x, 1); break;
+        case OP_ZGERU * 3 + 0:
+            cblas_zgeru(CblasColMajor, n, n, z_alpha, x, 1, y, 1, a->A, n);
+            break;
+        case OP_ZGERU * 3 + 1:
+            l2_zgeru(CblasColMajor, n, n, z_alpha, x, 1, y, 1, a->A, n);
+            break;
+        case OP_ZGERU * 3 + 2:
+            l2_zacc_geru(&acc, z_alpha, x, 1, y, 1); break;
+        }
+    }
+    if (a->how == 2) {
+        switch (a->op) {
+        case OP_SGER: case OP_SSYR: l2_sacc_flush(&acc); break;
+        case OP_DGER:               l2_dacc_flush(&acc); break;
+        case OP_CHER:               l2_cacc_flush(&acc); break;
+        default:                    l2_zacc_flush(&acc); break;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    static const char *op_name[] = {"sger", "dger", "ssyrL", "cherL",
+                                    "zgeru"};
+    static const size_t op_es[] = {4, 8, 4, 8, 16};
+    int n = argc > 1 ? atoi(argv[1]) : 4096;
+    int max_k = argc > 2 ? atoi(argv[2]) : 16;
+
+    if (n < 1) n = 1;
+    if (max_k < 1) max_k = 1;
+
+    printf("=== deferred rank-k accumulation vs one-by-one updates "
+           "(N=%d, ColMajor) ===\n", n);
+    printf("OpenBLAS core: %s, l2blas auto core: %s\n\n",
+           openblas_get_corename(), l2_get_corename());
+    printf("%-6s %4s %12s %12s %12s %10s %8s\n", "op", "k", "OpenBLAS ms",
+           "l2 loop ms", "acc ms", "acc GB/s", "acc/OB");
+
+    for (int op = 0; op < 5; op++) {
+        size_t es = op_es[op];
+        size_t a_bytes = (size_t)n * (size_t)n * es;
+        int tri = op == OP_SSYR || op == OP_CHER;
+        acc_args a;
+
+        a.op = op;
+        a.n = n;
+        a.A = bench_alloc(a_bytes);
+        a.x = bench_alloc((size_t)max_k * n * es);
+        a.y = bench_alloc((size_t)max_k * n * es);
+        a.work = bench_alloc((size_t)L2_ACC_LWORK(n, n, max_k) * es);
+        if (!a.A || !a.x || !a.y || !a.work) {
+            printf("%-6s   skipped (allocation failed)\n", op_name[op]);
+        } else {
+            if (es == 4 || op == OP_CHER) {
+                bench_fill_s(a.A, a_bytes / 4, 1);
+                bench_fill_s(a.x, (size_t)max_k * n * es / 4, 2);
+                bench_fill_s(a.y, (size_t)max_k * n * es / 4, 3);
+            } else {
+                bench_fill_d(a.A, a_bytes / 8, 1);
+                bench_fill_d(a.x, (size_t)max_k * n * es / 8, 2);
+                bench_fill_d(a.y, (size_t)max_k * n * es / 8, 3);
+            }
+            for (int k = 1; k <= max_k; k *= 2) {
+                double t[3] = {0.0, 0.0, 0.0};
+                double bytes = 2.0 * (double)a_bytes * (tri ? 0.5 : 1.0) * k;
+
+                a.k = k;
+                for (int how = 0; how < 3; how++) {
+                    if (how == 1 && tri) continue;
+                    a.how = how;
+                    t[how] = bench_run(call_acc, &a);
+                }
+                printf("%-6s %4d %12.3f", op_name[op], k, t[0] * 1e3);
+                if (tri) printf(" %12s", "-");
+                else     printf(" %12.3f", t[1] * 1e3);
+                printf(" %12.3f %10.2f %7.2fx\n", t[2] * 1e3,
+                       bytes / t[2] * 1e-9, t[0] / t[2]);
+                fflush(stdout);
+            }
+        }
+        bench_free(a.A);
+        bench_free(a.x);
+        bench_free(a.y);
+        bench_free(a.work);
+        printf("\n");
+    }
+    return 0;
+}
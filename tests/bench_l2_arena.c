@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2test.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Per-call latency of the hot-path routines on strided vectors, the case
+ * a workspace arena is for:
+ *   OpenBLAS  - cblas_?xxx
+ *   l2blas    - l2_?xxx, the scalar strided loops
+ *   arena     - l2_?xxx_arena, x and y staged to unit stride in the arena
+ * p50, p99 and max are over single timed calls; "allocs" is heap
+ * allocations per call as the runner's malloc hook counts them (n/a
+ * without glibc), which must be 0 for the arena.  The arena is set up once
+ * before any timing with the thread count in force, as a service would
+ * per worker thread.
+ *
+ * Usage: bench_l2_arena [N [inc [calls]]]   (defaults 512, 2, 2000)
+ *
+ * trsv and trmv get their x back from a copy before every call, outside
+ * the timed region, so repeated solves do not run into denormals.
+ */
+
+enum { HOW_OB, HOW_L2, HOW_ARENA, NHOWS };
+enum { R_SGEMV_N, R_DGEMV_T, R_DSYMV, R_ZHEMV, R_DTRSV, R_ZTRMV, NROUTINES };
+
+typedef struct {
+    int how, r, n, inc;
+    l2_arena *ar;
+    void *A, *x, *y, *x0;
+    size_t xbytes;
+} arena_args;
+
+static void call_routine(arena_args *a) {
+    static const double z_alpha[2] = {0.5, 0.25}, z_beta[2] = {0.5, 0.0};
+    const enum CBLAS_ORDER o = CblasColMajor;
+    int n = a->n, inc = a->inc, how = a->how;
+
+    switch (a->r) {
+    case R_SGEMV_N:
+        if (how == HOW_OB) cblas_sgemv(o, CblasNoTrans, n, n, 0.5f, a->A, n, a->x, inc, 0.5f, a->y, inc);
+        else if (how == HOW_L2) l2_sgemv(o, CblasNoTrans, n, n, 0.5f, a->A, n, a->x, inc, 0.5f, a->y, inc);
+        else l2_sgemv_arena(a->ar, o, CblasNoTrans, n, n, 0.5f, a->A, n, a->x, inc, 0.5f, a->y, inc);
+        break;
+    case R_DGEMV_T:
+        if (how == HOW_OB) cblas_dgemv(o, CblasTrans, n, n, 0.5, a->A, n, a->x, inc, 0.5, a->y, inc);
+        else if (how == HOW_L2) l2_dgemv(o, CblasTrans, n, n, 0.5, a->A, n, a->x, inc, 0.5, a->y, inc);
+        else l2_dgemv_arena(a->ar, o, CblasTrans, n, n, 0.5, a->A, n, a->x, inc, 0.5, a->y, inc);
+        break;
+    case R_DSYMV:
+        if (how == HOW_OB) cblas_dsymv(o, CblasLower, n, 0.5, a->A, n, a->x, inc, 0.5, a->y, inc);
+        else if (how == HOW_L2) l2_dsymv(o, CblasLower, n, 0.5, a->A, n, a->x, inc, 0.5, a->y, inc);
+        else l2_dsymv_arena(a->ar, o, CblasLower, n, 0.5, a->A, n, a->x, inc, 0.5, a->y, inc);
+        break;
+    case R_ZHEMV:
+        if (how == HOW_OB) cblas_zhemv(o, CblasUpper, n, z_alpha, a->A, n, a->x, inc, z_beta, a->y, inc);
+        else if (how == HOW_L2) l2_zhemv(o, CblasUpper, n, z_alpha, a->A, n, a->x, inc, z_beta, a->y, inc);
+        else l2_zhemv_arena(a->ar, o, CblasUpper, n, z_alpha, a->A, n, a->x, inc, z_beta, a->y, inc);
+        break;
+    case R_DTRSV:
+        if (how == HOW_OB) cblas_dtrsv(o, CblasLower, CblasNoTrans, CblasNonUnit, n, a->A, n, a->x, inc);
+        else if (how == HOW_L2) l2_dtrsv(o, CblasLower, CblasNoTrans, CblasNonUnit, n, a->A, n, a->x, inc);
+        else l2_dtrsv_arena(a->ar, o, CblasLower, CblasNoTrans, CblasNonUnit, n, a->A, n, a->x, inc);
+        break;
+    default:
+        if (how == HOW_OB) cblas_ztrmv(o, CblasUpper, CblasConjTrans, CblasNonUnit, n, a->A, n, a->x, inc);
+        else if (how == HOW_L2) l2_ztrmv(o, CblasUpper, CblasConjTrans, CblasNonUnit, n, a->A, n, a->x, inc);
+        else l2_ztrmv_arena(a->ar, o, CblasUpper, CblasConjTrans, CblasNonUnit, n, a->A, n, a->x, inc);
+        break;
+    }
+}
+
+/* A and x0 for routine r: entries in [-1/n, 1/n), diagonal 2, x in [-1, 1). */
+static void fill_inputs(arena_args *a, size_t abytes, size_t vbytes) {
+    int n = a->n, cs = a->r == R_ZHEMV || a->r == R_ZTRMV ? 2 : 1;
+
+    if (a->r == R_SGEMV_N) {
+        float *f = a->A;
+        bench_fill_s(f, abytes / sizeof(float), 1);
+        for (size_t i = 0; i < abytes / sizeof(float); i++) f[i] /= n;
+        for (int i = 0; i < n; i++) f[(size_t)i * (n + 1)] = 2.0f;
+        bench_fill_s(a->x0, vbytes / sizeof(float), 2);
+    } else {
+        double *d = a->A;
+        bench_fill_d(d, abytes / sizeof(double), 1);
+        for (size_t i = 0; i < abytes / sizeof(double); i++) d[i] /= n;
+        for (int i = 0; i < n; i++) d[(size_t)i * (n + 1) * cs] = 2.0;
+        bench_fill_d(a->x0, vbytes / sizeof(double), 2);
+    }
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv) {
+    static const char *r_name[NROUTINES] = {"sgemv N", "dgemv T", "dsymv L",
+                                            "zhemv U", "dtrsv LN", "ztrmv UC"};
+    static const char *how_name[NHOWS] = {"OpenBLAS", "l2blas", "arena"};
+    int n = argc > 1 ? atoi(argv[1]) : 512;
+    int inc = argc > 2 ? atoi(argv[2]) : 2;
+    int calls = argc > 3 ? atoi(argv[3]) : 2000;
+    size_t vbytes, abytes;
+    double *lat;
+    void *work;
+    l2_arena ar;
+    arena_args a;
+
+    if (n < 1) n = 1;
+    if (inc == 0) inc = 1;
+    if (calls < 10) calls = 10;
+    /* complex doubles at the widest, so every routine fits the buffers */
+    vbytes = (size_t)n * (size_t)(inc < 0 ? -inc : inc) * 2 * sizeof(double);
+    abytes = (size_t)n * (size_t)n * 2 * sizeof(double);
+    a.A = bench_alloc(abytes);
+    a.x = bench_alloc(vbytes);
+    a.y = bench_alloc(vbytes);
+    a.x0 = bench_alloc(vbytes);
+    work = bench_alloc(L2_ARENA_LWORK(n));
+    lat = malloc((size_t)calls * sizeof(double));
+    if (!a.A || !a.x || !a.y || !a.x0 || !work || !lat) {
+        printf("skipped (allocation failed)\n");
+        return 1;
+    }
+    a.xbytes = vbytes;
+    a.n = n;
+    a.inc = inc;
+    a.ar = &ar;
+    l2_arena_init(&ar, work, L2_ARENA_LWORK(n));
+
+    printf("=== per-call latency on strided vectors, N=%d, inc=%d, %d calls "
+           "===\n", n, inc, calls);
+    printf("OpenBLAS core: %s, l2blas core: %s, %d l2blas threads\n\n",
+           openblas_get_corename(), l2_get_corename(), l2_get_num_threads());
+    printf("%-9s %-9s %9s %9s %9s %8s\n", "routine", "impl", "p50 us",
+           "p99 us", "max us", "allocs");
+
+    for (int r = 0; r < NROUTINES; r++) {
+        a.r = r;
+        fill_inputs(&a, abytes, vbytes);
+        for (int how = 0; how < NHOWS; how++) {
+            long before;
+
+            a.how = how;
+            memcpy(a.x, a.x0, vbytes);
+            memcpy(a.y, a.x0, vbytes);
+            call_routine(&a);               /* warm up */
+            before = l2t_alloc_count();
+            for (int k = 0; k < calls; k++) {
+                double t0;
+
+                if (r == R_DTRSV || r == R_ZTRMV)
+                    memcpy(a.x, a.x0, a.xbytes);
+                t0 = bench_now();
+                call_routine(&a);
+                lat[k] = bench_now() - t0;
+            }
+            qsort(lat, calls, sizeof(double), cmp_double);
+            printf("%-9s %-9s %9.2f %9.2f %9.2f", how ? "" : r_name[r],
+                   how_name[how], lat[calls / 2] * 1e6,
+                   lat[(calls * 99) / 100] * 1e6, lat[calls - 1] * 1e6);
+            if (before < 0) printf(" %8s\n", "n/a");
+            else printf(" %8.2f\n", (double)(l2t_alloc_count() - before) /
+                                    calls);
+            fflush(stdout);
+        }
+    }
+
+    bench_free(a.A);
+    bench_free(a.x);
+    bench_free(a.y);
+    bench_free(a.x0);
+    bench_free(work);
+    free(lat);
+    return 0;
+}
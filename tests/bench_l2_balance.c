@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Load balance of the threaded triangular routines: each runs on T slots
+ * with the triangle split into equal column counts ("even"), then into
+ * column blocks of equal cost ("area", l2_set_tri_split), and the busy
+ * time of every slot is printed with max/mean of them.  With equal counts
+ * the slot holding the long columns does about twice the mean work
+ * (2T / (T + 1) for T slots); equal areas should bring that under 1.10.
+ * dsymv and zhemv split their column blocks the same way; dtrmv splits the
+ * rows of each band, and what is printed is its last band, the top one,
+ * which has no rectangle beside it.
+ *
+ * Usage: bench_l2_balance [N [threads]]
+ *
+ * Slot times are thread CPU time, so the figures stand even with more slots
+ * than CPUs.  Each slot's time is its best of BALANCE_REPS runs (default
+ * 10), as bench_run keeps the best batch: interrupts and a neighbour's
+ * memory traffic only ever add.
+ */
+
+enum { OP_DSYR, OP_DSYR2, OP_ZHER2, OP_DACC, OP_DSYMV, OP_ZHEMV, OP_DTRMV,
+       NOPS };
+
+typedef struct {
+    int op, n;
+    double *A, *x, *y, *work;
+} bal_args;
+
+#define ACC_K 4
+#define L2_BAL_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+static void call_op(bal_args *a) {
+    static const double z_alpha[2] = {1e-4, -1e-4};
+    int n = a->n;
+    l2_acc acc;
+
+    switch (a->op) {
+    case OP_DSYR:
+        l2_dsyr(CblasColMajor, CblasLower, n, 1e-4, a->x, 1, a->A, n);
+        break;
+    case OP_DSYR2:
+        l2_dsyr2(CblasColMajor, CblasUpper, n, 1e-4, a->x, 1, a->y, 1, a->A,
+                 n);
+        break;
+    case OP_ZHER2:
+        l2_zher2(CblasColMajor, CblasLower, n, z_alpha, a->x, 1, a->y, 1,
+                 a->A, n);
+        break;
+    case OP_DSYMV:
+        l2_dsymv(CblasColMajor, CblasLower, n, 1.0, a->A, n, a->x, 1, 0.0,
+                 a->y, 1);
+        break;
+    case OP_ZHEMV:
+        l2_zhemv(CblasColMajor, CblasLower, n, z_alpha, a->A, n, a->x, 1,
+                 z_alpha, a->y, 1);
+        break;
+    case OP_DTRMV:
+        l2_dtrmv(CblasColMajor, CblasLower, CblasNoTrans, CblasNonUnit, n,
+                 a->A, n, a->y, 1);
+        break;
+    case OP_DACC:
+        l2_dacc_init_sy(&acc, CblasColMajor, CblasLower, n, a->A, n, a->work,
+                        L2_ACC_LWORK(n, n, ACC_K));
+        for (int u = 0; u < ACC_K; u++)
+            l2_dacc_syr(&acc, 1e-4, a->x + (size_t)u * n, 1);
+        l2_dacc_flush(&acc);
+        break;
+    }
+}
+
+int main(int argc, char **argv) {
+    static const char *op_name[] = {"dsyr L", "dsyr2 U", "zher2 L",
+                                    "dacc sy L", "dsymv L", "zhemv L",
+                                    "dtrmv L N"};
+    static const char *split_name[] = {"even", "area"};
+    int n = argc > 1 ? atoi(argv[1]) : 4096;
+    int nt = argc > 2 ? atoi(argv[2]) : 4;
+    int reps = (int)bench_env_long("BALANCE_REPS", 10);
+    int saved = l2_get_num_threads();
+    bal_args a;
+
+    if (n < 1) n = 1;
+    if (nt < 2) nt = 2;
+    if (nt > 64) nt = 64;
+    if (reps < 1) reps = 1;
+
+    printf("=== per-thread busy time of threaded triangular routines "
+           "(N=%d, %d threads, ColMajor) ===\n", n, nt);
+    printf("l2blas core: %s\n\n", l2_get_corename());
+
+    a.n = n;
+    a.A = bench_alloc(2 * (size_t)n * n * sizeof(double));
+    a.x = bench_alloc(2 * (size_t)ACC_K * n * sizeof(double));
+    a.y = bench_alloc(2 * (size_t)n * sizeof(double));
+    a.work = bench_alloc((size_t)L2_ACC_LWORK(n, n, ACC_K) * sizeof(double));
+    if (!a.A || !a.x || !a.y || !a.work) {
+        printf("skipped (allocation failed)\n");
+        return 1;
+    }
+    bench_fill_d(a.A, 2 * (size_t)n * n, 1);
+    bench_fill_d(a.x, 2 * (size_t)ACC_K * n, 2);
+    bench_fill_d(a.y, 2 * (size_t)n, 3);
+
+    printf("%-10s %-5s %9s", "op", "split", "max/mean");
+    for (int t = 0; t < nt; t++) printf("  t%-2d ms", t);
+    printf("\n");
+
+    l2_set_num_threads(nt);
+    l2_set_slot_timing(1);
+    for (int op = 0; op < NOPS; op++) {
+        a.op = op;
+        call_op(&a);    /* warm the pool and the caches */
+        for (int s = 0; s < 2; s++) {
+            double best[64], max = 0, sum = 0, ratio;
+            int got = 0;
+
+            l2_set_tri_split(s ? L2_SPLIT_AREA : L2_SPLIT_EVEN);
+            for (int r = 0; r < reps; r++) {
+                double sec[64];
+                int ns;
+
+                call_op(&a);
+                ns = L2_BAL_MIN(l2_get_slot_times(sec, 64), 64);
+                for (int t = 0; t < ns; t++)
+                    if (r == 0 || sec[t] < best[t]) best[t] = sec[t];
+                got = ns;
+            }
+            for (int t = 0; t < got; t++) {
+                sum += best[t];
+                if (best[t] > max) max = best[t];
+            }
+            ratio = sum > 0 ? max * got / sum : 0;
+            printf("%-10s %-5s %8.2fx", op_name[op], split_name[s], ratio);
+            for (int t = 0; t < got; t++) printf(" %7.2f", best[t] * 1e3);
+            if (got < nt) printf("   (%d slots: below the threading "
+                                 "threshold)", got);
+            printf("\n");
+            fflush(stdout);
+        }
+    }
+    l2_set_slot_timing(0);
+    l2_set_tri_split(L2_SPLIT_AREA);
+    l2_set_num_threads(saved);
+
+    bench_free(a.A);
+    bench_free(a.x);
+    bench_free(a.y);
+    bench_free(a.work);
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Band storage against dense gemv: the same n x n product with only the
+ * kl = ku = bw diagonals either side stored, for bw = 0, 1, 2, 4 .. max_bw.
+ *
+ * Usage: bench_l2_band [n [max_bw]]   (defaults 4096 and 256)
+ *
+ * Columns are microseconds per call: dense gemv (OpenBLAS, l2blas), gbmv
+ * and sbmv (Lower, k = bw) in both libraries, then how many times faster
+ * l2 gbmv is than l2 dense gemv.  The dense time does not depend on bw and
+ * is measured once per precision.  ColMajor, NoTrans, unit increments.
+ */
+
+enum { DENSE_OB, DENSE_L2, GBMV_OB, GBMV_L2, SBMV_OB, SBMV_L2, NCOLS };
+
+typedef struct {
+    int col, n, bw;
+    char prec;
+    void *A, *band, *x, *y;
+} band_args;
+
+static void call_s(band_args *a) {
+    const enum CBLAS_ORDER o = CblasColMajor;
+    const enum CBLAS_TRANSPOSE t = CblasNoTrans;
+    const enum CBLAS_UPLO u = CblasLower;
+    int n = a->n, bw = a->bw;
+    float *A = a->A, *B = a->band, *x = a->x, *y = a->y;
+
+    switch (a->col) {
+    case DENSE_OB: cblas_sgemv(o, t, n, n, 1.0f, A, n, x, 1, 0.5f, y, 1); break;
+    case DENSE_L2: l2_sgemv(o, t, n, n, 1.0f, A, n, x, 1, 0.5f, y, 1); break;
+    case GBMV_OB:
+        cblas_sgbmv(o, t, n, n, bw, bw, 1.0f, B, 2 * bw + 1, x, 1, 0.5f, y, 1);
+        break;
+    case GBMV_L2:
+        l2_sgbmv(o, t, n, n, bw, bw, 1.0f, B, 2 * bw + 1, x, 1, 0.5f, y, 1);
+        break;
+    case SBMV_OB: cblas_ssbmv(o, u, n, bw, 1.0f, B, bw + 1, x, 1, 0.5f, y, 1); break;
+    default:      l2_ssbmv(o, u, n, bw, 1.0f, B, bw + 1, x, 1, 0.5f, y, 1); break;
+    }
+}
+
+static void call_d(band_args *a) {
+    const enum CBLAS_ORDER o = CblasColMajor;
+    const enum CBLAS_TRANSPOSE t = CblasNoTrans;
+    const enum CBLAS_UPLO u = CblasLower;
+    int n = a->n, bw = a->bw;
+    double *A = a->A, *B = a->band, *x = a->x, *y = a->y;
+
+    switch (a->col) {
+    case DENSE_OB: cblas_dgemv(o, t, n, n, 1.0, A, n, x, 1, 0.5, y, 1); break;
+    case DENSE_L2: l2_dgemv(o, t, n, n, 1.0, A, n, x, 1, 0.5, y, 1); break;
+    case GBMV_OB:
+        cblas_dgbmv(o, t, n, n, bw, bw, 1.0, B, 2 * bw + 1, x, 1, 0.5, y, 1);
+        break;
+    case GBMV_L2:
+        l2_dgbmv(o, t, n, n, bw, bw, 1.0, B, 2 * bw + 1, x, 1, 0.5, y, 1);
+        break;
+    case SBMV_OB: cblas_dsbmv(o, u, n, bw, 1.0, B, bw + 1, x, 1, 0.5, y, 1); break;
+    default:      l2_dsbmv(o, u, n, bw, 1.0, B, bw + 1, x, 1, 0.5, y, 1); break;
+    }
+}
+
+static void call_band(void *p) {
+    band_args *a = p;
+
+    if (a->prec == 's') call_s(a);
+    else call_d(a);
+}
+
+/* Entries in [-1/n, 1/n): y = 0.5*y + A*x stays bounded over many calls. */
+static void fill_scaled(void *p, char prec, size_t len, int n, unsigned seed) {
+    if (prec == 's') {
+        float *v = p;
+        bench_fill_s(v, len, seed);
+        for (size_t i = 0; i < len; i++) v[i] /= (float)n;
+    } else {
+        double *v = p;
+        bench_fill_d(v, len, seed);
+        for (size_t i = 0; i < len; i++) v[i] /= (double)n;
+    }
+}
+
+int main(int argc, char **argv) {
+    static const char precs[] = {'s', 'd'};
+    int n = argc > 1 ? atoi(argv[1]) : 4096;
+    int max_bw = argc > 2 ? atoi(argv[2]) : 256;
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+
+    if (n < 1) n = 1;
+    if (max_bw < 0) max_bw = 0;
+    if (max_bw > n - 1) max_bw = n - 1;
+
+    printf("=== band vs dense gemv, n = %d (us per call) ===\n", n);
+    printf("OpenBLAS core: %s, l2blas core: %s, ColMajor NoTrans\n\n",
+           openblas_get_corename(), l2_get_corename());
+    printf("%-4s %4s %10s %10s %9s %9s %9s %9s %9s\n", "prec", "bw",
+           "dense OB", "dense l2", "gbmv OB", "gbmv l2", "sbmv OB",
+           "sbmv l2", "vs dense");
+
+    for (int p = 0; p < 2; p++) {
+        size_t es = precs[p] == 's' ? sizeof(float) : sizeof(double);
+        size_t dense_bytes = (size_t)n * (size_t)n * es;
+        size_t band_bytes = (size_t)(2 * max_bw + 1) * (size_t)n * es;
+        double us[NCOLS];
+        band_args a;
+
+        if (dense_bytes + band_bytes > mem_limit) {
+            printf("%-4c skipped (needs %zu MB)\n", precs[p],
+                   (dense_bytes + band_bytes) >> 20);
+            continue;
+        }
+        a.prec = precs[p];
+        a.n = n;
+        a.A = bench_alloc(dense_bytes);
+        a.band = bench_alloc(band_bytes);
+        a.x = bench_alloc((size_t)n * es);
+        a.y = bench_alloc((size_t)n * es);
+        if (!a.A || !a.band || !a.x || !a.y) {
+            printf("%-4c skipped (allocation failed)\n", precs[p]);
+            bench_free(a.A); bench_free(a.band);
+            bench_free(a.x); bench_free(a.y);
+            continue;
+        }
+        fill_scaled(a.A, precs[p], (size_t)n * n, n, 1);
+        fill_scaled(a.band, precs[p], band_bytes / es, 2 * max_bw + 1, 2);
+        fill_scaled(a.x, precs[p], (size_t)n, 1, 3);
+        fill_scaled(a.y, precs[p], (size_t)n, 1, 4);
+
+        a.bw = 0;
+        for (int c = DENSE_OB; c <= DENSE_L2; c++) {
+            a.col = c;
+            us[c] = bench_run(call_band, &a) * 1e6;
+        }
+        for (int bw = 0; bw <= max_bw; bw = bw ? 2 * bw : 1) {
+            a.bw = bw;
+            for (int c = GBMV_OB; c < NCOLS; c++) {
+                a.col = c;
+                us[c] = bench_run(call_band, &a) * 1e6;
+            }
+            printf("%-4c %4d %10.1f %10.1f %9.1f %9.1f %9.1f %9.1f %8.1fx\n",
+                   precs[p], bw, us[DENSE_OB], us[DENSE_L2], us[GBMV_OB],
+                   us[GBMV_L2], us[SBMV_OB], us[SBMV_L2],
+                   us[DENSE_L2] / us[GBMV_L2]);
+            fflush(stdout);
+        }
+        printf("\n");
+        bench_free(a.A); bench_free(a.band);
+        bench_free(a.x); bench_free(a.y);
+    }
+    return 0;
+}
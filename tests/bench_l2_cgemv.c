@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Complex l2blas gemv and hemv against the linked OpenBLAS, one column per
+ * l2blas kernel tier.  The generic tier is the interleaved scalar code; the
+ * avx2 and avx512 tiers run the split-complex kernels, so "split/gen" is
+ * the speedup of the split layout on the same machine.
+ *
+ * Usage: bench_l2_cgemv [min_size [max_size]]   (powers of two, square)
+ *
+ * GB/s counts A (hemv: the stored triangle) once, x once and y read +
+ * written.
+ */
+
+enum { OP_GEMV_N, OP_GEMV_C, OP_HEMV };
+
+typedef struct {
+    int use_l2;
+    char prec;
+    int op;
+    int n;
+    void *A, *x, *y;
+} cgemv_args;
+
+static void call_cgemv(void *p) {
+    static const float  c_alpha[2] = {1.0f, 0.5f}, c_beta[2] = {0.5f, 0.0f};
+    static const double z_alpha[2] = {1.0, 0.5},   z_beta[2] = {0.5, 0.0};
+    cgemv_args *a = p;
+    enum CBLAS_TRANSPOSE t = a->op == OP_GEMV_N ? CblasNoTrans
+                                                : CblasConjTrans;
+    if (a->prec == 'c') {
+        if (a->op == OP_HEMV) {
+            if (a->use_l2)
+                l2_chemv(CblasColMajor, CblasLower, a->n, c_alpha, a->A,
+                         a->n, a->x, 1, c_beta, a->y, 1);
+            else
+                cblas_chemv(CblasColMajor, CblasLower, a->n, c_alpha, a->A,
+                            a->n, a->x, 1, c_beta, a->y, 1);
+        } else if (a->use_l2) {
+            l2_cgemv(CblasColMajor, t, a->n, a->n, c_alpha, a->A, a->n,
+                     a->x, 1, c_beta, a->y, 1);
+        } else {
+            cblas_cgemv(CblasColMajor, t, a->n, a->n, c_alpha, a->A, a->n,
+                        a->x, 1, c_beta, a->y, 1);
+        }
+    } else {
+        if (a->op == OP_HEMV) {
+            if (a->use_l2)
+                l2_zhemv(CblasColMajor, CblasLower, a->n, z_alpha, a->A,
+                         a->n, a->x, 1, z_beta, a->y, 1);
+            else
+                cblas_zhemv(CblasColMajor, CblasLower, a->n, z_alpha, a->A,
+                            a->n, a->x, 1, z_beta, a->y, 1);
+        } else if (a->use_l2) {
+            l2_zgemv(CblasColMajor, t, a->n, a->n, z_alpha, a->A, a->n,
+                     a->x, 1, z_beta, a->y, 1);
+        } else {
+            cblas_zgemv(CblasColMajor, t, a->n, a->n, z_alpha, a->A, a->n,
+                        a->x, 1, z_beta, a->y, 1);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    static const char *cores[] = {"generic", "avx2", "avx512"};
+    static const char precs[] = {'c', 'z'};
+    static const char *op_name[3] = {"gemvN", "gemvC", "hemvL"};
+    int min_size = argc > 1 ? atoi(argv[1]) : 64;
+    int max_size = argc > 2 ? atoi(argv[2]) : 4096;
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+
+    if (min_size < 1) min_size = 1;
+
+    printf("=== l2blas complex gemv/hemv vs OpenBLAS (GB/s, ColMajor) ===\n");
+    printf("OpenBLAS core: %s, l2blas auto core: %s\n\n",
+           openblas_get_corename(), l2_get_corename());
+    printf("%-4s %-5s %6s %10s %10s %10s %10s %9s %8s\n", "prec", "op", "N",
+           "OpenBLAS", "generic", "avx2", "avx512", "split/gen", "best/OB");
+
+    for (int p = 0; p < 2; p++) {
+        size_t es = 2 * (precs[p] == 'c' ? sizeof(float) : sizeof(double));
+        for (int n = min_size; n <= max_size; n *= 2) {
+            size_t a_bytes = (size_t)n * (size_t)n * es;
+            cgemv_args a;
+
+            if (a_bytes > mem_limit) {
+                printf("%-4c %-5s %6d   skipped (A needs %zu MB)\n",
+                       precs[p], "-", n, a_bytes >> 20);
+                continue;
+            }
+            a.prec = precs[p];
+            a.n = n;
+            a.A = bench_alloc(a_bytes);
+            a.x = bench_alloc((size_t)n * es);
+            a.y = bench_alloc((size_t)n * es);
+            if (!a.A || !a.x || !a.y) {
+                printf("%-4c %-5s %6d   skipped (allocation failed)\n",
+                       precs[p], "-", n);
+                bench_free(a.A); bench_free(a.x); bench_free(a.y);
+                continue;
+            }
+            if (precs[p] == 'c') {
+                bench_fill_s(a.A, 2 * (size_t)n * (size_t)n, 1);
+                bench_fill_s(a.x, 2 * (size_t)n, 2);
+            } else {
+                bench_fill_d(a.A, 2 * (size_t)n * (size_t)n, 1);
+                bench_fill_d(a.x, 2 * (size_t)n, 2);
+            }
+
+            for (int op = 0; op < 3; op++) {
+                double elems = op == OP_HEMV
+                    ? 0.5 * (double)n * (double)(n + 1)
+                    : (double)n * (double)n;
+                double bytes = (elems + 3.0 * (double)n) * (double)es;
+                double ob, gen = 0.0, split = 0.0;
+
+                a.op = op;
+                a.use_l2 = 0;
+                ob = bytes / bench_run(call_cgemv, &a) * 1e-9;
+                printf("%-4c %-5s %6d %10.2f", precs[p], op_name[op], n, ob);
+
+                a.use_l2 = 1;
+                for (int c = 0; c < 3; c++) {
+                    double gbs;
+                    if (l2_set_core(cores[c]) != 0) {
+                        printf(" %10s", "n/a");
+                        continue;
+                    }
+                    gbs = bytes / bench_run(call_cgemv, &a) * 1e-9;
+                    if (c == 0) gen = gbs;
+                    else if (gbs > split) split = gbs;
+                    printf(" %10.2f", gbs);
+                }
+                l2_set_core(NULL);
+                if (split > 0.0)
+                    printf(" %8.2fx", split / gen);
+                else
+                    printf(" %9s", "n/a");
+                printf(" %7.2fx\n", (split > gen ? split : gen) / ob);
+                fflush(stdout);
+            }
+            bench_free(a.A);
+            bench_free(a.x);
+            bench_free(a.y);
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * l2blas sgemv/dgemv against the linked OpenBLAS, one column per l2blas
+ * kernel tier.
+ *
+ * Usage: bench_l2_gemv [min_size [max_size]]   (square, powers of two)
+ *
+ * Figures are GB/s (A read once, x once, y read + written).  The last
+ * column is the best l2blas tier relative to OpenBLAS; compare it with the
+ * core name printed in the header (the vendored OpenBLAS-bin is "generic").
+ */
+
+typedef struct {
+    int use_l2;
+    char prec;
+    enum CBLAS_ORDER order;
+    enum CBLAS_TRANSPOSE trans;
+    int n;
+    void *A, *x, *y;
+} gemv_args;
+
+static void call_gemv(void *p) {
+    gemv_args *a = p;
+    if (a->prec == 's') {
+        if (a->use_l2)
+            l2_sgemv(a->order, a->trans, a->n, a->n, 1.0f, a->A, a->n,
+                     a->x, 1, 0.5f, a->y, 1);
+        else
+            cblas_sgemv(a->order, a->trans, a->n, a->n, 1.0f, a->A, a->n,
+                        a->x, 1, 0.5f, a->y, 1);
+    } else {
+        if (a->use_l2)
+            l2_dgemv(a->order, a->trans, a->n, a->n, 1.0, a->A, a->n,
+                     a->x, 1, 0.5, a->y, 1);
+        else
+            cblas_dgemv(a->order, a->trans, a->n, a->n, 1.0, a->A, a->n,
+                        a->x, 1, 0.5, a->y, 1);
+    }
+}
+
+int main(int argc, char **argv) {
+    static const char *cores[] = {"generic", "avx2", "avx512"};
+    static const char precs[] = {'s', 'd'};
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const enum CBLAS_TRANSPOSE transes[2] = {CblasNoTrans, CblasTrans};
+    int min_size = argc > 1 ? atoi(argv[1]) : 64;
+    int max_size = argc > 2 ? atoi(argv[2]) : 8192;
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+
+    if (min_size < 1) min_size = 1;
+
+    printf("=== l2blas gemv vs OpenBLAS (GB/s) ===\n");
+    printf("OpenBLAS core: %s, l2blas auto core: %s\n\n",
+           openblas_get_corename(), l2_get_corename());
+    printf("%-4s %-3s %-2s %6s %10s %10s %10s %10s %8s\n", "prec", "ord", "tr",
+           "N", "OpenBLAS", "generic", "avx2", "avx512", "best/OB");
+
+    for (int p = 0; p < 2; p++) {
+        size_t es = precs[p] == 's' ? sizeof(float) : sizeof(double);
+        for (int n = min_size; n <= max_size; n *= 2) {
+            size_t a_bytes = (size_t)n * (size_t)n * es;
+            double bytes = (double)a_bytes + 3.0 * (double)n * (double)es;
+            gemv_args a;
+
+            if (a_bytes > mem_limit) {
+                printf("%-4c %-3s %-2s %6d   skipped (A needs %zu MB)\n",
+                       precs[p], "-", "-", n, a_bytes >> 20);
+                continue;
+            }
+            a.prec = precs[p];
+            a.n = n;
+            a.A = bench_alloc(a_bytes);
+            a.x = bench_alloc((size_t)n * es);
+            a.y = bench_alloc((size_t)n * es);
+            if (!a.A || !a.x || !a.y) {
+                printf("%-4c %-3s %-2s %6d   skipped (allocation failed)\n",
+                       precs[p], "-", "-", n);
+                bench_free(a.A); bench_free(a.x); bench_free(a.y);
+                continue;
+            }
+            if (precs[p] == 's') {
+                bench_fill_s(a.A, (size_t)n * (size_t)n, 1);
+                bench_fill_s(a.x, (size_t)n, 2);
+            } else {
+                bench_fill_d(a.A, (size_t)n * (size_t)n, 1);
+                bench_fill_d(a.x, (size_t)n, 2);
+            }
+
+            for (int o = 0; o < 2; o++) {
+                for (int t = 0; t < 2; t++) {
+                    double ob, best = 0.0;
+
+                    a.order = orders[o];
+                    a.trans = transes[t];
+                    a.use_l2 = 0;
+                    ob = bytes / bench_run(call_gemv, &a) * 1e-9;
+                    printf("%-4c %-3s %-2s %6d %10.2f", precs[p],
+                           o == 0 ? "Row" : "Col", t == 0 ? "N" : "T", n, ob);
+
+                    a.use_l2 = 1;
+                    for (int c = 0; c < 3; c++) {
+                        double gbs;
+                        if (l2_set_core(cores[c]) != 0) {
+                            printf(" %10s", "n/a");
+                            continue;
+                        }
+                        gbs = bytes / bench_run(call_gemv, &a) * 1e-9;
+                        if (gbs > best) best = gbs;
+                        printf(" %10.2f", gbs);
+                    }
+                    l2_set_core(NULL);
+                    printf(" %7.2fx\n", best / ob);
+                    fflush(stdout);
+                }
+            }
+            bench_free(a.A);
+            bench_free(a.x);
+            bench_free(a.y);
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Batched gemv against a loop of single calls, for the small square shapes
+ * where per-call overhead dominates.  Reports ns per matrix for:
+ *   loop OB   - for (i) cblas_?gemv(...)       (linked OpenBLAS)
+ *   loop l2   - for (i) l2_?gemv(...)
+ *   strided   - one l2_?gemv_batch_strided call
+ *   grouped   - one l2_?gemv_batch call (pointer arrays, one group)
+ *
+ * Usage: bench_l2_gemv_batch [batch_count [max_size]]
+ *
+ * Sizes are 2, 4, 8, ... up to max_size (default 32).  The batch uses
+ * l2_get_num_threads() threads: L2BLAS_NUM_THREADS, else
+ * OPENBLAS_NUM_THREADS, else all CPUs.
+ */
+
+enum { LOOP_OB, LOOP_L2, STRIDED, GROUPED, NMODES };
+
+typedef struct {
+    int mode;
+    char prec;
+    int n, count;
+    char *A, *x, *y;
+    const void **ap, **xp;
+    void **yp;
+} batch_args;
+
+static void call_batch(void *p) {
+    static const float  sone[2] = {1.0f, 0.0f}, shalf[2] = {0.5f, 0.0f};
+    static const double done[2] = {1.0, 0.0},   dhalf[2] = {0.5, 0.0};
+    batch_args *b = p;
+    const enum CBLAS_ORDER o = CblasRowMajor;
+    const enum CBLAS_TRANSPOSE t = CblasNoTrans;
+    blasint n = b->n, size = b->count, inc = 1;
+    BLASLONG sa = (BLASLONG)n * n, sv = n;
+
+    if (b->mode == STRIDED) {
+        switch (b->prec) {
+        case 's': l2_sgemv_batch_strided(o, t, n, n, 1.0f, (float *)b->A, n, sa,
+                                          (float *)b->x, 1, sv, 0.5f,
+                                          (float *)b->y, 1, sv, size); break;
+        case 'd': l2_dgemv_batch_strided(o, t, n, n, 1.0, (double *)b->A, n, sa,
+                                          (double *)b->x, 1, sv, 0.5,
+                                          (double *)b->y, 1, sv, size); break;
+        case 'c': l2_cgemv_batch_strided(o, t, n, n, sone, b->A, n, sa, b->x, 1,
+                                          sv, shalf, b->y, 1, sv, size); break;
+        default:  l2_zgemv_batch_strided(o, t, n, n, done, b->A, n, sa, b->x, 1,
+                                          sv, dhalf, b->y, 1, sv, size); break;
+        }
+        return;
+    }
+    if (b->mode == GROUPED) {
+        switch (b->prec) {
+        case 's': l2_sgemv_batch(o, &t, &n, &n, sone, (const float **)b->ap, &n,
+                                 (const float **)b->xp, &inc, shalf,
+                                 (float **)b->yp, &inc, 1, &size); break;
+        case 'd': l2_dgemv_batch(o, &t, &n, &n, done, (const double **)b->ap, &n,
+                                 (const double **)b->xp, &inc, dhalf,
+                                 (double **)b->yp, &inc, 1, &size); break;
+        case 'c': l2_cgemv_batch(o, &t, &n, &n, sone, b->ap, &n, b->xp, &inc,
+                                 shalf, b->yp, &inc, 1, &size); break;
+        default:  l2_zgemv_batch(o, &t, &n, &n, done, b->ap, &n, b->xp, &inc,
+                                 dhalf, b->yp, &inc, 1, &size); break;
+        }
+        return;
+    }
+    for (int i = 0; i < b->count; i++) {
+        const void *a = b->ap[i], *x = b->xp[i];
+        void *y = b->yp[i];
+
+        switch (b->prec) {
+        case 's':
+            if (b->mode == LOOP_L2) l2_sgemv(o, t, n, n, 1.0f, a, n, x, 1, 0.5f, y, 1);
+            else cblas_sgemv(o, t, n, n, 1.0f, a, n, x, 1, 0.5f, y, 1);
+            break;
+        case 'd':
+            if (b->mode == LOOP_L2) l2_dgemv(o, t, n, n, 1.0, a, n, x, 1, 0.5, y, 1);
+            else cblas_dgemv(o, t, n, n, 1.0, a, n, x, 1, 0.5, y, 1);
+            break;
+        case 'c':
+            if (b->mode == LOOP_L2) l2_cgemv(o, t, n, n, sone, a, n, x, 1, shalf, y, 1);
+            else cblas_cgemv(o, t, n, n, sone, a, n, x, 1, shalf, y, 1);
+            break;
+        default:
+            if (b->mode == LOOP_L2) l2_zgemv(o, t, n, n, done, a, n, x, 1, dhalf, y, 1);
+            else cblas_zgemv(o, t, n, n, done, a, n, x, 1, dhalf, y, 1);
+            break;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    static const char precs[] = {'s', 'd', 'c', 'z'};
+    static const char *mode_name[NMODES] = {"loop OB", "loop l2", "strided",
+                                            "grouped"};
+    int count = argc > 1 ? atoi(argv[1]) : 10000;
+    int max_size = argc > 2 ? atoi(argv[2]) : 32;
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+
+    if (count < 1) count = 1;
+
+    printf("=== batched gemv vs loop of single calls (ns per matrix) ===\n");
+    printf("OpenBLAS core: %s, l2blas core: %s, l2blas threads: %d, "
+           "batch: %d, RowMajor NoTrans\n\n", openblas_get_corename(),
+           l2_get_corename(), l2_get_num_threads(), count);
+    printf("%-4s %4s %10s %10s %10s %10s %9s\n", "prec", "N", mode_name[0],
+           mode_name[1], mode_name[2], mode_name[3], "batch/OB");
+
+    for (int p = 0; p < 4; p++) {
+        size_t es = (precs[p] == 'c' || precs[p] == 'z' ? 2 : 1) *
+                    (precs[p] == 's' || precs[p] == 'c' ? sizeof(float)
+                                                        : sizeof(double));
+        for (int n = 2; n <= max_size; n *= 2) {
+            size_t per = (size_t)n * n + 2 * (size_t)n;
+            double ns[NMODES];
+            batch_args b;
+
+            if ((size_t)count * per * es > mem_limit) {
+                printf("%-4c %4d   skipped (batch needs %zu MB)\n", precs[p], n,
+                       ((size_t)count * per * es) >> 20);
+                continue;
+            }
+            b.prec = precs[p];
+            b.n = n;
+            b.count = count;
+            b.A = bench_alloc((size_t)count * n * n * es);
+            b.x = bench_alloc((size_t)count * n * es);
+            b.y = bench_alloc((size_t)count * n * es);
+            b.ap = malloc((size_t)count * sizeof(void *));
+            b.xp = malloc((size_t)count * sizeof(void *));
+            b.yp = malloc((size_t)count * sizeof(void *));
+            if (!b.A || !b.x || !b.y || !b.ap || !b.xp || !b.yp) {
+                printf("%-4c %4d   skipped (allocation failed)\n", precs[p], n);
+                bench_free(b.A); bench_free(b.x); bench_free(b.y);
+                free(b.ap); free(b.xp); free(b.yp);
+                continue;
+            }
+            if (precs[p] == 's' || precs[p] == 'c') {
+                bench_fill_s((float *)b.A, (size_t)count * n * n * es / sizeof(float), 1);
+                bench_fill_s((float *)b.x, (size_t)count * n * es / sizeof(float), 2);
+            } else {
+                bench_fill_d((double *)b.A, (size_t)count * n * n * es / sizeof(double), 1);
+                bench_fill_d((double *)b.x, (size_t)count * n * es / sizeof(double), 2);
+            }
+            for (int i = 0; i < count; i++) {
+                b.ap[i] = b.A + (size_t)i * n * n * es;
+                b.xp[i] = b.x + (size_t)i * n * es;
+                b.yp[i] = b.y + (size_t)i * n * es;
+            }
+
+            for (int m = 0; m < NMODES; m++) {
+                b.mode = m;
+                ns[m] = bench_run(call_batch, &b) / count * 1e9;
+            }
+            printf("%-4c %4d %10.1f %10.1f %10.1f %10.1f %8.2fx\n", precs[p], n,
+                   ns[LOOP_OB], ns[LOOP_L2], ns[STRIDED], ns[GROUPED],
+                   ns[LOOP_OB] / (ns[STRIDED] < ns[GROUPED] ? ns[STRIDED]
+                                                            : ns[GROUPED]));
+            fflush(stdout);
+
+            bench_free(b.A); bench_free(b.x); bench_free(b.y);
+            free(b.ap); free(b.xp); free(b.yp);
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Rank-1 updates (sger, dger, cgeru, zgeru) against the linked OpenBLAS,
+ * one column per l2blas kernel tier, next to an in-place update
+ * a[:, j] += s*b over an array the size of A, so "best/rmw" is how close
+ * the best tier gets to what the machine streams through a read-modify-write
+ * at that footprint (in cache for small N, DRAM once A outgrows the last
+ * level).
+ *
+ * Usage: bench_l2_ger [min_size [max_size]]   (powers of two, square)
+ *
+ * GB/s counts A read + written and x, y once, for the update too.  Both
+ * run on l2_get_num_threads() threads; the update's are started before
+ * timing begins.
+ */
+
+typedef struct {
+    int use_l2;
+    char prec;
+    int n;
+    void *A, *x, *y;
+} ger_args;
+
+static void call_ger(void *p) {
+    static const float  c_alpha[2] = {1e-3f, -1e-3f};
+    static const double z_alpha[2] = {1e-3, -1e-3};
+    ger_args *a = p;
+
+    switch (a->prec) {
+    case 's':
+        if (a->use_l2)
+            l2_sger(CblasColMajor, a->n, a->n, 1e-3f, a->x, 1, a->y, 1,
+                    a->A, a->n);
+        else
+            cblas_sger(CblasColMajor, a->n, a->n, 1e-3f, a->x, 1, a->y, 1,
+                       a->A, a->n);
+        break;
+    case 'd':
+        if (a->use_l2)
+            l2_dger(CblasColMajor, a->n, a->n, 1e-3, a->x, 1, a->y, 1,
+                    a->A, a->n);
+        else
+            cblas_dger(CblasColMajor, a->n, a->n, 1e-3, a->x, 1, a->y, 1,
+                       a->A, a->n);
+        break;
+    case 'c':
+        if (a->use_l2)
+            l2_cgeru(CblasColMajor, a->n, a->n, c_alpha, a->x, 1, a->y, 1,
+                     a->A, a->n);
+        else
+            cblas_cgeru(CblasColMajor, a->n, a->n, c_alpha, a->x, 1, a->y, 1,
+                        a->A, a->n);
+        break;
+    default:
+        if (a->use_l2)
+            l2_zgeru(CblasColMajor, a->n, a->n, z_alpha, a->x, 1, a->y, 1,
+                     a->A, a->n);
+        else
+            cblas_zgeru(CblasColMajor, a->n, a->n, z_alpha, a->x, 1, a->y, 1,
+                        a->A, a->n);
+        break;
+    }
+}
+
+/* ---- in-place update reference ------------------------------------------ */
+
+/*
+ * The streaming roof for ger: a[:, j] += s * b over the columns of an array
+ * the size of A, b one column long, so memory sees exactly what a rank-1
+ * update moves (A read and written, one vector read).  Its threads are
+ * started once and parked between calls, as the l2blas pool's are, so no
+ * thread start-up lands inside the timed region.
+ */
+typedef struct {
+    double *a;
+    const double *b;
+    size_t col, ncols;          /* column length and count, in doubles */
+    int isa;                    /* 0 sse2, 1 avx2, 2 avx512f */
+    int nthreads, nworkers;     /* workers: tids 1..nworkers */
+    pthread_t th[64];
+    pthread_mutex_t mu;
+    pthread_cond_t go, fin;
+    unsigned gen;
+    int pending, quit;
+} rmw_team;
+
+typedef struct {
+    rmw_team *t;
+    int tid;
+} rmw_slot;
+
+/*
+ * Four columns at a time, a[:, k] += s_k * b, as the ger kernels walk A, at
+ * each vector width; unaligned loads and stores.
+ */
+#define RMW_LOOP(name, tgt, VB)                                               \
+    __attribute__((target(tgt))) static void name(                            \
+            double *a, size_t ld, const double *restrict b, size_t len,       \
+            double s) {                                                       \
+        typedef double v __attribute__((vector_size(VB), aligned(8)));        \
+        const size_t w = VB / sizeof(double), q = len / w * w;                \
+        double *a0 = a, *a1 = a + ld, *a2 = a + 2 * ld, *a3 = a + 3 * ld;     \
+        for (size_t i = 0; i < q; i += w) {                                   \
+            v x = *(const v *)(b + i);                                        \
+            *(v *)(a0 + i) += s * x;                                          \
+            *(v *)(a1 + i) -= s * x;                                          \
+            *(v *)(a2 + i) += 2.0 * s * x;                                    \
+            *(v *)(a3 + i) -= 2.0 * s * x;                                    \
+        }                                                                     \
+        for (size_t i = q; i < len; i++) {                                    \
+            a0[i] += s * b[i];                                                \
+            a1[i] -= s * b[i];                                                \
+            a2[i] += 2.0 * s * b[i];                                          \
+            a3[i] -= 2.0 * s * b[i];                                          \
+        }                                                                     \
+    }
+
+RMW_LOOP(rmw_avx512, "avx512f", 64)
+RMW_LOOP(rmw_avx2, "avx2", 32)
+RMW_LOOP(rmw_sse2, "sse2", 16)
+
+static void rmw_part(rmw_team *t, int tid) {
+    /* whole groups of four columns per thread, the rest single */
+    size_t groups = (t->ncols + 3) / 4;
+    size_t chunk = (groups + t->nthreads - 1) / t->nthreads * 4;
+    size_t lo = chunk * tid < t->ncols ? chunk * tid : t->ncols;
+    size_t hi = lo + chunk < t->ncols ? lo + chunk : t->ncols;
+    const double s = 1e-3;
+
+    for (size_t j = lo; j + 4 <= hi; j += 4) {
+        double *a = t->a + j * t->col;
+        switch (t->isa) {
+        case 2:  rmw_avx512(a, t->col, t->b, t->col, s); break;
+        case 1:  rmw_avx2(a, t->col, t->b, t->col, s); break;
+        default: rmw_sse2(a, t->col, t->b, t->col, s); break;
+        }
+    }
+    for (size_t j = hi - (hi - lo) % 4; j < hi; j++) {
+        double *a = t->a + j * t->col;
+        for (size_t i = 0; i < t->col; i++)
+            a[i] += s * t->b[i];
+    }
+}
+
+static void *rmw_worker(void *p) {
+    rmw_slot *sl = p;
+    rmw_team *t = sl->t;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&t->mu);
+    for (;;) {
+        while (t->gen == seen && !t->quit)
+            pthread_cond_wait(&t->go, &t->mu);
+        if (t->quit) break;
+        seen = t->gen;
+        pthread_mutex_unlock(&t->mu);
+        rmw_part(t, sl->tid);
+        pthread_mutex_lock(&t->mu);
+        if (--t->pending == 0) pthread_cond_signal(&t->fin);
+    }
+    pthread_mutex_unlock(&t->mu);
+    return NULL;
+}
+
+static void rmw_start(rmw_team *t, rmw_slot *slot, int nthreads) {
+    __builtin_cpu_init();
+    t->isa = __builtin_cpu_supports("avx512f") ? 2
+             : __builtin_cpu_supports("avx2")  ? 1 : 0;
+    t->nthreads = nthreads < 64 ? nthreads : 64;
+    t->nworkers = 0;
+    t->gen = 0;
+    t->pending = 0;
+    t->quit = 0;
+    pthread_mutex_init(&t->mu, NULL);
+    pthread_cond_init(&t->go, NULL);
+    pthread_cond_init(&t->fin, NULL);
+    for (int k = 1; k < t->nthreads; k++) {
+        slot[k].t = t;
+        slot[k].tid = k;
+        if (pthread_create(&t->th[k], NULL, rmw_worker, &slot[k]) != 0)
+            break;
+        t->nworkers = k;
+    }
+}
+
+static void rmw_stop(rmw_team *t) {
+    pthread_mutex_lock(&t->mu);
+    t->quit = 1;
+    pthread_cond_broadcast(&t->go);
+    pthread_mutex_unlock(&t->mu);
+    for (int k = 1; k <= t->nworkers; k++)
+        pthread_join(t->th[k], NULL);
+    pthread_mutex_destroy(&t->mu);
+    pthread_cond_destroy(&t->go);
+    pthread_cond_destroy(&t->fin);
+}
+
+static void call_rmw(void *p) {
+    rmw_team *t = p;
+
+    if (t->nworkers > 0) {
+        pthread_mutex_lock(&t->mu);
+        t->gen++;
+        t->pending = t->nworkers;
+        pthread_cond_broadcast(&t->go);
+        pthread_mutex_unlock(&t->mu);
+    }
+    rmw_part(t, 0);
+    /* slots whose thread failed to start are done here, in order */
+    for (int k = t->nworkers + 1; k < t->nthreads; k++)
+        rmw_part(t, k);
+    if (t->nworkers > 0) {
+        pthread_mutex_lock(&t->mu);
+        while (t->pending > 0)
+            pthread_cond_wait(&t->fin, &t->mu);
+        pthread_mutex_unlock(&t->mu);
+    }
+}
+
+/*
+ * GB/s of the update over n columns of col_bytes each, counted as ger
+ * counts itself: `bytes`.
+ */
+static double rmw_gbs(rmw_team *t, size_t col_bytes, int n, double bytes) {
+    double *a, *b, gbs = 0.0;
+
+    t->col = col_bytes / sizeof(double);
+    t->ncols = (size_t)n;
+    a = bench_alloc(t->col * t->ncols * sizeof(double));
+    b = bench_alloc(t->col * sizeof(double));
+    if (a && b) {
+        bench_fill_d(a, t->col * t->ncols, 1);
+        bench_fill_d(b, t->col, 2);
+        t->a = a;
+        t->b = b;
+        gbs = bytes / bench_run(call_rmw, t) * 1e-9;
+    }
+    bench_free(a);
+    bench_free(b);
+    return gbs;
+}
+
+int main(int argc, char **argv) {
+    static const char *cores[] = {"generic", "avx2", "avx512"};
+    static const char precs[] = {'s', 'd', 'c', 'z'};
+    static const char *op_name[] = {"sger", "dger", "cgeru", "zgeru"};
+    int min_size = argc > 1 ? atoi(argv[1]) : 64;
+    int max_size = argc > 2 ? atoi(argv[2]) : 8192;
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+    int nthreads = l2_get_num_threads();
+    rmw_slot slots[64];
+    rmw_team team;
+
+    if (min_size < 1) min_size = 1;
+    rmw_start(&team, slots, nthreads);
+
+    printf("=== l2blas rank-1 update vs OpenBLAS and in-place update "
+           "(GB/s, ColMajor) ===\n");
+    printf("OpenBLAS core: %s, l2blas auto core: %s, l2blas/rmw threads: "
+           "%d\n\n", openblas_get_corename(), l2_get_corename(), nthreads);
+    printf("%-6s %6s %10s %10s %10s %10s %10s %11s\n", "op", "N", "OpenBLAS",
+           "generic", "avx2", "avx512", "rmw", "best/rmw");
+
+    for (int p = 0; p < 4; p++) {
+        size_t es = (precs[p] == 's' || precs[p] == 'c' ? sizeof(float)
+                                                        : sizeof(double)) *
+                    (precs[p] == 'c' || precs[p] == 'z' ? 2 : 1);
+        for (int n = min_size; n <= max_size; n *= 2) {
+            size_t a_bytes = (size_t)n * (size_t)n * es;
+            double bytes = (2.0 * (double)n * (double)n + 2.0 * (double)n) *
+                           (double)es;
+            double best = 0.0, rmw;
+            ger_args a;
+
+            if (2 * a_bytes > mem_limit) {
+                printf("%-6s %6d   skipped (A needs %zu MB)\n", op_name[p],
+                       n, a_bytes >> 20);
+                continue;
+            }
+            a.prec = precs[p];
+            a.n = n;
+            a.A = bench_alloc(a_bytes);
+            a.x = bench_alloc((size_t)n * es);
+            a.y = bench_alloc((size_t)n * es);
+            if (!a.A || !a.x || !a.y) {
+                printf("%-6s %6d   skipped (allocation failed)\n",
+                       op_name[p], n);
+                bench_free(a.A); bench_free(a.x); bench_free(a.y);
+                continue;
+            }
+            if (precs[p] == 's' || precs[p] == 'c') {
+                size_t k = es / sizeof(float);
+                bench_fill_s(a.A, k * (size_t)n * (size_t)n, 1);
+                bench_fill_s(a.x, k * (size_t)n, 2);
+                bench_fill_s(a.y, k * (size_t)n, 3);
+            } else {
+                size_t k = es / sizeof(double);
+                bench_fill_d(a.A, k * (size_t)n * (size_t)n, 1);
+                bench_fill_d(a.x, k * (size_t)n, 2);
+                bench_fill_d(a.y, k * (size_t)n, 3);
+            }
+
+            a.use_l2 = 0;
+            printf("%-6s %6d %10.2f", op_name[p], n,
+                   bytes / bench_run(call_ger, &a) * 1e-9);
+
+            a.use_l2 = 1;
+            for (int c = 0; c < 3; c++) {
+                double gbs;
+                if (l2_set_core(cores[c]) != 0) {
+                    printf(" %10s", "n/a");
+                    continue;
+                }
+                gbs = bytes / bench_run(call_ger, &a) * 1e-9;
+                if (gbs > best) best = gbs;
+                printf(" %10.2f", gbs);
+            }
+            l2_set_core(NULL);
+            bench_free(a.A);
+            bench_free(a.x);
+            bench_free(a.y);
+
+            rmw = rmw_gbs(&team, (size_t)n * es, n, bytes);
+            printf(" %10.2f %10.0f%%\n", rmw,
+                   rmw > 0.0 ? 100.0 * best / rmw : 0.0);
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+    rmw_stop(&team);
+    return 0;
+}
@@ -0,0 +1,189 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <dlfcn.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Reduced-precision storage against fp32: gemv (NoTrans, Trans), symv and
+ * trmv on an N x N ColMajor matrix held as float, bf16 and fp16.
+ *
+ * Usage: bench_l2_half [min_size [max_size]]   (powers of two)
+ *
+ * Columns:
+ *   OB f32, l2 f32   cblas_s* and l2_s* (trmv: cblas_strmv only)
+ *   OB bf16          cblas_sbgemv (gemv only, if OpenBLAS has bfloat16)
+ *   l2 bf16, l2 fp16 l2_sb* and l2_sh*
+ * as GB/s of the matrix bytes each one reads (the stored triangle for symv
+ * and trmv) plus x and y, and bf16/f32, the time of the faster fp32 column
+ * over l2 bf16: about 2 once A is out of cache.
+ */
+
+/*
+ * OpenBLAS only exports cblas_sbgemv when built with BUILD_BFLOAT16, so it
+ * is looked up at run time rather than linked; NULL without it.
+ */
+typedef void (*sbgemv_fn)(enum CBLAS_ORDER, enum CBLAS_TRANSPOSE, blasint,
+                          blasint, float, const bfloat16 *, blasint,
+                          const bfloat16 *, blasint, float, float *, blasint);
+
+static sbgemv_fn ob_sbgemv(void) {
+    return (sbgemv_fn)dlsym(RTLD_DEFAULT, "cblas_sbgemv");
+}
+
+enum { OP_GEMV_N, OP_GEMV_T, OP_SYMV, OP_TRMV, NOPS };
+enum { IM_OB32, IM_L232, IM_OB16, IM_L2BF, IM_L2FP, NIMPLS };
+
+static const char *op_name[NOPS] = {"gemv N", "gemv T", "symv", "trmv"};
+
+typedef struct {
+    int op, impl, n;
+    const float *A32, *x32;
+    const bfloat16 *Abf, *xbf;
+    const l2_fp16 *Afp, *xfp;
+    float *y;
+    sbgemv_fn sbgemv;
+} half_args;
+
+static void call_half(void *p) {
+    half_args *a = p;
+    int n = a->n;
+    enum CBLAS_TRANSPOSE t = a->op == OP_GEMV_T ? CblasTrans : CblasNoTrans;
+
+    switch (a->op) {
+    case OP_GEMV_N:
+    case OP_GEMV_T:
+        switch (a->impl) {
+        case IM_OB32: cblas_sgemv(CblasColMajor, t, n, n, 1.0f, a->A32, n,
+                                  a->x32, 1, 0.5f, a->y, 1); break;
+        case IM_L232: l2_sgemv(CblasColMajor, t, n, n, 1.0f, a->A32, n,
+                               a->x32, 1, 0.5f, a->y, 1); break;
+        case IM_OB16: a->sbgemv(CblasColMajor, t, n, n, 1.0f, a->Abf, n,
+                                a->xbf, 1, 0.5f, a->y, 1); break;
+        case IM_L2BF: l2_sbgemv(CblasColMajor, t, n, n, 1.0f, a->Abf, n,
+                                a->xbf, 1, 0.5f, a->y, 1); break;
+        default:      l2_shgemv(CblasColMajor, t, n, n, 1.0f, a->Afp, n,
+                                a->xfp, 1, 0.5f, a->y, 1); break;
+        }
+        break;
+    case OP_SYMV:
+        switch (a->impl) {
+        case IM_OB32: cblas_ssymv(CblasColMajor, CblasLower, n, 1.0f, a->A32,
+                                  n, a->x32, 1, 0.5f, a->y, 1); break;
+        case IM_L232: l2_ssymv(CblasColMajor, CblasLower, n, 1.0f, a->A32, n,
+                               a->x32, 1, 0.5f, a->y, 1); break;
+        case IM_L2BF: l2_sbsymv(CblasColMajor, CblasLower, n, 1.0f, a->Abf,
+                                n, a->xbf, 1, 0.5f, a->y, 1); break;
+        default:      l2_shsymv(CblasColMajor, CblasLower, n, 1.0f, a->Afp,
+                                n, a->xfp, 1, 0.5f, a->y, 1); break;
+        }
+        break;
+    default:
+        /* y is overwritten every call; A's entries are small enough that
+           the repeated products stay finite over a benchmark run */
+        switch (a->impl) {
+        case IM_OB32: cblas_strmv(CblasColMajor, CblasUpper, CblasNoTrans,
+                                  CblasNonUnit, n, a->A32, n, a->y, 1); break;
+        case IM_L2BF: l2_sbtrmv(CblasColMajor, CblasUpper, CblasNoTrans,
+                                CblasNonUnit, n, a->Abf, n, a->y, 1); break;
+        default:      l2_shtrmv(CblasColMajor, CblasUpper, CblasNoTrans,
+                                CblasNonUnit, n, a->Afp, n, a->y, 1); break;
+        }
+        break;
+    }
+}
+
+static int available(int op, int impl) {
+    if (impl == IM_OB16)
+        return ob_sbgemv() && (op == OP_GEMV_N || op == OP_GEMV_T);
+    if (impl == IM_L232) return op != OP_TRMV;
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    int min_size = argc > 1 ? atoi(argv[1]) : 256;
+    int max_size = argc > 2 ? atoi(argv[2]) : 8192;
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+
+    if (min_size < 1) min_size = 1;
+
+    printf("=== bf16/fp16 storage, fp32 arithmetic vs fp32 (GB/s) ===\n");
+    printf("OpenBLAS core: %s, l2blas core: %s\n\n", openblas_get_corename(),
+           l2_get_corename());
+    printf("%-7s %6s %9s %9s %9s %9s %9s %9s\n", "op", "N", "OB f32",
+           "l2 f32", "OB bf16", "l2 bf16", "l2 fp16", "bf16/f32");
+
+    for (int n = min_size; n <= max_size; n *= 2) {
+        size_t elems = (size_t)n * (size_t)n;
+        half_args a;
+        float *A32, *x32;
+        bfloat16 *Abf, *xbf;
+        l2_fp16 *Afp, *xfp;
+
+        if (elems * (sizeof(float) + 2 * sizeof(uint16_t)) > mem_limit) {
+            printf("%-7s %6d   skipped (A needs %zu MB)\n", "-", n,
+                   (elems * 8) >> 20);
+            continue;
+        }
+        A32 = bench_alloc(elems * sizeof(float));
+        x32 = bench_alloc((size_t)n * sizeof(float));
+        Abf = bench_alloc(elems * sizeof(bfloat16));
+        xbf = bench_alloc((size_t)n * sizeof(bfloat16));
+        Afp = bench_alloc(elems * sizeof(l2_fp16));
+        xfp = bench_alloc((size_t)n * sizeof(l2_fp16));
+        a.y = bench_alloc((size_t)n * sizeof(float));
+        if (!A32 || !x32 || !Abf || !xbf || !Afp || !xfp || !a.y) {
+            printf("bench_l2_half: allocation failed\n");
+            return 1;
+        }
+        /* entries of order 1/n: trmv iterates on y without blowing up */
+        bench_fill_s(A32, elems, 1);
+        for (size_t i = 0; i < elems; i++) A32[i] /= (float)n;
+        bench_fill_s(x32, (size_t)n, 2);
+        l2_sbstobf16((blasint)elems, A32, 1, Abf, 1);
+        l2_sbstobf16(n, x32, 1, xbf, 1);
+        l2_shstofp16((blasint)elems, A32, 1, Afp, 1);
+        l2_shstofp16(n, x32, 1, xfp, 1);
+        a.n = n;
+        a.sbgemv = ob_sbgemv();
+        a.A32 = A32; a.x32 = x32;
+        a.Abf = Abf; a.xbf = xbf;
+        a.Afp = Afp; a.xfp = xfp;
+
+        for (int op = 0; op < NOPS; op++) {
+            double sec[NIMPLS], best32 = 0.0;
+            /* matrix elements read; trmv/symv only the stored triangle */
+            double mat = op >= OP_SYMV ? 0.5 * (double)n * (n + 1)
+                                       : (double)elems;
+
+            a.op = op;
+            printf("%-7s %6d", op_name[op], n);
+            for (int im = 0; im < NIMPLS; im++) {
+                size_t es = im <= IM_L232 ? sizeof(float) : sizeof(uint16_t);
+                double bytes = mat * (double)es + 3.0 * n * sizeof(float);
+
+                sec[im] = 0.0;
+                if (!available(op, im)) {
+                    printf(" %9s", "-");
+                    continue;
+                }
+                a.impl = im;
+                bench_fill_s(a.y, (size_t)n, 3);
+                sec[im] = bench_run(call_half, &a);
+                if (im <= IM_L232 && (best32 == 0.0 || sec[im] < best32))
+                    best32 = sec[im];
+                printf(" %9.2f", bytes / sec[im] * 1e-9);
+            }
+            printf(" %9.2f\n", best32 / sec[IM_L2BF]);
+            fflush(stdout);
+        }
+
+        bench_free(A32); bench_free(x32);
+        bench_free(Abf); bench_free(xbf);
+        bench_free(Afp); bench_free(xfp);
+        bench_free(a.y);
+    }
+    return 0;
+}
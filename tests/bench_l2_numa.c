@@ -0,0 +1,134 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Threaded OpenBLAS dgemv on one large N x N matrix under each thread
+ * placement (l2_set_placement: NONE, COMPACT, SPREAD) and each way of
+ * initialising A:
+ *   main   - zeroed by the calling thread, so every page lands on its node
+ *   touch  - l2_first_touch, each gemv block's pages on its thread's node
+ * A is allocated afresh (untouched) for every row and first-touched by
+ * the blocks of that row's trans.  GB/s counts A read once per call; on a
+ * single-node machine the rows should agree.
+ *
+ * Usage: bench_l2_numa [N]   (default 8192; N = 30000 is 7.2 GB)
+ *
+ * Before the table, each policy's CPU and node per gemv block as read back
+ * from the threads (openblas_getaffinity; the caller for block 0).
+ */
+
+typedef struct {
+    enum CBLAS_TRANSPOSE trans;
+    int n;
+    const double *A, *x;
+    double *y;
+} numa_args;
+
+static void call_gemv(void *p) {
+    numa_args *a = p;
+    cblas_dgemv(CblasColMajor, a->trans, a->n, a->n, 1.0, a->A, a->n, a->x, 1,
+                0.0, a->y, 1);
+}
+
+/* The single CPU in set, or -1 for an unpinned thread. */
+static int pinned_cpu(const cpu_set_t *set) {
+    if (CPU_COUNT(set) != 1) return -1;
+    for (int c = 0; c < CPU_SETSIZE; c++)
+        if (CPU_ISSET(c, set)) return c;
+    return -1;
+}
+
+static void print_placement(const char *name, int nt) {
+    printf("%-8s", name);
+    for (int k = 0; k < nt; k++) {
+        cpu_set_t set;
+        int cpu = -1;
+
+        if (k == 0 ? sched_getaffinity(0, sizeof(set), &set) == 0
+                   : openblas_getaffinity(k - 1, sizeof(set), &set) == 0)
+            cpu = pinned_cpu(&set);
+        if (cpu < 0) printf(" %d:any", k);
+        else         printf(" %d:cpu%d/node%d", k, cpu, l2_cpu_node(cpu));
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    static const enum L2_PLACEMENT policies[3] = {L2_PLACE_NONE,
+                                                  L2_PLACE_COMPACT,
+                                                  L2_PLACE_SPREAD};
+    static const char *policy_name[3] = {"none", "compact", "spread"};
+    static const enum CBLAS_TRANSPOSE trans[2] = {CblasNoTrans, CblasTrans};
+    static const char *trans_name[2] = {"N", "T"};
+    int n = argc > 1 ? atoi(argv[1]) : 8192;
+    int nt = openblas_get_num_threads();
+    size_t a_bytes, rounded;
+    numa_args a;
+
+    if (n < 1) n = 1;
+    a_bytes = (size_t)n * (size_t)n * sizeof(double);
+    rounded = (a_bytes + 4095) & ~(size_t)4095;
+    a.n = n;
+    a.x = bench_alloc((size_t)n * sizeof(double));
+    a.y = bench_alloc((size_t)n * sizeof(double));
+    if (!a.x || !a.y) {
+        printf("bench_l2_numa: allocation failed\n");
+        return 1;
+    }
+    bench_fill_d((double *)a.x, n, 2);
+
+    printf("=== threaded dgemv GB/s by thread placement and first touch "
+           "(N=%d, %.2f GB, %d OpenBLAS threads) ===\n", n, a_bytes * 1e-9,
+           nt);
+    printf("OpenBLAS core: %s\n\n", openblas_get_corename());
+    printf("gemv block -> CPU/node\n");
+    for (int p = 0; p < 3; p++) {
+        if (l2_set_placement(policies[p]) != 0)
+            printf("%-8s placement failed\n", policy_name[p]);
+        else
+            print_placement(policy_name[p], nt);
+    }
+    printf("\n%-8s %-6s %-5s %10s %10s\n", "policy", "init", "trans",
+           "ms", "GB/s");
+
+    for (int p = 0; p < 3; p++) {
+        if (l2_set_placement(policies[p]) != 0) continue;
+        for (int init = 0; init < 2; init++)
+            for (int t = 0; t < 2; t++) {
+                /* page-aligned and never touched: placement is ours to make */
+                double *A = aligned_alloc(4096, rounded);
+                double sec;
+
+                if (!A) {
+                    printf("%-8s %-6s %-5s   skipped (allocation failed)\n",
+                           policy_name[p], init ? "touch" : "main",
+                           trans_name[t]);
+                    continue;
+                }
+                if (init)
+                    l2_first_touch(CblasColMajor, trans[t], n, n, A, n,
+                                   sizeof(double));
+                else
+                    memset(A, 0, a_bytes);
+                bench_fill_d(A, (size_t)n * n, 1);  /* pages stay put */
+                a.A = A;
+                a.trans = trans[t];
+                sec = bench_run(call_gemv, &a);
+                printf("%-8s %-6s %-5s %10.3f %10.2f\n", policy_name[p],
+                       init ? "touch" : "main", trans_name[t], sec * 1e3,
+                       (double)a_bytes / sec * 1e-9);
+                fflush(stdout);
+                free(A);
+            }
+    }
+    l2_set_placement(L2_PLACE_NONE);
+    bench_free((void *)a.x);
+    bench_free(a.y);
+    return 0;
+}
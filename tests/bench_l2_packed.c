@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Packed against full storage: each packed routine next to its full-storage
+ * counterpart (spmv/symv, tpmv/trmv, tpsv/trsv, spr/syr, spr2/syr2).
+ *
+ * Usage: bench_l2_packed [min_size [max_size]]   (powers of two)
+ *
+ * Columns: OpenBLAS full storage, OpenBLAS packed, l2blas packed.  GB/s
+ * counts the triangle once plus the vectors, the same bytes for both
+ * layouts, so the columns compare directly; "MB full/packed" is what the
+ * matrix itself occupies.  ColMajor Lower, unit increments.
+ */
+
+enum { SPMV, TPMV, TPSV, SPR, SPR2, NROUTINES };
+enum { FULL_OB, PACKED_OB, PACKED_L2, NLIBS };
+
+static const char *routine_name[NROUTINES] = {"spmv", "tpmv", "tpsv", "spr",
+                                              "spr2"};
+
+typedef struct {
+    int routine, lib, n;
+    char prec;
+    void *A, *Ap, *x, *x0, *y;
+    size_t xbytes;
+} packed_args;
+
+static void call_s(packed_args *a) {
+    const enum CBLAS_ORDER o = CblasColMajor;
+    const enum CBLAS_UPLO u = CblasLower;
+    const enum CBLAS_TRANSPOSE t = CblasNoTrans;
+    const enum CBLAS_DIAG d = CblasNonUnit;
+    int n = a->n, lib = a->lib;
+    float *A = a->A, *Ap = a->Ap, *x = a->x, *y = a->y;
+
+    switch (a->routine) {
+    case SPMV:
+        if (lib == FULL_OB) cblas_ssymv(o, u, n, 1.0f, A, n, x, 1, 0.5f, y, 1);
+        else if (lib == PACKED_OB) cblas_sspmv(o, u, n, 1.0f, Ap, x, 1, 0.5f, y, 1);
+        else l2_sspmv(o, u, n, 1.0f, Ap, x, 1, 0.5f, y, 1);
+        break;
+    case TPMV:
+        if (lib == FULL_OB) cblas_strmv(o, u, t, d, n, A, n, x, 1);
+        else if (lib == PACKED_OB) cblas_stpmv(o, u, t, d, n, Ap, x, 1);
+        else l2_stpmv(o, u, t, d, n, Ap, x, 1);
+        break;
+    case TPSV:
+        if (lib == FULL_OB) cblas_strsv(o, u, t, d, n, A, n, x, 1);
+        else if (lib == PACKED_OB) cblas_stpsv(o, u, t, d, n, Ap, x, 1);
+        else l2_stpsv(o, u, t, d, n, Ap, x, 1);
+        break;
+    case SPR:
+        if (lib == FULL_OB) cblas_ssyr(o, u, n, 1e-6f, x, 1, A, n);
+        else if (lib == PACKED_OB) cblas_sspr(o, u, n, 1e-6f, x, 1, Ap);
+        else l2_sspr(o, u, n, 1e-6f, x, 1, Ap);
+        break;
+    default:
+        if (lib == FULL_OB) cblas_ssyr2(o, u, n, 1e-6f, x, 1, y, 1, A, n);
+        else if (lib == PACKED_OB) cblas_sspr2(o, u, n, 1e-6f, x, 1, y, 1, Ap);
+        else l2_sspr2(o, u, n, 1e-6f, x, 1, y, 1, Ap);
+        break;
+    }
+}
+
+static void call_d(packed_args *a) {
+    const enum CBLAS_ORDER o = CblasColMajor;
+    const enum CBLAS_UPLO u = CblasLower;
+    const enum CBLAS_TRANSPOSE t = CblasNoTrans;
+    const enum CBLAS_DIAG d = CblasNonUnit;
+    int n = a->n, lib = a->lib;
+    double *A = a->A, *Ap = a->Ap, *x = a->x, *y = a->y;
+
+    switch (a->routine) {
+    case SPMV:
+        if (lib == FULL_OB) cblas_dsymv(o, u, n, 1.0, A, n, x, 1, 0.5, y, 1);
+        else if (lib == PACKED_OB) cblas_dspmv(o, u, n, 1.0, Ap, x, 1, 0.5, y, 1);
+        else l2_dspmv(o, u, n, 1.0, Ap, x, 1, 0.5, y, 1);
+        break;
+    case TPMV:
+        if (lib == FULL_OB) cblas_dtrmv(o, u, t, d, n, A, n, x, 1);
+        else if (lib == PACKED_OB) cblas_dtpmv(o, u, t, d, n, Ap, x, 1);
+        else l2_dtpmv(o, u, t, d, n, Ap, x, 1);
+        break;
+    case TPSV:
+        if (lib == FULL_OB) cblas_dtrsv(o, u, t, d, n, A, n, x, 1);
+        else if (lib == PACKED_OB) cblas_dtpsv(o, u, t, d, n, Ap, x, 1);
+        else l2_dtpsv(o, u, t, d, n, Ap, x, 1);
+        break;
+    case SPR:
+        if (lib == FULL_OB) cblas_dsyr(o, u, n, 1e-6, x, 1, A, n);
+        else if (lib == PACKED_OB) cblas_dspr(o, u, n, 1e-6, x, 1, Ap);
+        else l2_dspr(o, u, n, 1e-6, x, 1, Ap);
+        break;
+    default:
+        if (lib == FULL_OB) cblas_dsyr2(o, u, n, 1e-6, x, 1, y, 1, A, n);
+        else if (lib == PACKED_OB) cblas_dspr2(o, u, n, 1e-6, x, 1, y, 1, Ap);
+        else l2_dspr2(o, u, n, 1e-6, x, 1, y, 1, Ap);
+        break;
+    }
+}
+
+static void call_packed(void *p) {
+    packed_args *a = p;
+
+    /* tpmv/tpsv overwrite x; start every call from the same vector. */
+    if (a->routine == TPMV || a->routine == TPSV)
+        memcpy(a->x, a->x0, a->xbytes);
+    if (a->prec == 's') call_s(a);
+    else call_d(a);
+}
+
+/* Off-diagonal entries in [-1/n, 1/n), diagonal 2, in both layouts. */
+static void fill_lower(void *A, void *Ap, char prec, int n) {
+    size_t k = 0;
+
+    if (prec == 's') {
+        float *a = A, *ap = Ap;
+        bench_fill_s(a, (size_t)n * n, 1);
+        for (int j = 0; j < n; j++) {
+            for (int i = j; i < n; i++) {
+                float *aij = &a[(size_t)j * n + i];
+                *aij = i == j ? 2.0f : *aij / (float)n;
+                ap[k++] = *aij;
+            }
+        }
+    } else {
+        double *a = A, *ap = Ap;
+        bench_fill_d(a, (size_t)n * n, 1);
+        for (int j = 0; j < n; j++) {
+            for (int i = j; i < n; i++) {
+                double *aij = &a[(size_t)j * n + i];
+                *aij = i == j ? 2.0 : *aij / (double)n;
+                ap[k++] = *aij;
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    static const char precs[] = {'s', 'd'};
+    int min_size = argc > 1 ? atoi(argv[1]) : 64;
+    int max_size = argc > 2 ? atoi(argv[2]) : 4096;
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+
+    if (min_size < 1) min_size = 1;
+
+    printf("=== packed vs full storage (GB/s, triangle counted once) ===\n");
+    printf("OpenBLAS core: %s, l2blas core: %s, ColMajor Lower\n\n",
+           openblas_get_corename(), l2_get_corename());
+    printf("%-4s %-5s %6s %15s %10s %10s %10s %9s\n", "prec", "rout", "N",
+           "MB full/packed", "full OB", "packed OB", "packed l2", "l2/OB");
+
+    for (int p = 0; p < 2; p++) {
+        size_t es = precs[p] == 's' ? sizeof(float) : sizeof(double);
+        for (int n = min_size; n <= max_size; n *= 2) {
+            size_t full_bytes = (size_t)n * (size_t)n * es;
+            size_t packed_bytes = (size_t)n * (size_t)(n + 1) / 2 * es;
+            double tri = (double)packed_bytes;
+            packed_args a;
+
+            if (full_bytes + packed_bytes > mem_limit) {
+                printf("%-4c %-5s %6d   skipped (needs %zu MB)\n", precs[p],
+                       "-", n, (full_bytes + packed_bytes) >> 20);
+                continue;
+            }
+            a.prec = precs[p];
+            a.n = n;
+            a.xbytes = (size_t)n * es;
+            a.A = bench_alloc(full_bytes);
+            a.Ap = bench_alloc(packed_bytes);
+            a.x = bench_alloc(a.xbytes);
+            a.x0 = bench_alloc(a.xbytes);
+            a.y = bench_alloc(a.xbytes);
+            if (!a.A || !a.Ap || !a.x || !a.x0 || !a.y) {
+                printf("%-4c %-5s %6d   skipped (allocation failed)\n",
+                       precs[p], "-", n);
+                bench_free(a.A); bench_free(a.Ap); bench_free(a.x);
+                bench_free(a.x0); bench_free(a.y);
+                continue;
+            }
+            fill_lower(a.A, a.Ap, precs[p], n);
+            if (precs[p] == 's') {
+                bench_fill_s(a.x0, (size_t)n, 2);
+                bench_fill_s(a.y, (size_t)n, 3);
+            } else {
+                bench_fill_d(a.x0, (size_t)n, 2);
+                bench_fill_d(a.y, (size_t)n, 3);
+            }
+            memcpy(a.x, a.x0, a.xbytes);
+
+            for (int r = 0; r < NROUTINES; r++) {
+                /* Updates read and write the triangle; the rest read it. */
+                double vecs = r == SPMV || r == SPR2 ? 3.0 : 2.0;
+                double bytes = (r >= SPR ? 2.0 : 1.0) * tri +
+                               vecs * (double)n * (double)es;
+                double gbs[NLIBS];
+
+                a.routine = r;
+                for (int lib = 0; lib < NLIBS; lib++) {
+                    a.lib = lib;
+                    gbs[lib] = bytes / bench_run(call_packed, &a) * 1e-9;
+                }
+                printf("%-4c %-5s %6d %7.1f/%-7.1f %10.2f %10.2f %10.2f %8.2fx\n",
+                       precs[p], routine_name[r], n, full_bytes / 1048576.0,
+                       packed_bytes / 1048576.0, gbs[FULL_OB], gbs[PACKED_OB],
+                       gbs[PACKED_L2], gbs[PACKED_L2] / gbs[PACKED_OB]);
+                fflush(stdout);
+            }
+            bench_free(a.A); bench_free(a.Ap); bench_free(a.x);
+            bench_free(a.x0); bench_free(a.y);
+        }
+        printf("\n");
+    }
+    return 0;
+}
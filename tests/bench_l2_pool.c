@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * C application threads issue threaded N x N dger updates at the same
+ * time, each on its own matrix, for C = 1, 2, 4, ..., max_callers:
+ *   OpenBLAS  - cblas_dger on OpenBLAS' own threads
+ *   l2blas    - l2_dger on the l2blas work-stealing pool
+ *   OB/pool   - cblas_dger with the pool registered as OpenBLAS' threading
+ *               backend (l2_set_openblas_threads); "-" where the linked
+ *               OpenBLAS has no openblas_set_threads_callback_function
+ * Both libraries get nproc threads.  Per-call latency is reported as p50,
+ * p99 and max over all calls of all callers, and "thr" is the most threads
+ * the process had while the callers ran (callers and main included), so
+ * growth with C is oversubscription.
+ *
+ * Usage: bench_l2_pool [N [max_callers [calls]]]
+ *        (defaults 1024, 2 * nproc, 20 calls per caller)
+ */
+
+enum { HOW_OB, HOW_L2, HOW_OB_POOL, NHOWS };
+
+typedef struct {
+    int how, n, calls;
+    double *A, *x, *y;
+    double *lat;                /* calls latencies, seconds */
+} pool_caller;
+
+static volatile int callers_running;
+
+static int count_threads(void) {
+    DIR *d = opendir("/proc/self/task");
+    struct dirent *e;
+    int n = 0;
+
+    if (!d) return -1;
+    while ((e = readdir(d)))
+        n += e->d_name[0] != '.';
+    closedir(d);
+    return n;
+}
+
+static void *caller_main(void *p) {
+    pool_caller *c = p;
+    int n = c->n;
+
+    for (int k = 0; k < c->calls; k++) {
+        double t0 = bench_now();
+        if (c->how == HOW_L2)
+            l2_dger(CblasColMajor, n, n, 1e-4, c->x, 1, c->y, 1, c->A, n);
+        else
+            cblas_dger(CblasColMajor, n, n, 1e-4, c->x, 1, c->y, 1, c->A, n);
+        c->lat[k] = bench_now() - t0;
+    }
+    __atomic_fetch_sub(&callers_running, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Runs ncallers callers to completion; fills lat and returns peak threads. */
+static int run_callers(pool_caller *c, int ncallers, int how, double *wall) {
+    pthread_t th[256];
+    int peak = count_threads(), started = 0;
+    double t0 = bench_now();
+
+    callers_running = ncallers;
+    for (int i = 0; i < ncallers; i++) {
+        c[i].how = how;
+        if (pthread_create(&th[i], NULL, caller_main, &c[i]) != 0) {
+            __atomic_fetch_sub(&callers_running, ncallers - i,
+                               __ATOMIC_RELEASE);
+            break;
+        }
+        started++;
+    }
+    while (__atomic_load_n(&callers_running, __ATOMIC_ACQUIRE) > 0) {
+        int t = count_threads();
+        if (t > peak) peak = t;
+        nanosleep(&(struct timespec){0, 200000}, NULL);
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(th[i], NULL);
+    *wall = bench_now() - t0;
+    return started == ncallers ? peak : -1;
+}
+
+int main(int argc, char **argv) {
+    static const char *how_name[NHOWS] = {"OpenBLAS", "l2blas", "OB/pool"};
+    int nproc = l2_get_num_threads();
+    int n = argc > 1 ? atoi(argv[1]) : 1024;
+    int max_callers = argc > 2 ? atoi(argv[2]) : 2 * nproc;
+    int calls = argc > 3 ? atoi(argv[3]) : 20;
+    int hook = l2_set_openblas_threads(0) == 0;
+    pool_caller *c;
+    double *lat;
+
+    if (n < 1) n = 1;
+    if (max_callers < 1) max_callers = 1;
+    if (max_callers > 256) max_callers = 256;
+    if (calls < 1) calls = 1;
+
+    c = calloc((size_t)max_callers, sizeof(*c));
+    lat = malloc((size_t)max_callers * calls * sizeof(double));
+    if (!c || !lat) {
+        printf("bench_l2_pool: allocation failed\n");
+        return 1;
+    }
+    for (int i = 0; i < max_callers; i++) {
+        c[i].n = n;
+        c[i].calls = calls;
+        c[i].lat = lat + (size_t)i * calls;
+        c[i].A = bench_alloc((size_t)n * n * sizeof(double));
+        c[i].x = bench_alloc((size_t)n * sizeof(double));
+        c[i].y = bench_alloc((size_t)n * sizeof(double));
+        if (!c[i].A || !c[i].x || !c[i].y) {
+            printf("bench_l2_pool: allocation failed\n");
+            return 1;
+        }
+        bench_fill_d(c[i].A, (size_t)n * n, 1 + i);
+        bench_fill_d(c[i].x, n, 2);
+        bench_fill_d(c[i].y, n, 3);
+    }
+    openblas_set_num_threads(nproc);
+
+    printf("=== concurrent callers of threaded dger (N=%d, %d threads, "
+           "%d calls each) ===\n", n, nproc, calls);
+    printf("OpenBLAS core: %s, l2blas auto core: %s, OpenBLAS callback "
+           "hook: %s\n\n", openblas_get_corename(), l2_get_corename(),
+           hook ? "yes" : "no");
+    printf("%-9s %7s %9s %9s %9s %10s %5s\n", "backend", "callers",
+           "p50 ms", "p99 ms", "max ms", "calls/s", "thr");
+
+    for (int nc = 1;; nc *= 2) {
+        if (nc > max_callers) nc = max_callers;
+        for (int how = 0; how < NHOWS; how++) {
+            size_t total = (size_t)nc * calls;
+            double wall;
+            int peak;
+
+            if (how == HOW_OB_POOL && !hook) {
+                printf("%-9s %7d %9s %9s %9s %10s %5s\n", how_name[how], nc,
+                       "-", "-", "-", "-", "-");
+                continue;
+            }
+            if (how == HOW_OB_POOL) l2_set_openblas_threads(1);
+            peak = run_callers(c, nc, how, &wall);
+            if (how == HOW_OB_POOL) l2_set_openblas_threads(0);
+            if (peak < 0) {
+                printf("%-9s %7d   skipped (thread creation failed)\n",
+                       how_name[how], nc);
+                continue;
+            }
+            qsort(lat, total, sizeof(double), cmp_double);
+            printf("%-9s %7d %9.3f %9.3f %9.3f %10.1f %5d\n", how_name[how],
+                   nc, lat[total / 2] * 1e3, lat[(total * 99) / 100] * 1e3,
+                   lat[total - 1] * 1e3, (double)total / wall, peak);
+            fflush(stdout);
+        }
+        printf("\n");
+        if (nc == max_callers) break;
+    }
+    for (int i = 0; i < max_callers; i++) {
+        bench_free(c[i].A);
+        bench_free(c[i].x);
+        bench_free(c[i].y);
+    }
+    free(c);
+    free(lat);
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * int8 weights against fp32: gemv NoTrans and Trans on an N x N RowMajor
+ * matrix held as float and quantized once by l2_sq8_quantize.
+ *
+ * Usage: bench_l2_q8gemv [min_size [max_size [block]]]
+ *        (powers of two; block 0, the default, is a scale per row)
+ *
+ * Columns:
+ *   OB f32, l2 f32   cblas_sgemv and l2_sgemv
+ *   q8 int32         l2_sq8gemv, x rounded to int8, int32 products
+ *                    (NoTrans only; Trans always accumulates in fp32)
+ *   q8 fp32          l2_sq8gemv, A widened to float
+ * as GB/s of the bytes each one reads (A at its element size, x and y),
+ * q8/f32, the time of the faster fp32 column over the faster q8 one: up to
+ * 4 once A is out of cache; and err, the relative 2-norm difference of the
+ * q8 fp32 (Trans) or int32 (NoTrans) y from cblas_sgemv's.
+ */
+
+enum { IM_OB32, IM_L232, IM_Q8I, IM_Q8F, NIMPLS };
+
+typedef struct {
+    int impl, n;
+    enum CBLAS_TRANSPOSE trans;
+    const float *A, *x;
+    const l2_sq8mat *qa;
+    float *y;
+} q8_args;
+
+static void call_q8(void *p) {
+    q8_args *a = p;
+    int n = a->n;
+
+    switch (a->impl) {
+    case IM_OB32: cblas_sgemv(CblasRowMajor, a->trans, n, n, 1.0f, a->A, n,
+                              a->x, 1, 0.5f, a->y, 1); break;
+    case IM_L232: l2_sgemv(CblasRowMajor, a->trans, n, n, 1.0f, a->A, n,
+                           a->x, 1, 0.5f, a->y, 1); break;
+    case IM_Q8I:  l2_sq8gemv(a->trans, L2_Q8_INT32, 1.0f, a->qa, a->x, 1,
+                             0.5f, a->y, 1); break;
+    default:      l2_sq8gemv(a->trans, L2_Q8_FP32, 1.0f, a->qa, a->x, 1,
+                             0.5f, a->y, 1); break;
+    }
+}
+
+static double rel_err(const float *y, const float *ref, int n) {
+    double num = 0.0, den = 0.0;
+
+    for (int i = 0; i < n; i++) {
+        num += ((double)y[i] - ref[i]) * ((double)y[i] - ref[i]);
+        den += (double)ref[i] * ref[i];
+    }
+    return den > 0.0 ? sqrt(num / den) : 0.0;
+}
+
+int main(int argc, char **argv) {
+    int min_size = argc > 1 ? atoi(argv[1]) : 256;
+    int max_size = argc > 2 ? atoi(argv[2]) : 8192;
+    int block = argc > 3 ? atoi(argv[3]) : 0;
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+
+    if (min_size < 1) min_size = 1;
+    if (block < 0 || block % 32 != 0) {
+        printf("bench_l2_q8gemv: block must be a multiple of 32\n");
+        return 1;
+    }
+
+    printf("=== int8 weights vs fp32 gemv, %s (GB/s) ===\n",
+           block ? "scale per block" : "scale per row");
+    if (block) printf("block: %d columns\n", block);
+    printf("OpenBLAS core: %s, l2blas core: %s\n\n", openblas_get_corename(),
+           l2_get_corename());
+    printf("%-7s %6s %9s %9s %9s %9s %9s %9s\n", "op", "N", "OB f32",
+           "l2 f32", "q8 int32", "q8 fp32", "q8/f32", "err");
+
+    for (int n = min_size; n <= max_size; n *= 2) {
+        size_t elems = (size_t)n * (size_t)n;
+        size_t lwork = L2_Q8_LWORK(n, n, block);
+        float *A, *x, *yref;
+        void *work;
+        l2_sq8mat qa;
+        q8_args a;
+
+        if (elems * sizeof(float) + lwork > mem_limit) {
+            printf("%-7s %6d   skipped (A needs %zu MB)\n", "-", n,
+                   (elems * 5) >> 20);
+            continue;
+        }
+        A = bench_alloc(elems * sizeof(float));
+        x = bench_alloc((size_t)n * sizeof(float));
+        yref = bench_alloc((size_t)n * sizeof(float));
+        a.y = bench_alloc((size_t)n * sizeof(float));
+        work = bench_alloc(lwork);
+        if (!A || !x || !yref || !a.y || !work) {
+            printf("bench_l2_q8gemv: allocation failed\n");
+            return 1;
+        }
+        bench_fill_s(A, elems, 1);
+        bench_fill_s(x, (size_t)n, 2);
+        l2_sq8_quantize(&qa, CblasRowMajor, n, n, A, n, block, work, lwork);
+        a.n = n;
+        a.A = A;
+        a.x = x;
+        a.qa = &qa;
+
+        for (int t = 0; t < 2; t++) {
+            double sec[NIMPLS], best32, bestq;
+            int q8acc = t ? IM_Q8F : IM_Q8I;
+
+            a.trans = t ? CblasTrans : CblasNoTrans;
+            printf("%-7s %6d", t ? "gemv T" : "gemv N", n);
+            for (int im = 0; im < NIMPLS; im++) {
+                size_t es = im <= IM_L232 ? sizeof(float) : 1;
+                double bytes = (double)elems * es + 3.0 * n * sizeof(float);
+
+                sec[im] = 0.0;
+                if (t && im == IM_Q8I) {
+                    printf(" %9s", "-");
+                    continue;
+                }
+                a.impl = im;
+                bench_fill_s(a.y, (size_t)n, 3);
+                sec[im] = bench_run(call_q8, &a);
+                printf(" %9.2f", bytes / sec[im] * 1e-9);
+            }
+            best32 = fmin(sec[IM_OB32], sec[IM_L232]);
+            bestq = t ? sec[IM_Q8F] : fmin(sec[IM_Q8I], sec[IM_Q8F]);
+
+            /* one call each from the same y for the error column */
+            bench_fill_s(yref, (size_t)n, 3);
+            bench_fill_s(a.y, (size_t)n, 3);
+            cblas_sgemv(CblasRowMajor, a.trans, n, n, 1.0f, A, n, x, 1, 0.5f,
+                        yref, 1);
+            a.impl = q8acc;
+            call_q8(&a);
+            printf(" %9.2f %9.2e\n", best32 / bestq, rel_err(a.y, yref, n));
+            fflush(stdout);
+        }
+
+        bench_free(A);
+        bench_free(x);
+        bench_free(yref);
+        bench_free(a.y);
+        bench_free(work);
+    }
+    return 0;
+}
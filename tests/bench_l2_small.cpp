@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+#include "l2blas/l2blas_small.hpp"
+
+/*
+ * Latency of one tiny gemv/symv/trmv, in ns per call, for square orders
+ * 2..16 (ColMajor; gemv NoTrans, symv Lower, trmv Upper NoTrans NonUnit):
+ *   OpenBLAS  - cblas_?xxx from the linked OpenBLAS
+ *   l2blas    - l2_?xxx (gemv and symv only)
+ *   fixed     - l2::xxx<n>, the order a compile-time constant
+ *   runtime   - l2::xxx(..., n, ...), the switch over n in front of it
+ *
+ * Usage: bench_l2_small [max_n]   (default 16)
+ *
+ * Each timed call is followed by a compiler barrier, so the inlined kernels
+ * cannot be hoisted out of the loop or merged with the next call.  trmv
+ * works in place and restores x before every call (all four columns pay
+ * that copy).
+ */
+
+#define REPS 256
+
+enum { OP_SGEMV, OP_DGEMV, OP_SSYMV, OP_DSYMV, OP_STRMV, OP_DTRMV, NOPS };
+enum { HOW_OB, HOW_L2, HOW_FIXED, HOW_RUNTIME, NHOWS };
+
+typedef struct {
+    int op, how, n;
+    float *sa, *sx, *sx0, *sy;
+    double *da, *dx, *dx0, *dy;
+} small_args;
+
+#define BARRIER() __asm__ __volatile__("" ::: "memory")
+
+static void restore_x(small_args *a) {
+    for (int i = 0; i < a->n; i++) {
+        if (a->op == OP_STRMV) a->sx[i] = a->sx0[i];
+        else                   a->dx[i] = a->dx0[i];
+    }
+}
+
+template <int OP, int N>
+static void call_fixed(small_args *a) {
+    const CBLAS_ORDER o = CblasColMajor;
+
+    for (int r = 0; r < REPS; r++) {
+        if constexpr (OP == OP_SGEMV) {
+            l2::gemv<N, N>(o, CblasNoTrans, 1.0f, a->sa, N, a->sx, 1, 0.0f,
+                           a->sy, 1);
+        } else if constexpr (OP == OP_DGEMV) {
+            l2::gemv<N, N>(o, CblasNoTrans, 1.0, a->da, N, a->dx, 1, 0.0,
+                           a->dy, 1);
+        } else if constexpr (OP == OP_SSYMV) {
+            l2::symv<N>(o, CblasLower, 1.0f, a->sa, N, a->sx, 1, 0.0f, a->sy,
+                        1);
+        } else if constexpr (OP == OP_DSYMV) {
+            l2::symv<N>(o, CblasLower, 1.0, a->da, N, a->dx, 1, 0.0, a->dy, 1);
+        } else if constexpr (OP == OP_STRMV) {
+            restore_x(a);
+            l2::trmv<N>(o, CblasUpper, CblasNoTrans, CblasNonUnit, a->sa, N,
+                        a->sx, 1);
+        } else {
+            restore_x(a);
+            l2::trmv<N>(o, CblasUpper, CblasNoTrans, CblasNonUnit, a->da, N,
+                        a->dx, 1);
+        }
+        BARRIER();
+    }
+}
+
+typedef void (*fixed_fn)(small_args *a);
+
+/* One instance per op and order, so no kernel shares code with another. */
+#define FIXED_ROW(op) \
+    {NULL,                NULL,                call_fixed<op, 2>, \
+     call_fixed<op, 3>,   call_fixed<op, 4>,   call_fixed<op, 5>, \
+     call_fixed<op, 6>,   call_fixed<op, 7>,   call_fixed<op, 8>, \
+     call_fixed<op, 9>,   call_fixed<op, 10>,  call_fixed<op, 11>, \
+     call_fixed<op, 12>,  call_fixed<op, 13>,  call_fixed<op, 14>, \
+     call_fixed<op, 15>,  call_fixed<op, 16>}
+
+static const fixed_fn fixed_tab[NOPS][L2_SMALL_MAX + 1] = {
+    FIXED_ROW(OP_SGEMV), FIXED_ROW(OP_DGEMV), FIXED_ROW(OP_SSYMV),
+    FIXED_ROW(OP_DSYMV), FIXED_ROW(OP_STRMV), FIXED_ROW(OP_DTRMV)
+};
+
+static void call_small(void *p) {
+    small_args *a = (small_args *)p;
+    const CBLAS_ORDER o = CblasColMajor;
+    int n = a->n;
+
+    if (a->how == HOW_FIXED) {
+        fixed_tab[a->op][n](a);
+        return;
+    }
+    for (int r = 0; r < REPS; r++) {
+        switch (a->op * NHOWS + a->how) {
+        case OP_SGEMV * NHOWS + HOW_OB:
+            cblas_sgemv(o, CblasNoTrans, n, n, 1.0f, a->sa, n, a->sx, 1, 0.0f,
+                        a->sy, 1);
+            break;
+        case OP_SGEMV * NHOWS + HOW_L2:
+            l2_sgemv(o, CblasNoTrans, n, n, 1.0f, a->sa, n, a->sx, 1, 0.0f,
+                     a->sy, 1);
+            break;
+        case OP_SGEMV * NHOWS + HOW_RUNTIME:
+            l2::gemv(o, CblasNoTrans, n, n, 1.0f, a->sa, n, a->sx, 1, 0.0f,
+                     a->sy, 1);
+            break;
+        case OP_DGEMV * NHOWS + HOW_OB:
+            cblas_dgemv(o, CblasNoTrans, n, n, 1.0, a->da, n, a->dx, 1, 0.0,
+                        a->dy, 1);
+            break;
+        case OP_DGEMV * NHOWS + HOW_L2:
+            l2_dgemv(o, CblasNoTrans, n, n, 1.0, a->da, n, a->dx, 1, 0.0,
+                     a->dy, 1);
+            break;
+        case OP_DGEMV * NHOWS + HOW_RUNTIME:
+            l2::gemv(o, CblasNoTrans, n, n, 1.0, a->da, n, a->dx, 1, 0.0,
+                     a->dy, 1);
+            break;
+        case OP_SSYMV * NHOWS + HOW_OB:
+            cblas_ssymv(o, CblasLower, n, 1.0f, a->sa, n, a->sx, 1, 0.0f,
+                        a->sy, 1);
+            break;
+        case OP_SSYMV * NHOWS + HOW_L2:
+            l2_ssymv(o, CblasLower, n, 1.0f, a->sa, n, a->sx, 1, 0.0f, a->sy,
+                     1);
+            break;
+        case OP_SSYMV * NHOWS + HOW_RUNTIME:
+            l2::symv(o, CblasLower, n, 1.0f, a->sa, n, a->sx, 1, 0.0f, a->sy,
+                     1);
+            break;
+        case OP_DSYMV * NHOWS + HOW_OB:
+            cblas_dsymv(o, CblasLower, n, 1.0, a->da, n, a->dx, 1, 0.0, a->dy,
+                        1);
+            break;
+        case OP_DSYMV * NHOWS + HOW_L2:
+            l2_dsymv(o, CblasLower, n, 1.0, a->da, n, a->dx, 1, 0.0, a->dy, 1);
+            break;
+        case OP_DSYMV * NHOWS + HOW_RUNTIME:
+            l2::symv(o, CblasLower, n, 1.0, a->da, n, a->dx, 1, 0.0, a->dy, 1);
+            break;
+        case OP_STRMV * NHOWS + HOW_OB:
+            restore_x(a);
+            cblas_strmv(o, CblasUpper, CblasNoTrans, CblasNonUnit, n, a->sa,
+                        n, a->sx, 1);
+            break;
+        case OP_STRMV * NHOWS + HOW_RUNTIME:
+            restore_x(a);
+            l2::trmv(o, CblasUpper, CblasNoTrans, CblasNonUnit, n, a->sa, n,
+                     a->sx, 1);
+            break;
+        case OP_DTRMV * NHOWS + HOW_OB:
+            restore_x(a);
+            cblas_dtrmv(o, CblasUpper, CblasNoTrans, CblasNonUnit, n, a->da,
+                        n, a->dx, 1);
+            break;
+        case OP_DTRMV * NHOWS + HOW_RUNTIME:
+            restore_x(a);
+            l2::trmv(o, CblasUpper, CblasNoTrans, CblasNonUnit, n, a->da, n,
+                     a->dx, 1);
+            break;
+        }
+        BARRIER();
+    }
+}
+
+int main(int argc, char **argv) {
+    static const char *op_name[NOPS] = {"sgemv", "dgemv", "ssymvL", "dsymvL",
+                                        "strmvU", "dtrmvU"};
+    int max_n = argc > 1 ? atoi(argv[1]) : L2_SMALL_MAX;
+    small_args a;
+
+    if (max_n < 2) max_n = 2;
+    if (max_n > L2_SMALL_MAX) max_n = L2_SMALL_MAX;
+
+    a.sa = (float *)bench_alloc(L2_SMALL_MAX * L2_SMALL_MAX * sizeof(float));
+    a.da = (double *)bench_alloc(L2_SMALL_MAX * L2_SMALL_MAX * sizeof(double));
+    a.sx = (float *)bench_alloc(4 * L2_SMALL_MAX * sizeof(float));
+    a.dx = (double *)bench_alloc(4 * L2_SMALL_MAX * sizeof(double));
+    if (!a.sa || !a.da || !a.sx || !a.dx) {
+        printf("bench_l2_small: allocation failed\n");
+        return 1;
+    }
+    a.sx0 = a.sx + L2_SMALL_MAX;
+    a.sy = a.sx + 2 * L2_SMALL_MAX;
+    a.dx0 = a.dx + L2_SMALL_MAX;
+    a.dy = a.dx + 2 * L2_SMALL_MAX;
+    bench_fill_s(a.sa, L2_SMALL_MAX * L2_SMALL_MAX, 1);
+    bench_fill_d(a.da, L2_SMALL_MAX * L2_SMALL_MAX, 1);
+    bench_fill_s(a.sx, 2 * L2_SMALL_MAX, 2);
+    bench_fill_d(a.dx, 2 * L2_SMALL_MAX, 2);
+
+    printf("=== fixed-size C++ kernels vs library calls "
+           "(ns per call, ColMajor) ===\n");
+    printf("OpenBLAS core: %s, l2blas auto core: %s\n\n",
+           openblas_get_corename(), l2_get_corename());
+    printf("%-7s %3s %10s %10s %10s %10s %9s\n", "op", "n", "OpenBLAS",
+           "l2blas", "fixed", "runtime", "OB/fixed");
+
+    for (int op = 0; op < NOPS; op++) {
+        for (int n = 2; n <= max_n; n++) {
+            double ns[NHOWS];
+
+            a.op = op;
+            a.n = n;
+            for (int how = 0; how < NHOWS; how++) {
+                if (how == HOW_L2 && (op == OP_STRMV || op == OP_DTRMV)) {
+                    ns[how] = 0.0;
+                    continue;
+                }
+                a.how = how;
+                ns[how] = bench_run(call_small, &a) / REPS * 1e9;
+            }
+            printf("%-7s %3d %10.1f", op_name[op], n, ns[HOW_OB]);
+            if (ns[HOW_L2] > 0.0) printf(" %10.1f", ns[HOW_L2]);
+            else                  printf(" %10s", "-");
+            printf(" %10.1f %10.1f %8.1fx\n", ns[HOW_FIXED], ns[HOW_RUNTIME],
+                   ns[HOW_OB] / ns[HOW_FIXED]);
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+    bench_free(a.sa);
+    bench_free(a.da);
+    bench_free(a.sx);
+    bench_free(a.dx);
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Out-of-core dgemv on a square matrix in a file, every pass from a cold
+ * page cache:
+ *   read      - sequential read() of the whole file into one buffer: the
+ *               rate the device gives, and the ceiling for the rest
+ *   mapped N  - l2_dgemv_mapped, NoTrans
+ *   mapped T  - l2_dgemv_mapped, Trans
+ *   mmap+cblas - the whole file mapped at once, then cblas_dgemv NoTrans
+ * GB/s counts the matrix bytes; "% read" is against the read pass.  Before
+ * each pass the file is fsync'ed and dropped from the page cache with
+ * posix_fadvise, which is as cold as an unprivileged process can make it;
+ * on tmpfs nothing is dropped and every rate is a memory rate.
+ *
+ * Usage: bench_l2_stream [size_mb [file]]   (default 256 MB, a temporary
+ * file under $TMPDIR or /tmp, removed afterwards).  A given file is used
+ * as is when it is large enough, otherwise written; it is never removed.
+ * Pick a size above RAM to see the out-of-core case itself.
+ */
+
+#define CHUNK ((size_t)8 << 20)
+
+static void drop_cache(int fd) {
+    fsync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+/* Fills the first n * n doubles of fd in CHUNK pieces. */
+static int write_matrix(int fd, int n, double *buf) {
+    size_t total = (size_t)n * n * sizeof(double), done = 0;
+    unsigned seed = 1;
+
+    if (lseek(fd, 0, SEEK_SET) != 0) return 0;
+    while (done < total) {
+        size_t len = total - done < CHUNK ? total - done : CHUNK;
+        const char *p = (const char *)buf;
+
+        bench_fill_d(buf, len / sizeof(double), seed++);
+        for (size_t left = len; left > 0;) {
+            ssize_t w = write(fd, p, left);
+            if (w <= 0) return 0;
+            p += w;
+            left -= (size_t)w;
+        }
+        done += len;
+    }
+    return 1;
+}
+
+static double read_pass(int fd, size_t total, double *buf) {
+    double t0 = bench_now();
+
+    for (size_t done = 0; done < total;) {
+        ssize_t r = pread(fd, buf, CHUNK, (off_t)done);
+        if (r <= 0) return -1;
+        done += (size_t)r;
+    }
+    return bench_now() - t0;
+}
+
+static double mmap_cblas_pass(int fd, int n, const double *x, double *y) {
+    size_t total = (size_t)n * n * sizeof(double);
+    double t0 = bench_now();
+    void *map = mmap(NULL, total, PROT_READ, MAP_SHARED, fd, 0);
+
+    if (map == MAP_FAILED) return -1;
+    madvise(map, total, MADV_SEQUENTIAL);
+    cblas_dgemv(CblasColMajor, CblasNoTrans, n, n, 1.0, map, n, x, 1, 0.0,
+                y, 1);
+    munmap(map, total);
+    return bench_now() - t0;
+}
+
+static void report(const char *name, size_t bytes, double t, double base) {
+    if (t <= 0) {
+        printf("%-11s %9s\n", name, "failed");
+        return;
+    }
+    printf("%-11s %9.3f %9.3f %8.1f\n", name, t, bytes / t * 1e-9,
+           base > 0 ? 100.0 * base / t : 0.0);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    long mb = argc > 1 ? atol(argv[1]) : 256;
+    const char *file = argc > 2 && *argv[2] ? argv[2] : NULL;
+    const char *dir = getenv("TMPDIR");
+    char path[512];
+    size_t total;
+    double *buf, *x, *y, *yref, t_read, t, err = 0, ymax = 0;
+    int n, fd;
+    off_t have;
+
+    if (mb < 1) mb = 1;
+    n = (int)sqrt((double)mb * (1 << 20) / sizeof(double));
+    total = (size_t)n * n * sizeof(double);
+
+    if (file) {
+        snprintf(path, sizeof(path), "%s", file);
+        fd = open(path, O_RDWR | O_CREAT, 0644);
+    } else {
+        snprintf(path, sizeof(path), "%s/l2stream.XXXXXX",
+                 dir && *dir ? dir : "/tmp");
+        fd = mkstemp(path);
+    }
+    buf = bench_alloc(CHUNK);
+    x = bench_alloc((size_t)n * sizeof(double));
+    y = bench_alloc((size_t)n * sizeof(double));
+    yref = bench_alloc((size_t)n * sizeof(double));
+    if (fd < 0 || !buf || !x || !y || !yref) {
+        printf("skipped (%s)\n", fd < 0 ? strerror(errno)
+                                        : "allocation failed");
+        return 1;
+    }
+    bench_fill_d(x, (size_t)n, 7);
+
+    have = lseek(fd, 0, SEEK_END);
+    if ((!file || have < (off_t)total) && !write_matrix(fd, n, buf)) {
+        printf("skipped (writing %s: %s)\n", path, strerror(errno));
+        if (!file) unlink(path);
+        return 1;
+    }
+
+    printf("=== out-of-core dgemv, N=%d, %.1f MB in %s ===\n", n,
+           total / 1048576.0, path);
+    printf("OpenBLAS core: %s, l2blas core: %s, %d l2blas threads\n\n",
+           openblas_get_corename(), l2_get_corename(), l2_get_num_threads());
+    printf("%-11s %9s %9s %8s\n", "pass", "seconds", "GB/s", "% read");
+
+    drop_cache(fd);
+    t_read = read_pass(fd, total, buf);
+    report("read", total, t_read, t_read);
+
+    drop_cache(fd);
+    t = bench_now();
+    if (l2_dgemv_mapped(CblasColMajor, CblasNoTrans, n, n, 1.0, fd, 0, n, x,
+                        1, 0.0, y, 1) != 0)
+        t = -1;
+    else
+        t = bench_now() - t;
+    report("mapped N", total, t, t_read);
+
+    drop_cache(fd);
+    t = bench_now();
+    if (l2_dgemv_mapped(CblasColMajor, CblasTrans, n, n, 1.0, fd, 0, n, x,
+                        1, 0.0, yref, 1) != 0)
+        t = -1;
+    else
+        t = bench_now() - t;
+    report("mapped T", total, t, t_read);
+
+    drop_cache(fd);
+    t = mmap_cblas_pass(fd, n, x, yref);
+    report("mmap+cblas", total, t, t_read);
+
+    /* mapped N against the mmap + cblas result */
+    for (int i = 0; i < n; i++) {
+        if (fabs(yref[i]) > ymax) ymax = fabs(yref[i]);
+        if (fabs(y[i] - yref[i]) > err) err = fabs(y[i] - yref[i]);
+    }
+    printf("\nmapped N vs cblas_dgemv: max |diff| %.3g (max |y| %.3g)\n",
+           err, ymax);
+
+    drop_cache(fd);
+    close(fd);
+    if (!file) unlink(path);
+    bench_free(buf);
+    bench_free(x);
+    bench_free(y);
+    bench_free(yref);
+    return 0;
+}
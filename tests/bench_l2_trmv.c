@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2test.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Blocked in-place l2_?trmv against the linked OpenBLAS trmv, with the
+ * heap allocations each makes per call.
+ *
+ * Usage: bench_l2_trmv [min_size [max_size]]   (powers of two)
+ *
+ * GB/s counts the stored triangle once and x read + written.  Allocations
+ * are every malloc-family call the runner's allocator hook sees, on any
+ * thread, averaged over TRMV_ALLOC_CALLS calls (default 100) after a warm-up
+ * call; l2blas must report 0 at every size, unit stride or not.  Each call
+ * starts from the same x, so repeated products do not overflow.
+ */
+
+typedef struct {
+    const char *name;
+    char prec;
+    enum CBLAS_UPLO uplo;
+    enum CBLAS_TRANSPOSE trans;
+    int incx;
+} variant;
+
+static const variant variants[] = {
+    {"strmv LN",   's', CblasLower, CblasNoTrans,   1},
+    {"strmv UT",   's', CblasUpper, CblasTrans,     1},
+    {"dtrmv LN",   'd', CblasLower, CblasNoTrans,   1},
+    {"dtrmv UT",   'd', CblasUpper, CblasTrans,     1},
+    {"dtrmv LN/2", 'd', CblasLower, CblasNoTrans,   2},
+    {"ctrmv LN",   'c', CblasLower, CblasNoTrans,   1},
+    {"ztrmv UC",   'z', CblasUpper, CblasConjTrans, 1},
+};
+#define NVARIANTS ((int)(sizeof(variants) / sizeof(variants[0])))
+
+typedef struct {
+    int use_l2, n;
+    const variant *v;
+    void *A, *x, *x0;
+    size_t xbytes;
+} trmv_args;
+
+static void call_trmv(void *p) {
+    trmv_args *a = p;
+    const variant *v = a->v;
+    const enum CBLAS_ORDER o = CblasColMajor;
+    const enum CBLAS_DIAG d = CblasNonUnit;
+
+    memcpy(a->x, a->x0, a->xbytes);
+    switch (v->prec) {
+    case 's':
+        if (a->use_l2) l2_strmv(o, v->uplo, v->trans, d, a->n, a->A, a->n, a->x, v->incx);
+        else cblas_strmv(o, v->uplo, v->trans, d, a->n, a->A, a->n, a->x, v->incx);
+        break;
+    case 'd':
+        if (a->use_l2) l2_dtrmv(o, v->uplo, v->trans, d, a->n, a->A, a->n, a->x, v->incx);
+        else cblas_dtrmv(o, v->uplo, v->trans, d, a->n, a->A, a->n, a->x, v->incx);
+        break;
+    case 'c':
+        if (a->use_l2) l2_ctrmv(o, v->uplo, v->trans, d, a->n, a->A, a->n, a->x, v->incx);
+        else cblas_ctrmv(o, v->uplo, v->trans, d, a->n, a->A, a->n, a->x, v->incx);
+        break;
+    default:
+        if (a->use_l2) l2_ztrmv(o, v->uplo, v->trans, d, a->n, a->A, a->n, a->x, v->incx);
+        else cblas_ztrmv(o, v->uplo, v->trans, d, a->n, a->A, a->n, a->x, v->incx);
+        break;
+    }
+}
+
+/* Heap allocations per call, or -1 where the runner cannot count them. */
+static double allocs_per_call(trmv_args *a, int calls) {
+    long before;
+
+    call_trmv(a);
+    before = l2t_alloc_count();
+    if (before < 0) return -1;
+    for (int i = 0; i < calls; i++)
+        call_trmv(a);
+    return (double)(l2t_alloc_count() - before) / calls;
+}
+
+int main(int argc, char **argv) {
+    int min_size = argc > 1 ? atoi(argv[1]) : 64;
+    int max_size = argc > 2 ? atoi(argv[2]) : 8192;
+    int calls = (int)bench_env_long("TRMV_ALLOC_CALLS", 100);
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+
+    if (min_size < 1) min_size = 1;
+    if (calls < 1) calls = 1;
+
+    printf("=== l2blas trmv vs OpenBLAS (GB/s, heap allocations per call) "
+           "===\n");
+    printf("OpenBLAS core: %s, l2blas core: %s, %d l2blas threads\n\n",
+           openblas_get_corename(), l2_get_corename(), l2_get_num_threads());
+    printf("%-10s %6s %10s %10s %8s %10s %10s\n", "routine", "N", "OpenBLAS",
+           "l2blas", "l2/OB", "OB allocs", "l2 allocs");
+
+    for (int v = 0; v < NVARIANTS; v++) {
+        const variant *vr = &variants[v];
+        int cs = vr->prec == 'c' || vr->prec == 'z' ? 2 : 1;
+        size_t es = cs * (vr->prec == 's' || vr->prec == 'c' ? sizeof(float)
+                                                             : sizeof(double));
+
+        for (int n = min_size; n <= max_size; n *= 2) {
+            size_t a_bytes = (size_t)n * (size_t)n * es;
+            double bytes = 0.5 * (double)n * (double)(n + 1) * (double)es +
+                           2.0 * (double)n * (double)es;
+            double sec[2], allocs[2];
+            trmv_args a;
+
+            if (a_bytes > mem_limit) {
+                printf("%-10s %6d   skipped (A needs %zu MB)\n", vr->name, n,
+                       a_bytes >> 20);
+                continue;
+            }
+            a.n = n;
+            a.v = vr;
+            a.xbytes = (size_t)n * vr->incx * es;
+            a.A = bench_alloc(a_bytes);
+            a.x = bench_alloc(a.xbytes);
+            a.x0 = bench_alloc(a.xbytes);
+            if (!a.A || !a.x || !a.x0) {
+                printf("%-10s %6d   skipped (allocation failed)\n", vr->name,
+                       n);
+                bench_free(a.A); bench_free(a.x); bench_free(a.x0);
+                continue;
+            }
+            /* off-diagonal entries in [-1/n, 1/n), unit diagonal */
+            if (es / cs == sizeof(float)) {
+                float *f = a.A;
+                bench_fill_s(f, a_bytes / sizeof(float), 1);
+                for (size_t i = 0; i < a_bytes / sizeof(float); i++)
+                    f[i] /= (float)n;
+                for (int i = 0; i < n; i++) f[(size_t)i * (n + 1) * cs] = 1;
+                bench_fill_s(a.x0, a.xbytes / sizeof(float), 2);
+            } else {
+                double *f = a.A;
+                bench_fill_d(f, a_bytes / sizeof(double), 1);
+                for (size_t i = 0; i < a_bytes / sizeof(double); i++)
+                    f[i] /= (double)n;
+                for (int i = 0; i < n; i++) f[(size_t)i * (n + 1) * cs] = 1;
+                bench_fill_d(a.x0, a.xbytes / sizeof(double), 2);
+            }
+
+            for (int lib = 0; lib < 2; lib++) {
+                a.use_l2 = lib;
+                sec[lib] = bench_run(call_trmv, &a);
+                allocs[lib] = allocs_per_call(&a, calls);
+            }
+            printf("%-10s %6d %10.2f %10.2f %7.2fx", vr->name, n,
+                   bytes / sec[0] * 1e-9, bytes / sec[1] * 1e-9,
+                   sec[0] / sec[1]);
+            for (int lib = 0; lib < 2; lib++) {
+                if (allocs[lib] < 0) printf(" %10s", "n/a");
+                else printf(" %10.2f", allocs[lib]);
+            }
+            printf("\n");
+            fflush(stdout);
+            bench_free(a.A);
+            bench_free(a.x);
+            bench_free(a.x0);
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Thread scaling of the blocked l2_?trsv against the linked OpenBLAS trsv.
+ *
+ * Usage: bench_l2_trsv [n [max_threads]]
+ *   n            matrix order (default 4096)
+ *   max_threads  highest thread count tried (default openblas_get_num_procs())
+ *
+ * OpenBLAS runs with openblas_set_num_threads(t), l2blas with
+ * l2_set_num_threads(t).  Each call starts from the same right-hand side,
+ * so x does not drift towards denormals over thousands of repetitions.
+ */
+
+#define MAX_THREADS_SHOWN 256
+
+typedef struct {
+    const char *name;
+    char prec;
+    enum CBLAS_UPLO uplo;
+    enum CBLAS_TRANSPOSE trans;
+} variant;
+
+static const variant variants[] = {
+    {"strsv LN", 's', CblasLower, CblasNoTrans},
+    {"strsv LT", 's', CblasLower, CblasTrans},
+    {"dtrsv LN", 'd', CblasLower, CblasNoTrans},
+    {"dtrsv LT", 'd', CblasLower, CblasTrans},
+    {"ctrsv LN", 'c', CblasLower, CblasNoTrans},
+    {"ctrsv UC", 'c', CblasUpper, CblasConjTrans},
+    {"ztrsv LN", 'z', CblasLower, CblasNoTrans},
+    {"ztrsv UC", 'z', CblasUpper, CblasConjTrans},
+};
+#define NVARIANTS ((int)(sizeof(variants) / sizeof(variants[0])))
+
+typedef struct {
+    int use_l2, n;
+    const variant *v;
+    void *A, *x, *x0;
+    size_t xbytes;
+} trsv_args;
+
+static void call_trsv(void *p) {
+    trsv_args *a = p;
+    const enum CBLAS_ORDER o = CblasColMajor;
+    const enum CBLAS_DIAG d = CblasNonUnit;
+
+    memcpy(a->x, a->x0, a->xbytes);
+    switch (a->v->prec) {
+    case 's':
+        if (a->use_l2) l2_strsv(o, a->v->uplo, a->v->trans, d, a->n, a->A, a->n, a->x, 1);
+        else cblas_strsv(o, a->v->uplo, a->v->trans, d, a->n, a->A, a->n, a->x, 1);
+        break;
+    case 'd':
+        if (a->use_l2) l2_dtrsv(o, a->v->uplo, a->v->trans, d, a->n, a->A, a->n, a->x, 1);
+        else cblas_dtrsv(o, a->v->uplo, a->v->trans, d, a->n, a->A, a->n, a->x, 1);
+        break;
+    case 'c':
+        if (a->use_l2) l2_ctrsv(o, a->v->uplo, a->v->trans, d, a->n, a->A, a->n, a->x, 1);
+        else cblas_ctrsv(o, a->v->uplo, a->v->trans, d, a->n, a->A, a->n, a->x, 1);
+        break;
+    default:
+        if (a->use_l2) l2_ztrsv(o, a->v->uplo, a->v->trans, d, a->n, a->A, a->n, a->x, 1);
+        else cblas_ztrsv(o, a->v->uplo, a->v->trans, d, a->n, a->A, a->n, a->x, 1);
+        break;
+    }
+}
+
+/* Off-diagonal entries in [-1/n, 1/n), diagonal 2: well conditioned. */
+static void fill_triangular(void *A, char prec, int n) {
+    int cs = prec == 'c' || prec == 'z' ? 2 : 1;
+    size_t len = (size_t)n * (size_t)n * cs;
+
+    if (prec == 's' || prec == 'c') {
+        float *a = A;
+        bench_fill_s(a, len, 1);
+        for (size_t i = 0; i < len; i++) a[i] /= (float)n;
+        for (int i = 0; i < n; i++) a[(size_t)i * (n + 1) * cs] = 2.0f;
+    } else {
+        double *a = A;
+        bench_fill_d(a, len, 1);
+        for (size_t i = 0; i < len; i++) a[i] /= (double)n;
+        for (int i = 0; i < n; i++) a[(size_t)i * (n + 1) * cs] = 2.0;
+    }
+}
+
+static void print_header(const char *title, int max_t) {
+    printf("\n%s\n%-8s %-3s", title, "routine", "lib");
+    for (int t = 1; t <= max_t; t++)
+        printf(" %7d", t);
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 4096;
+    int max_t = argc > 2 ? atoi(argv[2]) : openblas_get_num_procs();
+    static double times[NVARIANTS][2][MAX_THREADS_SHOWN];
+    void *A[4] = {NULL, NULL, NULL, NULL};
+    void *x, *x0;
+    static const char precs[4] = {'s', 'd', 'c', 'z'};
+
+    if (n < 1) n = 1;
+    if (max_t < 1) max_t = 1;
+    if (max_t > MAX_THREADS_SHOWN) max_t = MAX_THREADS_SHOWN;
+
+    x = bench_alloc((size_t)n * 2 * sizeof(double));
+    x0 = bench_alloc((size_t)n * 2 * sizeof(double));
+    if (!x || !x0) {
+        fprintf(stderr, "bench_l2_trsv: cannot allocate n=%d\n", n);
+        return 1;
+    }
+    bench_fill_d(x0, (size_t)n * 2, 2);
+
+    printf("=== trsv thread scaling, l2blas vs OpenBLAS, n=%d ===\n", n);
+    printf("OpenBLAS core: %s, l2blas core: %s, threads tried: 1..%d\n",
+           openblas_get_corename(), l2_get_corename(), max_t);
+
+    for (int p = 0; p < 4; p++) {
+        size_t es = (precs[p] == 'c' || precs[p] == 'z' ? 2 : 1) *
+                    (precs[p] == 's' || precs[p] == 'c' ? sizeof(float)
+                                                        : sizeof(double));
+        A[p] = bench_alloc((size_t)n * (size_t)n * es);
+        if (!A[p]) {
+            fprintf(stderr, "bench_l2_trsv: cannot allocate n=%d\n", n);
+            return 1;
+        }
+        fill_triangular(A[p], precs[p], n);
+    }
+
+    for (int t = 1; t <= max_t; t++) {
+        openblas_set_num_threads(t);
+        l2_set_num_threads(t);
+        for (int v = 0; v < NVARIANTS; v++) {
+            const variant *vr = &variants[v];
+            int p = vr->prec == 's' ? 0 : vr->prec == 'd' ? 1 : vr->prec == 'c' ? 2 : 3;
+            trsv_args a;
+
+            a.n = n;
+            a.v = vr;
+            a.A = A[p];
+            a.x = x;
+            a.x0 = x0;
+            a.xbytes = (size_t)n * (p >= 2 ? 2 : 1) *
+                       (p == 0 || p == 2 ? sizeof(float) : sizeof(double));
+            for (int lib = 0; lib < 2; lib++) {
+                a.use_l2 = lib;
+                times[v][lib][t - 1] = bench_run(call_trsv, &a);
+            }
+        }
+    }
+
+    print_header("time per call, ms", max_t);
+    for (int v = 0; v < NVARIANTS; v++)
+        for (int lib = 0; lib < 2; lib++) {
+            printf("%-8s %-3s", lib ? "" : variants[v].name, lib ? "l2" : "OB");
+            for (int t = 1; t <= max_t; t++)
+                printf(" %7.3f", times[v][lib][t - 1] * 1e3);
+            printf("\n");
+        }
+
+    print_header("speedup over 1 thread", max_t);
+    for (int v = 0; v < NVARIANTS; v++)
+        for (int lib = 0; lib < 2; lib++) {
+            printf("%-8s %-3s", lib ? "" : variants[v].name, lib ? "l2" : "OB");
+            for (int t = 1; t <= max_t; t++)
+                printf(" %7.2f", times[v][lib][0] / times[v][lib][t - 1]);
+            printf("\n");
+        }
+
+    print_header("l2blas speedup over OpenBLAS at the same thread count", max_t);
+    for (int v = 0; v < NVARIANTS; v++) {
+        printf("%-8s %-3s", variants[v].name, "");
+        for (int t = 1; t <= max_t; t++)
+            printf(" %7.2f", times[v][0][t - 1] / times[v][1][t - 1]);
+        printf("\n");
+    }
+
+    for (int p = 0; p < 4; p++)
+        bench_free(A[p]);
+    bench_free(x);
+    bench_free(x0);
+    return 0;
+}
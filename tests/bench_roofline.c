@@ -0,0 +1,651 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <immintrin.h>
+#include <cblas.h>
+#include "bench.h"
+#include "l2blas/l2blas.h"
+
+/*
+ * Roofline report for the Level 2 routines of the test suite: gemv, hemv,
+ * symv, trmv, trsv, ger, geru/gerc, syr, her, syr2, her2, in every precision
+ * cblas.h has them, through OpenBLAS and, where it has one, l2blas.
+ *
+ * Usage: bench_roofline [min_size [max_size [csv_path]]]   (powers of two)
+ *
+ * At startup the machine is measured on the threads the routines get
+ * (openblas_get_num_threads(), l2blas set to the same):
+ *   peak GFLOP/s   FMA chains in the widest vectors the CPU has, s and d
+ *   read GB/s      a vector sum over footprints from 16 KiB up, so the
+ *                  curve shows each cache level and then DRAM
+ *   update GB/s    p[i] = p[i] * c + d in place, read + write counted
+ * Then every routine runs on N x N (ColMajor, NoTrans, Lower, NonUnit,
+ * unit increments) and is placed against its roof: arithmetic intensity
+ * AI = flops / bytes moved, attainable = min(peak, AI * bandwidth at the
+ * routine's footprint), with the update curve for the rank-k routines and
+ * the read curve for the rest.  Complex flops are real flops (a complex
+ * multiply-add is 8).  "%roof" is achieved over attainable; rows under
+ * ROOFLINE_LOW percent (default 50) are flagged and listed again at the
+ * end, worst first.  csv_path, if given, gets the same table as CSV.
+ */
+
+#define RL_MAXT   64
+#define RL_NACC   12      /* independent FMA chains per thread */
+#define RL_MINFP  (16 * 1024)
+#define RL_MAXCURVE 40
+
+/* ---- threads -------------------------------------------------------------- */
+
+typedef void (*rl_part_fn)(void *arg, int tid, int nt);
+
+typedef struct {
+    rl_part_fn fn;
+    void *arg;
+    int tid, nt;
+} rl_slot;
+
+static void *rl_slot_run(void *p) {
+    rl_slot *s = p;
+    s->fn(s->arg, s->tid, s->nt);
+    return NULL;
+}
+
+/* fn(arg, tid, nt) on nt threads, the caller being thread 0. */
+static void rl_parallel(int nt, rl_part_fn fn, void *arg) {
+    pthread_t th[RL_MAXT];
+    rl_slot slot[RL_MAXT];
+    int started = 0;
+
+    for (int k = 0; k < nt; k++) {
+        slot[k].fn = fn;
+        slot[k].arg = arg;
+        slot[k].tid = k;
+        slot[k].nt = nt;
+    }
+    for (int k = 1; k < nt; k++) {
+        if (pthread_create(&th[k], NULL, rl_slot_run, &slot[k]) != 0) break;
+        started = k;
+    }
+    fn(arg, 0, nt);
+    for (int k = started + 1; k < nt; k++) fn(arg, k, nt);
+    for (int k = 1; k <= started; k++) pthread_join(th[k], NULL);
+}
+
+/* ---- peak FLOP rate ------------------------------------------------------- */
+
+/*
+ * acc = acc * m + a on RL_NACC vectors; with m just under 1 every chain
+ * settles at a / (1 - m), so nothing overflows or goes subnormal.  Each
+ * ISA gets its own copy through a target attribute (CFLAGS carry no -m
+ * flags) and the widest one CPUID allows runs.
+ */
+#define RL_FMA_LOOP(name, tgt, T, VB)                                        \
+    __attribute__((target(tgt))) static double name(long iters) {           \
+        typedef T v __attribute__((vector_size(VB)));                         \
+        v acc[RL_NACC], m, a, s;                                              \
+        double r = 0.0;                                                       \
+        for (unsigned k = 0; k < VB / sizeof(T); k++) {                       \
+            m[k] = (T)0.999999;                                               \
+            a[k] = (T)1e-6;                                                   \
+        }                                                                     \
+        for (int c = 0; c < RL_NACC; c++) acc[c] = a * (T)c;                 \
+        for (long it = 0; it < iters; it++) {                                 \
+            _Pragma("GCC unroll 12")                                          \
+            for (int c = 0; c < RL_NACC; c++) acc[c] = acc[c] * m + a;        \
+        }                                                                     \
+        s = acc[0];                                                           \
+        for (int c = 1; c < RL_NACC; c++) s += acc[c];                        \
+        for (unsigned k = 0; k < VB / sizeof(T); k++) r += s[k];              \
+        return r;                                                             \
+    }
+
+RL_FMA_LOOP(fma_s_avx512, "avx512f", float, 64)
+RL_FMA_LOOP(fma_d_avx512, "avx512f", double, 64)
+RL_FMA_LOOP(fma_s_avx2, "avx2,fma", float, 32)
+RL_FMA_LOOP(fma_d_avx2, "avx2,fma", double, 32)
+RL_FMA_LOOP(fma_s_sse2, "sse2", float, 16)
+RL_FMA_LOOP(fma_d_sse2, "sse2", double, 16)
+
+enum { ISA_SSE2, ISA_AVX2, ISA_AVX512 };
+static const char *isa_name[3] = {"sse2", "avx2+fma", "avx512f"};
+static const int isa_bytes[3] = {16, 32, 64};
+
+static int rl_isa(void) {
+    if (__builtin_cpu_supports("avx512f")) return ISA_AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return ISA_AVX2;
+    return ISA_SSE2;
+}
+
+typedef struct {
+    int isa, dbl;
+    long iters;
+    volatile double sink;
+} fma_args;
+
+static void fma_part(void *p, int tid, int nt) {
+    fma_args *f = p;
+    double r;
+    (void)tid; (void)nt;
+
+    switch (f->isa * 2 + f->dbl) {
+    case ISA_AVX512 * 2:     r = fma_s_avx512(f->iters); break;
+    case ISA_AVX512 * 2 + 1: r = fma_d_avx512(f->iters); break;
+    case ISA_AVX2 * 2:       r = fma_s_avx2(f->iters); break;
+    case ISA_AVX2 * 2 + 1:   r = fma_d_avx2(f->iters); break;
+    case ISA_SSE2 * 2:       r = fma_s_sse2(f->iters); break;
+    default:                 r = fma_d_sse2(f->iters); break;
+    }
+    f->sink = r;
+}
+
+typedef struct {
+    fma_args f;
+    int nt;
+} fma_run_args;
+
+static void call_fma(void *p) {
+    fma_run_args *a = p;
+    rl_parallel(a->nt, fma_part, &a->f);
+}
+
+/* GFLOP/s of nt threads, single (dbl = 0) or double precision. */
+static double peak_gflops(int isa, int dbl, int nt) {
+    fma_run_args a;
+    double lanes = (double)isa_bytes[isa] / (dbl ? 8.0 : 4.0);
+
+    a.f.isa = isa;
+    a.f.dbl = dbl;
+    a.f.iters = 200000;
+    a.nt = nt;
+    return 2.0 * lanes * RL_NACC * (double)a.f.iters * nt /
+           bench_run(call_fma, &a) * 1e-9;
+}
+
+/* ---- bandwidth curve ------------------------------------------------------ */
+
+/*
+ * Four streams a quarter of the range apart, as gemv reads four columns at
+ * once: one sequential stream leaves DRAM bandwidth on the table that the
+ * prefetchers find with several.
+ */
+#define RL_RW_LOOP(name, tgt, VB)                                            \
+    __attribute__((target(tgt))) static double name##_read(                  \
+            const double *p, size_t len) {                                    \
+        typedef double v __attribute__((vector_size(VB)));                    \
+        const size_t w = VB / sizeof(double), q = len / 4 / w * w;            \
+        v s0 = {0}, s1 = {0}, s2 = {0}, s3 = {0};                             \
+        double r = 0.0;                                                       \
+        for (size_t i = 0; i < q; i += w) {                                   \
+            s0 += *(const v *)(p + i);                                        \
+            s1 += *(const v *)(p + q + i);                                    \
+            s2 += *(const v *)(p + 2 * q + i);                                \
+            s3 += *(const v *)(p + 3 * q + i);                                \
+        }                                                                     \
+        s0 += s1 + s2 + s3;                                                   \
+        for (size_t k = 0; k < w; k++) r += s0[k];                            \
+        for (size_t i = 4 * q; i < len; i++) r += p[i];                       \
+        return r;                                                             \
+    }                                                                         \
+    __attribute__((target(tgt))) static void name##_update(                  \
+            double *p, size_t len, double c, double d) {                      \
+        typedef double v __attribute__((vector_size(VB)));                    \
+        const size_t w = VB / sizeof(double), q = len / 4 / w * w;            \
+        for (size_t i = 0; i < q; i += w) {                                   \
+            *(v *)(p + i) = *(v *)(p + i) * c + d;                            \
+            *(v *)(p + q + i) = *(v *)(p + q + i) * c + d;                    \
+            *(v *)(p + 2 * q + i) = *(v *)(p + 2 * q + i) * c + d;            \
+            *(v *)(p + 3 * q + i) = *(v *)(p + 3 * q + i) * c + d;            \
+        }                                                                     \
+        for (size_t i = 4 * q; i < len; i++) p[i] = p[i] * c + d;             \
+    }
+
+RL_RW_LOOP(bw_avx512, "avx512f", 64)
+RL_RW_LOOP(bw_avx2, "avx2", 32)
+RL_RW_LOOP(bw_sse2, "sse2", 16)
+
+typedef struct {
+    int isa, update, nt;
+    double *p;
+    size_t len;
+    double c, d;
+    volatile double sink;
+} bw_args;
+
+static void bw_part(void *arg, int tid, int nt) {
+    bw_args *b = arg;
+    /* 64-byte aligned pieces, so the vector loads above are aligned */
+    size_t chunk = ((b->len + nt - 1) / nt + 7) & ~(size_t)7;
+    size_t lo = chunk * tid < b->len ? chunk * tid : b->len;
+    size_t hi = lo + chunk < b->len ? lo + chunk : b->len;
+    double *p = b->p + lo;
+
+    if (b->update) {
+        switch (b->isa) {
+        case ISA_AVX512: bw_avx512_update(p, hi - lo, b->c, b->d); break;
+        case ISA_AVX2:   bw_avx2_update(p, hi - lo, b->c, b->d); break;
+        default:         bw_sse2_update(p, hi - lo, b->c, b->d); break;
+        }
+    } else {
+        double r;
+        switch (b->isa) {
+        case ISA_AVX512: r = bw_avx512_read(p, hi - lo); break;
+        case ISA_AVX2:   r = bw_avx2_read(p, hi - lo); break;
+        default:         r = bw_sse2_read(p, hi - lo); break;
+        }
+        if (tid == 0) b->sink = r;
+    }
+}
+
+static void call_bw(void *p) {
+    bw_args *b = p;
+    rl_parallel(b->nt, bw_part, b);
+}
+
+typedef struct {
+    double bytes, read, update;   /* footprint, GB/s */
+} bw_point;
+
+static bw_point curve[RL_MAXCURVE];
+static int ncurve;
+
+/* Read and update GB/s over a footprint of `bytes`. */
+static void measure_bw(bw_point *pt, double bytes, int isa, int nt) {
+    bw_args b;
+    double sec;
+
+    b.isa = isa;
+    b.nt = nt;
+    b.len = (size_t)(bytes / sizeof(double));
+    b.c = 1.0;
+    b.d = 0.0;
+    b.p = bench_alloc(b.len * sizeof(double));
+    pt->bytes = bytes;
+    pt->read = pt->update = 0.0;
+    if (!b.p) return;
+    bench_fill_d(b.p, b.len, 7);
+    b.update = 0;
+    sec = bench_run(call_bw, &b);
+    pt->read = bytes / sec * 1e-9;
+    b.update = 1;
+    sec = bench_run(call_bw, &b);
+    pt->update = 2.0 * bytes / sec * 1e-9;
+    bench_free(b.p);
+}
+
+/*
+ * Read or update GB/s at a footprint of `bytes`, interpolated in log2 of
+ * the footprint between the probed points around it.
+ */
+static double bw_at(double bytes, int update) {
+    int k = 1;
+
+    if (bytes <= curve[0].bytes || ncurve == 1)
+        return update ? curve[0].update : curve[0].read;
+    while (k < ncurve - 1 && curve[k].bytes < bytes) k++;
+    {
+        const bw_point *a = &curve[k - 1], *b = &curve[k];
+        double t = log2(bytes / a->bytes) / log2(b->bytes / a->bytes);
+        double va = update ? a->update : a->read;
+        double vb = update ? b->update : b->read;
+        if (t > 1.0) t = 1.0;
+        return va + t * (vb - va);
+    }
+}
+
+/* ---- routines ------------------------------------------------------------- */
+
+enum { R_GEMV, R_HEMV, R_SYMV, R_TRMV, R_TRSV, R_GER, R_GERU, R_GERC,
+       R_SYR, R_HER, R_SYR2, R_HER2, NROUTINES };
+
+static const struct {
+    const char *name, *precs;
+    int update;               /* rank-k update: read + write A */
+} routines[NROUTINES] = {
+    {"gemv", "sdcz", 0}, {"hemv", "cz", 0},  {"symv", "sd", 0},
+    {"trmv", "sdcz", 0}, {"trsv", "sdcz", 0}, {"ger", "sd", 1},
+    {"geru", "cz", 1},   {"gerc", "cz", 1},   {"syr", "sd", 1},
+    {"her", "cz", 1},    {"syr2", "sd", 1},   {"her2", "cz", 1}};
+
+enum { IM_OB, IM_L2, NIMPLS };
+static const char *impl_name[NIMPLS] = {"OB", "l2"};
+
+static int has_l2(int r) {
+    return r == R_GEMV || r == R_HEMV || r == R_SYMV || r == R_TRMV ||
+           r == R_TRSV ||
+           r == R_GER || r == R_GERU || r == R_GERC || r == R_SYR ||
+           r == R_HER || r == R_SYR2 || r == R_HER2;
+}
+
+typedef struct {
+    int r, impl, n;
+    char prec;
+    void *A, *x, *y, *x0;
+    size_t es;
+} rl_args;
+
+static void call_routine(void *p) {
+    static const float  s_alpha = 1e-3f, c_alpha[2] = {1e-3f, -1e-3f};
+    static const double d_alpha = 1e-3,  z_alpha[2] = {1e-3, -1e-3};
+    static const float  c_beta[2] = {0.5f, 0.0f};
+    static const double z_beta[2] = {0.5, 0.0};
+    const enum CBLAS_ORDER o = CblasColMajor;
+    const enum CBLAS_UPLO lo = CblasLower;
+    const enum CBLAS_TRANSPOSE nt = CblasNoTrans;
+    const enum CBLAS_DIAG nu = CblasNonUnit;
+    rl_args *a = p;
+    int n = a->n, l2 = a->impl == IM_L2;
+    const void *ca = a->prec == 'c' ? (const void *)c_alpha
+                                    : (const void *)z_alpha;
+    const void *cb = a->prec == 'c' ? (const void *)c_beta
+                                    : (const void *)z_beta;
+
+    /* triangular solves and products start from the same x every call */
+    if (a->r == R_TRMV || a->r == R_TRSV)
+        memcpy(a->x, a->x0, (size_t)n * a->es);
+
+    switch (a->r * 4 + (int)(strchr("sdcz", a->prec) - "sdcz")) {
+    case R_GEMV * 4 + 0:
+        (l2 ? l2_sgemv : cblas_sgemv)(o, nt, n, n, 1.0f, a->A, n, a->x, 1,
+                                      0.5f, a->y, 1);
+        break;
+    case R_GEMV * 4 + 1:
+        (l2 ? l2_dgemv : cblas_dgemv)(o, nt, n, n, 1.0, a->A, n, a->x, 1,
+                                      0.5, a->y, 1);
+        break;
+    case R_GEMV * 4 + 2:
+        (l2 ? l2_cgemv : cblas_cgemv)(o, nt, n, n, ca, a->A, n, a->x, 1, cb,
+                                      a->y, 1);
+        break;
+    case R_GEMV * 4 + 3:
+        (l2 ? l2_zgemv : cblas_zgemv)(o, nt, n, n, ca, a->A, n, a->x, 1, cb,
+                                      a->y, 1);
+        break;
+    case R_HEMV * 4 + 2:
+        (l2 ? l2_chemv : cblas_chemv)(o, lo, n, ca, a->A, n, a->x, 1, cb,
+                                      a->y, 1);
+        break;
+    case R_HEMV * 4 + 3:
+        (l2 ? l2_zhemv : cblas_zhemv)(o, lo, n, ca, a->A, n, a->x, 1, cb,
+                                      a->y, 1);
+        break;
+    case R_SYMV * 4 + 0:
+        (l2 ? l2_ssymv : cblas_ssymv)(o, lo, n, 1.0f, a->A, n, a->x, 1, 0.5f,
+                                      a->y, 1);
+        break;
+    case R_SYMV * 4 + 1:
+        (l2 ? l2_dsymv : cblas_dsymv)(o, lo, n, 1.0, a->A, n, a->x, 1, 0.5,
+                                      a->y, 1);
+        break;
+    case R_TRMV * 4 + 0:
+        (l2 ? l2_strmv : cblas_strmv)(o, lo, nt, nu, n, a->A, n, a->x, 1);
+        break;
+    case R_TRMV * 4 + 1:
+        (l2 ? l2_dtrmv : cblas_dtrmv)(o, lo, nt, nu, n, a->A, n, a->x, 1);
+        break;
+    case R_TRMV * 4 + 2:
+        (l2 ? l2_ctrmv : cblas_ctrmv)(o, lo, nt, nu, n, a->A, n, a->x, 1);
+        break;
+    case R_TRMV * 4 + 3:
+        (l2 ? l2_ztrmv : cblas_ztrmv)(o, lo, nt, nu, n, a->A, n, a->x, 1);
+        break;
+    case R_TRSV * 4 + 0:
+        (l2 ? l2_strsv : cblas_strsv)(o, lo, nt, nu, n, a->A, n, a->x, 1);
+        break;
+    case R_TRSV * 4 + 1:
+        (l2 ? l2_dtrsv : cblas_dtrsv)(o, lo, nt, nu, n, a->A, n, a->x, 1);
+        break;
+    case R_TRSV * 4 + 2:
+        (l2 ? l2_ctrsv : cblas_ctrsv)(o, lo, nt, nu, n, a->A, n, a->x, 1);
+        break;
+    case R_TRSV * 4 + 3:
+        (l2 ? l2_ztrsv : cblas_ztrsv)(o, lo, nt, nu, n, a->A, n, a->x, 1);
+        break;
+    case R_GER * 4 + 0:
+        (l2 ? l2_sger : cblas_sger)(o, n, n, s_alpha, a->x, 1, a->y, 1,
+                                    a->A, n);
+        break;
+    case R_GER * 4 + 1:
+        (l2 ? l2_dger : cblas_dger)(o, n, n, d_alpha, a->x, 1, a->y, 1,
+                                    a->A, n);
+        break;
+    case R_GERU * 4 + 2:
+        (l2 ? l2_cgeru : cblas_cgeru)(o, n, n, ca, a->x, 1, a->y, 1, a->A, n);
+        break;
+    case R_GERU * 4 + 3:
+        (l2 ? l2_zgeru : cblas_zgeru)(o, n, n, ca, a->x, 1, a->y, 1, a->A, n);
+        break;
+    case R_GERC * 4 + 2:
+        (l2 ? l2_cgerc : cblas_cgerc)(o, n, n, ca, a->x, 1, a->y, 1, a->A, n);
+        break;
+    case R_GERC * 4 + 3:
+        (l2 ? l2_zgerc : cblas_zgerc)(o, n, n, ca, a->x, 1, a->y, 1, a->A, n);
+        break;
+    case R_SYR * 4 + 0:
+        (l2 ? l2_ssyr : cblas_ssyr)(o, lo, n, s_alpha, a->x, 1, a->A, n);
+        break;
+    case R_SYR * 4 + 1:
+        (l2 ? l2_dsyr : cblas_dsyr)(o, lo, n, d_alpha, a->x, 1, a->A, n);
+        break;
+    case R_HER * 4 + 2:
+        (l2 ? l2_cher : cblas_cher)(o, lo, n, s_alpha, a->x, 1, a->A, n);
+        break;
+    case R_HER * 4 + 3:
+        (l2 ? l2_zher : cblas_zher)(o, lo, n, d_alpha, a->x, 1, a->A, n);
+        break;
+    case R_SYR2 * 4 + 0:
+        (l2 ? l2_ssyr2 : cblas_ssyr2)(o, lo, n, s_alpha, a->x, 1, a->y, 1,
+                                      a->A, n);
+        break;
+    case R_SYR2 * 4 + 1:
+        (l2 ? l2_dsyr2 : cblas_dsyr2)(o, lo, n, d_alpha, a->x, 1, a->y, 1,
+                                      a->A, n);
+        break;
+    case R_HER2 * 4 + 2:
+        (l2 ? l2_cher2 : cblas_cher2)(o, lo, n, ca, a->x, 1, a->y, 1, a->A,
+                                      n);
+        break;
+    default:
+        (l2 ? l2_zher2 : cblas_zher2)(o, lo, n, ca, a->x, 1, a->y, 1, a->A,
+                                      n);
+        break;
+    }
+}
+
+/*
+ * Real flops and bytes moved by one call on order n, element size es
+ * (complex counted whole).  Full matrices move n^2 elements, triangles
+ * n(n+1)/2; updates read and write them; vectors count once per pass.
+ */
+static void routine_cost(int r, int cx, double n, double es, double *flops,
+                         double *bytes) {
+    double tri = n * (n + 1) / 2, f = cx ? 4.0 : 1.0;
+
+    switch (r) {
+    case R_GEMV:
+        *flops = 2 * n * n * f; *bytes = es * (n * n + 3 * n); break;
+    case R_HEMV: case R_SYMV:
+        *flops = 2 * n * n * f; *bytes = es * (tri + 3 * n); break;
+    case R_TRMV: case R_TRSV:
+        *flops = n * n * f;     *bytes = es * (tri + 2 * n); break;
+    case R_GER: case R_GERU: case R_GERC:
+        *flops = 2 * n * n * f; *bytes = es * (2 * n * n + 2 * n); break;
+    case R_SYR: case R_HER:
+        *flops = 2 * tri * f;   *bytes = es * (2 * tri + n); break;
+    default:
+        *flops = 4 * tri * f;   *bytes = es * (2 * tri + 2 * n); break;
+    }
+}
+
+/* ---- report --------------------------------------------------------------- */
+
+typedef struct {
+    int r, impl, n;
+    char prec;
+    double gflops, gbs, ai, roof, pct;
+    int mem_bound;
+} rl_row;
+
+static int by_pct(const void *a, const void *b) {
+    double pa = ((const rl_row *)a)->pct, pb = ((const rl_row *)b)->pct;
+    return pa < pb ? -1 : pa > pb;
+}
+
+static void print_row(const rl_row *w, double low) {
+    printf("%-6s %c %-3s %6d %9.2f %9.2f %7.3f %9.2f %7.1f %-4s %s\n",
+           routines[w->r].name, w->prec, impl_name[w->impl], w->n, w->gflops,
+           w->gbs, w->ai, w->roof, w->pct, w->mem_bound ? "mem" : "cpu",
+           w->pct < low ? "LOW" : "");
+}
+
+int main(int argc, char **argv) {
+    int min_size = argc > 1 ? atoi(argv[1]) : 256;
+    int max_size = argc > 2 ? atoi(argv[2]) : 4096;
+    const char *csv_path = argc > 3 ? argv[3] : NULL;
+    double low = (double)bench_env_long("ROOFLINE_LOW", 50);
+    size_t mem_limit = (size_t)bench_env_long("BENCH_MEM_MB", 3072) << 20;
+    int nt = openblas_get_num_threads(), isa = rl_isa();
+    double peak[2], top;
+    rl_row *rows;
+    int nrows = 0, cap;
+    FILE *csv = NULL;
+
+    if (min_size < 1) min_size = 1;
+    if (nt < 1) nt = 1;
+    if (nt > RL_MAXT) nt = RL_MAXT;
+    l2_set_num_threads(nt);
+
+    printf("=== Level 2 roofline ===\n");
+    printf("OpenBLAS core: %s, l2blas core: %s, threads: %d, probe ISA: %s\n",
+           openblas_get_corename(), l2_get_corename(), nt, isa_name[isa]);
+
+    peak[0] = peak_gflops(isa, 0, nt);
+    peak[1] = peak_gflops(isa, 1, nt);
+    printf("peak GFLOP/s: single %.1f, double %.1f\n\n", peak[0], peak[1]);
+
+    /* up to the largest footprint: a z update at max_size, read + write */
+    top = 16.0 * max_size * (double)max_size;
+    if (top > (double)mem_limit / 2) top = (double)mem_limit / 2;
+    printf("%12s %10s %10s\n", "footprint", "read GB/s", "upd GB/s");
+    for (double fp = RL_MINFP; ncurve < RL_MAXCURVE; fp *= 2) {
+        measure_bw(&curve[ncurve], fp, isa, nt);
+        printf("%9.0f KiB %10.2f %10.2f\n", fp / 1024, curve[ncurve].read,
+               curve[ncurve].update);
+        ncurve++;
+        if (fp >= top) break;
+    }
+    printf("\n");
+
+    if (csv_path && strcmp(csv_path, "-") != 0) {
+        csv = fopen(csv_path, "w");
+        if (!csv) {
+            printf("bench_roofline: cannot write %s\n", csv_path);
+            return 1;
+        }
+        fprintf(csv, "routine,prec,impl,n,gflops,gbs,ai,attainable_gflops,"
+                     "pct_of_roof,bound\n");
+    }
+
+    cap = 0;
+    for (int n = min_size; n <= max_size; n *= 2) cap++;
+    rows = malloc((size_t)cap * NROUTINES * 4 * NIMPLS * sizeof(rl_row));
+    if (!rows) return 1;
+
+    printf("%-6s %c %-3s %6s %9s %9s %7s %9s %7s %-4s\n", "op", 'p', "lib",
+           "N", "GFLOP/s", "GB/s", "AI", "roof", "%roof", "bnd");
+    for (int n = min_size; n <= max_size; n *= 2) {
+        for (int r = 0; r < NROUTINES; r++)
+            for (const char *pc = routines[r].precs; *pc; pc++) {
+                int cx = *pc == 'c' || *pc == 'z';
+                size_t es = (*pc == 's' ? 4 : *pc == 'd' ? 8 :
+                             *pc == 'c' ? 8 : 16);
+                size_t elems = (size_t)n * n;
+                double flops, bytes, real = es / (cx ? 2.0 : 1.0);
+                rl_args a;
+
+                if (elems * es > mem_limit) continue;
+                a.r = r;
+                a.n = n;
+                a.prec = *pc;
+                a.es = es;
+                a.A = bench_alloc(elems * es);
+                a.x = bench_alloc((size_t)n * es);
+                a.x0 = bench_alloc((size_t)n * es);
+                a.y = bench_alloc((size_t)n * es);
+                if (!a.A || !a.x || !a.x0 || !a.y) {
+                    printf("bench_roofline: allocation failed\n");
+                    return 1;
+                }
+                /* entries of order 1/n, unit diagonal: trsv stays tame */
+                if (real == 4.0) {
+                    float *A = a.A;
+                    bench_fill_s(A, elems * (cx ? 2 : 1), 1);
+                    for (size_t i = 0; i < elems * (cx ? 2 : 1); i++)
+                        A[i] /= (float)n;
+                    for (int i = 0; i < n; i++)
+                        A[((size_t)i * n + i) * (cx ? 2 : 1)] = 1.0f;
+                    bench_fill_s(a.x0, (size_t)n * (cx ? 2 : 1), 2);
+                    bench_fill_s(a.y, (size_t)n * (cx ? 2 : 1), 3);
+                } else {
+                    double *A = a.A;
+                    bench_fill_d(A, elems * (cx ? 2 : 1), 1);
+                    for (size_t i = 0; i < elems * (cx ? 2 : 1); i++)
+                        A[i] /= (double)n;
+                    for (int i = 0; i < n; i++)
+                        A[((size_t)i * n + i) * (cx ? 2 : 1)] = 1.0;
+                    bench_fill_d(a.x0, (size_t)n * (cx ? 2 : 1), 2);
+                    bench_fill_d(a.y, (size_t)n * (cx ? 2 : 1), 3);
+                }
+                memcpy(a.x, a.x0, (size_t)n * es);
+                routine_cost(r, cx, n, (double)es, &flops, &bytes);
+
+                for (int im = 0; im < NIMPLS; im++) {
+                    rl_row *w = &rows[nrows];
+                    double sec, ceil_mem, bw_gbs;
+
+                    if (im == IM_L2 && !has_l2(r)) continue;
+                    a.impl = im;
+                    sec = bench_run(call_routine, &a);
+                    bw_gbs = routines[r].update
+                           ? bw_at(bytes / 2, 1) : bw_at(bytes, 0);
+                    w->r = r;
+                    w->impl = im;
+                    w->n = n;
+                    w->prec = *pc;
+                    w->gflops = flops / sec * 1e-9;
+                    w->gbs = bytes / sec * 1e-9;
+                    w->ai = flops / bytes;
+                    ceil_mem = w->ai * bw_gbs;
+                    w->mem_bound = ceil_mem < peak[real == 8.0];
+                    w->roof = w->mem_bound ? ceil_mem : peak[real == 8.0];
+                    w->pct = 100.0 * w->gflops / w->roof;
+                    print_row(w, low);
+                    if (csv)
+                        fprintf(csv, "%s,%c,%s,%d,%.4f,%.4f,%.5f,%.4f,%.2f,"
+                                     "%s\n", routines[r].name, w->prec,
+                                impl_name[im], n, w->gflops, w->gbs, w->ai,
+                                w->roof, w->pct,
+                                w->mem_bound ? "memory" : "compute");
+                    nrows++;
+                }
+                fflush(stdout);
+                bench_free(a.A);
+                bench_free(a.x);
+                bench_free(a.x0);
+                bench_free(a.y);
+            }
+    }
+
+    qsort(rows, (size_t)nrows, sizeof(rl_row), by_pct);
+    printf("\nbelow %.0f%% of the roof, worst first:\n", low);
+    for (int k = 0; k < nrows && rows[k].pct < low; k++)
+        print_row(&rows[k], low);
+    if (csv) {
+        fclose(csv);
+        printf("\nCSV written to %s\n", csv_path);
+    }
+    free(rows);
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cblas.h>
+#include "bench.h"
+
+/*
+ * Thread-scaling sweep for the CBLAS Level 2 routines covered by the tests.
+ *
+ * Usage: bench_scale [n [max_threads]]
+ *   n            matrix order (default 4096)
+ *   max_threads  highest thread count tried (default openblas_get_num_procs())
+ *
+ * Every routine runs at the same size with 1..max_threads OpenBLAS threads,
+ * set through openblas_set_num_threads() and read back with
+ * openblas_get_num_threads().  Three tables are printed: time per call,
+ * speedup over one thread and parallel efficiency (speedup / threads).
+ */
+
+#define MAX_THREADS_SHOWN 256
+
+typedef struct {
+    int n;
+    double *A;                  /* n*n complex doubles, viewed as real too */
+    double *x, *y, *x0;         /* n complex doubles each */
+} scale_data;
+
+typedef struct {
+    const char *name;
+    bench_fn call;
+} routine;
+
+static scale_data D;
+
+/* Tiny update scale keeps A bounded over thousands of rank-1/2 updates. */
+static const double upd_alpha = 1e-9;
+static const double z_one[2]  = {1.0, 0.0};
+static const double z_half[2] = {0.5, 0.0};
+static const double z_upd[2]  = {1e-9, 0.0};
+
+static void run_dgemv(void *p) {
+    (void)p;
+    cblas_dgemv(CblasRowMajor, CblasNoTrans, D.n, D.n, 1.0, D.A, D.n,
+                D.x, 1, 0.5, D.y, 1);
+}
+
+static void run_dgemv_t(void *p) {
+    (void)p;
+    cblas_dgemv(CblasRowMajor, CblasTrans, D.n, D.n, 1.0, D.A, D.n,
+                D.x, 1, 0.5, D.y, 1);
+}
+
+static void run_dsymv(void *p) {
+    (void)p;
+    cblas_dsymv(CblasRowMajor, CblasUpper, D.n, 1.0, D.A, D.n,
+                D.x, 1, 0.5, D.y, 1);
+}
+
+static void run_zhemv(void *p) {
+    (void)p;
+    cblas_zhemv(CblasRowMajor, CblasUpper, D.n, z_one, D.A, D.n,
+                D.x, 1, z_half, D.y, 1);
+}
+
+static void run_dtrmv(void *p) {
+    (void)p;
+    memcpy(D.x, D.x0, (size_t)D.n * sizeof(double));
+    cblas_dtrmv(CblasRowMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                D.n, D.A, D.n, D.x, 1);
+}
+
+static void run_dtrsv(void *p) {
+    (void)p;
+    memcpy(D.x, D.x0, (size_t)D.n * sizeof(double));
+    cblas_dtrsv(CblasRowMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                D.n, D.A, D.n, D.x, 1);
+}
+
+static void run_dger(void *p) {
+    (void)p;
+    cblas_dger(CblasRowMajor, D.n, D.n, upd_alpha, D.x0, 1, D.y, 1, D.A, D.n);
+}
+
+static void run_zgeru(void *p) {
+    (void)p;
+    cblas_zgeru(CblasRowMajor, D.n, D.n, z_upd, D.x0, 1, D.y, 1, D.A, D.n);
+}
+
+static void run_zgerc(void *p) {
+    (void)p;
+    cblas_zgerc(CblasRowMajor, D.n, D.n, z_upd, D.x0, 1, D.y, 1, D.A, D.n);
+}
+
+static void run_dsyr(void *p) {
+    (void)p;
+    cblas_dsyr(CblasRowMajor, CblasUpper, D.n, upd_alpha, D.x0, 1, D.A, D.n);
+}
+
+static void run_zher(void *p) {
+    (void)p;
+    cblas_zher(CblasRowMajor, CblasUpper, D.n, upd_alpha, D.x0, 1, D.A, D.n);
+}
+
+static void run_dsyr2(void *p) {
+    (void)p;
+    cblas_dsyr2(CblasRowMajor, CblasUpper, D.n, upd_alpha, D.x0, 1, D.y, 1,
+                D.A, D.n);
+}
+
+static void run_zher2(void *p) {
+    (void)p;
+    cblas_zher2(CblasRowMajor, CblasUpper, D.n, z_upd, D.x0, 1, D.y, 1,
+                D.A, D.n);
+}
+
+static const routine routines[] = {
+    {"dgemv N", run_dgemv},
+    {"dgemv T", run_dgemv_t},
+    {"dsymv",   run_dsymv},
+    {"zhemv",   run_zhemv},
+    {"dtrmv",   run_dtrmv},
+    {"dtrsv",   run_dtrsv},
+    {"dger",    run_dger},
+    {"zgeru",   run_zgeru},
+    {"zgerc",   run_zgerc},
+    {"dsyr",    run_dsyr},
+    {"zher",    run_zher},
+    {"dsyr2",   run_dsyr2},
+    {"zher2",   run_zher2},
+};
+#define NROUTINES ((int)(sizeof(routines) / sizeof(routines[0])))
+
+static void print_header(const char *title, int max_t) {
+    printf("\n%s\n%-8s", title, "routine");
+    for (int t = 1; t <= max_t; t++) printf(" %7d", t);
+    printf("\n");
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 4096;
+    int max_t = argc > 2 ? atoi(argv[2]) : openblas_get_num_procs();
+    static double times[NROUTINES][MAX_THREADS_SHOWN];
+    int mismatch = 0;
+
+    if (n < 1) n = 1;
+    if (max_t < 1) max_t = 1;
+    if (max_t > MAX_THREADS_SHOWN) max_t = MAX_THREADS_SHOWN;
+
+    D.n = n;
+    D.A  = bench_alloc((size_t)n * (size_t)n * 2 * sizeof(double));
+    D.x  = bench_alloc((size_t)n * 2 * sizeof(double));
+    D.y  = bench_alloc((size_t)n * 2 * sizeof(double));
+    D.x0 = bench_alloc((size_t)n * 2 * sizeof(double));
+    if (!D.A || !D.x || !D.y || !D.x0) {
+        fprintf(stderr, "bench_scale: cannot allocate n=%d\n", n);
+        return 1;
+    }
+    bench_fill_d(D.A, (size_t)n * (size_t)n * 2, 1);
+    bench_fill_d(D.x0, (size_t)n * 2, 2);
+    bench_fill_d(D.y, (size_t)n * 2, 3);
+    memcpy(D.x, D.x0, (size_t)n * 2 * sizeof(double));
+    /* Diagonally dominant real view so dtrsv stays well conditioned. */
+    for (int i = 0; i < n; i++)
+        D.A[(size_t)i * (size_t)n + (size_t)i] = (double)n;
+
+    printf("=== CBLAS Level 2 thread scaling, n=%d ===\n", n);
+    printf("core: %s, procs: %d, threads tried: 1..%d\n",
+           openblas_get_corename(), openblas_get_num_procs(), max_t);
+
+    for (int t = 1; t <= max_t; t++) {
+        openblas_set_num_threads(t);
+        if (openblas_get_num_threads() != t) {
+            printf("warning: asked for %d threads, OpenBLAS reports %d\n",
+                   t, openblas_get_num_threads());
+            mismatch = 1;
+        }
+        for (int r = 0; r < NROUTINES; r++)
+            times[r][t - 1] = bench_run(routines[r].call, NULL);
+    }
+
+    print_header("time per call, ms", max_t);
+    for (int r = 0; r < NROUTINES; r++) {
+        printf("%-8s", routines[r].name);
+        for (int t = 1; t <= max_t; t++)
+            printf(" %7.3f", times[r][t - 1] * 1e3);
+        printf("\n");
+    }
+
+    print_header("speedup over 1 thread", max_t);
+    for (int r = 0; r < NROUTINES; r++) {
+        printf("%-8s", routines[r].name);
+        for (int t = 1; t <= max_t; t++)
+            printf(" %7.2f", times[r][0] / times[r][t - 1]);
+        printf("\n");
+    }
+
+    print_header("parallel efficiency, %", max_t);
+    for (int r = 0; r < NROUTINES; r++) {
+        printf("%-8s", routines[r].name);
+        for (int t = 1; t <= max_t; t++)
+            printf(" %7.1f", 100.0 * times[r][0] / (times[r][t - 1] * t));
+        printf("\n");
+    }
+
+    bench_free(D.A);
+    bench_free(D.x);
+    bench_free(D.y);
+    bench_free(D.x0);
+    return mismatch;
+}
@@ -0,0 +1,331 @@
+/*
+ * Deferred rank-k accumulation (l2_?acc_*): rank-1 and rank-2 updates of
+ * one matrix are queued in the caller's workspace and applied together,
+ * so k updates cost one read-modify-write pass over A instead of k.  Each
+ * column of A becomes one gemv with the queued vectors, run by the same
+ * SIMD gemv kernels as everything else.  See acc_template.h.
+ */
+#include <stddef.h>
+#include "l2blas_internal.h"
+
+/*
+ * Returns the parameter number of the first illegal init argument, or 0.
+ * General inits take (acc, order, m, n, a, lda, work, lwork), symmetric
+ * and Hermitian ones (acc, order, uplo, n, a, lda, work, lwork).
+ */
+static int acc_check(char kind, enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                     blasint m, blasint n, blasint lda, blasint lwork) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 2;
+    if (kind == L2_ACC_GE) {
+        if (m < 0) return 3;
+        if (n < 0) return 4;
+        if (lda < L2_MAX(1, order == CblasColMajor ? m : n)) return 6;
+    } else {
+        if (uplo != CblasUpper && uplo != CblasLower) return 3;
+        if (n < 0) return 4;
+        if (lda < L2_MAX(1, n)) return 6;
+    }
+    if (lwork < L2_MAX(1, m + n)) return 8;
+    return 0;
+}
+
+/* Reports an update on an acc of the wrong kind or precision, or whose
+ * init failed (parameter 1), or a zero increment. */
+static int acc_update_check(const l2_acc *acc, char prec, char kind,
+                            blasint incx, blasint incy, int incy_pos) {
+    if (acc->prec != prec || acc->kind != kind) return 1;
+    if (incx == 0) return 4;
+    if (incy_pos && incy == 0) return incy_pos;
+    return 0;
+}
+
+static const float  c_one[2] = {1.0f, 0.0f};
+static const double z_one[2] = {1.0, 0.0};
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define PREC_CHAR 's'
+#define GEMV_N(m, k, u, ldu, v, a) \
+    l2_sgemv_pick(1, 1, 1)(m, k, 1.0f, u, ldu, v, 1, a, 1)
+#include "acc_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef PREC_CHAR
+#undef GEMV_N
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define PREC_CHAR 'd'
+#define GEMV_N(m, k, u, ldu, v, a) \
+    l2_dgemv_pick(1, 1, 1)(m, k, 1.0, u, ldu, v, 1, a, 1)
+#include "acc_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef PREC_CHAR
+#undef GEMV_N
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define PREC_CHAR 'c'
+#define GEMV_N(m, k, u, ldu, v, a) \
+    l2_cgemv_panel_pick()(m, k, c_one, u, ldu, NULL, 0, a, 1, \
+                           v, 1, NULL, 0, 0, 0)
+#include "acc_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef PREC_CHAR
+#undef GEMV_N
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define PREC_CHAR 'z'
+#define GEMV_N(m, k, u, ldu, v, a) \
+    l2_zgemv_panel_pick()(m, k, z_one, u, ldu, NULL, 0, a, 1, \
+                           v, 1, NULL, 0, 0, 0)
+#include "acc_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef PREC_CHAR
+#undef GEMV_N
+
+/* ---- entry points -------------------------------------------------------- */
+
+void l2_sacc_init_ge(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, float *a,
+                     const blasint lda, float *work, const blasint lwork) {
+    sacc_init("l2_sacc_init_ge", acc, L2_ACC_GE, order, CblasUpper, m, n,
+              a, lda, work, lwork);
+}
+
+void l2_sacc_init_sy(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const enum CBLAS_UPLO uplo, const blasint n, float *a,
+                     const blasint lda, float *work, const blasint lwork) {
+    sacc_init("l2_sacc_init_sy", acc, L2_ACC_SY, order, uplo, n, n, a,
+              lda, work, lwork);
+}
+
+void l2_sacc_ger(l2_acc *acc, const float alpha, const float *x,
+                 const blasint incx, const float *y, const blasint incy) {
+    int info = acc_update_check(acc, 's', L2_ACC_GE, incx, incy, 6);
+
+    if (info) { l2_xerbla("l2_sacc_ger", info); return; }
+    if (alpha == 0) return;
+    sacc_push(acc, &alpha, x, acc->swap ? acc->n : acc->m, incx, 0,
+              y, acc->swap ? acc->m : acc->n, incy, 0);
+}
+
+void l2_sacc_syr(l2_acc *acc, const float alpha, const float *x,
+                 const blasint incx) {
+    int info = acc_update_check(acc, 's', L2_ACC_SY, incx, 0, 0);
+
+    if (info) { l2_xerbla("l2_sacc_syr", info); return; }
+    if (alpha == 0) return;
+    sacc_push(acc, &alpha, x, acc->n, incx, 0, x, acc->n, incx, 0);
+}
+
+void l2_sacc_syr2(l2_acc *acc, const float alpha, const float *x,
+                  const blasint incx, const float *y, const blasint incy) {
+    int info = acc_update_check(acc, 's', L2_ACC_SY, incx, incy, 6);
+
+    if (info) { l2_xerbla("l2_sacc_syr2", info); return; }
+    if (alpha == 0) return;
+    sacc_push(acc, &alpha, x, acc->n, incx, 0, y, acc->n, incy, 0);
+    sacc_push(acc, &alpha, y, acc->n, incy, 0, x, acc->n, incx, 0);
+}
+
+void l2_sacc_flush(l2_acc *acc) {
+    if (acc->prec != 's' || acc->kind == 0) {
+        l2_xerbla("l2_sacc_flush", 1);
+        return;
+    }
+    sacc_flush(acc);
+}
+
+void l2_dacc_init_ge(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, double *a,
+                     const blasint lda, double *work, const blasint lwork) {
+    dacc_init("l2_dacc_init_ge", acc, L2_ACC_GE, order, CblasUpper, m, n,
+              a, lda, work, lwork);
+}
+
+void l2_dacc_init_sy(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const enum CBLAS_UPLO uplo, const blasint n, double *a,
+                     const blasint lda, double *work, const blasint lwork) {
+    dacc_init("l2_dacc_init_sy", acc, L2_ACC_SY, order, uplo, n, n, a,
+              lda, work, lwork);
+}
+
+void l2_dacc_ger(l2_acc *acc, const double alpha, const double *x,
+                 const blasint incx, const double *y, const blasint incy) {
+    int info = acc_update_check(acc, 'd', L2_ACC_GE, incx, incy, 6);
+
+    if (info) { l2_xerbla("l2_dacc_ger", info); return; }
+    if (alpha == 0) return;
+    dacc_push(acc, &alpha, x, acc->swap ? acc->n : acc->m, incx, 0,
+              y, acc->swap ? acc->m : acc->n, incy, 0);
+}
+
+void l2_dacc_syr(l2_acc *acc, const double alpha, const double *x,
+                 const blasint incx) {
+    int info = acc_update_check(acc, 'd', L2_ACC_SY, incx, 0, 0);
+
+    if (info) { l2_xerbla("l2_dacc_syr", info); return; }
+    if (alpha == 0) return;
+    dacc_push(acc, &alpha, x, acc->n, incx, 0, x, acc->n, incx, 0);
+}
+
+void l2_dacc_syr2(l2_acc *acc, const double alpha, const double *x,
+                  const blasint incx, const double *y, const blasint incy) {
+    int info = acc_update_check(acc, 'd', L2_ACC_SY, incx, incy, 6);
+
+    if (info) { l2_xerbla("l2_dacc_syr2", info); return; }
+    if (alpha == 0) return;
+    dacc_push(acc, &alpha, x, acc->n, incx, 0, y, acc->n, incy, 0);
+    dacc_push(acc, &alpha, y, acc->n, incy, 0, x, acc->n, incx, 0);
+}
+
+void l2_dacc_flush(l2_acc *acc) {
+    if (acc->prec != 'd' || acc->kind == 0) {
+        l2_xerbla("l2_dacc_flush", 1);
+        return;
+    }
+    dacc_flush(acc);
+}
+
+void l2_cacc_init_ge(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, void *a,
+                     const blasint lda, void *work, const blasint lwork) {
+    cacc_init("l2_cacc_init_ge", acc, L2_ACC_GE, order, CblasUpper, m, n,
+              a, lda, work, lwork);
+}
+
+void l2_cacc_init_he(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const enum CBLAS_UPLO uplo, const blasint n, void *a,
+                     const blasint lda, void *work, const blasint lwork) {
+    cacc_init("l2_cacc_init_he", acc, L2_ACC_HE, order, uplo, n, n, a,
+              lda, work, lwork);
+}
+
+static void cacc_ger(const char *rname, l2_acc *acc, const float *alpha,
+                     const float *x, blasint incx, const float *y,
+                     blasint incy, int conj) {
+    int info = acc_update_check(acc, 'c', L2_ACC_GE, incx, incy, 6);
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (alpha[0] == 0 && alpha[1] == 0) return;
+    cacc_push(acc, alpha, x, acc->swap ? acc->n : acc->m, incx, 0,
+              y, acc->swap ? acc->m : acc->n, incy, conj);
+}
+
+void l2_cacc_geru(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy) {
+    cacc_ger("l2_cacc_geru", acc, alpha, x, incx, y, incy, 0);
+}
+
+void l2_cacc_gerc(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy) {
+    cacc_ger("l2_cacc_gerc", acc, alpha, x, incx, y, incy, 1);
+}
+
+void l2_cacc_her(l2_acc *acc, const float alpha, const void *x,
+                 const blasint incx) {
+    int info = acc_update_check(acc, 'c', L2_ACC_HE, incx, 0, 0);
+    float calpha[2] = {alpha, 0};
+
+    if (info) { l2_xerbla("l2_cacc_her", info); return; }
+    if (alpha == 0) return;
+    cacc_push(acc, calpha, x, acc->n, incx, 0, x, acc->n, incx, 1);
+}
+
+void l2_cacc_her2(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy) {
+    int info = acc_update_check(acc, 'c', L2_ACC_HE, incx, incy, 6);
+    const float *al = alpha;
+    float calpha[2] = {al[0], -al[1]};
+
+    if (info) { l2_xerbla("l2_cacc_her2", info); return; }
+    if (al[0] == 0 && al[1] == 0) return;
+    cacc_push(acc, al, x, acc->n, incx, 0, y, acc->n, incy, 1);
+    cacc_push(acc, calpha, y, acc->n, incy, 0, x, acc->n, incx, 1);
+}
+
+void l2_cacc_flush(l2_acc *acc) {
+    if (acc->prec != 'c' || acc->kind == 0) {
+        l2_xerbla("l2_cacc_flush", 1);
+        return;
+    }
+    cacc_flush(acc);
+}
+
+void l2_zacc_init_ge(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, void *a,
+                     const blasint lda, void *work, const blasint lwork) {
+    zacc_init("l2_zacc_init_ge", acc, L2_ACC_GE, order, CblasUpper, m, n,
+              a, lda, work, lwork);
+}
+
+void l2_zacc_init_he(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const enum CBLAS_UPLO uplo, const blasint n, void *a,
+                     const blasint lda, void *work, const blasint lwork) {
+    zacc_init("l2_zacc_init_he", acc, L2_ACC_HE, order, uplo, n, n, a,
+              lda, work, lwork);
+}
+
+static void zacc_ger(const char *rname, l2_acc *acc, const double *alpha,
+                     const double *x, blasint incx, const double *y,
+                     blasint incy, int conj) {
+    int info = acc_update_check(acc, 'z', L2_ACC_GE, incx, incy, 6);
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (alpha[0] == 0 && alpha[1] == 0) return;
+    zacc_push(acc, alpha, x, acc->swap ? acc->n : acc->m, incx, 0,
+              y, acc->swap ? acc->m : acc->n, incy, conj);
+}
+
+void l2_zacc_geru(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy) {
+    zacc_ger("l2_zacc_geru", acc, alpha, x, incx, y, incy, 0);
+}
+
+void l2_zacc_gerc(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy) {
+    zacc_ger("l2_zacc_gerc", acc, alpha, x, incx, y, incy, 1);
+}
+
+void l2_zacc_her(l2_acc *acc, const double alpha, const void *x,
+                 const blasint incx) {
+    int info = acc_update_check(acc, 'z', L2_ACC_HE, incx, 0, 0);
+    double calpha[2] = {alpha, 0};
+
+    if (info) { l2_xerbla("l2_zacc_her", info); return; }
+    if (alpha == 0) return;
+    zacc_push(acc, calpha, x, acc->n, incx, 0, x, acc->n, incx, 1);
+}
+
+void l2_zacc_her2(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy) {
+    int info = acc_update_check(acc, 'z', L2_ACC_HE, incx, incy, 6);
+    const double *al = alpha;
+    double calpha[2] = {al[0], -al[1]};
+
+    if (info) { l2_xerbla("l2_zacc_her2", info); return; }
+    if (al[0] == 0 && al[1] == 0) return;
+    zacc_push(acc, al, x, acc->n, incx, 0, y, acc->n, incy, 1);
+    zacc_push(acc, calpha, y, acc->n, incy, 0, x, acc->n, incx, 1);
+}
+
+void l2_zacc_flush(l2_acc *acc) {
+    if (acc->prec != 'z' || acc->kind == 0) {
+        l2_xerbla("l2_zacc_flush", 1);
+        return;
+    }
+    zacc_flush(acc);
+}
@@ -0,0 +1,164 @@
+/*
+ * Deferred rank-k accumulation body, included once per precision by acc.c
+ * with
+ *   FLOAT    element type (float or double)
+ *   CS       1 for real, 2 for complex
+ *   PREC     name prefix (s, d, c, z)
+ *   GEMV_N(m, k, u, ldu, v, a)
+ *            a[0..m) += U(0..m, 0..k) * v[0..k), U column-major with
+ *            leading dimension ldu, every vector unit-stride
+ * defined.
+ *
+ * The queue is A += U * V^T in the column-major view of A (M x N): U is
+ * M x cap column-major, V is stored row by row (the k entries for column
+ * j of A at v + j*cap) so each column of A is one m x k gemv against a
+ * contiguous run of V.  A RowMajor A is the ColMajor A^T, so a queued
+ * pair (u, v) of the caller's A += u v^T goes in as (v, u).
+ *
+ * The flush walks A in row tiles small enough that the tile of U stays in
+ * L2 while all the columns pass over it; each element of A is loaded and
+ * stored once however many updates are queued.
+ */
+
+#define ACC_CAT_(a, b) a##b
+#define ACC_CAT(a, b) ACC_CAT_(a, b)
+#define ACC_FN(name) ACC_CAT(PREC, name)
+
+static void ACC_FN(acc_init)(const char *rname, l2_acc *acc, char kind,
+                             enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                             blasint m, blasint n, FLOAT *a, blasint lda,
+                             FLOAT *work, blasint lwork) {
+    int info = acc_check(kind, order, uplo, m, n, lda, lwork);
+
+    acc->prec = PREC_CHAR;
+    acc->kind = 0;
+    acc->k = 0;
+    if (info) { l2_xerbla(rname, info); return; }
+    acc->kind = kind;
+    acc->m = order == CblasColMajor ? m : n;
+    acc->n = order == CblasColMajor ? n : m;
+    acc->lda = lda;
+    acc->swap = order == CblasRowMajor;
+    acc->lower = (uplo == CblasLower) == (order == CblasColMajor);
+    acc->a = a;
+    acc->cap = acc->m + acc->n > 0 ? lwork / (acc->m + acc->n) : 0;
+    acc->u = work;
+    acc->v = work + CS * acc->m * acc->cap;
+}
+
+/* Columns [c0, c1) of rows [r0, r1), only the stored triangle for sy/he. */
+static void ACC_FN(acc_tile)(const l2_acc *acc, BLASLONG r0, BLASLONG r1,
+                             BLASLONG c0, BLASLONG c1) {
+    const FLOAT *u = acc->u, *v = acc->v;
+    FLOAT *a = acc->a;
+
+    for (BLASLONG j = c0; j < c1; j++) {
+        BLASLONG lo = r0, hi = r1;
+        FLOAT *col = a + CS * j * acc->lda;
+
+        if (acc->kind != L2_ACC_GE) {
+            if (acc->lower) lo = L2_MAX(lo, j);
+            else            hi = L2_MIN(hi, j + 1);
+        }
+        if (lo >= hi) continue;
+        GEMV_N(hi - lo, acc->k, u + CS * lo, acc->m, v + CS * j * acc->cap,
+               col + CS * lo);
+#if CS == 2
+        if (acc->kind == L2_ACC_HE && lo <= j && j < hi)
+            col[2 * j + 1] = 0;
+#endif
+    }
+}
+
+static void ACC_FN(acc_worker)(int tid, int nthreads, void *arg) {
+    const l2_acc *acc = arg;
+    BLASLONG chunk = ((acc->n + nthreads - 1) / nthreads + 3) & -4;
+    BLASLONG lo = L2_MIN(tid * chunk, acc->n);
+    BLASLONG hi = L2_MIN(lo + chunk, acc->n);
+
+    /*
+     * A lower triangle's columns shorten left to right, an upper's grow.
+     * Every element takes k FMAs, so starting a column weighs less the
+     * longer the queue.
+     */
+    if (acc->kind != L2_ACC_GE) {
+        BLASLONG cost = 2 * L2_TRI_LINE_BYTES /
+                        (CS * (BLASLONG)sizeof(FLOAT) * (1 + acc->k));
+        lo = l2_tri_split(acc->n, !acc->lower, cost, tid, nthreads, 4);
+        hi = l2_tri_split(acc->n, !acc->lower, cost, tid + 1, nthreads, 4);
+    }
+    BLASLONG mb = L2_MAX(64, L2_ACC_U_BYTES /
+                                 (acc->k * CS * (BLASLONG)sizeof(FLOAT)));
+
+    for (BLASLONG r = 0; r < acc->m; r += mb)
+        ACC_FN(acc_tile)(acc, r, L2_MIN(r + mb, acc->m), lo, hi);
+}
+
+static void ACC_FN(acc_flush)(l2_acc *acc) {
+    int nthreads = l2_get_num_threads();
+    double work = (double)acc->m * (double)acc->n * acc->k * CS;
+
+    if (acc->k == 0) return;
+    if (acc->kind != L2_ACC_GE) work *= 0.5;
+    if (nthreads > 1 && work >= 2.0 * L2_GER_MIN_WORK) {
+        nthreads = (int)L2_MIN((double)nthreads, work / L2_GER_MIN_WORK);
+        l2_parallel(nthreads, ACC_FN(acc_worker), acc);
+    } else {
+        ACC_FN(acc_worker)(0, 1, acc);
+    }
+    acc->k = 0;
+}
+
+/*
+ * Queues the caller's A += (alpha * opx(x)) * opy(y)^T, x of length mx and
+ * y of length ny, opx / opy conjugating when conjx / conjy are set.
+ */
+static void ACC_FN(acc_push)(l2_acc *acc, const FLOAT *alpha,
+                             const FLOAT *x, BLASLONG mx, BLASLONG incx,
+                             int conjx, const FLOAT *y, BLASLONG ny,
+                             BLASLONG incy, int conjy) {
+    FLOAT *u, *v;
+    BLASLONG incu, incv;
+
+    if (acc->k == acc->cap) ACC_FN(acc_flush)(acc);
+    x = L2_VEC_BASE(x, mx, CS * incx);
+    y = L2_VEC_BASE(y, ny, CS * incy);
+    /* u side: column k of U; v side: entry k of every row of V */
+    u = (FLOAT *)acc->u + CS * acc->k * acc->m;
+    v = (FLOAT *)acc->v + CS * acc->k;
+    incu = 1;
+    incv = acc->cap;
+    if (acc->swap) {
+        FLOAT *t = u; u = v; v = t;
+        incu = acc->cap;
+        incv = 1;
+    }
+    for (BLASLONG i = 0; i < mx; i++) {
+#if CS == 1
+        u[i * incu] = alpha[0] * x[i * incx];
+#else
+        FLOAT xr = x[2 * i * incx], xi = x[2 * i * incx + 1];
+        if (conjx) xi = -xi;
+        u[2 * i * incu]     = alpha[0] * xr - alpha[1] * xi;
+        u[2 * i * incu + 1] = alpha[0] * xi + alpha[1] * xr;
+#endif
+    }
+    for (BLASLONG j = 0; j < ny; j++) {
+#if CS == 1
+        v[j * incv] = y[j * incy];
+#else
+        v[2 * j * incv]     = y[2 * j * incy];
+        v[2 * j * incv + 1] = conjy ? -y[2 * j * incy + 1]
+                                    : y[2 * j * incy + 1];
+#endif
+    }
+#if CS == 1
+    (void)conjx;
+    (void)conjy;
+#endif
+    acc->k++;
+}
+
+#undef ACC_CAT_
+#undef ACC_CAT
+#undef ACC_FN
@@ -0,0 +1,305 @@
+/*
+ * Thread placement and first-touch initialisation for bandwidth-bound
+ * Level 2 on multi-socket (NUMA) machines.
+ *
+ * OpenBLAS splits a threaded gemv into one block of y per thread (rows of A
+ * for NoTrans, columns for Trans) and, with every thread idle, hands block
+ * k to its k-th thread: block 0 to the caller, block k >= 1 to worker k - 1.
+ * l2_set_placement pins those threads to CPUs in a fixed order (compact:
+ * node by node; spread: round-robin over the nodes) through
+ * openblas_setaffinity, and l2_first_touch then writes each block of A from
+ * a thread pinned where that block's gemv thread runs, so the kernel finds
+ * its pages on its own node.  Nodes come from /sys/devices/system/cpu (the
+ * cpuN/nodeM links, else the socket id), restricted to the CPUs this
+ * process may use.
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#include <dirent.h>
+#endif
+#include "l2blas_internal.h"
+
+static pthread_mutex_t place_lock = PTHREAD_MUTEX_INITIALIZER;
+static int place_cpu[L2_MAX_THREADS];   /* per gemv block; -1: not pinned */
+static int place_slots;
+
+#ifdef __linux__
+
+typedef struct {
+    int cpu, node;
+} cpu_node;
+
+static int read_int(const char *path) {
+    FILE *f = fopen(path, "r");
+    int v = -1;
+
+    if (f) {
+        if (fscanf(f, "%d", &v) != 1) v = -1;
+        fclose(f);
+    }
+    return v;
+}
+
+int l2_cpu_node(int cpu) {
+    char path[96];
+    DIR *d;
+    struct dirent *e;
+    int node = -1;
+
+    if (cpu < 0) return -1;
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d", cpu);
+    if ((d = opendir(path))) {
+        while (node < 0 && (e = readdir(d)))
+            if (strncmp(e->d_name, "node", 4) == 0 &&
+                e->d_name[4] >= '0' && e->d_name[4] <= '9')
+                node = atoi(e->d_name + 4);
+        closedir(d);
+    }
+    if (node < 0) {
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/cpu/cpu%d/topology/physical_package_id",
+                 cpu);
+        node = read_int(path);
+    }
+    return node < 0 ? 0 : node;
+}
+
+static int by_node(const void *a, const void *b) {
+    const cpu_node *x = a, *y = b;
+    if (x->node != y->node) return x->node - y->node;
+    return x->cpu - y->cpu;
+}
+
+/*
+ * The CPUs this process may run on: the caller's mask the first time
+ * through, before any pinning narrowed it.
+ */
+static cpu_set_t usable_set;
+static int usable_ok;
+
+static void usable_init(void) {
+    usable_ok = sched_getaffinity(0, sizeof(usable_set), &usable_set) == 0;
+}
+
+/* The usable CPUs in compact order; returns the count. */
+static int usable_cpus(cpu_node *cpus, int max) {
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    int n = 0;
+
+    pthread_once(&once, usable_init);
+    if (!usable_ok) return 0;
+    for (int c = 0; c < CPU_SETSIZE && n < max; c++)
+        if (CPU_ISSET(c, &usable_set)) {
+            cpus[n].cpu = c;
+            cpus[n].node = l2_cpu_node(c);
+            n++;
+        }
+    qsort(cpus, (size_t)n, sizeof(*cpus), by_node);
+    return n;
+}
+
+/*
+ * CPU of gemv block k under a policy.  spread takes the nodes in turn and,
+ * within a node, its CPUs in order; either way blocks wrap round when
+ * there are more threads than CPUs.
+ */
+static int policy_cpu(enum L2_PLACEMENT policy, const cpu_node *cpus, int n,
+                      int k) {
+    int nodes = 0, node_start[L2_MAX_THREADS], node_len[L2_MAX_THREADS];
+
+    if (policy == L2_PLACE_COMPACT) return cpus[k % n].cpu;
+    for (int i = 0; i < n; i++) {
+        if (i == 0 || cpus[i].node != cpus[i - 1].node) {
+            if (nodes == L2_MAX_THREADS) break;
+            node_start[nodes] = i;
+            node_len[nodes++] = 0;
+        }
+        node_len[nodes - 1]++;
+    }
+    {
+        int v = k % nodes, i = (k / nodes) % node_len[v];
+        return cpus[node_start[v] + i].cpu;
+    }
+}
+
+static int pin_self(int cpu, const cpu_set_t *all) {
+    cpu_set_t set;
+
+    if (cpu < 0) return pthread_setaffinity_np(pthread_self(), sizeof(*all),
+                                               all);
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+int l2_set_placement(enum L2_PLACEMENT policy) {
+    static cpu_node cpus[CPU_SETSIZE];
+    int nt = openblas_get_num_threads(), n, err = 0;
+    const cpu_set_t *all = &usable_set;
+
+    if (policy < L2_PLACE_NONE || policy > L2_PLACE_SPREAD) return -1;
+    nt = L2_MIN(L2_MAX(nt, 1), L2_MAX_THREADS);
+
+    pthread_mutex_lock(&place_lock);
+    n = usable_cpus(cpus, CPU_SETSIZE);
+    if (n == 0) {
+        pthread_mutex_unlock(&place_lock);
+        return -1;
+    }
+    for (int k = 0; k < nt; k++)
+        place_cpu[k] = policy == L2_PLACE_NONE ? -1
+                                               : policy_cpu(policy, cpus, n, k);
+    place_slots = nt;
+
+    /* block 0 runs on the caller, block k on OpenBLAS thread k - 1 */
+    err |= pin_self(place_cpu[0], all) != 0;
+    for (int k = 1; k < nt; k++) {
+        cpu_set_t set;
+
+        if (place_cpu[k] < 0) {
+            set = *all;
+        } else {
+            CPU_ZERO(&set);
+            CPU_SET(place_cpu[k], &set);
+        }
+        err |= openblas_setaffinity(k - 1, sizeof(set), &set) != 0;
+    }
+    pthread_mutex_unlock(&place_lock);
+    return err ? -1 : 0;
+}
+
+#else  /* !__linux__ */
+
+int l2_cpu_node(int cpu) {
+    return cpu < 0 ? -1 : 0;
+}
+
+int l2_set_placement(enum L2_PLACEMENT policy) {
+    (void)policy;
+    return -1;
+}
+
+#endif
+
+int l2_get_placement_cpu(int block) {
+    int cpu;
+
+    pthread_mutex_lock(&place_lock);
+    cpu = block >= 0 && block < place_slots ? place_cpu[block] : -1;
+    pthread_mutex_unlock(&place_lock);
+    return cpu;
+}
+
+/* ---- first touch --------------------------------------------------------- */
+
+/*
+ * OpenBLAS (interface/gemv.c) runs a gemv of fewer than 2304 *
+ * GEMM_MULTITHREAD_THRESHOLD elements on the caller alone; 4 is the
+ * threshold's default.
+ */
+#define L2_OB_GEMV_MT_MIN (2304.0 * 4)
+
+/*
+ * Start of each gemv block of a length-len y, as OpenBLAS' gemv_thread.c
+ * splits it: the remainder shared evenly among the threads still to go, no
+ * block under 4.  Returns the number of blocks; start[nblocks] = len.
+ * This copies OpenBLAS's split rather than asking for it, so a build that
+ * splits otherwise gets blocks touched on the wrong nodes (still zeroed).
+ */
+static int gemv_blocks(blasint len, int nt, blasint *start) {
+    int k = 0;
+
+    start[0] = 0;
+    while (start[k] < len && k < nt) {
+        blasint left = len - start[k];
+        blasint width = (left + (nt - k) - 1) / (nt - k);
+
+        if (width < 4) width = 4;
+        if (width > left) width = left;
+        start[k + 1] = start[k] + width;
+        k++;
+    }
+    return k;
+}
+
+typedef struct {
+    char   *a;
+    size_t  elsize, lda;
+    size_t  lines;          /* columns (ColMajor) or rows (RowMajor) */
+    size_t  line_len;       /* elements per line */
+    int     contiguous;     /* block is whole lines */
+    blasint lo, hi;         /* block of y */
+    int     cpu;
+} touch_job;
+
+static void touch_block(const touch_job *j) {
+    if (j->contiguous) {
+        for (size_t l = (size_t)j->lo; l < (size_t)j->hi; l++)
+            memset(j->a + l * j->lda * j->elsize, 0, j->line_len * j->elsize);
+        return;
+    }
+    for (size_t l = 0; l < j->lines; l++)
+        memset(j->a + (l * j->lda + (size_t)j->lo) * j->elsize, 0,
+               (size_t)(j->hi - j->lo) * j->elsize);
+}
+
+static void *touch_main(void *p) {
+    touch_job *j = p;
+
+#ifdef __linux__
+    if (j->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(j->cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+    touch_block(j);
+    return NULL;
+}
+
+void l2_first_touch(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                    blasint m, blasint n, void *a, blasint lda,
+                    size_t elsize) {
+    blasint start[L2_MAX_THREADS + 1];
+    touch_job jobs[L2_MAX_THREADS];
+    pthread_t th[L2_MAX_THREADS];
+    int started[L2_MAX_THREADS];
+    int nt = L2_MIN(L2_MAX(openblas_get_num_threads(), 1), L2_MAX_THREADS);
+    int col = order == CblasColMajor;
+    int notrans = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    blasint len = notrans ? m : n;
+    int nb;
+
+    if (m <= 0 || n <= 0 || !a) return;
+    if ((double)m * (double)n < L2_OB_GEMV_MT_MIN) nt = 1;
+    nb = gemv_blocks(len, nt, start);
+    for (int k = 0; k < nb; k++) {
+        touch_job *j = &jobs[k];
+
+        j->a = a;
+        j->elsize = elsize;
+        j->lda = (size_t)lda;
+        j->lines = (size_t)(col ? n : m);
+        j->line_len = (size_t)(col ? m : n);
+        /* y runs along the lines' stride when it indexes whole lines */
+        j->contiguous = col != notrans;
+        j->lo = start[k];
+        j->hi = start[k + 1];
+        j->cpu = l2_get_placement_cpu(k);
+        started[k] = k > 0 &&
+                     pthread_create(&th[k], NULL, touch_main, j) == 0;
+    }
+    touch_block(&jobs[0]);
+    for (int k = 1; k < nb; k++) {
+        if (started[k]) pthread_join(th[k], NULL);
+        else            touch_block(&jobs[k]);
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Workspace arenas (l2_arena_init, l2_?xxx_arena): the hot-path routines
+ * with a caller-owned staging area.  Nothing in l2blas allocates per call
+ * (scratch lives on the stack, parallel regions on their caller's stack),
+ * but the pool starts its workers on the first threaded call, and strided
+ * vectors fall back to scalar loops.  An arena moves the first to init
+ * time and copies strided vectors to unit stride, which costs O(n) against
+ * the O(n^2) pass over A.  See arena_template.h.
+ */
+#include <stdint.h>
+#include "l2blas_internal.h"
+
+void l2_arena_init(l2_arena *ar, void *work, const size_t lwork) {
+    uintptr_t p = (uintptr_t)work, base = (p + 63) & ~(uintptr_t)63;
+    size_t pad = (size_t)(base - p);
+
+    ar->x = ar->y = NULL;
+    ar->cap = 0;
+    if (work && lwork > pad + 128) {
+        ar->cap = ((lwork - pad) / 2) & ~(size_t)63;
+        ar->x = (void *)base;
+        ar->y = (char *)base + ar->cap;
+    }
+    l2_pool_reserve(l2_get_num_threads());
+}
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define SYHE symv
+#include "arena_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef SYHE
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define SYHE symv
+#include "arena_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef SYHE
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define SYHE hemv
+#include "arena_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef SYHE
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define SYHE hemv
+#include "arena_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef SYHE
@@ -0,0 +1,139 @@
+/*
+ * Arena variants of gemv, symv / hemv, trsv and trmv, included once per
+ * precision by arena.c with
+ *   FLOAT  element type (float or double)
+ *   CS     1 for real, 2 for complex
+ *   PREC   name prefix (s, d, c, z)
+ *   SYHE   symv for real, hemv for complex
+ * defined.
+ *
+ * Each checks its arguments under its own name, stages the strided vectors
+ * that fit, and runs the plain routine on unit-stride ones.
+ */
+
+#define AR_CAT_(a, b) a##b
+#define AR_CAT(a, b) AR_CAT_(a, b)
+#define AR_STR_(a) #a
+#define AR_STR(a) AR_STR_(a)
+#define AR_FN(name) AR_CAT(PREC, name)
+#define AR_L2(name) AR_CAT(l2_, AR_FN(name))
+#define AR_ARENA(name) AR_CAT(AR_L2(name), _arena)
+
+#if CS == 1
+#define AR_VEC FLOAT
+#define AR_SCALAR const FLOAT
+#else
+#define AR_VEC void
+#define AR_SCALAR const void *
+#endif
+
+/*
+ * Copies the n elements of v (increment inc) into buf and returns it, or
+ * NULL when the call should use v as it is: unit stride, nothing to copy,
+ * or more than the arena holds.
+ */
+static FLOAT *AR_FN(arena_in)(void *buf, size_t cap, const void *v,
+                              BLASLONG n, BLASLONG inc) {
+    const FLOAT *s = v;
+    FLOAT *d = buf;
+
+    if (inc == 1 || n == 0 || (size_t)n * CS * sizeof(FLOAT) > cap)
+        return NULL;
+    s = L2_VEC_BASE(s, n, CS * inc);
+    for (BLASLONG i = 0; i < n; i++) {
+        d[CS * i] = s[CS * i * inc];
+#if CS == 2
+        d[CS * i + 1] = s[CS * i * inc + 1];
+#endif
+    }
+    return d;
+}
+
+/* The staged vector back into v. */
+static void AR_FN(arena_out)(void *v, const FLOAT *buf, BLASLONG n,
+                             BLASLONG inc) {
+    FLOAT *d = L2_VEC_BASE((FLOAT *)v, n, CS * inc);
+
+    for (BLASLONG i = 0; i < n; i++) {
+        d[CS * i * inc] = buf[CS * i];
+#if CS == 2
+        d[CS * i * inc + 1] = buf[CS * i + 1];
+#endif
+    }
+}
+
+void AR_ARENA(gemv)(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE trans, const blasint m,
+                    const blasint n, AR_SCALAR alpha, const AR_VEC *a,
+                    const blasint lda, const AR_VEC *x, const blasint incx,
+                    AR_SCALAR beta, AR_VEC *y, const blasint incy) {
+    int info = l2_gemv_check(order, trans, m, n, lda, incx, incy);
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    BLASLONG lenx = plain ? n : m, leny = plain ? m : n;
+    FLOAT *xs, *ys;
+
+    if (info) { l2_xerbla(AR_STR(AR_ARENA(gemv)), info); return; }
+    xs = AR_FN(arena_in)(ar->x, ar->cap, x, lenx, incx);
+    ys = AR_FN(arena_in)(ar->y, ar->cap, y, leny, incy);
+    AR_L2(gemv)(order, trans, m, n, alpha, a, lda, xs ? xs : x,
+                xs ? 1 : incx, beta, ys ? ys : y, ys ? 1 : incy);
+    if (ys) AR_FN(arena_out)(y, ys, leny, incy);
+}
+
+void AR_ARENA(SYHE)(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo, const blasint n,
+                    AR_SCALAR alpha, const AR_VEC *a, const blasint lda,
+                    const AR_VEC *x, const blasint incx, AR_SCALAR beta,
+                    AR_VEC *y, const blasint incy) {
+    int info = l2_symv_check(order, uplo, n, lda, incx, incy);
+    FLOAT *xs, *ys;
+
+    if (info) { l2_xerbla(AR_STR(AR_ARENA(SYHE)), info); return; }
+    xs = AR_FN(arena_in)(ar->x, ar->cap, x, n, incx);
+    ys = AR_FN(arena_in)(ar->y, ar->cap, y, n, incy);
+    AR_L2(SYHE)(order, uplo, n, alpha, a, lda, xs ? xs : x, xs ? 1 : incx,
+                beta, ys ? ys : y, ys ? 1 : incy);
+    if (ys) AR_FN(arena_out)(y, ys, n, incy);
+}
+
+void AR_ARENA(trsv)(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const AR_VEC *a, const blasint lda, AR_VEC *x,
+                    const blasint incx) {
+    int info = l2_trxv_check(order, uplo, trans, diag, n, lda, incx);
+    FLOAT *xs;
+
+    if (info) { l2_xerbla(AR_STR(AR_ARENA(trsv)), info); return; }
+    xs = AR_FN(arena_in)(ar->x, ar->cap, x, n, incx);
+    AR_L2(trsv)(order, uplo, trans, diag, n, a, lda, xs ? xs : x,
+                xs ? 1 : incx);
+    if (xs) AR_FN(arena_out)(x, xs, n, incx);
+}
+
+void AR_ARENA(trmv)(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const AR_VEC *a, const blasint lda, AR_VEC *x,
+                    const blasint incx) {
+    int info = l2_trxv_check(order, uplo, trans, diag, n, lda, incx);
+    FLOAT *xs;
+
+    if (info) { l2_xerbla(AR_STR(AR_ARENA(trmv)), info); return; }
+    xs = AR_FN(arena_in)(ar->x, ar->cap, x, n, incx);
+    AR_L2(trmv)(order, uplo, trans, diag, n, a, lda, xs ? xs : x,
+                xs ? 1 : incx);
+    if (xs) AR_FN(arena_out)(x, xs, n, incx);
+}
+
+#undef AR_CAT_
+#undef AR_CAT
+#undef AR_STR_
+#undef AR_STR
+#undef AR_FN
+#undef AR_L2
+#undef AR_ARENA
+#undef AR_VEC
+#undef AR_SCALAR
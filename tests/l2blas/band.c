@@ -0,0 +1,311 @@
+/*
+ * Band-storage routines: ?gbmv, ?sbmv/?hbmv, ?tbmv and ?tbsv.
+ *
+ * A band matrix keeps only its kl+ku+1 (or k+1) nonzero diagonals, lda per
+ * column, so all of these do O(n * bandwidth) work and read O(n * bandwidth)
+ * bytes where the dense routines would touch n*n.  Narrow real bands are
+ * vectorised along the diagonals by the l2_?band_diag kernels; wider real
+ * gbmv bands are cut into dense panels for the gemv kernels, and everything
+ * else reuses the gemv/symv kernels column by column.  See band_template.h.
+ */
+#include "l2blas_internal.h"
+
+void l2_sband_diag_generic(BLASLONG len, int nterms, const BLASLONG *off,
+                           const BLASLONG *shift, float alpha,
+                           const float *a, BLASLONG lda, const float *x,
+                           float *y) {
+    for (BLASLONG i = 0; i < len; i++) {
+        float s = 0.0f;
+        for (int t = 0; t < nterms; t++)
+            s += a[off[t] + i * lda] * x[i + shift[t]];
+        y[i] += alpha * s;
+    }
+}
+
+void l2_dband_diag_generic(BLASLONG len, int nterms, const BLASLONG *off,
+                           const BLASLONG *shift, double alpha,
+                           const double *a, BLASLONG lda, const double *x,
+                           double *y) {
+    for (BLASLONG i = 0; i < len; i++) {
+        double s = 0.0;
+        for (int t = 0; t < nterms; t++)
+            s += a[off[t] + i * lda] * x[i + shift[t]];
+        y[i] += alpha * s;
+    }
+}
+
+static l2_sband_diag_kernel sband_diag_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_sband_diag_avx512;
+    case L2_CORE_AVX2:   return l2_sband_diag_avx2;
+    default:             return l2_sband_diag_generic;
+    }
+}
+
+static l2_dband_diag_kernel dband_diag_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_dband_diag_avx512;
+    case L2_CORE_AVX2:   return l2_dband_diag_avx2;
+    default:             return l2_dband_diag_generic;
+    }
+}
+
+/* Argument checks; each returns the cblas parameter number or 0. */
+static int gbmv_check(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      blasint m, blasint n, blasint kl, blasint ku,
+                      blasint lda, blasint incx, blasint incy) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (trans != CblasNoTrans && trans != CblasTrans &&
+        trans != CblasConjTrans && trans != CblasConjNoTrans) return 2;
+    if (m < 0) return 3;
+    if (n < 0) return 4;
+    if (kl < 0) return 5;
+    if (ku < 0) return 6;
+    if (lda < kl + ku + 1) return 9;
+    if (incx == 0) return 11;
+    if (incy == 0) return 14;
+    return 0;
+}
+
+static int sbmv_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                      blasint n, blasint k, blasint lda, blasint incx,
+                      blasint incy) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (uplo != CblasUpper && uplo != CblasLower) return 2;
+    if (n < 0) return 3;
+    if (k < 0) return 4;
+    if (lda < k + 1) return 7;
+    if (incx == 0) return 9;
+    if (incy == 0) return 12;
+    return 0;
+}
+
+static int tbxv_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                      enum CBLAS_TRANSPOSE trans, enum CBLAS_DIAG diag,
+                      blasint n, blasint k, blasint lda, blasint incx) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (uplo != CblasUpper && uplo != CblasLower) return 2;
+    if (trans != CblasNoTrans && trans != CblasTrans &&
+        trans != CblasConjTrans && trans != CblasConjNoTrans) return 3;
+    if (diag != CblasUnit && diag != CblasNonUnit) return 4;
+    if (n < 0) return 5;
+    if (k < 0) return 6;
+    if (lda < k + 1) return 8;
+    if (incx == 0) return 10;
+    return 0;
+}
+
+static const float  c_one[2] = {1.0f, 0.0f};
+static const double z_one[2] = {1.0, 0.0};
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define AXPY_A(m, s, a, y, incy, conj) \
+    l2_sgemv_pick(1, 1, incy)(m, 1, 1.0f, a, m, s, 1, y, incy)
+#define DOT_A(m, a, x, incx, acc, conj) \
+    l2_sgemv_pick(0, incx, 1)(m, 1, 1.0f, a, m, x, incx, acc, 1)
+#define SYMV_PANEL(m, alpha, a, x1, y1, x2, y2) \
+    l2_ssymv_panel_pick()(m, 1, alpha, a, m, x1, y1, x2, y2)
+#define BAND_DIAG sband_diag_pick()
+#define BAND_PANEL l2_sgemv_pick
+#include "colops_template.h"
+#include "band_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef AXPY_A
+#undef DOT_A
+#undef SYMV_PANEL
+#undef BAND_DIAG
+#undef BAND_PANEL
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define AXPY_A(m, s, a, y, incy, conj) \
+    l2_dgemv_pick(1, 1, incy)(m, 1, 1.0, a, m, s, 1, y, incy)
+#define DOT_A(m, a, x, incx, acc, conj) \
+    l2_dgemv_pick(0, incx, 1)(m, 1, 1.0, a, m, x, incx, acc, 1)
+#define SYMV_PANEL(m, alpha, a, x1, y1, x2, y2) \
+    l2_dsymv_panel_pick()(m, 1, alpha, a, m, x1, y1, x2, y2)
+#define BAND_DIAG dband_diag_pick()
+#define BAND_PANEL l2_dgemv_pick
+#include "colops_template.h"
+#include "band_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef AXPY_A
+#undef DOT_A
+#undef SYMV_PANEL
+#undef BAND_DIAG
+#undef BAND_PANEL
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define AXPY_A(m, s, a, y, incy, conj) \
+    l2_cgemv_n_generic(m, 1, c_one, a, m, s, 1, y, incy, conj)
+#define DOT_A(m, a, x, incx, acc, conj) \
+    l2_cgemv_t_generic(m, 1, c_one, a, m, x, incx, acc, 1, conj)
+#include "colops_template.h"
+#include "band_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef AXPY_A
+#undef DOT_A
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define AXPY_A(m, s, a, y, incy, conj) \
+    l2_zgemv_n_generic(m, 1, z_one, a, m, s, 1, y, incy, conj)
+#define DOT_A(m, a, x, incx, acc, conj) \
+    l2_zgemv_t_generic(m, 1, z_one, a, m, x, incx, acc, 1, conj)
+#include "colops_template.h"
+#include "band_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef AXPY_A
+#undef DOT_A
+
+/* ---- cblas-compatible entry points ---------------------------------------- */
+
+void l2_sgbmv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const blasint kl,
+              const blasint ku, const float alpha, const float *a,
+              const blasint lda, const float *x, const blasint incx,
+              const float beta, float *y, const blasint incy) {
+    sgbmv_driver("l2_sgbmv", order, trans, m, n, kl, ku, &alpha, a, lda, x,
+                 incx, &beta, y, incy);
+}
+
+void l2_dgbmv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const blasint kl,
+              const blasint ku, const double alpha, const double *a,
+              const blasint lda, const double *x, const blasint incx,
+              const double beta, double *y, const blasint incy) {
+    dgbmv_driver("l2_dgbmv", order, trans, m, n, kl, ku, &alpha, a, lda, x,
+                 incx, &beta, y, incy);
+}
+
+void l2_cgbmv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const blasint kl,
+              const blasint ku, const void *alpha, const void *a,
+              const blasint lda, const void *x, const blasint incx,
+              const void *beta, void *y, const blasint incy) {
+    cgbmv_driver("l2_cgbmv", order, trans, m, n, kl, ku, alpha, a, lda, x,
+                 incx, beta, y, incy);
+}
+
+void l2_zgbmv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const blasint kl,
+              const blasint ku, const void *alpha, const void *a,
+              const blasint lda, const void *x, const blasint incx,
+              const void *beta, void *y, const blasint incy) {
+    zgbmv_driver("l2_zgbmv", order, trans, m, n, kl, ku, alpha, a, lda, x,
+                 incx, beta, y, incy);
+}
+
+void l2_ssbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const blasint k, const float alpha,
+              const float *a, const blasint lda, const float *x,
+              const blasint incx, const float beta, float *y,
+              const blasint incy) {
+    ssbmv_driver("l2_ssbmv", order, uplo, n, k, &alpha, a, lda, x, incx,
+                 &beta, y, incy);
+}
+
+void l2_dsbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const blasint k, const double alpha,
+              const double *a, const blasint lda, const double *x,
+              const blasint incx, const double beta, double *y,
+              const blasint incy) {
+    dsbmv_driver("l2_dsbmv", order, uplo, n, k, &alpha, a, lda, x, incx,
+                 &beta, y, incy);
+}
+
+void l2_chbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const blasint k, const void *alpha,
+              const void *a, const blasint lda, const void *x,
+              const blasint incx, const void *beta, void *y,
+              const blasint incy) {
+    csbmv_driver("l2_chbmv", order, uplo, n, k, alpha, a, lda, x, incx, beta,
+                 y, incy);
+}
+
+void l2_zhbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const blasint k, const void *alpha,
+              const void *a, const blasint lda, const void *x,
+              const blasint incx, const void *beta, void *y,
+              const blasint incy) {
+    zsbmv_driver("l2_zhbmv", order, uplo, n, k, alpha, a, lda, x, incx, beta,
+                 y, incy);
+}
+
+void l2_stbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const float *a,
+              const blasint lda, float *x, const blasint incx) {
+    stbxv_driver("l2_stbmv", 0, order, uplo, trans, diag, n, k, a, lda, x,
+                 incx);
+}
+
+void l2_dtbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const double *a,
+              const blasint lda, double *x, const blasint incx) {
+    dtbxv_driver("l2_dtbmv", 0, order, uplo, trans, diag, n, k, a, lda, x,
+                 incx);
+}
+
+void l2_ctbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const void *a,
+              const blasint lda, void *x, const blasint incx) {
+    ctbxv_driver("l2_ctbmv", 0, order, uplo, trans, diag, n, k, a, lda, x,
+                 incx);
+}
+
+void l2_ztbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const void *a,
+              const blasint lda, void *x, const blasint incx) {
+    ztbxv_driver("l2_ztbmv", 0, order, uplo, trans, diag, n, k, a, lda, x,
+                 incx);
+}
+
+void l2_stbsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const float *a,
+              const blasint lda, float *x, const blasint incx) {
+    stbxv_driver("l2_stbsv", 1, order, uplo, trans, diag, n, k, a, lda, x,
+                 incx);
+}
+
+void l2_dtbsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const double *a,
+              const blasint lda, double *x, const blasint incx) {
+    dtbxv_driver("l2_dtbsv", 1, order, uplo, trans, diag, n, k, a, lda, x,
+                 incx);
+}
+
+void l2_ctbsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const void *a,
+              const blasint lda, void *x, const blasint incx) {
+    ctbxv_driver("l2_ctbsv", 1, order, uplo, trans, diag, n, k, a, lda, x,
+                 incx);
+}
+
+void l2_ztbsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const void *a,
+              const blasint lda, void *x, const blasint incx) {
+    ztbxv_driver("l2_ztbsv", 1, order, uplo, trans, diag, n, k, a, lda, x,
+                 incx);
+}
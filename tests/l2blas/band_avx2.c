@@ -0,0 +1,71 @@
+/*
+ * AVX2/FMA band diagonal kernels.  Eight (float) or four (double) rows per
+ * step: every diagonal is one gather at stride lda through the band array
+ * and one unaligned load of x, FMA'd into two alternating accumulators.
+ */
+#include "l2blas_internal.h"
+#include "l2blas_avx2.h"
+
+void l2_sband_diag_avx2(BLASLONG len, int nterms, const BLASLONG *off,
+                        const BLASLONG *shift, float alpha, const float *a,
+                        BLASLONG lda, const float *x, float *y) {
+    const int s = (int)lda;
+    __m256i idx = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s,
+                                    7 * s);
+    __m256 va = _mm256_set1_ps(alpha);
+    BLASLONG i = 0;
+
+    for (; i + 8 <= len; i += 8) {
+        const float *ai = a + i * lda;
+        const float *xi = x + i;
+        __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+        int t = 0;
+
+        for (; t + 2 <= nterms; t += 2) {
+            __m256 v0 = _mm256_i32gather_ps(ai + off[t], idx, 4);
+            __m256 v1 = _mm256_i32gather_ps(ai + off[t + 1], idx, 4);
+            c0 = _mm256_fmadd_ps(v0, _mm256_loadu_ps(xi + shift[t]), c0);
+            c1 = _mm256_fmadd_ps(v1, _mm256_loadu_ps(xi + shift[t + 1]), c1);
+        }
+        if (t < nterms) {
+            __m256 v0 = _mm256_i32gather_ps(ai + off[t], idx, 4);
+            c0 = _mm256_fmadd_ps(v0, _mm256_loadu_ps(xi + shift[t]), c0);
+        }
+        c0 = _mm256_add_ps(c0, c1);
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, c0, _mm256_loadu_ps(y + i)));
+    }
+    if (i < len)
+        l2_sband_diag_generic(len - i, nterms, off, shift, alpha,
+                              a + i * lda, lda, x + i, y + i);
+}
+
+void l2_dband_diag_avx2(BLASLONG len, int nterms, const BLASLONG *off,
+                        const BLASLONG *shift, double alpha, const double *a,
+                        BLASLONG lda, const double *x, double *y) {
+    __m256i idx = _mm256_setr_epi64x(0, lda, 2 * lda, 3 * lda);
+    __m256d va = _mm256_set1_pd(alpha);
+    BLASLONG i = 0;
+
+    for (; i + 4 <= len; i += 4) {
+        const double *ai = a + i * lda;
+        const double *xi = x + i;
+        __m256d c0 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+        int t = 0;
+
+        for (; t + 2 <= nterms; t += 2) {
+            __m256d v0 = _mm256_i64gather_pd(ai + off[t], idx, 8);
+            __m256d v1 = _mm256_i64gather_pd(ai + off[t + 1], idx, 8);
+            c0 = _mm256_fmadd_pd(v0, _mm256_loadu_pd(xi + shift[t]), c0);
+            c1 = _mm256_fmadd_pd(v1, _mm256_loadu_pd(xi + shift[t + 1]), c1);
+        }
+        if (t < nterms) {
+            __m256d v0 = _mm256_i64gather_pd(ai + off[t], idx, 8);
+            c0 = _mm256_fmadd_pd(v0, _mm256_loadu_pd(xi + shift[t]), c0);
+        }
+        c0 = _mm256_add_pd(c0, c1);
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, c0, _mm256_loadu_pd(y + i)));
+    }
+    if (i < len)
+        l2_dband_diag_generic(len - i, nterms, off, shift, alpha,
+                              a + i * lda, lda, x + i, y + i);
+}
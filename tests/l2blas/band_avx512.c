@@ -0,0 +1,80 @@
+/*
+ * AVX-512F band diagonal kernels.  Same scheme as band_avx2.c with 16
+ * (float) or 8 (double) rows per step; the row tail uses masked gathers and
+ * loads instead of a scalar loop.
+ */
+#include <immintrin.h>
+#include "l2blas_internal.h"
+
+void l2_sband_diag_avx512(BLASLONG len, int nterms, const BLASLONG *off,
+                          const BLASLONG *shift, float alpha, const float *a,
+                          BLASLONG lda, const float *x, float *y) {
+    const int s = (int)lda;
+    __m512i idx = _mm512_mullo_epi32(
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+        _mm512_set1_epi32(s));
+    __m512 va = _mm512_set1_ps(alpha);
+    BLASLONG i = 0;
+
+    for (; i < len; i += 16) {
+        const float *ai = a + i * lda;
+        const float *xi = x + i;
+        __mmask16 k = len - i >= 16 ? (__mmask16)0xffff
+                                    : (__mmask16)((1u << (len - i)) - 1u);
+        __m512 z = _mm512_setzero_ps();
+        __m512 c0 = z, c1 = z;
+        int t = 0;
+
+        for (; t + 2 <= nterms; t += 2) {
+            __m512 v0 = _mm512_mask_i32gather_ps(z, k, idx, ai + off[t], 4);
+            __m512 v1 = _mm512_mask_i32gather_ps(z, k, idx, ai + off[t + 1], 4);
+            c0 = _mm512_fmadd_ps(v0, _mm512_maskz_loadu_ps(k, xi + shift[t]), c0);
+            c1 = _mm512_fmadd_ps(v1, _mm512_maskz_loadu_ps(k, xi + shift[t + 1]),
+                                 c1);
+        }
+        if (t < nterms) {
+            __m512 v0 = _mm512_mask_i32gather_ps(z, k, idx, ai + off[t], 4);
+            c0 = _mm512_fmadd_ps(v0, _mm512_maskz_loadu_ps(k, xi + shift[t]), c0);
+        }
+        c0 = _mm512_add_ps(c0, c1);
+        _mm512_mask_storeu_ps(y + i, k,
+                              _mm512_fmadd_ps(va, c0,
+                                              _mm512_maskz_loadu_ps(k, y + i)));
+    }
+}
+
+void l2_dband_diag_avx512(BLASLONG len, int nterms, const BLASLONG *off,
+                          const BLASLONG *shift, double alpha,
+                          const double *a, BLASLONG lda, const double *x,
+                          double *y) {
+    __m512i idx = _mm512_setr_epi64(0, lda, 2 * lda, 3 * lda, 4 * lda,
+                                    5 * lda, 6 * lda, 7 * lda);
+    __m512d va = _mm512_set1_pd(alpha);
+    BLASLONG i = 0;
+
+    for (; i < len; i += 8) {
+        const double *ai = a + i * lda;
+        const double *xi = x + i;
+        __mmask8 k = len - i >= 8 ? (__mmask8)0xff
+                                  : (__mmask8)((1u << (len - i)) - 1u);
+        __m512d z = _mm512_setzero_pd();
+        __m512d c0 = z, c1 = z;
+        int t = 0;
+
+        for (; t + 2 <= nterms; t += 2) {
+            __m512d v0 = _mm512_mask_i64gather_pd(z, k, idx, ai + off[t], 8);
+            __m512d v1 = _mm512_mask_i64gather_pd(z, k, idx, ai + off[t + 1], 8);
+            c0 = _mm512_fmadd_pd(v0, _mm512_maskz_loadu_pd(k, xi + shift[t]), c0);
+            c1 = _mm512_fmadd_pd(v1, _mm512_maskz_loadu_pd(k, xi + shift[t + 1]),
+                                 c1);
+        }
+        if (t < nterms) {
+            __m512d v0 = _mm512_mask_i64gather_pd(z, k, idx, ai + off[t], 8);
+            c0 = _mm512_fmadd_pd(v0, _mm512_maskz_loadu_pd(k, xi + shift[t]), c0);
+        }
+        c0 = _mm512_add_pd(c0, c1);
+        _mm512_mask_storeu_pd(y + i, k,
+                              _mm512_fmadd_pd(va, c0,
+                                              _mm512_maskz_loadu_pd(k, y + i)));
+    }
+}
@@ -0,0 +1,310 @@
+/*
+ * Band-storage bodies, included once per precision by band.c with
+ *   FLOAT     element type (float or double)
+ *   CS        reals per element (1 real, 2 complex)
+ *   PREC      name prefix (s, d, c, z)
+ * defined, after colops_template.h for the same precision, and for real
+ * data
+ *   BAND_DIAG     the l2_?band_diag kernel for the current core
+ *   BAND_PANEL(notrans, incx, incy)   l2_?gemv_pick
+ *
+ * Everything is column-major band storage: A(i,j) of a general band sits at
+ * a[ku+i-j + j*lda], of an upper triangular/symmetric band at a[k+i-j +
+ * j*lda] and of a lower one at a[i-j + j*lda].  A RowMajor band is the
+ * ColMajor band of the transpose (kl and ku swapped for gbmv, the opposite
+ * triangle otherwise; for Hermitian data conj(A), tracked as "cj"), so the
+ * drivers only ever see ColMajor bands.
+ *
+ * Each band column is a contiguous run of at most kl+ku+1 entries, and by
+ * default the drivers go column by column through the gemv kernels,
+ * O(n*bandwidth) work.  Narrow real bands go diagonal by diagonal instead
+ * (band_rows), where a vector of rows is one gather per diagonal rather
+ * than one short kernel call per column; wide real gbmv bands go a panel of
+ * columns at a time (gbmv_panels).
+ */
+
+#define BD_CAT_(a, b) a##b
+#define BD_CAT(a, b) BD_CAT_(a, b)
+#define BD_FN(name) BD_CAT(PREC, name)
+
+#ifdef BAND_DIAG
+/*
+ * y[i] += alpha * sum_t a[off[t] + i*lda] * x[i + shift[t]] for i < len,
+ * where a term only counts while 0 <= i + shift[t] < nx.  The rows where
+ * every term is in range go to the SIMD diagonal kernel; the few at either
+ * end, where diagonals run off the matrix, are done here.
+ */
+static void BD_FN(band_rows)(BLASLONG len, int nterms, const BLASLONG *off,
+                             const BLASLONG *shift, BLASLONG nx, FLOAT alpha,
+                             const FLOAT *a, BLASLONG lda, const FLOAT *x,
+                             FLOAT *y) {
+    BLASLONG lo = 0, hi = len;
+
+    for (int t = 0; t < nterms; t++) {
+        lo = L2_MAX(lo, -shift[t]);
+        hi = L2_MIN(hi, nx - shift[t]);
+    }
+    lo = L2_MIN(lo, len);
+    hi = L2_MAX(hi, lo);
+    for (BLASLONG i = 0; i < len; i++) {
+        FLOAT s = 0;
+
+        if (i == lo && hi > lo) {
+            BAND_DIAG(hi - lo, nterms, off, shift, alpha, a + lo * lda, lda,
+                      x + lo, y + lo);
+            i = hi - 1;
+            continue;
+        }
+        for (int t = 0; t < nterms; t++) {
+            BLASLONG c = i + shift[t];
+            if (c >= 0 && c < nx) s += a[off[t] + i * lda] * x[c];
+        }
+        y[i] += alpha * s;
+    }
+}
+#endif
+
+#ifdef BAND_PANEL
+/*
+ * Wide real bands.  A(i,j) = a[ku + i + j*(lda-1)], so inside a block of
+ * L2_BAND_PANEL_NB columns the rows that are in band for every column form
+ * a dense panel with leading dimension lda-1, which goes to the gemv kernel
+ * in one call.  That leaves nb-1 entries per column, in the two triangles
+ * above and below the panel, for a short scalar loop.
+ */
+static void BD_FN(gbmv_panels)(int notrans, BLASLONG m, BLASLONG n,
+                               BLASLONG kl, BLASLONG ku, FLOAT alpha,
+                               const FLOAT *a, BLASLONG lda, const FLOAT *x,
+                               BLASLONG incx, FLOAT *y, BLASLONG incy) {
+    const BLASLONG nb = L2_BAND_PANEL_NB;
+
+    for (BLASLONG j0 = 0; j0 < n; j0 += nb) {
+        BLASLONG jb = L2_MIN(nb, n - j0);
+        BLASLONG p0 = L2_MAX(0, j0 + jb - 1 - ku), p1 = L2_MIN(m, j0 + kl + 1);
+
+        if (p1 > p0) {
+            const FLOAT *pa = a + ku + p0 + j0 * (lda - 1);
+            if (notrans)
+                BAND_PANEL(1, incx, incy)(p1 - p0, jb, alpha, pa, lda - 1,
+                                          x + j0 * incx, incx, y + p0 * incy,
+                                          incy);
+            else
+                BAND_PANEL(0, incx, incy)(p1 - p0, jb, alpha, pa, lda - 1,
+                                          x + p0 * incx, incx, y + j0 * incy,
+                                          incy);
+        } else {
+            p0 = p1 = 0;
+        }
+        for (BLASLONG j = j0; j < j0 + jb; j++) {
+            BLASLONG r0 = L2_MAX(0, j - ku), r1 = L2_MIN(m, j + kl + 1);
+            const FLOAT *aj = a + ku + j * (lda - 1);
+            FLOAT t = notrans ? alpha * x[j * incx] : 0;
+
+            for (BLASLONG i = r0; i < r1; i++) {
+                if (i == p0 && p1 > p0) i = p1;
+                if (i >= r1) break;
+                if (notrans) y[i * incy] += t * aj[i];
+                else t += aj[i] * x[i * incx];
+            }
+            if (!notrans) y[j * incy] += alpha * t;
+        }
+    }
+}
+#endif
+
+/* y := beta * y over n elements (beta != 1). */
+static void BD_FN(band_scale)(BLASLONG n, const FLOAT *beta, FLOAT *y,
+                              BLASLONG incy) {
+    for (BLASLONG i = 0; i < n; i++) {
+        FLOAT *yi = y + i * incy * CS;
+        if (COL_IS_ZERO(beta))
+            for (int k = 0; k < CS; k++) yi[k] = 0;
+        else
+            BD_FN(col_mul)(yi, beta, yi, 0);
+    }
+}
+
+/* y := alpha * op(A) * x + beta * y for an m x n band, kl sub / ku super. */
+static void BD_FN(gbmv_driver)(const char *rname, enum CBLAS_ORDER order,
+                               enum CBLAS_TRANSPOSE trans, blasint m_in,
+                               blasint n_in, blasint kl_in, blasint ku_in,
+                               const FLOAT *alpha, const FLOAT *a,
+                               blasint lda, const FLOAT *x, blasint incx,
+                               const FLOAT *beta, FLOAT *y, blasint incy) {
+    int info = gbmv_check(order, trans, m_in, n_in, kl_in, ku_in, lda, incx,
+                          incy);
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int conj = CS == 2 &&
+               (trans == CblasConjTrans || trans == CblasConjNoTrans);
+    int col = order == CblasColMajor, notrans = plain == col;
+    BLASLONG m = col ? m_in : n_in, n = col ? n_in : m_in;
+    BLASLONG kl = col ? kl_in : ku_in, ku = col ? ku_in : kl_in;
+    BLASLONG lenx, leny;
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (m == 0 || n == 0 || (COL_IS_ZERO(alpha) && COL_IS_ONE(beta))) return;
+
+    lenx = notrans ? n : m;
+    leny = notrans ? m : n;
+    x = L2_VEC_BASE(x, lenx, incx * CS);
+    y = L2_VEC_BASE(y, leny, incy * CS);
+    if (!COL_IS_ONE(beta)) BD_FN(band_scale)(leny, beta, y, incy);
+    if (COL_IS_ZERO(alpha)) return;
+
+#ifdef BAND_DIAG
+    if (incx == 1 && incy == 1 && kl + ku + 1 <= L2_BAND_DIAG_MAX &&
+        lda <= L2_BAND_DIAG_LDA) {
+        BLASLONG off[L2_BAND_DIAG_MAX], shift[L2_BAND_DIAG_MAX];
+        int nt = 0;
+
+        /* Diagonal d holds A(i, i-d); row i of op(A) meets it at a[ku+d +
+         * (i-d)*lda] (NoTrans) or, transposed, at a[ku+d + i*lda]. */
+        for (BLASLONG d = -ku; d <= kl; d++, nt++) {
+            off[nt] = notrans ? ku + d - d * lda : ku + d;
+            shift[nt] = notrans ? -d : d;
+        }
+        /* Rows past the last diagonal's end are all zero. */
+        BD_FN(band_rows)(L2_MIN(leny, lenx + (notrans ? kl : ku)), nt, off,
+                         shift, lenx, alpha[0], a, lda, x, y);
+        return;
+    }
+#endif
+#ifdef BAND_PANEL
+    if (kl + ku + 1 >= 2 * L2_BAND_PANEL_NB) {
+        BD_FN(gbmv_panels)(notrans, m, n, kl, ku, alpha[0], a, lda, x, incx,
+                           y, incy);
+        return;
+    }
+#endif
+    for (BLASLONG j = 0; j < n; j++) {
+        BLASLONG i0 = L2_MAX(0, j - ku), i1 = L2_MIN(m - 1, j + kl);
+        const FLOAT *seg = a + (ku + i0 - j + j * lda) * CS;
+        const FLOAT *xj = x + j * incx * CS;
+        FLOAT *yj = y + j * incy * CS;
+        FLOAT t[CS];
+
+        if (i0 > i1) continue;
+        if (notrans) {
+            BD_FN(col_mul)(t, alpha, xj, 0);
+            BD_FN(col_axpy)(i1 - i0 + 1, t, seg, 1, y + i0 * incy * CS, incy,
+                            conj);
+        } else {
+            for (int k = 0; k < CS; k++) t[k] = 0;
+            BD_FN(col_dot)(i1 - i0 + 1, seg, x + i0 * incx * CS, incx, t,
+                           conj);
+            BD_FN(col_mul)(t, alpha, t, 0);
+            for (int k = 0; k < CS; k++) yj[k] += t[k];
+        }
+    }
+}
+
+/* y := alpha * A * x + beta * y; sbmv for real data, hbmv for complex. */
+static void BD_FN(sbmv_driver)(const char *rname, enum CBLAS_ORDER order,
+                               enum CBLAS_UPLO uplo, blasint n, blasint k,
+                               const FLOAT *alpha, const FLOAT *a,
+                               blasint lda, const FLOAT *x, blasint incx,
+                               const FLOAT *beta, FLOAT *y, blasint incy) {
+    int info = sbmv_check(order, uplo, n, k, lda, incx, incy);
+    int lower, cj = CS == 2 && order == CblasRowMajor;
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (n == 0 || (COL_IS_ZERO(alpha) && COL_IS_ONE(beta))) return;
+
+    x = L2_VEC_BASE(x, n, incx * CS);
+    y = L2_VEC_BASE(y, n, incy * CS);
+    if (!COL_IS_ONE(beta)) BD_FN(band_scale)(n, beta, y, incy);
+    if (COL_IS_ZERO(alpha)) return;
+
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+#ifdef BAND_DIAG
+    if (incx == 1 && incy == 1 && 2 * k + 1 <= L2_BAND_DIAG_MAX &&
+        lda <= L2_BAND_DIAG_LDA) {
+        BLASLONG off[L2_BAND_DIAG_MAX], shift[L2_BAND_DIAG_MAX];
+        int nt = 0;
+
+        /* Stored diagonal d read down its column (A(i, i-d) for the lower
+         * triangle, A(i, i+d) upper) and, for d > 0, along its row. */
+        for (BLASLONG d = 0; d <= k; d++, nt++) {
+            off[nt] = lower ? d - d * lda : k - d + d * lda;
+            shift[nt] = lower ? -d : d;
+        }
+        for (BLASLONG d = 1; d <= k; d++, nt++) {
+            off[nt] = lower ? d : k - d;
+            shift[nt] = lower ? d : -d;
+        }
+        BD_FN(band_rows)(n, nt, off, shift, n, alpha[0], a, lda, x, y);
+        return;
+    }
+#endif
+    for (BLASLONG j = 0; j < n; j++) {
+        BLASLONG mj = lower ? L2_MIN(k, n - 1 - j) : L2_MIN(k, j);
+        BLASLONG i0 = lower ? j + 1 : j - mj;
+        const FLOAT *d = a + ((lower ? 0 : k) + j * lda) * CS;
+        const FLOAT *seg = lower ? d + CS : d - mj * CS;
+        const FLOAT *xj = x + j * incx * CS;
+        FLOAT *yj = y + j * incy * CS;
+        FLOAT t[CS];
+
+        BD_FN(col_symv)(mj, alpha, seg, x + i0 * incx * CS, incx,
+                        y + i0 * incy * CS, incy, xj, yj, cj);
+        /* The imaginary part of a Hermitian diagonal is taken as zero. */
+        BD_FN(col_mul)(t, alpha, xj, 0);
+        for (int c = 0; c < CS; c++) yj[c] += t[c] * d[0];
+    }
+}
+
+/* x := op(A) * x (tbmv) or x := op(A)^-1 * x (tbsv). */
+static void BD_FN(tbxv_driver)(const char *rname, int solve,
+                               enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                               enum CBLAS_TRANSPOSE trans,
+                               enum CBLAS_DIAG diag, blasint n, blasint k,
+                               const FLOAT *a, blasint lda, FLOAT *x,
+                               blasint incx) {
+    int info = tbxv_check(order, uplo, trans, diag, n, k, lda, incx);
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int conj = CS == 2 &&
+               (trans == CblasConjTrans || trans == CblasConjNoTrans);
+    int unit = diag == CblasUnit, lower, notrans, forward;
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (n == 0) return;
+
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    notrans = plain == (order == CblasColMajor);
+    x = L2_VEC_BASE(x, n, incx * CS);
+
+    /* Same column order as tpxv_driver in packed_template.h. */
+    forward = solve ? lower == notrans : lower != notrans;
+    for (BLASLONG q = 0; q < n; q++) {
+        BLASLONG j = forward ? q : n - 1 - q;
+        BLASLONG mj = lower ? L2_MIN(k, n - 1 - j) : L2_MIN(k, j);
+        BLASLONG i0 = lower ? j + 1 : j - mj;
+        const FLOAT *d = a + ((lower ? 0 : k) + j * lda) * CS;
+        const FLOAT *seg = lower ? d + CS : d - mj * CS;
+        FLOAT *xj = x + j * incx * CS, *xo = x + i0 * incx * CS;
+        FLOAT t[CS];
+
+        if (notrans) {
+            if (solve && !unit) BD_FN(col_div)(xj, d, conj);
+            for (int c = 0; c < CS; c++) t[c] = solve ? -xj[c] : xj[c];
+            BD_FN(col_axpy)(mj, t, seg, 1, xo, incx, conj);
+            if (!solve && !unit) BD_FN(col_mul)(xj, xj, d, conj);
+        } else if (solve) {
+            for (int c = 0; c < CS; c++) t[c] = 0;
+            BD_FN(col_dot)(mj, seg, xo, incx, t, conj);
+            for (int c = 0; c < CS; c++) xj[c] -= t[c];
+            if (!unit) BD_FN(col_div)(xj, d, conj);
+        } else {
+            if (unit)
+                for (int c = 0; c < CS; c++) t[c] = xj[c];
+            else
+                BD_FN(col_mul)(t, xj, d, conj);
+            BD_FN(col_dot)(mj, seg, xo, incx, t, conj);
+            for (int c = 0; c < CS; c++) xj[c] = t[c];
+        }
+    }
+}
+
+#undef BD_FN
+#undef BD_CAT
+#undef BD_CAT_
@@ -0,0 +1,252 @@
+/*
+ * Complex gemv (cgemv/zgemv) on interleaved storage.
+ *
+ * In column-major terms the four cblas operations map onto the two
+ * directions of the complex gemv panel:
+ *   NoTrans -> y1 += A x2,  ConjNoTrans -> the same with conj(A),
+ *   Trans   -> y2 += A^T x1, ConjTrans  -> the same with conj(A).
+ * A RowMajor matrix is the ColMajor transpose, which swaps the directions
+ * and keeps the conjugation.  The SIMD tiers run the split-complex panels
+ * of cgemv_avx2.c / cgemv_avx512.c; the generic tier the kernels below.
+ */
+#include <stddef.h>
+#include "l2blas_internal.h"
+
+/* ---- portable kernels (any increments) ---------------------------------- */
+
+void l2_cgemv_n_generic(BLASLONG m, BLASLONG n, const float *alpha,
+                        const float *a, BLASLONG lda, const float *x,
+                        BLASLONG incx, float *y, BLASLONG incy, int conj) {
+    float sg = conj ? -1.0f : 1.0f;
+
+    for (BLASLONG j = 0; j < n; j++) {
+        const float *col = a + 2 * j * lda;
+        float xr = x[2 * j * incx], xi = x[2 * j * incx + 1];
+        float tr = alpha[0] * xr - alpha[1] * xi;
+        float ti = alpha[0] * xi + alpha[1] * xr;
+        for (BLASLONG i = 0; i < m; i++) {
+            float ar = col[2 * i], ai = sg * col[2 * i + 1];
+            y[2 * i * incy]     += ar * tr - ai * ti;
+            y[2 * i * incy + 1] += ar * ti + ai * tr;
+        }
+    }
+}
+
+void l2_cgemv_t_generic(BLASLONG m, BLASLONG n, const float *alpha,
+                        const float *a, BLASLONG lda, const float *x,
+                        BLASLONG incx, float *y, BLASLONG incy, int conj) {
+    float sg = conj ? -1.0f : 1.0f;
+
+    for (BLASLONG j = 0; j < n; j++) {
+        const float *col = a + 2 * j * lda;
+        float sr = 0.0f, si = 0.0f;
+        for (BLASLONG i = 0; i < m; i++) {
+            float ar = col[2 * i], ai = sg * col[2 * i + 1];
+            float xr = x[2 * i * incx], xi = x[2 * i * incx + 1];
+            sr += ar * xr - ai * xi;
+            si += ar * xi + ai * xr;
+        }
+        y[2 * j * incy]     += alpha[0] * sr - alpha[1] * si;
+        y[2 * j * incy + 1] += alpha[0] * si + alpha[1] * sr;
+    }
+}
+
+void l2_zgemv_n_generic(BLASLONG m, BLASLONG n, const double *alpha,
+                        const double *a, BLASLONG lda, const double *x,
+                        BLASLONG incx, double *y, BLASLONG incy, int conj) {
+    double sg = conj ? -1.0 : 1.0;
+
+    for (BLASLONG j = 0; j < n; j++) {
+        const double *col = a + 2 * j * lda;
+        double xr = x[2 * j * incx], xi = x[2 * j * incx + 1];
+        double tr = alpha[0] * xr - alpha[1] * xi;
+        double ti = alpha[0] * xi + alpha[1] * xr;
+        for (BLASLONG i = 0; i < m; i++) {
+            double ar = col[2 * i], ai = sg * col[2 * i + 1];
+            y[2 * i * incy]     += ar * tr - ai * ti;
+            y[2 * i * incy + 1] += ar * ti + ai * tr;
+        }
+    }
+}
+
+void l2_zgemv_t_generic(BLASLONG m, BLASLONG n, const double *alpha,
+                        const double *a, BLASLONG lda, const double *x,
+                        BLASLONG incx, double *y, BLASLONG incy, int conj) {
+    double sg = conj ? -1.0 : 1.0;
+
+    for (BLASLONG j = 0; j < n; j++) {
+        const double *col = a + 2 * j * lda;
+        double sr = 0.0, si = 0.0;
+        for (BLASLONG i = 0; i < m; i++) {
+            double ar = col[2 * i], ai = sg * col[2 * i + 1];
+            double xr = x[2 * i * incx], xi = x[2 * i * incx + 1];
+            sr += ar * xr - ai * xi;
+            si += ar * xi + ai * xr;
+        }
+        y[2 * j * incy]     += alpha[0] * sr - alpha[1] * si;
+        y[2 * j * incy + 1] += alpha[0] * si + alpha[1] * sr;
+    }
+}
+
+/* Generic panel: the two directions as separate passes over A. */
+void l2_cgemv_panel_generic(BLASLONG m, BLASLONG n, const float *alpha,
+                            const float *a, BLASLONG lda,
+                            const float *x1, BLASLONG incx1,
+                            float *y1, BLASLONG incy1,
+                            const float *x2, BLASLONG incx2,
+                            float *y2, BLASLONG incy2,
+                            int conj1, int conj2) {
+    if (y1)
+        l2_cgemv_n_generic(m, n, alpha, a, lda, x2, incx2, y1, incy1, conj1);
+    if (y2)
+        l2_cgemv_t_generic(m, n, alpha, a, lda, x1, incx1, y2, incy2, conj2);
+}
+
+void l2_zgemv_panel_generic(BLASLONG m, BLASLONG n, const double *alpha,
+                            const double *a, BLASLONG lda,
+                            const double *x1, BLASLONG incx1,
+                            double *y1, BLASLONG incy1,
+                            const double *x2, BLASLONG incx2,
+                            double *y2, BLASLONG incy2,
+                            int conj1, int conj2) {
+    if (y1)
+        l2_zgemv_n_generic(m, n, alpha, a, lda, x2, incx2, y1, incy1, conj1);
+    if (y2)
+        l2_zgemv_t_generic(m, n, alpha, a, lda, x1, incx1, y2, incy2, conj2);
+}
+
+/* ---- dispatch ------------------------------------------------------------ */
+
+l2_cgemv_panel_kernel l2_cgemv_panel_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_cgemv_panel_avx512;
+    case L2_CORE_AVX2:   return l2_cgemv_panel_avx2;
+    default:             return l2_cgemv_panel_generic;
+    }
+}
+
+l2_zgemv_panel_kernel l2_zgemv_panel_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_zgemv_panel_avx512;
+    case L2_CORE_AVX2:   return l2_zgemv_panel_avx2;
+    default:             return l2_zgemv_panel_generic;
+    }
+}
+
+/* ---- drivers ------------------------------------------------------------- */
+
+void l2_cgemv_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      BLASLONG m, BLASLONG n, const float *alpha,
+                      const float *a, BLASLONG lda, const float *x,
+                      BLASLONG incx, const float *beta, float *y,
+                      BLASLONG incy) {
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int conj = trans == CblasConjTrans || trans == CblasConjNoTrans;
+    int alpha0 = alpha[0] == 0.0f && alpha[1] == 0.0f;
+    BLASLONG lenx, leny, rows, cols;
+
+    if (m == 0 || n == 0 ||
+        (alpha0 && beta[0] == 1.0f && beta[1] == 0.0f)) return;
+
+    lenx = plain ? n : m;
+    leny = plain ? m : n;
+    x = L2_VEC_BASE(x, lenx, 2 * incx);
+    y = L2_VEC_BASE(y, leny, 2 * incy);
+
+    if (beta[0] != 1.0f || beta[1] != 0.0f) {
+        /* the test hoisted out of the loops, so both vectorize */
+        if (beta[0] == 0.0f && beta[1] == 0.0f) {
+            for (BLASLONG i = 0; i < leny; i++) {
+                y[2 * i * incy] = 0.0f;
+                y[2 * i * incy + 1] = 0.0f;
+            }
+        } else {
+            for (BLASLONG i = 0; i < leny; i++) {
+                float *yi = y + 2 * i * incy;
+                float r = beta[0] * yi[0] - beta[1] * yi[1];
+                yi[1] = beta[0] * yi[1] + beta[1] * yi[0];
+                yi[0] = r;
+            }
+        }
+    }
+    if (alpha0) return;
+
+    rows = order == CblasColMajor ? m : n;
+    cols = order == CblasColMajor ? n : m;
+
+    if (plain == (order == CblasColMajor))
+        l2_cgemv_panel_pick()(rows, cols, alpha, a, lda, NULL, 0, y, incy,
+                               x, incx, NULL, 0, conj, 0);
+    else
+        l2_cgemv_panel_pick()(rows, cols, alpha, a, lda, x, incx, NULL, 0,
+                               NULL, 0, y, incy, 0, conj);
+}
+
+void l2_zgemv_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      BLASLONG m, BLASLONG n, const double *alpha,
+                      const double *a, BLASLONG lda, const double *x,
+                      BLASLONG incx, const double *beta, double *y,
+                      BLASLONG incy) {
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int conj = trans == CblasConjTrans || trans == CblasConjNoTrans;
+    int alpha0 = alpha[0] == 0.0 && alpha[1] == 0.0;
+    BLASLONG lenx, leny, rows, cols;
+
+    if (m == 0 || n == 0 ||
+        (alpha0 && beta[0] == 1.0 && beta[1] == 0.0)) return;
+
+    lenx = plain ? n : m;
+    leny = plain ? m : n;
+    x = L2_VEC_BASE(x, lenx, 2 * incx);
+    y = L2_VEC_BASE(y, leny, 2 * incy);
+
+    if (beta[0] != 1.0 || beta[1] != 0.0) {
+        /* the test hoisted out of the loops, so both vectorize */
+        if (beta[0] == 0.0 && beta[1] == 0.0) {
+            for (BLASLONG i = 0; i < leny; i++) {
+                y[2 * i * incy] = 0.0;
+                y[2 * i * incy + 1] = 0.0;
+            }
+        } else {
+            for (BLASLONG i = 0; i < leny; i++) {
+                double *yi = y + 2 * i * incy;
+                double r = beta[0] * yi[0] - beta[1] * yi[1];
+                yi[1] = beta[0] * yi[1] + beta[1] * yi[0];
+                yi[0] = r;
+            }
+        }
+    }
+    if (alpha0) return;
+
+    rows = order == CblasColMajor ? m : n;
+    cols = order == CblasColMajor ? n : m;
+
+    if (plain == (order == CblasColMajor))
+        l2_zgemv_panel_pick()(rows, cols, alpha, a, lda, NULL, 0, y, incy,
+                               x, incx, NULL, 0, conj, 0);
+    else
+        l2_zgemv_panel_pick()(rows, cols, alpha, a, lda, x, incx, NULL, 0,
+                               NULL, 0, y, incy, 0, conj);
+}
+
+void l2_cgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const void *alpha,
+              const void *a, const blasint lda, const void *x,
+              const blasint incx, const void *beta, void *y,
+              const blasint incy) {
+    int info = l2_gemv_check(order, trans, m, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_cgemv", info); return; }
+    l2_cgemv_compute(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+void l2_zgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const void *alpha,
+              const void *a, const blasint lda, const void *x,
+              const blasint incx, const void *beta, void *y,
+              const blasint incy) {
+    int info = l2_gemv_check(order, trans, m, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_zgemv", info); return; }
+    l2_zgemv_compute(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
@@ -0,0 +1,78 @@
+/*
+ * AVX2/FMA split-complex gemv panels (cgemv_template.h).  Built with
+ * -mavx2 -mfma; only called when l2_core() reports at least L2_CORE_AVX2.
+ *
+ * Splitting two vectors of interleaved data takes one in-lane shuffle per
+ * half (shuffle_ps / unpack*_pd), which leaves the rows permuted within
+ * each 128-bit lane; the unpacks of V_MERGE undo exactly that.
+ */
+#include <stddef.h>
+#include "l2blas_internal.h"
+#include "l2blas_avx2.h"
+
+#define ISA avx2
+
+#define FLOAT float
+#define PREC c
+#define VEC __m256
+#define VL 8
+#define V_ZERO() _mm256_setzero_ps()
+#define V_SET1(s) _mm256_set1_ps(s)
+#define V_ADD(a, b) _mm256_add_ps(a, b)
+#define V_MUL(a, b) _mm256_mul_ps(a, b)
+#define V_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#define V_HSUM(v) l2_hsum_ps(v)
+#define V_CSUM(p, q, out) l2_csum_ps(p, q, out)
+#define V_LOAD(p) _mm256_loadu_ps(p)
+#define V_STORE(p, v) _mm256_storeu_ps(p, v)
+#define V_SPLIT(p, re, im) do {                                            \
+        __m256 lo_ = _mm256_loadu_ps(p), hi_ = _mm256_loadu_ps((p) + 8);   \
+        re = _mm256_shuffle_ps(lo_, hi_, 0x88);                            \
+        im = _mm256_shuffle_ps(lo_, hi_, 0xdd);                            \
+    } while (0)
+#define V_MERGE(p, re, im) do {                                            \
+        __m256 re_ = (re), im_ = (im);                                     \
+        _mm256_storeu_ps(p, _mm256_unpacklo_ps(re_, im_));                 \
+        _mm256_storeu_ps((p) + 8, _mm256_unpackhi_ps(re_, im_));           \
+    } while (0)
+#include "cgemv_template.h"
+#undef FLOAT
+#undef PREC
+#undef VEC
+#undef VL
+#undef V_ZERO
+#undef V_SET1
+#undef V_ADD
+#undef V_MUL
+#undef V_FMA
+#undef V_HSUM
+#undef V_CSUM
+#undef V_LOAD
+#undef V_STORE
+#undef V_SPLIT
+#undef V_MERGE
+
+#define FLOAT double
+#define PREC z
+#define VEC __m256d
+#define VL 4
+#define V_ZERO() _mm256_setzero_pd()
+#define V_SET1(s) _mm256_set1_pd(s)
+#define V_ADD(a, b) _mm256_add_pd(a, b)
+#define V_MUL(a, b) _mm256_mul_pd(a, b)
+#define V_FMA(a, b, c) _mm256_fmadd_pd(a, b, c)
+#define V_HSUM(v) l2_hsum_pd(v)
+#define V_CSUM(p, q, out) l2_csum_pd(p, q, out)
+#define V_LOAD(p) _mm256_loadu_pd(p)
+#define V_STORE(p, v) _mm256_storeu_pd(p, v)
+#define V_SPLIT(p, re, im) do {                                            \
+        __m256d lo_ = _mm256_loadu_pd(p), hi_ = _mm256_loadu_pd((p) + 4);  \
+        re = _mm256_unpacklo_pd(lo_, hi_);                                 \
+        im = _mm256_unpackhi_pd(lo_, hi_);                                 \
+    } while (0)
+#define V_MERGE(p, re, im) do {                                            \
+        __m256d re_ = (re), im_ = (im);                                    \
+        _mm256_storeu_pd(p, _mm256_unpacklo_pd(re_, im_));                 \
+        _mm256_storeu_pd((p) + 4, _mm256_unpackhi_pd(re_, im_));           \
+    } while (0)
+#include "cgemv_template.h"
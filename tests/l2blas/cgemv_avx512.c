@@ -0,0 +1,99 @@
+/*
+ * AVX-512F split-complex gemv panels (cgemv_template.h), 16 (float) or 8
+ * (double) rows per step.  Built with -mavx512f; only called when l2_core()
+ * reports L2_CORE_AVX512.  Same in-lane split as cgemv_avx2.c.
+ */
+#include <stddef.h>
+#include <immintrin.h>
+#include "l2blas_internal.h"
+
+/* out[0] = sum of p, out[1] = sum of q: the unpacks leave (p, q) pairs in
+ * every lane, which then fold down to the low pair. */
+static inline void csum_ps(__m512 p, __m512 q, float *out) {
+    __m512 t = _mm512_add_ps(_mm512_unpacklo_ps(p, q),
+                             _mm512_unpackhi_ps(p, q));
+    __m256 h = _mm256_add_ps(_mm512_castps512_ps256(t),
+                             _mm256_castpd_ps(_mm512_extractf64x4_pd(
+                                 _mm512_castps_pd(t), 1)));
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(h),
+                          _mm256_extractf128_ps(h, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    _mm_store_ss(out, s);
+    _mm_store_ss(out + 1, _mm_movehdup_ps(s));
+}
+
+static inline void csum_pd(__m512d p, __m512d q, double *out) {
+    __m512d t = _mm512_add_pd(_mm512_unpacklo_pd(p, q),
+                              _mm512_unpackhi_pd(p, q));
+    __m256d h = _mm256_add_pd(_mm512_castpd512_pd256(t),
+                              _mm512_extractf64x4_pd(t, 1));
+    _mm_storeu_pd(out, _mm_add_pd(_mm256_castpd256_pd128(h),
+                                  _mm256_extractf128_pd(h, 1)));
+}
+
+#define ISA avx512
+
+#define FLOAT float
+#define PREC c
+#define VEC __m512
+#define VL 16
+#define V_ZERO() _mm512_setzero_ps()
+#define V_SET1(s) _mm512_set1_ps(s)
+#define V_ADD(a, b) _mm512_add_ps(a, b)
+#define V_MUL(a, b) _mm512_mul_ps(a, b)
+#define V_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define V_HSUM(v) _mm512_reduce_add_ps(v)
+#define V_CSUM(p, q, out) csum_ps(p, q, out)
+#define V_LOAD(p) _mm512_loadu_ps(p)
+#define V_STORE(p, v) _mm512_storeu_ps(p, v)
+#define V_SPLIT(p, re, im) do {                                            \
+        __m512 lo_ = _mm512_loadu_ps(p), hi_ = _mm512_loadu_ps((p) + 16);  \
+        re = _mm512_shuffle_ps(lo_, hi_, 0x88);                            \
+        im = _mm512_shuffle_ps(lo_, hi_, 0xdd);                            \
+    } while (0)
+#define V_MERGE(p, re, im) do {                                            \
+        __m512 re_ = (re), im_ = (im);                                     \
+        _mm512_storeu_ps(p, _mm512_unpacklo_ps(re_, im_));                 \
+        _mm512_storeu_ps((p) + 16, _mm512_unpackhi_ps(re_, im_));          \
+    } while (0)
+#include "cgemv_template.h"
+#undef FLOAT
+#undef PREC
+#undef VEC
+#undef VL
+#undef V_ZERO
+#undef V_SET1
+#undef V_ADD
+#undef V_MUL
+#undef V_FMA
+#undef V_HSUM
+#undef V_CSUM
+#undef V_LOAD
+#undef V_STORE
+#undef V_SPLIT
+#undef V_MERGE
+
+#define FLOAT double
+#define PREC z
+#define VEC __m512d
+#define VL 8
+#define V_ZERO() _mm512_setzero_pd()
+#define V_SET1(s) _mm512_set1_pd(s)
+#define V_ADD(a, b) _mm512_add_pd(a, b)
+#define V_MUL(a, b) _mm512_mul_pd(a, b)
+#define V_FMA(a, b, c) _mm512_fmadd_pd(a, b, c)
+#define V_HSUM(v) _mm512_reduce_add_pd(v)
+#define V_CSUM(p, q, out) csum_pd(p, q, out)
+#define V_LOAD(p) _mm512_loadu_pd(p)
+#define V_STORE(p, v) _mm512_storeu_pd(p, v)
+#define V_SPLIT(p, re, im) do {                                            \
+        __m512d lo_ = _mm512_loadu_pd(p), hi_ = _mm512_loadu_pd((p) + 8);  \
+        re = _mm512_unpacklo_pd(lo_, hi_);                                 \
+        im = _mm512_unpackhi_pd(lo_, hi_);                                 \
+    } while (0)
+#define V_MERGE(p, re, im) do {                                            \
+        __m512d re_ = (re), im_ = (im);                                    \
+        _mm512_storeu_pd(p, _mm512_unpacklo_pd(re_, im_));                 \
+        _mm512_storeu_pd((p) + 8, _mm512_unpackhi_pd(re_, im_));           \
+    } while (0)
+#include "cgemv_template.h"
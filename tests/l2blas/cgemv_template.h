@@ -0,0 +1,403 @@
+/*
+ * Split-complex gemv panel (see l2_cgemv_panel_* in l2blas_internal.h),
+ * included once per precision by cgemv_avx2.c and cgemv_avx512.c with
+ *   FLOAT     element type (float or double)
+ *   PREC      name prefix (c, z)
+ *   ISA       name suffix (avx2, avx512)
+ *   VEC       vector type, VL reals wide
+ *   V_ZERO()  V_SET1(s)  V_ADD(a, b)  V_MUL(a, b)  V_FMA(a, b, c) = a*b + c
+ *   V_HSUM(v)  V_CSUM(p, q, out): out[0] = V_HSUM(p), out[1] = V_HSUM(q)
+ *   V_LOAD(p)  V_STORE(p, v)     unaligned, on the split arrays
+ *   V_SPLIT(p, re, im)   VL interleaved complex at p -> real, imaginary
+ *   V_MERGE(p, re, im)   the inverse of V_SPLIT
+ * defined.  V_SPLIT is free to leave the lanes in any order (in-lane
+ * shuffles do) as long as V_MERGE puts them back: A, x1 and y1 all go
+ * through it, so row i of A always meets row i of x1 and y1.
+ *
+ * With op(a) = ar + i*s*ai (s = -1 conjugates), one complex multiply-add
+ * is four FMAs once the signs are moved out of the loop:
+ *   y1 += op1(a) * t   yr += ar*tr + ai*(-s1*ti),  yi += ar*ti + ai*(s1*tr)
+ *                      with t = alpha * x2(j) broadcast per column;
+ *   acc += op2(a) * x1 accr += ar*xr + ai*(-s2*xi), acci += ar*xi + ai*(s2*xr)
+ *                      with x1 converted to all four of xr, xi, -s2*xi,
+ *                      s2*xr once per row tile.
+ * Rows past the last whole vector go through scalar code on the
+ * interleaved data.
+ */
+
+#define CS_CAT_(a, b) a##b
+#define CS_CAT(a, b) CS_CAT_(a, b)
+#define CS_FN(name) CS_CAT(PREC, name)
+#define CS_KERNEL CS_CAT(CS_CAT(l2_, PREC), CS_CAT(gemv_panel_, ISA))
+
+#define CS_MB L2_CSPLIT_MB(FLOAT)
+
+/*
+ * Split arrays of one row tile.  The dot-only panel (y1 NULL) keeps x1
+ * interleaved instead, as xp = (xr, -s*xi) and xq = (xi, s*xr) per row.
+ */
+typedef struct {
+    union {
+        struct {
+            FLOAT xr[CS_MB], xi[CS_MB], xs[CS_MB], xc[CS_MB];  /* x1 */
+        };
+        struct {
+            FLOAT xp[2 * CS_MB], xq[2 * CS_MB];
+        };
+    };
+    FLOAT yr[CS_MB], yi[CS_MB];                             /* y1 */
+} CS_FN(split_tile);
+
+/* VL complex starting at p with increment inc, gathered for V_SPLIT. */
+static inline const FLOAT *CS_FN(gather)(const FLOAT *p, BLASLONG inc,
+                                         FLOAT *tmp) {
+    if (inc == 1) return p;
+    for (int k = 0; k < VL; k++) {
+        tmp[2 * k]     = p[2 * k * inc];
+        tmp[2 * k + 1] = p[2 * k * inc + 1];
+    }
+    return tmp;
+}
+
+/* x1 rows [0, len) -> xr, xi, xs = -s*xi, xc = s*xr; len a multiple of VL. */
+static void CS_FN(split_x)(BLASLONG len, const FLOAT *x, BLASLONG inc,
+                           FLOAT s, CS_FN(split_tile) *t) {
+    FLOAT tmp[2 * VL];
+    VEC vs = V_SET1(s), vns = V_SET1(-s);
+
+    for (BLASLONG i = 0; i < len; i += VL) {
+        VEC re, im;
+        V_SPLIT(CS_FN(gather)(x + 2 * i * inc, inc, tmp), re, im);
+        V_STORE(t->xr + i, re);
+        V_STORE(t->xi + i, im);
+        V_STORE(t->xs + i, V_MUL(vns, im));
+        V_STORE(t->xc + i, V_MUL(vs, re));
+    }
+}
+
+/* x1 rows [0, len) -> xp, xq of the dot-only panel. */
+static void CS_FN(pair_x)(BLASLONG len, const FLOAT *x, BLASLONG inc,
+                          FLOAT s, CS_FN(split_tile) *t) {
+    if (inc == 1) {             /* the same loop, left for the vectorizer */
+        for (BLASLONG i = 0; i < len; i++) {
+            FLOAT r = x[2 * i], m = x[2 * i + 1];
+            t->xp[2 * i] = r;
+            t->xp[2 * i + 1] = -s * m;
+            t->xq[2 * i] = m;
+            t->xq[2 * i + 1] = s * r;
+        }
+        return;
+    }
+    for (BLASLONG i = 0; i < len; i++) {
+        FLOAT r = x[2 * i * inc], m = x[2 * i * inc + 1];
+        t->xp[2 * i] = r;
+        t->xp[2 * i + 1] = -s * m;
+        t->xq[2 * i] = m;
+        t->xq[2 * i + 1] = s * r;
+    }
+}
+
+static void CS_FN(split_y)(BLASLONG len, const FLOAT *y, BLASLONG inc,
+                           CS_FN(split_tile) *t) {
+    FLOAT tmp[2 * VL];
+
+    for (BLASLONG i = 0; i < len; i += VL) {
+        VEC re, im;
+        V_SPLIT(CS_FN(gather)(y + 2 * i * inc, inc, tmp), re, im);
+        V_STORE(t->yr + i, re);
+        V_STORE(t->yi + i, im);
+    }
+}
+
+static void CS_FN(merge_y)(BLASLONG len, FLOAT *y, BLASLONG inc,
+                           const CS_FN(split_tile) *t) {
+    FLOAT tmp[2 * VL];
+
+    for (BLASLONG i = 0; i < len; i += VL) {
+        FLOAT *p = inc == 1 ? y + 2 * i : tmp;
+        V_MERGE(p, V_LOAD(t->yr + i), V_LOAD(t->yi + i));
+        if (inc != 1) {
+            for (int k = 0; k < VL; k++) {
+                y[2 * (i + k) * inc]     = tmp[2 * k];
+                y[2 * (i + k) * inc + 1] = tmp[2 * k + 1];
+            }
+        }
+    }
+}
+
+/* alpha * x2(j) as the four broadcasts of the y1 update. */
+#define CS_COEF(j, tr, ti, tu, tv) do {                                    \
+        const FLOAT *xj_ = x2 + 2 * (j) * incx2;                           \
+        FLOAT r_ = alpha[0] * xj_[0] - alpha[1] * xj_[1];                  \
+        FLOAT i_ = alpha[0] * xj_[1] + alpha[1] * xj_[0];                  \
+        tr = V_SET1(r_);                                                   \
+        ti = V_SET1(i_);                                                   \
+        tu = V_SET1(-s1 * i_);                                             \
+        tv = V_SET1(s1 * r_);                                              \
+    } while (0)
+
+/* y2(j) += alpha * (accr + i*acci). */
+#define CS_ADD_Y2(j, accr, acci) do {                                      \
+        FLOAT *yj_ = y2 + 2 * (j) * incy2;                                 \
+        FLOAT r_ = (accr), i_ = (acci);                                    \
+        yj_[0] += alpha[0] * r_ - alpha[1] * i_;                           \
+        yj_[1] += alpha[0] * i_ + alpha[1] * r_;                           \
+    } while (0)
+
+/* y1 tile += alpha * op1(A) * x2, four columns per sweep of the tile. */
+static void CS_FN(tile_n)(BLASLONG len, BLASLONG n, const FLOAT *alpha,
+                          const FLOAT *a, BLASLONG lda, const FLOAT *x2,
+                          BLASLONG incx2, FLOAT s1, CS_FN(split_tile) *t) {
+    BLASLONG j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        const FLOAT *a0 = a + 2 * j * lda, *a1 = a0 + 2 * lda;
+        const FLOAT *a2 = a1 + 2 * lda, *a3 = a2 + 2 * lda;
+        VEC tr0, ti0, tu0, tv0, tr1, ti1, tu1, tv1;
+        VEC tr2, ti2, tu2, tv2, tr3, ti3, tu3, tv3;
+
+        CS_COEF(j, tr0, ti0, tu0, tv0);
+        CS_COEF(j + 1, tr1, ti1, tu1, tv1);
+        CS_COEF(j + 2, tr2, ti2, tu2, tv2);
+        CS_COEF(j + 3, tr3, ti3, tu3, tv3);
+        for (BLASLONG i = 0; i < len; i += VL) {
+            VEC yr = V_LOAD(t->yr + i), yi = V_LOAD(t->yi + i);
+            VEC ar, ai;
+            V_SPLIT(a0 + 2 * i, ar, ai);
+            yr = V_FMA(ar, tr0, yr); yi = V_FMA(ar, ti0, yi);
+            yr = V_FMA(ai, tu0, yr); yi = V_FMA(ai, tv0, yi);
+            V_SPLIT(a1 + 2 * i, ar, ai);
+            yr = V_FMA(ar, tr1, yr); yi = V_FMA(ar, ti1, yi);
+            yr = V_FMA(ai, tu1, yr); yi = V_FMA(ai, tv1, yi);
+            V_SPLIT(a2 + 2 * i, ar, ai);
+            yr = V_FMA(ar, tr2, yr); yi = V_FMA(ar, ti2, yi);
+            yr = V_FMA(ai, tu2, yr); yi = V_FMA(ai, tv2, yi);
+            V_SPLIT(a3 + 2 * i, ar, ai);
+            yr = V_FMA(ar, tr3, yr); yi = V_FMA(ar, ti3, yi);
+            yr = V_FMA(ai, tu3, yr); yi = V_FMA(ai, tv3, yi);
+            V_STORE(t->yr + i, yr);
+            V_STORE(t->yi + i, yi);
+        }
+    }
+    for (; j < n; j++) {
+        const FLOAT *a0 = a + 2 * j * lda;
+        VEC tr0, ti0, tu0, tv0;
+
+        CS_COEF(j, tr0, ti0, tu0, tv0);
+        for (BLASLONG i = 0; i < len; i += VL) {
+            VEC yr = V_LOAD(t->yr + i), yi = V_LOAD(t->yi + i);
+            VEC ar, ai;
+            V_SPLIT(a0 + 2 * i, ar, ai);
+            yr = V_FMA(ar, tr0, yr);
+            yi = V_FMA(ar, ti0, yi);
+            yr = V_FMA(ai, tu0, yr);
+            yi = V_FMA(ai, tv0, yi);
+            V_STORE(t->yr + i, yr);
+            V_STORE(t->yi + i, yi);
+        }
+    }
+}
+
+/*
+ * y2 += alpha * op2(A)^T * x1 tile, four columns per sweep.  A dot product
+ * needs no split: A times xp sums to the real part and A times xq to the
+ * imaginary part, lane by lane on the interleaved data, so each column is
+ * two FMAs per vector and no shuffle.  Two steps per iteration, each with
+ * its own accumulators, keep sixteen FMAs independent.
+ */
+static void CS_FN(tile_t)(BLASLONG len, BLASLONG n, const FLOAT *alpha,
+                          const FLOAT *a, BLASLONG lda,
+                          const CS_FN(split_tile) *t, FLOAT *y2,
+                          BLASLONG incy2) {
+    BLASLONG j = 0, len2 = 2 * len;
+
+    for (; j + 4 <= n; j += 4) {
+        const FLOAT *a0 = a + 2 * j * lda, *a1 = a0 + 2 * lda;
+        const FLOAT *a2 = a1 + 2 * lda, *a3 = a2 + 2 * lda;
+        VEC p0 = V_ZERO(), q0 = V_ZERO(), r0 = V_ZERO(), u0 = V_ZERO();
+        VEC p1 = V_ZERO(), q1 = V_ZERO(), r1 = V_ZERO(), u1 = V_ZERO();
+        VEC p2 = V_ZERO(), q2 = V_ZERO(), r2 = V_ZERO(), u2 = V_ZERO();
+        VEC p3 = V_ZERO(), q3 = V_ZERO(), r3 = V_ZERO(), u3 = V_ZERO();
+
+        for (BLASLONG i = 0; i < len2; i += 2 * VL) {
+            VEC xp = V_LOAD(t->xp + i), xq = V_LOAD(t->xq + i);
+            VEC xp_ = V_LOAD(t->xp + i + VL), xq_ = V_LOAD(t->xq + i + VL);
+            VEC av;
+            av = V_LOAD(a0 + i); p0 = V_FMA(av, xp, p0); q0 = V_FMA(av, xq, q0);
+            av = V_LOAD(a1 + i); p1 = V_FMA(av, xp, p1); q1 = V_FMA(av, xq, q1);
+            av = V_LOAD(a2 + i); p2 = V_FMA(av, xp, p2); q2 = V_FMA(av, xq, q2);
+            av = V_LOAD(a3 + i); p3 = V_FMA(av, xp, p3); q3 = V_FMA(av, xq, q3);
+            av = V_LOAD(a0 + i + VL);
+            r0 = V_FMA(av, xp_, r0); u0 = V_FMA(av, xq_, u0);
+            av = V_LOAD(a1 + i + VL);
+            r1 = V_FMA(av, xp_, r1); u1 = V_FMA(av, xq_, u1);
+            av = V_LOAD(a2 + i + VL);
+            r2 = V_FMA(av, xp_, r2); u2 = V_FMA(av, xq_, u2);
+            av = V_LOAD(a3 + i + VL);
+            r3 = V_FMA(av, xp_, r3); u3 = V_FMA(av, xq_, u3);
+        }
+        FLOAT s0[2], s1[2], s2[2], s3[2];
+
+        V_CSUM(V_ADD(p0, r0), V_ADD(q0, u0), s0);
+        V_CSUM(V_ADD(p1, r1), V_ADD(q1, u1), s1);
+        V_CSUM(V_ADD(p2, r2), V_ADD(q2, u2), s2);
+        V_CSUM(V_ADD(p3, r3), V_ADD(q3, u3), s3);
+        CS_ADD_Y2(j, s0[0], s0[1]);
+        CS_ADD_Y2(j + 1, s1[0], s1[1]);
+        CS_ADD_Y2(j + 2, s2[0], s2[1]);
+        CS_ADD_Y2(j + 3, s3[0], s3[1]);
+    }
+    for (; j < n; j++) {
+        const FLOAT *a0 = a + 2 * j * lda;
+        VEC p0 = V_ZERO(), q0 = V_ZERO();
+        FLOAT s0[2];
+
+        for (BLASLONG i = 0; i < len2; i += VL) {
+            VEC av = V_LOAD(a0 + i);
+            p0 = V_FMA(av, V_LOAD(t->xp + i), p0);
+            q0 = V_FMA(av, V_LOAD(t->xq + i), q0);
+        }
+        V_CSUM(p0, q0, s0);
+        CS_ADD_Y2(j, s0[0], s0[1]);
+    }
+}
+
+/* Both directions: every split column of A feeds the y1 update and the y2
+ * dot product.  Two columns per sweep halve the y1 and x1 traffic through
+ * the tile, which lies in L2 rather than L1. */
+static void CS_FN(tile_nt)(BLASLONG len, BLASLONG n, const FLOAT *alpha,
+                           const FLOAT *a, BLASLONG lda, const FLOAT *x2,
+                           BLASLONG incx2, FLOAT *y2, BLASLONG incy2,
+                           FLOAT s1, CS_FN(split_tile) *t) {
+    BLASLONG j = 0;
+
+    for (; j + 2 <= n; j += 2) {
+        const FLOAT *a0 = a + 2 * j * lda, *a1 = a0 + 2 * lda;
+        VEC tr0, ti0, tu0, tv0, tr1, ti1, tu1, tv1;
+        VEC p0 = V_ZERO(), q0 = V_ZERO(), r0 = V_ZERO(), u0 = V_ZERO();
+        VEC p1 = V_ZERO(), q1 = V_ZERO(), r1 = V_ZERO(), u1 = V_ZERO();
+
+        CS_COEF(j, tr0, ti0, tu0, tv0);
+        CS_COEF(j + 1, tr1, ti1, tu1, tv1);
+        for (BLASLONG i = 0; i < len; i += VL) {
+            VEC yr = V_LOAD(t->yr + i), yi = V_LOAD(t->yi + i);
+            VEC xr = V_LOAD(t->xr + i), xs = V_LOAD(t->xs + i);
+            VEC xi = V_LOAD(t->xi + i), xc = V_LOAD(t->xc + i);
+            VEC ar, ai;
+            V_SPLIT(a0 + 2 * i, ar, ai);
+            yr = V_FMA(ar, tr0, yr); yi = V_FMA(ar, ti0, yi);
+            yr = V_FMA(ai, tu0, yr); yi = V_FMA(ai, tv0, yi);
+            p0 = V_FMA(ar, xr, p0); q0 = V_FMA(ai, xs, q0);
+            r0 = V_FMA(ar, xi, r0); u0 = V_FMA(ai, xc, u0);
+            V_SPLIT(a1 + 2 * i, ar, ai);
+            yr = V_FMA(ar, tr1, yr); yi = V_FMA(ar, ti1, yi);
+            yr = V_FMA(ai, tu1, yr); yi = V_FMA(ai, tv1, yi);
+            p1 = V_FMA(ar, xr, p1); q1 = V_FMA(ai, xs, q1);
+            r1 = V_FMA(ar, xi, r1); u1 = V_FMA(ai, xc, u1);
+            V_STORE(t->yr + i, yr);
+            V_STORE(t->yi + i, yi);
+        }
+        FLOAT s0[2], s1_[2];
+
+        V_CSUM(V_ADD(p0, q0), V_ADD(r0, u0), s0);
+        V_CSUM(V_ADD(p1, q1), V_ADD(r1, u1), s1_);
+        CS_ADD_Y2(j, s0[0], s0[1]);
+        CS_ADD_Y2(j + 1, s1_[0], s1_[1]);
+    }
+    for (; j < n; j++) {
+        const FLOAT *a0 = a + 2 * j * lda;
+        VEC tr0, ti0, tu0, tv0;
+        VEC p0 = V_ZERO(), q0 = V_ZERO(), r0 = V_ZERO(), u0 = V_ZERO();
+
+        CS_COEF(j, tr0, ti0, tu0, tv0);
+        for (BLASLONG i = 0; i < len; i += VL) {
+            VEC yr = V_LOAD(t->yr + i), yi = V_LOAD(t->yi + i);
+            VEC ar, ai;
+            V_SPLIT(a0 + 2 * i, ar, ai);
+            yr = V_FMA(ar, tr0, yr);
+            yi = V_FMA(ar, ti0, yi);
+            yr = V_FMA(ai, tu0, yr);
+            yi = V_FMA(ai, tv0, yi);
+            p0 = V_FMA(ar, V_LOAD(t->xr + i), p0);
+            q0 = V_FMA(ai, V_LOAD(t->xs + i), q0);
+            r0 = V_FMA(ar, V_LOAD(t->xi + i), r0);
+            u0 = V_FMA(ai, V_LOAD(t->xc + i), u0);
+            V_STORE(t->yr + i, yr);
+            V_STORE(t->yi + i, yi);
+        }
+        CS_ADD_Y2(j, V_HSUM(p0) + V_HSUM(q0), V_HSUM(r0) + V_HSUM(u0));
+    }
+}
+
+/* Rows [0, len) of the same panel in scalar code, interleaved throughout. */
+static void CS_FN(rows_scalar)(BLASLONG len, BLASLONG n, const FLOAT *alpha,
+                               const FLOAT *a, BLASLONG lda,
+                               const FLOAT *x1, BLASLONG incx1,
+                               FLOAT *y1, BLASLONG incy1,
+                               const FLOAT *x2, BLASLONG incx2,
+                               FLOAT *y2, BLASLONG incy2,
+                               FLOAT s1, FLOAT s2) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const FLOAT *col = a + 2 * j * lda;
+        FLOAT tr = 0, ti = 0, sr = 0, si = 0;
+
+        if (y1) {
+            const FLOAT *xj = x2 + 2 * j * incx2;
+            tr = alpha[0] * xj[0] - alpha[1] * xj[1];
+            ti = alpha[0] * xj[1] + alpha[1] * xj[0];
+        }
+        for (BLASLONG i = 0; i < len; i++) {
+            FLOAT ar = col[2 * i], ai = col[2 * i + 1];
+            if (y1) {
+                FLOAT *yi = y1 + 2 * i * incy1;
+                yi[0] += ar * tr - s1 * ai * ti;
+                yi[1] += ar * ti + s1 * ai * tr;
+            }
+            if (y2) {
+                const FLOAT *xi = x1 + 2 * i * incx1;
+                sr += ar * xi[0] - s2 * ai * xi[1];
+                si += ar * xi[1] + s2 * ai * xi[0];
+            }
+        }
+        if (y2) CS_ADD_Y2(j, sr, si);
+    }
+}
+
+void CS_KERNEL(BLASLONG m, BLASLONG n, const FLOAT *alpha, const FLOAT *a,
+               BLASLONG lda, const FLOAT *x1, BLASLONG incx1,
+               FLOAT *y1, BLASLONG incy1, const FLOAT *x2, BLASLONG incx2,
+               FLOAT *y2, BLASLONG incy2, int conj1, int conj2) {
+    CS_FN(split_tile) t __attribute__((aligned(64)));
+    FLOAT s1 = conj1 ? -1 : 1, s2 = conj2 ? -1 : 1;
+    BLASLONG mv = m - m % VL;
+
+    if (n <= 0) return;
+    for (BLASLONG i0 = 0; i0 < mv; i0 += CS_MB) {
+        BLASLONG len = L2_MIN(CS_MB, mv - i0);
+        const FLOAT *ta = a + 2 * i0;
+
+        if (y2 && y1)
+            CS_FN(split_x)(len, x1 + 2 * i0 * incx1, incx1, s2, &t);
+        else if (y2)
+            CS_FN(pair_x)(len, x1 + 2 * i0 * incx1, incx1, s2, &t);
+        if (y1) CS_FN(split_y)(len, y1 + 2 * i0 * incy1, incy1, &t);
+        if (y1 && y2)
+            CS_FN(tile_nt)(len, n, alpha, ta, lda, x2, incx2, y2, incy2,
+                           s1, &t);
+        else if (y1)
+            CS_FN(tile_n)(len, n, alpha, ta, lda, x2, incx2, s1, &t);
+        else
+            CS_FN(tile_t)(len, n, alpha, ta, lda, &t, y2, incy2);
+        if (y1) CS_FN(merge_y)(len, y1 + 2 * i0 * incy1, incy1, &t);
+    }
+    if (mv < m)
+        CS_FN(rows_scalar)(m - mv, n, alpha, a + 2 * mv, lda,
+                           x1 ? x1 + 2 * mv * incx1 : NULL, incx1,
+                           y1 ? y1 + 2 * mv * incy1 : NULL, incy1,
+                           x2, incx2, y2, incy2, s1, s2);
+}
+
+#undef CS_COEF
+#undef CS_ADD_Y2
+#undef CS_MB
+#undef CS_KERNEL
@@ -0,0 +1,120 @@
+/*
+ * Single-element and column-segment helpers shared by the packed and banded
+ * templates (packed_template.h, band_template.h), included once per
+ * precision with
+ *   FLOAT     element type (float or double)
+ *   CS        reals per element (1 real, 2 complex)
+ *   PREC      name prefix (s, d, c, z)
+ *   AXPY_A(m, s, a, y, incy, conj)    y += s * op(a), a unit-stride
+ *   DOT_A(m, a, x, incx, acc, conj)   acc += op(a)^T * x, a unit-stride
+ * defined, and for real data optionally
+ *   SYMV_PANEL(m, alpha, a, x1, y1, x2, y2)   fused symv column, unit stride
+ * op() conjugates when conj is set; s and acc point at one element.
+ *
+ * Packed and band columns are both contiguous runs of A, so each helper
+ * hands a whole column segment to one gemv (or symv panel) kernel call.
+ */
+
+#define COL_CAT_(a, b) a##b
+#define COL_CAT(a, b) COL_CAT_(a, b)
+#define COL_FN(name) COL_CAT(PREC, name)
+
+#ifndef COL_IS_ZERO
+#define COL_IS_ZERO(p) ((p)[0] == 0 && (CS == 1 || (p)[CS - 1] == 0))
+#define COL_IS_ONE(p)  ((p)[0] == 1 && (CS == 1 || (p)[CS - 1] == 0))
+#endif
+
+/* r = a * op(b) on single elements; r may alias a or b. */
+static inline void COL_FN(col_mul)(FLOAT *r, const FLOAT *a, const FLOAT *b,
+                                 int conjb) {
+#if CS == 1
+    (void)conjb;
+    r[0] = a[0] * b[0];
+#else
+    FLOAT br = b[0], bi = conjb ? -b[1] : b[1];
+    FLOAT t = a[0] * br - a[1] * bi;
+    r[1] = a[0] * bi + a[1] * br;
+    r[0] = t;
+#endif
+}
+
+/* x /= op(a); complex reciprocal scaled as in the reference BLAS. */
+static inline void COL_FN(col_div)(FLOAT *x, const FLOAT *a, int conj) {
+#if CS == 1
+    (void)conj;
+    x[0] /= a[0];
+#else
+    FLOAT ar = a[0], ai = conj ? -a[1] : a[1], rr, ri, t;
+    if ((ar < 0 ? -ar : ar) >= (ai < 0 ? -ai : ai)) {
+        FLOAT ratio = ai / ar, den = (FLOAT)1 / (ar * (1 + ratio * ratio));
+        rr = den;
+        ri = -ratio * den;
+    } else {
+        FLOAT ratio = ar / ai, den = (FLOAT)1 / (ai * (1 + ratio * ratio));
+        rr = ratio * den;
+        ri = -den;
+    }
+    t = rr * x[0] - ri * x[1];
+    x[1] = rr * x[1] + ri * x[0];
+    x[0] = t;
+#endif
+}
+
+/* y += s * op(v) over m elements, any increments. */
+static void COL_FN(col_axpy)(BLASLONG m, const FLOAT *s, const FLOAT *v,
+                           BLASLONG incv, FLOAT *y, BLASLONG incy, int conj) {
+    if (m <= 0) return;
+    if (incv == 1) {
+        AXPY_A(m, s, v, y, incy, conj);
+        return;
+    }
+    for (BLASLONG i = 0; i < m; i++) {
+        const FLOAT *vi = v + i * incv * CS;
+        FLOAT *yi = y + i * incy * CS;
+#if CS == 1
+        (void)conj;
+        yi[0] += s[0] * vi[0];
+#else
+        FLOAT vr = vi[0], vm = conj ? -vi[1] : vi[1];
+        yi[0] += s[0] * vr - s[1] * vm;
+        yi[1] += s[0] * vm + s[1] * vr;
+#endif
+    }
+}
+
+/* acc += op(a)^T * x over m elements of a unit-stride column segment. */
+static void COL_FN(col_dot)(BLASLONG m, const FLOAT *a, const FLOAT *x,
+                          BLASLONG incx, FLOAT *acc, int conj) {
+    (void)conj;
+    if (m > 0) DOT_A(m, a, x, incx, acc, conj);
+}
+
+/*
+ * One column of the symmetric/Hermitian product: the m stored off-diagonal
+ * entries a update y1 += alpha * op(a) * x2[0] and y2[0] += alpha *
+ * op'(a)^T * x1, where op' is the conjugate of op for Hermitian data.
+ */
+static void COL_FN(col_symv)(BLASLONG m, const FLOAT *alpha, const FLOAT *a,
+                             const FLOAT *x1, BLASLONG incx, FLOAT *y1,
+                             BLASLONG incy, const FLOAT *x2, FLOAT *y2,
+                             int cj) {
+    FLOAT t[CS], acc[CS];
+
+    if (m <= 0) return;
+#ifdef SYMV_PANEL
+    if (incx == 1 && incy == 1) {
+        SYMV_PANEL(m, alpha[0], a, x1, y1, x2, y2);
+        return;
+    }
+#endif
+    for (int k = 0; k < CS; k++) acc[k] = 0;
+    COL_FN(col_mul)(t, alpha, x2, 0);
+    COL_FN(col_axpy)(m, t, a, 1, y1, incy, cj);
+    COL_FN(col_dot)(m, a, x1, incx, acc, CS == 2 && !cj);
+    COL_FN(col_mul)(acc, alpha, acc, 0);
+    for (int k = 0; k < CS; k++) y2[k] += acc[k];
+}
+
+#undef COL_FN
+#undef COL_CAT
+#undef COL_CAT_
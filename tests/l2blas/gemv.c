@@ -0,0 +1,164 @@
+#include <stddef.h>
+#include "l2blas_internal.h"
+
+/* ---- portable kernels (any increments) ---------------------------------- */
+
+void l2_sgemv_n_generic(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                        BLASLONG lda, const float *x, BLASLONG incx,
+                        float *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const float *col = a + j * lda;
+        float t = alpha * x[j * incx];
+        for (BLASLONG i = 0; i < m; i++)
+            y[i * incy] += t * col[i];
+    }
+}
+
+void l2_sgemv_t_generic(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                        BLASLONG lda, const float *x, BLASLONG incx,
+                        float *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const float *col = a + j * lda;
+        float s = 0.0f;
+        for (BLASLONG i = 0; i < m; i++)
+            s += col[i] * x[i * incx];
+        y[j * incy] += alpha * s;
+    }
+}
+
+void l2_dgemv_n_generic(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                        BLASLONG lda, const double *x, BLASLONG incx,
+                        double *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const double *col = a + j * lda;
+        double t = alpha * x[j * incx];
+        for (BLASLONG i = 0; i < m; i++)
+            y[i * incy] += t * col[i];
+    }
+}
+
+void l2_dgemv_t_generic(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                        BLASLONG lda, const double *x, BLASLONG incx,
+                        double *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const double *col = a + j * lda;
+        double s = 0.0;
+        for (BLASLONG i = 0; i < m; i++)
+            s += col[i] * x[i * incx];
+        y[j * incy] += alpha * s;
+    }
+}
+
+/* ---- dispatch ------------------------------------------------------------ */
+
+l2_sgemv_kernel l2_sgemv_pick(int notrans, BLASLONG incx, BLASLONG incy) {
+    /* SIMD kernels stream y ("n") or x ("t") with vector loads. */
+    switch ((notrans ? incy : incx) == 1 ? l2_core() : L2_CORE_GENERIC) {
+    case L2_CORE_AVX512: return notrans ? l2_sgemv_n_avx512 : l2_sgemv_t_avx512;
+    case L2_CORE_AVX2:   return notrans ? l2_sgemv_n_avx2   : l2_sgemv_t_avx2;
+    default:             return notrans ? l2_sgemv_n_generic : l2_sgemv_t_generic;
+    }
+}
+
+l2_dgemv_kernel l2_dgemv_pick(int notrans, BLASLONG incx, BLASLONG incy) {
+    switch ((notrans ? incy : incx) == 1 ? l2_core() : L2_CORE_GENERIC) {
+    case L2_CORE_AVX512: return notrans ? l2_dgemv_n_avx512 : l2_dgemv_t_avx512;
+    case L2_CORE_AVX2:   return notrans ? l2_dgemv_n_avx2   : l2_dgemv_t_avx2;
+    default:             return notrans ? l2_dgemv_n_generic : l2_dgemv_t_generic;
+    }
+}
+
+int l2_gemv_check(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                  blasint m, blasint n, blasint lda,
+                  blasint incx, blasint incy) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (trans != CblasNoTrans && trans != CblasTrans &&
+        trans != CblasConjTrans && trans != CblasConjNoTrans) return 2;
+    if (m < 0) return 3;
+    if (n < 0) return 4;
+    if (lda < L2_MAX(1, order == CblasColMajor ? m : n)) return 7;
+    if (incx == 0) return 9;
+    if (incy == 0) return 12;
+    return 0;
+}
+
+void l2_sgemv_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      BLASLONG m, BLASLONG n, float alpha,
+                      const float *a, BLASLONG lda, const float *x,
+                      BLASLONG incx, float beta, float *y, BLASLONG incy) {
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    BLASLONG lenx, leny, rows, cols;
+    int notrans;
+
+    if (m == 0 || n == 0 || (alpha == 0.0f && beta == 1.0f)) return;
+
+    lenx = plain ? n : m;
+    leny = plain ? m : n;
+    x = L2_VEC_BASE(x, lenx, incx);
+    y = L2_VEC_BASE(y, leny, incy);
+
+    if (beta != 1.0f) {
+        for (BLASLONG i = 0; i < leny; i++)
+            y[i * incy] = beta == 0.0f ? 0.0f : beta * y[i * incy];
+    }
+    if (alpha == 0.0f) return;
+
+    /* A RowMajor matrix is its own transpose stored ColMajor. */
+    rows = order == CblasColMajor ? m : n;
+    cols = order == CblasColMajor ? n : m;
+    notrans = plain == (order == CblasColMajor);
+
+    l2_sgemv_pick(notrans, incx, incy)(rows, cols, alpha, a, lda,
+                                       x, incx, y, incy);
+}
+
+void l2_dgemv_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      BLASLONG m, BLASLONG n, double alpha,
+                      const double *a, BLASLONG lda, const double *x,
+                      BLASLONG incx, double beta, double *y, BLASLONG incy) {
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    BLASLONG lenx, leny, rows, cols;
+    int notrans;
+
+    if (m == 0 || n == 0 || (alpha == 0.0 && beta == 1.0)) return;
+
+    lenx = plain ? n : m;
+    leny = plain ? m : n;
+    x = L2_VEC_BASE(x, lenx, incx);
+    y = L2_VEC_BASE(y, leny, incy);
+
+    if (beta != 1.0) {
+        for (BLASLONG i = 0; i < leny; i++)
+            y[i * incy] = beta == 0.0 ? 0.0 : beta * y[i * incy];
+    }
+    if (alpha == 0.0) return;
+
+    rows = order == CblasColMajor ? m : n;
+    cols = order == CblasColMajor ? n : m;
+    notrans = plain == (order == CblasColMajor);
+
+    l2_dgemv_pick(notrans, incx, incy)(rows, cols, alpha, a, lda,
+                                       x, incx, y, incy);
+}
+
+void l2_sgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const float alpha,
+              const float *a, const blasint lda, const float *x,
+              const blasint incx, const float beta, float *y,
+              const blasint incy) {
+    int info = l2_gemv_check(order, trans, m, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_sgemv", info); return; }
+    l2_sgemv_compute(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+void l2_dgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const double alpha,
+              const double *a, const blasint lda, const double *x,
+              const blasint incx, const double beta, double *y,
+              const blasint incy) {
+    int info = l2_gemv_check(order, trans, m, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_dgemv", info); return; }
+    l2_dgemv_compute(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
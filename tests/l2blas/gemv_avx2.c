@@ -0,0 +1,244 @@
+/*
+ * AVX2/FMA gemv kernels.  Built with -mavx2 -mfma; only called when
+ * l2_core() reports at least L2_CORE_AVX2.
+ *
+ * "n": four columns of A are combined per sweep so each load/store of y is
+ * amortised over four FMAs.  "t": four columns are dotted with x at once,
+ * two vectors deep, giving eight independent FMA chains.
+ */
+#include "l2blas_internal.h"
+#include "l2blas_avx2.h"
+
+void l2_sgemv_n_avx2(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                     BLASLONG lda, const float *x, BLASLONG incx,
+                     float *y, BLASLONG incy) {
+    BLASLONG j = 0;
+    (void)incy;
+
+    for (; j + 4 <= n; j += 4) {
+        const float *a0 = a + j * lda, *a1 = a0 + lda;
+        const float *a2 = a1 + lda,    *a3 = a2 + lda;
+        float t0 = alpha * x[(j + 0) * incx], t1 = alpha * x[(j + 1) * incx];
+        float t2 = alpha * x[(j + 2) * incx], t3 = alpha * x[(j + 3) * incx];
+        __m256 b0 = _mm256_set1_ps(t0), b1 = _mm256_set1_ps(t1);
+        __m256 b2 = _mm256_set1_ps(t2), b3 = _mm256_set1_ps(t3);
+        BLASLONG i = 0;
+
+        for (; i + 16 <= m; i += 16) {
+            __m256 y0 = _mm256_loadu_ps(y + i), y1 = _mm256_loadu_ps(y + i + 8);
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + i),     b0, y0);
+            y1 = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + i + 8), b0, y1);
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + i),     b1, y0);
+            y1 = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + i + 8), b1, y1);
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(a2 + i),     b2, y0);
+            y1 = _mm256_fmadd_ps(_mm256_loadu_ps(a2 + i + 8), b2, y1);
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(a3 + i),     b3, y0);
+            y1 = _mm256_fmadd_ps(_mm256_loadu_ps(a3 + i + 8), b3, y1);
+            _mm256_storeu_ps(y + i, y0);
+            _mm256_storeu_ps(y + i + 8, y1);
+        }
+        for (; i + 8 <= m; i += 8) {
+            __m256 y0 = _mm256_loadu_ps(y + i);
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + i), b0, y0);
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + i), b1, y0);
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(a2 + i), b2, y0);
+            y0 = _mm256_fmadd_ps(_mm256_loadu_ps(a3 + i), b3, y0);
+            _mm256_storeu_ps(y + i, y0);
+        }
+        for (; i < m; i++)
+            y[i] += t0 * a0[i] + t1 * a1[i] + t2 * a2[i] + t3 * a3[i];
+    }
+    for (; j < n; j++) {
+        const float *a0 = a + j * lda;
+        float t0 = alpha * x[j * incx];
+        __m256 b0 = _mm256_set1_ps(t0);
+        BLASLONG i = 0;
+
+        for (; i + 8 <= m; i += 8)
+            _mm256_storeu_ps(y + i, _mm256_fmadd_ps(_mm256_loadu_ps(a0 + i), b0,
+                                                    _mm256_loadu_ps(y + i)));
+        for (; i < m; i++)
+            y[i] += t0 * a0[i];
+    }
+}
+
+void l2_sgemv_t_avx2(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                     BLASLONG lda, const float *x, BLASLONG incx,
+                     float *y, BLASLONG incy) {
+    BLASLONG j = 0;
+    (void)incx;
+
+    for (; j + 4 <= n; j += 4) {
+        const float *a0 = a + j * lda, *a1 = a0 + lda;
+        const float *a2 = a1 + lda,    *a3 = a2 + lda;
+        __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+        __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+        __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+        __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+        float s0, s1, s2, s3;
+        BLASLONG i = 0;
+
+        for (; i + 16 <= m; i += 16) {
+            __m256 x0 = _mm256_loadu_ps(x + i), x1 = _mm256_loadu_ps(x + i + 8);
+            c00 = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + i),     x0, c00);
+            c01 = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + i + 8), x1, c01);
+            c10 = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + i),     x0, c10);
+            c11 = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + i + 8), x1, c11);
+            c20 = _mm256_fmadd_ps(_mm256_loadu_ps(a2 + i),     x0, c20);
+            c21 = _mm256_fmadd_ps(_mm256_loadu_ps(a2 + i + 8), x1, c21);
+            c30 = _mm256_fmadd_ps(_mm256_loadu_ps(a3 + i),     x0, c30);
+            c31 = _mm256_fmadd_ps(_mm256_loadu_ps(a3 + i + 8), x1, c31);
+        }
+        for (; i + 8 <= m; i += 8) {
+            __m256 x0 = _mm256_loadu_ps(x + i);
+            c00 = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + i), x0, c00);
+            c10 = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + i), x0, c10);
+            c20 = _mm256_fmadd_ps(_mm256_loadu_ps(a2 + i), x0, c20);
+            c30 = _mm256_fmadd_ps(_mm256_loadu_ps(a3 + i), x0, c30);
+        }
+        s0 = l2_hsum_ps(_mm256_add_ps(c00, c01));
+        s1 = l2_hsum_ps(_mm256_add_ps(c10, c11));
+        s2 = l2_hsum_ps(_mm256_add_ps(c20, c21));
+        s3 = l2_hsum_ps(_mm256_add_ps(c30, c31));
+        for (; i < m; i++) {
+            s0 += a0[i] * x[i];
+            s1 += a1[i] * x[i];
+            s2 += a2[i] * x[i];
+            s3 += a3[i] * x[i];
+        }
+        y[(j + 0) * incy] += alpha * s0;
+        y[(j + 1) * incy] += alpha * s1;
+        y[(j + 2) * incy] += alpha * s2;
+        y[(j + 3) * incy] += alpha * s3;
+    }
+    for (; j < n; j++) {
+        const float *a0 = a + j * lda;
+        __m256 c0 = _mm256_setzero_ps();
+        float s0;
+        BLASLONG i = 0;
+
+        for (; i + 8 <= m; i += 8)
+            c0 = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + i), _mm256_loadu_ps(x + i), c0);
+        s0 = l2_hsum_ps(c0);
+        for (; i < m; i++)
+            s0 += a0[i] * x[i];
+        y[j * incy] += alpha * s0;
+    }
+}
+
+void l2_dgemv_n_avx2(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                     BLASLONG lda, const double *x, BLASLONG incx,
+                     double *y, BLASLONG incy) {
+    BLASLONG j = 0;
+    (void)incy;
+
+    for (; j + 4 <= n; j += 4) {
+        const double *a0 = a + j * lda, *a1 = a0 + lda;
+        const double *a2 = a1 + lda,    *a3 = a2 + lda;
+        double t0 = alpha * x[(j + 0) * incx], t1 = alpha * x[(j + 1) * incx];
+        double t2 = alpha * x[(j + 2) * incx], t3 = alpha * x[(j + 3) * incx];
+        __m256d b0 = _mm256_set1_pd(t0), b1 = _mm256_set1_pd(t1);
+        __m256d b2 = _mm256_set1_pd(t2), b3 = _mm256_set1_pd(t3);
+        BLASLONG i = 0;
+
+        for (; i + 8 <= m; i += 8) {
+            __m256d y0 = _mm256_loadu_pd(y + i), y1 = _mm256_loadu_pd(y + i + 4);
+            y0 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i),     b0, y0);
+            y1 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i + 4), b0, y1);
+            y0 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + i),     b1, y0);
+            y1 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + i + 4), b1, y1);
+            y0 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + i),     b2, y0);
+            y1 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + i + 4), b2, y1);
+            y0 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + i),     b3, y0);
+            y1 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + i + 4), b3, y1);
+            _mm256_storeu_pd(y + i, y0);
+            _mm256_storeu_pd(y + i + 4, y1);
+        }
+        for (; i + 4 <= m; i += 4) {
+            __m256d y0 = _mm256_loadu_pd(y + i);
+            y0 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i), b0, y0);
+            y0 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + i), b1, y0);
+            y0 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + i), b2, y0);
+            y0 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + i), b3, y0);
+            _mm256_storeu_pd(y + i, y0);
+        }
+        for (; i < m; i++)
+            y[i] += t0 * a0[i] + t1 * a1[i] + t2 * a2[i] + t3 * a3[i];
+    }
+    for (; j < n; j++) {
+        const double *a0 = a + j * lda;
+        double t0 = alpha * x[j * incx];
+        __m256d b0 = _mm256_set1_pd(t0);
+        BLASLONG i = 0;
+
+        for (; i + 4 <= m; i += 4)
+            _mm256_storeu_pd(y + i, _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i), b0,
+                                                    _mm256_loadu_pd(y + i)));
+        for (; i < m; i++)
+            y[i] += t0 * a0[i];
+    }
+}
+
+void l2_dgemv_t_avx2(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                     BLASLONG lda, const double *x, BLASLONG incx,
+                     double *y, BLASLONG incy) {
+    BLASLONG j = 0;
+    (void)incx;
+
+    for (; j + 4 <= n; j += 4) {
+        const double *a0 = a + j * lda, *a1 = a0 + lda;
+        const double *a2 = a1 + lda,    *a3 = a2 + lda;
+        __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+        __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+        __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+        __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+        double s0, s1, s2, s3;
+        BLASLONG i = 0;
+
+        for (; i + 8 <= m; i += 8) {
+            __m256d x0 = _mm256_loadu_pd(x + i), x1 = _mm256_loadu_pd(x + i + 4);
+            c00 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i),     x0, c00);
+            c01 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i + 4), x1, c01);
+            c10 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + i),     x0, c10);
+            c11 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + i + 4), x1, c11);
+            c20 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + i),     x0, c20);
+            c21 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + i + 4), x1, c21);
+            c30 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + i),     x0, c30);
+            c31 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + i + 4), x1, c31);
+        }
+        for (; i + 4 <= m; i += 4) {
+            __m256d x0 = _mm256_loadu_pd(x + i);
+            c00 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i), x0, c00);
+            c10 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + i), x0, c10);
+            c20 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + i), x0, c20);
+            c30 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + i), x0, c30);
+        }
+        s0 = l2_hsum_pd(_mm256_add_pd(c00, c01));
+        s1 = l2_hsum_pd(_mm256_add_pd(c10, c11));
+        s2 = l2_hsum_pd(_mm256_add_pd(c20, c21));
+        s3 = l2_hsum_pd(_mm256_add_pd(c30, c31));
+        for (; i < m; i++) {
+            s0 += a0[i] * x[i];
+            s1 += a1[i] * x[i];
+            s2 += a2[i] * x[i];
+            s3 += a3[i] * x[i];
+        }
+        y[(j + 0) * incy] += alpha * s0;
+        y[(j + 1) * incy] += alpha * s1;
+        y[(j + 2) * incy] += alpha * s2;
+        y[(j + 3) * incy] += alpha * s3;
+    }
+    for (; j < n; j++) {
+        const double *a0 = a + j * lda;
+        __m256d c0 = _mm256_setzero_pd();
+        double s0;
+        BLASLONG i = 0;
+
+        for (; i + 4 <= m; i += 4)
+            c0 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + i), _mm256_loadu_pd(x + i), c0);
+        s0 = l2_hsum_pd(c0);
+        for (; i < m; i++)
+            s0 += a0[i] * x[i];
+        y[j * incy] += alpha * s0;
+    }
+}
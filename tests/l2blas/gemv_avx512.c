@@ -0,0 +1,258 @@
+/*
+ * AVX-512F gemv kernels.  Built with -mavx512f; only called when l2_core()
+ * reports L2_CORE_AVX512.
+ *
+ * Same blocking as gemv_avx2.c with 512-bit vectors; row tails use masked
+ * loads/stores instead of a scalar loop.
+ */
+#include <immintrin.h>
+#include "l2blas_internal.h"
+
+static inline __mmask16 tail16(BLASLONG r) { return (__mmask16)((1u << r) - 1u); }
+static inline __mmask8  tail8(BLASLONG r)  { return (__mmask8)((1u << r) - 1u); }
+
+void l2_sgemv_n_avx512(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                       BLASLONG lda, const float *x, BLASLONG incx,
+                       float *y, BLASLONG incy) {
+    BLASLONG j = 0;
+    BLASLONG mv = m & ~(BLASLONG)15;
+    __mmask16 k = tail16(m - mv);
+    (void)incy;
+
+    for (; j + 4 <= n; j += 4) {
+        const float *a0 = a + j * lda, *a1 = a0 + lda;
+        const float *a2 = a1 + lda,    *a3 = a2 + lda;
+        __m512 b0 = _mm512_set1_ps(alpha * x[(j + 0) * incx]);
+        __m512 b1 = _mm512_set1_ps(alpha * x[(j + 1) * incx]);
+        __m512 b2 = _mm512_set1_ps(alpha * x[(j + 2) * incx]);
+        __m512 b3 = _mm512_set1_ps(alpha * x[(j + 3) * incx]);
+        BLASLONG i = 0;
+
+        for (; i + 32 <= m; i += 32) {
+            __m512 y0 = _mm512_loadu_ps(y + i), y1 = _mm512_loadu_ps(y + i + 16);
+            y0 = _mm512_fmadd_ps(_mm512_loadu_ps(a0 + i),      b0, y0);
+            y1 = _mm512_fmadd_ps(_mm512_loadu_ps(a0 + i + 16), b0, y1);
+            y0 = _mm512_fmadd_ps(_mm512_loadu_ps(a1 + i),      b1, y0);
+            y1 = _mm512_fmadd_ps(_mm512_loadu_ps(a1 + i + 16), b1, y1);
+            y0 = _mm512_fmadd_ps(_mm512_loadu_ps(a2 + i),      b2, y0);
+            y1 = _mm512_fmadd_ps(_mm512_loadu_ps(a2 + i + 16), b2, y1);
+            y0 = _mm512_fmadd_ps(_mm512_loadu_ps(a3 + i),      b3, y0);
+            y1 = _mm512_fmadd_ps(_mm512_loadu_ps(a3 + i + 16), b3, y1);
+            _mm512_storeu_ps(y + i, y0);
+            _mm512_storeu_ps(y + i + 16, y1);
+        }
+        for (; i < mv; i += 16) {
+            __m512 y0 = _mm512_loadu_ps(y + i);
+            y0 = _mm512_fmadd_ps(_mm512_loadu_ps(a0 + i), b0, y0);
+            y0 = _mm512_fmadd_ps(_mm512_loadu_ps(a1 + i), b1, y0);
+            y0 = _mm512_fmadd_ps(_mm512_loadu_ps(a2 + i), b2, y0);
+            y0 = _mm512_fmadd_ps(_mm512_loadu_ps(a3 + i), b3, y0);
+            _mm512_storeu_ps(y + i, y0);
+        }
+        if (k) {
+            __m512 y0 = _mm512_maskz_loadu_ps(k, y + i);
+            y0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a0 + i), b0, y0);
+            y0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a1 + i), b1, y0);
+            y0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a2 + i), b2, y0);
+            y0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a3 + i), b3, y0);
+            _mm512_mask_storeu_ps(y + i, k, y0);
+        }
+    }
+    for (; j < n; j++) {
+        const float *a0 = a + j * lda;
+        __m512 b0 = _mm512_set1_ps(alpha * x[j * incx]);
+        BLASLONG i = 0;
+
+        for (; i < mv; i += 16)
+            _mm512_storeu_ps(y + i, _mm512_fmadd_ps(_mm512_loadu_ps(a0 + i), b0,
+                                                    _mm512_loadu_ps(y + i)));
+        if (k)
+            _mm512_mask_storeu_ps(y + i, k,
+                _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a0 + i), b0,
+                                _mm512_maskz_loadu_ps(k, y + i)));
+    }
+}
+
+void l2_sgemv_t_avx512(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                       BLASLONG lda, const float *x, BLASLONG incx,
+                       float *y, BLASLONG incy) {
+    BLASLONG j = 0;
+    BLASLONG mv = m & ~(BLASLONG)15;
+    __mmask16 k = tail16(m - mv);
+    (void)incx;
+
+    for (; j + 4 <= n; j += 4) {
+        const float *a0 = a + j * lda, *a1 = a0 + lda;
+        const float *a2 = a1 + lda,    *a3 = a2 + lda;
+        __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+        __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+        __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+        __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+        BLASLONG i = 0;
+
+        for (; i + 32 <= m; i += 32) {
+            __m512 x0 = _mm512_loadu_ps(x + i), x1 = _mm512_loadu_ps(x + i + 16);
+            c00 = _mm512_fmadd_ps(_mm512_loadu_ps(a0 + i),      x0, c00);
+            c01 = _mm512_fmadd_ps(_mm512_loadu_ps(a0 + i + 16), x1, c01);
+            c10 = _mm512_fmadd_ps(_mm512_loadu_ps(a1 + i),      x0, c10);
+            c11 = _mm512_fmadd_ps(_mm512_loadu_ps(a1 + i + 16), x1, c11);
+            c20 = _mm512_fmadd_ps(_mm512_loadu_ps(a2 + i),      x0, c20);
+            c21 = _mm512_fmadd_ps(_mm512_loadu_ps(a2 + i + 16), x1, c21);
+            c30 = _mm512_fmadd_ps(_mm512_loadu_ps(a3 + i),      x0, c30);
+            c31 = _mm512_fmadd_ps(_mm512_loadu_ps(a3 + i + 16), x1, c31);
+        }
+        for (; i < mv; i += 16) {
+            __m512 x0 = _mm512_loadu_ps(x + i);
+            c00 = _mm512_fmadd_ps(_mm512_loadu_ps(a0 + i), x0, c00);
+            c10 = _mm512_fmadd_ps(_mm512_loadu_ps(a1 + i), x0, c10);
+            c20 = _mm512_fmadd_ps(_mm512_loadu_ps(a2 + i), x0, c20);
+            c30 = _mm512_fmadd_ps(_mm512_loadu_ps(a3 + i), x0, c30);
+        }
+        if (k) {
+            __m512 x0 = _mm512_maskz_loadu_ps(k, x + i);
+            c01 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a0 + i), x0, c01);
+            c11 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a1 + i), x0, c11);
+            c21 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a2 + i), x0, c21);
+            c31 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a3 + i), x0, c31);
+        }
+        y[(j + 0) * incy] += alpha * _mm512_reduce_add_ps(_mm512_add_ps(c00, c01));
+        y[(j + 1) * incy] += alpha * _mm512_reduce_add_ps(_mm512_add_ps(c10, c11));
+        y[(j + 2) * incy] += alpha * _mm512_reduce_add_ps(_mm512_add_ps(c20, c21));
+        y[(j + 3) * incy] += alpha * _mm512_reduce_add_ps(_mm512_add_ps(c30, c31));
+    }
+    for (; j < n; j++) {
+        const float *a0 = a + j * lda;
+        __m512 c0 = _mm512_setzero_ps();
+        BLASLONG i = 0;
+
+        for (; i < mv; i += 16)
+            c0 = _mm512_fmadd_ps(_mm512_loadu_ps(a0 + i), _mm512_loadu_ps(x + i), c0);
+        if (k)
+            c0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(k, a0 + i),
+                                 _mm512_maskz_loadu_ps(k, x + i), c0);
+        y[j * incy] += alpha * _mm512_reduce_add_ps(c0);
+    }
+}
+
+void l2_dgemv_n_avx512(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                       BLASLONG lda, const double *x, BLASLONG incx,
+                       double *y, BLASLONG incy) {
+    BLASLONG j = 0;
+    BLASLONG mv = m & ~(BLASLONG)7;
+    __mmask8 k = tail8(m - mv);
+    (void)incy;
+
+    for (; j + 4 <= n; j += 4) {
+        const double *a0 = a + j * lda, *a1 = a0 + lda;
+        const double *a2 = a1 + lda,    *a3 = a2 + lda;
+        __m512d b0 = _mm512_set1_pd(alpha * x[(j + 0) * incx]);
+        __m512d b1 = _mm512_set1_pd(alpha * x[(j + 1) * incx]);
+        __m512d b2 = _mm512_set1_pd(alpha * x[(j + 2) * incx]);
+        __m512d b3 = _mm512_set1_pd(alpha * x[(j + 3) * incx]);
+        BLASLONG i = 0;
+
+        for (; i + 16 <= m; i += 16) {
+            __m512d y0 = _mm512_loadu_pd(y + i), y1 = _mm512_loadu_pd(y + i + 8);
+            y0 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i),     b0, y0);
+            y1 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i + 8), b0, y1);
+            y0 = _mm512_fmadd_pd(_mm512_loadu_pd(a1 + i),     b1, y0);
+            y1 = _mm512_fmadd_pd(_mm512_loadu_pd(a1 + i + 8), b1, y1);
+            y0 = _mm512_fmadd_pd(_mm512_loadu_pd(a2 + i),     b2, y0);
+            y1 = _mm512_fmadd_pd(_mm512_loadu_pd(a2 + i + 8), b2, y1);
+            y0 = _mm512_fmadd_pd(_mm512_loadu_pd(a3 + i),     b3, y0);
+            y1 = _mm512_fmadd_pd(_mm512_loadu_pd(a3 + i + 8), b3, y1);
+            _mm512_storeu_pd(y + i, y0);
+            _mm512_storeu_pd(y + i + 8, y1);
+        }
+        for (; i < mv; i += 8) {
+            __m512d y0 = _mm512_loadu_pd(y + i);
+            y0 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i), b0, y0);
+            y0 = _mm512_fmadd_pd(_mm512_loadu_pd(a1 + i), b1, y0);
+            y0 = _mm512_fmadd_pd(_mm512_loadu_pd(a2 + i), b2, y0);
+            y0 = _mm512_fmadd_pd(_mm512_loadu_pd(a3 + i), b3, y0);
+            _mm512_storeu_pd(y + i, y0);
+        }
+        if (k) {
+            __m512d y0 = _mm512_maskz_loadu_pd(k, y + i);
+            y0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a0 + i), b0, y0);
+            y0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a1 + i), b1, y0);
+            y0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a2 + i), b2, y0);
+            y0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a3 + i), b3, y0);
+            _mm512_mask_storeu_pd(y + i, k, y0);
+        }
+    }
+    for (; j < n; j++) {
+        const double *a0 = a + j * lda;
+        __m512d b0 = _mm512_set1_pd(alpha * x[j * incx]);
+        BLASLONG i = 0;
+
+        for (; i < mv; i += 8)
+            _mm512_storeu_pd(y + i, _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i), b0,
+                                                    _mm512_loadu_pd(y + i)));
+        if (k)
+            _mm512_mask_storeu_pd(y + i, k,
+                _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a0 + i), b0,
+                                _mm512_maskz_loadu_pd(k, y + i)));
+    }
+}
+
+void l2_dgemv_t_avx512(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                       BLASLONG lda, const double *x, BLASLONG incx,
+                       double *y, BLASLONG incy) {
+    BLASLONG j = 0;
+    BLASLONG mv = m & ~(BLASLONG)7;
+    __mmask8 k = tail8(m - mv);
+    (void)incx;
+
+    for (; j + 4 <= n; j += 4) {
+        const double *a0 = a + j * lda, *a1 = a0 + lda;
+        const double *a2 = a1 + lda,    *a3 = a2 + lda;
+        __m512d c00 = _mm512_setzero_pd(), c01 = _mm512_setzero_pd();
+        __m512d c10 = _mm512_setzero_pd(), c11 = _mm512_setzero_pd();
+        __m512d c20 = _mm512_setzero_pd(), c21 = _mm512_setzero_pd();
+        __m512d c30 = _mm512_setzero_pd(), c31 = _mm512_setzero_pd();
+        BLASLONG i = 0;
+
+        for (; i + 16 <= m; i += 16) {
+            __m512d x0 = _mm512_loadu_pd(x + i), x1 = _mm512_loadu_pd(x + i + 8);
+            c00 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i),     x0, c00);
+            c01 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i + 8), x1, c01);
+            c10 = _mm512_fmadd_pd(_mm512_loadu_pd(a1 + i),     x0, c10);
+            c11 = _mm512_fmadd_pd(_mm512_loadu_pd(a1 + i + 8), x1, c11);
+            c20 = _mm512_fmadd_pd(_mm512_loadu_pd(a2 + i),     x0, c20);
+            c21 = _mm512_fmadd_pd(_mm512_loadu_pd(a2 + i + 8), x1, c21);
+            c30 = _mm512_fmadd_pd(_mm512_loadu_pd(a3 + i),     x0, c30);
+            c31 = _mm512_fmadd_pd(_mm512_loadu_pd(a3 + i + 8), x1, c31);
+        }
+        for (; i < mv; i += 8) {
+            __m512d x0 = _mm512_loadu_pd(x + i);
+            c00 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i), x0, c00);
+            c10 = _mm512_fmadd_pd(_mm512_loadu_pd(a1 + i), x0, c10);
+            c20 = _mm512_fmadd_pd(_mm512_loadu_pd(a2 + i), x0, c20);
+            c30 = _mm512_fmadd_pd(_mm512_loadu_pd(a3 + i), x0, c30);
+        }
+        if (k) {
+            __m512d x0 = _mm512_maskz_loadu_pd(k, x + i);
+            c01 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a0 + i), x0, c01);
+            c11 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a1 + i), x0, c11);
+            c21 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a2 + i), x0, c21);
+            c31 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a3 + i), x0, c31);
+        }
+        y[(j + 0) * incy] += alpha * _mm512_reduce_add_pd(_mm512_add_pd(c00, c01));
+        y[(j + 1) * incy] += alpha * _mm512_reduce_add_pd(_mm512_add_pd(c10, c11));
+        y[(j + 2) * incy] += alpha * _mm512_reduce_add_pd(_mm512_add_pd(c20, c21));
+        y[(j + 3) * incy] += alpha * _mm512_reduce_add_pd(_mm512_add_pd(c30, c31));
+    }
+    for (; j < n; j++) {
+        const double *a0 = a + j * lda;
+        __m512d c0 = _mm512_setzero_pd();
+        BLASLONG i = 0;
+
+        for (; i < mv; i += 8)
+            c0 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + i), _mm512_loadu_pd(x + i), c0);
+        if (k)
+            c0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(k, a0 + i),
+                                 _mm512_maskz_loadu_pd(k, x + i), c0);
+        y[j * incy] += alpha * _mm512_reduce_add_pd(c0);
+    }
+}
@@ -0,0 +1,339 @@
+/*
+ * Batched gemv.  Problems are small (2x2 .. a few hundred), so each one runs
+ * on a single thread and the threads share the batch instead: workers claim
+ * chunks of consecutive problems from an atomic counter until the batch is
+ * exhausted, which balances groups of different sizes without a schedule.
+ * Arguments are checked once per group, not once per problem.
+ */
+#include <stddef.h>
+#include <stdatomic.h>
+#include "l2blas_internal.h"
+
+/* Below this many A elements in total the batch runs on the caller. */
+#define L2_BATCH_MIN_WORK 65536
+/* Chunks handed out per thread; more chunks balance uneven groups better. */
+#define L2_BATCH_CHUNKS   8
+
+typedef struct {
+    char prec;                                 /* 's', 'd', 'c' or 'z' */
+    size_t esize;                              /* bytes per element */
+    enum CBLAS_ORDER order;
+
+    /* grouped form; the strided form is one group */
+    const enum CBLAS_TRANSPOSE *trans;
+    const blasint *m, *n, *lda, *incx, *incy;
+    const void *alpha, *beta;
+    const void **a, **x;
+    void **y;
+    const blasint *group_size;
+    blasint group_count;
+
+    /* strided form (a == NULL): base pointers and strides in elements */
+    const char *sa, *sx;
+    char *sy;
+    BLASLONG stride_a, stride_x, stride_y;
+
+    BLASLONG count, chunk;
+    _Atomic BLASLONG next;
+} gemv_batch_job;
+
+static void batch_item(const gemv_batch_job *b, BLASLONG g, BLASLONG i) {
+    size_t es = b->esize;
+    const void *a, *x;
+    void *y;
+
+    if (b->a) {
+        a = b->a[i];
+        x = b->x[i];
+        y = b->y[i];
+    } else {
+        a = b->sa + (ptrdiff_t)(i * b->stride_a) * (ptrdiff_t)es;
+        x = b->sx + (ptrdiff_t)(i * b->stride_x) * (ptrdiff_t)es;
+        y = b->sy + (ptrdiff_t)(i * b->stride_y) * (ptrdiff_t)es;
+    }
+
+    switch (b->prec) {
+    case 's':
+        l2_sgemv_compute(b->order, b->trans[g], b->m[g], b->n[g],
+                         ((const float *)b->alpha)[g], a, b->lda[g],
+                         x, b->incx[g], ((const float *)b->beta)[g],
+                         y, b->incy[g]);
+        break;
+    case 'd':
+        l2_dgemv_compute(b->order, b->trans[g], b->m[g], b->n[g],
+                         ((const double *)b->alpha)[g], a, b->lda[g],
+                         x, b->incx[g], ((const double *)b->beta)[g],
+                         y, b->incy[g]);
+        break;
+    case 'c':
+        l2_cgemv_compute(b->order, b->trans[g], b->m[g], b->n[g],
+                         (const float *)b->alpha + 2 * g, a, b->lda[g],
+                         x, b->incx[g], (const float *)b->beta + 2 * g,
+                         y, b->incy[g]);
+        break;
+    default:
+        l2_zgemv_compute(b->order, b->trans[g], b->m[g], b->n[g],
+                         (const double *)b->alpha + 2 * g, a, b->lda[g],
+                         x, b->incx[g], (const double *)b->beta + 2 * g,
+                         y, b->incy[g]);
+        break;
+    }
+}
+
+static void batch_worker(int tid, int nthreads, void *arg) {
+    gemv_batch_job *b = arg;
+    BLASLONG g = 0, gend = b->group_size[0];
+
+    (void)tid;
+    (void)nthreads;
+    for (;;) {
+        BLASLONG i = atomic_fetch_add(&b->next, b->chunk);
+        BLASLONG end = L2_MIN(i + b->chunk, b->count);
+
+        /* Claims only grow, so the group cursor only moves forward. */
+        for (; i < end; i++) {
+            while (i >= gend)
+                gend += b->group_size[++g];
+            batch_item(b, g, i);
+        }
+        if (end >= b->count) break;
+    }
+}
+
+/*
+ * Checks every group and runs the batch.  pos maps the gemv parameter
+ * numbers from l2_gemv_check onto the batch routine's own.
+ */
+static void batch_run(gemv_batch_job *b, const char *rname, const int *pos) {
+    double work = 0.0;
+    int nthreads;
+
+    for (blasint g = 0; g < b->group_count; g++) {
+        int info;
+
+        if (b->group_size[g] < 0) { l2_xerbla(rname, pos[13]); return; }
+        info = l2_gemv_check(b->order, b->trans[g], b->m[g], b->n[g],
+                             b->lda[g], b->incx[g], b->incy[g]);
+        if (info) { l2_xerbla(rname, pos[info]); return; }
+        b->count += b->group_size[g];
+        work += (double)b->group_size[g] * b->m[g] * b->n[g];
+    }
+    if (b->count == 0) return;
+    if (b->prec == 'c' || b->prec == 'z') work *= 4.0;
+
+    nthreads = l2_get_num_threads();
+    if (work < (double)L2_BATCH_MIN_WORK * 2)
+        nthreads = 1;
+    nthreads = (int)L2_MIN((BLASLONG)nthreads, b->count);
+    b->chunk = L2_MAX(b->count / ((BLASLONG)nthreads * L2_BATCH_CHUNKS), 1);
+    atomic_init(&b->next, 0);
+
+    if (nthreads == 1)
+        batch_worker(0, 1, b);
+    else
+        l2_parallel(nthreads, batch_worker, b);
+}
+
+/* Parameter numbers: identity for the grouped form, [13] = group_size. */
+static const int grouped_pos[14] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+                                    12, 14};
+/* Strided form: lda 7, incx 10, incy 14 (stride arguments interleave). */
+static const int strided_pos[14] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 10, 11,
+                                    14, 16};
+
+static void grouped(gemv_batch_job *b, char prec, size_t esize,
+                    enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const void *alpha_array, const void **a_array,
+                    const blasint *lda_array, const void **x_array,
+                    const blasint *incx_array, const void *beta_array,
+                    void **y_array, const blasint *incy_array,
+                    blasint group_count, const blasint *group_size,
+                    const char *rname) {
+    b->prec = prec;
+    b->esize = esize;
+    b->order = order;
+    b->trans = trans_array;
+    b->m = m_array;
+    b->n = n_array;
+    b->lda = lda_array;
+    b->incx = incx_array;
+    b->incy = incy_array;
+    b->alpha = alpha_array;
+    b->beta = beta_array;
+    b->a = a_array;
+    b->x = x_array;
+    b->y = y_array;
+    b->group_size = group_size;
+    b->group_count = group_count;
+    b->count = 0;
+
+    if (group_count < 0) { l2_xerbla(rname, 13); return; }
+    batch_run(b, rname, grouped_pos);
+}
+
+static void strided(gemv_batch_job *b, char prec, size_t esize,
+                    enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE *trans,
+                    const blasint *m, const blasint *n, const void *alpha,
+                    const void *a, const blasint *lda, BLASLONG stride_a,
+                    const void *x, const blasint *incx, BLASLONG stride_x,
+                    const void *beta, void *y, const blasint *incy,
+                    BLASLONG stride_y, const blasint *batch_count,
+                    const char *rname) {
+    b->prec = prec;
+    b->esize = esize;
+    b->order = order;
+    b->trans = trans;
+    b->m = m;
+    b->n = n;
+    b->lda = lda;
+    b->incx = incx;
+    b->incy = incy;
+    b->alpha = alpha;
+    b->beta = beta;
+    b->a = NULL;
+    b->x = NULL;
+    b->y = NULL;
+    b->sa = a;
+    b->sx = x;
+    b->sy = y;
+    b->stride_a = stride_a;
+    b->stride_x = stride_x;
+    b->stride_y = stride_y;
+    b->group_size = batch_count;
+    b->group_count = 1;
+    b->count = 0;
+
+    batch_run(b, rname, strided_pos);
+}
+
+void l2_sgemv_batch(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const float *alpha_array, const float **a_array,
+                    const blasint *lda_array, const float **x_array,
+                    const blasint *incx_array, const float *beta_array,
+                    float **y_array, const blasint *incy_array,
+                    const blasint group_count, const blasint *group_size) {
+    gemv_batch_job b;
+
+    grouped(&b, 's', sizeof(float), order, trans_array, m_array, n_array,
+            alpha_array, (const void **)a_array, lda_array,
+            (const void **)x_array, incx_array, beta_array, (void **)y_array,
+            incy_array, group_count, group_size, "l2_sgemv_batch");
+}
+
+void l2_dgemv_batch(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const double *alpha_array, const double **a_array,
+                    const blasint *lda_array, const double **x_array,
+                    const blasint *incx_array, const double *beta_array,
+                    double **y_array, const blasint *incy_array,
+                    const blasint group_count, const blasint *group_size) {
+    gemv_batch_job b;
+
+    grouped(&b, 'd', sizeof(double), order, trans_array, m_array, n_array,
+            alpha_array, (const void **)a_array, lda_array,
+            (const void **)x_array, incx_array, beta_array, (void **)y_array,
+            incy_array, group_count, group_size, "l2_dgemv_batch");
+}
+
+void l2_cgemv_batch(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const void *alpha_array, const void **a_array,
+                    const blasint *lda_array, const void **x_array,
+                    const blasint *incx_array, const void *beta_array,
+                    void **y_array, const blasint *incy_array,
+                    const blasint group_count, const blasint *group_size) {
+    gemv_batch_job b;
+
+    grouped(&b, 'c', 2 * sizeof(float), order, trans_array, m_array, n_array,
+            alpha_array, a_array, lda_array, x_array, incx_array, beta_array,
+            y_array, incy_array, group_count, group_size, "l2_cgemv_batch");
+}
+
+void l2_zgemv_batch(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const void *alpha_array, const void **a_array,
+                    const blasint *lda_array, const void **x_array,
+                    const blasint *incx_array, const void *beta_array,
+                    void **y_array, const blasint *incy_array,
+                    const blasint group_count, const blasint *group_size) {
+    gemv_batch_job b;
+
+    grouped(&b, 'z', 2 * sizeof(double), order, trans_array, m_array, n_array,
+            alpha_array, a_array, lda_array, x_array, incx_array, beta_array,
+            y_array, incy_array, group_count, group_size, "l2_zgemv_batch");
+}
+
+void l2_sgemv_batch_strided(const enum CBLAS_ORDER order,
+                            const enum CBLAS_TRANSPOSE trans,
+                            const blasint m, const blasint n,
+                            const float alpha, const float *a,
+                            const blasint lda, const BLASLONG stride_a,
+                            const float *x, const blasint incx,
+                            const BLASLONG stride_x, const float beta,
+                            float *y, const blasint incy,
+                            const BLASLONG stride_y,
+                            const blasint batch_count) {
+    gemv_batch_job b;
+
+    strided(&b, 's', sizeof(float), order, &trans, &m, &n, &alpha,
+            a, &lda, stride_a, x, &incx, stride_x, &beta, y, &incy, stride_y,
+            &batch_count, "l2_sgemv_batch_strided");
+}
+
+void l2_dgemv_batch_strided(const enum CBLAS_ORDER order,
+                            const enum CBLAS_TRANSPOSE trans,
+                            const blasint m, const blasint n,
+                            const double alpha, const double *a,
+                            const blasint lda, const BLASLONG stride_a,
+                            const double *x, const blasint incx,
+                            const BLASLONG stride_x, const double beta,
+                            double *y, const blasint incy,
+                            const BLASLONG stride_y,
+                            const blasint batch_count) {
+    gemv_batch_job b;
+
+    strided(&b, 'd', sizeof(double), order, &trans, &m, &n, &alpha,
+            a, &lda, stride_a, x, &incx, stride_x, &beta, y, &incy, stride_y,
+            &batch_count, "l2_dgemv_batch_strided");
+}
+
+void l2_cgemv_batch_strided(const enum CBLAS_ORDER order,
+                            const enum CBLAS_TRANSPOSE trans,
+                            const blasint m, const blasint n,
+                            const void *alpha, const void *a,
+                            const blasint lda, const BLASLONG stride_a,
+                            const void *x, const blasint incx,
+                            const BLASLONG stride_x, const void *beta,
+                            void *y, const blasint incy,
+                            const BLASLONG stride_y,
+                            const blasint batch_count) {
+    gemv_batch_job b;
+
+    strided(&b, 'c', 2 * sizeof(float), order, &trans, &m, &n, alpha,
+            a, &lda, stride_a, x, &incx, stride_x, beta, y, &incy, stride_y,
+            &batch_count, "l2_cgemv_batch_strided");
+}
+
+void l2_zgemv_batch_strided(const enum CBLAS_ORDER order,
+                            const enum CBLAS_TRANSPOSE trans,
+                            const blasint m, const blasint n,
+                            const void *alpha, const void *a,
+                            const blasint lda, const BLASLONG stride_a,
+                            const void *x, const blasint incx,
+                            const BLASLONG stride_x, const void *beta,
+                            void *y, const blasint incy,
+                            const BLASLONG stride_y,
+                            const blasint batch_count) {
+    gemv_batch_job b;
+
+    strided(&b, 'z', 2 * sizeof(double), order, &trans, &m, &n, alpha,
+            a, &lda, stride_a, x, &incx, stride_x, beta, y, &incy, stride_y,
+            &batch_count, "l2_zgemv_batch_strided");
+}
@@ -0,0 +1,227 @@
+/*
+ * Rank-1 updates (sger/dger, cgeru/cgerc, zgeru/zgerc).
+ *
+ * A rank-1 update reads and writes every element of A once and does one
+ * FMA (two for complex) on it, so past the caches it is a pure
+ * read-modify-write stream and the only goal is to keep the memory bus
+ * busy: vector sweeps down four columns at a time against a row tile of x
+ * held in L1, software prefetch on every column stream, and threads on
+ * disjoint blocks of contiguous columns.  See ger_template.h for the
+ * driver and ger_kernel_template.h for the SIMD kernels.
+ *
+ * Stores are ordinary ones.  Every line of A has just been loaded, so it
+ * is already owned and a non-temporal store saves no traffic; it only
+ * evicts the line early, which halved the bandwidth when tried and throws
+ * away A when it would have stayed in the last level cache.
+ */
+#include "l2blas_internal.h"
+
+static int ger_check(enum CBLAS_ORDER order, blasint m, blasint n,
+                     blasint incx, blasint incy, blasint lda) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (m < 0) return 2;
+    if (n < 0) return 3;
+    if (incx == 0) return 6;
+    if (incy == 0) return 8;
+    if (lda < L2_MAX(1, order == CblasColMajor ? m : n)) return 10;
+    return 0;
+}
+
+/* ---- portable kernels ---------------------------------------------------- */
+
+void l2_sger_kernel_generic(BLASLONG m, BLASLONG n, float alpha,
+                            const float *x, const float *y, BLASLONG incy,
+                            float *a, BLASLONG lda) {
+    for (BLASLONG j = 0; j < n; j++) {
+        float *col = a + j * lda;
+        float t = alpha * y[j * incy];
+        for (BLASLONG i = 0; i < m; i++)
+            col[i] += t * x[i];
+    }
+}
+
+void l2_dger_kernel_generic(BLASLONG m, BLASLONG n, double alpha,
+                            const double *x, const double *y, BLASLONG incy,
+                            double *a, BLASLONG lda) {
+    for (BLASLONG j = 0; j < n; j++) {
+        double *col = a + j * lda;
+        double t = alpha * y[j * incy];
+        for (BLASLONG i = 0; i < m; i++)
+            col[i] += t * x[i];
+    }
+}
+
+void l2_cger_kernel_generic(BLASLONG m, BLASLONG n, const float *alpha,
+                            const float *x, const float *xw,
+                            const float *y, BLASLONG incy, float *a,
+                            BLASLONG lda, int conjy) {
+    float sy = conjy ? -1.0f : 1.0f;
+
+    for (BLASLONG j = 0; j < n; j++) {
+        float *col = a + 2 * j * lda;
+        float yr = y[2 * j * incy], yi = sy * y[2 * j * incy + 1];
+        float tr = alpha[0] * yr - alpha[1] * yi;
+        float ti = alpha[0] * yi + alpha[1] * yr;
+        for (BLASLONG i = 0; i < 2 * m; i++)
+            col[i] += tr * x[i] + ti * xw[i];
+    }
+}
+
+void l2_zger_kernel_generic(BLASLONG m, BLASLONG n, const double *alpha,
+                            const double *x, const double *xw,
+                            const double *y, BLASLONG incy, double *a,
+                            BLASLONG lda, int conjy) {
+    double sy = conjy ? -1.0 : 1.0;
+
+    for (BLASLONG j = 0; j < n; j++) {
+        double *col = a + 2 * j * lda;
+        double yr = y[2 * j * incy], yi = sy * y[2 * j * incy + 1];
+        double tr = alpha[0] * yr - alpha[1] * yi;
+        double ti = alpha[0] * yi + alpha[1] * yr;
+        for (BLASLONG i = 0; i < 2 * m; i++)
+            col[i] += tr * x[i] + ti * xw[i];
+    }
+}
+
+/* ---- kernel selection ---------------------------------------------------- */
+
+l2_sger_kernel l2_sger_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_sger_kernel_avx512;
+    case L2_CORE_AVX2:   return l2_sger_kernel_avx2;
+    default:             return l2_sger_kernel_generic;
+    }
+}
+
+l2_dger_kernel l2_dger_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_dger_kernel_avx512;
+    case L2_CORE_AVX2:   return l2_dger_kernel_avx2;
+    default:             return l2_dger_kernel_generic;
+    }
+}
+
+l2_cger_kernel l2_cger_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_cger_kernel_avx512;
+    case L2_CORE_AVX2:   return l2_cger_kernel_avx2;
+    default:             return l2_cger_kernel_generic;
+    }
+}
+
+l2_zger_kernel l2_zger_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_zger_kernel_avx512;
+    case L2_CORE_AVX2:   return l2_zger_kernel_avx2;
+    default:             return l2_zger_kernel_generic;
+    }
+}
+
+/* ---- drivers ------------------------------------------------------------- */
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define KERNEL l2_sger_kernel
+#define PICK() l2_sger_pick()
+#include "ger_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef KERNEL
+#undef PICK
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define KERNEL l2_dger_kernel
+#define PICK() l2_dger_pick()
+#include "ger_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef KERNEL
+#undef PICK
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define KERNEL l2_cger_kernel
+#define PICK() l2_cger_pick()
+#include "ger_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef KERNEL
+#undef PICK
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define KERNEL l2_zger_kernel
+#define PICK() l2_zger_pick()
+#include "ger_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef KERNEL
+#undef PICK
+
+void l2_sger(const enum CBLAS_ORDER order, const blasint m, const blasint n,
+             const float alpha, const float *x, const blasint incx,
+             const float *y, const blasint incy, float *a, const blasint lda) {
+    int info = ger_check(order, m, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_sger", info); return; }
+    sger_compute(order, m, n, alpha, x, incx, y, incy, a, lda, 0);
+}
+
+void l2_dger(const enum CBLAS_ORDER order, const blasint m, const blasint n,
+             const double alpha, const double *x, const blasint incx,
+             const double *y, const blasint incy, double *a,
+             const blasint lda) {
+    int info = ger_check(order, m, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_dger", info); return; }
+    dger_compute(order, m, n, alpha, x, incx, y, incy, a, lda, 0);
+}
+
+void l2_cgeru(const enum CBLAS_ORDER order, const blasint m,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda) {
+    int info = ger_check(order, m, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_cgeru", info); return; }
+    cger_compute(order, m, n, alpha, x, incx, y, incy, a, lda, 0);
+}
+
+void l2_cgerc(const enum CBLAS_ORDER order, const blasint m,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda) {
+    int info = ger_check(order, m, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_cgerc", info); return; }
+    cger_compute(order, m, n, alpha, x, incx, y, incy, a, lda, 1);
+}
+
+void l2_zgeru(const enum CBLAS_ORDER order, const blasint m,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda) {
+    int info = ger_check(order, m, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_zgeru", info); return; }
+    zger_compute(order, m, n, alpha, x, incx, y, incy, a, lda, 0);
+}
+
+void l2_zgerc(const enum CBLAS_ORDER order, const blasint m,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda) {
+    int info = ger_check(order, m, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_zgerc", info); return; }
+    zger_compute(order, m, n, alpha, x, incx, y, incy, a, lda, 1);
+}
@@ -0,0 +1,130 @@
+/*
+ * Rank-2 update kernel (see l2_?ger2_kernel in l2blas_internal.h),
+ * included once per precision by ger_avx2.c and ger_avx512.c with the
+ * same macros as ger_kernel_template.h.
+ *
+ * The sweep is ger's: four columns at a time, two vectors deep, each
+ * column stream prefetched L2_GER_PF bytes ahead.  Both terms go into the
+ * loaded vector of A before it is stored, so A is read and written once
+ * for x * p(j) + y * q(j):
+ *   real     a[i] += p * x[i] + q * y[i]
+ *   complex  a[i] += pr * x[i] + pi * xw[i] + qr * y[i] + qi * yw[i]
+ */
+
+#define G2_CAT_(a, b) a##b
+#define G2_CAT(a, b) G2_CAT_(a, b)
+#define G2_KERNEL G2_CAT(G2_CAT(l2_, PREC), G2_CAT(ger2_kernel_, ISA))
+
+#define G2_STEP (2 * VL)
+#define G2_LINES ((int)(G2_STEP * sizeof(FLOAT) / 64))
+#define G2_PF ((BLASLONG)(L2_GER_PF / sizeof(FLOAT)))
+
+#define G2_PREFETCH(p) do {                                                 \
+        for (int l_ = 0; l_ < G2_LINES; l_++)                               \
+            _mm_prefetch((const char *)(p) + 64 * l_, _MM_HINT_T0);         \
+    } while (0)
+
+/*
+ * G2_LOADX(v, i) loads vector v of x and y (and xw, yw) at real i,
+ * G2_COEF(k, j) broadcasts column j's coefficients as column k of the
+ * group, G2_UPD(p, i, k, v) applies them to the vector of column p at i.
+ */
+#if CS == 1
+#define G2_LOADX(v, i) \
+    VEC x##v = V_LOAD(x + (i)), y##v = V_LOAD(y + (i))
+#define G2_COEF(k, j) \
+    FLOAT p##k = p[j], q##k = q[j];                                         \
+    VEC bp##k = V_SET1(p##k), bq##k = V_SET1(q##k)
+#define G2_UPD(a, i, k, v)                                                  \
+    V_STORE((a) + (i),                                                      \
+            V_FMA(y##v, bq##k, V_FMA(x##v, bp##k, V_LOAD((a) + (i)))))
+#define G2_SCALAR(a, i, k) ((a)[i] += p##k * x[i] + q##k * y[i])
+#else
+#define G2_LOADX(v, i)                                                      \
+    VEC x##v = V_LOAD(x + (i)), w##v = V_LOAD(xw + (i));                    \
+    VEC y##v = V_LOAD(y + (i)), z##v = V_LOAD(yw + (i))
+#define G2_COEF(k, j)                                                       \
+    FLOAT pr##k = p[2 * (j)], pi##k = p[2 * (j) + 1];                       \
+    FLOAT qr##k = q[2 * (j)], qi##k = q[2 * (j) + 1];                       \
+    VEC bpr##k = V_SET1(pr##k), bpi##k = V_SET1(pi##k);                     \
+    VEC bqr##k = V_SET1(qr##k), bqi##k = V_SET1(qi##k)
+#define G2_UPD(a, i, k, v)                                                  \
+    V_STORE((a) + (i),                                                      \
+            V_FMA(z##v, bqi##k, V_FMA(y##v, bqr##k,                         \
+            V_FMA(w##v, bpi##k, V_FMA(x##v, bpr##k, V_LOAD((a) + (i)))))))
+#define G2_SCALAR(a, i, k) \
+    ((a)[i] += pr##k * x[i] + pi##k * xw[i] + qr##k * y[i] + qi##k * yw[i])
+#endif
+
+#if CS == 1
+void G2_KERNEL(BLASLONG m, BLASLONG n, const FLOAT *x, const FLOAT *y,
+               const FLOAT *p, const FLOAT *q, FLOAT *a, BLASLONG lda)
+#else
+void G2_KERNEL(BLASLONG m, BLASLONG n, const FLOAT *x, const FLOAT *xw,
+               const FLOAT *y, const FLOAT *yw, const FLOAT *p,
+               const FLOAT *q, FLOAT *a, BLASLONG lda)
+#endif
+{
+    BLASLONG len = CS * m, j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        FLOAT *a0 = a + CS * j * lda, *a1 = a0 + CS * lda;
+        FLOAT *a2 = a1 + CS * lda,    *a3 = a2 + CS * lda;
+        G2_COEF(0, j + 0);
+        G2_COEF(1, j + 1);
+        G2_COEF(2, j + 2);
+        G2_COEF(3, j + 3);
+        BLASLONG i = 0;
+
+        for (; i + G2_STEP <= len; i += G2_STEP) {
+            G2_LOADX(0, i);
+            G2_LOADX(1, i + VL);
+            G2_PREFETCH(a0 + i + G2_PF);
+            G2_PREFETCH(a1 + i + G2_PF);
+            G2_PREFETCH(a2 + i + G2_PF);
+            G2_PREFETCH(a3 + i + G2_PF);
+            G2_UPD(a0, i, 0, 0); G2_UPD(a0, i + VL, 0, 1);
+            G2_UPD(a1, i, 1, 0); G2_UPD(a1, i + VL, 1, 1);
+            G2_UPD(a2, i, 2, 0); G2_UPD(a2, i + VL, 2, 1);
+            G2_UPD(a3, i, 3, 0); G2_UPD(a3, i + VL, 3, 1);
+        }
+        for (; i + VL <= len; i += VL) {
+            G2_LOADX(0, i);
+            G2_UPD(a0, i, 0, 0);
+            G2_UPD(a1, i, 1, 0);
+            G2_UPD(a2, i, 2, 0);
+            G2_UPD(a3, i, 3, 0);
+        }
+        for (; i < len; i++) {
+            G2_SCALAR(a0, i, 0);
+            G2_SCALAR(a1, i, 1);
+            G2_SCALAR(a2, i, 2);
+            G2_SCALAR(a3, i, 3);
+        }
+    }
+    for (; j < n; j++) {
+        FLOAT *a0 = a + CS * j * lda;
+        G2_COEF(0, j);
+        BLASLONG i = 0;
+
+        for (; i + VL <= len; i += VL) {
+            G2_LOADX(0, i);
+            if ((i & (G2_STEP - 1)) == 0) G2_PREFETCH(a0 + i + G2_PF);
+            G2_UPD(a0, i, 0, 0);
+        }
+        for (; i < len; i++)
+            G2_SCALAR(a0, i, 0);
+    }
+}
+
+#undef G2_CAT_
+#undef G2_CAT
+#undef G2_KERNEL
+#undef G2_STEP
+#undef G2_LINES
+#undef G2_PF
+#undef G2_PREFETCH
+#undef G2_LOADX
+#undef G2_COEF
+#undef G2_UPD
+#undef G2_SCALAR
@@ -0,0 +1,85 @@
+/*
+ * AVX2/FMA rank-1 and rank-2 update kernels (ger_kernel_template.h,
+ * ger2_kernel_template.h), 8 (float) or 4 (double) reals per vector.
+ * Built with -mavx2 -mfma; only called when l2_core() reports at least
+ * L2_CORE_AVX2.
+ */
+#include <immintrin.h>
+#include "l2blas_internal.h"
+
+#define ISA avx2
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define VEC __m256
+#define VL 8
+#define V_SET1(s) _mm256_set1_ps(s)
+#define V_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#define V_LOAD(p) _mm256_loadu_ps(p)
+#define V_STORE(p, v) _mm256_storeu_ps(p, v)
+#include "ger_kernel_template.h"
+#include "ger2_kernel_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef VEC
+#undef VL
+#undef V_SET1
+#undef V_FMA
+#undef V_LOAD
+#undef V_STORE
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define VEC __m256d
+#define VL 4
+#define V_SET1(s) _mm256_set1_pd(s)
+#define V_FMA(a, b, c) _mm256_fmadd_pd(a, b, c)
+#define V_LOAD(p) _mm256_loadu_pd(p)
+#define V_STORE(p, v) _mm256_storeu_pd(p, v)
+#include "ger_kernel_template.h"
+#include "ger2_kernel_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef VEC
+#undef VL
+#undef V_SET1
+#undef V_FMA
+#undef V_LOAD
+#undef V_STORE
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define VEC __m256
+#define VL 8
+#define V_SET1(s) _mm256_set1_ps(s)
+#define V_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#define V_LOAD(p) _mm256_loadu_ps(p)
+#define V_STORE(p, v) _mm256_storeu_ps(p, v)
+#include "ger_kernel_template.h"
+#include "ger2_kernel_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef VEC
+#undef VL
+#undef V_SET1
+#undef V_FMA
+#undef V_LOAD
+#undef V_STORE
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define VEC __m256d
+#define VL 4
+#define V_SET1(s) _mm256_set1_pd(s)
+#define V_FMA(a, b, c) _mm256_fmadd_pd(a, b, c)
+#define V_LOAD(p) _mm256_loadu_pd(p)
+#define V_STORE(p, v) _mm256_storeu_pd(p, v)
+#include "ger_kernel_template.h"
+#include "ger2_kernel_template.h"
@@ -0,0 +1,85 @@
+/*
+ * AVX-512F rank-1 and rank-2 update kernels (ger_kernel_template.h,
+ * ger2_kernel_template.h), 16 (float) or 8 (double) reals per vector.
+ * Built with -mavx512f; only called when l2_core() reports
+ * L2_CORE_AVX512.
+ */
+#include <immintrin.h>
+#include "l2blas_internal.h"
+
+#define ISA avx512
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define VEC __m512
+#define VL 16
+#define V_SET1(s) _mm512_set1_ps(s)
+#define V_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define V_LOAD(p) _mm512_loadu_ps(p)
+#define V_STORE(p, v) _mm512_storeu_ps(p, v)
+#include "ger_kernel_template.h"
+#include "ger2_kernel_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef VEC
+#undef VL
+#undef V_SET1
+#undef V_FMA
+#undef V_LOAD
+#undef V_STORE
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define VEC __m512d
+#define VL 8
+#define V_SET1(s) _mm512_set1_pd(s)
+#define V_FMA(a, b, c) _mm512_fmadd_pd(a, b, c)
+#define V_LOAD(p) _mm512_loadu_pd(p)
+#define V_STORE(p, v) _mm512_storeu_pd(p, v)
+#include "ger_kernel_template.h"
+#include "ger2_kernel_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef VEC
+#undef VL
+#undef V_SET1
+#undef V_FMA
+#undef V_LOAD
+#undef V_STORE
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define VEC __m512
+#define VL 16
+#define V_SET1(s) _mm512_set1_ps(s)
+#define V_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define V_LOAD(p) _mm512_loadu_ps(p)
+#define V_STORE(p, v) _mm512_storeu_ps(p, v)
+#include "ger_kernel_template.h"
+#include "ger2_kernel_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef VEC
+#undef VL
+#undef V_SET1
+#undef V_FMA
+#undef V_LOAD
+#undef V_STORE
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define VEC __m512d
+#define VL 8
+#define V_SET1(s) _mm512_set1_pd(s)
+#define V_FMA(a, b, c) _mm512_fmadd_pd(a, b, c)
+#define V_LOAD(p) _mm512_loadu_pd(p)
+#define V_STORE(p, v) _mm512_storeu_pd(p, v)
+#include "ger_kernel_template.h"
+#include "ger2_kernel_template.h"
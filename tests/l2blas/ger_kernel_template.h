@@ -0,0 +1,137 @@
+/*
+ * Rank-1 update kernel (see l2_?ger_kernel in l2blas_internal.h), included
+ * once per precision by ger_avx2.c and ger_avx512.c with
+ *   FLOAT     element type (float or double)
+ *   CS        1 for real, 2 for complex
+ *   PREC      name prefix (s, d, c, z)
+ *   ISA       name suffix (avx2, avx512)
+ *   VEC       vector type, VL reals wide
+ *   V_SET1(s)  V_FMA(a, b, c) = a*b + c  V_LOAD(p)  V_STORE(p, v)  unaligned
+ * defined.
+ *
+ * Both kinds are a sweep over the reals of each column, four columns at a
+ * time and two vectors deep, so every iteration is eight independent
+ * read-modify-write streams' worth of FMAs on one load of x:
+ *   real     a[i] += t * x[i]                      t  = alpha * y(j)
+ *   complex  a[i] += tr * xv[i] + ti * xw[i]       tr + i*ti = alpha * y(j)
+ * xw holds i*xv, so the complex multiply needs no shuffles.  Each column
+ * stream is prefetched L2_GER_PF bytes ahead: with four columns in flight
+ * the hardware prefetcher alone leaves about a quarter of the bandwidth on
+ * the table once A is out of cache.
+ */
+
+#define GK_CAT_(a, b) a##b
+#define GK_CAT(a, b) GK_CAT_(a, b)
+#define GK_KERNEL GK_CAT(GK_CAT(l2_, PREC), GK_CAT(ger_kernel_, ISA))
+
+/* Reals per iteration and the 64-byte lines they cover per column. */
+#define GK_STEP (2 * VL)
+#define GK_LINES ((int)(GK_STEP * sizeof(FLOAT) / 64))
+#define GK_PF ((BLASLONG)(L2_GER_PF / sizeof(FLOAT)))
+
+#define GK_PREFETCH(p) do {                                                 \
+        for (int l_ = 0; l_ < GK_LINES; l_++)                               \
+            _mm_prefetch((const char *)(p) + 64 * l_, _MM_HINT_T0);         \
+    } while (0)
+
+/*
+ * GK_LOADX(v, i) loads vector v of x (and xw) at real i, GK_COEF(k, yj)
+ * sets up column k's coefficient from its y element, GK_UPD(p, i, k, v)
+ * applies it to the vector of column p at i.
+ */
+#if CS == 1
+#define GK_LOADX(v, i) VEC x##v = V_LOAD(x + (i))
+#define GK_COEF(k, yj) \
+    FLOAT t##k = alpha * (yj)[0]; VEC b##k = V_SET1(t##k)
+#define GK_UPD(p, i, k, v) \
+    V_STORE((p) + (i), V_FMA(x##v, b##k, V_LOAD((p) + (i))))
+#define GK_SCALAR(p, i, k) ((p)[i] += t##k * x[i])
+#else
+#define GK_LOADX(v, i) \
+    VEC x##v = V_LOAD(x + (i)), w##v = V_LOAD(xw + (i))
+#define GK_COEF(k, yj)                                                      \
+    FLOAT yr##k = (yj)[0], yi##k = sy * (yj)[1];                            \
+    FLOAT tr##k = alpha[0] * yr##k - alpha[1] * yi##k;                      \
+    FLOAT ti##k = alpha[0] * yi##k + alpha[1] * yr##k;                      \
+    VEC br##k = V_SET1(tr##k), bi##k = V_SET1(ti##k)
+#define GK_UPD(p, i, k, v)                                                  \
+    V_STORE((p) + (i),                                                      \
+            V_FMA(w##v, bi##k, V_FMA(x##v, br##k, V_LOAD((p) + (i)))))
+#define GK_SCALAR(p, i, k) ((p)[i] += tr##k * x[i] + ti##k * xw[i])
+#endif
+
+#if CS == 1
+void GK_KERNEL(BLASLONG m, BLASLONG n, FLOAT alpha, const FLOAT *x,
+               const FLOAT *y, BLASLONG incy, FLOAT *a, BLASLONG lda)
+#else
+void GK_KERNEL(BLASLONG m, BLASLONG n, const FLOAT *alpha, const FLOAT *x,
+               const FLOAT *xw, const FLOAT *y, BLASLONG incy, FLOAT *a,
+               BLASLONG lda, int conjy)
+#endif
+{
+    BLASLONG len = CS * m, j = 0;
+#if CS == 2
+    FLOAT sy = conjy ? -1 : 1;
+#endif
+
+    for (; j + 4 <= n; j += 4) {
+        FLOAT *a0 = a + CS * j * lda, *a1 = a0 + CS * lda;
+        FLOAT *a2 = a1 + CS * lda,    *a3 = a2 + CS * lda;
+        GK_COEF(0, y + CS * (j + 0) * incy);
+        GK_COEF(1, y + CS * (j + 1) * incy);
+        GK_COEF(2, y + CS * (j + 2) * incy);
+        GK_COEF(3, y + CS * (j + 3) * incy);
+        BLASLONG i = 0;
+
+        for (; i + GK_STEP <= len; i += GK_STEP) {
+            GK_LOADX(0, i);
+            GK_LOADX(1, i + VL);
+            GK_PREFETCH(a0 + i + GK_PF);
+            GK_PREFETCH(a1 + i + GK_PF);
+            GK_PREFETCH(a2 + i + GK_PF);
+            GK_PREFETCH(a3 + i + GK_PF);
+            GK_UPD(a0, i, 0, 0); GK_UPD(a0, i + VL, 0, 1);
+            GK_UPD(a1, i, 1, 0); GK_UPD(a1, i + VL, 1, 1);
+            GK_UPD(a2, i, 2, 0); GK_UPD(a2, i + VL, 2, 1);
+            GK_UPD(a3, i, 3, 0); GK_UPD(a3, i + VL, 3, 1);
+        }
+        for (; i + VL <= len; i += VL) {
+            GK_LOADX(0, i);
+            GK_UPD(a0, i, 0, 0);
+            GK_UPD(a1, i, 1, 0);
+            GK_UPD(a2, i, 2, 0);
+            GK_UPD(a3, i, 3, 0);
+        }
+        for (; i < len; i++) {
+            GK_SCALAR(a0, i, 0);
+            GK_SCALAR(a1, i, 1);
+            GK_SCALAR(a2, i, 2);
+            GK_SCALAR(a3, i, 3);
+        }
+    }
+    for (; j < n; j++) {
+        FLOAT *a0 = a + CS * j * lda;
+        GK_COEF(0, y + CS * j * incy);
+        BLASLONG i = 0;
+
+        for (; i + VL <= len; i += VL) {
+            GK_LOADX(0, i);
+            if ((i & (GK_STEP - 1)) == 0) GK_PREFETCH(a0 + i + GK_PF);
+            GK_UPD(a0, i, 0, 0);
+        }
+        for (; i < len; i++)
+            GK_SCALAR(a0, i, 0);
+    }
+}
+
+#undef GK_CAT_
+#undef GK_CAT
+#undef GK_KERNEL
+#undef GK_STEP
+#undef GK_LINES
+#undef GK_PF
+#undef GK_PREFETCH
+#undef GK_LOADX
+#undef GK_COEF
+#undef GK_UPD
+#undef GK_SCALAR
@@ -0,0 +1,149 @@
+/*
+ * ger driver, included once per precision by ger.c with
+ *   FLOAT    element type (float or double)
+ *   CS       1 for real, 2 for complex
+ *   PREC     name prefix (s, d, c, z)
+ *   KERNEL   l2_?ger_kernel
+ *   PICK()   l2_?ger_pick()
+ * defined.
+ *
+ * Everything is column-major: a RowMajor A is the ColMajor A^T, which is
+ * the same update with x and y swapped (and, for gerc, the conjugation
+ * moved from the column coefficients to the row vector).  Threads split
+ * the columns of that ColMajor view, i.e. column blocks of a ColMajor A
+ * and row blocks of a RowMajor one, so every thread streams whole
+ * contiguous runs of A of its own; only when there are too few columns to
+ * go round are the rows split instead.
+ */
+
+#define GER_CAT_(a, b) a##b
+#define GER_CAT(a, b) GER_CAT_(a, b)
+#define GER_FN(name) GER_CAT(PREC, name)
+
+#define GER_MB L2_GER_MB(FLOAT)
+
+typedef struct {
+    BLASLONG m, n, lda, incx, incy;
+#if CS == 1
+    FLOAT alpha;
+#else
+    const FLOAT *alpha;
+#endif
+    const FLOAT *x, *y;
+    FLOAT *a;
+    int conjx, conjy, by_rows;
+    KERNEL kernel;
+} GER_FN(ger_args);
+
+/* Rows [r0, r1) of columns [c0, c1). */
+static void GER_FN(ger_block)(const GER_FN(ger_args) *p, BLASLONG r0,
+                              BLASLONG r1, BLASLONG c0, BLASLONG c1) {
+    const FLOAT *y = p->y + CS * c0 * p->incy;
+    FLOAT *a = p->a + CS * c0 * p->lda;
+    FLOAT xv[CS * GER_MB] __attribute__((aligned(64)));
+#if CS == 2
+    FLOAT xw[2 * GER_MB] __attribute__((aligned(64)));
+    FLOAT sx = p->conjx ? -1 : 1;
+#endif
+
+#if CS == 1
+    if (p->incx == 1) {
+        p->kernel(r1 - r0, c1 - c0, p->alpha, p->x + r0, y, p->incy,
+                  a + r0, p->lda);
+        return;
+    }
+#endif
+    for (BLASLONG i = r0; i < r1; i += GER_MB) {
+        BLASLONG len = L2_MIN(GER_MB, r1 - i);
+        const FLOAT *x = p->x + CS * i * p->incx;
+
+        for (BLASLONG k = 0; k < len; k++) {
+#if CS == 1
+            xv[k] = x[k * p->incx];
+#else
+            FLOAT re = x[2 * k * p->incx], im = sx * x[2 * k * p->incx + 1];
+            xv[2 * k] = re;
+            xv[2 * k + 1] = im;
+            xw[2 * k] = -im;
+            xw[2 * k + 1] = re;
+#endif
+        }
+#if CS == 1
+        p->kernel(len, c1 - c0, p->alpha, xv, y, p->incy, a + i, p->lda);
+#else
+        p->kernel(len, c1 - c0, p->alpha, xv, xw, y, p->incy, a + 2 * i,
+                  p->lda, p->conjy);
+#endif
+    }
+}
+
+/* One thread's share: a column block, or a row block when by_rows. */
+static void GER_FN(ger_worker)(int tid, int nthreads, void *arg) {
+    const GER_FN(ger_args) *p = arg;
+    BLASLONG len = p->by_rows ? p->m : p->n;
+    BLASLONG align = p->by_rows ? 16 : 4;
+    BLASLONG chunk = ((len + nthreads - 1) / nthreads + align - 1) & -align;
+    BLASLONG lo = L2_MIN(tid * chunk, len), hi = L2_MIN(lo + chunk, len);
+
+    if (lo == hi) return;
+    if (p->by_rows)
+        GER_FN(ger_block)(p, lo, hi, 0, p->n);
+    else
+        GER_FN(ger_block)(p, 0, p->m, lo, hi);
+}
+
+#if CS == 1
+static void GER_FN(ger_compute)(enum CBLAS_ORDER order, BLASLONG m,
+                                BLASLONG n, FLOAT alpha, const FLOAT *x,
+                                BLASLONG incx, const FLOAT *y, BLASLONG incy,
+                                FLOAT *a, BLASLONG lda, int conj)
+#else
+static void GER_FN(ger_compute)(enum CBLAS_ORDER order, BLASLONG m,
+                                BLASLONG n, const FLOAT *alpha,
+                                const FLOAT *x, BLASLONG incx,
+                                const FLOAT *y, BLASLONG incy, FLOAT *a,
+                                BLASLONG lda, int conj)
+#endif
+{
+    GER_FN(ger_args) p;
+    int nthreads = l2_get_num_threads();
+    double work;
+
+#if CS == 1
+    if (m == 0 || n == 0 || alpha == 0) return;
+#else
+    if (m == 0 || n == 0 || (alpha[0] == 0 && alpha[1] == 0)) return;
+#endif
+    x = L2_VEC_BASE(x, m, CS * incx);
+    y = L2_VEC_BASE(y, n, CS * incy);
+
+    p.alpha = alpha;
+    p.a = a;
+    p.lda = lda;
+    p.kernel = PICK();
+    if (order == CblasColMajor) {
+        p.m = m;      p.n = n;
+        p.x = x;      p.incx = incx;
+        p.y = y;      p.incy = incy;
+        p.conjx = 0;  p.conjy = conj;
+    } else {
+        p.m = n;      p.n = m;
+        p.x = y;      p.incx = incy;
+        p.y = x;      p.incy = incx;
+        p.conjx = conj;  p.conjy = 0;
+    }
+
+    work = (double)m * (double)n * CS;
+    if (nthreads > 1 && work >= 2.0 * L2_GER_MIN_WORK) {
+        nthreads = (int)L2_MIN((double)nthreads, work / L2_GER_MIN_WORK);
+        p.by_rows = p.n < 4 * (BLASLONG)nthreads;
+        l2_parallel(nthreads, GER_FN(ger_worker), &p);
+    } else {
+        GER_FN(ger_block)(&p, 0, p.m, 0, p.n);
+    }
+}
+
+#undef GER_CAT_
+#undef GER_CAT
+#undef GER_FN
+#undef GER_MB
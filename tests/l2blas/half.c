@@ -0,0 +1,512 @@
+#include <stddef.h>
+#include "l2blas_internal.h"
+
+/*
+ * gemv, symv and trmv on bf16 (sb) or fp16 (sh) storage with fp32
+ * arithmetic.  gemv is bound by the bytes of A it streams, so halving the
+ * element halves the time once A is out of cache; x is widened into a
+ * stack buffer L2_HALF_XB elements at a time and the kernels only ever
+ * convert A, in registers, as it is loaded.  The drivers are those of the
+ * fp32 routines: gemv chunks the dimension x runs along, symv keeps the
+ * L2_SYMV_NB blocking with both x segments widened per block, and trmv is
+ * blocked with scalar diagonal blocks and every off-diagonal panel a gemv
+ * kernel call.
+ */
+
+static inline float half_get(int fmt, uint16_t h) {
+    return fmt == L2_HALF_BF16 ? l2_bf16_to_float(h) : l2_fp16_to_float(h);
+}
+
+/* buf[i] = x(i) for i in [0, n); x is based at its first element. */
+static void half_widen(int fmt, BLASLONG n, const uint16_t *x, BLASLONG incx,
+                       float *buf) {
+    for (BLASLONG i = 0; i < n; i++)
+        buf[i] = half_get(fmt, x[i * incx]);
+}
+
+/* ---- portable kernels (any increments) ---------------------------------- */
+
+static inline void hgemv_n_generic(int fmt, BLASLONG m, BLASLONG n,
+                                   float alpha, const uint16_t *a,
+                                   BLASLONG lda, const float *x,
+                                   BLASLONG incx, float *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const uint16_t *col = a + j * lda;
+        float t = alpha * x[j * incx];
+        for (BLASLONG i = 0; i < m; i++)
+            y[i * incy] += t * half_get(fmt, col[i]);
+    }
+}
+
+static inline void hgemv_t_generic(int fmt, BLASLONG m, BLASLONG n,
+                                   float alpha, const uint16_t *a,
+                                   BLASLONG lda, const float *x,
+                                   BLASLONG incx, float *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const uint16_t *col = a + j * lda;
+        float s = 0.0f;
+        for (BLASLONG i = 0; i < m; i++)
+            s += half_get(fmt, col[i]) * x[i * incx];
+        y[j * incy] += alpha * s;
+    }
+}
+
+static inline void hsymv_panel_generic(int fmt, BLASLONG m, BLASLONG n,
+                                       float alpha, const uint16_t *a,
+                                       BLASLONG lda,
+                                       const float *x1, float *y1,
+                                       const float *x2, float *y2) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const uint16_t *col = a + j * lda;
+        float t1 = alpha * x2[j], t2 = 0.0f;
+        for (BLASLONG i = 0; i < m; i++) {
+            float v = half_get(fmt, col[i]);
+            y1[i] += t1 * v;
+            t2 += v * x1[i];
+        }
+        y2[j] += alpha * t2;
+    }
+}
+
+void l2_sbgemv_n_generic(BLASLONG m, BLASLONG n, float alpha,
+                         const uint16_t *a, BLASLONG lda,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy) {
+    hgemv_n_generic(L2_HALF_BF16, m, n, alpha, a, lda, x, incx, y, incy);
+}
+
+void l2_sbgemv_t_generic(BLASLONG m, BLASLONG n, float alpha,
+                         const uint16_t *a, BLASLONG lda,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy) {
+    hgemv_t_generic(L2_HALF_BF16, m, n, alpha, a, lda, x, incx, y, incy);
+}
+
+void l2_shgemv_n_generic(BLASLONG m, BLASLONG n, float alpha,
+                         const uint16_t *a, BLASLONG lda,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy) {
+    hgemv_n_generic(L2_HALF_FP16, m, n, alpha, a, lda, x, incx, y, incy);
+}
+
+void l2_shgemv_t_generic(BLASLONG m, BLASLONG n, float alpha,
+                         const uint16_t *a, BLASLONG lda,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy) {
+    hgemv_t_generic(L2_HALF_FP16, m, n, alpha, a, lda, x, incx, y, incy);
+}
+
+void l2_sbsymv_panel_generic(BLASLONG m, BLASLONG n, float alpha,
+                             const uint16_t *a, BLASLONG lda,
+                             const float *x1, float *y1,
+                             const float *x2, float *y2) {
+    hsymv_panel_generic(L2_HALF_BF16, m, n, alpha, a, lda, x1, y1, x2, y2);
+}
+
+void l2_shsymv_panel_generic(BLASLONG m, BLASLONG n, float alpha,
+                             const uint16_t *a, BLASLONG lda,
+                             const float *x1, float *y1,
+                             const float *x2, float *y2) {
+    hsymv_panel_generic(L2_HALF_FP16, m, n, alpha, a, lda, x1, y1, x2, y2);
+}
+
+/* ---- dispatch ------------------------------------------------------------ */
+
+/* The AVX2 fp16 kernels need F16C, which l2_core() does not check for. */
+static int half_core(int fmt) {
+    int core = l2_core();
+
+    if (core == L2_CORE_AVX2 && fmt == L2_HALF_FP16 &&
+        !__builtin_cpu_supports("f16c"))
+        return L2_CORE_GENERIC;
+    return core;
+}
+
+l2_hgemv_kernel l2_hgemv_pick(int fmt, int notrans, BLASLONG incx,
+                              BLASLONG incy) {
+    int bf = fmt == L2_HALF_BF16;
+
+    switch ((notrans ? incy : incx) == 1 ? half_core(fmt) : L2_CORE_GENERIC) {
+    case L2_CORE_AVX512:
+        if (bf) return notrans ? l2_sbgemv_n_avx512 : l2_sbgemv_t_avx512;
+        return notrans ? l2_shgemv_n_avx512 : l2_shgemv_t_avx512;
+    case L2_CORE_AVX2:
+        if (bf) return notrans ? l2_sbgemv_n_avx2 : l2_sbgemv_t_avx2;
+        return notrans ? l2_shgemv_n_avx2 : l2_shgemv_t_avx2;
+    default:
+        if (bf) return notrans ? l2_sbgemv_n_generic : l2_sbgemv_t_generic;
+        return notrans ? l2_shgemv_n_generic : l2_shgemv_t_generic;
+    }
+}
+
+l2_hsymv_panel_kernel l2_hsymv_panel_pick(int fmt) {
+    int bf = fmt == L2_HALF_BF16;
+
+    switch (half_core(fmt)) {
+    case L2_CORE_AVX512:
+        return bf ? l2_sbsymv_panel_avx512 : l2_shsymv_panel_avx512;
+    case L2_CORE_AVX2:
+        return bf ? l2_sbsymv_panel_avx2 : l2_shsymv_panel_avx2;
+    default:
+        return bf ? l2_sbsymv_panel_generic : l2_shsymv_panel_generic;
+    }
+}
+
+/* ---- gemv ---------------------------------------------------------------- */
+
+static void hgemv(int fmt, enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                  BLASLONG m, BLASLONG n, float alpha, const uint16_t *a,
+                  BLASLONG lda, const uint16_t *x, BLASLONG incx, float beta,
+                  float *y, BLASLONG incy) {
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    float buf[L2_HALF_XB];
+    BLASLONG lenx, leny, rows, cols;
+    l2_hgemv_kernel kernel;
+    int notrans;
+
+    if (m == 0 || n == 0 || (alpha == 0.0f && beta == 1.0f)) return;
+
+    lenx = plain ? n : m;
+    leny = plain ? m : n;
+    x = L2_VEC_BASE(x, lenx, incx);
+    y = L2_VEC_BASE(y, leny, incy);
+
+    if (beta != 1.0f) {
+        for (BLASLONG i = 0; i < leny; i++)
+            y[i * incy] = beta == 0.0f ? 0.0f : beta * y[i * incy];
+    }
+    if (alpha == 0.0f) return;
+
+    rows = order == CblasColMajor ? m : n;
+    cols = order == CblasColMajor ? n : m;
+    notrans = plain == (order == CblasColMajor);
+    kernel = l2_hgemv_pick(fmt, notrans, 1, incy);
+
+    /* x runs along the columns for "n", along the rows for "t" */
+    for (BLASLONG k0 = 0; k0 < lenx; k0 += L2_HALF_XB) {
+        BLASLONG kb = L2_MIN(L2_HALF_XB, lenx - k0);
+
+        half_widen(fmt, kb, x + k0 * incx, incx, buf);
+        if (notrans)
+            kernel(rows, kb, alpha, a + k0 * lda, lda, buf, 1, y, incy);
+        else
+            kernel(kb, cols, alpha, a + k0, lda, buf, 1, y, incy);
+    }
+}
+
+void l2_sbgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+               const blasint m, const blasint n, const float alpha,
+               const bfloat16 *a, const blasint lda, const bfloat16 *x,
+               const blasint incx, const float beta, float *y,
+               const blasint incy) {
+    int info = l2_gemv_check(order, trans, m, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_sbgemv", info); return; }
+    hgemv(L2_HALF_BF16, order, trans, m, n, alpha, a, lda, x, incx, beta, y,
+          incy);
+}
+
+void l2_shgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+               const blasint m, const blasint n, const float alpha,
+               const l2_fp16 *a, const blasint lda, const l2_fp16 *x,
+               const blasint incx, const float beta, float *y,
+               const blasint incy) {
+    int info = l2_gemv_check(order, trans, m, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_shgemv", info); return; }
+    hgemv(L2_HALF_FP16, order, trans, m, n, alpha, a, lda, x, incx, beta, y,
+          incy);
+}
+
+/* ---- symv ---------------------------------------------------------------- */
+
+/* Diagonal block, as ssymv_diag in symv.c; x is widened already. */
+static void hsymv_diag(int fmt, int lower, BLASLONG n, float alpha,
+                       const uint16_t *a, BLASLONG lda, const float *x,
+                       float *y, l2_hsymv_panel_kernel panel) {
+    for (BLASLONG j = 0; j < n; j += 4) {
+        BLASLONG w = L2_MIN(4, n - j);
+        const uint16_t *d = a + j + j * lda;
+
+        for (BLASLONG c = 0; c < w; c++) {
+            float t1 = alpha * x[j + c], t2 = 0.0f;
+            BLASLONG r0 = lower ? c + 1 : 0, r1 = lower ? w : c;
+            y[j + c] += t1 * half_get(fmt, d[c + c * lda]);
+            for (BLASLONG r = r0; r < r1; r++) {
+                float v = half_get(fmt, d[r + c * lda]);
+                y[j + r] += t1 * v;
+                t2 += v * x[j + r];
+            }
+            y[j + c] += alpha * t2;
+        }
+        if (lower && n - j - w > 0)
+            panel(n - j - w, w, alpha, d + w, lda, x + j + w, y + j + w,
+                  x + j, y + j);
+        else if (!lower && j > 0)
+            panel(j, w, alpha, a + j * lda, lda, x, y, x + j, y + j);
+    }
+}
+
+static void hsymv_blocked(int fmt, int lower, BLASLONG n, float alpha,
+                          const uint16_t *a, BLASLONG lda, const uint16_t *x,
+                          BLASLONG incx, float *y) {
+    const BLASLONG nb = L2_SYMV_NB(float);
+    float xj[L2_SYMV_NB(float)], xi[L2_SYMV_NB(float)];
+    l2_hsymv_panel_kernel panel = l2_hsymv_panel_pick(fmt);
+
+    for (BLASLONG j0 = 0; j0 < n; j0 += nb) {
+        BLASLONG jb = L2_MIN(nb, n - j0);
+        BLASLONG i_begin = lower ? j0 + jb : 0, i_end = lower ? n : j0;
+
+        half_widen(fmt, jb, x + j0 * incx, incx, xj);
+        hsymv_diag(fmt, lower, jb, alpha, a + j0 + j0 * lda, lda, xj, y + j0,
+                   panel);
+        for (BLASLONG i0 = i_begin; i0 < i_end; i0 += nb) {
+            BLASLONG ib = L2_MIN(nb, i_end - i0);
+            half_widen(fmt, ib, x + i0 * incx, incx, xi);
+            panel(ib, jb, alpha, a + i0 + j0 * lda, lda, xi, y + i0, xj,
+                  y + j0);
+        }
+    }
+}
+
+/* Strided y: one column at a time, converting as it goes. */
+static void hsymv_strided(int fmt, int lower, BLASLONG n, float alpha,
+                          const uint16_t *a, BLASLONG lda, const uint16_t *x,
+                          BLASLONG incx, float *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const uint16_t *col = a + j * lda;
+        float t1 = alpha * half_get(fmt, x[j * incx]), t2 = 0.0f;
+        BLASLONG i0 = lower ? j + 1 : 0, i1 = lower ? n : j;
+        y[j * incy] += t1 * half_get(fmt, col[j]);
+        for (BLASLONG i = i0; i < i1; i++) {
+            float v = half_get(fmt, col[i]);
+            y[i * incy] += t1 * v;
+            t2 += v * half_get(fmt, x[i * incx]);
+        }
+        y[j * incy] += alpha * t2;
+    }
+}
+
+static void hsymv(int fmt, enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                  BLASLONG n, float alpha, const uint16_t *a, BLASLONG lda,
+                  const uint16_t *x, BLASLONG incx, float beta, float *y,
+                  BLASLONG incy) {
+    int lower;
+
+    if (n == 0 || (alpha == 0.0f && beta == 1.0f)) return;
+
+    x = L2_VEC_BASE(x, n, incx);
+    y = L2_VEC_BASE(y, n, incy);
+    if (beta != 1.0f) {
+        for (BLASLONG i = 0; i < n; i++)
+            y[i * incy] = beta == 0.0f ? 0.0f : beta * y[i * incy];
+    }
+    if (alpha == 0.0f) return;
+
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    if (incy == 1)
+        hsymv_blocked(fmt, lower, n, alpha, a, lda, x, incx, y);
+    else
+        hsymv_strided(fmt, lower, n, alpha, a, lda, x, incx, y, incy);
+}
+
+void l2_sbsymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const blasint n, const float alpha, const bfloat16 *a,
+               const blasint lda, const bfloat16 *x, const blasint incx,
+               const float beta, float *y, const blasint incy) {
+    int info = l2_symv_check(order, uplo, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_sbsymv", info); return; }
+    hsymv(L2_HALF_BF16, order, uplo, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+void l2_shsymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const blasint n, const float alpha, const l2_fp16 *a,
+               const blasint lda, const l2_fp16 *x, const blasint incx,
+               const float beta, float *y, const blasint incy) {
+    int info = l2_symv_check(order, uplo, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_shsymv", info); return; }
+    hsymv(L2_HALF_FP16, order, uplo, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+/* ---- trmv ---------------------------------------------------------------- */
+
+/*
+ * x := op(T) x for an n x n column-major triangle T, in place, in scalar
+ * code.  Each element is overwritten in the order that leaves the ones it
+ * still needs untouched: NoTrans Upper (rows) and Trans Lower (columns)
+ * ascending, the other two descending.
+ */
+static void htrmv_tri(int fmt, int lower, int notrans, int unit, BLASLONG n,
+                      const uint16_t *a, BLASLONG lda, float *x,
+                      BLASLONG incx) {
+    int up = lower != notrans;
+
+    for (BLASLONG s = 0; s < n; s++) {
+        BLASLONG k = up ? s : n - 1 - s;
+        BLASLONG lo = lower == notrans ? 0 : k + 1;
+        BLASLONG hi = lower == notrans ? k : n;
+        float t = unit ? x[k * incx]
+                       : half_get(fmt, a[k + k * lda]) * x[k * incx];
+
+        if (notrans)
+            for (BLASLONG j = lo; j < hi; j++)
+                t += half_get(fmt, a[k + j * lda]) * x[j * incx];
+        else
+            for (BLASLONG i = lo; i < hi; i++)
+                t += half_get(fmt, a[i + k * lda]) * x[i * incx];
+        x[k * incx] = t;
+    }
+}
+
+/*
+ * Unit stride: L2_HALF_TRMV_NB diagonal blocks in the same order as the
+ * elements above, each with its off-diagonal panel as one gemv kernel call
+ * on whole column runs (a row panel would stride across a page per
+ * column).  NoTrans adds block j's columns into the blocks of x still to
+ * be finished, before the triangle overwrites x_j; Trans gathers into x_j
+ * from the blocks not yet overwritten.
+ */
+static void htrmv_blocked(int fmt, int lower, int notrans, int unit,
+                          BLASLONG n, const uint16_t *a, BLASLONG lda,
+                          float *x) {
+    const BLASLONG nb = L2_HALF_TRMV_NB;
+    BLASLONG nblocks = (n + nb - 1) / nb;
+    l2_hgemv_kernel kn = l2_hgemv_pick(fmt, 1, 1, 1);
+    l2_hgemv_kernel kt = l2_hgemv_pick(fmt, 0, 1, 1);
+    int up = lower != notrans;
+
+    for (BLASLONG s = 0; s < nblocks; s++) {
+        BLASLONG j0 = (up ? s : nblocks - 1 - s) * nb;
+        BLASLONG jb = L2_MIN(nb, n - j0), j1 = j0 + jb;
+        const uint16_t *col = a + j0 * lda;
+
+        if (notrans && !lower && j0 > 0)
+            kn(j0, jb, 1.0f, col, lda, x + j0, 1, x, 1);
+        else if (notrans && lower && j1 < n)
+            kn(n - j1, jb, 1.0f, col + j1, lda, x + j0, 1, x + j1, 1);
+        htrmv_tri(fmt, lower, notrans, unit, jb, col + j0, lda, x + j0, 1);
+        if (!notrans && !lower && j0 > 0)
+            kt(j0, jb, 1.0f, col, lda, x, 1, x + j0, 1);
+        else if (!notrans && lower && j1 < n)
+            kt(n - j1, jb, 1.0f, col + j1, lda, x + j1, 1, x + j0, 1);
+    }
+}
+
+static void htrmv(int fmt, enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                  enum CBLAS_TRANSPOSE trans, enum CBLAS_DIAG diag,
+                  BLASLONG n, const uint16_t *a, BLASLONG lda, float *x,
+                  BLASLONG incx) {
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int col = order == CblasColMajor;
+    int lower, notrans, unit = diag == CblasUnit;
+
+    if (n == 0) return;
+    x = L2_VEC_BASE(x, n, incx);
+
+    /* RowMajor T is the ColMajor transpose: other triangle, other op. */
+    lower = (uplo == CblasLower) == col;
+    notrans = plain == col;
+    if (incx == 1)
+        htrmv_blocked(fmt, lower, notrans, unit, n, a, lda, x);
+    else
+        htrmv_tri(fmt, lower, notrans, unit, n, a, lda, x, incx);
+}
+
+void l2_sbtrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+               const blasint n, const bfloat16 *a, const blasint lda,
+               float *x, const blasint incx) {
+    int info = l2_trxv_check(order, uplo, trans, diag, n, lda, incx);
+
+    if (info) { l2_xerbla("l2_sbtrmv", info); return; }
+    htrmv(L2_HALF_BF16, order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+void l2_shtrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+               const blasint n, const l2_fp16 *a, const blasint lda,
+               float *x, const blasint incx) {
+    int info = l2_trxv_check(order, uplo, trans, diag, n, lda, incx);
+
+    if (info) { l2_xerbla("l2_shtrmv", info); return; }
+    htrmv(L2_HALF_FP16, order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+/* ---- float <-> bf16, fp16 ------------------------------------------------ */
+
+static uint16_t float_to_bf16(float f) {
+    uint32_t bits;
+
+    memcpy(&bits, &f, sizeof(bits));
+    if ((bits & 0x7fffffffu) > 0x7f800000u)     /* nan: keep it quiet */
+        return (uint16_t)((bits >> 16) | 0x40u);
+    bits += 0x7fffu + ((bits >> 16) & 1u);      /* ties to even */
+    return (uint16_t)(bits >> 16);
+}
+
+static uint16_t float_to_fp16(float f) {
+    uint32_t bits, mag;
+    uint16_t sign;
+
+    memcpy(&bits, &f, sizeof(bits));
+    sign = (uint16_t)((bits >> 16) & 0x8000u);
+    mag = bits & 0x7fffffffu;
+
+    if (mag >= 0x7f800000u)             /* inf; nan stays a quiet nan */
+        return sign | 0x7c00u | (mag > 0x7f800000u ? 0x200u : 0u);
+    if (mag >= 0x477ff000u)             /* rounds to 65536 or more */
+        return sign | 0x7c00u;
+    if (mag < 0x38800000u) {            /* below 2^-14: subnormal or zero */
+        /* mag * 2^24 rounded to an integer, ties to even via the 2^23 trick */
+        float v, big = 0x1p23f;
+        uint32_t vb;
+
+        memcpy(&v, &mag, sizeof(v));
+        v = v * 0x1p24f + big;
+        memcpy(&vb, &v, sizeof(vb));
+        return sign | (uint16_t)(vb - 0x4b000000u);
+    }
+    /* rebias the exponent, round 23 fraction bits to 10, ties to even */
+    mag -= (uint32_t)(127 - 15) << 23;
+    mag += 0xfffu + ((mag >> 13) & 1u);
+    return sign | (uint16_t)(mag >> 13);
+}
+
+void l2_shstofp16(const blasint n, const float *in, const blasint incin,
+                  l2_fp16 *out, const blasint incout) {
+    if (n <= 0) return;
+    in = L2_VEC_BASE(in, n, incin);
+    out = L2_VEC_BASE(out, n, incout);
+    for (BLASLONG i = 0; i < n; i++)
+        out[i * incout] = float_to_fp16(in[i * incin]);
+}
+
+void l2_shfp16tos(const blasint n, const l2_fp16 *in, const blasint incin,
+                  float *out, const blasint incout) {
+    if (n <= 0) return;
+    in = L2_VEC_BASE(in, n, incin);
+    out = L2_VEC_BASE(out, n, incout);
+    for (BLASLONG i = 0; i < n; i++)
+        out[i * incout] = l2_fp16_to_float(in[i * incin]);
+}
+
+void l2_sbstobf16(const blasint n, const float *in, const blasint incin,
+                  bfloat16 *out, const blasint incout) {
+    if (n <= 0) return;
+    in = L2_VEC_BASE(in, n, incin);
+    out = L2_VEC_BASE(out, n, incout);
+    for (BLASLONG i = 0; i < n; i++)
+        out[i * incout] = float_to_bf16(in[i * incin]);
+}
+
+void l2_sbf16tos(const blasint n, const bfloat16 *in, const blasint incin,
+                 float *out, const blasint incout) {
+    if (n <= 0) return;
+    in = L2_VEC_BASE(in, n, incin);
+    out = L2_VEC_BASE(out, n, incout);
+    for (BLASLONG i = 0; i < n; i++)
+        out[i * incout] = l2_bf16_to_float(in[i * incin]);
+}
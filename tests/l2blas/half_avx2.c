@@ -0,0 +1,33 @@
+/*
+ * AVX2+FMA reduced-precision gemv/symv kernels (half_template.h), 8 floats
+ * per vector.  bf16 widens with vpmovzxwd and a 16-bit shift; fp16 needs
+ * F16C's vcvtph2ps, so this file is also built with -mf16c and the sh
+ * kernels are only picked when the CPU has it (half.c).
+ */
+#include <immintrin.h>
+#include "l2blas_internal.h"
+#include "l2blas_avx2.h"
+
+#define ISA avx2
+#define VEC __m256
+#define VL 8
+#define V_ZERO() _mm256_setzero_ps()
+#define V_SET1(s) _mm256_set1_ps(s)
+#define V_FMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#define V_LOAD(p) _mm256_loadu_ps(p)
+#define V_STORE(p, v) _mm256_storeu_ps(p, v)
+#define V_HSUM(v) l2_hsum_ps(v)
+
+#define FMT sb
+#define V_LOADH(p) _mm256_castsi256_ps(_mm256_slli_epi32(                  \
+        _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(p))), 16))
+#define H2F(h) l2_bf16_to_float(h)
+#include "half_template.h"
+#undef FMT
+#undef V_LOADH
+#undef H2F
+
+#define FMT sh
+#define V_LOADH(p) _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(p)))
+#define H2F(h) l2_fp16_to_float(h)
+#include "half_template.h"
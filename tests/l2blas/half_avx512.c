@@ -0,0 +1,32 @@
+/*
+ * AVX-512F reduced-precision gemv/symv kernels (half_template.h), 16 floats
+ * per vector.  bf16 widens with vpmovzxwd and a 16-bit shift, fp16 with
+ * vcvtph2ps; both are AVX-512F.  Built with -mavx512f; only called when
+ * l2_core() reports L2_CORE_AVX512.
+ */
+#include <immintrin.h>
+#include "l2blas_internal.h"
+
+#define ISA avx512
+#define VEC __m512
+#define VL 16
+#define V_ZERO() _mm512_setzero_ps()
+#define V_SET1(s) _mm512_set1_ps(s)
+#define V_FMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define V_LOAD(p) _mm512_loadu_ps(p)
+#define V_STORE(p, v) _mm512_storeu_ps(p, v)
+#define V_HSUM(v) _mm512_reduce_add_ps(v)
+
+#define FMT sb
+#define V_LOADH(p) _mm512_castsi512_ps(_mm512_slli_epi32(                  \
+        _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(p))), 16))
+#define H2F(h) l2_bf16_to_float(h)
+#include "half_template.h"
+#undef FMT
+#undef V_LOADH
+#undef H2F
+
+#define FMT sh
+#define V_LOADH(p) _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(p)))
+#define H2F(h) l2_fp16_to_float(h)
+#include "half_template.h"
@@ -0,0 +1,212 @@
+/*
+ * Reduced-precision gemv and symv kernels (see l2_hgemv_kernel and
+ * l2_hsymv_panel_kernel in l2blas_internal.h), included once per storage
+ * format by half_avx2.c and half_avx512.c with
+ *   FMT       name prefix: sb (bf16) or sh (fp16)
+ *   ISA       name suffix (avx2, avx512)
+ *   VEC       float vector type, VL floats wide
+ *   V_ZERO()  V_SET1(s)  V_FMA(a, b, c) = a*b + c  V_LOAD(p)  V_STORE(p, v)
+ *   V_LOADH(p)  VL stored elements at p widened to a VEC of floats
+ *   V_HSUM(v)   sum of the lanes of v
+ *   H2F(h)      one stored element as a float, for the row tails
+ * defined.
+ *
+ * The loops are those of the fp32 kernels with every load of A replaced by
+ * V_LOADH: the conversion is a shift (bf16) or one vcvtph2ps (fp16) on data
+ * already in registers, so A streams at half the bytes and everything after
+ * the load is fp32.  Tails shorter than a vector go through H2F.
+ */
+
+#define HK_CAT_(a, b) a##b
+#define HK_CAT(a, b) HK_CAT_(a, b)
+#define HK_NAME(op) HK_CAT(HK_CAT(l2_, FMT), HK_CAT(op, ISA))
+
+void HK_NAME(gemv_n_)(BLASLONG m, BLASLONG n, float alpha,
+                      const uint16_t *a, BLASLONG lda, const float *x,
+                      BLASLONG incx, float *y, BLASLONG incy) {
+    BLASLONG mv = m & ~(BLASLONG)(VL - 1);
+    BLASLONG j = 0;
+    (void)incy;
+
+    for (; j + 4 <= n; j += 4) {
+        const uint16_t *a0 = a + j * lda, *a1 = a0 + lda;
+        const uint16_t *a2 = a1 + lda,    *a3 = a2 + lda;
+        float t0 = alpha * x[(j + 0) * incx], t1 = alpha * x[(j + 1) * incx];
+        float t2 = alpha * x[(j + 2) * incx], t3 = alpha * x[(j + 3) * incx];
+        VEC b0 = V_SET1(t0), b1 = V_SET1(t1), b2 = V_SET1(t2), b3 = V_SET1(t3);
+        BLASLONG i = 0;
+
+        for (; i + 2 * VL <= m; i += 2 * VL) {
+            VEC y0 = V_LOAD(y + i), y1 = V_LOAD(y + i + VL);
+            y0 = V_FMA(V_LOADH(a0 + i),      b0, y0);
+            y1 = V_FMA(V_LOADH(a0 + i + VL), b0, y1);
+            y0 = V_FMA(V_LOADH(a1 + i),      b1, y0);
+            y1 = V_FMA(V_LOADH(a1 + i + VL), b1, y1);
+            y0 = V_FMA(V_LOADH(a2 + i),      b2, y0);
+            y1 = V_FMA(V_LOADH(a2 + i + VL), b2, y1);
+            y0 = V_FMA(V_LOADH(a3 + i),      b3, y0);
+            y1 = V_FMA(V_LOADH(a3 + i + VL), b3, y1);
+            V_STORE(y + i, y0);
+            V_STORE(y + i + VL, y1);
+        }
+        for (; i < mv; i += VL) {
+            VEC y0 = V_LOAD(y + i);
+            y0 = V_FMA(V_LOADH(a0 + i), b0, y0);
+            y0 = V_FMA(V_LOADH(a1 + i), b1, y0);
+            y0 = V_FMA(V_LOADH(a2 + i), b2, y0);
+            y0 = V_FMA(V_LOADH(a3 + i), b3, y0);
+            V_STORE(y + i, y0);
+        }
+        for (; i < m; i++)
+            y[i] += t0 * H2F(a0[i]) + t1 * H2F(a1[i]) +
+                    t2 * H2F(a2[i]) + t3 * H2F(a3[i]);
+    }
+    for (; j < n; j++) {
+        const uint16_t *a0 = a + j * lda;
+        float t0 = alpha * x[j * incx];
+        VEC b0 = V_SET1(t0);
+        BLASLONG i = 0;
+
+        for (; i < mv; i += VL)
+            V_STORE(y + i, V_FMA(V_LOADH(a0 + i), b0, V_LOAD(y + i)));
+        for (; i < m; i++)
+            y[i] += t0 * H2F(a0[i]);
+    }
+}
+
+void HK_NAME(gemv_t_)(BLASLONG m, BLASLONG n, float alpha,
+                      const uint16_t *a, BLASLONG lda, const float *x,
+                      BLASLONG incx, float *y, BLASLONG incy) {
+    BLASLONG mv = m & ~(BLASLONG)(VL - 1);
+    BLASLONG j = 0;
+    (void)incx;
+
+    for (; j + 4 <= n; j += 4) {
+        const uint16_t *a0 = a + j * lda, *a1 = a0 + lda;
+        const uint16_t *a2 = a1 + lda,    *a3 = a2 + lda;
+        VEC c00 = V_ZERO(), c01 = V_ZERO(), c10 = V_ZERO(), c11 = V_ZERO();
+        VEC c20 = V_ZERO(), c21 = V_ZERO(), c30 = V_ZERO(), c31 = V_ZERO();
+        float s0, s1, s2, s3;
+        BLASLONG i = 0;
+
+        for (; i + 2 * VL <= m; i += 2 * VL) {
+            VEC x0 = V_LOAD(x + i), x1 = V_LOAD(x + i + VL);
+            c00 = V_FMA(V_LOADH(a0 + i),      x0, c00);
+            c01 = V_FMA(V_LOADH(a0 + i + VL), x1, c01);
+            c10 = V_FMA(V_LOADH(a1 + i),      x0, c10);
+            c11 = V_FMA(V_LOADH(a1 + i + VL), x1, c11);
+            c20 = V_FMA(V_LOADH(a2 + i),      x0, c20);
+            c21 = V_FMA(V_LOADH(a2 + i + VL), x1, c21);
+            c30 = V_FMA(V_LOADH(a3 + i),      x0, c30);
+            c31 = V_FMA(V_LOADH(a3 + i + VL), x1, c31);
+        }
+        for (; i < mv; i += VL) {
+            VEC x0 = V_LOAD(x + i);
+            c00 = V_FMA(V_LOADH(a0 + i), x0, c00);
+            c10 = V_FMA(V_LOADH(a1 + i), x0, c10);
+            c20 = V_FMA(V_LOADH(a2 + i), x0, c20);
+            c30 = V_FMA(V_LOADH(a3 + i), x0, c30);
+        }
+        s0 = V_HSUM(c00) + V_HSUM(c01);
+        s1 = V_HSUM(c10) + V_HSUM(c11);
+        s2 = V_HSUM(c20) + V_HSUM(c21);
+        s3 = V_HSUM(c30) + V_HSUM(c31);
+        for (; i < m; i++) {
+            s0 += H2F(a0[i]) * x[i];
+            s1 += H2F(a1[i]) * x[i];
+            s2 += H2F(a2[i]) * x[i];
+            s3 += H2F(a3[i]) * x[i];
+        }
+        y[(j + 0) * incy] += alpha * s0;
+        y[(j + 1) * incy] += alpha * s1;
+        y[(j + 2) * incy] += alpha * s2;
+        y[(j + 3) * incy] += alpha * s3;
+    }
+    for (; j < n; j++) {
+        const uint16_t *a0 = a + j * lda;
+        VEC c0 = V_ZERO();
+        float s0;
+        BLASLONG i = 0;
+
+        for (; i < mv; i += VL)
+            c0 = V_FMA(V_LOADH(a0 + i), V_LOAD(x + i), c0);
+        s0 = V_HSUM(c0);
+        for (; i < m; i++)
+            s0 += H2F(a0[i]) * x[i];
+        y[j * incy] += alpha * s0;
+    }
+}
+
+void HK_NAME(symv_panel_)(BLASLONG m, BLASLONG n, float alpha,
+                          const uint16_t *a, BLASLONG lda,
+                          const float *x1, float *y1,
+                          const float *x2, float *y2) {
+    BLASLONG mv = m & ~(BLASLONG)(VL - 1);
+    BLASLONG j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        const uint16_t *a0 = a + j * lda, *a1 = a0 + lda;
+        const uint16_t *a2 = a1 + lda,    *a3 = a2 + lda;
+        float t0 = alpha * x2[j],     t1 = alpha * x2[j + 1];
+        float t2 = alpha * x2[j + 2], t3 = alpha * x2[j + 3];
+        VEC b0 = V_SET1(t0), b1 = V_SET1(t1), b2 = V_SET1(t2), b3 = V_SET1(t3);
+        VEC c0 = V_ZERO(), c1 = V_ZERO(), c2 = V_ZERO(), c3 = V_ZERO();
+        float s0, s1, s2, s3;
+        BLASLONG i = 0;
+
+        for (; i < mv; i += VL) {
+            VEC xv = V_LOAD(x1 + i), yv = V_LOAD(y1 + i);
+            VEC v0 = V_LOADH(a0 + i), v1 = V_LOADH(a1 + i);
+            VEC v2 = V_LOADH(a2 + i), v3 = V_LOADH(a3 + i);
+            yv = V_FMA(v0, b0, yv);
+            c0 = V_FMA(v0, xv, c0);
+            yv = V_FMA(v1, b1, yv);
+            c1 = V_FMA(v1, xv, c1);
+            yv = V_FMA(v2, b2, yv);
+            c2 = V_FMA(v2, xv, c2);
+            yv = V_FMA(v3, b3, yv);
+            c3 = V_FMA(v3, xv, c3);
+            V_STORE(y1 + i, yv);
+        }
+        s0 = V_HSUM(c0);
+        s1 = V_HSUM(c1);
+        s2 = V_HSUM(c2);
+        s3 = V_HSUM(c3);
+        for (; i < m; i++) {
+            float v0 = H2F(a0[i]), v1 = H2F(a1[i]);
+            float v2 = H2F(a2[i]), v3 = H2F(a3[i]);
+            y1[i] += t0 * v0 + t1 * v1 + t2 * v2 + t3 * v3;
+            s0 += v0 * x1[i];
+            s1 += v1 * x1[i];
+            s2 += v2 * x1[i];
+            s3 += v3 * x1[i];
+        }
+        y2[j]     += alpha * s0;
+        y2[j + 1] += alpha * s1;
+        y2[j + 2] += alpha * s2;
+        y2[j + 3] += alpha * s3;
+    }
+    for (; j < n; j++) {
+        const uint16_t *a0 = a + j * lda;
+        float t0 = alpha * x2[j], s0;
+        VEC b0 = V_SET1(t0), c0 = V_ZERO();
+        BLASLONG i = 0;
+
+        for (; i < mv; i += VL) {
+            VEC v0 = V_LOADH(a0 + i);
+            V_STORE(y1 + i, V_FMA(v0, b0, V_LOAD(y1 + i)));
+            c0 = V_FMA(v0, V_LOAD(x1 + i), c0);
+        }
+        s0 = V_HSUM(c0);
+        for (; i < m; i++) {
+            float v0 = H2F(a0[i]);
+            y1[i] += t0 * v0;
+            s0 += v0 * x1[i];
+        }
+        y2[j] += alpha * s0;
+    }
+}
+
+#undef HK_CAT_
+#undef HK_CAT
+#undef HK_NAME
@@ -0,0 +1,49 @@
+/*
+ * Single-pass Hermitian matrix-vector product (chemv/zhemv): the complex
+ * counterpart of symv.c, run through the complex gemv panels, so on the
+ * SIMD tiers every off-diagonal block is split-complex FMA loops that read
+ * each stored element once.  See hemv_template.h.
+ */
+#include <stddef.h>
+#include <pthread.h>
+#include "l2blas_internal.h"
+
+#define FLOAT float
+#define PREC c
+#define PANEL_KERNEL l2_cgemv_panel_kernel
+#define PANEL_PICK() l2_cgemv_panel_pick()
+#include "hemv_template.h"
+#undef FLOAT
+#undef PREC
+#undef PANEL_KERNEL
+#undef PANEL_PICK
+
+#define FLOAT double
+#define PREC z
+#define PANEL_KERNEL l2_zgemv_panel_kernel
+#define PANEL_PICK() l2_zgemv_panel_pick()
+#include "hemv_template.h"
+#undef FLOAT
+#undef PREC
+#undef PANEL_KERNEL
+#undef PANEL_PICK
+
+void l2_chemv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *a,
+              const blasint lda, const void *x, const blasint incx,
+              const void *beta, void *y, const blasint incy) {
+    int info = l2_symv_check(order, uplo, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_chemv", info); return; }
+    chemv_compute(order, uplo, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+void l2_zhemv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *a,
+              const blasint lda, const void *x, const blasint incx,
+              const void *beta, void *y, const blasint incy) {
+    int info = l2_symv_check(order, uplo, n, lda, incx, incy);
+
+    if (info) { l2_xerbla("l2_zhemv", info); return; }
+    zhemv_compute(order, uplo, n, alpha, a, lda, x, incx, beta, y, incy);
+}
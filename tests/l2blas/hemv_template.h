@@ -0,0 +1,209 @@
+/*
+ * hemv body, included once per precision by hemv.c with
+ *   FLOAT          element type (float or double)
+ *   PREC           name prefix (c, z)
+ *   PANEL_KERNEL   l2_?gemv_panel_kernel
+ *   PANEL_PICK()   l2_?gemv_panel_pick()
+ * defined.
+ *
+ * The stored triangle is walked in L2_CSPLIT_MB-square blocks, exactly as
+ * symv.c walks its triangle: every off-diagonal block is one call to the
+ * complex gemv panel, which reads A(i,j) once for both y(i) += A(i,j)*x(j)
+ * and y(j) += conj(A(i,j))*x(i), and each diagonal block is strips of
+ * HE_STRIP columns: the strip's small triangle, copied out as a full
+ * Hermitian square for one NoTrans panel, plus a panel for the rest of the
+ * strip.  Diagonal imaginary parts are never read.
+ *
+ * Everything is column-major; a RowMajor triangle is the opposite ColMajor
+ * triangle of conj(A), tracked as "cj" (conj1 of the panel; conj2 is
+ * always its opposite).
+ */
+
+#define HE_CAT_(a, b) a##b
+#define HE_CAT(a, b) HE_CAT_(a, b)
+#define HE_FN(name) HE_CAT(PREC, name)
+
+#define HE_STRIP 16
+
+static void HE_FN(hemv_diag)(int lower, int cj, BLASLONG n,
+                             const FLOAT *alpha, const FLOAT *a, BLASLONG lda,
+                             const FLOAT *x, BLASLONG incx, FLOAT *y,
+                             BLASLONG incy, PANEL_KERNEL panel) {
+    FLOAT sq[2 * HE_STRIP * HE_STRIP];
+    FLOAT sg = cj ? -1 : 1;
+
+    for (BLASLONG j = 0; j < n; j += HE_STRIP) {
+        BLASLONG w = L2_MIN(HE_STRIP, n - j);
+        const FLOAT *d = a + 2 * (j + j * lda);
+
+        for (BLASLONG c = 0; c < w; c++) {
+            BLASLONG r0 = lower ? c + 1 : 0, r1 = lower ? w : c;
+
+            sq[2 * (c + c * w)] = d[2 * (c + c * lda)];
+            sq[2 * (c + c * w) + 1] = 0;
+            for (BLASLONG r = r0; r < r1; r++) {
+                const FLOAT *v = d + 2 * (r + c * lda);
+                sq[2 * (r + c * w)] = sq[2 * (c + r * w)] = v[0];
+                sq[2 * (r + c * w) + 1] = sg * v[1];
+                sq[2 * (c + r * w) + 1] = -sg * v[1];
+            }
+        }
+        panel(w, w, alpha, sq, w, NULL, 0, y + 2 * j * incy, incy,
+              x + 2 * j * incx, incx, NULL, 0, 0, 0);
+        if (lower && n - j - w > 0)
+            panel(n - j - w, w, alpha, d + 2 * w, lda,
+                  x + 2 * (j + w) * incx, incx, y + 2 * (j + w) * incy, incy,
+                  x + 2 * j * incx, incx, y + 2 * j * incy, incy, cj, !cj);
+        else if (!lower && j > 0)
+            panel(j, w, alpha, a + 2 * j * lda, lda, x, incx, y, incy,
+                  x + 2 * j * incx, incx, y + 2 * j * incy, incy, cj, !cj);
+    }
+}
+
+static void HE_FN(hemv_blocked)(int lower, int cj, BLASLONG n,
+                                const FLOAT *alpha, const FLOAT *a,
+                                BLASLONG lda, const FLOAT *x, BLASLONG incx,
+                                FLOAT *y, BLASLONG incy) {
+    const BLASLONG nb = L2_CSPLIT_MB(FLOAT);
+    PANEL_KERNEL panel = PANEL_PICK();
+
+    for (BLASLONG j0 = 0; j0 < n; j0 += nb) {
+        BLASLONG jb = L2_MIN(nb, n - j0);
+        BLASLONG i_begin = lower ? j0 + jb : 0, i_end = lower ? n : j0;
+        const FLOAT *xj = x + 2 * j0 * incx;
+        FLOAT *yj = y + 2 * j0 * incy;
+
+        HE_FN(hemv_diag)(lower, cj, jb, alpha, a + 2 * (j0 + j0 * lda), lda,
+                         xj, incx, yj, incy, panel);
+        for (BLASLONG i0 = i_begin; i0 < i_end; i0 += nb) {
+            BLASLONG ib = L2_MIN(nb, i_end - i0);
+            panel(ib, jb, alpha, a + 2 * (i0 + j0 * lda), lda,
+                  x + 2 * i0 * incx, incx, y + 2 * i0 * incy, incy,
+                  xj, incx, yj, incy, cj, !cj);
+        }
+    }
+}
+
+/*
+ * Threaded: slots take column blocks of equal cost (l2_tri_split) and walk
+ * them as hemv_blocked does into unit-stride stack tiles, the block
+ * column's y and the block row's, each added into y under the region's
+ * lock once its panel is done.  Those additions come in thread order, so
+ * threaded results can differ in the last bits from run to run.
+ */
+typedef struct {
+    int lower, cj;
+    BLASLONG n, lda, incx, incy;
+    const FLOAT *alpha, *a, *x;
+    FLOAT *y;
+    PANEL_KERNEL panel;
+    pthread_mutex_t lock;
+} HE_FN(hemv_mt_args);
+
+static void HE_FN(hemv_merge)(HE_FN(hemv_mt_args) *p, BLASLONG i0,
+                              const FLOAT *t, BLASLONG len) {
+    FLOAT *y = p->y + 2 * i0 * p->incy;
+
+    pthread_mutex_lock(&p->lock);
+    for (BLASLONG i = 0; i < len; i++) {
+        y[2 * i * p->incy] += t[2 * i];
+        y[2 * i * p->incy + 1] += t[2 * i + 1];
+    }
+    pthread_mutex_unlock(&p->lock);
+}
+
+static void HE_FN(hemv_worker)(int tid, int nthreads, void *arg) {
+    HE_FN(hemv_mt_args) *p = arg;
+    const BLASLONG nb = L2_CSPLIT_MB(FLOAT);
+    BLASLONG align = 64 / (2 * (BLASLONG)sizeof(FLOAT));
+    BLASLONG cost = L2_TRI_LINE_BYTES / (2 * (BLASLONG)sizeof(FLOAT));
+    BLASLONG c0 = l2_tri_split(p->n, !p->lower, cost, tid, nthreads, align);
+    BLASLONG c1 = l2_tri_split(p->n, !p->lower, cost, tid + 1, nthreads,
+                               align);
+    FLOAT yc[2 * L2_CSPLIT_MB(FLOAT)], yr[2 * L2_CSPLIT_MB(FLOAT)];
+
+    for (BLASLONG j0 = c0; j0 < c1; j0 += nb) {
+        BLASLONG jb = L2_MIN(nb, c1 - j0);
+        BLASLONG i_begin = p->lower ? j0 + jb : 0;
+        BLASLONG i_end = p->lower ? p->n : j0;
+        const FLOAT *aj = p->a + 2 * j0 * p->lda;
+        const FLOAT *xj = p->x + 2 * j0 * p->incx;
+
+        for (BLASLONG k = 0; k < 2 * jb; k++) yc[k] = 0;
+        HE_FN(hemv_diag)(p->lower, p->cj, jb, p->alpha, aj + 2 * j0, p->lda,
+                         xj, p->incx, yc, 1, p->panel);
+        for (BLASLONG i0 = i_begin; i0 < i_end; i0 += nb) {
+            BLASLONG ib = L2_MIN(nb, i_end - i0);
+            for (BLASLONG k = 0; k < 2 * ib; k++) yr[k] = 0;
+            p->panel(ib, jb, p->alpha, aj + 2 * i0, p->lda,
+                     p->x + 2 * i0 * p->incx, p->incx, yr, 1,
+                     xj, p->incx, yc, 1, p->cj, !p->cj);
+            HE_FN(hemv_merge)(p, i0, yr, ib);
+        }
+        HE_FN(hemv_merge)(p, j0, yc, jb);
+    }
+}
+
+/* hemv_blocked on as many threads as the triangle is worth. */
+static void HE_FN(hemv_run)(int lower, int cj, BLASLONG n,
+                            const FLOAT *alpha, const FLOAT *a, BLASLONG lda,
+                            const FLOAT *x, BLASLONG incx, FLOAT *y,
+                            BLASLONG incy) {
+    HE_FN(hemv_mt_args) p;
+    int nthreads = l2_get_num_threads();
+    double work = (double)n * (double)(n + 1);
+
+    if (nthreads < 2 || work < 2.0 * L2_SYMV_MIN_WORK) {
+        HE_FN(hemv_blocked)(lower, cj, n, alpha, a, lda, x, incx, y, incy);
+        return;
+    }
+    p.lower = lower;
+    p.cj = cj;
+    p.n = n;
+    p.lda = lda;
+    p.incx = incx;
+    p.incy = incy;
+    p.alpha = alpha;
+    p.a = a;
+    p.x = x;
+    p.y = y;
+    p.panel = PANEL_PICK();
+    pthread_mutex_init(&p.lock, NULL);
+    nthreads = (int)L2_MIN((double)nthreads, work / L2_SYMV_MIN_WORK);
+    l2_parallel(nthreads, HE_FN(hemv_worker), &p);
+    pthread_mutex_destroy(&p.lock);
+}
+
+static void HE_FN(hemv_compute)(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                                BLASLONG n, const FLOAT *alpha,
+                                const FLOAT *a, BLASLONG lda, const FLOAT *x,
+                                BLASLONG incx, const FLOAT *beta, FLOAT *y,
+                                BLASLONG incy) {
+    int alpha0 = alpha[0] == 0 && alpha[1] == 0;
+    int lower;
+
+    if (n == 0 || (alpha0 && beta[0] == 1 && beta[1] == 0)) return;
+
+    x = L2_VEC_BASE(x, n, 2 * incx);
+    y = L2_VEC_BASE(y, n, 2 * incy);
+    if (beta[0] != 1 || beta[1] != 0) {
+        for (BLASLONG i = 0; i < n; i++) {
+            FLOAT *yi = y + 2 * i * incy;
+            if (beta[0] == 0 && beta[1] == 0) {
+                yi[0] = 0;
+                yi[1] = 0;
+            } else {
+                FLOAT r = beta[0] * yi[0] - beta[1] * yi[1];
+                yi[1] = beta[0] * yi[1] + beta[1] * yi[0];
+                yi[0] = r;
+            }
+        }
+    }
+    if (alpha0) return;
+
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    HE_FN(hemv_run)(lower, order == CblasRowMajor, n, alpha, a, lda, x,
+                    incx, y, incy);
+}
+
+#undef HE_STRIP
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "l2blas_internal.h"
+
+static const char *core_names[] = {"generic", "avx2", "avx512"};
+
+static pthread_once_t core_once = PTHREAD_ONCE_INIT;
+static int core_detected = L2_CORE_GENERIC;
+static int core_current  = L2_CORE_GENERIC;
+
+static int core_from_name(const char *name) {
+    for (int i = 0; i < (int)(sizeof(core_names) / sizeof(core_names[0])); i++)
+        if (strcmp(name, core_names[i]) == 0) return i;
+    return -1;
+}
+
+static void core_detect(void) {
+    const char *env;
+    int forced;
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        core_detected = L2_CORE_AVX512;
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        core_detected = L2_CORE_AVX2;
+    else
+        core_detected = L2_CORE_GENERIC;
+    core_current = core_detected;
+
+    env = getenv("L2BLAS_CORE");
+    if (env && *env && strcmp(env, "auto") != 0) {
+        forced = core_from_name(env);
+        if (forced >= 0 && forced <= core_detected)
+            core_current = forced;
+        else
+            fprintf(stderr, "l2blas: ignoring L2BLAS_CORE=%s (using %s)\n",
+                    env, core_names[core_detected]);
+    }
+}
+
+int l2_core(void) {
+    pthread_once(&core_once, core_detect);
+    return core_current;
+}
+
+const char *l2_get_corename(void) {
+    return core_names[l2_core()];
+}
+
+int l2_set_core(const char *name) {
+    int c;
+
+    pthread_once(&core_once, core_detect);
+    if (!name || strcmp(name, "auto") == 0) {
+        core_current = core_detected;
+        return 0;
+    }
+    c = core_from_name(name);
+    if (c < 0 || c > core_detected) return -1;
+    core_current = c;
+    return 0;
+}
+
+void l2_xerbla(const char *rname, int info) {
+    fprintf(stderr, " ** On entry to %s parameter number %d had an illegal value\n",
+            rname, info);
+}
@@ -0,0 +1,881 @@
+/*
+ * l2blas - project-owned CBLAS Level 2 kernels.
+ *
+ * Every l2_?xxx entry point takes exactly the arguments of the cblas_?xxx
+ * routine of the same name, so it can be swapped in for the OpenBLAS call
+ * (see l2blas_cblas.h).  Kernels are selected at runtime from CPUID; the
+ * L2BLAS_CORE environment variable or l2_set_core() can force a lower tier.
+ */
+#ifndef L2BLAS_H
+#define L2BLAS_H
+
+#include <cblas.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Name of the kernel tier in use: "generic", "avx2" or "avx512". */
+const char *l2_get_corename(void);
+
+/*
+ * Force a kernel tier by name; NULL or "auto" restores the CPUID choice.
+ * Returns 0 on success, -1 if the name is unknown or the CPU lacks the ISA.
+ * Not safe to call while other threads are inside l2blas.
+ */
+int l2_set_core(const char *name);
+
+/*
+ * Threads used by the multithreaded l2blas routines.  The default comes from
+ * L2BLAS_NUM_THREADS, then OPENBLAS_NUM_THREADS, then the online CPU count.
+ */
+void l2_set_num_threads(int n);
+int l2_get_num_threads(void);
+
+/*
+ * How threaded triangular routines (syr, syr2, her, her2, symv, hemv, trmv,
+ * the sy/he accumulator flush) split the triangle: AREA (the default) gives
+ * every thread the same number of elements, in column (or, for trmv, row)
+ * blocks bounded on whole cache lines; EVEN gives every thread the same
+ * number of columns, so the thread with the long ones does about twice the
+ * mean work.  EVEN is there to measure against.  Not safe to call while
+ * other threads are inside l2blas.
+ */
+enum L2_TRI_SPLIT { L2_SPLIT_AREA = 0, L2_SPLIT_EVEN = 1 };
+void l2_set_tri_split(enum L2_TRI_SPLIT mode);
+
+/*
+ * The split itself: bound k (0 <= k <= nparts) of the n rows or columns
+ * ("lines") of a triangle cut into nparts blocks.  Line i holds i + 1
+ * elements when grows is set and n - i otherwise, and costs line_cost
+ * elements more to start, so under AREA block k of a growing triangle
+ * with line_cost 0 starts at n * sqrt(k / nparts).  Bounds are rounded to
+ * multiples of align (whole cache lines of the vectors, or of A's columns
+ * for row splits) and are monotone in k; bound 0 is 0 and bound nparts n.
+ */
+BLASLONG l2_tri_split(BLASLONG n, int grows, BLASLONG line_cost, int k,
+                      int nparts, BLASLONG align);
+
+/*
+ * Per-slot busy time of threaded routines.  With l2_set_slot_timing(1),
+ * every parallel region records the thread CPU seconds each of its slots
+ * took; l2_get_slot_times copies those of the calling thread's last region
+ * into sec (at most max) and returns the slot count, 0 if none was timed.
+ * A routine that ran single-threaded reports one slot.
+ */
+void l2_set_slot_timing(int on);
+int l2_get_slot_times(double *sec, int max);
+
+/*
+ * The l2blas pool as an OpenBLAS threading backend.  l2_openblas_threads has
+ * the signature of cblas.h's openblas_threads_callback: it runs the numjobs
+ * jobs on the pool, job i as dojob(i, jobdata + i * jobdata_elsize,
+ * dojob_data), and returns when all are done.  Jobs become independent pool
+ * tasks, not one thread each, which suits the Level 2 drivers; OpenBLAS
+ * drivers whose jobs wait on one another (Level 3) need a thread per job.
+ *
+ * l2_set_openblas_threads(1) registers it through
+ * openblas_set_threads_callback_function, so OpenBLAS parallel regions run
+ * on the same workers as l2blas instead of OpenBLAS' own threads; (0) goes
+ * back to those.  Returns 0, or -1 if the linked OpenBLAS has no such hook.
+ */
+typedef void (*l2_dojob_fn)(int thread_num, void *jobdata, int dojob_data);
+void l2_openblas_threads(int sync, l2_dojob_fn dojob, int numjobs,
+                         size_t jobdata_elsize, void *jobdata, int dojob_data);
+int l2_set_openblas_threads(int on);
+
+/*
+ * Placement of OpenBLAS' threads for bandwidth-bound work on NUMA machines
+ * (Linux).  A threaded gemv gives OpenBLAS thread k the k-th block of y;
+ * l2_set_placement pins the thread of each block to one CPU, filling node
+ * after node (COMPACT) or taking the nodes in turn (SPREAD), or unpins them
+ * all (NONE).  The calling thread runs block 0 and is pinned too, and stays
+ * pinned for everything it does afterwards, not only gemv, until
+ * l2_set_placement(L2_PLACE_NONE) gives it back the CPUs the process
+ * started with; call it from a thread that only drives BLAS, or undo it.
+ * Call it again after openblas_set_num_threads.  Returns 0, or -1 if a
+ * thread could not be placed.
+ *
+ * l2_first_touch zeroes A (m x n, elements of elsize bytes) with each gemv
+ * block of the given order/trans written by a thread on that block's CPU,
+ * so under a first-touch page policy every block is local to the thread
+ * that will stream it.  Call it on freshly allocated, untouched memory.
+ * The blocks are those of OpenBLAS's gemv_thread.c (y shared evenly, at
+ * least 4 per block), copied, not queried: an OpenBLAS that splits
+ * differently leaves A zeroed but on the wrong nodes.  Below OpenBLAS's
+ * threading threshold (m * n < 2304 * 4) the gemv runs on the caller, and
+ * the caller touches all of A.
+ *
+ * l2_get_placement_cpu: CPU of a gemv block, -1 if unpinned.
+ * l2_cpu_node: NUMA node of a CPU (its socket if the kernel exposes none).
+ */
+enum L2_PLACEMENT { L2_PLACE_NONE = 0, L2_PLACE_COMPACT = 1,
+                    L2_PLACE_SPREAD = 2 };
+int l2_set_placement(enum L2_PLACEMENT policy);
+int l2_get_placement_cpu(int block);
+int l2_cpu_node(int cpu);
+void l2_first_touch(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                    blasint m, blasint n, void *a, blasint lda,
+                    size_t elsize);
+
+void l2_sgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const float alpha,
+              const float *a, const blasint lda, const float *x,
+              const blasint incx, const float beta, float *y,
+              const blasint incy);
+void l2_dgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const double alpha,
+              const double *a, const blasint lda, const double *x,
+              const blasint incx, const double beta, double *y,
+              const blasint incy);
+
+void l2_cgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const void *alpha,
+              const void *a, const blasint lda, const void *x,
+              const blasint incx, const void *beta, void *y,
+              const blasint incy);
+void l2_zgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const void *alpha,
+              const void *a, const blasint lda, const void *x,
+              const blasint incx, const void *beta, void *y,
+              const blasint incy);
+
+/*
+ * Batched gemv, grouped form (the layout of cblas_?gemm_batch): group g
+ * holds group_size[g] problems sharing trans_array[g], m_array[g], ...,
+ * beta_array[g]; the a/x/y pointer arrays list the problems of all groups
+ * back to back.  For c/z, alpha_array and beta_array hold one complex value
+ * per group.  The batch is spread over l2_get_num_threads() threads, whole
+ * problems per thread, so the y vectors must not overlap.
+ */
+void l2_sgemv_batch(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const float *alpha_array, const float **a_array,
+                    const blasint *lda_array, const float **x_array,
+                    const blasint *incx_array, const float *beta_array,
+                    float **y_array, const blasint *incy_array,
+                    const blasint group_count, const blasint *group_size);
+void l2_dgemv_batch(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const double *alpha_array, const double **a_array,
+                    const blasint *lda_array, const double **x_array,
+                    const blasint *incx_array, const double *beta_array,
+                    double **y_array, const blasint *incy_array,
+                    const blasint group_count, const blasint *group_size);
+void l2_cgemv_batch(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const void *alpha_array, const void **a_array,
+                    const blasint *lda_array, const void **x_array,
+                    const blasint *incx_array, const void *beta_array,
+                    void **y_array, const blasint *incy_array,
+                    const blasint group_count, const blasint *group_size);
+void l2_zgemv_batch(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE *trans_array,
+                    const blasint *m_array, const blasint *n_array,
+                    const void *alpha_array, const void **a_array,
+                    const blasint *lda_array, const void **x_array,
+                    const blasint *incx_array, const void *beta_array,
+                    void **y_array, const blasint *incy_array,
+                    const blasint group_count, const blasint *group_size);
+
+/*
+ * Batched gemv, strided form: problem i uses a + i*stride_a, x + i*stride_x
+ * and y + i*stride_y (strides in elements, complex elements for c/z) with
+ * one set of scalar arguments.
+ */
+void l2_sgemv_batch_strided(const enum CBLAS_ORDER order,
+                            const enum CBLAS_TRANSPOSE trans,
+                            const blasint m, const blasint n,
+                            const float alpha, const float *a,
+                            const blasint lda, const BLASLONG stride_a,
+                            const float *x, const blasint incx,
+                            const BLASLONG stride_x, const float beta,
+                            float *y, const blasint incy,
+                            const BLASLONG stride_y,
+                            const blasint batch_count);
+void l2_dgemv_batch_strided(const enum CBLAS_ORDER order,
+                            const enum CBLAS_TRANSPOSE trans,
+                            const blasint m, const blasint n,
+                            const double alpha, const double *a,
+                            const blasint lda, const BLASLONG stride_a,
+                            const double *x, const blasint incx,
+                            const BLASLONG stride_x, const double beta,
+                            double *y, const blasint incy,
+                            const BLASLONG stride_y,
+                            const blasint batch_count);
+void l2_cgemv_batch_strided(const enum CBLAS_ORDER order,
+                            const enum CBLAS_TRANSPOSE trans,
+                            const blasint m, const blasint n,
+                            const void *alpha, const void *a,
+                            const blasint lda, const BLASLONG stride_a,
+                            const void *x, const blasint incx,
+                            const BLASLONG stride_x, const void *beta,
+                            void *y, const blasint incy,
+                            const BLASLONG stride_y,
+                            const blasint batch_count);
+void l2_zgemv_batch_strided(const enum CBLAS_ORDER order,
+                            const enum CBLAS_TRANSPOSE trans,
+                            const blasint m, const blasint n,
+                            const void *alpha, const void *a,
+                            const blasint lda, const BLASLONG stride_a,
+                            const void *x, const blasint incx,
+                            const BLASLONG stride_x, const void *beta,
+                            void *y, const blasint incy,
+                            const BLASLONG stride_y,
+                            const blasint batch_count);
+
+void l2_ssymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const float alpha, const float *a,
+              const blasint lda, const float *x, const blasint incx,
+              const float beta, float *y, const blasint incy);
+void l2_dsymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const double alpha, const double *a,
+              const blasint lda, const double *x, const blasint incx,
+              const double beta, double *y, const blasint incy);
+
+/*
+ * Hermitian: the imaginary parts of the diagonal are not read.  Threaded
+ * symv and hemv sum each thread's share of y into y as it finishes, so
+ * with more than one thread the last bits of y can vary between runs.
+ */
+void l2_chemv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *a,
+              const blasint lda, const void *x, const blasint incx,
+              const void *beta, void *y, const blasint incy);
+void l2_zhemv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *a,
+              const blasint lda, const void *x, const blasint incx,
+              const void *beta, void *y, const blasint incy);
+
+void l2_strsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const float *a, const blasint lda, float *x,
+              const blasint incx);
+void l2_dtrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const double *a, const blasint lda, double *x,
+              const blasint incx);
+void l2_ctrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *a, const blasint lda, void *x,
+              const blasint incx);
+void l2_ztrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *a, const blasint lda, void *x,
+              const blasint incx);
+
+/*
+ * x := op(A) * x in place, blocked like trsv: gemv panels off the diagonal,
+ * no heap allocation at any size or increment.  Threaded calls hold one
+ * band of products in a stack buffer (L2_TRMV_BAND_BYTES) until the band's
+ * x is no longer read.
+ */
+void l2_strmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const float *a, const blasint lda, float *x,
+              const blasint incx);
+void l2_dtrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const double *a, const blasint lda, double *x,
+              const blasint incx);
+void l2_ctrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *a, const blasint lda, void *x,
+              const blasint incx);
+void l2_ztrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *a, const blasint lda, void *x,
+              const blasint incx);
+
+/*
+ * Workspace arena for callers on a latency budget.  l2_arena_init lays an
+ * arena out in the caller's work of lwork bytes (L2_ARENA_LWORK(n) stages
+ * vectors of up to n elements of any precision) and starts every pool
+ * worker the current l2_get_num_threads() can use.  From then on the
+ * l2_?xxx_arena routines below allocate nothing and start no thread; they
+ * take the arguments of the cblas routine after the arena.  A strided x or
+ * y is copied into the arena and back, so the call runs the unit-stride
+ * code (SIMD gemv and symv kernels, blocked trsv and trmv) in place of the
+ * scalar strided loops.  Longer vectors, or a work too small for any, take
+ * the plain routine's strided path, still without allocating.
+ *
+ * One arena serves one call at a time: one per application thread.  The
+ * pool is reserved for the thread count at init; raise it before then.
+ * The fields are private.
+ */
+typedef struct {
+    void *x, *y;
+    size_t cap;         /* bytes each of x and y holds */
+} l2_arena;
+
+#define L2_ARENA_LWORK(n) \
+    (2 * ((2 * sizeof(double) * (size_t)(n) + 63) & ~(size_t)63) + 64)
+
+void l2_arena_init(l2_arena *ar, void *work, const size_t lwork);
+
+void l2_sgemv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE trans, const blasint m,
+                    const blasint n, const float alpha, const float *a,
+                    const blasint lda, const float *x, const blasint incx,
+                    const float beta, float *y, const blasint incy);
+void l2_dgemv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE trans, const blasint m,
+                    const blasint n, const double alpha, const double *a,
+                    const blasint lda, const double *x, const blasint incx,
+                    const double beta, double *y, const blasint incy);
+void l2_cgemv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE trans, const blasint m,
+                    const blasint n, const void *alpha, const void *a,
+                    const blasint lda, const void *x, const blasint incx,
+                    const void *beta, void *y, const blasint incy);
+void l2_zgemv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE trans, const blasint m,
+                    const blasint n, const void *alpha, const void *a,
+                    const blasint lda, const void *x, const blasint incx,
+                    const void *beta, void *y, const blasint incy);
+
+void l2_ssymv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo, const blasint n,
+                    const float alpha, const float *a, const blasint lda,
+                    const float *x, const blasint incx, const float beta,
+                    float *y, const blasint incy);
+void l2_dsymv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo, const blasint n,
+                    const double alpha, const double *a, const blasint lda,
+                    const double *x, const blasint incx, const double beta,
+                    double *y, const blasint incy);
+void l2_chemv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo, const blasint n,
+                    const void *alpha, const void *a, const blasint lda,
+                    const void *x, const blasint incx, const void *beta,
+                    void *y, const blasint incy);
+void l2_zhemv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo, const blasint n,
+                    const void *alpha, const void *a, const blasint lda,
+                    const void *x, const blasint incx, const void *beta,
+                    void *y, const blasint incy);
+
+void l2_strsv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const float *a, const blasint lda, float *x,
+                    const blasint incx);
+void l2_dtrsv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const double *a, const blasint lda, double *x,
+                    const blasint incx);
+void l2_ctrsv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const void *a, const blasint lda, void *x,
+                    const blasint incx);
+void l2_ztrsv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const void *a, const blasint lda, void *x,
+                    const blasint incx);
+
+void l2_strmv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const float *a, const blasint lda, float *x,
+                    const blasint incx);
+void l2_dtrmv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const double *a, const blasint lda, double *x,
+                    const blasint incx);
+void l2_ctrmv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const void *a, const blasint lda, void *x,
+                    const blasint incx);
+void l2_ztrmv_arena(l2_arena *ar, const enum CBLAS_ORDER order,
+                    const enum CBLAS_UPLO uplo,
+                    const enum CBLAS_TRANSPOSE trans,
+                    const enum CBLAS_DIAG diag, const blasint n,
+                    const void *a, const blasint lda, void *x,
+                    const blasint incx);
+
+/*
+ * Out-of-core gemv for a matrix kept in a file, e.g. one larger than RAM.
+ * A is the cblas_?gemv matrix (order, m, n, lda) whose first element is at
+ * byte offset (a multiple of the element size) of the open file fd;
+ * everything else is as in cblas_?gemv.
+ * The file is mapped and read front to back once, a panel of whole stored
+ * rows or columns at a time, the next panel read ahead (MADV_WILLNEED)
+ * while the current one is computed; panels done are unmapped.  Results
+ * match cblas_?gemv up to rounding.
+ *
+ * Returns 0, or -1 with errno set: EINVAL for illegal arguments (also
+ * reported through xerbla, with fd and offset as parameters 6 and 7) or a
+ * file too short for A, otherwise the error of fstat or mmap.  After a
+ * failure y is undefined.  POSIX only; ENOSYS elsewhere.
+ *
+ * l2_set_stream_panel sets the panel size in bytes (rounded down to whole
+ * stored lines, at least one); 0 restores the default of 64 MB.
+ * l2_set_stream_evict sets how large A (in bytes, from its first to its
+ * last element) must be for panels done to be dropped from the page cache
+ * as well, so that a pass over a file larger than RAM does not evict
+ * everything else; a smaller A stays cached for the next call.  0 restores
+ * the default of half the physical RAM, SIZE_MAX never drops.
+ */
+int l2_sgemv_mapped(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE trans, const blasint m,
+                    const blasint n, const float alpha, const int fd,
+                    const BLASLONG offset, const blasint lda, const float *x,
+                    const blasint incx, const float beta, float *y,
+                    const blasint incy);
+int l2_dgemv_mapped(const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE trans, const blasint m,
+                    const blasint n, const double alpha, const int fd,
+                    const BLASLONG offset, const blasint lda,
+                    const double *x, const blasint incx, const double beta,
+                    double *y, const blasint incy);
+void l2_set_stream_panel(size_t bytes);
+void l2_set_stream_evict(size_t bytes);
+
+void l2_sger(const enum CBLAS_ORDER order, const blasint m, const blasint n,
+             const float alpha, const float *x, const blasint incx,
+             const float *y, const blasint incy, float *a, const blasint lda);
+void l2_dger(const enum CBLAS_ORDER order, const blasint m, const blasint n,
+             const double alpha, const double *x, const blasint incx,
+             const double *y, const blasint incy, double *a,
+             const blasint lda);
+
+void l2_cgeru(const enum CBLAS_ORDER order, const blasint m,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda);
+void l2_cgerc(const enum CBLAS_ORDER order, const blasint m,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda);
+void l2_zgeru(const enum CBLAS_ORDER order, const blasint m,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda);
+void l2_zgerc(const enum CBLAS_ORDER order, const blasint m,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda);
+
+/*
+ * Rank-1 and rank-2 updates of the uplo triangle, the latter in one pass
+ * over it.  Hermitian: the imaginary parts of the diagonal are set to zero.
+ */
+void l2_ssyr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const float alpha, const float *x,
+             const blasint incx, float *a, const blasint lda);
+void l2_dsyr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const double alpha, const double *x,
+             const blasint incx, double *a, const blasint lda);
+void l2_cher(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const float alpha, const void *x,
+             const blasint incx, void *a, const blasint lda);
+void l2_zher(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const double alpha, const void *x,
+             const blasint incx, void *a, const blasint lda);
+
+void l2_ssyr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const float alpha, const float *x,
+              const blasint incx, const float *y, const blasint incy,
+              float *a, const blasint lda);
+void l2_dsyr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const double alpha, const double *x,
+              const blasint incx, const double *y, const blasint incy,
+              double *a, const blasint lda);
+
+void l2_cher2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda);
+void l2_zher2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda);
+
+/*
+ * Reduced-precision storage with fp32 arithmetic.  A and x are stored as
+ * bf16 (l2_sb*, OpenBLAS' bfloat16: 8 significant bits) or IEEE fp16
+ * (l2_sh*: 11 bits, |v| <= 65504); alpha, beta and y are float and every
+ * product and sum is fp32.  l2_sbgemv takes the arguments of cblas_sbgemv;
+ * the others follow it.  trmv overwrites a float x.
+ *
+ * Error bound: with k the terms of one element (n for NoTrans gemv, m for
+ * Trans, n for symv and trmv) and u = 2^-24, each y(i) differs from the
+ * exact result computed from the stored A and x by at most
+ *
+ *     (k + 2) * u * (|alpha| * sum_j |A(i,j)| |x(j)| + |beta| |y(i)|)
+ *
+ * Rounding float data to the storage format first costs each of A and x a
+ * relative 2^-8 (bf16) or 2^-11 (fp16, inside its normal range), so against
+ * the float data add 2^-7 resp. 2^-10 (plus their squares) times |A||x|.
+ */
+typedef uint16_t l2_fp16;
+
+void l2_sbgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+               const blasint m, const blasint n, const float alpha,
+               const bfloat16 *a, const blasint lda, const bfloat16 *x,
+               const blasint incx, const float beta, float *y,
+               const blasint incy);
+void l2_shgemv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+               const blasint m, const blasint n, const float alpha,
+               const l2_fp16 *a, const blasint lda, const l2_fp16 *x,
+               const blasint incx, const float beta, float *y,
+               const blasint incy);
+
+void l2_sbsymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const blasint n, const float alpha, const bfloat16 *a,
+               const blasint lda, const bfloat16 *x, const blasint incx,
+               const float beta, float *y, const blasint incy);
+void l2_shsymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const blasint n, const float alpha, const l2_fp16 *a,
+               const blasint lda, const l2_fp16 *x, const blasint incx,
+               const float beta, float *y, const blasint incy);
+
+void l2_sbtrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+               const blasint n, const bfloat16 *a, const blasint lda,
+               float *x, const blasint incx);
+void l2_shtrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+               const blasint n, const l2_fp16 *a, const blasint lda,
+               float *x, const blasint incx);
+
+/*
+ * float <-> bf16 and float <-> fp16, as cblas_sbstobf16 / cblas_sbf16tos
+ * (which OpenBLAS only exports when built with BUILD_BFLOAT16): round to
+ * nearest even, overflow to infinity, subnormals kept, NaN stays NaN.
+ */
+void l2_sbstobf16(const blasint n, const float *in, const blasint incin,
+                  bfloat16 *out, const blasint incout);
+void l2_sbf16tos(const blasint n, const bfloat16 *in, const blasint incin,
+                 float *out, const blasint incout);
+void l2_shstofp16(const blasint n, const float *in, const blasint incin,
+                  l2_fp16 *out, const blasint incout);
+void l2_shfp16tos(const blasint n, const l2_fp16 *in, const blasint incin,
+                  float *out, const blasint incout);
+
+/*
+ * int8 weights.  l2_sq8_quantize stores an m x n float A (order and lda as
+ * for cblas_sgemv) once as int8 with float scales in the caller's workspace
+ * of lwork >= L2_Q8_LWORK(m, n, block) bytes; l2_sq8gemv then computes
+ * y := alpha * op(A) * x + beta * y from it as often as needed, with the
+ * trans, x and y conventions of cblas_sgemv.  A itself is not kept.
+ *
+ * block = 0 gives every row of A one scale, otherwise each row is cut into
+ * blocks of block columns (a multiple of 32) with a scale each; a block's
+ * scale s is its largest |A(i,j)| / 127 and A(i,j) ~ s * round(A(i,j) / s).
+ *
+ * acc chooses the NoTrans arithmetic.  L2_Q8_INT32 rounds x to int8 the
+ * same way, one scale sx per chunk of up to 4096 elements, and accumulates
+ * the int8 products exactly in int32 (VNNI vpdpbusd, or AVX2 vpmaddubsw);
+ * L2_Q8_FP32 widens A to float and keeps x as it is.  Trans always uses
+ * fp32: the row scales do not factor out of a column sum.  Besides float
+ * rounding, y(i) differs from alpha * sum_j A(i,j) x(j) + beta y(i) by at
+ * most
+ *
+ *     |alpha| * sum_j (s_ij |x(j)| + (|A(i,j)| + s_ij / 2) * sx_j) / 2
+ *
+ * with s_ij the scale of A(i,j), the sum running over op(A)'s row, and
+ * sx_j = 0 for fp32 accumulation.  The bound is for finite data.  A chunk
+ * of x holding a NaN or an infinity is accumulated in fp32, so it reaches
+ * y as in sgemv.  A block of A holding one quantizes to a NaN scale: NoTrans
+ * gives NaN in that row of y and Trans in all of that block's columns.
+ *
+ * A failed quantize sets m to -1, which l2_sq8gemv reports as an illegal
+ * parameter 4.  The fields are private.
+ */
+enum L2_Q8_ACC { L2_Q8_INT32 = 0, L2_Q8_FP32 = 1 };
+
+typedef struct {
+    BLASLONG m, n, ldq, block, lds;
+    int8_t *q;
+    float *scale;
+} l2_sq8mat;
+
+#define L2_Q8_LDQ(n) (((size_t)(n) + 63) / 64 * 64)
+#define L2_Q8_NBLOCKS(n, block) \
+    ((block) > 0 ? ((size_t)(n) + (block) - 1) / (block) : (size_t)1)
+#define L2_Q8_LWORK(m, n, block) \
+    ((size_t)(m) * (L2_Q8_LDQ(n) + sizeof(float) * L2_Q8_NBLOCKS(n, block)))
+
+void l2_sq8_quantize(l2_sq8mat *qa, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, const float *a,
+                     const blasint lda, const blasint block, void *work,
+                     const size_t lwork);
+void l2_sq8gemv(const enum CBLAS_TRANSPOSE trans, const enum L2_Q8_ACC acc,
+                const float alpha, const l2_sq8mat *qa, const float *x,
+                const blasint incx, const float beta, float *y,
+                const blasint incy);
+
+/*
+ * Deferred rank-k accumulation.  An l2_acc queues rank-1 and rank-2
+ * updates of one matrix A and applies them together on flush, as one
+ * blocked pass A += U * V^T, so k queued updates read and write A once
+ * instead of k times.  The vectors are copied into the caller's workspace
+ * when queued (x and y may be reused at once); A must not be touched until
+ * the next flush.  An update that finds the workspace full flushes first,
+ * and an acc dropped without a flush simply discards its queue.
+ *
+ * work holds lwork elements (complex elements for c/z); L2_ACC_LWORK gives
+ * the size for k queued rank-1 updates, a rank-2 update counting as two.
+ * _ge accs take ger/geru/gerc, _sy accs syr/syr2 and _he accs her/her2 on
+ * the uplo triangle only, zeroing the imaginary parts of the diagonal as
+ * cher does.  Results equal the sequence of cblas calls up to rounding:
+ * the k terms per element are summed in a different order.
+ *
+ * The fields are private.
+ */
+typedef struct {
+    char prec, kind;
+    int swap, lower;
+    BLASLONG m, n, lda, cap, k;
+    void *a, *u, *v;
+} l2_acc;
+
+#define L2_ACC_LWORK(m, n, k) ((k) * ((m) + (n)))
+
+void l2_sacc_init_ge(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, float *a,
+                     const blasint lda, float *work, const blasint lwork);
+void l2_sacc_init_sy(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const enum CBLAS_UPLO uplo, const blasint n, float *a,
+                     const blasint lda, float *work, const blasint lwork);
+void l2_sacc_ger(l2_acc *acc, const float alpha, const float *x,
+                 const blasint incx, const float *y, const blasint incy);
+void l2_sacc_syr(l2_acc *acc, const float alpha, const float *x,
+                 const blasint incx);
+void l2_sacc_syr2(l2_acc *acc, const float alpha, const float *x,
+                  const blasint incx, const float *y, const blasint incy);
+void l2_sacc_flush(l2_acc *acc);
+
+void l2_dacc_init_ge(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, double *a,
+                     const blasint lda, double *work, const blasint lwork);
+void l2_dacc_init_sy(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const enum CBLAS_UPLO uplo, const blasint n, double *a,
+                     const blasint lda, double *work, const blasint lwork);
+void l2_dacc_ger(l2_acc *acc, const double alpha, const double *x,
+                 const blasint incx, const double *y, const blasint incy);
+void l2_dacc_syr(l2_acc *acc, const double alpha, const double *x,
+                 const blasint incx);
+void l2_dacc_syr2(l2_acc *acc, const double alpha, const double *x,
+                  const blasint incx, const double *y, const blasint incy);
+void l2_dacc_flush(l2_acc *acc);
+
+void l2_cacc_init_ge(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, void *a,
+                     const blasint lda, void *work, const blasint lwork);
+void l2_cacc_init_he(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const enum CBLAS_UPLO uplo, const blasint n, void *a,
+                     const blasint lda, void *work, const blasint lwork);
+void l2_cacc_geru(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy);
+void l2_cacc_gerc(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy);
+void l2_cacc_her(l2_acc *acc, const float alpha, const void *x,
+                 const blasint incx);
+void l2_cacc_her2(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy);
+void l2_cacc_flush(l2_acc *acc);
+
+void l2_zacc_init_ge(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, void *a,
+                     const blasint lda, void *work, const blasint lwork);
+void l2_zacc_init_he(l2_acc *acc, const enum CBLAS_ORDER order,
+                     const enum CBLAS_UPLO uplo, const blasint n, void *a,
+                     const blasint lda, void *work, const blasint lwork);
+void l2_zacc_geru(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy);
+void l2_zacc_gerc(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy);
+void l2_zacc_her(l2_acc *acc, const double alpha, const void *x,
+                 const blasint incx);
+void l2_zacc_her2(l2_acc *acc, const void *alpha, const void *x,
+                  const blasint incx, const void *y, const blasint incy);
+void l2_zacc_flush(l2_acc *acc);
+
+/*
+ * Packed storage: the stored triangle's columns (ColMajor) or rows
+ * (RowMajor) back to back, n*(n+1)/2 elements in all, as in cblas.
+ */
+void l2_sspmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const float alpha, const float *ap,
+              const float *x, const blasint incx, const float beta,
+              float *y, const blasint incy);
+void l2_dspmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const double alpha, const double *ap,
+              const double *x, const blasint incx, const double beta,
+              double *y, const blasint incy);
+
+void l2_chpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *ap,
+              const void *x, const blasint incx, const void *beta, void *y,
+              const blasint incy);
+void l2_zhpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *ap,
+              const void *x, const blasint incx, const void *beta, void *y,
+              const blasint incy);
+
+void l2_stpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const float *ap, float *x,
+              const blasint incx);
+void l2_dtpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const double *ap, double *x,
+              const blasint incx);
+void l2_ctpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *ap, void *x, const blasint incx);
+void l2_ztpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *ap, void *x, const blasint incx);
+
+void l2_stpsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const float *ap, float *x,
+              const blasint incx);
+void l2_dtpsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const double *ap, double *x,
+              const blasint incx);
+void l2_ctpsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *ap, void *x, const blasint incx);
+void l2_ztpsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *ap, void *x, const blasint incx);
+
+void l2_sspr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const float alpha, const float *x,
+             const blasint incx, float *ap);
+void l2_dspr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const double alpha, const double *x,
+             const blasint incx, double *ap);
+
+void l2_chpr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const float alpha, const void *x,
+             const blasint incx, void *ap);
+void l2_zhpr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const double alpha, const void *x,
+             const blasint incx, void *ap);
+
+void l2_sspr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const float alpha, const float *x,
+              const blasint incx, const float *y, const blasint incy,
+              float *ap);
+void l2_dspr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const double alpha, const double *x,
+              const blasint incx, const double *y, const blasint incy,
+              double *ap);
+
+void l2_chpr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *ap);
+void l2_zhpr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *ap);
+
+/*
+ * Band storage: column j of A (ColMajor) or row j (RowMajor) holds its
+ * in-band entries at offset ku (k for upper triangles, 0 for lower) plus
+ * their distance from the diagonal, lda apart, as in cblas.
+ */
+void l2_sgbmv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const blasint kl,
+              const blasint ku, const float alpha, const float *a,
+              const blasint lda, const float *x, const blasint incx,
+              const float beta, float *y, const blasint incy);
+void l2_dgbmv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const blasint kl,
+              const blasint ku, const double alpha, const double *a,
+              const blasint lda, const double *x, const blasint incx,
+              const double beta, double *y, const blasint incy);
+void l2_cgbmv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const blasint kl,
+              const blasint ku, const void *alpha, const void *a,
+              const blasint lda, const void *x, const blasint incx,
+              const void *beta, void *y, const blasint incy);
+void l2_zgbmv(const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+              const blasint m, const blasint n, const blasint kl,
+              const blasint ku, const void *alpha, const void *a,
+              const blasint lda, const void *x, const blasint incx,
+              const void *beta, void *y, const blasint incy);
+
+void l2_ssbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const blasint k, const float alpha,
+              const float *a, const blasint lda, const float *x,
+              const blasint incx, const float beta, float *y,
+              const blasint incy);
+void l2_dsbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const blasint k, const double alpha,
+              const double *a, const blasint lda, const double *x,
+              const blasint incx, const double beta, double *y,
+              const blasint incy);
+
+void l2_chbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const blasint k, const void *alpha,
+              const void *a, const blasint lda, const void *x,
+              const blasint incx, const void *beta, void *y,
+              const blasint incy);
+void l2_zhbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const blasint k, const void *alpha,
+              const void *a, const blasint lda, const void *x,
+              const blasint incx, const void *beta, void *y,
+              const blasint incy);
+
+void l2_stbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const float *a,
+              const blasint lda, float *x, const blasint incx);
+void l2_dtbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const double *a,
+              const blasint lda, double *x, const blasint incx);
+void l2_ctbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const void *a,
+              const blasint lda, void *x, const blasint incx);
+void l2_ztbmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const void *a,
+              const blasint lda, void *x, const blasint incx);
+
+void l2_stbsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const float *a,
+              const blasint lda, float *x, const blasint incx);
+void l2_dtbsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const double *a,
+              const blasint lda, double *x, const blasint incx);
+void l2_ctbsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const void *a,
+              const blasint lda, void *x, const blasint incx);
+void l2_ztbsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const blasint k, const void *a,
+              const blasint lda, void *x, const blasint incx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* L2BLAS_H */
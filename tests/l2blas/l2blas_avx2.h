@@ -0,0 +1,41 @@
+/*
+ * Helpers shared by the *_avx2.c kernels.  Only include from files built
+ * with -mavx2 -mfma.
+ */
+#ifndef L2BLAS_AVX2_H
+#define L2BLAS_AVX2_H
+
+#include <immintrin.h>
+
+static inline float l2_hsum_ps(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+static inline double l2_hsum_pd(__m256d v) {
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+    return _mm_cvtsd_f64(s);
+}
+
+/* out[0] = sum of p, out[1] = sum of q, sharing one reduction. */
+static inline void l2_csum_ps(__m256 p, __m256 q, float *out) {
+    __m256 t = _mm256_add_ps(_mm256_unpacklo_ps(p, q),
+                             _mm256_unpackhi_ps(p, q));
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(t),
+                          _mm256_extractf128_ps(t, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    _mm_store_ss(out, s);
+    _mm_store_ss(out + 1, _mm_movehdup_ps(s));
+}
+
+static inline void l2_csum_pd(__m256d p, __m256d q, double *out) {
+    __m256d t = _mm256_add_pd(_mm256_unpacklo_pd(p, q),
+                              _mm256_unpackhi_pd(p, q));
+    _mm_storeu_pd(out, _mm_add_pd(_mm256_castpd256_pd128(t),
+                                  _mm256_extractf128_pd(t, 1)));
+}
+
+#endif /* L2BLAS_AVX2_H */
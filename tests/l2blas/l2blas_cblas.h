@@ -0,0 +1,80 @@
+/*
+ * Routes cblas_* calls to the l2blas implementations.
+ *
+ * Force-included (gcc -include) when the unmodified test_*.c programs are
+ * rebuilt against l2blas, e.g. test_gemv.c -> test_gemv_l2.  Routines that
+ * l2blas does not implement keep calling OpenBLAS.
+ */
+#ifndef L2BLAS_CBLAS_H
+#define L2BLAS_CBLAS_H
+
+#include "l2blas.h"
+
+#define cblas_sgemv l2_sgemv
+#define cblas_dgemv l2_dgemv
+#define cblas_cgemv l2_cgemv
+#define cblas_zgemv l2_zgemv
+#define cblas_ssymv l2_ssymv
+#define cblas_dsymv l2_dsymv
+#define cblas_chemv l2_chemv
+#define cblas_zhemv l2_zhemv
+#define cblas_strsv l2_strsv
+#define cblas_dtrsv l2_dtrsv
+#define cblas_ctrsv l2_ctrsv
+#define cblas_ztrsv l2_ztrsv
+#define cblas_strmv l2_strmv
+#define cblas_dtrmv l2_dtrmv
+#define cblas_ctrmv l2_ctrmv
+#define cblas_ztrmv l2_ztrmv
+#define cblas_sger l2_sger
+#define cblas_dger l2_dger
+#define cblas_cgeru l2_cgeru
+#define cblas_cgerc l2_cgerc
+#define cblas_zgeru l2_zgeru
+#define cblas_zgerc l2_zgerc
+#define cblas_ssyr l2_ssyr
+#define cblas_dsyr l2_dsyr
+#define cblas_cher l2_cher
+#define cblas_zher l2_zher
+#define cblas_ssyr2 l2_ssyr2
+#define cblas_dsyr2 l2_dsyr2
+#define cblas_cher2 l2_cher2
+#define cblas_zher2 l2_zher2
+#define cblas_sspmv l2_sspmv
+#define cblas_dspmv l2_dspmv
+#define cblas_chpmv l2_chpmv
+#define cblas_zhpmv l2_zhpmv
+#define cblas_stpmv l2_stpmv
+#define cblas_dtpmv l2_dtpmv
+#define cblas_ctpmv l2_ctpmv
+#define cblas_ztpmv l2_ztpmv
+#define cblas_stpsv l2_stpsv
+#define cblas_dtpsv l2_dtpsv
+#define cblas_ctpsv l2_ctpsv
+#define cblas_ztpsv l2_ztpsv
+#define cblas_sspr l2_sspr
+#define cblas_dspr l2_dspr
+#define cblas_chpr l2_chpr
+#define cblas_zhpr l2_zhpr
+#define cblas_sspr2 l2_sspr2
+#define cblas_dspr2 l2_dspr2
+#define cblas_chpr2 l2_chpr2
+#define cblas_zhpr2 l2_zhpr2
+#define cblas_sgbmv l2_sgbmv
+#define cblas_dgbmv l2_dgbmv
+#define cblas_cgbmv l2_cgbmv
+#define cblas_zgbmv l2_zgbmv
+#define cblas_ssbmv l2_ssbmv
+#define cblas_dsbmv l2_dsbmv
+#define cblas_chbmv l2_chbmv
+#define cblas_zhbmv l2_zhbmv
+#define cblas_stbmv l2_stbmv
+#define cblas_dtbmv l2_dtbmv
+#define cblas_ctbmv l2_ctbmv
+#define cblas_ztbmv l2_ztbmv
+#define cblas_stbsv l2_stbsv
+#define cblas_dtbsv l2_dtbsv
+#define cblas_ctbsv l2_ctbsv
+#define cblas_ztbsv l2_ztbsv
+
+#endif /* L2BLAS_CBLAS_H */
@@ -0,0 +1,776 @@
+/*
+ * Internal declarations shared by the l2blas drivers and kernels.
+ *
+ * Kernels work on column-major storage, like the reference BLAS; the
+ * drivers fold RowMajor into a transpose before dispatching.  The "n"
+ * kernels compute y += alpha * A * x and the "t" kernels y += alpha * A^T * x.
+ * SIMD kernels require the vector they stream with vector loads to be
+ * unit-stride (y for "n", x for "t"); drivers fall back to the generic
+ * kernels otherwise.
+ */
+#ifndef L2BLAS_INTERNAL_H
+#define L2BLAS_INTERNAL_H
+
+#include <string.h>
+#include "l2blas.h"
+
+enum l2_core_id {
+    L2_CORE_GENERIC = 0,
+    L2_CORE_AVX2    = 1,
+    L2_CORE_AVX512  = 2
+};
+
+/* Kernel tier currently selected (detected once, thread-safe). */
+int l2_core(void);
+
+/* Reference-BLAS style report of an illegal argument. */
+void l2_xerbla(const char *rname, int info);
+
+/* Points a negative-increment vector at its logical first element. */
+#define L2_VEC_BASE(p, len, inc) \
+    ((inc) < 0 ? (p) - (BLASLONG)((len) - 1) * (inc) : (p))
+
+#define L2_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define L2_MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* L1 data cache size as configured for the linked OpenBLAS. */
+#ifdef OPENBLAS_L1_DATA_SIZE
+#define L2_L1_BYTES OPENBLAS_L1_DATA_SIZE
+#else
+#define L2_L1_BYTES 32768
+#endif
+
+/*
+ * symv block order: the x and y segments of one block row take half of L1,
+ * leaving the other half for the streamed columns of A.
+ */
+#define L2_SYMV_NB(type) ((BLASLONG)(L2_L1_BYTES / (4 * sizeof(type))))
+
+/*
+ * symv and hemv: stored A reals per thread below which another thread is
+ * not worth its y tiles and their merges.
+ */
+#define L2_SYMV_MIN_WORK 32768
+
+/*
+ * trsv and trmv: diagonal block order of the blocked sweep, the strip width
+ * inside a diagonal block, and the A elements per thread below which a
+ * panel update is not worth waking another thread for.
+ */
+#define L2_TRSV_NB       256
+#define L2_TRSV_STRIP    8
+#define L2_TRSV_MIN_WORK 32768
+
+/*
+ * Threaded trmv: the products of one band of rows (or columns) go to a
+ * stack buffer of this many bytes before they overwrite x.
+ */
+#define L2_TRMV_BAND_BYTES 32768
+
+/* ---- threading (thread.c) ------------------------------------------------ */
+
+#define L2_MAX_THREADS 64
+
+typedef void (*l2_thread_fn)(int tid, int nthreads, void *arg);
+
+/*
+ * Runs fn(tid, nthreads, arg) for every tid in [0, nthreads) and returns once
+ * all slots have finished.  Slots are tasks, not threads: the caller and any
+ * idle pool workers claim them in turn, so fn must not make one slot wait
+ * for another.  nthreads above L2_MAX_THREADS is clamped, so fn must split
+ * its work by the nthreads it is given.
+ */
+void l2_parallel(int nthreads, l2_thread_fn fn, void *arg);
+
+/*
+ * Starts the pool workers that regions of up to nthreads slots (at most
+ * l2_get_num_threads()) would, so later ones create no thread.  Returns the
+ * slots that can run at once: the workers that exist plus the caller.
+ */
+int l2_pool_reserve(int nthreads);
+
+/*
+ * Threaded triangular routines split through l2_tri_split (l2blas.h).  A
+ * column costs L2_TRI_LINE_BYTES of streamed A on top of its elements: a
+ * new stream's TLB miss and prefetcher ramp-up, which leave blocks of many
+ * short columns behind ones of few long ones at equal area.
+ */
+#define L2_TRI_LINE_BYTES 4096
+
+/*
+ * Default panel of the mapped gemv (stream.c): large enough that the
+ * kernel's read-ahead of the next panel runs at the device's sequential
+ * rate, small enough that two panels are a sliver of RAM.
+ */
+#define L2_STREAM_PANEL ((size_t)64 << 20)
+
+/*
+ * By default the mapped gemv drops A from the page cache only when A is
+ * larger than this fraction (1/L2_STREAM_EVICT_DIV) of physical RAM: such
+ * an A would not survive in the cache to the next call anyway, and
+ * keeping it would push out everything else.
+ */
+#define L2_STREAM_EVICT_DIV 2
+
+/* ---- gemv drivers without argument checking (gemv.c, cgemv.c) ------------ */
+
+/*
+ * Returns the cblas parameter number of the first illegal gemv argument,
+ * or 0.  CblasConjNoTrans is accepted, as OpenBLAS does; for real data it
+ * means NoTrans.
+ */
+int l2_gemv_check(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                  blasint m, blasint n, blasint lda,
+                  blasint incx, blasint incy);
+
+/* Argument check of symv, hemv, sbsymv and shsymv (symv.c), same contract. */
+int l2_symv_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                  blasint n, blasint lda, blasint incx, blasint incy);
+
+/* Argument check shared by trsv and trmv (trsv.c), same contract. */
+int l2_trxv_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                  enum CBLAS_TRANSPOSE trans, enum CBLAS_DIAG diag,
+                  blasint n, blasint lda, blasint incx);
+
+void l2_sgemv_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      BLASLONG m, BLASLONG n, float alpha,
+                      const float *a, BLASLONG lda, const float *x,
+                      BLASLONG incx, float beta, float *y, BLASLONG incy);
+void l2_dgemv_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      BLASLONG m, BLASLONG n, double alpha,
+                      const double *a, BLASLONG lda, const double *x,
+                      BLASLONG incx, double beta, double *y, BLASLONG incy);
+void l2_cgemv_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      BLASLONG m, BLASLONG n, const float *alpha,
+                      const float *a, BLASLONG lda, const float *x,
+                      BLASLONG incx, const float *beta, float *y,
+                      BLASLONG incy);
+void l2_zgemv_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                      BLASLONG m, BLASLONG n, const double *alpha,
+                      const double *a, BLASLONG lda, const double *x,
+                      BLASLONG incx, const double *beta, double *y,
+                      BLASLONG incy);
+
+typedef void (*l2_sgemv_kernel)(BLASLONG m, BLASLONG n, float alpha,
+                                const float *a, BLASLONG lda,
+                                const float *x, BLASLONG incx,
+                                float *y, BLASLONG incy);
+typedef void (*l2_dgemv_kernel)(BLASLONG m, BLASLONG n, double alpha,
+                                const double *a, BLASLONG lda,
+                                const double *x, BLASLONG incx,
+                                double *y, BLASLONG incy);
+
+/* Kernel for y += alpha * op(A) * x with the given increments (gemv.c). */
+l2_sgemv_kernel l2_sgemv_pick(int notrans, BLASLONG incx, BLASLONG incy);
+l2_dgemv_kernel l2_dgemv_pick(int notrans, BLASLONG incx, BLASLONG incy);
+
+void l2_sgemv_n_generic(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                        BLASLONG lda, const float *x, BLASLONG incx,
+                        float *y, BLASLONG incy);
+void l2_sgemv_t_generic(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                        BLASLONG lda, const float *x, BLASLONG incx,
+                        float *y, BLASLONG incy);
+void l2_dgemv_n_generic(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                        BLASLONG lda, const double *x, BLASLONG incx,
+                        double *y, BLASLONG incy);
+void l2_dgemv_t_generic(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                        BLASLONG lda, const double *x, BLASLONG incx,
+                        double *y, BLASLONG incy);
+
+void l2_sgemv_n_avx2(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                     BLASLONG lda, const float *x, BLASLONG incx,
+                     float *y, BLASLONG incy);
+void l2_sgemv_t_avx2(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                     BLASLONG lda, const float *x, BLASLONG incx,
+                     float *y, BLASLONG incy);
+void l2_dgemv_n_avx2(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                     BLASLONG lda, const double *x, BLASLONG incx,
+                     double *y, BLASLONG incy);
+void l2_dgemv_t_avx2(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                     BLASLONG lda, const double *x, BLASLONG incx,
+                     double *y, BLASLONG incy);
+
+void l2_sgemv_n_avx512(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                       BLASLONG lda, const float *x, BLASLONG incx,
+                       float *y, BLASLONG incy);
+void l2_sgemv_t_avx512(BLASLONG m, BLASLONG n, float alpha, const float *a,
+                       BLASLONG lda, const float *x, BLASLONG incx,
+                       float *y, BLASLONG incy);
+void l2_dgemv_n_avx512(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                       BLASLONG lda, const double *x, BLASLONG incx,
+                       double *y, BLASLONG incy);
+void l2_dgemv_t_avx512(BLASLONG m, BLASLONG n, double alpha, const double *a,
+                       BLASLONG lda, const double *x, BLASLONG incx,
+                       double *y, BLASLONG incy);
+
+/*
+ * Fused symv panel: for an m x n column-major block A,
+ *   y1 += alpha * A * x2   and   y2 += alpha * A^T * x1
+ * in one pass over A.  All vectors are unit-stride and y1/y2 are disjoint.
+ */
+typedef void (*l2_ssymv_panel_kernel)(BLASLONG m, BLASLONG n, float alpha,
+                                      const float *a, BLASLONG lda,
+                                      const float *x1, float *y1,
+                                      const float *x2, float *y2);
+typedef void (*l2_dsymv_panel_kernel)(BLASLONG m, BLASLONG n, double alpha,
+                                      const double *a, BLASLONG lda,
+                                      const double *x1, double *y1,
+                                      const double *x2, double *y2);
+
+/* Panel kernel for the current tier (symv.c). */
+l2_ssymv_panel_kernel l2_ssymv_panel_pick(void);
+l2_dsymv_panel_kernel l2_dsymv_panel_pick(void);
+
+void l2_ssymv_panel_generic(BLASLONG m, BLASLONG n, float alpha,
+                            const float *a, BLASLONG lda,
+                            const float *x1, float *y1,
+                            const float *x2, float *y2);
+void l2_ssymv_panel_avx2(BLASLONG m, BLASLONG n, float alpha,
+                         const float *a, BLASLONG lda,
+                         const float *x1, float *y1,
+                         const float *x2, float *y2);
+void l2_ssymv_panel_avx512(BLASLONG m, BLASLONG n, float alpha,
+                           const float *a, BLASLONG lda,
+                           const float *x1, float *y1,
+                           const float *x2, float *y2);
+void l2_dsymv_panel_generic(BLASLONG m, BLASLONG n, double alpha,
+                            const double *a, BLASLONG lda,
+                            const double *x1, double *y1,
+                            const double *x2, double *y2);
+void l2_dsymv_panel_avx2(BLASLONG m, BLASLONG n, double alpha,
+                         const double *a, BLASLONG lda,
+                         const double *x1, double *y1,
+                         const double *x2, double *y2);
+void l2_dsymv_panel_avx512(BLASLONG m, BLASLONG n, double alpha,
+                           const double *a, BLASLONG lda,
+                           const double *x1, double *y1,
+                           const double *x2, double *y2);
+
+/*
+ * Band "diagonal" kernel: for i in [0, len)
+ *   y[i] += alpha * sum_t a[off[t] + i*lda] * x[i + shift[t]]
+ * Each term t walks one diagonal of a band matrix (stride lda through the
+ * band array) against a contiguous run of x, so short band columns still
+ * fill whole vectors.  x and y are unit-stride and every index must be in
+ * range; band.c peels the rows where a diagonal leaves the matrix.
+ *
+ * Used for real gbmv/sbmv when at most L2_BAND_DIAG_MAX diagonals are
+ * involved; wider gbmv bands go to the gemv kernels a panel at a time.
+ */
+#define L2_BAND_DIAG_MAX 33
+#define L2_BAND_DIAG_LDA 256
+
+/* Column block of the dense-panel path for wider real gbmv bands. */
+#define L2_BAND_PANEL_NB 8
+
+typedef void (*l2_sband_diag_kernel)(BLASLONG len, int nterms,
+                                     const BLASLONG *off,
+                                     const BLASLONG *shift, float alpha,
+                                     const float *a, BLASLONG lda,
+                                     const float *x, float *y);
+typedef void (*l2_dband_diag_kernel)(BLASLONG len, int nterms,
+                                     const BLASLONG *off,
+                                     const BLASLONG *shift, double alpha,
+                                     const double *a, BLASLONG lda,
+                                     const double *x, double *y);
+
+void l2_sband_diag_generic(BLASLONG len, int nterms, const BLASLONG *off,
+                           const BLASLONG *shift, float alpha,
+                           const float *a, BLASLONG lda, const float *x,
+                           float *y);
+void l2_sband_diag_avx2(BLASLONG len, int nterms, const BLASLONG *off,
+                        const BLASLONG *shift, float alpha, const float *a,
+                        BLASLONG lda, const float *x, float *y);
+void l2_sband_diag_avx512(BLASLONG len, int nterms, const BLASLONG *off,
+                          const BLASLONG *shift, float alpha, const float *a,
+                          BLASLONG lda, const float *x, float *y);
+void l2_dband_diag_generic(BLASLONG len, int nterms, const BLASLONG *off,
+                           const BLASLONG *shift, double alpha,
+                           const double *a, BLASLONG lda, const double *x,
+                           double *y);
+void l2_dband_diag_avx2(BLASLONG len, int nterms, const BLASLONG *off,
+                        const BLASLONG *shift, double alpha, const double *a,
+                        BLASLONG lda, const double *x, double *y);
+void l2_dband_diag_avx512(BLASLONG len, int nterms, const BLASLONG *off,
+                          const BLASLONG *shift, double alpha,
+                          const double *a, BLASLONG lda, const double *x,
+                          double *y);
+
+/*
+ * Complex gemv kernels on interleaved (re, im) storage; lda and the
+ * increments count complex elements.  conj uses conj(A) in place of A.
+ */
+void l2_cgemv_n_generic(BLASLONG m, BLASLONG n, const float *alpha,
+                        const float *a, BLASLONG lda, const float *x,
+                        BLASLONG incx, float *y, BLASLONG incy, int conj);
+void l2_cgemv_t_generic(BLASLONG m, BLASLONG n, const float *alpha,
+                        const float *a, BLASLONG lda, const float *x,
+                        BLASLONG incx, float *y, BLASLONG incy, int conj);
+void l2_zgemv_n_generic(BLASLONG m, BLASLONG n, const double *alpha,
+                        const double *a, BLASLONG lda, const double *x,
+                        BLASLONG incx, double *y, BLASLONG incy, int conj);
+void l2_zgemv_t_generic(BLASLONG m, BLASLONG n, const double *alpha,
+                        const double *a, BLASLONG lda, const double *x,
+                        BLASLONG incx, double *y, BLASLONG incy, int conj);
+
+/*
+ * Complex gemv panel, both directions of one block in a single pass over A
+ * (the complex counterpart of the symv panel):
+ *
+ *     y1 += alpha * op1(A) * x2        (skipped when y1 is NULL)
+ *     y2 += alpha * op2(A)^T * x1      (skipped when y2 is NULL)
+ *
+ * for an m x n column-major block A, where opK conjugates A when conjK is
+ * set.  gemv uses one direction, hemv both with opposite conjugation.
+ * Vectors may have any nonzero increment, already based at their first
+ * element.
+ *
+ * The SIMD versions work split-complex: each row tile of x1 and y1 is
+ * converted once into separate real and imaginary arrays, columns of A are
+ * split into real and imaginary vectors as they are loaded, and the inner
+ * loops are nothing but FMAs.  A tile is L2_CSPLIT_MB rows: its split
+ * arrays come to 1.5x L1 and sit in L2, which buys column runs of A long
+ * enough (16 KiB) for the hardware prefetcher to stay ahead.  The
+ * conjugations are folded into the signs of the converted x1 and of the
+ * per-column coefficients, so all four combinations run the same loops.
+ */
+#define L2_CSPLIT_MB(type) ((BLASLONG)(L2_L1_BYTES / (4 * sizeof(type))))
+
+typedef void (*l2_cgemv_panel_kernel)(BLASLONG m, BLASLONG n,
+                                      const float *alpha, const float *a,
+                                      BLASLONG lda,
+                                      const float *x1, BLASLONG incx1,
+                                      float *y1, BLASLONG incy1,
+                                      const float *x2, BLASLONG incx2,
+                                      float *y2, BLASLONG incy2,
+                                      int conj1, int conj2);
+typedef void (*l2_zgemv_panel_kernel)(BLASLONG m, BLASLONG n,
+                                      const double *alpha, const double *a,
+                                      BLASLONG lda,
+                                      const double *x1, BLASLONG incx1,
+                                      double *y1, BLASLONG incy1,
+                                      const double *x2, BLASLONG incx2,
+                                      double *y2, BLASLONG incy2,
+                                      int conj1, int conj2);
+
+/* Panel kernel for the current tier (cgemv.c). */
+l2_cgemv_panel_kernel l2_cgemv_panel_pick(void);
+l2_zgemv_panel_kernel l2_zgemv_panel_pick(void);
+
+void l2_cgemv_panel_generic(BLASLONG m, BLASLONG n, const float *alpha,
+                            const float *a, BLASLONG lda,
+                            const float *x1, BLASLONG incx1,
+                            float *y1, BLASLONG incy1,
+                            const float *x2, BLASLONG incx2,
+                            float *y2, BLASLONG incy2,
+                            int conj1, int conj2);
+void l2_cgemv_panel_avx2(BLASLONG m, BLASLONG n, const float *alpha,
+                         const float *a, BLASLONG lda,
+                         const float *x1, BLASLONG incx1,
+                         float *y1, BLASLONG incy1,
+                         const float *x2, BLASLONG incx2,
+                         float *y2, BLASLONG incy2,
+                         int conj1, int conj2);
+void l2_cgemv_panel_avx512(BLASLONG m, BLASLONG n, const float *alpha,
+                           const float *a, BLASLONG lda,
+                           const float *x1, BLASLONG incx1,
+                           float *y1, BLASLONG incy1,
+                           const float *x2, BLASLONG incx2,
+                           float *y2, BLASLONG incy2,
+                           int conj1, int conj2);
+void l2_zgemv_panel_generic(BLASLONG m, BLASLONG n, const double *alpha,
+                            const double *a, BLASLONG lda,
+                            const double *x1, BLASLONG incx1,
+                            double *y1, BLASLONG incy1,
+                            const double *x2, BLASLONG incx2,
+                            double *y2, BLASLONG incy2,
+                            int conj1, int conj2);
+void l2_zgemv_panel_avx2(BLASLONG m, BLASLONG n, const double *alpha,
+                         const double *a, BLASLONG lda,
+                         const double *x1, BLASLONG incx1,
+                         double *y1, BLASLONG incy1,
+                         const double *x2, BLASLONG incx2,
+                         double *y2, BLASLONG incy2,
+                         int conj1, int conj2);
+void l2_zgemv_panel_avx512(BLASLONG m, BLASLONG n, const double *alpha,
+                           const double *a, BLASLONG lda,
+                           const double *x1, BLASLONG incx1,
+                           double *y1, BLASLONG incy1,
+                           const double *x2, BLASLONG incx2,
+                           double *y2, BLASLONG incy2,
+                           int conj1, int conj2);
+
+/*
+ * Rank-1 update kernels (ger.c): for an m x n column-major block A
+ *
+ *     A(:, j) += alpha * opy(y(j)) * x       j in [0, n)
+ *
+ * with x unit-stride and y at any increment, based at its first element.
+ * Complex kernels take x twice, as xv = opx(x) and xw = i * opx(x) (the
+ * pairs (-im, re)), both interleaved, so one column update is two real
+ * FMAs per element; conjy conjugates y.  The driver builds x a row tile
+ * of L2_GER_MB at a time (real x only when it is strided), which keeps it
+ * in L1 while A streams past.
+ *
+ * L2_GER_PF is the software prefetch distance ahead of each column stream
+ * and L2_GER_MIN_WORK the A reals per thread below which another thread is
+ * not worth waking.
+ */
+#define L2_GER_MB(type) ((BLASLONG)(L2_L1_BYTES / (8 * sizeof(type))))
+#define L2_GER_PF       1024
+#define L2_GER_MIN_WORK 32768
+
+typedef void (*l2_sger_kernel)(BLASLONG m, BLASLONG n, float alpha,
+                               const float *x, const float *y, BLASLONG incy,
+                               float *a, BLASLONG lda);
+typedef void (*l2_dger_kernel)(BLASLONG m, BLASLONG n, double alpha,
+                               const double *x, const double *y,
+                               BLASLONG incy, double *a, BLASLONG lda);
+typedef void (*l2_cger_kernel)(BLASLONG m, BLASLONG n, const float *alpha,
+                               const float *x, const float *xw,
+                               const float *y, BLASLONG incy, float *a,
+                               BLASLONG lda, int conjy);
+typedef void (*l2_zger_kernel)(BLASLONG m, BLASLONG n, const double *alpha,
+                               const double *x, const double *xw,
+                               const double *y, BLASLONG incy, double *a,
+                               BLASLONG lda, int conjy);
+
+/* Kernel for the current tier (ger.c). */
+l2_sger_kernel l2_sger_pick(void);
+l2_dger_kernel l2_dger_pick(void);
+l2_cger_kernel l2_cger_pick(void);
+l2_zger_kernel l2_zger_pick(void);
+
+void l2_sger_kernel_generic(BLASLONG m, BLASLONG n, float alpha,
+                            const float *x, const float *y, BLASLONG incy,
+                            float *a, BLASLONG lda);
+void l2_sger_kernel_avx2(BLASLONG m, BLASLONG n, float alpha,
+                         const float *x, const float *y, BLASLONG incy,
+                         float *a, BLASLONG lda);
+void l2_sger_kernel_avx512(BLASLONG m, BLASLONG n, float alpha,
+                           const float *x, const float *y, BLASLONG incy,
+                           float *a, BLASLONG lda);
+void l2_dger_kernel_generic(BLASLONG m, BLASLONG n, double alpha,
+                            const double *x, const double *y, BLASLONG incy,
+                            double *a, BLASLONG lda);
+void l2_dger_kernel_avx2(BLASLONG m, BLASLONG n, double alpha,
+                         const double *x, const double *y, BLASLONG incy,
+                         double *a, BLASLONG lda);
+void l2_dger_kernel_avx512(BLASLONG m, BLASLONG n, double alpha,
+                           const double *x, const double *y, BLASLONG incy,
+                           double *a, BLASLONG lda);
+void l2_cger_kernel_generic(BLASLONG m, BLASLONG n, const float *alpha,
+                            const float *x, const float *xw,
+                            const float *y, BLASLONG incy, float *a,
+                            BLASLONG lda, int conjy);
+void l2_cger_kernel_avx2(BLASLONG m, BLASLONG n, const float *alpha,
+                         const float *x, const float *xw,
+                         const float *y, BLASLONG incy, float *a,
+                         BLASLONG lda, int conjy);
+void l2_cger_kernel_avx512(BLASLONG m, BLASLONG n, const float *alpha,
+                           const float *x, const float *xw,
+                           const float *y, BLASLONG incy, float *a,
+                           BLASLONG lda, int conjy);
+void l2_zger_kernel_generic(BLASLONG m, BLASLONG n, const double *alpha,
+                            const double *x, const double *xw,
+                            const double *y, BLASLONG incy, double *a,
+                            BLASLONG lda, int conjy);
+void l2_zger_kernel_avx2(BLASLONG m, BLASLONG n, const double *alpha,
+                         const double *x, const double *xw,
+                         const double *y, BLASLONG incy, double *a,
+                         BLASLONG lda, int conjy);
+void l2_zger_kernel_avx512(BLASLONG m, BLASLONG n, const double *alpha,
+                           const double *x, const double *xw,
+                           const double *y, BLASLONG incy, double *a,
+                           BLASLONG lda, int conjy);
+
+/*
+ * Rank-2 update kernels (syr.c): for an m x n column-major block A
+ *
+ *     A(:, j) += p(j) * x + q(j) * y       j in [0, n)
+ *
+ * with x, y and the column coefficients p, q all unit-stride.  Complex
+ * kernels take x and y twice like the ger ones (xw = i * x, yw = i * y),
+ * and p, q interleaved, so one column update is four real FMAs per
+ * element.  The syr/her and syr2/her2 driver builds x, y row tiles of
+ * L2_SYR_MB and the coefficients of L2_SYR_MB columns at a time on the
+ * stack; both tiles together take the L1 share of ger's single x tile.
+ * syr/her run the rank-1 ger kernels on the same tiles.
+ */
+#define L2_SYR_MB(type) (L2_GER_MB(type) / 2)
+
+typedef void (*l2_sger2_kernel)(BLASLONG m, BLASLONG n, const float *x,
+                                const float *y, const float *p,
+                                const float *q, float *a, BLASLONG lda);
+typedef void (*l2_dger2_kernel)(BLASLONG m, BLASLONG n, const double *x,
+                                const double *y, const double *p,
+                                const double *q, double *a, BLASLONG lda);
+typedef void (*l2_cger2_kernel)(BLASLONG m, BLASLONG n, const float *x,
+                                const float *xw, const float *y,
+                                const float *yw, const float *p,
+                                const float *q, float *a, BLASLONG lda);
+typedef void (*l2_zger2_kernel)(BLASLONG m, BLASLONG n, const double *x,
+                                const double *xw, const double *y,
+                                const double *yw, const double *p,
+                                const double *q, double *a, BLASLONG lda);
+
+/* Kernel for the current tier (syr.c). */
+l2_sger2_kernel l2_sger2_pick(void);
+l2_dger2_kernel l2_dger2_pick(void);
+l2_cger2_kernel l2_cger2_pick(void);
+l2_zger2_kernel l2_zger2_pick(void);
+
+void l2_sger2_kernel_generic(BLASLONG m, BLASLONG n, const float *x,
+                             const float *y, const float *p, const float *q,
+                             float *a, BLASLONG lda);
+void l2_sger2_kernel_avx2(BLASLONG m, BLASLONG n, const float *x,
+                          const float *y, const float *p, const float *q,
+                          float *a, BLASLONG lda);
+void l2_sger2_kernel_avx512(BLASLONG m, BLASLONG n, const float *x,
+                            const float *y, const float *p, const float *q,
+                            float *a, BLASLONG lda);
+void l2_dger2_kernel_generic(BLASLONG m, BLASLONG n, const double *x,
+                             const double *y, const double *p, const double *q,
+                             double *a, BLASLONG lda);
+void l2_dger2_kernel_avx2(BLASLONG m, BLASLONG n, const double *x,
+                          const double *y, const double *p, const double *q,
+                          double *a, BLASLONG lda);
+void l2_dger2_kernel_avx512(BLASLONG m, BLASLONG n, const double *x,
+                            const double *y, const double *p, const double *q,
+                            double *a, BLASLONG lda);
+void l2_cger2_kernel_generic(BLASLONG m, BLASLONG n, const float *x,
+                             const float *xw, const float *y, const float *yw,
+                             const float *p, const float *q, float *a,
+                             BLASLONG lda);
+void l2_cger2_kernel_avx2(BLASLONG m, BLASLONG n, const float *x,
+                          const float *xw, const float *y, const float *yw,
+                          const float *p, const float *q, float *a,
+                          BLASLONG lda);
+void l2_cger2_kernel_avx512(BLASLONG m, BLASLONG n, const float *x,
+                            const float *xw, const float *y, const float *yw,
+                            const float *p, const float *q, float *a,
+                            BLASLONG lda);
+void l2_zger2_kernel_generic(BLASLONG m, BLASLONG n, const double *x,
+                             const double *xw, const double *y,
+                             const double *yw, const double *p,
+                             const double *q, double *a, BLASLONG lda);
+void l2_zger2_kernel_avx2(BLASLONG m, BLASLONG n, const double *x,
+                          const double *xw, const double *y, const double *yw,
+                          const double *p, const double *q, double *a,
+                          BLASLONG lda);
+void l2_zger2_kernel_avx512(BLASLONG m, BLASLONG n, const double *x,
+                            const double *xw, const double *y,
+                            const double *yw, const double *p, const double *q,
+                            double *a, BLASLONG lda);
+
+/*
+ * Deferred rank-k accumulation (acc.c): l2_acc kinds, 0 marking an acc
+ * whose init failed, and the bytes of U one row tile of a flush may take,
+ * about half of a typical L2 so the tile stays there while every column
+ * of A passes over it.
+ */
+enum { L2_ACC_GE = 1, L2_ACC_SY = 2, L2_ACC_HE = 3 };
+#define L2_ACC_U_BYTES (256 * 1024)
+
+/*
+ * Reduced-precision storage (half.c): A and x held as bf16 (sb) or IEEE
+ * fp16 (sh), widened to fp32 as they are loaded; all arithmetic is fp32.
+ * The kernels take x (and, for symv, both vector segments) already widened
+ * to float: the drivers convert x L2_HALF_XB elements at a time into a
+ * stack buffer, so the kernels' operands are the fp32 gemv/symv ones with
+ * A at half the bytes.  L2_HALF_TRMV_NB is the diagonal block of the
+ * blocked trmv, done in scalar code; the rest of the triangle goes to the
+ * gemv kernels.
+ */
+#define L2_HALF_XB      4096
+#define L2_HALF_TRMV_NB 32
+
+enum l2_half_format { L2_HALF_BF16 = 0, L2_HALF_FP16 = 1 };
+
+static inline float l2_bf16_to_float(uint16_t h) {
+    uint32_t bits = (uint32_t)h << 16;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static inline float l2_fp16_to_float(uint16_t h) {
+    uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+    uint32_t e = (h >> 10) & 0x1fu, mant = h & 0x3ffu, bits;
+    float f;
+
+    if (e == 0x1f) {                /* inf, nan */
+        bits = sign | 0x7f800000u | (mant << 13);
+    } else if (e != 0) {
+        bits = sign | ((e + 112) << 23) | (mant << 13);
+    } else {                        /* zero, subnormal: mant * 2^-24 exactly */
+        f = (float)mant * 0x1p-24f;
+        return sign ? -f : f;
+    }
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+typedef void (*l2_hgemv_kernel)(BLASLONG m, BLASLONG n, float alpha,
+                                const uint16_t *a, BLASLONG lda,
+                                const float *x, BLASLONG incx,
+                                float *y, BLASLONG incy);
+typedef void (*l2_hsymv_panel_kernel)(BLASLONG m, BLASLONG n, float alpha,
+                                      const uint16_t *a, BLASLONG lda,
+                                      const float *x1, float *y1,
+                                      const float *x2, float *y2);
+
+/* Kernels for the current tier and format (half.c), contracts as above. */
+l2_hgemv_kernel l2_hgemv_pick(int fmt, int notrans, BLASLONG incx,
+                              BLASLONG incy);
+l2_hsymv_panel_kernel l2_hsymv_panel_pick(int fmt);
+
+void l2_sbgemv_n_generic(BLASLONG m, BLASLONG n, float alpha,
+                         const uint16_t *a, BLASLONG lda,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy);
+void l2_sbgemv_t_generic(BLASLONG m, BLASLONG n, float alpha,
+                         const uint16_t *a, BLASLONG lda,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy);
+void l2_sbsymv_panel_generic(BLASLONG m, BLASLONG n, float alpha,
+                             const uint16_t *a, BLASLONG lda,
+                             const float *x1, float *y1,
+                             const float *x2, float *y2);
+void l2_sbgemv_n_avx2(BLASLONG m, BLASLONG n, float alpha,
+                      const uint16_t *a, BLASLONG lda,
+                      const float *x, BLASLONG incx, float *y,
+                      BLASLONG incy);
+void l2_sbgemv_t_avx2(BLASLONG m, BLASLONG n, float alpha,
+                      const uint16_t *a, BLASLONG lda,
+                      const float *x, BLASLONG incx, float *y,
+                      BLASLONG incy);
+void l2_sbsymv_panel_avx2(BLASLONG m, BLASLONG n, float alpha,
+                          const uint16_t *a, BLASLONG lda,
+                          const float *x1, float *y1,
+                          const float *x2, float *y2);
+void l2_sbgemv_n_avx512(BLASLONG m, BLASLONG n, float alpha,
+                        const uint16_t *a, BLASLONG lda,
+                        const float *x, BLASLONG incx, float *y,
+                        BLASLONG incy);
+void l2_sbgemv_t_avx512(BLASLONG m, BLASLONG n, float alpha,
+                        const uint16_t *a, BLASLONG lda,
+                        const float *x, BLASLONG incx, float *y,
+                        BLASLONG incy);
+void l2_sbsymv_panel_avx512(BLASLONG m, BLASLONG n, float alpha,
+                            const uint16_t *a, BLASLONG lda,
+                            const float *x1, float *y1,
+                            const float *x2, float *y2);
+void l2_shgemv_n_generic(BLASLONG m, BLASLONG n, float alpha,
+                         const uint16_t *a, BLASLONG lda,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy);
+void l2_shgemv_t_generic(BLASLONG m, BLASLONG n, float alpha,
+                         const uint16_t *a, BLASLONG lda,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy);
+void l2_shsymv_panel_generic(BLASLONG m, BLASLONG n, float alpha,
+                             const uint16_t *a, BLASLONG lda,
+                             const float *x1, float *y1,
+                             const float *x2, float *y2);
+void l2_shgemv_n_avx2(BLASLONG m, BLASLONG n, float alpha,
+                      const uint16_t *a, BLASLONG lda,
+                      const float *x, BLASLONG incx, float *y,
+                      BLASLONG incy);
+void l2_shgemv_t_avx2(BLASLONG m, BLASLONG n, float alpha,
+                      const uint16_t *a, BLASLONG lda,
+                      const float *x, BLASLONG incx, float *y,
+                      BLASLONG incy);
+void l2_shsymv_panel_avx2(BLASLONG m, BLASLONG n, float alpha,
+                          const uint16_t *a, BLASLONG lda,
+                          const float *x1, float *y1,
+                          const float *x2, float *y2);
+void l2_shgemv_n_avx512(BLASLONG m, BLASLONG n, float alpha,
+                        const uint16_t *a, BLASLONG lda,
+                        const float *x, BLASLONG incx, float *y,
+                        BLASLONG incy);
+void l2_shgemv_t_avx512(BLASLONG m, BLASLONG n, float alpha,
+                        const uint16_t *a, BLASLONG lda,
+                        const float *x, BLASLONG incx, float *y,
+                        BLASLONG incy);
+void l2_shsymv_panel_avx512(BLASLONG m, BLASLONG n, float alpha,
+                            const uint16_t *a, BLASLONG lda,
+                            const float *x1, float *y1,
+                            const float *x2, float *y2);
+
+/*
+ * int8 weights (quant.c).  The quantized A is row-major with rows padded
+ * with zeros to ldq, a multiple of 64 bytes, and scale[i * lds + b] the
+ * scale of block b of row i.  The drivers walk x (NoTrans) or y (Trans) in
+ * chunks of up to L2_Q8_XB elements held on the stack, zero-padded like A,
+ * so every kernel length is a multiple of 32 and the kernels have no
+ * tails; chunks hold whole blocks where blocks are shorter.  Trans takes
+ * L2_Q8_RB rows of alpha * x at a time.
+ *
+ * The kernels run over m rows and len columns of A starting on a block
+ * boundary, block k covering columns [k * block, min((k + 1) * block, len))
+ * with scale scale[i * lds + k]:
+ *   q8dot   y(i*incy) += mult * sum_k scale_ik * sum (int32) q(i,j) xq(j)
+ *   q8dotf  y(i*incy) += mult * sum_k scale_ik * sum q(i,j) x(j)
+ *   q8axpy  y(j)      += sum_i tx(i) * scale_ik * q(i,j)
+ * q8dot needs len <= L2_Q8_XB to stay clear of int32 overflow, and xq in
+ * [-127, 127].
+ */
+#define L2_Q8_XB 4096
+#define L2_Q8_RB 256
+
+typedef void (*l2_q8dot_kernel)(BLASLONG m, BLASLONG len, BLASLONG block,
+                                const int8_t *q, BLASLONG ldq,
+                                const float *scale, BLASLONG lds,
+                                const int8_t *xq, float mult,
+                                float *y, BLASLONG incy);
+typedef void (*l2_q8dotf_kernel)(BLASLONG m, BLASLONG len, BLASLONG block,
+                                 const int8_t *q, BLASLONG ldq,
+                                 const float *scale, BLASLONG lds,
+                                 const float *x, float mult,
+                                 float *y, BLASLONG incy);
+typedef void (*l2_q8axpy_kernel)(BLASLONG m, BLASLONG len, BLASLONG block,
+                                 const int8_t *q, BLASLONG ldq,
+                                 const float *scale, BLASLONG lds,
+                                 const float *tx, float *y);
+
+/* Kernels for the current tier (quant.c), contracts as above. */
+l2_q8dot_kernel l2_q8dot_pick(void);
+l2_q8dotf_kernel l2_q8dotf_pick(void);
+l2_q8axpy_kernel l2_q8axpy_pick(void);
+
+void l2_q8dot_generic(BLASLONG m, BLASLONG len, BLASLONG block,
+                      const int8_t *q, BLASLONG ldq, const float *scale,
+                      BLASLONG lds, const int8_t *xq, float mult, float *y,
+                      BLASLONG incy);
+void l2_q8dotf_generic(BLASLONG m, BLASLONG len, BLASLONG block,
+                       const int8_t *q, BLASLONG ldq, const float *scale,
+                       BLASLONG lds, const float *x, float mult, float *y,
+                       BLASLONG incy);
+void l2_q8axpy_generic(BLASLONG m, BLASLONG len, BLASLONG block,
+                       const int8_t *q, BLASLONG ldq, const float *scale,
+                       BLASLONG lds, const float *tx, float *y);
+void l2_q8dot_avx2(BLASLONG m, BLASLONG len, BLASLONG block,
+                   const int8_t *q, BLASLONG ldq, const float *scale,
+                   BLASLONG lds, const int8_t *xq, float mult, float *y,
+                   BLASLONG incy);
+void l2_q8dotf_avx2(BLASLONG m, BLASLONG len, BLASLONG block,
+                    const int8_t *q, BLASLONG ldq, const float *scale,
+                    BLASLONG lds, const float *x, float mult, float *y,
+                    BLASLONG incy);
+void l2_q8axpy_avx2(BLASLONG m, BLASLONG len, BLASLONG block,
+                    const int8_t *q, BLASLONG ldq, const float *scale,
+                    BLASLONG lds, const float *tx, float *y);
+void l2_q8dot_avx512(BLASLONG m, BLASLONG len, BLASLONG block,
+                     const int8_t *q, BLASLONG ldq, const float *scale,
+                     BLASLONG lds, const int8_t *xq, float mult, float *y,
+                     BLASLONG incy);
+void l2_q8dotf_avx512(BLASLONG m, BLASLONG len, BLASLONG block,
+                      const int8_t *q, BLASLONG ldq, const float *scale,
+                      BLASLONG lds, const float *x, float mult, float *y,
+                      BLASLONG incy);
+void l2_q8axpy_avx512(BLASLONG m, BLASLONG len, BLASLONG block,
+                      const int8_t *q, BLASLONG ldq, const float *scale,
+                      BLASLONG lds, const float *tx, float *y);
+
+#endif /* L2BLAS_INTERNAL_H */
@@ -0,0 +1,524 @@
+/*
+ * l2blas_small - header-only C++ gemv/symv/trmv for matrices whose order is
+ * known at compile time (1..16; aimed at the 2x2..4x4 of geometry code).
+ *
+ *     l2::gemv<3, 4>(CblasColMajor, CblasNoTrans, 1.0, R, 3, p, 1, 0.0, q, 1);
+ *     l2::symv<6>(CblasRowMajor, CblasLower, 1.0f, P, 6, v, 1, 0.0f, w, 1);
+ *     l2::trmv<4>(CblasColMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+ *                 T, 4, x, 1);
+ *
+ * Arguments are the cblas ones minus the sizes, float or double.  At these
+ * sizes the library call (argument checks, kernel and thread dispatch,
+ * stride setup) costs more than the arithmetic, so everything here is
+ * inline: order/trans/uplo/diag pick one of a few template instances, x is
+ * copied into a local array, and the multiply-adds are fully unrolled over
+ * compile-time bounds so the compiler keeps the whole problem in registers.
+ *
+ * The overloads taking runtime sizes (same arguments as cblas) use the
+ * fixed-size kernels for square orders 2..16 (dgemv 2..14) and call
+ * cblas_?gemv/symv/trmv otherwise; with l2blas_cblas.h included first that is l2blas.  Invalid
+ * arguments (an order/trans/uplo/diag value cblas does not define, lda too
+ * small, zero increment) also go to cblas, which reports them through
+ * xerbla.  ConjNoTrans and ConjTrans are NoTrans and Trans, as in cblas.
+ */
+#ifndef L2BLAS_SMALL_HPP
+#define L2BLAS_SMALL_HPP
+
+#include <utility>
+#include <cblas.h>
+
+#define L2_SMALL_MAX 16
+
+#define L2_SMALL_UNROLL _Pragma("GCC unroll 16")
+
+namespace l2 {
+
+namespace small_detail {
+
+/* Keeps alpha/beta out of template argument deduction: 1.0 works for float. */
+template <typename T> struct same { typedef T type; };
+
+/*
+ * Largest square order the runtime-size gemv hands to the fixed kernel.
+ * At double 16 x 16 the unrolled kernel no longer beats the library call
+ * (bench_l2_small: about 65-95 ns fixed against 60-90 ns for OpenBLAS);
+ * float keeps winning up to 16.
+ */
+template <typename T> struct gemv_max { static const int value = 16; };
+template <> struct gemv_max<double> { static const int value = 14; };
+
+inline void cblas_gemv(CBLAS_ORDER o, CBLAS_TRANSPOSE t, blasint m,
+                       blasint n, float alpha, const float *a, blasint lda,
+                       const float *x, blasint incx, float beta, float *y,
+                       blasint incy) {
+    cblas_sgemv(o, t, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+inline void cblas_gemv(CBLAS_ORDER o, CBLAS_TRANSPOSE t, blasint m,
+                       blasint n, double alpha, const double *a, blasint lda,
+                       const double *x, blasint incx, double beta, double *y,
+                       blasint incy) {
+    cblas_dgemv(o, t, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+inline void cblas_symv(CBLAS_ORDER o, CBLAS_UPLO u, blasint n, float alpha,
+                       const float *a, blasint lda, const float *x,
+                       blasint incx, float beta, float *y, blasint incy) {
+    cblas_ssymv(o, u, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+inline void cblas_symv(CBLAS_ORDER o, CBLAS_UPLO u, blasint n, double alpha,
+                       const double *a, blasint lda, const double *x,
+                       blasint incx, double beta, double *y, blasint incy) {
+    cblas_dsymv(o, u, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+inline void cblas_trmv(CBLAS_ORDER o, CBLAS_UPLO u, CBLAS_TRANSPOSE t,
+                       CBLAS_DIAG d, blasint n, const float *a, blasint lda,
+                       float *x, blasint incx) {
+    cblas_strmv(o, u, t, d, n, a, lda, x, incx);
+}
+
+inline void cblas_trmv(CBLAS_ORDER o, CBLAS_UPLO u, CBLAS_TRANSPOSE t,
+                       CBLAS_DIAG d, blasint n, const double *a, blasint lda,
+                       double *x, blasint incx) {
+    cblas_dtrmv(o, u, t, d, n, a, lda, x, incx);
+}
+
+/*
+ * 1 for NoTrans/ConjNoTrans, 0 for Trans/ConjTrans (conjugation means
+ * nothing for real data), -1 for a value cblas rejects.
+ */
+inline int plain(CBLAS_TRANSPOSE t) {
+    if (t == CblasNoTrans || t == CblasConjNoTrans) return 1;
+    if (t == CblasTrans || t == CblasConjTrans) return 0;
+    return -1;
+}
+
+inline bool valid(CBLAS_ORDER o) {
+    return o == CblasColMajor || o == CblasRowMajor;
+}
+
+inline bool valid(CBLAS_UPLO u) { return u == CblasUpper || u == CblasLower; }
+
+inline bool valid(CBLAS_DIAG d) { return d == CblasNonUnit || d == CblasUnit; }
+
+/* x[0..N) into v, the cblas way for a negative increment. */
+template <int N, typename T>
+inline void load(T *v, const T *x, blasint inc) {
+    if (inc == 1) {
+        __builtin_memcpy(v, x, N * sizeof(T));
+    } else {
+        if (inc < 0) x -= (N - 1) * inc;
+        L2_SMALL_UNROLL
+        for (int i = 0; i < N; i++) v[i] = x[i * inc];
+    }
+}
+
+/* y = alpha * t + beta * y; as in BLAS, t is ignored when alpha is 0 and
+ * y is not read when beta is 0. */
+template <int N, typename T>
+inline void store(T *y, blasint inc, const T *t, T alpha, T beta) {
+    if (inc < 0) y -= (N - 1) * inc;
+    if (alpha == T(0)) {
+        L2_SMALL_UNROLL
+        for (int i = 0; i < N; i++)
+            y[i * inc] = beta == T(0) ? T(0) : beta * y[i * inc];
+    } else if (beta == T(0)) {
+        L2_SMALL_UNROLL
+        for (int i = 0; i < N; i++) y[i * inc] = alpha * t[i];
+    } else {
+        L2_SMALL_UNROLL
+        for (int i = 0; i < N; i++)
+            y[i * inc] = alpha * t[i] + beta * y[i * inc];
+    }
+}
+
+/*
+ * Widest vector the including translation unit is compiled for; the
+ * kernels are inlined into the caller, so its -m / -march flags decide.
+ */
+#if defined(__AVX512F__)
+#define L2_SMALL_VBYTES 64
+#elif defined(__AVX__)
+#define L2_SMALL_VBYTES 32
+#else
+#define L2_SMALL_VBYTES 16
+#endif
+
+template <typename T, int BYTES> struct vec {
+    typedef T type __attribute__((vector_size(BYTES)));
+};
+
+template <int BYTES, typename T>
+inline typename vec<T, BYTES>::type vload(const T *p) {
+    typename vec<T, BYTES>::type v;
+    __builtin_memcpy(&v, p, BYTES);
+    return v;
+}
+
+/* Lanes [O, O + L/2) of v as a vector of half the width. */
+template <int BYTES, int O, typename T, int... I>
+inline typename vec<T, BYTES / 2>::type
+vhalf(typename vec<T, BYTES>::type v, std::integer_sequence<int, I...>) {
+    return __builtin_shufflevector(v, v, (O + I)...);
+}
+
+/* Sum of the lanes, adding the halves down to 16 bytes. */
+template <int BYTES, typename T>
+inline T vsum(typename vec<T, BYTES>::type v) {
+    constexpr int L = BYTES / (int)sizeof(T);
+
+    if constexpr (BYTES > 16) {
+        auto half = std::make_integer_sequence<int, L / 2>();
+        return vsum<BYTES / 2, T>(vhalf<BYTES, 0, T>(v, half) +
+                                  vhalf<BYTES, L / 2, T>(v, half));
+    } else {
+        T s = v[0];
+        L2_SMALL_UNROLL
+        for (int i = 1; i < L; i++) s += v[i];
+        return s;
+    }
+}
+
+/* Lane i of the result: p[2i] + p[2i+1] of the lanes of (p, q) in turn. */
+template <int BYTES, typename T, int... I>
+inline typename vec<T, BYTES>::type
+vpairs(typename vec<T, BYTES>::type p, typename vec<T, BYTES>::type q,
+       std::integer_sequence<int, I...>) {
+    return __builtin_shufflevector(p, q, (2 * I)...) +
+           __builtin_shufflevector(p, q, (2 * I + 1)...);
+}
+
+/*
+ * Rows [R0, R) of t = B * v, B(r, c) = a[r + c * ld]: each column is a
+ * run of vectors scaled by v[c] into register accumulators, the widest
+ * vectors first, then halves, then scalars for what is left.  Even and
+ * odd columns go to separate accumulators while registers allow, so the
+ * adds form two dependency chains instead of one.
+ */
+template <int R0, int R, int C, int BYTES, typename T>
+inline void mv_cols(T *t, const T *a, blasint ld, const T *v) {
+    constexpr int L = BYTES / (int)sizeof(T);
+
+    if constexpr (R0 >= R) {
+        return;
+    } else if constexpr (BYTES < 16) {
+        L2_SMALL_UNROLL
+        for (int r = R0; r < R; r++) t[r] = a[r] * v[0];
+        L2_SMALL_UNROLL
+        for (int c = 1; c < C; c++) {
+            L2_SMALL_UNROLL
+            for (int r = R0; r < R; r++) t[r] += a[r + c * ld] * v[c];
+        }
+    } else if constexpr (R - R0 < L) {
+        mv_cols<R0, R, C, BYTES / 2>(t, a, ld, v);
+    } else {
+        constexpr int NV = (R - R0) / L;
+        constexpr int NS = C >= 4 && NV <= 4 ? 2 : 1;
+        typename vec<T, BYTES>::type acc[NS][NV];
+
+        L2_SMALL_UNROLL
+        for (int c = 0; c < NS; c++) {
+            L2_SMALL_UNROLL
+            for (int k = 0; k < NV; k++)
+                acc[c][k] = vload<BYTES>(a + R0 + k * L + c * ld) * v[c];
+        }
+        L2_SMALL_UNROLL
+        for (int c = NS; c < C; c++) {
+            L2_SMALL_UNROLL
+            for (int k = 0; k < NV; k++)
+                acc[c % NS][k] +=
+                    vload<BYTES>(a + R0 + k * L + c * ld) * v[c];
+        }
+        L2_SMALL_UNROLL
+        for (int k = 0; k < NV; k++) {
+            if constexpr (NS == 2) acc[0][k] += acc[1][k];
+            __builtin_memcpy(t + R0 + k * L, &acc[0][k], BYTES);
+        }
+        mv_cols<R0 + NV * L, R, C, BYTES / 2>(t, a, ld, v);
+    }
+}
+
+/*
+ * t[0..R) = (ADD ? t : 0) + columns [C0, C) of B * v, B(r, c) = a[r * ld
+ * + c]: rows are dot products, taken L rows at a time so the L product
+ * vectors reduce to one vector of L sums (L - 1 shuffle-adds rather than
+ * a horizontal sum per row).  Columns the widest vector does not cover
+ * go round again with narrower ones.
+ */
+template <int R, int C0, int C, int BYTES, bool ADD, typename T>
+inline void mv_rows(T *t, const T *a, blasint ld, const T *v) {
+    typedef typename vec<T, BYTES>::type V;
+    constexpr int L = BYTES / (int)sizeof(T);
+
+    if constexpr (C0 >= C) {
+        if constexpr (!ADD) {
+            L2_SMALL_UNROLL
+            for (int r = 0; r < R; r++) t[r] = 0;
+        }
+    } else if constexpr (BYTES < 16) {
+        L2_SMALL_UNROLL
+        for (int r = 0; r < R; r++) {
+            T s = a[r * ld + C0] * v[C0];
+            L2_SMALL_UNROLL
+            for (int c = C0 + 1; c < C; c++) s += a[r * ld + c] * v[c];
+            t[r] = ADD ? t[r] + s : s;
+        }
+    } else if constexpr (C - C0 < L) {
+        mv_rows<R, C0, C, BYTES / 2, ADD>(t, a, ld, v);
+    } else {
+        constexpr int NV = (C - C0) / L;
+        auto lanes = std::make_integer_sequence<int, L>();
+        V vv[NV];
+
+        L2_SMALL_UNROLL
+        for (int q = 0; q < NV; q++) vv[q] = vload<BYTES>(v + C0 + q * L);
+        L2_SMALL_UNROLL
+        for (int r0 = 0; r0 < R; r0 += L) {
+            int nr = R - r0 < L ? R - r0 : L;
+            V p[L];
+
+            L2_SMALL_UNROLL
+            for (int k = 0; k < nr; k++) {
+                const T *row = a + (r0 + k) * ld + C0;
+                p[k] = vload<BYTES>(row) * vv[0];
+                L2_SMALL_UNROLL
+                for (int q = 1; q < NV; q++)
+                    p[k] += vload<BYTES>(row + q * L) * vv[q];
+            }
+            if (nr == L) {
+                L2_SMALL_UNROLL
+                for (int w = L; w > 1; w /= 2) {
+                    L2_SMALL_UNROLL
+                    for (int i = 0; i < w / 2; i++)
+                        p[i] = vpairs<BYTES, T>(p[2 * i], p[2 * i + 1], lanes);
+                }
+                if (ADD) p[0] += vload<BYTES>(t + r0);
+                __builtin_memcpy(t + r0, &p[0], BYTES);
+            } else {
+                L2_SMALL_UNROLL
+                for (int k = 0; k < nr; k++) {
+                    T sum = vsum<BYTES, T>(p[k]);
+                    t[r0 + k] = ADD ? t[r0 + k] + sum : sum;
+                }
+            }
+        }
+        mv_rows<R, C0 + NV * L, C, BYTES / 2, true>(t, a, ld, v);
+    }
+}
+
+/*
+ * t = B * v for the R x C matrix B(r, c) = a[r + c * ld] (COLS) or
+ * a[r * ld + c].  COLS runs down the columns, whose adds are independent;
+ * otherwise each row is one dot product.
+ */
+template <int R, int C, bool COLS, typename T>
+inline void mv(T *t, const T *a, blasint ld, const T *v) {
+    /* The callers branch between layouts that load the same columns;
+     * hiding a from the optimiser keeps it from hoisting (and spilling)
+     * the loads of both branches above the branch. */
+    __asm__("" : "+r"(a));
+    if constexpr (COLS) {
+        mv_cols<0, R, C, L2_SMALL_VBYTES>(t, a, ld, v);
+    } else {
+        mv_rows<R, 0, C, L2_SMALL_VBYTES, false>(t, a, ld, v);
+    }
+}
+
+/*
+ * t = S * v, S symmetric with the triangle i >= j (LO) or i <= j of the
+ * column-major view a[i + j * ld] stored.  S is read column by column,
+ * mirroring the unstored half, so every access is a compile-time offset.
+ */
+template <int N, bool LO, typename T>
+inline void sv(T *t, const T *a, blasint ld, const T *v) {
+    L2_SMALL_UNROLL
+    for (int i = 0; i < N; i++) t[i] = 0;
+    L2_SMALL_UNROLL
+    for (int j = 0; j < N; j++) {
+        L2_SMALL_UNROLL
+        for (int i = 0; i < N; i++) {
+            bool stored = LO ? i >= j : i <= j;
+            t[i] += (stored ? a[i + j * ld] : a[j + i * ld]) * v[j];
+        }
+    }
+}
+
+/*
+ * t = op(A) * v for triangular op(A), element (i, j) at a[j + i * ld] when
+ * TR, else a[i + j * ld]; UP when op(A) is upper triangular.  The unit
+ * diagonal is a runtime choice: it only changes the first term of each t[i].
+ */
+template <int N, bool TR, bool UP, typename T>
+inline void tv(T *t, const T *a, blasint ld, const T *v, bool unit) {
+    L2_SMALL_UNROLL
+    for (int i = 0; i < N; i++) t[i] = unit ? v[i] : a[i + i * ld] * v[i];
+    L2_SMALL_UNROLL
+    for (int j = 0; j < N; j++) {
+        L2_SMALL_UNROLL
+        for (int i = 0; i < N; i++) {
+            if (UP ? i >= j : i <= j) continue;
+            t[i] += (TR ? a[j + i * ld] : a[i + j * ld]) * v[j];
+        }
+    }
+}
+
+}  // namespace small_detail
+
+/* y = alpha * op(A) * x + beta * y, A of M x N. */
+template <int M, int N, typename T>
+inline void gemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans,
+                 typename small_detail::same<T>::type alpha, const T *a,
+                 blasint lda, const T *x, blasint incx,
+                 typename small_detail::same<T>::type beta, T *y,
+                 blasint incy) {
+    static_assert(M >= 1 && M <= L2_SMALL_MAX && N >= 1 && N <= L2_SMALL_MAX,
+                  "l2::gemv: fixed sizes are 1..16");
+    using namespace small_detail;
+    int notrans = plain(trans);
+    bool cols = (order == CblasColMajor) == (notrans == 1);
+
+    if (notrans < 0 || !valid(order) ||
+        lda < (order == CblasColMajor ? M : N) || incx == 0 || incy == 0) {
+        cblas_gemv(order, trans, M, N, alpha, a, lda, x, incx, beta, y, incy);
+        return;
+    }
+    if (notrans) {
+        T v[N], t[M];
+        load<N>(v, x, incx);
+        if (cols) mv<M, N, true>(t, a, lda, v);
+        else      mv<M, N, false>(t, a, lda, v);
+        store<M>(y, incy, t, alpha, beta);
+    } else {
+        T v[M], t[N];
+        load<M>(v, x, incx);
+        if (cols) mv<N, M, true>(t, a, lda, v);
+        else      mv<N, M, false>(t, a, lda, v);
+        store<N>(y, incy, t, alpha, beta);
+    }
+}
+
+/* y = alpha * A * x + beta * y, A symmetric N x N, uplo triangle stored. */
+template <int N, typename T>
+inline void symv(CBLAS_ORDER order, CBLAS_UPLO uplo,
+                 typename small_detail::same<T>::type alpha, const T *a,
+                 blasint lda, const T *x, blasint incx,
+                 typename small_detail::same<T>::type beta, T *y,
+                 blasint incy) {
+    static_assert(N >= 1 && N <= L2_SMALL_MAX,
+                  "l2::symv: fixed sizes are 1..16");
+    using namespace small_detail;
+    T v[N], t[N];
+
+    if (!valid(order) || !valid(uplo) || lda < N || incx == 0 ||
+        incy == 0) {
+        cblas_symv(order, uplo, N, alpha, a, lda, x, incx, beta, y, incy);
+        return;
+    }
+    load<N>(v, x, incx);
+    if ((uplo == CblasLower) == (order == CblasColMajor))
+        sv<N, true>(t, a, lda, v);
+    else
+        sv<N, false>(t, a, lda, v);
+    store<N>(y, incy, t, T(alpha), T(beta));
+}
+
+/* x = op(A) * x, A triangular N x N. */
+template <int N, typename T>
+inline void trmv(CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans,
+                 CBLAS_DIAG diag, const T *a, blasint lda, T *x,
+                 blasint incx) {
+    static_assert(N >= 1 && N <= L2_SMALL_MAX,
+                  "l2::trmv: fixed sizes are 1..16");
+    using namespace small_detail;
+    int notrans = plain(trans);
+    bool tr = (order == CblasRowMajor) == (notrans == 1);
+    bool up = (uplo == CblasUpper) == (notrans == 1);
+    bool unit = diag == CblasUnit;
+    T v[N], t[N];
+
+    if (notrans < 0 || !valid(order) || !valid(uplo) || !valid(diag) ||
+        lda < N || incx == 0) {
+        cblas_trmv(order, uplo, trans, diag, N, a, lda, x, incx);
+        return;
+    }
+    load<N>(v, x, incx);
+    switch ((tr ? 2 : 0) + (up ? 1 : 0)) {
+    case 0: tv<N, false, false>(t, a, lda, v, unit); break;
+    case 1: tv<N, false, true>(t, a, lda, v, unit);  break;
+    case 2: tv<N, true, false>(t, a, lda, v, unit);  break;
+    default: tv<N, true, true>(t, a, lda, v, unit);  break;
+    }
+    if (incx < 0) x -= (N - 1) * incx;
+    L2_SMALL_UNROLL
+    for (int i = 0; i < N; i++) x[i * incx] = t[i];
+}
+
+/* ---- runtime sizes ------------------------------------------------------- */
+
+#define L2_SMALL_CASES(C) \
+    C(2) C(3) C(4) C(5) C(6) C(7) C(8) C(9) C(10) C(11) C(12) C(13) C(14) \
+    C(15) C(16)
+
+/* cblas_?gemv arguments; square 2..small_detail::gemv_max<T> take the
+ * fixed-size path. */
+template <typename T>
+inline void gemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, blasint m,
+                 blasint n, typename small_detail::same<T>::type alpha,
+                 const T *a, blasint lda, const T *x, blasint incx,
+                 typename small_detail::same<T>::type beta, T *y,
+                 blasint incy) {
+    if (m == n && n <= small_detail::gemv_max<T>::value) {
+        switch (n) {
+#define L2_SMALL_CASE(k) \
+        case k: gemv<k, k, T>(order, trans, alpha, a, lda, x, incx, beta, \
+                              y, incy); return;
+        L2_SMALL_CASES(L2_SMALL_CASE)
+#undef L2_SMALL_CASE
+        }
+    }
+    small_detail::cblas_gemv(order, trans, m, n, alpha, a, lda, x, incx, beta,
+                             y, incy);
+}
+
+/* cblas_?symv arguments; orders 2..16 take the fixed-size path. */
+template <typename T>
+inline void symv(CBLAS_ORDER order, CBLAS_UPLO uplo, blasint n,
+                 typename small_detail::same<T>::type alpha, const T *a,
+                 blasint lda, const T *x, blasint incx,
+                 typename small_detail::same<T>::type beta, T *y,
+                 blasint incy) {
+    switch (n) {
+#define L2_SMALL_CASE(k) \
+    case k: symv<k, T>(order, uplo, alpha, a, lda, x, incx, beta, y, incy); \
+            return;
+    L2_SMALL_CASES(L2_SMALL_CASE)
+#undef L2_SMALL_CASE
+    }
+    small_detail::cblas_symv(order, uplo, n, alpha, a, lda, x, incx, beta, y,
+                             incy);
+}
+
+/* cblas_?trmv arguments; orders 2..16 take the fixed-size path. */
+template <typename T>
+inline void trmv(CBLAS_ORDER order, CBLAS_UPLO uplo, CBLAS_TRANSPOSE trans,
+                 CBLAS_DIAG diag, blasint n, const T *a, blasint lda, T *x,
+                 blasint incx) {
+    switch (n) {
+#define L2_SMALL_CASE(k) \
+    case k: trmv<k, T>(order, uplo, trans, diag, a, lda, x, incx); return;
+    L2_SMALL_CASES(L2_SMALL_CASE)
+#undef L2_SMALL_CASE
+    }
+    small_detail::cblas_trmv(order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+#undef L2_SMALL_CASES
+
+}  // namespace l2
+
+#undef L2_SMALL_UNROLL
+#undef L2_SMALL_VBYTES
+
+#endif /* L2BLAS_SMALL_HPP */
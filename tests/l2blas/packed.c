@@ -0,0 +1,256 @@
+/*
+ * Packed-storage routines: ?spmv/?hpmv, ?tpmv, ?tpsv, ?spr/?hpr and
+ * ?spr2/?hpr2.
+ *
+ * A packed triangle holds n(n+1)/2 elements instead of n*n, so these read
+ * half the bytes of their full-storage counterparts.  Every packed column is
+ * contiguous, and the drivers hand each one to the SIMD gemv kernels as an
+ * m x 1 panel (for spmv, to the fused symv panel kernel, so A is still read
+ * once).  See packed_template.h.
+ */
+#include "l2blas_internal.h"
+
+/* Offset in elements of the first stored entry of packed column j. */
+static BLASLONG packed_col(int lower, BLASLONG n, BLASLONG j) {
+    return lower ? j * (2 * n - j + 1) / 2 : j * (j + 1) / 2;
+}
+
+/*
+ * Returns the cblas parameter number of the first illegal argument, or 0;
+ * incx_pos / incy_pos give the positions of the increments in the routine's
+ * argument list (incy_pos 0: no y).
+ */
+static int packed_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                        blasint n, blasint incx, int incx_pos,
+                        blasint incy, int incy_pos) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (uplo != CblasUpper && uplo != CblasLower) return 2;
+    if (n < 0) return 3;
+    if (incx == 0) return incx_pos;
+    if (incy_pos && incy == 0) return incy_pos;
+    return 0;
+}
+
+static int tpxv_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                      enum CBLAS_TRANSPOSE trans, enum CBLAS_DIAG diag,
+                      blasint n, blasint incx) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (uplo != CblasUpper && uplo != CblasLower) return 2;
+    if (trans != CblasNoTrans && trans != CblasTrans &&
+        trans != CblasConjTrans && trans != CblasConjNoTrans) return 3;
+    if (diag != CblasUnit && diag != CblasNonUnit) return 4;
+    if (n < 0) return 5;
+    if (incx == 0) return 8;
+    return 0;
+}
+
+static const float  c_one[2] = {1.0f, 0.0f};
+static const double z_one[2] = {1.0, 0.0};
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define AXPY_A(m, s, a, y, incy, conj) \
+    l2_sgemv_pick(1, 1, incy)(m, 1, 1.0f, a, m, s, 1, y, incy)
+#define DOT_A(m, a, x, incx, acc, conj) \
+    l2_sgemv_pick(0, incx, 1)(m, 1, 1.0f, a, m, x, incx, acc, 1)
+#define SYMV_PANEL(m, alpha, a, x1, y1, x2, y2) \
+    l2_ssymv_panel_pick()(m, 1, alpha, a, m, x1, y1, x2, y2)
+#include "colops_template.h"
+#include "packed_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef AXPY_A
+#undef DOT_A
+#undef SYMV_PANEL
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define AXPY_A(m, s, a, y, incy, conj) \
+    l2_dgemv_pick(1, 1, incy)(m, 1, 1.0, a, m, s, 1, y, incy)
+#define DOT_A(m, a, x, incx, acc, conj) \
+    l2_dgemv_pick(0, incx, 1)(m, 1, 1.0, a, m, x, incx, acc, 1)
+#define SYMV_PANEL(m, alpha, a, x1, y1, x2, y2) \
+    l2_dsymv_panel_pick()(m, 1, alpha, a, m, x1, y1, x2, y2)
+#include "colops_template.h"
+#include "packed_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef AXPY_A
+#undef DOT_A
+#undef SYMV_PANEL
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define AXPY_A(m, s, a, y, incy, conj) \
+    l2_cgemv_n_generic(m, 1, c_one, a, m, s, 1, y, incy, conj)
+#define DOT_A(m, a, x, incx, acc, conj) \
+    l2_cgemv_t_generic(m, 1, c_one, a, m, x, incx, acc, 1, conj)
+#include "colops_template.h"
+#include "packed_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef AXPY_A
+#undef DOT_A
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define AXPY_A(m, s, a, y, incy, conj) \
+    l2_zgemv_n_generic(m, 1, z_one, a, m, s, 1, y, incy, conj)
+#define DOT_A(m, a, x, incx, acc, conj) \
+    l2_zgemv_t_generic(m, 1, z_one, a, m, x, incx, acc, 1, conj)
+#include "colops_template.h"
+#include "packed_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef AXPY_A
+#undef DOT_A
+
+/* ---- cblas-compatible entry points ---------------------------------------- */
+
+void l2_sspmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const float alpha, const float *ap,
+              const float *x, const blasint incx, const float beta,
+              float *y, const blasint incy) {
+    sspmv_driver("l2_sspmv", order, uplo, n, &alpha, ap, x, incx, &beta, y,
+                 incy);
+}
+
+void l2_dspmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const double alpha, const double *ap,
+              const double *x, const blasint incx, const double beta,
+              double *y, const blasint incy) {
+    dspmv_driver("l2_dspmv", order, uplo, n, &alpha, ap, x, incx, &beta, y,
+                 incy);
+}
+
+void l2_chpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *ap,
+              const void *x, const blasint incx, const void *beta, void *y,
+              const blasint incy) {
+    cspmv_driver("l2_chpmv", order, uplo, n, alpha, ap, x, incx, beta, y,
+                 incy);
+}
+
+void l2_zhpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *ap,
+              const void *x, const blasint incx, const void *beta, void *y,
+              const blasint incy) {
+    zspmv_driver("l2_zhpmv", order, uplo, n, alpha, ap, x, incx, beta, y,
+                 incy);
+}
+
+void l2_stpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const float *ap, float *x,
+              const blasint incx) {
+    stpxv_driver("l2_stpmv", 0, order, uplo, trans, diag, n, ap, x, incx);
+}
+
+void l2_dtpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const double *ap, double *x,
+              const blasint incx) {
+    dtpxv_driver("l2_dtpmv", 0, order, uplo, trans, diag, n, ap, x, incx);
+}
+
+void l2_ctpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *ap, void *x, const blasint incx) {
+    ctpxv_driver("l2_ctpmv", 0, order, uplo, trans, diag, n, ap, x, incx);
+}
+
+void l2_ztpmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *ap, void *x, const blasint incx) {
+    ztpxv_driver("l2_ztpmv", 0, order, uplo, trans, diag, n, ap, x, incx);
+}
+
+void l2_stpsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const float *ap, float *x,
+              const blasint incx) {
+    stpxv_driver("l2_stpsv", 1, order, uplo, trans, diag, n, ap, x, incx);
+}
+
+void l2_dtpsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const double *ap, double *x,
+              const blasint incx) {
+    dtpxv_driver("l2_dtpsv", 1, order, uplo, trans, diag, n, ap, x, incx);
+}
+
+void l2_ctpsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *ap, void *x, const blasint incx) {
+    ctpxv_driver("l2_ctpsv", 1, order, uplo, trans, diag, n, ap, x, incx);
+}
+
+void l2_ztpsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *ap, void *x, const blasint incx) {
+    ztpxv_driver("l2_ztpsv", 1, order, uplo, trans, diag, n, ap, x, incx);
+}
+
+void l2_sspr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const float alpha, const float *x,
+             const blasint incx, float *ap) {
+    sspr_driver("l2_sspr", order, uplo, n, &alpha, x, incx, ap);
+}
+
+void l2_dspr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const double alpha, const double *x,
+             const blasint incx, double *ap) {
+    dspr_driver("l2_dspr", order, uplo, n, &alpha, x, incx, ap);
+}
+
+void l2_chpr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const float alpha, const void *x,
+             const blasint incx, void *ap) {
+    const float calpha[2] = {alpha, 0.0f};
+
+    cspr_driver("l2_chpr", order, uplo, n, calpha, x, incx, ap);
+}
+
+void l2_zhpr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const double alpha, const void *x,
+             const blasint incx, void *ap) {
+    const double zalpha[2] = {alpha, 0.0};
+
+    zspr_driver("l2_zhpr", order, uplo, n, zalpha, x, incx, ap);
+}
+
+void l2_sspr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const float alpha, const float *x,
+              const blasint incx, const float *y, const blasint incy,
+              float *ap) {
+    sspr2_driver("l2_sspr2", order, uplo, n, &alpha, x, incx, y, incy, ap);
+}
+
+void l2_dspr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const double alpha, const double *x,
+              const blasint incx, const double *y, const blasint incy,
+              double *ap) {
+    dspr2_driver("l2_dspr2", order, uplo, n, &alpha, x, incx, y, incy, ap);
+}
+
+void l2_chpr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *ap) {
+    cspr2_driver("l2_chpr2", order, uplo, n, alpha, x, incx, y, incy, ap);
+}
+
+void l2_zhpr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *ap) {
+    zspr2_driver("l2_zhpr2", order, uplo, n, alpha, x, incx, y, incy, ap);
+}
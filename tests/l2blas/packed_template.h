@@ -0,0 +1,190 @@
+/*
+ * Packed-storage bodies, included once per precision by packed.c with
+ *   FLOAT     element type (float or double)
+ *   CS        reals per element (1 real, 2 complex)
+ *   PREC      name prefix (s, d, c, z)
+ * defined, after colops_template.h for the same precision.
+ *
+ * Everything is column-major packed: column j of the upper triangle holds
+ * rows 0..j, column j of the lower triangle rows j..n-1, back to back.  A
+ * RowMajor triangle is the opposite ColMajor triangle of the transpose, so
+ * the drivers only ever walk whole packed columns front to back, and every
+ * off-diagonal column segment is one call to a gemv (or symv panel) kernel.
+ *
+ * For Hermitian data that transpose is the conjugate: with RowMajor order
+ * the stored triangle holds conj(A), which the drivers track as "cj".
+ */
+
+#define PK_CAT_(a, b) a##b
+#define PK_CAT(a, b) PK_CAT_(a, b)
+#define PK_FN(name) PK_CAT(PREC, name)
+
+/* y := alpha * A * x + beta * y; spmv for real data, hpmv for complex. */
+static void PK_FN(spmv_driver)(const char *rname, enum CBLAS_ORDER order,
+                               enum CBLAS_UPLO uplo, blasint n,
+                               const FLOAT *alpha, const FLOAT *ap,
+                               const FLOAT *x, blasint incx,
+                               const FLOAT *beta, FLOAT *y, blasint incy) {
+    int info = packed_check(order, uplo, n, incx, 7, incy, 10);
+    int lower, cj = CS == 2 && order == CblasRowMajor;
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (n == 0 || (COL_IS_ZERO(alpha) && COL_IS_ONE(beta))) return;
+
+    x = L2_VEC_BASE(x, n, incx * CS);
+    y = L2_VEC_BASE(y, n, incy * CS);
+    if (!COL_IS_ONE(beta)) {
+        for (BLASLONG i = 0; i < n; i++) {
+            FLOAT *yi = y + i * incy * CS;
+            if (COL_IS_ZERO(beta))
+                for (int k = 0; k < CS; k++) yi[k] = 0;
+            else
+                PK_FN(col_mul)(yi, beta, yi, 0);
+        }
+    }
+    if (COL_IS_ZERO(alpha)) return;
+
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    for (BLASLONG j = 0; j < n; j++) {
+        const FLOAT *col = ap + packed_col(lower, n, j) * CS;
+        const FLOAT *d = lower ? col : col + j * CS;
+        const FLOAT *xj = x + j * incx * CS;
+        FLOAT *yj = y + j * incy * CS;
+        BLASLONG i0 = lower ? j + 1 : 0, m = lower ? n - j - 1 : j;
+        FLOAT t[CS];
+
+        PK_FN(col_symv)(m, alpha, lower ? col + CS : col,
+                         x + i0 * incx * CS, incx, y + i0 * incy * CS, incy,
+                         xj, yj, cj);
+        /* The imaginary part of a Hermitian diagonal is taken as zero. */
+        PK_FN(col_mul)(t, alpha, xj, 0);
+        for (int k = 0; k < CS; k++) yj[k] += t[k] * d[0];
+    }
+}
+
+/* x := op(A) * x (tpmv) or x := op(A)^-1 * x (tpsv). */
+static void PK_FN(tpxv_driver)(const char *rname, int solve,
+                               enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                               enum CBLAS_TRANSPOSE trans,
+                               enum CBLAS_DIAG diag, blasint n,
+                               const FLOAT *ap, FLOAT *x, blasint incx) {
+    int info = tpxv_check(order, uplo, trans, diag, n, incx);
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int conj = CS == 2 &&
+               (trans == CblasConjTrans || trans == CblasConjNoTrans);
+    int unit = diag == CblasUnit, lower, notrans, forward;
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (n == 0) return;
+
+    /* A RowMajor triangle is the opposite ColMajor triangle, transposed. */
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    notrans = plain == (order == CblasColMajor);
+    x = L2_VEC_BASE(x, n, incx * CS);
+
+    /*
+     * The product runs against the direction of the solve so that every
+     * column only reads entries of x it has not overwritten yet.
+     */
+    forward = solve ? lower == notrans : lower != notrans;
+    for (BLASLONG k = 0; k < n; k++) {
+        BLASLONG j = forward ? k : n - 1 - k;
+        const FLOAT *col = ap + packed_col(lower, n, j) * CS;
+        const FLOAT *d = lower ? col : col + j * CS;
+        const FLOAT *a = lower ? col + CS : col;
+        BLASLONG i0 = lower ? j + 1 : 0, m = lower ? n - j - 1 : j;
+        FLOAT *xj = x + j * incx * CS, *xo = x + i0 * incx * CS;
+        FLOAT t[CS];
+
+        if (notrans) {
+            if (solve && !unit) PK_FN(col_div)(xj, d, conj);
+            for (int c = 0; c < CS; c++) t[c] = solve ? -xj[c] : xj[c];
+            PK_FN(col_axpy)(m, t, a, 1, xo, incx, conj);
+            if (!solve && !unit) PK_FN(col_mul)(xj, xj, d, conj);
+        } else if (solve) {
+            for (int c = 0; c < CS; c++) t[c] = 0;
+            PK_FN(col_dot)(m, a, xo, incx, t, conj);
+            for (int c = 0; c < CS; c++) xj[c] -= t[c];
+            if (!unit) PK_FN(col_div)(xj, d, conj);
+        } else {
+            if (unit)
+                for (int c = 0; c < CS; c++) t[c] = xj[c];
+            else
+                PK_FN(col_mul)(t, xj, d, conj);
+            PK_FN(col_dot)(m, a, xo, incx, t, conj);
+            for (int c = 0; c < CS; c++) xj[c] = t[c];
+        }
+    }
+}
+
+/*
+ * A := alpha * x * x^H + A (spr for real data, hpr for complex with a real
+ * alpha passed as alpha[0] + 0i).  Each packed column takes one axpy of the
+ * matching segment of x.
+ */
+static void PK_FN(spr_driver)(const char *rname, enum CBLAS_ORDER order,
+                              enum CBLAS_UPLO uplo, blasint n,
+                              const FLOAT *alpha, const FLOAT *x,
+                              blasint incx, FLOAT *ap) {
+    int info = packed_check(order, uplo, n, incx, 6, 1, 0);
+    int lower, cj = CS == 2 && order == CblasRowMajor;
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (n == 0 || COL_IS_ZERO(alpha)) return;
+
+    x = L2_VEC_BASE(x, n, incx * CS);
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    for (BLASLONG j = 0; j < n; j++) {
+        FLOAT *col = ap + packed_col(lower, n, j) * CS;
+        BLASLONG i0 = lower ? j : 0, m = lower ? n - j : j + 1;
+        FLOAT s[CS];
+
+        /* Column j gains alpha * x * conj(x_j); cj stores its conjugate. */
+        PK_FN(col_mul)(s, alpha, x + j * incx * CS, CS == 2 && !cj);
+        PK_FN(col_axpy)(m, s, x + i0 * incx * CS, incx, col, 1, cj);
+#if CS == 2
+        (lower ? col : col + j * CS)[1] = 0;
+#endif
+    }
+}
+
+/* A := alpha * x * y^H + conj(alpha) * y * x^H + A (spr2 / hpr2). */
+static void PK_FN(spr2_driver)(const char *rname, enum CBLAS_ORDER order,
+                               enum CBLAS_UPLO uplo, blasint n,
+                               const FLOAT *alpha, const FLOAT *x,
+                               blasint incx, const FLOAT *y, blasint incy,
+                               FLOAT *ap) {
+    int info = packed_check(order, uplo, n, incx, 6, incy, 8);
+    int lower, cj = CS == 2 && order == CblasRowMajor;
+    FLOAT calpha[CS];
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (n == 0 || COL_IS_ZERO(alpha)) return;
+
+    calpha[0] = alpha[0];
+#if CS == 2
+    calpha[1] = -alpha[1];
+#endif
+    x = L2_VEC_BASE(x, n, incx * CS);
+    y = L2_VEC_BASE(y, n, incy * CS);
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    for (BLASLONG j = 0; j < n; j++) {
+        FLOAT *col = ap + packed_col(lower, n, j) * CS;
+        BLASLONG i0 = lower ? j : 0, m = lower ? n - j : j + 1;
+        FLOAT s1[CS], s2[CS];
+
+        PK_FN(col_mul)(s1, cj ? calpha : alpha, y + j * incy * CS,
+                      CS == 2 && !cj);
+        PK_FN(col_mul)(s2, cj ? alpha : calpha, x + j * incx * CS,
+                      CS == 2 && !cj);
+        PK_FN(col_axpy)(m, s1, x + i0 * incx * CS, incx, col, 1, cj);
+        PK_FN(col_axpy)(m, s2, y + i0 * incy * CS, incy, col, 1, cj);
+#if CS == 2
+        (lower ? col : col + j * CS)[1] = 0;
+#endif
+    }
+}
+
+#undef PK_FN
+#undef PK_CAT
+#undef PK_CAT_
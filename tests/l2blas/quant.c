@@ -0,0 +1,346 @@
+#include <stddef.h>
+#include <float.h>
+#include <math.h>
+#include "l2blas_internal.h"
+
+/*
+ * int8-weight gemv.  l2_sq8_quantize rounds A once to int8 with a float
+ * scale per row or per block of a row and lays it out row-major, so that
+ * NoTrans is a dot product of each row with x and Trans adds scaled rows
+ * into y, both streaming a quarter of the bytes of sgemv.  NoTrans in
+ * int32 quantizes each chunk of x on the stack and multiplies int8 by int8
+ * (vpdpbusd or vpmaddubsw, exact in int32), one float multiply-add per row
+ * and block turning the sums back into floats; everything else widens A to
+ * float as it is loaded.  A's rows are padded with zeros to a multiple of
+ * 64 bytes and the x and y chunks likewise, so no kernel has a tail.
+ */
+
+/* ---- portable kernels --------------------------------------------------- */
+
+void l2_q8dot_generic(BLASLONG m, BLASLONG len, BLASLONG block,
+                      const int8_t *q, BLASLONG ldq, const float *scale,
+                      BLASLONG lds, const int8_t *xq, float mult, float *y,
+                      BLASLONG incy) {
+    for (BLASLONG i = 0; i < m; i++) {
+        const int8_t *row = q + i * ldq;
+        float s = 0.0f;
+
+        for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+            BLASLONG k1 = L2_MIN(len, k0 + block);
+            int32_t d = 0;
+            for (BLASLONG k = k0; k < k1; k++)
+                d += (int32_t)row[k] * xq[k];
+            s += scale[i * lds + b] * (float)d;
+        }
+        y[i * incy] += mult * s;
+    }
+}
+
+void l2_q8dotf_generic(BLASLONG m, BLASLONG len, BLASLONG block,
+                       const int8_t *q, BLASLONG ldq, const float *scale,
+                       BLASLONG lds, const float *x, float mult, float *y,
+                       BLASLONG incy) {
+    for (BLASLONG i = 0; i < m; i++) {
+        const int8_t *row = q + i * ldq;
+        float s = 0.0f;
+
+        for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+            BLASLONG k1 = L2_MIN(len, k0 + block);
+            float d = 0.0f;
+            for (BLASLONG k = k0; k < k1; k++)
+                d += (float)row[k] * x[k];
+            s += scale[i * lds + b] * d;
+        }
+        y[i * incy] += mult * s;
+    }
+}
+
+void l2_q8axpy_generic(BLASLONG m, BLASLONG len, BLASLONG block,
+                       const int8_t *q, BLASLONG ldq, const float *scale,
+                       BLASLONG lds, const float *tx, float *y) {
+    for (BLASLONG i = 0; i < m; i++) {
+        const int8_t *row = q + i * ldq;
+
+        for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+            BLASLONG k1 = L2_MIN(len, k0 + block);
+            float t = tx[i] * scale[i * lds + b];
+            for (BLASLONG k = k0; k < k1; k++)
+                y[k] += t * (float)row[k];
+        }
+    }
+}
+
+/* ---- dispatch ------------------------------------------------------------ */
+
+/*
+ * The avx512 kernels are built with AVX512BW and AVX512_VNNI, which
+ * l2_core() does not check for; without them the AVX2 ones run.
+ */
+static int q8_core(void) {
+    int core = l2_core();
+
+    if (core == L2_CORE_AVX512 && !(__builtin_cpu_supports("avx512bw") &&
+                                    __builtin_cpu_supports("avx512vnni")))
+        return L2_CORE_AVX2;
+    return core;
+}
+
+l2_q8dot_kernel l2_q8dot_pick(void) {
+    switch (q8_core()) {
+    case L2_CORE_AVX512: return l2_q8dot_avx512;
+    case L2_CORE_AVX2:   return l2_q8dot_avx2;
+    default:             return l2_q8dot_generic;
+    }
+}
+
+l2_q8dotf_kernel l2_q8dotf_pick(void) {
+    switch (q8_core()) {
+    case L2_CORE_AVX512: return l2_q8dotf_avx512;
+    case L2_CORE_AVX2:   return l2_q8dotf_avx2;
+    default:             return l2_q8dotf_generic;
+    }
+}
+
+l2_q8axpy_kernel l2_q8axpy_pick(void) {
+    switch (q8_core()) {
+    case L2_CORE_AVX512: return l2_q8axpy_avx512;
+    case L2_CORE_AVX2:   return l2_q8axpy_avx2;
+    default:             return l2_q8axpy_generic;
+    }
+}
+
+/* ---- quantize ------------------------------------------------------------ */
+
+/* Rows quantized together, so ColMajor A is read down whole cache lines. */
+#define Q8_TB 64
+
+static int quantize_check(enum CBLAS_ORDER order, blasint m, blasint n,
+                          blasint lda, blasint block, size_t lwork) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 2;
+    if (m < 0) return 3;
+    if (n < 0) return 4;
+    if (lda < L2_MAX(1, order == CblasColMajor ? m : n)) return 6;
+    if (block < 0 || block % 32 != 0) return 7;
+    if (lwork < L2_Q8_LWORK(m, n, block)) return 9;
+    return 0;
+}
+
+void l2_sq8_quantize(l2_sq8mat *qa, const enum CBLAS_ORDER order,
+                     const blasint m, const blasint n, const float *a,
+                     const blasint lda, const blasint block, void *work,
+                     const size_t lwork) {
+    int info = quantize_check(order, m, n, lda, block, lwork);
+    BLASLONG rs, cs, qb;
+
+    if (info) {
+        qa->m = -1;
+        l2_xerbla("l2_sq8_quantize", info);
+        return;
+    }
+    qa->m = m;
+    qa->n = n;
+    qa->ldq = (BLASLONG)L2_Q8_LDQ(n);
+    qa->lds = (BLASLONG)L2_Q8_NBLOCKS(n, block);
+    /* a row scale is one block over the whole padded row */
+    qa->block = block > 0 ? block : qa->ldq;
+    qa->scale = work;
+    qa->q = (int8_t *)(qa->scale + (size_t)m * qa->lds);
+
+    rs = order == CblasColMajor ? 1 : lda;
+    cs = order == CblasColMajor ? lda : 1;
+    qb = block > 0 ? block : n;
+
+    for (BLASLONG i0 = 0; i0 < m; i0 += Q8_TB) {
+        BLASLONG ib = L2_MIN(Q8_TB, (BLASLONG)m - i0);
+        const float *ai = a + i0 * rs;
+        float amax[Q8_TB], inv[Q8_TB];
+        int fin[Q8_TB];
+
+        for (BLASLONG b = 0; b < qa->lds; b++) {
+            BLASLONG j0 = b * qb, j1 = L2_MIN((BLASLONG)n, j0 + qb);
+
+            for (BLASLONG i = 0; i < ib; i++) {
+                amax[i] = 0.0f;
+                fin[i] = 1;
+            }
+            for (BLASLONG j = j0; j < j1; j++)
+                for (BLASLONG i = 0; i < ib; i++) {
+                    float v = fabsf(ai[i * rs + j * cs]);
+                    fin[i] &= v <= FLT_MAX;
+                    amax[i] = fmaxf(amax[i], v);
+                }
+            /* fmaxf skips NaN; NaN or infinity: a NaN scale, zero weights */
+            for (BLASLONG i = 0; i < ib; i++) {
+                qa->scale[(i0 + i) * qa->lds + b] =
+                    fin[i] ? amax[i] / 127.0f : NAN;
+                inv[i] = fin[i] && amax[i] > 0.0f ? 127.0f / amax[i] : 0.0f;
+            }
+            for (BLASLONG j = j0; j < j1; j++)
+                for (BLASLONG i = 0; i < ib; i++)
+                    qa->q[(i0 + i) * qa->ldq + j] = inv[i] > 0.0f
+                        ? (int8_t)lrintf(ai[i * rs + j * cs] * inv[i]) : 0;
+        }
+        for (BLASLONG i = 0; i < ib; i++)
+            memset(qa->q + (i0 + i) * qa->ldq + n, 0, (size_t)(qa->ldq - n));
+    }
+}
+
+/* ---- gemv ---------------------------------------------------------------- */
+
+/*
+ * Chunks of x (NoTrans) or y (Trans) along the padded row: whole blocks
+ * when blocks fit in L2_Q8_XB, so one kernel call covers a chunk, else
+ * L2_Q8_XB and a call per block the chunk touches.
+ */
+static BLASLONG q8_chunk(const l2_sq8mat *qa) {
+    return qa->block <= L2_Q8_XB ? L2_Q8_XB / qa->block * qa->block
+                                 : L2_Q8_XB;
+}
+
+/* End of the kernel call starting at column s of the chunk ending at c1. */
+static BLASLONG q8_segment_end(const l2_sq8mat *qa, BLASLONG s, BLASLONG c1) {
+    if (qa->block <= L2_Q8_XB) return c1;
+    return L2_MIN(c1, (s / qa->block + 1) * qa->block);
+}
+
+/* One chunk of x, [c0, c1) with nx elements of x, in fp32. */
+static void q8dotf_chunk(const l2_sq8mat *qa, l2_q8dotf_kernel kernel,
+                         BLASLONG c0, BLASLONG c1, BLASLONG nx, float alpha,
+                         const float *x, BLASLONG incx, float *y,
+                         BLASLONG incy) {
+    float xf[L2_Q8_XB];
+
+    for (BLASLONG k = 0; k < nx; k++) xf[k] = x[(c0 + k) * incx];
+    for (BLASLONG k = nx; k < c1 - c0; k++) xf[k] = 0.0f;
+
+    for (BLASLONG s = c0, e; s < c1; s = e) {
+        e = q8_segment_end(qa, s, c1);
+        kernel(qa->m, e - s, qa->block, qa->q + s, qa->ldq,
+               qa->scale + s / qa->block, qa->lds, xf + (s - c0), alpha, y,
+               incy);
+    }
+}
+
+/*
+ * A chunk of x holding a NaN or an infinity has no int8 scale (fmaxf and
+ * lrintf would turn it into zeros), so it goes through q8dotf_chunk.
+ */
+static void q8gemv_n_int(const l2_sq8mat *qa, float alpha, const float *x,
+                         BLASLONG incx, float *y, BLASLONG incy) {
+    int8_t xq[L2_Q8_XB];
+    l2_q8dot_kernel kernel = l2_q8dot_pick();
+    BLASLONG cb = q8_chunk(qa);
+
+    for (BLASLONG c0 = 0; c0 < qa->ldq; c0 += cb) {
+        BLASLONG c1 = L2_MIN(qa->ldq, c0 + cb);
+        BLASLONG nx = L2_MAX(0, L2_MIN(c1, qa->n) - c0);
+        float amax = 0.0f, inv;
+        int fin = 1;
+
+        for (BLASLONG k = 0; k < nx; k++) {
+            float v = fabsf(x[(c0 + k) * incx]);
+            fin &= v <= FLT_MAX;
+            amax = fmaxf(amax, v);
+        }
+        if (!fin) {
+            q8dotf_chunk(qa, l2_q8dotf_pick(), c0, c1, nx, alpha, x, incx,
+                         y, incy);
+            continue;
+        }
+        if (amax == 0.0f) continue;
+        inv = 127.0f / amax;
+        for (BLASLONG k = 0; k < nx; k++)
+            xq[k] = (int8_t)lrintf(x[(c0 + k) * incx] * inv);
+        memset(xq + nx, 0, (size_t)(c1 - c0 - nx));
+
+        for (BLASLONG s = c0, e; s < c1; s = e) {
+            e = q8_segment_end(qa, s, c1);
+            kernel(qa->m, e - s, qa->block, qa->q + s, qa->ldq,
+                   qa->scale + s / qa->block, qa->lds, xq + (s - c0),
+                   alpha * (amax / 127.0f), y, incy);
+        }
+    }
+}
+
+static void q8gemv_n_float(const l2_sq8mat *qa, float alpha, const float *x,
+                           BLASLONG incx, float *y, BLASLONG incy) {
+    l2_q8dotf_kernel kernel = l2_q8dotf_pick();
+    BLASLONG cb = q8_chunk(qa);
+
+    for (BLASLONG c0 = 0; c0 < qa->ldq; c0 += cb) {
+        BLASLONG c1 = L2_MIN(qa->ldq, c0 + cb);
+        BLASLONG nx = L2_MAX(0, L2_MIN(c1, qa->n) - c0);
+
+        q8dotf_chunk(qa, kernel, c0, c1, nx, alpha, x, incx, y, incy);
+    }
+}
+
+static void q8gemv_t(const l2_sq8mat *qa, float alpha, const float *x,
+                     BLASLONG incx, float *y, BLASLONG incy) {
+    float yb[L2_Q8_XB], tx[L2_Q8_RB];
+    l2_q8axpy_kernel kernel = l2_q8axpy_pick();
+    BLASLONG cb = q8_chunk(qa);
+
+    for (BLASLONG c0 = 0; c0 < qa->ldq; c0 += cb) {
+        BLASLONG c1 = L2_MIN(qa->ldq, c0 + cb);
+        BLASLONG ny = L2_MAX(0, L2_MIN(c1, qa->n) - c0);
+
+        if (ny == 0) continue;
+        for (BLASLONG k = 0; k < c1 - c0; k++) yb[k] = 0.0f;
+        for (BLASLONG r0 = 0; r0 < qa->m; r0 += L2_Q8_RB) {
+            BLASLONG rb = L2_MIN(L2_Q8_RB, qa->m - r0);
+            const int8_t *qr = qa->q + r0 * qa->ldq;
+            const float *sr = qa->scale + r0 * qa->lds;
+
+            for (BLASLONG r = 0; r < rb; r++)
+                tx[r] = alpha * x[(r0 + r) * incx];
+            for (BLASLONG s = c0, e; s < c1; s = e) {
+                e = q8_segment_end(qa, s, c1);
+                kernel(rb, e - s, qa->block, qr + s, qa->ldq,
+                       sr + s / qa->block, qa->lds, tx, yb + (s - c0));
+            }
+        }
+        for (BLASLONG k = 0; k < ny; k++) y[(c0 + k) * incy] += yb[k];
+    }
+}
+
+static int q8gemv_check(enum CBLAS_TRANSPOSE trans, enum L2_Q8_ACC acc,
+                        const l2_sq8mat *qa, blasint incx, blasint incy) {
+    if (trans != CblasNoTrans && trans != CblasTrans &&
+        trans != CblasConjTrans && trans != CblasConjNoTrans) return 1;
+    if (acc != L2_Q8_INT32 && acc != L2_Q8_FP32) return 2;
+    if (qa->m < 0) return 4;
+    if (incx == 0) return 6;
+    if (incy == 0) return 9;
+    return 0;
+}
+
+void l2_sq8gemv(const enum CBLAS_TRANSPOSE trans, const enum L2_Q8_ACC acc,
+                const float alpha, const l2_sq8mat *qa, const float *x,
+                const blasint incx, const float beta, float *y,
+                const blasint incy) {
+    int info = q8gemv_check(trans, acc, qa, incx, incy);
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    BLASLONG lenx, leny;
+
+    if (info) { l2_xerbla("l2_sq8gemv", info); return; }
+    if (qa->m == 0 || qa->n == 0 || (alpha == 0.0f && beta == 1.0f)) return;
+
+    lenx = plain ? qa->n : qa->m;
+    leny = plain ? qa->m : qa->n;
+    x = L2_VEC_BASE(x, lenx, incx);
+    y = L2_VEC_BASE(y, leny, incy);
+
+    if (beta != 1.0f) {
+        for (BLASLONG i = 0; i < leny; i++)
+            y[i * incy] = beta == 0.0f ? 0.0f : beta * y[i * incy];
+    }
+    if (alpha == 0.0f) return;
+
+    if (!plain)
+        q8gemv_t(qa, alpha, x, incx, y, incy);
+    else if (acc == L2_Q8_INT32)
+        q8gemv_n_int(qa, alpha, x, incx, y, incy);
+    else
+        q8gemv_n_float(qa, alpha, x, incx, y, incy);
+}
@@ -0,0 +1,140 @@
+/*
+ * AVX2/FMA int8 kernels (quant.c), four rows of A at a time.  Built with
+ * -mavx2 -mfma; only called when l2_core() reports at least L2_CORE_AVX2.
+ *
+ * q8dot multiplies with vpmaddubsw, which takes one unsigned operand and
+ * saturates the sum of each pair of products to int16.  Both operands are
+ * in [-127, 127], so it gets |x| and q with x's sign (vpsignb): a pair is
+ * at most 2 * 127 * 127 < 32768 and nothing saturates; vpmaddwd against
+ * ones then adds pairs into the int32 accumulators.  q8dotf and q8axpy
+ * widen 8 bytes at a time with vpmovsxbd + vcvtdq2ps.
+ */
+#include "l2blas_internal.h"
+#include "l2blas_avx2.h"
+
+#define Q8_ALWAYS_INLINE static inline __attribute__((always_inline))
+
+static inline __m256 q8_load8(const int8_t *p) {
+    return _mm256_cvtepi32_ps(
+        _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)p)));
+}
+
+/* R rows of q8dot; R is a constant, so the arrays live in registers. */
+Q8_ALWAYS_INLINE void q8dot_rows(const int R, BLASLONG len, BLASLONG block,
+                                 const int8_t *q, BLASLONG ldq,
+                                 const float *scale, BLASLONG lds,
+                                 const int8_t *xq, float mult, float *y,
+                                 BLASLONG incy) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256 f[4];
+
+    for (int r = 0; r < R; r++) f[r] = _mm256_setzero_ps();
+    for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+        BLASLONG k1 = L2_MIN(len, k0 + block);
+        __m256i c[4];
+
+        for (int r = 0; r < R; r++) c[r] = _mm256_setzero_si256();
+        for (BLASLONG k = k0; k < k1; k += 32) {
+            __m256i xv = _mm256_loadu_si256((const __m256i *)(xq + k));
+            __m256i xa = _mm256_sign_epi8(xv, xv);
+            for (int r = 0; r < R; r++) {
+                __m256i qv = _mm256_loadu_si256(
+                    (const __m256i *)(q + r * ldq + k));
+                __m256i p = _mm256_maddubs_epi16(xa,
+                                                 _mm256_sign_epi8(qv, xv));
+                c[r] = _mm256_add_epi32(c[r], _mm256_madd_epi16(p, ones));
+            }
+        }
+        for (int r = 0; r < R; r++)
+            f[r] = _mm256_fmadd_ps(_mm256_cvtepi32_ps(c[r]),
+                                   _mm256_set1_ps(scale[r * lds + b]), f[r]);
+    }
+    for (int r = 0; r < R; r++)
+        y[r * incy] += mult * l2_hsum_ps(f[r]);
+}
+
+void l2_q8dot_avx2(BLASLONG m, BLASLONG len, BLASLONG block,
+                   const int8_t *q, BLASLONG ldq, const float *scale,
+                   BLASLONG lds, const int8_t *xq, float mult, float *y,
+                   BLASLONG incy) {
+    BLASLONG i = 0;
+
+    for (; i + 4 <= m; i += 4)
+        q8dot_rows(4, len, block, q + i * ldq, ldq, scale + i * lds, lds, xq,
+                   mult, y + i * incy, incy);
+    for (; i < m; i++)
+        q8dot_rows(1, len, block, q + i * ldq, ldq, scale + i * lds, lds, xq,
+                   mult, y + i * incy, incy);
+}
+
+Q8_ALWAYS_INLINE void q8dotf_rows(const int R, BLASLONG len, BLASLONG block,
+                                  const int8_t *q, BLASLONG ldq,
+                                  const float *scale, BLASLONG lds,
+                                  const float *x, float mult, float *y,
+                                  BLASLONG incy) {
+    __m256 f[4];
+
+    for (int r = 0; r < R; r++) f[r] = _mm256_setzero_ps();
+    for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+        BLASLONG k1 = L2_MIN(len, k0 + block);
+        __m256 c[4];
+
+        for (int r = 0; r < R; r++) c[r] = _mm256_setzero_ps();
+        for (BLASLONG k = k0; k < k1; k += 8) {
+            __m256 xv = _mm256_loadu_ps(x + k);
+            for (int r = 0; r < R; r++)
+                c[r] = _mm256_fmadd_ps(q8_load8(q + r * ldq + k), xv, c[r]);
+        }
+        for (int r = 0; r < R; r++)
+            f[r] = _mm256_fmadd_ps(c[r], _mm256_set1_ps(scale[r * lds + b]),
+                                   f[r]);
+    }
+    for (int r = 0; r < R; r++)
+        y[r * incy] += mult * l2_hsum_ps(f[r]);
+}
+
+void l2_q8dotf_avx2(BLASLONG m, BLASLONG len, BLASLONG block,
+                    const int8_t *q, BLASLONG ldq, const float *scale,
+                    BLASLONG lds, const float *x, float mult, float *y,
+                    BLASLONG incy) {
+    BLASLONG i = 0;
+
+    for (; i + 4 <= m; i += 4)
+        q8dotf_rows(4, len, block, q + i * ldq, ldq, scale + i * lds, lds, x,
+                    mult, y + i * incy, incy);
+    for (; i < m; i++)
+        q8dotf_rows(1, len, block, q + i * ldq, ldq, scale + i * lds, lds, x,
+                    mult, y + i * incy, incy);
+}
+
+Q8_ALWAYS_INLINE void q8axpy_rows(const int R, BLASLONG len, BLASLONG block,
+                                  const int8_t *q, BLASLONG ldq,
+                                  const float *scale, BLASLONG lds,
+                                  const float *tx, float *y) {
+    for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+        BLASLONG k1 = L2_MIN(len, k0 + block);
+        __m256 t[4];
+
+        for (int r = 0; r < R; r++)
+            t[r] = _mm256_set1_ps(tx[r] * scale[r * lds + b]);
+        for (BLASLONG k = k0; k < k1; k += 8) {
+            __m256 yv = _mm256_loadu_ps(y + k);
+            for (int r = 0; r < R; r++)
+                yv = _mm256_fmadd_ps(q8_load8(q + r * ldq + k), t[r], yv);
+            _mm256_storeu_ps(y + k, yv);
+        }
+    }
+}
+
+void l2_q8axpy_avx2(BLASLONG m, BLASLONG len, BLASLONG block,
+                    const int8_t *q, BLASLONG ldq, const float *scale,
+                    BLASLONG lds, const float *tx, float *y) {
+    BLASLONG i = 0;
+
+    for (; i + 4 <= m; i += 4)
+        q8axpy_rows(4, len, block, q + i * ldq, ldq, scale + i * lds, lds,
+                    tx + i, y);
+    for (; i < m; i++)
+        q8axpy_rows(1, len, block, q + i * ldq, ldq, scale + i * lds, lds,
+                    tx + i, y);
+}
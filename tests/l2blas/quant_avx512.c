@@ -0,0 +1,188 @@
+/*
+ * AVX-512 int8 kernels (quant.c), four rows of A at a time.  Built with
+ * -mavx512f -mavx512bw -mavx512vnni; quant.c only picks them when CPUID
+ * has all three.
+ *
+ * q8dot is one vpdpbusd per 64 bytes of a row: four u8 x s8 products
+ * summed straight into each int32 lane, without vpmaddubsw's int16 step.
+ * The unsigned operand is |x|, and x's sign moves onto q with a masked
+ * subtract from zero (AVX-512 has no vpsignb).  A 32-byte remainder of a
+ * block is loaded under a mask.  q8dotf and q8axpy widen 16 bytes at a
+ * time with vpmovsxbd + vcvtdq2ps.
+ */
+#include <immintrin.h>
+#include "l2blas_internal.h"
+
+#define Q8_ALWAYS_INLINE static inline __attribute__((always_inline))
+
+static inline __m512 q8_load16(const int8_t *p) {
+    return _mm512_cvtepi32_ps(
+        _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i *)p)));
+}
+
+/* R rows of q8dot; R is a constant, so the arrays live in registers. */
+Q8_ALWAYS_INLINE void q8dot_rows(const int R, BLASLONG len, BLASLONG block,
+                                 const int8_t *q, BLASLONG ldq,
+                                 const float *scale, BLASLONG lds,
+                                 const int8_t *xq, float mult, float *y,
+                                 BLASLONG incy) {
+    const __m512i zero = _mm512_setzero_si512();
+    __m512 f[4];
+
+    for (int r = 0; r < R; r++) f[r] = _mm512_setzero_ps();
+    for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+        BLASLONG k1 = L2_MIN(len, k0 + block);
+        __m512i c[4];
+
+        for (int r = 0; r < R; r++) c[r] = zero;
+        for (BLASLONG k = k0; k < k1; k += 64) {
+            /* all 64 bytes, or the low 32 of a block's last step */
+            __mmask64 lm = k + 64 <= k1 ? ~(__mmask64)0 : 0xffffffffull;
+            __m512i xv = _mm512_maskz_loadu_epi8(lm, xq + k);
+            __m512i xa = _mm512_abs_epi8(xv);
+            __mmask64 neg = _mm512_movepi8_mask(xv);
+            for (int r = 0; r < R; r++) {
+                __m512i qv = _mm512_maskz_loadu_epi8(lm, q + r * ldq + k);
+                qv = _mm512_mask_sub_epi8(qv, neg, zero, qv);
+                c[r] = _mm512_dpbusd_epi32(c[r], xa, qv);
+            }
+        }
+        for (int r = 0; r < R; r++)
+            f[r] = _mm512_fmadd_ps(_mm512_cvtepi32_ps(c[r]),
+                                   _mm512_set1_ps(scale[r * lds + b]), f[r]);
+    }
+    for (int r = 0; r < R; r++)
+        y[r * incy] += mult * _mm512_reduce_add_ps(f[r]);
+}
+
+/*
+ * block == 32 (and len a multiple of 64): one vpdpbusd covers two blocks,
+ * lanes 0-7 the first and 8-15 the second, so the int32 lanes are scaled
+ * by a vector holding both scales instead of a masked half step per block.
+ */
+Q8_ALWAYS_INLINE void q8dot32_rows(const int R, BLASLONG len,
+                                   const int8_t *q, BLASLONG ldq,
+                                   const float *scale, BLASLONG lds,
+                                   const int8_t *xq, float mult, float *y,
+                                   BLASLONG incy) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i halves = _mm512_set_epi32(1, 1, 1, 1, 1, 1, 1, 1,
+                                            0, 0, 0, 0, 0, 0, 0, 0);
+    __m512 f[4];
+
+    for (int r = 0; r < R; r++) f[r] = _mm512_setzero_ps();
+    for (BLASLONG k = 0; k < len; k += 64) {
+        __m512i xv = _mm512_loadu_si512(xq + k);
+        __m512i xa = _mm512_abs_epi8(xv);
+        __mmask64 neg = _mm512_movepi8_mask(xv);
+        for (int r = 0; r < R; r++) {
+            __m512i qv = _mm512_loadu_si512(q + r * ldq + k);
+            __m128 s2 = _mm_castsi128_ps(_mm_loadl_epi64(
+                (const __m128i *)(scale + r * lds + k / 32)));
+            __m512i c;
+            qv = _mm512_mask_sub_epi8(qv, neg, zero, qv);
+            c = _mm512_dpbusd_epi32(zero, xa, qv);
+            f[r] = _mm512_fmadd_ps(
+                _mm512_cvtepi32_ps(c),
+                _mm512_permutexvar_ps(halves, _mm512_castps128_ps512(s2)),
+                f[r]);
+        }
+    }
+    for (int r = 0; r < R; r++)
+        y[r * incy] += mult * _mm512_reduce_add_ps(f[r]);
+}
+
+void l2_q8dot_avx512(BLASLONG m, BLASLONG len, BLASLONG block,
+                     const int8_t *q, BLASLONG ldq, const float *scale,
+                     BLASLONG lds, const int8_t *xq, float mult, float *y,
+                     BLASLONG incy) {
+    BLASLONG i = 0;
+
+    if (block == 32 && len % 64 == 0) {
+        for (; i + 4 <= m; i += 4)
+            q8dot32_rows(4, len, q + i * ldq, ldq, scale + i * lds, lds, xq,
+                         mult, y + i * incy, incy);
+        for (; i < m; i++)
+            q8dot32_rows(1, len, q + i * ldq, ldq, scale + i * lds, lds, xq,
+                         mult, y + i * incy, incy);
+        return;
+    }
+    for (; i + 4 <= m; i += 4)
+        q8dot_rows(4, len, block, q + i * ldq, ldq, scale + i * lds, lds, xq,
+                   mult, y + i * incy, incy);
+    for (; i < m; i++)
+        q8dot_rows(1, len, block, q + i * ldq, ldq, scale + i * lds, lds, xq,
+                   mult, y + i * incy, incy);
+}
+
+Q8_ALWAYS_INLINE void q8dotf_rows(const int R, BLASLONG len, BLASLONG block,
+                                  const int8_t *q, BLASLONG ldq,
+                                  const float *scale, BLASLONG lds,
+                                  const float *x, float mult, float *y,
+                                  BLASLONG incy) {
+    __m512 f[4];
+
+    for (int r = 0; r < R; r++) f[r] = _mm512_setzero_ps();
+    for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+        BLASLONG k1 = L2_MIN(len, k0 + block);
+        __m512 c[4];
+
+        for (int r = 0; r < R; r++) c[r] = _mm512_setzero_ps();
+        for (BLASLONG k = k0; k < k1; k += 16) {
+            __m512 xv = _mm512_loadu_ps(x + k);
+            for (int r = 0; r < R; r++)
+                c[r] = _mm512_fmadd_ps(q8_load16(q + r * ldq + k), xv, c[r]);
+        }
+        for (int r = 0; r < R; r++)
+            f[r] = _mm512_fmadd_ps(c[r], _mm512_set1_ps(scale[r * lds + b]),
+                                   f[r]);
+    }
+    for (int r = 0; r < R; r++)
+        y[r * incy] += mult * _mm512_reduce_add_ps(f[r]);
+}
+
+void l2_q8dotf_avx512(BLASLONG m, BLASLONG len, BLASLONG block,
+                      const int8_t *q, BLASLONG ldq, const float *scale,
+                      BLASLONG lds, const float *x, float mult, float *y,
+                      BLASLONG incy) {
+    BLASLONG i = 0;
+
+    for (; i + 4 <= m; i += 4)
+        q8dotf_rows(4, len, block, q + i * ldq, ldq, scale + i * lds, lds, x,
+                    mult, y + i * incy, incy);
+    for (; i < m; i++)
+        q8dotf_rows(1, len, block, q + i * ldq, ldq, scale + i * lds, lds, x,
+                    mult, y + i * incy, incy);
+}
+
+Q8_ALWAYS_INLINE void q8axpy_rows(const int R, BLASLONG len, BLASLONG block,
+                                  const int8_t *q, BLASLONG ldq,
+                                  const float *scale, BLASLONG lds,
+                                  const float *tx, float *y) {
+    for (BLASLONG k0 = 0, b = 0; k0 < len; k0 += block, b++) {
+        BLASLONG k1 = L2_MIN(len, k0 + block);
+        __m512 t[4];
+
+        for (int r = 0; r < R; r++)
+            t[r] = _mm512_set1_ps(tx[r] * scale[r * lds + b]);
+        for (BLASLONG k = k0; k < k1; k += 16) {
+            __m512 yv = _mm512_loadu_ps(y + k);
+            for (int r = 0; r < R; r++)
+                yv = _mm512_fmadd_ps(q8_load16(q + r * ldq + k), t[r], yv);
+            _mm512_storeu_ps(y + k, yv);
+        }
+    }
+}
+
+void l2_q8axpy_avx512(BLASLONG m, BLASLONG len, BLASLONG block,
+                      const int8_t *q, BLASLONG ldq, const float *scale,
+                      BLASLONG lds, const float *tx, float *y) {
+    BLASLONG i = 0;
+
+    for (; i + 4 <= m; i += 4)
+        q8axpy_rows(4, len, block, q + i * ldq, ldq, scale + i * lds, lds,
+                    tx + i, y);
+    for (; i < m; i++)
+        q8axpy_rows(1, len, block, q + i * ldq, ldq, scale + i * lds, lds,
+                    tx + i, y);
+}
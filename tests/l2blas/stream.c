@@ -0,0 +1,123 @@
+/*
+ * Out-of-core gemv (l2_sgemv_mapped, l2_dgemv_mapped): A stays in a file
+ * and is mapped one panel at a time.
+ *
+ * As in gemv.c a RowMajor matrix is taken as its ColMajor transpose, so
+ * either way the stored lines (columns of the ColMajor view) lie back to
+ * back in the file and a panel of whole lines is one contiguous range:
+ * NoTrans adds A(:, panel) * x(panel) to all of y, Trans sets y(panel)
+ * from A(:, panel)^T * x.  The file is therefore read front to back
+ * exactly once.  While panel k is computed, panel k + 1 is already mapped
+ * with MADV_WILLNEED, so the kernel reads it ahead asynchronously; panel k
+ * is then unmapped.  When A is a large share of RAM its pages are also
+ * dropped from the page cache, which keeps a pass over a file larger than
+ * RAM from evicting everything else; a smaller A stays cached, so the next
+ * call on it runs from memory.
+ */
+#include <errno.h>
+#include <stdatomic.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "l2blas_internal.h"
+
+static atomic_size_t panel_bytes;
+static atomic_size_t evict_bytes;
+
+void l2_set_stream_panel(size_t bytes) {
+    atomic_store(&panel_bytes, bytes);
+}
+
+void l2_set_stream_evict(size_t bytes) {
+    atomic_store(&evict_bytes, bytes);
+}
+
+/* ---- panel windows ------------------------------------------------------- */
+
+#ifndef _WIN32
+
+typedef struct {
+    void       *map;        /* NULL: nothing mapped */
+    size_t      maplen;
+    off_t       start;      /* file offset of map, page aligned */
+    const char *a;          /* first element of the panel */
+} stream_window;
+
+/* Maps bytes [off, off + len) of fd and starts reading them ahead. */
+static int window_open(stream_window *w, int fd, off_t off, size_t len) {
+    off_t page = (off_t)sysconf(_SC_PAGESIZE);
+
+    w->start = off - off % page;
+    w->maplen = len + (size_t)(off - w->start);
+    w->map = mmap(NULL, w->maplen, PROT_READ, MAP_SHARED, fd, w->start);
+    if (w->map == MAP_FAILED) {
+        w->map = NULL;
+        return -1;
+    }
+    madvise(w->map, w->maplen, MADV_SEQUENTIAL);
+    madvise(w->map, w->maplen, MADV_WILLNEED);
+    w->a = (const char *)w->map + (off - w->start);
+    return 0;
+}
+
+/* Unmaps w, dropping its pages from the page cache if drop is set. */
+static void window_close(stream_window *w, int fd, int drop) {
+    if (!w->map) return;
+    munmap(w->map, w->maplen);
+    if (drop)
+        posix_fadvise(fd, w->start, (off_t)w->maplen, POSIX_FADV_DONTNEED);
+    w->map = NULL;
+}
+
+/* Whether a pass over span bytes of A drops them (l2_set_stream_evict). */
+static int stream_evicts(size_t span) {
+    size_t limit = atomic_load(&evict_bytes);
+
+    if (limit == 0) {
+        long pages = sysconf(_SC_PHYS_PAGES), page = sysconf(_SC_PAGESIZE);
+        if (pages <= 0 || page <= 0) return 1;
+        limit = (size_t)pages / L2_STREAM_EVICT_DIV * (size_t)page;
+    }
+    return span > limit;
+}
+
+#endif
+
+/* ---- driver -------------------------------------------------------------- */
+
+/*
+ * cblas_?gemv's parameter numbers, with fd and offset in place of a; the
+ * offset must be a whole number of elements of es bytes.
+ */
+static int stream_check(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+                        blasint m, blasint n, int fd, BLASLONG offset,
+                        size_t es, blasint lda, blasint incx, blasint incy) {
+    int info = l2_gemv_check(order, trans, m, n, lda, incx, incy);
+
+    if (info && info < 6) return info;
+    if (fd < 0) return 6;
+    if (offset < 0 || (size_t)offset % es) return 7;
+    return info ? info + 1 : 0;
+}
+
+/*
+ * The part of a cblas vector holding its logical elements [i, i + len):
+ * the pointer a cblas routine expects for it, lowest address first.
+ */
+#define STREAM_SUB(base, i, len, inc) \
+    ((inc) < 0 ? (base) + ((i) + (len) - 1) * (inc) : (base) + (i) * (inc))
+
+#define FLOAT float
+#define PREC s
+#include "stream_template.h"
+#undef FLOAT
+#undef PREC
+
+#define FLOAT double
+#define PREC d
+#include "stream_template.h"
+#undef FLOAT
+#undef PREC
@@ -0,0 +1,100 @@
+/*
+ * l2_?gemv_mapped, included once per precision by stream.c with
+ *   FLOAT  element type (float or double)
+ *   PREC   name prefix (s, d)
+ * defined.
+ */
+
+#define ST_CAT_(a, b) a##b
+#define ST_CAT(a, b) ST_CAT_(a, b)
+#define ST_STR_(a) #a
+#define ST_STR(a) ST_STR_(a)
+#define ST_L2(name) ST_CAT(l2_, ST_CAT(PREC, name))
+
+int ST_L2(gemv_mapped)(const enum CBLAS_ORDER order,
+                       const enum CBLAS_TRANSPOSE trans, const blasint m,
+                       const blasint n, const FLOAT alpha, const int fd,
+                       const BLASLONG offset, const blasint lda,
+                       const FLOAT *x, const blasint incx, const FLOAT beta,
+                       FLOAT *y, const blasint incy) {
+    int info = stream_check(order, trans, m, n, fd, offset, sizeof(FLOAT),
+                            lda, incx, incy);
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int notrans = plain == (order == CblasColMajor);
+    BLASLONG rows = order == CblasColMajor ? m : n;
+    BLASLONG cols = order == CblasColMajor ? n : m;
+#ifndef _WIN32
+    size_t es = sizeof(FLOAT), line = (size_t)lda * es;
+    size_t want = atomic_load(&panel_bytes);
+    size_t span = ((size_t)(cols - 1) * lda + rows) * es;
+    BLASLONG pc;
+    int drop;
+    stream_window cur, next;
+    struct stat st;
+#endif
+
+    if (info) {
+        l2_xerbla(ST_STR(ST_L2(gemv_mapped)), info);
+        errno = EINVAL;
+        return -1;
+    }
+    if (m == 0 || n == 0 || (alpha == 0 && beta == 1)) return 0;
+    x = L2_VEC_BASE(x, notrans ? cols : rows, incx);
+    y = L2_VEC_BASE(y, notrans ? rows : cols, incy);
+    if (alpha == 0) {
+        /* A is not read */
+        for (BLASLONG i = 0; i < (notrans ? rows : cols); i++)
+            y[i * incy] = beta == 0 ? 0 : beta * y[i * incy];
+        return 0;
+    }
+#ifdef _WIN32
+    errno = ENOSYS;
+    return -1;
+#else
+    if (fstat(fd, &st) != 0) return -1;
+    if ((size_t)offset + span > (size_t)st.st_size) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (want == 0) want = L2_STREAM_PANEL;
+    pc = (BLASLONG)L2_MAX(want / line, 1);
+    drop = stream_evicts(span);
+
+    next.map = NULL;
+    if (window_open(&cur, fd, (off_t)offset,
+                    ((size_t)(L2_MIN(pc, cols) - 1) * lda + rows) * es) != 0)
+        return -1;
+    for (BLASLONG c0 = 0; c0 < cols; c0 += pc) {
+        BLASLONG nc = L2_MIN(pc, cols - c0), c1 = c0 + nc;
+
+        if (c1 < cols) {
+            BLASLONG nn = L2_MIN(pc, cols - c1);
+            if (window_open(&next, fd, (off_t)(offset + c1 * line),
+                            ((size_t)(nn - 1) * lda + rows) * es) != 0) {
+                int err = errno;
+                window_close(&cur, fd, drop);
+                errno = err;
+                return -1;
+            }
+        }
+        /* NoTrans: all of y, beta on the first panel only */
+        ST_L2(gemv_compute)(CblasColMajor, notrans ? CblasNoTrans : CblasTrans,
+                            rows, nc, alpha, (const FLOAT *)cur.a, lda,
+                            notrans ? STREAM_SUB(x, c0, nc, incx)
+                                    : STREAM_SUB(x, 0, rows, incx), incx,
+                            notrans && c0 > 0 ? 1 : beta,
+                            notrans ? STREAM_SUB(y, 0, rows, incy)
+                                    : STREAM_SUB(y, c0, nc, incy), incy);
+        window_close(&cur, fd, drop);
+        cur = next;
+        next.map = NULL;
+    }
+    return 0;
+#endif
+}
+
+#undef ST_CAT_
+#undef ST_CAT
+#undef ST_STR_
+#undef ST_STR
+#undef ST_L2
@@ -0,0 +1,408 @@
+#include <stddef.h>
+#include <pthread.h>
+#include "l2blas_internal.h"
+
+/*
+ * Single-pass symv.  Only the stored triangle is read, and each element
+ * A(i,j) is loaded once and used for both y(i) += A(i,j)*x(j) and
+ * y(j) += A(i,j)*x(i).  The triangle is walked in L2_SYMV_NB-square blocks so
+ * the x/y segments of both the block row and the block column stay in L1
+ * while a block is streamed; every off-diagonal block is one call to a
+ * fused panel kernel.
+ */
+
+/* ---- portable kernels ----------------------------------------------------- */
+
+void l2_ssymv_panel_generic(BLASLONG m, BLASLONG n, float alpha,
+                            const float *a, BLASLONG lda,
+                            const float *x1, float *y1,
+                            const float *x2, float *y2) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const float *col = a + j * lda;
+        float t1 = alpha * x2[j], t2 = 0.0f;
+        for (BLASLONG i = 0; i < m; i++) {
+            y1[i] += t1 * col[i];
+            t2 += col[i] * x1[i];
+        }
+        y2[j] += alpha * t2;
+    }
+}
+
+void l2_dsymv_panel_generic(BLASLONG m, BLASLONG n, double alpha,
+                            const double *a, BLASLONG lda,
+                            const double *x1, double *y1,
+                            const double *x2, double *y2) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const double *col = a + j * lda;
+        double t1 = alpha * x2[j], t2 = 0.0;
+        for (BLASLONG i = 0; i < m; i++) {
+            y1[i] += t1 * col[i];
+            t2 += col[i] * x1[i];
+        }
+        y2[j] += alpha * t2;
+    }
+}
+
+l2_ssymv_panel_kernel l2_ssymv_panel_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_ssymv_panel_avx512;
+    case L2_CORE_AVX2:   return l2_ssymv_panel_avx2;
+    default:             return l2_ssymv_panel_generic;
+    }
+}
+
+l2_dsymv_panel_kernel l2_dsymv_panel_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_dsymv_panel_avx512;
+    case L2_CORE_AVX2:   return l2_dsymv_panel_avx2;
+    default:             return l2_dsymv_panel_generic;
+    }
+}
+
+/* ---- column-major drivers ------------------------------------------------- */
+
+/*
+ * Diagonal block: 4-column strips, each a 4x4 triangle done in scalar code
+ * plus the rectangular part of the strip inside the block as a panel.
+ */
+static void ssymv_diag(int lower, BLASLONG n, float alpha, const float *a,
+                       BLASLONG lda, const float *x, float *y,
+                       l2_ssymv_panel_kernel panel) {
+    for (BLASLONG j = 0; j < n; j += 4) {
+        BLASLONG w = L2_MIN(4, n - j);
+        const float *d = a + j + j * lda;
+
+        for (BLASLONG c = 0; c < w; c++) {
+            float t1 = alpha * x[j + c], t2 = 0.0f;
+            BLASLONG r0 = lower ? c + 1 : 0, r1 = lower ? w : c;
+            y[j + c] += t1 * d[c + c * lda];
+            for (BLASLONG r = r0; r < r1; r++) {
+                float v = d[r + c * lda];
+                y[j + r] += t1 * v;
+                t2 += v * x[j + r];
+            }
+            y[j + c] += alpha * t2;
+        }
+        if (lower && n - j - w > 0)
+            panel(n - j - w, w, alpha, d + w, lda, x + j + w, y + j + w,
+                  x + j, y + j);
+        else if (!lower && j > 0)
+            panel(j, w, alpha, a + j * lda, lda, x, y, x + j, y + j);
+    }
+}
+
+static void ssymv_blocked(int lower, BLASLONG n, float alpha, const float *a,
+                          BLASLONG lda, const float *x, float *y) {
+    const BLASLONG nb = L2_SYMV_NB(float);
+    l2_ssymv_panel_kernel panel = l2_ssymv_panel_pick();
+
+    for (BLASLONG j0 = 0; j0 < n; j0 += nb) {
+        BLASLONG jb = L2_MIN(nb, n - j0);
+        BLASLONG i_begin = lower ? j0 + jb : 0, i_end = lower ? n : j0;
+
+        ssymv_diag(lower, jb, alpha, a + j0 + j0 * lda, lda, x + j0, y + j0,
+                   panel);
+        for (BLASLONG i0 = i_begin; i0 < i_end; i0 += nb) {
+            BLASLONG ib = L2_MIN(nb, i_end - i0);
+            panel(ib, jb, alpha, a + i0 + j0 * lda, lda, x + i0, y + i0,
+                  x + j0, y + j0);
+        }
+    }
+}
+
+static void dsymv_diag(int lower, BLASLONG n, double alpha, const double *a,
+                       BLASLONG lda, const double *x, double *y,
+                       l2_dsymv_panel_kernel panel) {
+    for (BLASLONG j = 0; j < n; j += 4) {
+        BLASLONG w = L2_MIN(4, n - j);
+        const double *d = a + j + j * lda;
+
+        for (BLASLONG c = 0; c < w; c++) {
+            double t1 = alpha * x[j + c], t2 = 0.0;
+            BLASLONG r0 = lower ? c + 1 : 0, r1 = lower ? w : c;
+            y[j + c] += t1 * d[c + c * lda];
+            for (BLASLONG r = r0; r < r1; r++) {
+                double v = d[r + c * lda];
+                y[j + r] += t1 * v;
+                t2 += v * x[j + r];
+            }
+            y[j + c] += alpha * t2;
+        }
+        if (lower && n - j - w > 0)
+            panel(n - j - w, w, alpha, d + w, lda, x + j + w, y + j + w,
+                  x + j, y + j);
+        else if (!lower && j > 0)
+            panel(j, w, alpha, a + j * lda, lda, x, y, x + j, y + j);
+    }
+}
+
+static void dsymv_blocked(int lower, BLASLONG n, double alpha, const double *a,
+                          BLASLONG lda, const double *x, double *y) {
+    const BLASLONG nb = L2_SYMV_NB(double);
+    l2_dsymv_panel_kernel panel = l2_dsymv_panel_pick();
+
+    for (BLASLONG j0 = 0; j0 < n; j0 += nb) {
+        BLASLONG jb = L2_MIN(nb, n - j0);
+        BLASLONG i_begin = lower ? j0 + jb : 0, i_end = lower ? n : j0;
+
+        dsymv_diag(lower, jb, alpha, a + j0 + j0 * lda, lda, x + j0, y + j0,
+                   panel);
+        for (BLASLONG i0 = i_begin; i0 < i_end; i0 += nb) {
+            BLASLONG ib = L2_MIN(nb, i_end - i0);
+            panel(ib, jb, alpha, a + i0 + j0 * lda, lda, x + i0, y + i0,
+                  x + j0, y + j0);
+        }
+    }
+}
+
+/*
+ * Threaded: slots take column blocks of equal cost (l2_tri_split) and walk
+ * them as the blocked driver does, but into stack tiles, one for the block
+ * column's y and one for the block row's, each added into y under the
+ * region's lock once its panel is done.  The order of those additions
+ * follows the threads, so threaded results can differ in the last bits
+ * from run to run.  A column is charged a quarter of L2_TRI_LINE_BYTES: it
+ * is started once per row tile, not once per call, and at the full charge
+ * the slot of short columns came out a seventh light.
+ */
+typedef struct {
+    int lower;
+    BLASLONG n, lda;
+    float alpha;
+    const float *a, *x;
+    float *y;
+    l2_ssymv_panel_kernel panel;
+    pthread_mutex_t lock;
+} ssymv_mt_args;
+
+static void ssymv_merge(ssymv_mt_args *p, BLASLONG i0, const float *t,
+                        BLASLONG len) {
+    pthread_mutex_lock(&p->lock);
+    for (BLASLONG i = 0; i < len; i++)
+        p->y[i0 + i] += t[i];
+    pthread_mutex_unlock(&p->lock);
+}
+
+static void ssymv_worker(int tid, int nthreads, void *arg) {
+    ssymv_mt_args *p = arg;
+    const BLASLONG nb = L2_SYMV_NB(float);
+    BLASLONG align = 64 / (BLASLONG)sizeof(float);
+    BLASLONG cost = L2_TRI_LINE_BYTES / (BLASLONG)sizeof(float) / 4;
+    BLASLONG c0 = l2_tri_split(p->n, !p->lower, cost, tid, nthreads, align);
+    BLASLONG c1 = l2_tri_split(p->n, !p->lower, cost, tid + 1, nthreads,
+                               align);
+    float yc[L2_SYMV_NB(float)], yr[L2_SYMV_NB(float)];
+
+    for (BLASLONG j0 = c0; j0 < c1; j0 += nb) {
+        BLASLONG jb = L2_MIN(nb, c1 - j0);
+        BLASLONG i_begin = p->lower ? j0 + jb : 0;
+        BLASLONG i_end = p->lower ? p->n : j0;
+        const float *aj = p->a + j0 * p->lda;
+
+        for (BLASLONG k = 0; k < jb; k++) yc[k] = 0;
+        ssymv_diag(p->lower, jb, p->alpha, aj + j0, p->lda, p->x + j0, yc,
+                   p->panel);
+        for (BLASLONG i0 = i_begin; i0 < i_end; i0 += nb) {
+            BLASLONG ib = L2_MIN(nb, i_end - i0);
+            for (BLASLONG k = 0; k < ib; k++) yr[k] = 0;
+            p->panel(ib, jb, p->alpha, aj + i0, p->lda, p->x + i0, yr,
+                     p->x + j0, yc);
+            ssymv_merge(p, i0, yr, ib);
+        }
+        ssymv_merge(p, j0, yc, jb);
+    }
+}
+
+/* Unit-stride symv, on as many threads as the triangle is worth. */
+static void ssymv_unit(int lower, BLASLONG n, float alpha, const float *a,
+                       BLASLONG lda, const float *x, float *y) {
+    ssymv_mt_args p;
+    int nthreads = l2_get_num_threads();
+    double work = 0.5 * (double)n * (double)(n + 1);
+
+    if (nthreads < 2 || work < 2.0 * L2_SYMV_MIN_WORK) {
+        ssymv_blocked(lower, n, alpha, a, lda, x, y);
+        return;
+    }
+    p.lower = lower;
+    p.n = n;
+    p.lda = lda;
+    p.alpha = alpha;
+    p.a = a;
+    p.x = x;
+    p.y = y;
+    p.panel = l2_ssymv_panel_pick();
+    pthread_mutex_init(&p.lock, NULL);
+    nthreads = (int)L2_MIN((double)nthreads, work / L2_SYMV_MIN_WORK);
+    l2_parallel(nthreads, ssymv_worker, &p);
+    pthread_mutex_destroy(&p.lock);
+}
+
+typedef struct {
+    int lower;
+    BLASLONG n, lda;
+    double alpha;
+    const double *a, *x;
+    double *y;
+    l2_dsymv_panel_kernel panel;
+    pthread_mutex_t lock;
+} dsymv_mt_args;
+
+static void dsymv_merge(dsymv_mt_args *p, BLASLONG i0, const double *t,
+                        BLASLONG len) {
+    pthread_mutex_lock(&p->lock);
+    for (BLASLONG i = 0; i < len; i++)
+        p->y[i0 + i] += t[i];
+    pthread_mutex_unlock(&p->lock);
+}
+
+static void dsymv_worker(int tid, int nthreads, void *arg) {
+    dsymv_mt_args *p = arg;
+    const BLASLONG nb = L2_SYMV_NB(double);
+    BLASLONG align = 64 / (BLASLONG)sizeof(double);
+    BLASLONG cost = L2_TRI_LINE_BYTES / (BLASLONG)sizeof(double) / 4;
+    BLASLONG c0 = l2_tri_split(p->n, !p->lower, cost, tid, nthreads, align);
+    BLASLONG c1 = l2_tri_split(p->n, !p->lower, cost, tid + 1, nthreads,
+                               align);
+    double yc[L2_SYMV_NB(double)], yr[L2_SYMV_NB(double)];
+
+    for (BLASLONG j0 = c0; j0 < c1; j0 += nb) {
+        BLASLONG jb = L2_MIN(nb, c1 - j0);
+        BLASLONG i_begin = p->lower ? j0 + jb : 0;
+        BLASLONG i_end = p->lower ? p->n : j0;
+        const double *aj = p->a + j0 * p->lda;
+
+        for (BLASLONG k = 0; k < jb; k++) yc[k] = 0;
+        dsymv_diag(p->lower, jb, p->alpha, aj + j0, p->lda, p->x + j0, yc,
+                   p->panel);
+        for (BLASLONG i0 = i_begin; i0 < i_end; i0 += nb) {
+            BLASLONG ib = L2_MIN(nb, i_end - i0);
+            for (BLASLONG k = 0; k < ib; k++) yr[k] = 0;
+            p->panel(ib, jb, p->alpha, aj + i0, p->lda, p->x + i0, yr,
+                     p->x + j0, yc);
+            dsymv_merge(p, i0, yr, ib);
+        }
+        dsymv_merge(p, j0, yc, jb);
+    }
+}
+
+static void dsymv_unit(int lower, BLASLONG n, double alpha, const double *a,
+                       BLASLONG lda, const double *x, double *y) {
+    dsymv_mt_args p;
+    int nthreads = l2_get_num_threads();
+    double work = 0.5 * (double)n * (double)(n + 1);
+
+    if (nthreads < 2 || work < 2.0 * L2_SYMV_MIN_WORK) {
+        dsymv_blocked(lower, n, alpha, a, lda, x, y);
+        return;
+    }
+    p.lower = lower;
+    p.n = n;
+    p.lda = lda;
+    p.alpha = alpha;
+    p.a = a;
+    p.x = x;
+    p.y = y;
+    p.panel = l2_dsymv_panel_pick();
+    pthread_mutex_init(&p.lock, NULL);
+    nthreads = (int)L2_MIN((double)nthreads, work / L2_SYMV_MIN_WORK);
+    l2_parallel(nthreads, dsymv_worker, &p);
+    pthread_mutex_destroy(&p.lock);
+}
+
+/* Non-unit increments: same single pass, one column at a time. */
+static void ssymv_strided(int lower, BLASLONG n, float alpha, const float *a,
+                          BLASLONG lda, const float *x, BLASLONG incx,
+                          float *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const float *col = a + j * lda;
+        float t1 = alpha * x[j * incx], t2 = 0.0f;
+        BLASLONG i0 = lower ? j + 1 : 0, i1 = lower ? n : j;
+        y[j * incy] += t1 * col[j];
+        for (BLASLONG i = i0; i < i1; i++) {
+            y[i * incy] += t1 * col[i];
+            t2 += col[i] * x[i * incx];
+        }
+        y[j * incy] += alpha * t2;
+    }
+}
+
+static void dsymv_strided(int lower, BLASLONG n, double alpha, const double *a,
+                          BLASLONG lda, const double *x, BLASLONG incx,
+                          double *y, BLASLONG incy) {
+    for (BLASLONG j = 0; j < n; j++) {
+        const double *col = a + j * lda;
+        double t1 = alpha * x[j * incx], t2 = 0.0;
+        BLASLONG i0 = lower ? j + 1 : 0, i1 = lower ? n : j;
+        y[j * incy] += t1 * col[j];
+        for (BLASLONG i = i0; i < i1; i++) {
+            y[i * incy] += t1 * col[i];
+            t2 += col[i] * x[i * incx];
+        }
+        y[j * incy] += alpha * t2;
+    }
+}
+
+/* ---- cblas-compatible entry points ---------------------------------------- */
+
+int l2_symv_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                  blasint n, blasint lda, blasint incx, blasint incy) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (uplo != CblasUpper && uplo != CblasLower) return 2;
+    if (n < 0) return 3;
+    if (lda < L2_MAX(1, n)) return 6;
+    if (incx == 0) return 8;
+    if (incy == 0) return 11;
+    return 0;
+}
+
+void l2_ssymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const float alpha, const float *a,
+              const blasint lda, const float *x, const blasint incx,
+              const float beta, float *y, const blasint incy) {
+    int info = l2_symv_check(order, uplo, n, lda, incx, incy);
+    int lower;
+
+    if (info) { l2_xerbla("l2_ssymv", info); return; }
+    if (n == 0 || (alpha == 0.0f && beta == 1.0f)) return;
+
+    x = L2_VEC_BASE(x, n, incx);
+    y = L2_VEC_BASE(y, n, incy);
+    if (beta != 1.0f) {
+        for (BLASLONG i = 0; i < n; i++)
+            y[i * incy] = beta == 0.0f ? 0.0f : beta * y[i * incy];
+    }
+    if (alpha == 0.0f) return;
+
+    /* RowMajor Upper is the ColMajor Lower triangle of the same matrix. */
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    if (incx == 1 && incy == 1)
+        ssymv_unit(lower, n, alpha, a, lda, x, y);
+    else
+        ssymv_strided(lower, n, alpha, a, lda, x, incx, y, incy);
+}
+
+void l2_dsymv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const double alpha, const double *a,
+              const blasint lda, const double *x, const blasint incx,
+              const double beta, double *y, const blasint incy) {
+    int info = l2_symv_check(order, uplo, n, lda, incx, incy);
+    int lower;
+
+    if (info) { l2_xerbla("l2_dsymv", info); return; }
+    if (n == 0 || (alpha == 0.0 && beta == 1.0)) return;
+
+    x = L2_VEC_BASE(x, n, incx);
+    y = L2_VEC_BASE(y, n, incy);
+    if (beta != 1.0) {
+        for (BLASLONG i = 0; i < n; i++)
+            y[i * incy] = beta == 0.0 ? 0.0 : beta * y[i * incy];
+    }
+    if (alpha == 0.0) return;
+
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    if (incx == 1 && incy == 1)
+        dsymv_unit(lower, n, alpha, a, lda, x, y);
+    else
+        dsymv_strided(lower, n, alpha, a, lda, x, incx, y, incy);
+}
@@ -0,0 +1,145 @@
+/*
+ * AVX2/FMA fused symv panels.  Four columns per sweep: each vector of A is
+ * loaded once, FMA'd into y1 (axpy with alpha*x2[j]) and into a per-column
+ * dot accumulator against x1.
+ */
+#include "l2blas_internal.h"
+#include "l2blas_avx2.h"
+
+void l2_ssymv_panel_avx2(BLASLONG m, BLASLONG n, float alpha,
+                         const float *a, BLASLONG lda,
+                         const float *x1, float *y1,
+                         const float *x2, float *y2) {
+    BLASLONG j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        const float *a0 = a + j * lda, *a1 = a0 + lda;
+        const float *a2 = a1 + lda,    *a3 = a2 + lda;
+        float t0 = alpha * x2[j],     t1 = alpha * x2[j + 1];
+        float t2 = alpha * x2[j + 2], t3 = alpha * x2[j + 3];
+        __m256 b0 = _mm256_set1_ps(t0), b1 = _mm256_set1_ps(t1);
+        __m256 b2 = _mm256_set1_ps(t2), b3 = _mm256_set1_ps(t3);
+        __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+        __m256 c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+        float s0, s1, s2, s3;
+        BLASLONG i = 0;
+
+        for (; i + 8 <= m; i += 8) {
+            __m256 xv = _mm256_loadu_ps(x1 + i);
+            __m256 yv = _mm256_loadu_ps(y1 + i);
+            __m256 v0 = _mm256_loadu_ps(a0 + i), v1 = _mm256_loadu_ps(a1 + i);
+            __m256 v2 = _mm256_loadu_ps(a2 + i), v3 = _mm256_loadu_ps(a3 + i);
+            yv = _mm256_fmadd_ps(v0, b0, yv);
+            c0 = _mm256_fmadd_ps(v0, xv, c0);
+            yv = _mm256_fmadd_ps(v1, b1, yv);
+            c1 = _mm256_fmadd_ps(v1, xv, c1);
+            yv = _mm256_fmadd_ps(v2, b2, yv);
+            c2 = _mm256_fmadd_ps(v2, xv, c2);
+            yv = _mm256_fmadd_ps(v3, b3, yv);
+            c3 = _mm256_fmadd_ps(v3, xv, c3);
+            _mm256_storeu_ps(y1 + i, yv);
+        }
+        s0 = l2_hsum_ps(c0);
+        s1 = l2_hsum_ps(c1);
+        s2 = l2_hsum_ps(c2);
+        s3 = l2_hsum_ps(c3);
+        for (; i < m; i++) {
+            y1[i] += t0 * a0[i] + t1 * a1[i] + t2 * a2[i] + t3 * a3[i];
+            s0 += a0[i] * x1[i];
+            s1 += a1[i] * x1[i];
+            s2 += a2[i] * x1[i];
+            s3 += a3[i] * x1[i];
+        }
+        y2[j]     += alpha * s0;
+        y2[j + 1] += alpha * s1;
+        y2[j + 2] += alpha * s2;
+        y2[j + 3] += alpha * s3;
+    }
+    for (; j < n; j++) {
+        const float *a0 = a + j * lda;
+        float t0 = alpha * x2[j], s0;
+        __m256 b0 = _mm256_set1_ps(t0), c0 = _mm256_setzero_ps();
+        BLASLONG i = 0;
+
+        for (; i + 8 <= m; i += 8) {
+            __m256 v0 = _mm256_loadu_ps(a0 + i);
+            _mm256_storeu_ps(y1 + i, _mm256_fmadd_ps(v0, b0, _mm256_loadu_ps(y1 + i)));
+            c0 = _mm256_fmadd_ps(v0, _mm256_loadu_ps(x1 + i), c0);
+        }
+        s0 = l2_hsum_ps(c0);
+        for (; i < m; i++) {
+            y1[i] += t0 * a0[i];
+            s0 += a0[i] * x1[i];
+        }
+        y2[j] += alpha * s0;
+    }
+}
+
+void l2_dsymv_panel_avx2(BLASLONG m, BLASLONG n, double alpha,
+                         const double *a, BLASLONG lda,
+                         const double *x1, double *y1,
+                         const double *x2, double *y2) {
+    BLASLONG j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        const double *a0 = a + j * lda, *a1 = a0 + lda;
+        const double *a2 = a1 + lda,    *a3 = a2 + lda;
+        double t0 = alpha * x2[j],     t1 = alpha * x2[j + 1];
+        double t2 = alpha * x2[j + 2], t3 = alpha * x2[j + 3];
+        __m256d b0 = _mm256_set1_pd(t0), b1 = _mm256_set1_pd(t1);
+        __m256d b2 = _mm256_set1_pd(t2), b3 = _mm256_set1_pd(t3);
+        __m256d c0 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+        __m256d c2 = _mm256_setzero_pd(), c3 = _mm256_setzero_pd();
+        double s0, s1, s2, s3;
+        BLASLONG i = 0;
+
+        for (; i + 4 <= m; i += 4) {
+            __m256d xv = _mm256_loadu_pd(x1 + i);
+            __m256d yv = _mm256_loadu_pd(y1 + i);
+            __m256d v0 = _mm256_loadu_pd(a0 + i), v1 = _mm256_loadu_pd(a1 + i);
+            __m256d v2 = _mm256_loadu_pd(a2 + i), v3 = _mm256_loadu_pd(a3 + i);
+            yv = _mm256_fmadd_pd(v0, b0, yv);
+            c0 = _mm256_fmadd_pd(v0, xv, c0);
+            yv = _mm256_fmadd_pd(v1, b1, yv);
+            c1 = _mm256_fmadd_pd(v1, xv, c1);
+            yv = _mm256_fmadd_pd(v2, b2, yv);
+            c2 = _mm256_fmadd_pd(v2, xv, c2);
+            yv = _mm256_fmadd_pd(v3, b3, yv);
+            c3 = _mm256_fmadd_pd(v3, xv, c3);
+            _mm256_storeu_pd(y1 + i, yv);
+        }
+        s0 = l2_hsum_pd(c0);
+        s1 = l2_hsum_pd(c1);
+        s2 = l2_hsum_pd(c2);
+        s3 = l2_hsum_pd(c3);
+        for (; i < m; i++) {
+            y1[i] += t0 * a0[i] + t1 * a1[i] + t2 * a2[i] + t3 * a3[i];
+            s0 += a0[i] * x1[i];
+            s1 += a1[i] * x1[i];
+            s2 += a2[i] * x1[i];
+            s3 += a3[i] * x1[i];
+        }
+        y2[j]     += alpha * s0;
+        y2[j + 1] += alpha * s1;
+        y2[j + 2] += alpha * s2;
+        y2[j + 3] += alpha * s3;
+    }
+    for (; j < n; j++) {
+        const double *a0 = a + j * lda;
+        double t0 = alpha * x2[j], s0;
+        __m256d b0 = _mm256_set1_pd(t0), c0 = _mm256_setzero_pd();
+        BLASLONG i = 0;
+
+        for (; i + 4 <= m; i += 4) {
+            __m256d v0 = _mm256_loadu_pd(a0 + i);
+            _mm256_storeu_pd(y1 + i, _mm256_fmadd_pd(v0, b0, _mm256_loadu_pd(y1 + i)));
+            c0 = _mm256_fmadd_pd(v0, _mm256_loadu_pd(x1 + i), c0);
+        }
+        s0 = l2_hsum_pd(c0);
+        for (; i < m; i++) {
+            y1[i] += t0 * a0[i];
+            s0 += a0[i] * x1[i];
+        }
+        y2[j] += alpha * s0;
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * AVX-512F fused symv panels; same scheme as symv_avx2.c with masked row
+ * tails.
+ */
+#include <immintrin.h>
+#include "l2blas_internal.h"
+
+void l2_ssymv_panel_avx512(BLASLONG m, BLASLONG n, float alpha,
+                           const float *a, BLASLONG lda,
+                           const float *x1, float *y1,
+                           const float *x2, float *y2) {
+    BLASLONG mv = m & ~(BLASLONG)15;
+    __mmask16 k = (__mmask16)((1u << (m - mv)) - 1u);
+    BLASLONG j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        const float *a0 = a + j * lda, *a1 = a0 + lda;
+        const float *a2 = a1 + lda,    *a3 = a2 + lda;
+        __m512 b0 = _mm512_set1_ps(alpha * x2[j]);
+        __m512 b1 = _mm512_set1_ps(alpha * x2[j + 1]);
+        __m512 b2 = _mm512_set1_ps(alpha * x2[j + 2]);
+        __m512 b3 = _mm512_set1_ps(alpha * x2[j + 3]);
+        __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps();
+        __m512 c2 = _mm512_setzero_ps(), c3 = _mm512_setzero_ps();
+        BLASLONG i = 0;
+
+        for (; i < mv; i += 16) {
+            __m512 xv = _mm512_loadu_ps(x1 + i);
+            __m512 yv = _mm512_loadu_ps(y1 + i);
+            __m512 v0 = _mm512_loadu_ps(a0 + i), v1 = _mm512_loadu_ps(a1 + i);
+            __m512 v2 = _mm512_loadu_ps(a2 + i), v3 = _mm512_loadu_ps(a3 + i);
+            yv = _mm512_fmadd_ps(v0, b0, yv);
+            c0 = _mm512_fmadd_ps(v0, xv, c0);
+            yv = _mm512_fmadd_ps(v1, b1, yv);
+            c1 = _mm512_fmadd_ps(v1, xv, c1);
+            yv = _mm512_fmadd_ps(v2, b2, yv);
+            c2 = _mm512_fmadd_ps(v2, xv, c2);
+            yv = _mm512_fmadd_ps(v3, b3, yv);
+            c3 = _mm512_fmadd_ps(v3, xv, c3);
+            _mm512_storeu_ps(y1 + i, yv);
+        }
+        if (k) {
+            __m512 xv = _mm512_maskz_loadu_ps(k, x1 + i);
+            __m512 yv = _mm512_maskz_loadu_ps(k, y1 + i);
+            __m512 v0 = _mm512_maskz_loadu_ps(k, a0 + i);
+            __m512 v1 = _mm512_maskz_loadu_ps(k, a1 + i);
+            __m512 v2 = _mm512_maskz_loadu_ps(k, a2 + i);
+            __m512 v3 = _mm512_maskz_loadu_ps(k, a3 + i);
+            yv = _mm512_fmadd_ps(v0, b0, yv);
+            c0 = _mm512_fmadd_ps(v0, xv, c0);
+            yv = _mm512_fmadd_ps(v1, b1, yv);
+            c1 = _mm512_fmadd_ps(v1, xv, c1);
+            yv = _mm512_fmadd_ps(v2, b2, yv);
+            c2 = _mm512_fmadd_ps(v2, xv, c2);
+            yv = _mm512_fmadd_ps(v3, b3, yv);
+            c3 = _mm512_fmadd_ps(v3, xv, c3);
+            _mm512_mask_storeu_ps(y1 + i, k, yv);
+        }
+        y2[j]     += alpha * _mm512_reduce_add_ps(c0);
+        y2[j + 1] += alpha * _mm512_reduce_add_ps(c1);
+        y2[j + 2] += alpha * _mm512_reduce_add_ps(c2);
+        y2[j + 3] += alpha * _mm512_reduce_add_ps(c3);
+    }
+    for (; j < n; j++) {
+        const float *a0 = a + j * lda;
+        __m512 b0 = _mm512_set1_ps(alpha * x2[j]), c0 = _mm512_setzero_ps();
+        BLASLONG i = 0;
+
+        for (; i < mv; i += 16) {
+            __m512 v0 = _mm512_loadu_ps(a0 + i);
+            _mm512_storeu_ps(y1 + i, _mm512_fmadd_ps(v0, b0, _mm512_loadu_ps(y1 + i)));
+            c0 = _mm512_fmadd_ps(v0, _mm512_loadu_ps(x1 + i), c0);
+        }
+        if (k) {
+            __m512 v0 = _mm512_maskz_loadu_ps(k, a0 + i);
+            _mm512_mask_storeu_ps(y1 + i, k,
+                _mm512_fmadd_ps(v0, b0, _mm512_maskz_loadu_ps(k, y1 + i)));
+            c0 = _mm512_fmadd_ps(v0, _mm512_maskz_loadu_ps(k, x1 + i), c0);
+        }
+        y2[j] += alpha * _mm512_reduce_add_ps(c0);
+    }
+}
+
+void l2_dsymv_panel_avx512(BLASLONG m, BLASLONG n, double alpha,
+                           const double *a, BLASLONG lda,
+                           const double *x1, double *y1,
+                           const double *x2, double *y2) {
+    BLASLONG mv = m & ~(BLASLONG)7;
+    __mmask8 k = (__mmask8)((1u << (m - mv)) - 1u);
+    BLASLONG j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        const double *a0 = a + j * lda, *a1 = a0 + lda;
+        const double *a2 = a1 + lda,    *a3 = a2 + lda;
+        __m512d b0 = _mm512_set1_pd(alpha * x2[j]);
+        __m512d b1 = _mm512_set1_pd(alpha * x2[j + 1]);
+        __m512d b2 = _mm512_set1_pd(alpha * x2[j + 2]);
+        __m512d b3 = _mm512_set1_pd(alpha * x2[j + 3]);
+        __m512d c0 = _mm512_setzero_pd(), c1 = _mm512_setzero_pd();
+        __m512d c2 = _mm512_setzero_pd(), c3 = _mm512_setzero_pd();
+        BLASLONG i = 0;
+
+        for (; i < mv; i += 8) {
+            __m512d xv = _mm512_loadu_pd(x1 + i);
+            __m512d yv = _mm512_loadu_pd(y1 + i);
+            __m512d v0 = _mm512_loadu_pd(a0 + i), v1 = _mm512_loadu_pd(a1 + i);
+            __m512d v2 = _mm512_loadu_pd(a2 + i), v3 = _mm512_loadu_pd(a3 + i);
+            yv = _mm512_fmadd_pd(v0, b0, yv);
+            c0 = _mm512_fmadd_pd(v0, xv, c0);
+            yv = _mm512_fmadd_pd(v1, b1, yv);
+            c1 = _mm512_fmadd_pd(v1, xv, c1);
+            yv = _mm512_fmadd_pd(v2, b2, yv);
+            c2 = _mm512_fmadd_pd(v2, xv, c2);
+            yv = _mm512_fmadd_pd(v3, b3, yv);
+            c3 = _mm512_fmadd_pd(v3, xv, c3);
+            _mm512_storeu_pd(y1 + i, yv);
+        }
+        if (k) {
+            __m512d xv = _mm512_maskz_loadu_pd(k, x1 + i);
+            __m512d yv = _mm512_maskz_loadu_pd(k, y1 + i);
+            __m512d v0 = _mm512_maskz_loadu_pd(k, a0 + i);
+            __m512d v1 = _mm512_maskz_loadu_pd(k, a1 + i);
+            __m512d v2 = _mm512_maskz_loadu_pd(k, a2 + i);
+            __m512d v3 = _mm512_maskz_loadu_pd(k, a3 + i);
+            yv = _mm512_fmadd_pd(v0, b0, yv);
+            c0 = _mm512_fmadd_pd(v0, xv, c0);
+            yv = _mm512_fmadd_pd(v1, b1, yv);
+            c1 = _mm512_fmadd_pd(v1, xv, c1);
+            yv = _mm512_fmadd_pd(v2, b2, yv);
+            c2 = _mm512_fmadd_pd(v2, xv, c2);
+            yv = _mm512_fmadd_pd(v3, b3, yv);
+            c3 = _mm512_fmadd_pd(v3, xv, c3);
+            _mm512_mask_storeu_pd(y1 + i, k, yv);
+        }
+        y2[j]     += alpha * _mm512_reduce_add_pd(c0);
+        y2[j + 1] += alpha * _mm512_reduce_add_pd(c1);
+        y2[j + 2] += alpha * _mm512_reduce_add_pd(c2);
+        y2[j + 3] += alpha * _mm512_reduce_add_pd(c3);
+    }
+    for (; j < n; j++) {
+        const double *a0 = a + j * lda;
+        __m512d b0 = _mm512_set1_pd(alpha * x2[j]), c0 = _mm512_setzero_pd();
+        BLASLONG i = 0;
+
+        for (; i < mv; i += 8) {
+            __m512d v0 = _mm512_loadu_pd(a0 + i);
+            _mm512_storeu_pd(y1 + i, _mm512_fmadd_pd(v0, b0, _mm512_loadu_pd(y1 + i)));
+            c0 = _mm512_fmadd_pd(v0, _mm512_loadu_pd(x1 + i), c0);
+        }
+        if (k) {
+            __m512d v0 = _mm512_maskz_loadu_pd(k, a0 + i);
+            _mm512_mask_storeu_pd(y1 + i, k,
+                _mm512_fmadd_pd(v0, b0, _mm512_maskz_loadu_pd(k, y1 + i)));
+            c0 = _mm512_fmadd_pd(v0, _mm512_maskz_loadu_pd(k, x1 + i), c0);
+        }
+        y2[j] += alpha * _mm512_reduce_add_pd(c0);
+    }
+}
@@ -0,0 +1,264 @@
+/*
+ * Symmetric and Hermitian rank-1 and rank-2 updates (ssyr/dsyr, cher/zher,
+ * ssyr2/dsyr2, cher2/zher2).
+ *
+ * A := alpha*x*x^T + A, or alpha*x*x^H + A with real alpha, on the uplo
+ * triangle only, through the ger kernels.
+ *
+ * A := alpha*x*y^T + alpha*y*x^T + A, or alpha*x*y^H + conj(alpha)*y*x^H + A.
+ * Done as two rank-1 passes it streams the triangle through memory twice;
+ * here each element is loaded once, takes both terms in registers and is
+ * stored once, so the update costs what one ger over half the matrix does.
+ *
+ * The imaginary parts of a Hermitian diagonal are set to zero, as cher and
+ * cher2 do.  See syr_template.h for the driver and ger2_kernel_template.h
+ * for the rank-2 SIMD kernels.
+ */
+#include "l2blas_internal.h"
+
+static int syr_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                     blasint n, blasint incx, blasint lda) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (uplo != CblasUpper && uplo != CblasLower) return 2;
+    if (n < 0) return 3;
+    if (incx == 0) return 6;
+    if (lda < L2_MAX(1, n)) return 8;
+    return 0;
+}
+
+static int syr2_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                      blasint n, blasint incx, blasint incy, blasint lda) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (uplo != CblasUpper && uplo != CblasLower) return 2;
+    if (n < 0) return 3;
+    if (incx == 0) return 6;
+    if (incy == 0) return 8;
+    if (lda < L2_MAX(1, n)) return 10;
+    return 0;
+}
+
+/* ---- portable kernels ---------------------------------------------------- */
+
+void l2_sger2_kernel_generic(BLASLONG m, BLASLONG n, const float *x,
+                             const float *y, const float *p, const float *q,
+                             float *a, BLASLONG lda) {
+    for (BLASLONG j = 0; j < n; j++) {
+        float *col = a + j * lda;
+        for (BLASLONG i = 0; i < m; i++)
+            col[i] += p[j] * x[i] + q[j] * y[i];
+    }
+}
+
+void l2_dger2_kernel_generic(BLASLONG m, BLASLONG n, const double *x,
+                             const double *y, const double *p,
+                             const double *q, double *a, BLASLONG lda) {
+    for (BLASLONG j = 0; j < n; j++) {
+        double *col = a + j * lda;
+        for (BLASLONG i = 0; i < m; i++)
+            col[i] += p[j] * x[i] + q[j] * y[i];
+    }
+}
+
+void l2_cger2_kernel_generic(BLASLONG m, BLASLONG n, const float *x,
+                             const float *xw, const float *y,
+                             const float *yw, const float *p, const float *q,
+                             float *a, BLASLONG lda) {
+    for (BLASLONG j = 0; j < n; j++) {
+        float *col = a + 2 * j * lda;
+        float pr = p[2 * j], pi = p[2 * j + 1];
+        float qr = q[2 * j], qi = q[2 * j + 1];
+        for (BLASLONG i = 0; i < 2 * m; i++)
+            col[i] += pr * x[i] + pi * xw[i] + qr * y[i] + qi * yw[i];
+    }
+}
+
+void l2_zger2_kernel_generic(BLASLONG m, BLASLONG n, const double *x,
+                             const double *xw, const double *y,
+                             const double *yw, const double *p,
+                             const double *q, double *a, BLASLONG lda) {
+    for (BLASLONG j = 0; j < n; j++) {
+        double *col = a + 2 * j * lda;
+        double pr = p[2 * j], pi = p[2 * j + 1];
+        double qr = q[2 * j], qi = q[2 * j + 1];
+        for (BLASLONG i = 0; i < 2 * m; i++)
+            col[i] += pr * x[i] + pi * xw[i] + qr * y[i] + qi * yw[i];
+    }
+}
+
+/* ---- kernel selection ---------------------------------------------------- */
+
+l2_sger2_kernel l2_sger2_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_sger2_kernel_avx512;
+    case L2_CORE_AVX2:   return l2_sger2_kernel_avx2;
+    default:             return l2_sger2_kernel_generic;
+    }
+}
+
+l2_dger2_kernel l2_dger2_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_dger2_kernel_avx512;
+    case L2_CORE_AVX2:   return l2_dger2_kernel_avx2;
+    default:             return l2_dger2_kernel_generic;
+    }
+}
+
+l2_cger2_kernel l2_cger2_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_cger2_kernel_avx512;
+    case L2_CORE_AVX2:   return l2_cger2_kernel_avx2;
+    default:             return l2_cger2_kernel_generic;
+    }
+}
+
+l2_zger2_kernel l2_zger2_pick(void) {
+    switch (l2_core()) {
+    case L2_CORE_AVX512: return l2_zger2_kernel_avx512;
+    case L2_CORE_AVX2:   return l2_zger2_kernel_avx2;
+    default:             return l2_zger2_kernel_generic;
+    }
+}
+
+/* ---- drivers ------------------------------------------------------------- */
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define KERNEL1 l2_sger_kernel
+#define PICK1() l2_sger_pick()
+#define KERNEL2 l2_sger2_kernel
+#define PICK2() l2_sger2_pick()
+#include "syr_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef KERNEL1
+#undef PICK1
+#undef KERNEL2
+#undef PICK2
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define KERNEL1 l2_dger_kernel
+#define PICK1() l2_dger_pick()
+#define KERNEL2 l2_dger2_kernel
+#define PICK2() l2_dger2_pick()
+#include "syr_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef KERNEL1
+#undef PICK1
+#undef KERNEL2
+#undef PICK2
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define KERNEL1 l2_cger_kernel
+#define PICK1() l2_cger_pick()
+#define KERNEL2 l2_cger2_kernel
+#define PICK2() l2_cger2_pick()
+#include "syr_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef KERNEL1
+#undef PICK1
+#undef KERNEL2
+#undef PICK2
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define KERNEL1 l2_zger_kernel
+#define PICK1() l2_zger_pick()
+#define KERNEL2 l2_zger2_kernel
+#define PICK2() l2_zger2_pick()
+#include "syr_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef KERNEL1
+#undef PICK1
+#undef KERNEL2
+#undef PICK2
+
+void l2_ssyr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const float alpha, const float *x,
+              const blasint incx, const float *y, const blasint incy,
+              float *a, const blasint lda) {
+    int info = syr2_check(order, uplo, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_ssyr2", info); return; }
+    ssyr_compute(2, order, uplo, n, &alpha, x, incx, y, incy, a, lda);
+}
+
+void l2_dsyr2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const double alpha, const double *x,
+              const blasint incx, const double *y, const blasint incy,
+              double *a, const blasint lda) {
+    int info = syr2_check(order, uplo, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_dsyr2", info); return; }
+    dsyr_compute(2, order, uplo, n, &alpha, x, incx, y, incy, a, lda);
+}
+
+void l2_cher2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda) {
+    int info = syr2_check(order, uplo, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_cher2", info); return; }
+    csyr_compute(2, order, uplo, n, alpha, x, incx, y, incy, a, lda);
+}
+
+void l2_zher2(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const blasint n, const void *alpha, const void *x,
+              const blasint incx, const void *y, const blasint incy,
+              void *a, const blasint lda) {
+    int info = syr2_check(order, uplo, n, incx, incy, lda);
+
+    if (info) { l2_xerbla("l2_zher2", info); return; }
+    zsyr_compute(2, order, uplo, n, alpha, x, incx, y, incy, a, lda);
+}
+
+void l2_ssyr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const float alpha, const float *x,
+             const blasint incx, float *a, const blasint lda) {
+    int info = syr_check(order, uplo, n, incx, lda);
+
+    if (info) { l2_xerbla("l2_ssyr", info); return; }
+    ssyr_compute(1, order, uplo, n, &alpha, x, incx, NULL, 0, a, lda);
+}
+
+void l2_dsyr(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const double alpha, const double *x,
+             const blasint incx, double *a, const blasint lda) {
+    int info = syr_check(order, uplo, n, incx, lda);
+
+    if (info) { l2_xerbla("l2_dsyr", info); return; }
+    dsyr_compute(1, order, uplo, n, &alpha, x, incx, NULL, 0, a, lda);
+}
+
+void l2_cher(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const float alpha, const void *x,
+             const blasint incx, void *a, const blasint lda) {
+    float calpha[2] = {alpha, 0.0f};
+    int info = syr_check(order, uplo, n, incx, lda);
+
+    if (info) { l2_xerbla("l2_cher", info); return; }
+    csyr_compute(1, order, uplo, n, calpha, x, incx, NULL, 0, a, lda);
+}
+
+void l2_zher(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+             const blasint n, const double alpha, const void *x,
+             const blasint incx, void *a, const blasint lda) {
+    double zalpha[2] = {alpha, 0.0};
+    int info = syr_check(order, uplo, n, incx, lda);
+
+    if (info) { l2_xerbla("l2_zher", info); return; }
+    zsyr_compute(1, order, uplo, n, zalpha, x, incx, NULL, 0, a, lda);
+}
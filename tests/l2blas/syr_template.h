@@ -0,0 +1,265 @@
+/*
+ * syr / her and syr2 / her2 driver, included once per precision by syr.c
+ * with
+ *   FLOAT    element type (float or double)
+ *   CS       1 for real (syr, syr2), 2 for complex (her, her2)
+ *   PREC     name prefix (s, d, c, z)
+ *   KERNEL1  l2_?ger_kernel      PICK1()  l2_?ger_pick()
+ *   KERNEL2  l2_?ger2_kernel     PICK2()  l2_?ger2_pick()
+ * defined.
+ *
+ * Column-major view: column j of the stored triangle gains
+ *     x * alpha * conj(x(j))                                  (rank 1)
+ *     x * alpha * conj(y(j)) + y * conj(alpha) * conj(x(j))   (rank 2)
+ * (no conjugation for real data) on its rows of the triangle.  A RowMajor
+ * triangle is the ColMajor one of A^T, the opposite uplo; for real data
+ * that is the same update, for complex the update of conj(A), which is the
+ * formula above with x, y and alpha conjugated.
+ *
+ * Threads take column blocks of equal cost (l2_tri_split), and each block
+ * goes by row tiles of L2_SYR_MB: the off-diagonal rectangle of the tile
+ * with the kernel over whole column chunks, then the diagonal block four
+ * columns at a time, each group a small triangle column by column plus a
+ * rectangle below (lower) or above (upper) it.  Unit-stride real vectors
+ * take the block's rows as one tile, so every column is a single stream.
+ */
+
+#define SY_CAT_(a, b) a##b
+#define SY_CAT(a, b) SY_CAT_(a, b)
+#define SY_FN(name) SY_CAT(PREC, name)
+
+#define SY_MB L2_SYR_MB(FLOAT)
+
+typedef struct {
+    BLASLONG n, lda, incx, incy;
+    FLOAT alpha[CS];
+    const FLOAT *x, *y;
+    FLOAT *a;
+    int rank, lower, conj;
+    KERNEL1 kernel1;
+    KERNEL2 kernel2;
+} SY_FN(syr_args);
+
+/* Row tile vectors; y is only built for rank 2. */
+typedef struct {
+    BLASLONG i0, i1;
+    const FLOAT *x, *y;
+#if CS == 2
+    const FLOAT *xw, *yw;
+#endif
+} SY_FN(syr_tile);
+
+/*
+ * Rank 2: p(j) = alpha * conj(y(j)) and q(j) = conj(alpha) * conj(x(j))
+ * for columns [c0, c1), x and y conjugated first when p->conj.  Rank 1
+ * needs none: the ger kernels take their coefficients from x itself.
+ */
+static void SY_FN(syr_coef)(const SY_FN(syr_args) *p, BLASLONG c0,
+                            BLASLONG c1, FLOAT *cp, FLOAT *cq) {
+    if (p->rank == 1) return;
+    for (BLASLONG j = c0; j < c1; j++) {
+        const FLOAT *xj = p->x + CS * j * p->incx;
+        const FLOAT *yj = p->y + CS * j * p->incy;
+#if CS == 1
+        cp[j - c0] = p->alpha[0] * yj[0];
+        cq[j - c0] = p->alpha[0] * xj[0];
+#else
+        /* conj(conj(v)) when the vectors are conjugated: v as stored */
+        FLOAT s = p->conj ? 1 : -1;
+        FLOAT ar = p->alpha[0], ai = p->alpha[1];
+        FLOAT yr = yj[0], yi = s * yj[1], xr = xj[0], xi = s * xj[1];
+        cp[2 * (j - c0)]     = ar * yr - ai * yi;
+        cp[2 * (j - c0) + 1] = ar * yi + ai * yr;
+        cq[2 * (j - c0)]     = ar * xr + ai * xi;
+        cq[2 * (j - c0) + 1] = ar * xi - ai * xr;
+#endif
+    }
+}
+
+/* Rows [r0, r1) of the tile's vectors onto columns [c0, c1). */
+static void SY_FN(syr_rect)(const SY_FN(syr_args) *p,
+                            const SY_FN(syr_tile) *t, BLASLONG r0,
+                            BLASLONG r1, BLASLONG c0, BLASLONG c1,
+                            const FLOAT *cp, const FLOAT *cq) {
+    FLOAT *a = p->a + CS * (c0 * p->lda + r0);
+    const FLOAT *xc = p->x + CS * c0 * p->incx;
+    BLASLONG o = CS * (r0 - t->i0);
+
+    if (r0 >= r1 || c0 >= c1) return;
+#if CS == 1
+    if (p->rank == 1)
+        p->kernel1(r1 - r0, c1 - c0, p->alpha[0], t->x + o, xc, p->incx, a,
+                   p->lda);
+    else
+        p->kernel2(r1 - r0, c1 - c0, t->x + o, t->y + o, cp, cq, a, p->lda);
+#else
+    if (p->rank == 1)
+        p->kernel1(r1 - r0, c1 - c0, p->alpha, t->x + o, t->xw + o, xc,
+                   p->incx, a, p->lda, !p->conj);
+    else
+        p->kernel2(r1 - r0, c1 - c0, t->x + o, t->xw + o, t->y + o,
+                   t->yw + o, cp, cq, a, p->lda);
+#endif
+}
+
+/*
+ * The triangle's part of rows [i0, i1) in columns [c0, c1), the tile
+ * vectors already built.
+ */
+static void SY_FN(syr_tile_update)(const SY_FN(syr_args) *p,
+                                   const SY_FN(syr_tile) *t, BLASLONG c0,
+                                   BLASLONG c1) {
+    FLOAT cp[CS * SY_MB] __attribute__((aligned(64)));
+    FLOAT cq[CS * SY_MB] __attribute__((aligned(64)));
+    BLASLONG i0 = t->i0, i1 = t->i1;
+    BLASLONG r0 = p->lower ? c0 : L2_MAX(c0, i1);
+    BLASLONG r1 = p->lower ? L2_MIN(c1, i0) : c1;
+
+    /* the rectangle left (lower) or right (upper) of the diagonal block */
+    for (BLASLONG c = r0; c < r1; c += SY_MB) {
+        BLASLONG ce = L2_MIN(c + SY_MB, r1);
+        SY_FN(syr_coef)(p, c, ce, cp, cq);
+        SY_FN(syr_rect)(p, t, i0, i1, c, ce, cp, cq);
+    }
+
+    /* the diagonal block, four columns at a time */
+    for (BLASLONG j = L2_MAX(i0, c0); j < L2_MIN(i1, c1); j += 4) {
+        BLASLONG je = L2_MIN(j + 4, L2_MIN(i1, c1));
+
+        SY_FN(syr_coef)(p, j, je, cp, cq);
+        if (!p->lower) SY_FN(syr_rect)(p, t, i0, j, j, je, cp, cq);
+        for (BLASLONG c = j; c < je; c++) {
+            const FLOAT *op = cp + CS * (c - j), *oq = cq + CS * (c - j);
+            if (p->lower) SY_FN(syr_rect)(p, t, c, je, c, c + 1, op, oq);
+            else          SY_FN(syr_rect)(p, t, j, c + 1, c, c + 1, op, oq);
+#if CS == 2
+            p->a[2 * (c * p->lda + c) + 1] = 0;
+#endif
+        }
+        if (p->lower) SY_FN(syr_rect)(p, t, je, i1, j, je, cp, cq);
+    }
+}
+
+/*
+ * Columns [c0, c1) of the triangle, a row tile at a time over the rows
+ * they hold: [c0, n) of a lower triangle, [0, c1) of an upper one.
+ */
+static void SY_FN(syr_cols)(const SY_FN(syr_args) *p, BLASLONG c0,
+                            BLASLONG c1) {
+    FLOAT xv[CS * SY_MB] __attribute__((aligned(64)));
+    FLOAT yv[CS * SY_MB] __attribute__((aligned(64)));
+#if CS == 2
+    FLOAT xw[2 * SY_MB] __attribute__((aligned(64)));
+    FLOAT yw[2 * SY_MB] __attribute__((aligned(64)));
+    FLOAT s = p->conj ? -1 : 1;
+#endif
+    BLASLONG r0 = p->lower ? c0 : 0, r1 = p->lower ? p->n : c1;
+
+    if (c0 >= c1) return;
+#if CS == 1
+    /* unit-stride real vectors need no tile: whole columns, as in ger */
+    if (p->incx == 1 && (p->rank == 1 || p->incy == 1)) {
+        SY_FN(syr_tile) t = {r0, r1, p->x + r0, p->y + r0};
+        SY_FN(syr_tile_update)(p, &t, c0, c1);
+        return;
+    }
+#endif
+    for (BLASLONG i = r0; i < r1; i += SY_MB) {
+        BLASLONG len = L2_MIN(SY_MB, r1 - i);
+        const FLOAT *x = p->x + CS * i * p->incx;
+        const FLOAT *y = p->y + CS * i * p->incy;
+        SY_FN(syr_tile) t;
+
+        t.i0 = i;
+        t.i1 = i + len;
+        for (BLASLONG k = 0; k < len; k++) {
+#if CS == 1
+            xv[k] = x[k * p->incx];
+#else
+            FLOAT xr = x[2 * k * p->incx], xi = s * x[2 * k * p->incx + 1];
+            xv[2 * k] = xr;  xv[2 * k + 1] = xi;
+            xw[2 * k] = -xi; xw[2 * k + 1] = xr;
+#endif
+        }
+        for (BLASLONG k = 0; k < len && p->rank == 2; k++) {
+#if CS == 1
+            yv[k] = y[k * p->incy];
+#else
+            FLOAT yr = y[2 * k * p->incy], yi = s * y[2 * k * p->incy + 1];
+            yv[2 * k] = yr;  yv[2 * k + 1] = yi;
+            yw[2 * k] = -yi; yw[2 * k + 1] = yr;
+#endif
+        }
+        t.x = xv;
+        t.y = yv;
+#if CS == 2
+        t.xw = xw;
+        t.yw = yw;
+#endif
+        SY_FN(syr_tile_update)(p, &t, c0, c1);
+    }
+}
+
+/*
+ * Column blocks of equal cost: a lower triangle's columns shorten left to
+ * right, an upper one's grow, and each column is one more stream to start.
+ */
+static void SY_FN(syr_worker)(int tid, int nthreads, void *arg) {
+    const SY_FN(syr_args) *p = arg;
+    BLASLONG align = 64 / (CS * (BLASLONG)sizeof(FLOAT));
+    BLASLONG cost = L2_TRI_LINE_BYTES / (CS * (BLASLONG)sizeof(FLOAT));
+    int grows = !p->lower;
+
+    SY_FN(syr_cols)(p, l2_tri_split(p->n, grows, cost, tid, nthreads, align),
+                    l2_tri_split(p->n, grows, cost, tid + 1, nthreads,
+                                 align));
+}
+
+/* y and incy are ignored for rank 1 (syr / her). */
+static void SY_FN(syr_compute)(int rank, enum CBLAS_ORDER order,
+                               enum CBLAS_UPLO uplo, BLASLONG n,
+                               const FLOAT *alpha, const FLOAT *x,
+                               BLASLONG incx, const FLOAT *y, BLASLONG incy,
+                               FLOAT *a, BLASLONG lda) {
+    SY_FN(syr_args) p;
+    int nthreads = l2_get_num_threads();
+    double work = 0.5 * (double)n * (double)(n + 1) * CS;
+
+#if CS == 1
+    if (n == 0 || alpha[0] == 0) return;
+#else
+    if (n == 0 || (alpha[0] == 0 && alpha[1] == 0)) return;
+#endif
+    if (rank == 1) {
+        y = x;
+        incy = incx;
+    }
+    p.rank = rank;
+    p.n = n;
+    p.lda = lda;
+    p.x = L2_VEC_BASE(x, n, CS * incx);
+    p.y = L2_VEC_BASE(y, n, CS * incy);
+    p.incx = incx;
+    p.incy = incy;
+    p.a = a;
+    p.lower = (uplo == CblasLower) == (order == CblasColMajor);
+    p.conj = CS == 2 && order == CblasRowMajor;
+    p.alpha[0] = alpha[0];
+#if CS == 2
+    p.alpha[1] = p.conj ? -alpha[1] : alpha[1];
+#endif
+    p.kernel1 = PICK1();
+    p.kernel2 = PICK2();
+
+    if (nthreads > 1 && work >= 2.0 * L2_GER_MIN_WORK) {
+        nthreads = (int)L2_MIN((double)nthreads, work / L2_GER_MIN_WORK);
+        l2_parallel(nthreads, SY_FN(syr_worker), &p);
+    } else {
+        SY_FN(syr_cols)(&p, 0, n);
+    }
+}
+
+#undef SY_CAT_
+#undef SY_CAT
+#undef SY_FN
+#undef SY_MB
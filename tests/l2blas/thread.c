@@ -0,0 +1,393 @@
+/*
+ * Work-stealing worker pool behind l2_parallel(), and the same pool offered
+ * to OpenBLAS through openblas_set_threads_callback_function.
+ *
+ * A parallel region lives on its caller's stack.  Its thread slots are not
+ * bound to threads: whoever holds the region claims the next slot from an
+ * atomic counter until none are left.  The caller pushes the region onto
+ * the deques of as many workers as it wants helpers, runs slots itself, and
+ * returns once every slot has finished.  A worker takes regions from the
+ * back of its own deque and, when that is empty, steals from the front of
+ * the others'; with nothing anywhere it sleeps on a condition variable.
+ *
+ * Any number of application threads can be inside regions at once: they
+ * share the one set of workers (at most l2_get_num_threads() - 1 of them,
+ * however many callers there are), so concurrent callers neither fall back
+ * to running alone nor add threads.  A region entered from inside a slot
+ * works the same way.  Nothing here allocates once the workers exist.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#include "l2blas.h"
+#include "l2blas_internal.h"
+
+/* Regions queued per worker; a region that finds a deque full skips it. */
+#define POOL_DEPTH 64
+
+typedef struct {
+    l2_thread_fn fn;
+    void        *arg;
+    int          nthreads;
+    atomic_int   next;      /* first unclaimed slot */
+    atomic_int   busy;      /* unfinished slots + workers holding the region */
+    double      *slot_sec;  /* busy seconds per slot, NULL: not timed */
+} pool_region;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pool_region    *ring[POOL_DEPTH];   /* NULL: withdrawn by its caller */
+    unsigned long   head, tail;         /* steal at head, own pop at tail */
+} pool_deque;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  pool_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  pool_done = PTHREAD_COND_INITIALIZER;
+
+static pool_deque     deques[L2_MAX_THREADS];
+static atomic_int     nworkers;             /* deques[0..nworkers) are live */
+static atomic_ulong   work_gen;             /* bumped on every push */
+static atomic_uint    push_next;            /* first deque of the next push */
+static int            sleepers;
+
+static _Thread_local int worker_id = -1;
+
+static pthread_once_t threads_once = PTHREAD_ONCE_INIT;
+static int num_threads = 1;
+
+static atomic_int tri_split_mode;           /* enum L2_TRI_SPLIT */
+static atomic_int slot_timing;
+static _Thread_local double last_sec[L2_MAX_THREADS];
+static _Thread_local int    last_slots;
+
+static int online_procs(void) {
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+static void threads_init(void) {
+    const char *env = getenv("L2BLAS_NUM_THREADS");
+    int n = 0;
+
+    if (!env || !*env) env = getenv("OPENBLAS_NUM_THREADS");
+    if (env && *env) n = atoi(env);
+    if (n <= 0) n = online_procs();
+    num_threads = L2_MIN(L2_MAX(n, 1), L2_MAX_THREADS);
+}
+
+void l2_set_num_threads(int n) {
+    pthread_once(&threads_once, threads_init);
+    num_threads = L2_MIN(L2_MAX(n, 1), L2_MAX_THREADS);
+}
+
+int l2_get_num_threads(void) {
+    pthread_once(&threads_once, threads_init);
+    return num_threads;
+}
+
+/* ---- triangle partitioning ---------------------------------------------- */
+
+void l2_set_tri_split(enum L2_TRI_SPLIT mode) {
+    atomic_store(&tri_split_mode, mode == L2_SPLIT_EVEN);
+}
+
+/*
+ * Lines [0, r) of a growing triangle cost r (r + 1) / 2 + c r: the r at
+ * which that reaches t.
+ */
+static double tri_lines(double t, double c) {
+    double b = c + 0.5;
+
+    return sqrt(b * b + 2.0 * t) - b;
+}
+
+BLASLONG l2_tri_split(BLASLONG n, int grows, BLASLONG line_cost, int k,
+                      int nparts, BLASLONG align) {
+    double c = (double)line_cost, total, r;
+    BLASLONG b;
+
+    if (k <= 0) return 0;
+    if (k >= nparts) return n;
+    /* a shrinking triangle is a growing one read from its far end */
+    total = 0.5 * (double)n * (double)(n + 1) + c * (double)n;
+    if (atomic_load(&tri_split_mode) == L2_SPLIT_EVEN)
+        r = (double)n * k / nparts;
+    else if (grows)
+        r = tri_lines(total * k / nparts, c);
+    else
+        r = (double)n - tri_lines(total * (nparts - k) / nparts, c);
+    b = (BLASLONG)(r / (double)align + 0.5) * align;
+    return L2_MIN(b, n);
+}
+
+/* ---- slot timing --------------------------------------------------------- */
+
+void l2_set_slot_timing(int on) {
+    atomic_store(&slot_timing, on != 0);
+}
+
+int l2_get_slot_times(double *sec, int max) {
+    for (int t = 0; t < last_slots && t < max; t++)
+        sec[t] = last_sec[t];
+    return last_slots;
+}
+
+/* CPU time of the calling thread: time spent waiting for memory counts. */
+static double slot_clock(void) {
+    struct timespec ts;
+
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+/* ---- regions and deques ------------------------------------------------- */
+
+static void region_release(pool_region *r) {
+    /* r may be gone as soon as busy reaches 0: only globals after that */
+    if (atomic_fetch_sub(&r->busy, 1) == 1) {
+        pthread_mutex_lock(&pool_lock);
+        pthread_cond_broadcast(&pool_done);
+        pthread_mutex_unlock(&pool_lock);
+    }
+}
+
+static void region_run(pool_region *r) {
+    int t;
+
+    while ((t = atomic_fetch_add(&r->next, 1)) < r->nthreads) {
+        double t0 = r->slot_sec ? slot_clock() : 0;
+
+        r->fn(t, r->nthreads, r->arg);
+        if (r->slot_sec) r->slot_sec[t] = slot_clock() - t0;
+        region_release(r);
+    }
+}
+
+/* Queues r on d; returns the ring position, or -1 if d is full. */
+static long deque_push(pool_deque *d, pool_region *r) {
+    long pos = -1;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->tail - d->head < POOL_DEPTH) {
+        pos = (long)d->tail;
+        d->ring[d->tail++ % POOL_DEPTH] = r;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return pos;
+}
+
+/*
+ * Takes a region from the back (own deque) or the front (stealing) of d and
+ * holds it: the caller of l2_parallel will not return before region_release.
+ */
+static pool_region *deque_take(pool_deque *d, int own) {
+    pool_region *r = NULL;
+
+    pthread_mutex_lock(&d->lock);
+    while (!r && d->head != d->tail)
+        r = own ? d->ring[--d->tail % POOL_DEPTH]
+                : d->ring[d->head++ % POOL_DEPTH];
+    if (r) atomic_fetch_add(&r->busy, 1);
+    pthread_mutex_unlock(&d->lock);
+    return r;
+}
+
+/* Withdraws r from position pos of d unless a worker took it already. */
+static void deque_withdraw(pool_deque *d, long pos, pool_region *r) {
+    unsigned long p = (unsigned long)pos;
+
+    pthread_mutex_lock(&d->lock);
+    if (p >= d->head && p < d->tail && d->ring[p % POOL_DEPTH] == r)
+        d->ring[p % POOL_DEPTH] = NULL;
+    pthread_mutex_unlock(&d->lock);
+}
+
+static pool_region *pool_take(int self) {
+    int n = atomic_load(&nworkers);
+    pool_region *r;
+
+    if (self >= 0 && (r = deque_take(&deques[self], 1)))
+        return r;
+    for (int i = 1; i <= n; i++) {
+        int v = (self + i) % n;
+        if (v != self && (r = deque_take(&deques[v], 0)))
+            return r;
+    }
+    return NULL;
+}
+
+static void *worker_main(void *p) {
+    worker_id = (int)(intptr_t)p;
+    for (;;) {
+        unsigned long gen = atomic_load(&work_gen);
+        pool_region *r = pool_take(worker_id);
+
+        if (r) {
+            region_run(r);
+            region_release(r);
+            continue;
+        }
+        pthread_mutex_lock(&pool_lock);
+        sleepers++;
+        while (atomic_load(&work_gen) == gen)
+            pthread_cond_wait(&pool_wake, &pool_lock);
+        sleepers--;
+        pthread_mutex_unlock(&pool_lock);
+    }
+    return NULL;
+}
+
+/* Starts workers up to want; returns how many exist (fewer if creation failed). */
+static int pool_grow(int want) {
+    int n = atomic_load(&nworkers);
+
+    if (n >= want) return n;
+    pthread_mutex_lock(&pool_lock);
+    for (n = atomic_load(&nworkers); n < want; n++) {
+        pthread_t th;
+
+        pthread_mutex_init(&deques[n].lock, NULL);
+        if (pthread_create(&th, NULL, worker_main, (void *)(intptr_t)n) != 0)
+            break;
+        pthread_detach(th);
+        atomic_store(&nworkers, n + 1);
+    }
+    pthread_mutex_unlock(&pool_lock);
+    return n;
+}
+
+int l2_pool_reserve(int nthreads) {
+    int want = L2_MIN(L2_MAX(nthreads, 1), l2_get_num_threads()) - 1;
+
+    return pool_grow(want) + 1;
+}
+
+void l2_parallel(int nthreads, l2_thread_fn fn, void *arg) {
+    pool_region r;
+    long pos[L2_MAX_THREADS];
+    double sec[L2_MAX_THREADS];
+    int want, nw, first, helpers = 0, timed = atomic_load(&slot_timing);
+
+    if (nthreads > L2_MAX_THREADS) nthreads = L2_MAX_THREADS;
+    if (nthreads <= 1) {
+        double t0 = timed ? slot_clock() : 0;
+
+        fn(0, 1, arg);
+        if (timed) {
+            last_sec[0] = slot_clock() - t0;
+            last_slots = 1;
+        }
+        return;
+    }
+
+    r.fn = fn;
+    r.arg = arg;
+    r.nthreads = nthreads;
+    r.slot_sec = timed ? sec : NULL;
+    atomic_init(&r.next, 0);
+    atomic_init(&r.busy, nthreads);
+
+    /* never more workers than l2_get_num_threads() - 1, whatever nthreads */
+    want = L2_MIN(nthreads, l2_get_num_threads()) - 1;
+    nw = pool_grow(want);
+    first = (int)(atomic_fetch_add(&push_next, 1) % (unsigned)L2_MAX(nw, 1));
+    for (int i = 0; i < nw && helpers < want; i++) {
+        int d = (first + i) % nw;
+        if (d == worker_id) continue;
+        pos[d] = deque_push(&deques[d], &r);
+        helpers += pos[d] >= 0;
+    }
+    if (helpers) {
+        atomic_fetch_add(&work_gen, 1);
+        pthread_mutex_lock(&pool_lock);
+        if (sleepers) pthread_cond_broadcast(&pool_wake);
+        pthread_mutex_unlock(&pool_lock);
+    }
+
+    region_run(&r);
+
+    /* No slot left to claim: take back the queue entries nobody reached. */
+    for (int i = 0, n = 0; i < nw && n < helpers; i++) {
+        int d = (first + i) % nw;
+        if (d == worker_id || pos[d] < 0) continue;
+        deque_withdraw(&deques[d], pos[d], &r);
+        n++;
+    }
+    if (atomic_load(&r.busy) > 0) {
+        pthread_mutex_lock(&pool_lock);
+        while (atomic_load(&r.busy) > 0)
+            pthread_cond_wait(&pool_done, &pool_lock);
+        pthread_mutex_unlock(&pool_lock);
+    }
+    if (timed) {
+        for (int t = 0; t < nthreads; t++)
+            last_sec[t] = sec[t];
+        last_slots = nthreads;
+    }
+}
+
+/* ---- OpenBLAS threading callback ---------------------------------------- */
+
+typedef struct {
+    l2_dojob_fn dojob;
+    int                     numjobs;
+    size_t                  elsize;
+    char                   *jobdata;
+    int                     dojob_data;
+} ob_jobs;
+
+static void ob_worker(int tid, int nthreads, void *arg) {
+    ob_jobs *j = arg;
+
+    for (int i = tid; i < j->numjobs; i += nthreads)
+        j->dojob(i, j->jobdata + (size_t)i * j->elsize, j->dojob_data);
+}
+
+void l2_openblas_threads(int sync, l2_dojob_fn dojob, int numjobs,
+                         size_t jobdata_elsize, void *jobdata, int dojob_data) {
+    ob_jobs j;
+
+    /* every call returns with its jobs done, which also serves sync == 0 */
+    (void)sync;
+    if (numjobs <= 0) return;
+    j.dojob = dojob;
+    j.numjobs = numjobs;
+    j.elsize = jobdata_elsize;
+    j.jobdata = jobdata;
+    j.dojob_data = dojob_data;
+    l2_parallel(L2_MIN(numjobs, L2_MAX_THREADS), ob_worker, &j);
+}
+
+/*
+ * Declared here rather than taken from cblas.h, which only has it from the
+ * OpenBLAS release that added the hook.  Weak, so older libraries link and
+ * leave it NULL.
+ */
+extern void openblas_set_threads_callback_function(
+    void (*callback)(int sync, l2_dojob_fn dojob, int numjobs,
+                     size_t jobdata_elsize, void *jobdata, int dojob_data))
+    __attribute__((weak));
+
+int l2_set_openblas_threads(int on) {
+    if (!openblas_set_threads_callback_function) return -1;
+    openblas_set_threads_callback_function(on ? l2_openblas_threads : NULL);
+    return 0;
+}
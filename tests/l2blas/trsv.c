@@ -0,0 +1,146 @@
+/*
+ * Blocked, multithreaded triangular solve and multiply (strsv/dtrsv/ctrsv/
+ * ztrsv, strmv/dtrmv/ctrmv/ztrmv).
+ *
+ * Only the L2_TRSV_NB x L2_TRSV_NB diagonal blocks are done sequentially;
+ * everything else is gemv panels that the SIMD gemv kernels run and that
+ * are split over threads by rows ("n" panels) or columns ("t" panels), so
+ * no reduction is needed.  Threaded trmv needs no sequential part: it
+ * splits bands of the triangle into blocks of equal area instead.  Both
+ * work on x in place and allocate nothing.
+ * See trsv_template.h for the algorithms.
+ */
+#include "l2blas_internal.h"
+
+int l2_trxv_check(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+                  enum CBLAS_TRANSPOSE trans, enum CBLAS_DIAG diag,
+                  blasint n, blasint lda, blasint incx) {
+    if (order != CblasRowMajor && order != CblasColMajor) return 1;
+    if (uplo != CblasUpper && uplo != CblasLower) return 2;
+    if (trans != CblasNoTrans && trans != CblasTrans &&
+        trans != CblasConjTrans && trans != CblasConjNoTrans) return 3;
+    if (diag != CblasUnit && diag != CblasNonUnit) return 4;
+    if (n < 0) return 5;
+    if (lda < L2_MAX(1, n)) return 7;
+    if (incx == 0) return 9;
+    return 0;
+}
+
+static const float  c_one[2] = {1.0f, 0.0f}, c_mone[2] = {-1.0f, 0.0f};
+static const double z_one[2] = {1.0, 0.0},   z_mone[2] = {-1.0, 0.0};
+
+#define FLOAT float
+#define CS 1
+#define PREC s
+#define PANEL_N(m, n, a, lda, x, y, conj, sub) \
+    l2_sgemv_pick(1, 1, 1)(m, n, (sub) ? -1.0f : 1.0f, a, lda, x, 1, y, 1)
+#define PANEL_T(m, n, a, lda, x, y, conj, sub) \
+    l2_sgemv_pick(0, 1, 1)(m, n, (sub) ? -1.0f : 1.0f, a, lda, x, 1, y, 1)
+#include "trsv_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef PANEL_N
+#undef PANEL_T
+
+#define FLOAT double
+#define CS 1
+#define PREC d
+#define PANEL_N(m, n, a, lda, x, y, conj, sub) \
+    l2_dgemv_pick(1, 1, 1)(m, n, (sub) ? -1.0 : 1.0, a, lda, x, 1, y, 1)
+#define PANEL_T(m, n, a, lda, x, y, conj, sub) \
+    l2_dgemv_pick(0, 1, 1)(m, n, (sub) ? -1.0 : 1.0, a, lda, x, 1, y, 1)
+#include "trsv_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef PANEL_N
+#undef PANEL_T
+
+#define FLOAT float
+#define CS 2
+#define PREC c
+#define PANEL_N(m, n, a, lda, x, y, conj, sub) \
+    l2_cgemv_panel_pick()(m, n, (sub) ? c_mone : c_one, a, lda, NULL, 0, \
+                           y, 1, x, 1, NULL, 0, conj, 0)
+#define PANEL_T(m, n, a, lda, x, y, conj, sub) \
+    l2_cgemv_panel_pick()(m, n, (sub) ? c_mone : c_one, a, lda, x, 1, \
+                           NULL, 0, NULL, 0, y, 1, 0, conj)
+#include "trsv_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef PANEL_N
+#undef PANEL_T
+
+#define FLOAT double
+#define CS 2
+#define PREC z
+#define PANEL_N(m, n, a, lda, x, y, conj, sub) \
+    l2_zgemv_panel_pick()(m, n, (sub) ? z_mone : z_one, a, lda, NULL, 0, \
+                           y, 1, x, 1, NULL, 0, conj, 0)
+#define PANEL_T(m, n, a, lda, x, y, conj, sub) \
+    l2_zgemv_panel_pick()(m, n, (sub) ? z_mone : z_one, a, lda, x, 1, \
+                           NULL, 0, NULL, 0, y, 1, 0, conj)
+#include "trsv_template.h"
+#undef FLOAT
+#undef CS
+#undef PREC
+#undef PANEL_N
+#undef PANEL_T
+
+void l2_strsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const float *a, const blasint lda, float *x,
+              const blasint incx) {
+    strsv_driver("l2_strsv", order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+void l2_dtrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const double *a, const blasint lda, double *x,
+              const blasint incx) {
+    dtrsv_driver("l2_dtrsv", order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+void l2_ctrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *a, const blasint lda, void *x,
+              const blasint incx) {
+    ctrsv_driver("l2_ctrsv", order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+void l2_ztrsv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *a, const blasint lda, void *x,
+              const blasint incx) {
+    ztrsv_driver("l2_ztrsv", order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+void l2_strmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const float *a, const blasint lda, float *x,
+              const blasint incx) {
+    strmv_driver("l2_strmv", order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+void l2_dtrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const double *a, const blasint lda, double *x,
+              const blasint incx) {
+    dtrmv_driver("l2_dtrmv", order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+void l2_ctrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *a, const blasint lda, void *x,
+              const blasint incx) {
+    ctrmv_driver("l2_ctrmv", order, uplo, trans, diag, n, a, lda, x, incx);
+}
+
+void l2_ztrmv(const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+              const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+              const blasint n, const void *a, const blasint lda, void *x,
+              const blasint incx) {
+    ztrmv_driver("l2_ztrmv", order, uplo, trans, diag, n, a, lda, x, incx);
+}
@@ -0,0 +1,455 @@
+/*
+ * trsv and trmv bodies, included once per precision by trsv.c with
+ *   FLOAT     element type (float or double)
+ *   CS        reals per element (1 real, 2 complex)
+ *   PREC      name prefix (s, d, c, z)
+ *   PANEL_N(m, n, a, lda, x, y, conj, sub)   y -= op(A) * x, += if !sub
+ *   PANEL_T(m, n, a, lda, x, y, conj, sub)   y -= op(A)^T * x, += if !sub
+ * defined; the panels take unit-stride vectors and op() conjugates A when
+ * conj is set.
+ *
+ * All solves are column-major; the driver has already folded RowMajor into
+ * the opposite triangle and transpose.  Every off-diagonal access is a gemv
+ * panel over whole columns of block k, which keeps A streaming in long
+ * contiguous runs: NoTrans pushes the solved x_k into the remaining
+ * unknowns ("n" panel below/above the block), Trans first pulls the
+ * already solved unknowns into x_k ("t" panel).  The panels are where the
+ * threads go.
+ *
+ * trmv is the same sweep with the dependencies reversed: a block's product
+ * needs the other blocks' x still unchanged, so the blocks go in the order
+ * trsv would take them backwards, and x is overwritten in place with no
+ * buffer at any size.  On several threads trmv goes by bands instead (see
+ * trmv_threaded), with one band of products in a stack buffer.
+ */
+
+#define TRSV_CAT_(a, b) a##b
+#define TRSV_CAT(a, b) TRSV_CAT_(a, b)
+#define TRSV_FN(name) TRSV_CAT(PREC, name)
+
+/* y -= op(a) * x on single elements. */
+static inline void TRSV_FN(trsv_axpy1)(FLOAT *y, const FLOAT *a,
+                                       const FLOAT *x, int conj) {
+#if CS == 1
+    (void)conj;
+    y[0] -= a[0] * x[0];
+#else
+    FLOAT ar = a[0], ai = conj ? -a[1] : a[1];
+    y[0] -= ar * x[0] - ai * x[1];
+    y[1] -= ar * x[1] + ai * x[0];
+#endif
+}
+
+/* x /= op(a); complex reciprocal scaled as in the reference BLAS. */
+static inline void TRSV_FN(trsv_div1)(FLOAT *x, const FLOAT *a, int conj) {
+#if CS == 1
+    (void)conj;
+    x[0] /= a[0];
+#else
+    FLOAT ar = a[0], ai = conj ? -a[1] : a[1], rr, ri, t;
+    if ((ar < 0 ? -ar : ar) >= (ai < 0 ? -ai : ai)) {
+        FLOAT ratio = ai / ar, den = (FLOAT)1 / (ar * (1 + ratio * ratio));
+        rr = den;
+        ri = -ratio * den;
+    } else {
+        FLOAT ratio = ar / ai, den = (FLOAT)1 / (ai * (1 + ratio * ratio));
+        rr = ratio * den;
+        ri = -den;
+    }
+    t = rr * x[0] - ri * x[1];
+    x[1] = rr * x[1] + ri * x[0];
+    x[0] = t;
+#endif
+}
+
+/*
+ * Element-by-element solve, any increment.  Serves both the strided driver
+ * path and, with incx == 1, the tiny diagonal strips of the blocked solve.
+ */
+static void TRSV_FN(trsv_unblocked)(int lower, int notrans, int conj, int unit,
+                                    BLASLONG n, const FLOAT *a, BLASLONG lda,
+                                    FLOAT *x, BLASLONG incx) {
+#define A_(i, j) (a + ((i) + (j) * lda) * CS)
+#define X_(i)    (x + (i) * incx * CS)
+    if (notrans) {
+        if (lower) {
+            for (BLASLONG j = 0; j < n; j++) {
+                if (!unit) TRSV_FN(trsv_div1)(X_(j), A_(j, j), conj);
+                for (BLASLONG i = j + 1; i < n; i++)
+                    TRSV_FN(trsv_axpy1)(X_(i), A_(i, j), X_(j), conj);
+            }
+        } else {
+            for (BLASLONG j = n - 1; j >= 0; j--) {
+                if (!unit) TRSV_FN(trsv_div1)(X_(j), A_(j, j), conj);
+                for (BLASLONG i = 0; i < j; i++)
+                    TRSV_FN(trsv_axpy1)(X_(i), A_(i, j), X_(j), conj);
+            }
+        }
+    } else {
+        if (lower) {
+            for (BLASLONG j = n - 1; j >= 0; j--) {
+                for (BLASLONG i = j + 1; i < n; i++)
+                    TRSV_FN(trsv_axpy1)(X_(j), A_(i, j), X_(i), conj);
+                if (!unit) TRSV_FN(trsv_div1)(X_(j), A_(j, j), conj);
+            }
+        } else {
+            for (BLASLONG j = 0; j < n; j++) {
+                for (BLASLONG i = 0; i < j; i++)
+                    TRSV_FN(trsv_axpy1)(X_(j), A_(i, j), X_(i), conj);
+                if (!unit) TRSV_FN(trsv_div1)(X_(j), A_(j, j), conj);
+            }
+        }
+    }
+#undef A_
+#undef X_
+}
+
+typedef struct {
+    int notrans, conj, sub;
+    BLASLONG m, n, lda;
+    const FLOAT *a, *x;
+    FLOAT *y;
+} TRSV_FN(trsv_panel_args);
+
+/* One thread's share: rows of y for an "n" panel, columns for a "t" one. */
+static void TRSV_FN(trsv_panel_worker)(int tid, int nthreads, void *arg) {
+    const TRSV_FN(trsv_panel_args) *p = arg;
+    BLASLONG len = p->notrans ? p->m : p->n;
+    BLASLONG align = p->notrans ? 16 : 4;
+    BLASLONG chunk = ((len + nthreads - 1) / nthreads + align - 1) & -align;
+    BLASLONG lo = L2_MIN(tid * chunk, len), hi = L2_MIN(lo + chunk, len);
+
+    if (lo == hi) return;
+    if (p->notrans)
+        PANEL_N(hi - lo, p->n, p->a + lo * CS, p->lda, p->x,
+                p->y + lo * CS, p->conj, p->sub);
+    else
+        PANEL_T(p->m, hi - lo, p->a + lo * p->lda * CS, p->lda, p->x,
+                p->y + lo * CS, p->conj, p->sub);
+}
+
+/* y -= op(A) x or op(A)^T x (y += when !sub), threaded when large. */
+static void TRSV_FN(trsv_panel)(int notrans, int conj, int sub, BLASLONG m,
+                                BLASLONG n, const FLOAT *a, BLASLONG lda,
+                                const FLOAT *x, FLOAT *y, int nthreads) {
+    TRSV_FN(trsv_panel_args) p;
+    double work = (double)m * (double)n * CS;
+
+    if (nthreads > 1 && work >= 2.0 * L2_TRSV_MIN_WORK) {
+        p.notrans = notrans;
+        p.conj = conj;
+        p.sub = sub;
+        p.m = m;
+        p.n = n;
+        p.lda = lda;
+        p.a = a;
+        p.x = x;
+        p.y = y;
+        nthreads = (int)L2_MIN((double)nthreads, work / L2_TRSV_MIN_WORK);
+        l2_parallel(nthreads, TRSV_FN(trsv_panel_worker), &p);
+    } else if (notrans) {
+        PANEL_N(m, n, a, lda, x, y, conj, sub);
+    } else {
+        PANEL_T(m, n, a, lda, x, y, conj, sub);
+    }
+}
+
+/*
+ * Blocked solve with unit-stride x in blocks of nb.  Diagonal blocks are
+ * solved by the same routine in L2_TRSV_STRIP strips (serial panels), and
+ * the strips element by element.
+ */
+static void TRSV_FN(trsv_blocked)(int lower, int notrans, int conj, int unit,
+                                  BLASLONG n, const FLOAT *a, BLASLONG lda,
+                                  FLOAT *x, BLASLONG nb, int nthreads) {
+    int forward = lower == notrans;
+    BLASLONG nblk = (n + nb - 1) / nb;
+
+    for (BLASLONG k = 0; k < nblk; k++) {
+        BLASLONG j0 = (forward ? k : nblk - 1 - k) * nb;
+        BLASLONG jb = L2_MIN(nb, n - j0), rest = n - j0 - jb;
+        const FLOAT *akk = a + (j0 + j0 * lda) * CS;
+        FLOAT *xk = x + j0 * CS;
+
+        /* Trans: pull in the solved unknowns through block k's columns. */
+        if (!notrans && lower && rest)
+            TRSV_FN(trsv_panel)(0, conj, 1, rest, jb, akk + jb * CS, lda,
+                                xk + jb * CS, xk, nthreads);
+        else if (!notrans && !lower && j0)
+            TRSV_FN(trsv_panel)(0, conj, 1, j0, jb, a + j0 * lda * CS, lda,
+                                x, xk, nthreads);
+
+        if (nb > L2_TRSV_STRIP)
+            TRSV_FN(trsv_blocked)(lower, notrans, conj, unit, jb, akk, lda,
+                                  xk, L2_TRSV_STRIP, 1);
+        else
+            TRSV_FN(trsv_unblocked)(lower, notrans, conj, unit, jb, akk, lda,
+                                    xk, 1);
+
+        /* NoTrans: push x_k out to the unknowns still to be solved. */
+        if (notrans && lower && rest)
+            TRSV_FN(trsv_panel)(1, conj, 1, rest, jb, akk + jb * CS, lda,
+                                xk, xk + jb * CS, nthreads);
+        else if (notrans && !lower && j0)
+            TRSV_FN(trsv_panel)(1, conj, 1, j0, jb, a + j0 * lda * CS, lda,
+                                xk, x, nthreads);
+    }
+}
+
+static void TRSV_FN(trsv_driver)(const char *rname, enum CBLAS_ORDER order,
+                                 enum CBLAS_UPLO uplo,
+                                 enum CBLAS_TRANSPOSE trans,
+                                 enum CBLAS_DIAG diag, blasint n,
+                                 const FLOAT *a, blasint lda, FLOAT *x,
+                                 blasint incx) {
+    int info = l2_trxv_check(order, uplo, trans, diag, n, lda, incx);
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int conj = CS == 2 &&
+               (trans == CblasConjTrans || trans == CblasConjNoTrans);
+    int lower, notrans;
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (n == 0) return;
+
+    /* A RowMajor triangle is the opposite ColMajor triangle, transposed. */
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    notrans = plain == (order == CblasColMajor);
+    x = L2_VEC_BASE(x, n, incx * CS);
+
+    if (incx == 1)
+        TRSV_FN(trsv_blocked)(lower, notrans, conj, diag == CblasUnit, n, a,
+                              lda, x, L2_TRSV_NB, l2_get_num_threads());
+    else
+        TRSV_FN(trsv_unblocked)(lower, notrans, conj, diag == CblasUnit, n,
+                                a, lda, x, incx);
+}
+
+/* ---- trmv -------------------------------------------------------------- */
+
+/* y += op(a) * x on single elements. */
+static inline void TRSV_FN(trmv_axpy1)(FLOAT *y, const FLOAT *a,
+                                       const FLOAT *x, int conj) {
+#if CS == 1
+    (void)conj;
+    y[0] += a[0] * x[0];
+#else
+    FLOAT ar = a[0], ai = conj ? -a[1] : a[1];
+    y[0] += ar * x[0] - ai * x[1];
+    y[1] += ar * x[1] + ai * x[0];
+#endif
+}
+
+/* x *= op(a). */
+static inline void TRSV_FN(trmv_mul1)(FLOAT *x, const FLOAT *a, int conj) {
+#if CS == 1
+    (void)conj;
+    x[0] *= a[0];
+#else
+    FLOAT ar = a[0], ai = conj ? -a[1] : a[1];
+    FLOAT t = ar * x[0] - ai * x[1];
+    x[1] = ar * x[1] + ai * x[0];
+    x[0] = t;
+#endif
+}
+
+/*
+ * Element-by-element product in place, any increment: every x(j) is read
+ * before the sweep overwrites it, as in the reference BLAS.
+ */
+static void TRSV_FN(trmv_unblocked)(int lower, int notrans, int conj, int unit,
+                                    BLASLONG n, const FLOAT *a, BLASLONG lda,
+                                    FLOAT *x, BLASLONG incx) {
+#define A_(i, j) (a + ((i) + (j) * lda) * CS)
+#define X_(i)    (x + (i) * incx * CS)
+    if (notrans) {
+        if (lower) {
+            for (BLASLONG j = n - 1; j >= 0; j--) {
+                for (BLASLONG i = j + 1; i < n; i++)
+                    TRSV_FN(trmv_axpy1)(X_(i), A_(i, j), X_(j), conj);
+                if (!unit) TRSV_FN(trmv_mul1)(X_(j), A_(j, j), conj);
+            }
+        } else {
+            for (BLASLONG j = 0; j < n; j++) {
+                for (BLASLONG i = 0; i < j; i++)
+                    TRSV_FN(trmv_axpy1)(X_(i), A_(i, j), X_(j), conj);
+                if (!unit) TRSV_FN(trmv_mul1)(X_(j), A_(j, j), conj);
+            }
+        }
+    } else {
+        if (lower) {
+            for (BLASLONG j = 0; j < n; j++) {
+                if (!unit) TRSV_FN(trmv_mul1)(X_(j), A_(j, j), conj);
+                for (BLASLONG i = j + 1; i < n; i++)
+                    TRSV_FN(trmv_axpy1)(X_(j), A_(i, j), X_(i), conj);
+            }
+        } else {
+            for (BLASLONG j = n - 1; j >= 0; j--) {
+                if (!unit) TRSV_FN(trmv_mul1)(X_(j), A_(j, j), conj);
+                for (BLASLONG i = 0; i < j; i++)
+                    TRSV_FN(trmv_axpy1)(X_(j), A_(i, j), X_(i), conj);
+            }
+        }
+    }
+#undef A_
+#undef X_
+}
+
+/*
+ * Blocked product with unit-stride x in blocks of nb, the diagonal blocks
+ * again in L2_TRSV_STRIP strips.  NoTrans pushes the unchanged x_k into
+ * the blocks already finished before its own block is multiplied, so lower
+ * goes back to front and upper front to back; Trans multiplies x_k first
+ * and then pulls in the blocks not yet reached, the other way round.
+ */
+static void TRSV_FN(trmv_blocked)(int lower, int notrans, int conj, int unit,
+                                  BLASLONG n, const FLOAT *a, BLASLONG lda,
+                                  FLOAT *x, BLASLONG nb, int nthreads) {
+    int forward = lower != notrans;
+    BLASLONG nblk = (n + nb - 1) / nb;
+
+    for (BLASLONG k = 0; k < nblk; k++) {
+        BLASLONG j0 = (forward ? k : nblk - 1 - k) * nb;
+        BLASLONG jb = L2_MIN(nb, n - j0), rest = n - j0 - jb;
+        const FLOAT *akk = a + (j0 + j0 * lda) * CS;
+        FLOAT *xk = x + j0 * CS;
+
+        if (notrans && lower && rest)
+            TRSV_FN(trsv_panel)(1, conj, 0, rest, jb, akk + jb * CS, lda,
+                                xk, xk + jb * CS, nthreads);
+        else if (notrans && !lower && j0)
+            TRSV_FN(trsv_panel)(1, conj, 0, j0, jb, a + j0 * lda * CS, lda,
+                                xk, x, nthreads);
+
+        if (nb > L2_TRSV_STRIP)
+            TRSV_FN(trmv_blocked)(lower, notrans, conj, unit, jb, akk, lda,
+                                  xk, L2_TRSV_STRIP, 1);
+        else
+            TRSV_FN(trmv_unblocked)(lower, notrans, conj, unit, jb, akk, lda,
+                                    xk, 1);
+
+        if (!notrans && lower && rest)
+            TRSV_FN(trsv_panel)(0, conj, 0, rest, jb, akk + jb * CS, lda,
+                                xk + jb * CS, xk, nthreads);
+        else if (!notrans && !lower && j0)
+            TRSV_FN(trsv_panel)(0, conj, 0, j0, jb, a + j0 * lda * CS, lda,
+                                x, xk, nthreads);
+    }
+}
+
+/*
+ * Threaded product.  Every entry of op(A) x is a triangle line (a row for
+ * NoTrans, a column for Trans) and depends only on the entries of x on one
+ * side of it ("before": those at lower indices).  Lines go in bands of
+ * L2_TRMV_BAND_BYTES, taken in the order that leaves the x a band reads
+ * unchanged; within a band, slots take line blocks of equal cost
+ * (l2_tri_split: the band's triangle plus the rectangle beside it) and
+ * write their products to a stack buffer, which replaces the band's x once
+ * the region is over.  One pass over A, no reduction.
+ */
+typedef struct {
+    int lower, notrans, conj, unit, before;
+    BLASLONG n, lda, b0, b1;
+    const FLOAT *a, *x;
+    FLOAT *t;           /* products of lines b0..b1 */
+} TRSV_FN(trmv_band_args);
+
+static void TRSV_FN(trmv_band_worker)(int tid, int nthreads, void *arg) {
+    const TRSV_FN(trmv_band_args) *p = arg;
+    BLASLONG h = p->b1 - p->b0, lda = p->lda;
+    BLASLONG extra = p->before ? p->b0 : p->n - p->b1;
+    BLASLONG cost = extra +
+        L2_TRI_LINE_BYTES / (CS * (BLASLONG)sizeof(FLOAT)) / (p->notrans ? 8 : 1);
+    BLASLONG align = p->notrans ? 16 : 4;
+    BLASLONG lo = p->b0 + l2_tri_split(h, p->before, cost, tid, nthreads,
+                                       align);
+    BLASLONG hi = p->b0 + l2_tri_split(h, p->before, cost, tid + 1,
+                                       nthreads, align);
+    FLOAT *t = p->t + (lo - p->b0) * CS;
+
+    if (lo == hi) return;
+    for (BLASLONG i = 0; i < (hi - lo) * CS; i++)
+        t[i] = p->x[lo * CS + i];
+    TRSV_FN(trmv_blocked)(p->lower, p->notrans, p->conj, p->unit, hi - lo,
+                          p->a + (lo + lo * lda) * CS, lda, t, L2_TRSV_NB, 1);
+    if (p->notrans && p->before && lo)
+        PANEL_N(hi - lo, lo, p->a + lo * CS, lda, p->x, t, p->conj, 0);
+    else if (p->notrans && !p->before && hi < p->n)
+        PANEL_N(hi - lo, p->n - hi, p->a + (lo + hi * lda) * CS, lda,
+                p->x + hi * CS, t, p->conj, 0);
+    else if (!p->notrans && p->before && lo)
+        PANEL_T(lo, hi - lo, p->a + lo * lda * CS, lda, p->x, t, p->conj, 0);
+    else if (!p->notrans && !p->before && hi < p->n)
+        PANEL_T(p->n - hi, hi - lo, p->a + (hi + lo * lda) * CS, lda,
+                p->x + hi * CS, t, p->conj, 0);
+}
+
+static void TRSV_FN(trmv_threaded)(int lower, int notrans, int conj, int unit,
+                                   BLASLONG n, const FLOAT *a, BLASLONG lda,
+                                   FLOAT *x, int nthreads) {
+    const BLASLONG band = L2_TRMV_BAND_BYTES / (CS * (BLASLONG)sizeof(FLOAT));
+    BLASLONG nband = (n + band - 1) / band;
+    FLOAT t[L2_TRMV_BAND_BYTES / sizeof(FLOAT)];
+    TRSV_FN(trmv_band_args) p;
+
+    p.lower = lower;
+    p.notrans = notrans;
+    p.conj = conj;
+    p.unit = unit;
+    p.before = lower == notrans;
+    p.n = n;
+    p.lda = lda;
+    p.a = a;
+    p.x = x;
+    p.t = t;
+    for (BLASLONG k = 0; k < nband; k++) {
+        BLASLONG b0 = (p.before ? nband - 1 - k : k) * band;
+        BLASLONG h = L2_MIN(band, n - b0);
+        double work = (0.5 * (double)h * (double)(h + 1) +
+                       (double)h * (double)(p.before ? b0 : n - b0 - h)) * CS;
+        int nt = (int)L2_MIN((double)nthreads, work / L2_TRSV_MIN_WORK);
+
+        p.b0 = b0;
+        p.b1 = b0 + h;
+        if (nt > 1)
+            l2_parallel(nt, TRSV_FN(trmv_band_worker), &p);
+        else
+            TRSV_FN(trmv_band_worker)(0, 1, &p);
+        for (BLASLONG i = 0; i < h * CS; i++)
+            x[b0 * CS + i] = t[i];
+    }
+}
+
+static void TRSV_FN(trmv_driver)(const char *rname, enum CBLAS_ORDER order,
+                                 enum CBLAS_UPLO uplo,
+                                 enum CBLAS_TRANSPOSE trans,
+                                 enum CBLAS_DIAG diag, blasint n,
+                                 const FLOAT *a, blasint lda, FLOAT *x,
+                                 blasint incx) {
+    int info = l2_trxv_check(order, uplo, trans, diag, n, lda, incx);
+    int plain = trans == CblasNoTrans || trans == CblasConjNoTrans;
+    int conj = CS == 2 &&
+               (trans == CblasConjTrans || trans == CblasConjNoTrans);
+    int lower, notrans, nthreads = l2_get_num_threads();
+
+    if (info) { l2_xerbla(rname, info); return; }
+    if (n == 0) return;
+
+    lower = (uplo == CblasLower) == (order == CblasColMajor);
+    notrans = plain == (order == CblasColMajor);
+    x = L2_VEC_BASE(x, n, incx * CS);
+
+    if (incx == 1 && nthreads > 1 &&
+        0.5 * (double)n * (double)(n + 1) * CS >= 2.0 * L2_TRSV_MIN_WORK)
+        TRSV_FN(trmv_threaded)(lower, notrans, conj, diag == CblasUnit, n, a,
+                               lda, x, nthreads);
+    else if (incx == 1)
+        TRSV_FN(trmv_blocked)(lower, notrans, conj, diag == CblasUnit, n, a,
+                              lda, x, L2_TRSV_NB, 1);
+    else
+        TRSV_FN(trmv_unblocked)(lower, notrans, conj, diag == CblasUnit, n,
+                                a, lda, x, incx);
+}
+
+#undef TRSV_FN
+#undef TRSV_CAT
+#undef TRSV_CAT_
@@ -0,0 +1,789 @@
+/*
+ * l2prof - LD_PRELOAD profiler for the CBLAS Level 2 routines (see l2prof.h).
+ *
+ * Each wrapper reads the clock, forwards to the definition found by
+ * dlsym(RTLD_NEXT), and records the call in per-routine counters: layout,
+ * trans/uplo/diag, log2 size buckets, increment and lda classes, and a
+ * log-scale latency histogram (8 sub-buckets per power of two, so reported
+ * percentiles are within about 6% of the measured time).  Exact argument
+ * shapes go to one open-addressing table shared by all routines; once it is
+ * three quarters full, calls with new shapes still reach the histograms but
+ * are listed as dropped instead of by shape.
+ *
+ * Counters are relaxed atomics and the table is filled without locks.  The
+ * histograms are a function of the shape, so they are rebuilt from the
+ * table when the report is written and a profiled call costs two clock
+ * reads, a hash of the arguments and three uncontended increments.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <cblas.h>
+#include "l2prof.h"
+
+/* Which arguments a routine has; selects the histograms and shape fields. */
+enum {
+    PF_MN    = 1 << 0,      /* separate m (rows) besides n */
+    PF_TRANS = 1 << 1,
+    PF_UPLO  = 1 << 2,
+    PF_DIAG  = 1 << 3,
+    PF_KLKU  = 1 << 4,      /* general band */
+    PF_K     = 1 << 5,      /* symmetric / triangular band */
+    PF_LDA   = 1 << 6,
+    PF_INCY  = 1 << 7
+};
+
+#define F_GEMV (PF_MN | PF_TRANS | PF_LDA | PF_INCY)
+#define F_GBMV (F_GEMV | PF_KLKU)
+#define F_TRXV (PF_UPLO | PF_TRANS | PF_DIAG | PF_LDA)
+#define F_TBXV (F_TRXV | PF_K)
+#define F_TPXV (PF_UPLO | PF_TRANS | PF_DIAG)
+#define F_SYMV (PF_UPLO | PF_LDA | PF_INCY)
+#define F_SBMV (F_SYMV | PF_K)
+#define F_SPMV (PF_UPLO | PF_INCY)
+#define F_GER  (PF_MN | PF_LDA | PF_INCY)
+#define F_SYR  (PF_UPLO | PF_LDA)
+#define F_SPR  (PF_UPLO)
+#define F_SYR2 (PF_UPLO | PF_LDA | PF_INCY)
+#define F_SPR2 (PF_UPLO | PF_INCY)
+
+/* Every Level 2 routine declared in cblas.h. */
+#define PROF_ROUTINES(X) \
+    X(sgemv, F_GEMV) X(dgemv, F_GEMV) X(cgemv, F_GEMV) X(zgemv, F_GEMV) \
+    X(sbgemv, F_GEMV) \
+    X(sgbmv, F_GBMV) X(dgbmv, F_GBMV) X(cgbmv, F_GBMV) X(zgbmv, F_GBMV) \
+    X(strmv, F_TRXV) X(dtrmv, F_TRXV) X(ctrmv, F_TRXV) X(ztrmv, F_TRXV) \
+    X(strsv, F_TRXV) X(dtrsv, F_TRXV) X(ctrsv, F_TRXV) X(ztrsv, F_TRXV) \
+    X(stbmv, F_TBXV) X(dtbmv, F_TBXV) X(ctbmv, F_TBXV) X(ztbmv, F_TBXV) \
+    X(stbsv, F_TBXV) X(dtbsv, F_TBXV) X(ctbsv, F_TBXV) X(ztbsv, F_TBXV) \
+    X(stpmv, F_TPXV) X(dtpmv, F_TPXV) X(ctpmv, F_TPXV) X(ztpmv, F_TPXV) \
+    X(stpsv, F_TPXV) X(dtpsv, F_TPXV) X(ctpsv, F_TPXV) X(ztpsv, F_TPXV) \
+    X(ssymv, F_SYMV) X(dsymv, F_SYMV) X(chemv, F_SYMV) X(zhemv, F_SYMV) \
+    X(ssbmv, F_SBMV) X(dsbmv, F_SBMV) X(chbmv, F_SBMV) X(zhbmv, F_SBMV) \
+    X(sspmv, F_SPMV) X(dspmv, F_SPMV) X(chpmv, F_SPMV) X(zhpmv, F_SPMV) \
+    X(sger, F_GER) X(dger, F_GER) \
+    X(cgeru, F_GER) X(cgerc, F_GER) X(zgeru, F_GER) X(zgerc, F_GER) \
+    X(ssyr, F_SYR) X(dsyr, F_SYR) X(cher, F_SYR) X(zher, F_SYR) \
+    X(sspr, F_SPR) X(dspr, F_SPR) X(chpr, F_SPR) X(zhpr, F_SPR) \
+    X(ssyr2, F_SYR2) X(dsyr2, F_SYR2) X(cher2, F_SYR2) X(zher2, F_SYR2) \
+    X(sspr2, F_SPR2) X(dspr2, F_SPR2) X(chpr2, F_SPR2) X(zhpr2, F_SPR2)
+
+#define PROF_ENUM(name, flags) R_##name,
+enum { PROF_ROUTINES(PROF_ENUM) PROF_NROUTINES };
+#undef PROF_ENUM
+
+#define PROF_NAME(name, flags) "cblas_" #name,
+static const char *const routine_names[PROF_NROUTINES] = {
+    PROF_ROUTINES(PROF_NAME)
+};
+#undef PROF_NAME
+
+#define PROF_FLAGS(name, flags) flags,
+static const unsigned routine_flags[PROF_NROUTINES] = {
+    PROF_ROUTINES(PROF_FLAGS)
+};
+#undef PROF_FLAGS
+
+#define PROF_LAT_BUCKETS  496   /* 16 exact + 8 per power of two up to 2^63 */
+#define PROF_SIZE_BUCKETS 32    /* bucket b holds sizes in (2^(b-1), 2^b] */
+#define PROF_SHAPE_SLOTS  8192  /* power of two */
+#define PROF_SHAPE_PROBES 32
+#define PROF_TOP_DEFAULT  20
+
+typedef struct {
+    unsigned long long calls, ns, min_ns, max_ns;
+    unsigned long long layout[2];                   /* ColMajor, RowMajor */
+    unsigned long long trans[4], uplo[2], diag[2];  /* in enum order */
+    unsigned long long incx[4], incy[4];            /* see inc_class() */
+    unsigned long long lda[2];                      /* tight, padded */
+    unsigned long long shapes_dropped;
+    unsigned long long size[PROF_SIZE_BUCKETS][PROF_SIZE_BUCKETS];
+    unsigned long long lat[PROF_LAT_BUCKETS];
+} prof_routine;
+
+/* Arguments that identify a shape; no padding, so memcmp compares keys. */
+typedef struct {
+    int32_t routine;
+    char layout, trans, uplo, diag;     /* letters, 0 if not an argument */
+    int32_t m, n, kl, ku, lda, incx, incy;
+} prof_key;
+
+enum { SLOT_EMPTY, SLOT_BUSY, SLOT_READY };
+
+typedef struct {
+    prof_key key;
+    int state;
+    unsigned long long calls, ns;
+} prof_slot;
+
+static prof_routine routines[PROF_NROUTINES];
+static prof_slot shapes[PROF_SHAPE_SLOTS];
+static unsigned shape_count;
+static void *real_fn[PROF_NROUTINES];
+static unsigned long long start_ns;
+
+#define ADD(v, d) __atomic_fetch_add(&(v), (d), __ATOMIC_RELAXED)
+#define LOAD(v)   __atomic_load_n(&(v), __ATOMIC_RELAXED)
+
+static inline unsigned long long prof_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL +
+           (unsigned long long)ts.tv_nsec;
+}
+
+static void *prof_real(int r) {
+    void *f = __atomic_load_n(&real_fn[r], __ATOMIC_ACQUIRE);
+
+    if (!f) {
+        f = dlsym(RTLD_NEXT, routine_names[r]);
+        if (!f) {
+            const char *err = dlerror();
+            fprintf(stderr, "l2prof: no %s after libl2prof (%s)\n",
+                    routine_names[r], err ? err : "not found");
+            abort();
+        }
+        __atomic_store_n(&real_fn[r], f, __ATOMIC_RELEASE);
+    }
+    return f;
+}
+
+#define REAL(name) ((__typeof__(&cblas_##name))prof_real(R_##name))
+
+static int lat_bucket(unsigned long long ns) {
+    int e;
+
+    if (ns < 16) return (int)ns;
+    e = 63 - __builtin_clzll(ns);
+    return 16 + (e - 4) * 8 + (int)((ns >> (e - 3)) & 7);
+}
+
+/* Midpoint of a latency bucket. */
+static unsigned long long lat_value(int b) {
+    int e, s;
+
+    if (b < 16) return (unsigned long long)b;
+    e = (b - 16) / 8 + 4;
+    s = (b - 16) % 8;
+    return ((8ULL + (unsigned)s) << (e - 3)) + (1ULL << (e - 3)) / 2;
+}
+
+static int size_bucket(blasint v) {
+    int b;
+
+    if (v <= 1) return 0;
+    b = 64 - __builtin_clzll((unsigned long long)v - 1);
+    return b < PROF_SIZE_BUCKETS ? b : PROF_SIZE_BUCKETS - 1;
+}
+
+static const char *const inc_names[4] = {"unit", "strided", "negative", "zero"};
+
+static int inc_class(blasint inc) {
+    return inc == 1 ? 0 : inc > 1 ? 1 : inc < 0 ? 2 : 3;
+}
+
+/* Letter for an enum argument in the shape key; 0 when absent. */
+static inline char enum_letter(int v, int first, int count,
+                               const char *letters) {
+    if (v < 0) return 0;
+    return (unsigned)(v - first) < (unsigned)count ? letters[v - first] : '?';
+}
+
+static prof_slot *shape_slot(const prof_key *key) {
+    uint32_t w[sizeof(prof_key) / 4];
+    uint64_t h = 0x9e3779b97f4a7c15ULL;
+
+    memcpy(w, key, sizeof w);
+    for (size_t i = 0; i < sizeof w / sizeof w[0]; i++)
+        h = (h ^ w[i]) * 0x100000001b3ULL;
+    h ^= h >> 29;
+
+    for (int p = 0; p < PROF_SHAPE_PROBES; p++) {
+        prof_slot *s = &shapes[(h + (uint64_t)p) & (PROF_SHAPE_SLOTS - 1)];
+        int st = __atomic_load_n(&s->state, __ATOMIC_ACQUIRE);
+
+        if (st == SLOT_EMPTY) {
+            if (LOAD(shape_count) >= PROF_SHAPE_SLOTS / 4 * 3) return NULL;
+            if (__atomic_compare_exchange_n(&s->state, &st, SLOT_BUSY, 0,
+                                            __ATOMIC_ACQUIRE,
+                                            __ATOMIC_ACQUIRE)) {
+                s->key = *key;
+                ADD(shape_count, 1);
+                __atomic_store_n(&s->state, SLOT_READY, __ATOMIC_RELEASE);
+                return s;
+            }
+        }
+        while (st == SLOT_BUSY)
+            st = __atomic_load_n(&s->state, __ATOMIC_ACQUIRE);
+        if (memcmp(&s->key, key, sizeof *key) == 0) return s;
+    }
+    return NULL;
+}
+
+static int letter_index(char c, const char *letters) {
+    const char *p = c ? strchr(letters, c) : NULL;
+    return p ? (int)(p - letters) : -1;
+}
+
+/* Smallest legal lda for the shape, as the reference BLAS checks it. */
+static blasint ld_min(unsigned flags, const prof_key *k) {
+    if (flags & PF_KLKU) return k->kl + k->ku + 1;
+    if (flags & PF_K) return k->kl + 1;
+    if (flags & PF_MN) return k->layout == 'R' ? k->n : k->m;
+    return k->n;
+}
+
+/* Add calls/ns of one shape to the per-routine totals and histograms. */
+static void tally(prof_routine *p, unsigned flags, const prof_key *k,
+                  unsigned long long calls, unsigned long long ns) {
+    int i;
+
+    ADD(p->calls, calls);
+    ADD(p->ns, ns);
+    ADD(p->layout[k->layout == 'R'], calls);
+    if ((i = letter_index(k->trans, "NTCR")) >= 0) ADD(p->trans[i], calls);
+    if ((i = letter_index(k->uplo, "UL")) >= 0) ADD(p->uplo[i], calls);
+    if ((i = letter_index(k->diag, "NU")) >= 0) ADD(p->diag[i], calls);
+    ADD(p->incx[inc_class(k->incx)], calls);
+    if (flags & PF_INCY) ADD(p->incy[inc_class(k->incy)], calls);
+    if (flags & PF_LDA) ADD(p->lda[k->lda > ld_min(flags, k)], calls);
+    ADD(p->size[size_bucket((flags & PF_MN) ? k->m : k->n)]
+               [size_bucket(k->n)], calls);
+}
+
+/*
+ * Record one call that started at t0.  Enum arguments a routine does not
+ * take are passed as -1, absent sizes as 0.  The histograms are rebuilt
+ * from the shape table when the report is written, so the common case
+ * touches only the shape slot and the latency bucket.
+ */
+static void prof_record(int r, unsigned long long t0, int order, int trans,
+                        int uplo, int diag, blasint m, blasint n, blasint kl,
+                        blasint ku, blasint lda, blasint incx, blasint incy) {
+    unsigned long long dt = prof_now() - t0, cur;
+    prof_routine *p = &routines[r];
+    prof_slot *slot;
+    prof_key key;
+
+    if (dt == 0) dt = 1;          /* min_ns == 0 means "no call yet" */
+    ADD(p->lat[lat_bucket(dt)], 1);
+    cur = LOAD(p->min_ns);
+    while ((cur == 0 || dt < cur) &&
+           !__atomic_compare_exchange_n(&p->min_ns, &cur, dt, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+    cur = LOAD(p->max_ns);
+    while (dt > cur &&
+           !__atomic_compare_exchange_n(&p->max_ns, &cur, dt, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+
+    key.routine = r;
+    key.layout = order == CblasRowMajor ? 'R' : order == CblasColMajor ? 'C' : '?';
+    key.trans = enum_letter(trans, CblasNoTrans, 4, "NTCR");
+    key.uplo = enum_letter(uplo, CblasUpper, 2, "UL");
+    key.diag = enum_letter(diag, CblasNonUnit, 2, "NU");
+    key.m = m;
+    key.n = n;
+    key.kl = kl;
+    key.ku = ku;
+    key.lda = lda;
+    key.incx = incx;
+    key.incy = incy;
+    slot = shape_slot(&key);
+    if (slot) {
+        ADD(slot->calls, 1);
+        ADD(slot->ns, dt);
+    } else {
+        tally(p, routine_flags[r], &key, 1, dt);
+        ADD(p->shapes_dropped, 1);
+    }
+}
+
+#define WRAP_GEMV(name, ST, AT, YT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_TRANSPOSE trans, \
+                  OPENBLAS_CONST blasint m, OPENBLAS_CONST blasint n, \
+                  OPENBLAS_CONST ST alpha, OPENBLAS_CONST AT *a, \
+                  OPENBLAS_CONST blasint lda, OPENBLAS_CONST AT *x, \
+                  OPENBLAS_CONST blasint incx, OPENBLAS_CONST ST beta, \
+                  YT *y, OPENBLAS_CONST blasint incy) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, trans, m, n, alpha, a, lda, x, incx, beta, y, incy); \
+    prof_record(R_##name, t0, order, trans, -1, -1, m, n, 0, 0, lda, incx, \
+                incy); \
+}
+
+#define WRAP_GBMV(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_TRANSPOSE trans, \
+                  OPENBLAS_CONST blasint m, OPENBLAS_CONST blasint n, \
+                  OPENBLAS_CONST blasint kl, OPENBLAS_CONST blasint ku, \
+                  OPENBLAS_CONST ST alpha, OPENBLAS_CONST AT *a, \
+                  OPENBLAS_CONST blasint lda, OPENBLAS_CONST AT *x, \
+                  OPENBLAS_CONST blasint incx, OPENBLAS_CONST ST beta, \
+                  AT *y, OPENBLAS_CONST blasint incy) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, trans, m, n, kl, ku, alpha, a, lda, x, incx, beta, y, \
+               incy); \
+    prof_record(R_##name, t0, order, trans, -1, -1, m, n, kl, ku, lda, incx, \
+                incy); \
+}
+
+#define WRAP_TRXV(name, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST enum CBLAS_TRANSPOSE trans, \
+                  OPENBLAS_CONST enum CBLAS_DIAG diag, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST AT *a, \
+                  OPENBLAS_CONST blasint lda, AT *x, \
+                  OPENBLAS_CONST blasint incx) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, trans, diag, n, a, lda, x, incx); \
+    prof_record(R_##name, t0, order, trans, uplo, diag, n, n, 0, 0, lda, incx, \
+                0); \
+}
+
+#define WRAP_TBXV(name, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST enum CBLAS_TRANSPOSE trans, \
+                  OPENBLAS_CONST enum CBLAS_DIAG diag, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST blasint k, \
+                  OPENBLAS_CONST AT *a, OPENBLAS_CONST blasint lda, AT *x, \
+                  OPENBLAS_CONST blasint incx) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, trans, diag, n, k, a, lda, x, incx); \
+    prof_record(R_##name, t0, order, trans, uplo, diag, n, n, k, 0, lda, incx, \
+                0); \
+}
+
+#define WRAP_TPXV(name, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST enum CBLAS_TRANSPOSE trans, \
+                  OPENBLAS_CONST enum CBLAS_DIAG diag, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST AT *ap, AT *x, \
+                  OPENBLAS_CONST blasint incx) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, trans, diag, n, ap, x, incx); \
+    prof_record(R_##name, t0, order, trans, uplo, diag, n, n, 0, 0, 0, incx, \
+                0); \
+}
+
+#define WRAP_SYMV(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST ST alpha, \
+                  OPENBLAS_CONST AT *a, OPENBLAS_CONST blasint lda, \
+                  OPENBLAS_CONST AT *x, OPENBLAS_CONST blasint incx, \
+                  OPENBLAS_CONST ST beta, AT *y, \
+                  OPENBLAS_CONST blasint incy) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, n, alpha, a, lda, x, incx, beta, y, incy); \
+    prof_record(R_##name, t0, order, -1, uplo, -1, n, n, 0, 0, lda, incx, \
+                incy); \
+}
+
+#define WRAP_SBMV(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST blasint k, \
+                  OPENBLAS_CONST ST alpha, OPENBLAS_CONST AT *a, \
+                  OPENBLAS_CONST blasint lda, OPENBLAS_CONST AT *x, \
+                  OPENBLAS_CONST blasint incx, OPENBLAS_CONST ST beta, \
+                  AT *y, OPENBLAS_CONST blasint incy) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, n, k, alpha, a, lda, x, incx, beta, y, incy); \
+    prof_record(R_##name, t0, order, -1, uplo, -1, n, n, k, 0, lda, incx, \
+                incy); \
+}
+
+#define WRAP_SPMV(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST ST alpha, \
+                  OPENBLAS_CONST AT *ap, OPENBLAS_CONST AT *x, \
+                  OPENBLAS_CONST blasint incx, OPENBLAS_CONST ST beta, \
+                  AT *y, OPENBLAS_CONST blasint incy) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, n, alpha, ap, x, incx, beta, y, incy); \
+    prof_record(R_##name, t0, order, -1, uplo, -1, n, n, 0, 0, 0, incx, \
+                incy); \
+}
+
+#define WRAP_GER(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST blasint m, OPENBLAS_CONST blasint n, \
+                  OPENBLAS_CONST ST alpha, OPENBLAS_CONST AT *x, \
+                  OPENBLAS_CONST blasint incx, OPENBLAS_CONST AT *y, \
+                  OPENBLAS_CONST blasint incy, AT *a, \
+                  OPENBLAS_CONST blasint lda) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, m, n, alpha, x, incx, y, incy, a, lda); \
+    prof_record(R_##name, t0, order, -1, -1, -1, m, n, 0, 0, lda, incx, \
+                incy); \
+}
+
+#define WRAP_SYR(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST ST alpha, \
+                  OPENBLAS_CONST AT *x, OPENBLAS_CONST blasint incx, AT *a, \
+                  OPENBLAS_CONST blasint lda) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, n, alpha, x, incx, a, lda); \
+    prof_record(R_##name, t0, order, -1, uplo, -1, n, n, 0, 0, lda, incx, \
+                0); \
+}
+
+#define WRAP_SPR(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST ST alpha, \
+                  OPENBLAS_CONST AT *x, OPENBLAS_CONST blasint incx, \
+                  AT *ap) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, n, alpha, x, incx, ap); \
+    prof_record(R_##name, t0, order, -1, uplo, -1, n, n, 0, 0, 0, incx, \
+                0); \
+}
+
+#define WRAP_SYR2(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST ST alpha, \
+                  OPENBLAS_CONST AT *x, OPENBLAS_CONST blasint incx, \
+                  OPENBLAS_CONST AT *y, OPENBLAS_CONST blasint incy, AT *a, \
+                  OPENBLAS_CONST blasint lda) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, n, alpha, x, incx, y, incy, a, lda); \
+    prof_record(R_##name, t0, order, -1, uplo, -1, n, n, 0, 0, lda, incx, \
+                incy); \
+}
+
+#define WRAP_SPR2(name, ST, AT) \
+void cblas_##name(OPENBLAS_CONST enum CBLAS_ORDER order, \
+                  OPENBLAS_CONST enum CBLAS_UPLO uplo, \
+                  OPENBLAS_CONST blasint n, OPENBLAS_CONST ST alpha, \
+                  OPENBLAS_CONST AT *x, OPENBLAS_CONST blasint incx, \
+                  OPENBLAS_CONST AT *y, OPENBLAS_CONST blasint incy, \
+                  AT *ap) { \
+    unsigned long long t0 = prof_now(); \
+    REAL(name)(order, uplo, n, alpha, x, incx, y, incy, ap); \
+    prof_record(R_##name, t0, order, -1, uplo, -1, n, n, 0, 0, 0, incx, \
+                incy); \
+}
+
+WRAP_GEMV(sgemv, float, float, float)
+WRAP_GEMV(dgemv, double, double, double)
+WRAP_GEMV(cgemv, void *, void, void)
+WRAP_GEMV(zgemv, void *, void, void)
+WRAP_GEMV(sbgemv, float, bfloat16, float)
+
+WRAP_GBMV(sgbmv, float, float)
+WRAP_GBMV(dgbmv, double, double)
+WRAP_GBMV(cgbmv, void *, void)
+WRAP_GBMV(zgbmv, void *, void)
+
+WRAP_TRXV(strmv, float)
+WRAP_TRXV(dtrmv, double)
+WRAP_TRXV(ctrmv, void)
+WRAP_TRXV(ztrmv, void)
+WRAP_TRXV(strsv, float)
+WRAP_TRXV(dtrsv, double)
+WRAP_TRXV(ctrsv, void)
+WRAP_TRXV(ztrsv, void)
+
+WRAP_TBXV(stbmv, float)
+WRAP_TBXV(dtbmv, double)
+WRAP_TBXV(ctbmv, void)
+WRAP_TBXV(ztbmv, void)
+WRAP_TBXV(stbsv, float)
+WRAP_TBXV(dtbsv, double)
+WRAP_TBXV(ctbsv, void)
+WRAP_TBXV(ztbsv, void)
+
+WRAP_TPXV(stpmv, float)
+WRAP_TPXV(dtpmv, double)
+WRAP_TPXV(ctpmv, void)
+WRAP_TPXV(ztpmv, void)
+WRAP_TPXV(stpsv, float)
+WRAP_TPXV(dtpsv, double)
+WRAP_TPXV(ctpsv, void)
+WRAP_TPXV(ztpsv, void)
+
+WRAP_SYMV(ssymv, float, float)
+WRAP_SYMV(dsymv, double, double)
+WRAP_SYMV(chemv, void *, void)
+WRAP_SYMV(zhemv, void *, void)
+
+WRAP_SBMV(ssbmv, float, float)
+WRAP_SBMV(dsbmv, double, double)
+WRAP_SBMV(chbmv, void *, void)
+WRAP_SBMV(zhbmv, void *, void)
+
+WRAP_SPMV(sspmv, float, float)
+WRAP_SPMV(dspmv, double, double)
+WRAP_SPMV(chpmv, void *, void)
+WRAP_SPMV(zhpmv, void *, void)
+
+WRAP_GER(sger, float, float)
+WRAP_GER(dger, double, double)
+WRAP_GER(cgeru, void *, void)
+WRAP_GER(cgerc, void *, void)
+WRAP_GER(zgeru, void *, void)
+WRAP_GER(zgerc, void *, void)
+
+/* her/hpr take a real alpha with complex vectors. */
+WRAP_SYR(ssyr, float, float)
+WRAP_SYR(dsyr, double, double)
+WRAP_SYR(cher, float, void)
+WRAP_SYR(zher, double, void)
+
+WRAP_SPR(sspr, float, float)
+WRAP_SPR(dspr, double, double)
+WRAP_SPR(chpr, float, void)
+WRAP_SPR(zhpr, double, void)
+
+WRAP_SYR2(ssyr2, float, float)
+WRAP_SYR2(dsyr2, double, double)
+WRAP_SYR2(cher2, void *, void)
+WRAP_SYR2(zher2, void *, void)
+
+WRAP_SPR2(sspr2, float, float)
+WRAP_SPR2(dspr2, double, double)
+WRAP_SPR2(chpr2, void *, void)
+WRAP_SPR2(zhpr2, void *, void)
+
+/* ---- report ---- */
+
+static unsigned long long lat_percentile(const prof_routine *p,
+                                         unsigned long long calls,
+                                         unsigned per_mille) {
+    unsigned long long want = (calls * per_mille + 999) / 1000, seen = 0;
+    unsigned long long lo = LOAD(p->min_ns), hi = LOAD(p->max_ns), v;
+
+    for (int b = 0; b < PROF_LAT_BUCKETS; b++) {
+        seen += LOAD(p->lat[b]);
+        if (seen >= want) {
+            v = lat_value(b);
+            return v < lo ? lo : v > hi ? hi : v;
+        }
+    }
+    return hi;
+}
+
+/* ",\n      "name": {"a": 1, "b": 2}" over the nonzero counts. */
+static void put_hist(FILE *f, const char *name, const char *const *labels,
+                     const unsigned long long *counts, int n) {
+    int first = 1;
+
+    fprintf(f, ",\n      \"%s\": {", name);
+    for (int i = 0; i < n; i++) {
+        unsigned long long c = LOAD(counts[i]);
+        if (!c) continue;
+        fprintf(f, "%s\"%s\": %llu", first ? "" : ", ", labels[i], c);
+        first = 0;
+    }
+    fprintf(f, "}");
+}
+
+static int cmp_slot_calls(const void *pa, const void *pb) {
+    const prof_slot *a = *(const prof_slot *const *)pa;
+    const prof_slot *b = *(const prof_slot *const *)pb;
+    unsigned long long ca = LOAD(a->calls), cb = LOAD(b->calls);
+
+    return ca < cb ? 1 : ca > cb ? -1 : 0;
+}
+
+static void put_letter(FILE *f, const char *name, char c) {
+    if (c) fprintf(f, "\"%s\": \"%c\", ", name, c);
+}
+
+static void put_shape(FILE *f, const prof_slot *s, unsigned flags) {
+    const prof_key *k = &s->key;
+
+    fprintf(f, "{\"layout\": \"%c\", ", k->layout);
+    put_letter(f, "trans", k->trans);
+    put_letter(f, "uplo", k->uplo);
+    put_letter(f, "diag", k->diag);
+    if (flags & PF_MN) fprintf(f, "\"m\": %d, ", (int)k->m);
+    fprintf(f, "\"n\": %d, ", (int)k->n);
+    if (flags & PF_KLKU)
+        fprintf(f, "\"kl\": %d, \"ku\": %d, ", (int)k->kl, (int)k->ku);
+    if (flags & PF_K) fprintf(f, "\"k\": %d, ", (int)k->kl);
+    if (flags & PF_LDA) fprintf(f, "\"lda\": %d, ", (int)k->lda);
+    fprintf(f, "\"incx\": %d, ", (int)k->incx);
+    if (flags & PF_INCY) fprintf(f, "\"incy\": %d, ", (int)k->incy);
+    fprintf(f, "\"calls\": %llu, \"ns\": %llu}", LOAD(s->calls), LOAD(s->ns));
+}
+
+static void put_routine(FILE *f, int r, const prof_routine *p,
+                        prof_slot *const *sorted, size_t nsorted, int top) {
+    static const char *const layout_names[2] = {"ColMajor", "RowMajor"};
+    static const char *const trans_names[4] = {"N", "T", "C", "R"};
+    static const char *const uplo_names[2] = {"U", "L"};
+    static const char *const diag_names[2] = {"N", "U"};
+    static const char *const lda_names[2] = {"tight", "padded"};
+    unsigned flags = routine_flags[r];
+    unsigned long long calls = LOAD(p->calls), ns = LOAD(p->ns);
+    int first, listed;
+
+    fprintf(f, "    \"%s\": {\n      \"calls\": %llu,\n      \"ns\": %llu",
+            routine_names[r], calls, ns);
+    fprintf(f, ",\n      \"latency_ns\": {\"min\": %llu, \"mean\": %llu, "
+            "\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p99.9\": %llu, "
+            "\"max\": %llu}",
+            LOAD(p->min_ns), ns / calls, lat_percentile(p, calls, 500),
+            lat_percentile(p, calls, 900), lat_percentile(p, calls, 990),
+            lat_percentile(p, calls, 999), LOAD(p->max_ns));
+    put_hist(f, "layout", layout_names, p->layout, 2);
+    if (flags & PF_TRANS) put_hist(f, "trans", trans_names, p->trans, 4);
+    if (flags & PF_UPLO) put_hist(f, "uplo", uplo_names, p->uplo, 2);
+    if (flags & PF_DIAG) put_hist(f, "diag", diag_names, p->diag, 2);
+    put_hist(f, "incx", inc_names, p->incx, 4);
+    if (flags & PF_INCY) put_hist(f, "incy", inc_names, p->incy, 4);
+    if (flags & PF_LDA) put_hist(f, "lda", lda_names, p->lda, 2);
+
+    /* Square routines keep m == n, so only the n axis is reported. */
+    fprintf(f, ",\n      \"sizes\": [");
+    first = 1;
+    for (int bm = 0; bm < PROF_SIZE_BUCKETS; bm++) {
+        for (int bn = 0; bn < PROF_SIZE_BUCKETS; bn++) {
+            unsigned long long c = LOAD(p->size[bm][bn]);
+            if (!c) continue;
+            fprintf(f, "%s\n        {", first ? "" : ",");
+            if (flags & PF_MN) fprintf(f, "\"m_le\": %llu, ", 1ULL << bm);
+            fprintf(f, "\"n_le\": %llu, \"calls\": %llu}", 1ULL << bn, c);
+            first = 0;
+        }
+    }
+    fprintf(f, "%s]", first ? "" : "\n      ");
+
+    fprintf(f, ",\n      \"shapes\": [");
+    listed = 0;
+    for (size_t i = 0; i < nsorted && listed < top; i++) {
+        if (sorted[i]->key.routine != r) continue;
+        fprintf(f, "%s\n        ", listed ? "," : "");
+        put_shape(f, sorted[i], flags);
+        listed++;
+    }
+    fprintf(f, "%s]", listed ? "\n      " : "");
+    fprintf(f, ",\n      \"shapes_dropped\": %llu\n    }",
+            LOAD(p->shapes_dropped));
+}
+
+static void put_report(FILE *f) {
+    int order[PROF_NROUTINES], nused = 0, top = PROF_TOP_DEFAULT;
+    unsigned long long total_calls = 0, total_ns = 0;
+    prof_routine *agg = malloc(sizeof routines);
+    prof_slot **sorted = malloc(PROF_SHAPE_SLOTS * sizeof *sorted);
+    size_t nsorted = 0;
+    const char *env = getenv("L2PROF_TOP");
+
+    if (env && *env) top = atoi(env);
+    if (top < 0) top = 0;
+    if (!agg || !sorted) {
+        fprintf(f, "{\"tool\": \"l2prof\", \"error\": \"out of memory\"}\n");
+        free(agg);
+        free(sorted);
+        return;
+    }
+
+    /* Calls that missed the shape table are already in the routine
+     * counters; add every table entry on top. */
+    memcpy(agg, routines, sizeof routines);
+    for (int i = 0; i < PROF_SHAPE_SLOTS; i++) {
+        prof_slot *s = &shapes[i];
+        int r;
+        if (__atomic_load_n(&s->state, __ATOMIC_ACQUIRE) != SLOT_READY)
+            continue;
+        r = s->key.routine;
+        tally(&agg[r], routine_flags[r], &s->key, LOAD(s->calls),
+              LOAD(s->ns));
+        sorted[nsorted++] = s;
+    }
+    qsort(sorted, nsorted, sizeof *sorted, cmp_slot_calls);
+
+    /* Routines that were called, most total time first. */
+    for (int r = 0; r < PROF_NROUTINES; r++) {
+        int j;
+        if (!agg[r].calls) continue;
+        total_calls += agg[r].calls;
+        total_ns += agg[r].ns;
+        for (j = nused; j > 0 && agg[order[j - 1]].ns < agg[r].ns; j--)
+            order[j] = order[j - 1];
+        order[j] = r;
+        nused++;
+    }
+
+    fprintf(f, "{\n  \"tool\": \"l2prof\",\n  \"pid\": %ld,\n"
+            "  \"elapsed_s\": %.6f,\n  \"calls\": %llu,\n  \"ns\": %llu,\n"
+            "  \"routines\": {",
+            (long)getpid(), (double)(prof_now() - start_ns) * 1e-9,
+            total_calls, total_ns);
+    for (int i = 0; i < nused; i++) {
+        fprintf(f, "%s\n", i ? "," : "");
+        put_routine(f, order[i], &agg[order[i]], sorted, nsorted, top);
+    }
+    fprintf(f, "%s}\n}\n", nused ? "\n  " : "");
+    free(agg);
+    free(sorted);
+}
+
+int l2prof_dump(const char *path) {
+    FILE *f = (!path || strcmp(path, "-") == 0) ? stderr : fopen(path, "w");
+    int ok;
+
+    if (!f) return -1;
+    put_report(f);
+    ok = !ferror(f);
+    if (f == stderr) fflush(f);
+    else if (fclose(f) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+void l2prof_reset(void) {
+    memset(routines, 0, sizeof routines);
+    memset(shapes, 0, sizeof shapes);
+    shape_count = 0;
+}
+
+__attribute__((constructor))
+static void prof_init(void) {
+    start_ns = prof_now();
+}
+
+/* Processes that made no Level 2 call (shells, compilers, ... under an
+ * exported LD_PRELOAD) write nothing. */
+__attribute__((destructor))
+static void prof_exit(void) {
+    const char *out = getenv("L2PROF_OUTPUT");
+    char path[4096];
+    size_t len = 0;
+    int any = LOAD(shape_count) != 0;
+
+    for (int r = 0; r < PROF_NROUTINES; r++)
+        if (LOAD(routines[r].calls)) any = 1;
+    if (!any || (out && strcmp(out, "none") == 0)) return;
+    if (!out || !*out) out = "l2prof.%p.json";
+
+    for (const char *s = out; *s && len < sizeof path - 24; s++) {
+        if (s[0] == '%' && s[1] == 'p') {
+            len += (size_t)snprintf(path + len, sizeof path - len, "%ld",
+                                    (long)getpid());
+            s++;
+        } else {
+            path[len++] = *s;
+        }
+    }
+    path[len] = '\0';
+    if (l2prof_dump(path) != 0)
+        fprintf(stderr, "l2prof: cannot write %s\n", path);
+}
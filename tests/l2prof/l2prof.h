@@ -0,0 +1,38 @@
+/*
+ * l2prof - call profiler for the CBLAS Level 2 routines.
+ *
+ * libl2prof.so defines every Level 2 cblas_* entry point and forwards each
+ * call to the next library in the lookup order, so preloading it in front of
+ * OpenBLAS profiles an unmodified program:
+ *
+ *     LD_PRELOAD=./l2prof/libl2prof.so L2PROF_OUTPUT=prof.json ./app
+ *
+ * The report is written as JSON when the process exits.  Environment:
+ *
+ *   L2PROF_OUTPUT  report path; "%p" is replaced by the pid, "-" writes to
+ *                  stderr and "none" turns the exit report off
+ *                  (default: l2prof.%p.json in the working directory)
+ *   L2PROF_TOP     exact argument shapes listed per routine (default: 20)
+ *
+ * A program that links l2prof.c directly can also take snapshots itself.
+ */
+#ifndef L2PROF_H
+#define L2PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Write the report for the calls so far to path ("-" for stderr).
+ * Returns 0 on success, -1 if the file cannot be written. */
+int l2prof_dump(const char *path);
+
+/* Forget every call recorded so far.  Not safe while other threads are
+ * inside a profiled routine. */
+void l2prof_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,407 @@
+/*
+ * l2ref - reference Level 2 results for the randomized tests; see l2ref.h.
+ */
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "l2ref.h"
+
+/* Rows per work unit of l2r_mv, and columns swept per pass over a unit:
+ * a tile's slice of x and its accumulators stay in L1. */
+#define L2R_TILE_R 128
+#define L2R_TILE_C 256
+
+/* Columns per work unit of l2r_check_update. */
+#define L2R_TILE_J 64
+
+#define L2R_MAX_THREADS 256
+
+#define L2R_MIN(a, b) ((a) < (b) ? (a) : (b))
+#define L2R_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+static int is_complex(char prec) { return prec == 'c' || prec == 'z'; }
+
+static int is_sym(enum l2r_kind k) {
+    return k == L2R_SY || k == L2R_SB || k == L2R_SP;
+}
+
+static int is_herm(enum l2r_kind k) {
+    return k == L2R_HE || k == L2R_HB || k == L2R_HP;
+}
+
+static int is_tri(enum l2r_kind k) {
+    return k == L2R_TR || k == L2R_TB || k == L2R_TP;
+}
+
+static int is_band(enum l2r_kind k) {
+    return k == L2R_GB || k == L2R_SB || k == L2R_HB || k == L2R_TB;
+}
+
+static int is_packed(enum l2r_kind k) {
+    return k == L2R_SP || k == L2R_HP || k == L2R_TP;
+}
+
+/* Element off of storage of precision prec, as complex double. */
+static inline void load(char prec, const void *a, long off, double v[2]) {
+    switch (prec) {
+    case 's': v[0] = ((const float *)a)[off];  v[1] = 0.0; break;
+    case 'd': v[0] = ((const double *)a)[off]; v[1] = 0.0; break;
+    case 'c':
+        v[0] = ((const float *)a)[2 * off];
+        v[1] = ((const float *)a)[2 * off + 1];
+        break;
+    default:
+        v[0] = ((const double *)a)[2 * off];
+        v[1] = ((const double *)a)[2 * off + 1];
+        break;
+    }
+}
+
+static double abs1(const double v[2]) { return fabs(v[0]) + fabs(v[1]); }
+
+size_t l2r_elems(const l2r_matrix *A) {
+    int cols;
+
+    if (is_packed(A->kind)) return (size_t)A->n * (size_t)(A->n + 1) / 2;
+    cols = A->n;
+    if ((A->kind == L2R_GE || A->kind == L2R_GB) && A->order == CblasRowMajor)
+        cols = A->m;
+    return (size_t)A->lda * (size_t)cols;
+}
+
+/* l2r_offset() and l2r_get(), inlined into the loops below. */
+static inline long offset(const l2r_matrix *A, int i, int j) {
+    int m = A->m, n = A->n, kl = A->kl, ku = A->ku, t;
+    int upper = A->uplo == CblasUpper;
+
+    if (i < 0 || j < 0 || i >= m || j >= n) return -1;
+    if (is_tri(A->kind) && A->diag == CblasUnit && i == j) return -1;
+    if (A->order == CblasRowMajor) {
+        /* Row-major storage of A is the column-major storage of A^T. */
+        t = i; i = j; j = t;
+        t = m; m = n; n = t;
+        t = kl; kl = ku; ku = t;
+        upper = !upper;
+    }
+
+    switch (A->kind) {
+    case L2R_GE:
+        return i + (long)j * A->lda;
+    case L2R_GB:
+        if (i < j - ku || i > j + kl) return -1;
+        return (ku + i - j) + (long)j * A->lda;
+    default:
+        break;
+    }
+
+    if (upper ? i > j : i < j) return -1;
+    switch (A->kind) {
+    case L2R_SB: case L2R_HB: case L2R_TB:
+        if (upper) {
+            if (j - i > kl) return -1;
+            return (kl + i - j) + (long)j * A->lda;
+        }
+        if (i - j > kl) return -1;
+        return (i - j) + (long)j * A->lda;
+    case L2R_SP: case L2R_HP: case L2R_TP:
+        if (upper) return i + (long)j * (j + 1) / 2;
+        return i + (long)j * (2L * n - j - 1) / 2;
+    default:
+        return i + (long)j * A->lda;
+    }
+}
+
+static inline void get(const l2r_matrix *A, int i, int j, double v[2]) {
+    long off;
+    int mirrored = 0;
+
+    v[0] = v[1] = 0.0;
+    if (is_tri(A->kind) && A->diag == CblasUnit && i == j) {
+        v[0] = 1.0;
+        return;
+    }
+    off = offset(A, i, j);
+    if (off < 0 && (is_sym(A->kind) || is_herm(A->kind))) {
+        off = offset(A, j, i);
+        mirrored = 1;
+    }
+    if (off < 0) return;
+    load(A->prec, A->a, off, v);
+    if (is_herm(A->kind)) {
+        if (i == j) v[1] = 0.0;             /* imaginary part not referenced */
+        else if (mirrored) v[1] = -v[1];
+    }
+}
+
+long l2r_offset(const l2r_matrix *A, int i, int j) {
+    return offset(A, i, j);
+}
+
+void l2r_get(const l2r_matrix *A, int i, int j, double v[2]) {
+    get(A, i, j, v);
+}
+
+void l2r_rows(const l2r_matrix *A, int j, int *lo, int *hi) {
+    int below = A->m, above = A->n;
+
+    if (A->kind == L2R_GB) {
+        below = A->kl;
+        above = A->ku;
+    } else if (is_band(A->kind)) {
+        below = above = A->kl;
+    }
+    *lo = L2R_MAX(0, j - above);
+    *hi = L2R_MIN(A->m, j + below + 1);
+}
+
+/* ---- threads ------------------------------------------------------------ */
+
+static int ref_threads;
+
+void l2r_set_num_threads(int n) {
+    ref_threads = n < 1 ? 1 : L2R_MIN(n, L2R_MAX_THREADS);
+}
+
+static int num_threads(void) {
+    if (ref_threads == 0) {
+        const char *env = getenv("L2REF_NUM_THREADS");
+        long n = env ? atol(env) : sysconf(_SC_NPROCESSORS_ONLN);
+        l2r_set_num_threads(n < 1 ? 1 : (int)L2R_MIN(n, L2R_MAX_THREADS));
+    }
+    return ref_threads;
+}
+
+typedef void (*job_fn)(void *arg, int t, int nt);
+
+typedef struct {
+    job_fn fn;
+    void *arg;
+    int t, nt;
+} job;
+
+static void *job_main(void *p) {
+    job *j = p;
+    j->fn(j->arg, j->t, j->nt);
+    return NULL;
+}
+
+/*
+ * Runs fn(arg, t, nt) on nt threads, nt at most units; thread t takes work
+ * units t, t + nt, ...  Falls back to fewer threads if one cannot start.
+ */
+static void run_threads(job_fn fn, void *arg, int units) {
+    pthread_t tid[L2R_MAX_THREADS];
+    job jobs[L2R_MAX_THREADS];
+    int nt = L2R_MAX(1, L2R_MIN(num_threads(), units)), started = 1;
+
+    for (int t = 0; t < nt; t++) {
+        jobs[t].fn = fn;
+        jobs[t].arg = arg;
+        jobs[t].t = t;
+        jobs[t].nt = nt;
+    }
+    for (int t = 1; t < nt; t++) {
+        if (pthread_create(&tid[t], NULL, job_main, &jobs[t]) != 0) break;
+        started++;
+    }
+    /* Units of threads that did not start run here. */
+    for (int t = 0; t < nt; t++)
+        if (t == 0 || t >= started) fn(arg, t, nt);
+    for (int t = 1; t < started; t++)
+        pthread_join(tid[t], NULL);
+}
+
+/* ---- y = op(A) * x ------------------------------------------------------- */
+
+typedef struct {
+    const l2r_matrix *A;
+    enum CBLAS_TRANSPOSE trans;
+    const double *x;
+    double *y, *yabs;
+    int rows, cols;
+    int below, above;               /* bandwidths of op(A) */
+} mv_args;
+
+static void mv_job(void *p, int t, int nt) {
+    const mv_args *a = p;
+    int tiles = (a->rows + L2R_TILE_R - 1) / L2R_TILE_R;
+    double acc[2 * L2R_TILE_R], accabs[L2R_TILE_R], v[2];
+
+    for (int tile = t; tile < tiles; tile += nt) {
+        int r0 = tile * L2R_TILE_R;
+        int r1 = L2R_MIN(a->rows, r0 + L2R_TILE_R);
+        int c_lo = L2R_MAX(0, r0 - a->below);
+        int c_hi = L2R_MIN(a->cols, r1 + a->above);
+
+        memset(acc, 0, sizeof acc);
+        memset(accabs, 0, sizeof accabs);
+        for (int c0 = c_lo; c0 < c_hi; c0 += L2R_TILE_C) {
+            int c1 = L2R_MIN(c_hi, c0 + L2R_TILE_C);
+            for (int c = c0; c < c1; c++) {
+                const double *xc = a->x + 2 * (size_t)c;
+                double xabs = abs1(xc);
+                double xr = xc[0], xi = a->trans == CblasConjTrans ? -xc[1]
+                                                                   : xc[1];
+                /* conj(a) x = conj(a conj(x)): conjugate the sum instead */
+                for (int r = r0; r < r1; r++) {
+                    double *s = acc + 2 * (r - r0);
+                    if (a->trans == CblasNoTrans) get(a->A, r, c, v);
+                    else get(a->A, c, r, v);
+                    s[0] += v[0] * xr - v[1] * xi;
+                    s[1] += v[0] * xi + v[1] * xr;
+                    accabs[r - r0] += abs1(v) * xabs;
+                }
+            }
+        }
+        if (a->trans == CblasConjTrans)
+            for (int r = 0; r < r1 - r0; r++) acc[2 * r + 1] = -acc[2 * r + 1];
+        memcpy(a->y + 2 * (size_t)r0, acc, 2 * (size_t)(r1 - r0) * sizeof *acc);
+        memcpy(a->yabs + r0, accabs, (size_t)(r1 - r0) * sizeof *accabs);
+    }
+}
+
+void l2r_mv(const l2r_matrix *A, enum CBLAS_TRANSPOSE trans,
+            const double *x, double *y, double *yabs) {
+    mv_args a;
+    int below = A->m, above = A->n;
+
+    if (A->kind == L2R_GB) {
+        below = A->kl;
+        above = A->ku;
+    } else if (is_band(A->kind)) {
+        below = above = A->kl;
+    }
+    a.A = A;
+    a.trans = trans;
+    a.x = x;
+    a.y = y;
+    a.yabs = yabs;
+    if (trans == CblasNoTrans) {
+        a.rows = A->m;
+        a.cols = A->n;
+        a.below = below;
+        a.above = above;
+    } else {
+        a.rows = A->n;
+        a.cols = A->m;
+        a.below = above;
+        a.above = below;
+    }
+    /* c_hi is exclusive: row r reaches column r + above. */
+    a.above += 1;
+    run_threads(mv_job, &a, (a.rows + L2R_TILE_R - 1) / L2R_TILE_R);
+}
+
+/* ---- rank updates -------------------------------------------------------- */
+
+typedef struct {
+    const l2r_matrix *A0, *A1;
+    const double *alpha, *x, *y;
+    int conj, two;
+    double tol;
+    double worst[L2R_MAX_THREADS];
+    int wi[L2R_MAX_THREADS], wj[L2R_MAX_THREADS];
+} upd_args;
+
+/* acc += alpha * u * (conj ? conj(w) : w); returns |alpha| |u| |w|. */
+static double add_term(double acc[2], const double alpha[2], const double u[2],
+                       const double w[2], int conj) {
+    double wr = w[0], wi = conj ? -w[1] : w[1];
+    double pr = u[0] * wr - u[1] * wi, pi = u[0] * wi + u[1] * wr;
+
+    acc[0] += alpha[0] * pr - alpha[1] * pi;
+    acc[1] += alpha[0] * pi + alpha[1] * pr;
+    return abs1(alpha) * abs1(u) * abs1(w);
+}
+
+static void upd_job(void *p, int t, int nt) {
+    upd_args *a = p;
+    const l2r_matrix *A0 = a->A0;
+    int herm = is_herm(A0->kind);
+    int tiles = (A0->n + L2R_TILE_J - 1) / L2R_TILE_J;
+    double alpha2[2] = {a->alpha[0], a->conj ? -a->alpha[1] : a->alpha[1]};
+    double worst = 0.0;
+    int wi = -1, wj = -1;
+
+    for (int tile = t; tile < tiles; tile += nt) {
+        int j1 = L2R_MIN(A0->n, (tile + 1) * L2R_TILE_J);
+        for (int j = tile * L2R_TILE_J; j < j1; j++) {
+            int lo, hi;
+            l2r_rows(A0, j, &lo, &hi);
+            for (int i = lo; i < hi; i++) {
+                long off = offset(A0, i, j);
+                double e[2], got[2], bound, err, ratio;
+
+                if (off < 0) continue;
+                load(A0->prec, A0->a, off, e);
+                if (herm && i == j) e[1] = 0.0;
+                bound = abs1(e);
+                bound += add_term(e, a->alpha, a->x + 2 * (size_t)i,
+                                  a->y + 2 * (size_t)j, a->conj);
+                if (a->two)
+                    bound += add_term(e, alpha2, a->y + 2 * (size_t)i,
+                                      a->x + 2 * (size_t)j, a->conj);
+                if (herm && i == j) e[1] = 0.0;
+
+                load(A0->prec, a->A1->a, off, got);
+                got[0] -= e[0];
+                got[1] -= e[1];
+                err = abs1(got);
+                bound *= a->tol;
+                if (err <= bound) ratio = bound > 0.0 ? err / bound : 0.0;
+                else ratio = bound > 0.0 && err == err ? err / bound : INFINITY;
+                if (ratio > worst || wi < 0) {
+                    worst = ratio;
+                    wi = i;
+                    wj = j;
+                }
+            }
+        }
+    }
+    a->worst[t] = worst;
+    a->wi[t] = wi;
+    a->wj[t] = wj;
+}
+
+double l2r_check_update(const l2r_matrix *A0, const l2r_matrix *A1,
+                        const double alpha[2], const double *x,
+                        const double *y, int conj, int two, double tol,
+                        int *worst_i, int *worst_j) {
+    upd_args *a = calloc(1, sizeof *a);
+    int tiles = (A0->n + L2R_TILE_J - 1) / L2R_TILE_J;
+    double worst = 0.0;
+
+    *worst_i = *worst_j = -1;
+    if (!a) return INFINITY;
+    a->A0 = A0;
+    a->A1 = A1;
+    a->alpha = alpha;
+    a->x = x;
+    a->y = y;
+    a->conj = conj && is_complex(A0->prec);
+    a->two = two;
+    a->tol = tol;
+    for (int t = 0; t < L2R_MAX_THREADS; t++) a->wi[t] = -1;
+    run_threads(upd_job, a, tiles);
+    for (int t = 0; t < L2R_MAX_THREADS; t++) {
+        if (a->wi[t] >= 0 && (a->worst[t] > worst || *worst_i < 0)) {
+            worst = a->worst[t];
+            *worst_i = a->wi[t];
+            *worst_j = a->wj[t];
+        }
+    }
+    free(a);
+    return worst;
+}
+
+void l2r_load(char prec, int n, const void *x, int inc, double *out) {
+    long step = inc < 0 ? -(long)inc : inc;
+    long start = inc < 0 ? (long)(n - 1) * step : 0;
+
+    for (int i = 0; i < n; i++) {
+        long off = inc < 0 ? start - i * step : i * step;
+        load(prec, x, off, out + 2 * (size_t)i);
+    }
+}
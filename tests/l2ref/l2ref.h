@@ -0,0 +1,88 @@
+/*
+ * l2ref - reference Level 2 results for the randomized tests.
+ *
+ * Matrices are read in place, in whatever storage the routine under test
+ * uses (full, band or packed, either layout), through the offsets of
+ * l2r_offset(); nothing is expanded to a dense copy, so an 8192 x 8192
+ * problem costs no more memory than the routine itself needs.  All
+ * arithmetic is complex double whatever the tested precision, and every
+ * result comes with the matching sum of absolute values, from which the
+ * caller forms a componentwise error bound.
+ *
+ * Products are tiled for cache and split over L2REF_NUM_THREADS threads
+ * (default: all CPUs).  Independent of l2blas, so it can check it too.
+ */
+#ifndef L2REF_H
+#define L2REF_H
+
+#include <stddef.h>
+#include <cblas.h>
+
+/* Storage kinds, after the BLAS two-letter matrix types. */
+enum l2r_kind {
+    L2R_GE, L2R_GB,                 /* general, general band */
+    L2R_SY, L2R_SB, L2R_SP,         /* symmetric: full, band, packed */
+    L2R_HE, L2R_HB, L2R_HP,         /* Hermitian */
+    L2R_TR, L2R_TB, L2R_TP          /* triangular */
+};
+
+typedef struct {
+    char prec;                      /* 's', 'd', 'c' or 'z' */
+    enum l2r_kind kind;
+    enum CBLAS_ORDER order;
+    enum CBLAS_UPLO uplo;           /* all but GE/GB */
+    enum CBLAS_DIAG diag;           /* TR/TB/TP */
+    int m, n;                       /* m == n except for GE/GB */
+    int kl, ku;                     /* GB; SB/HB/TB keep k in both */
+    int lda;                        /* all but the packed kinds */
+    const void *a;
+} l2r_matrix;
+
+/* Elements of storage the matrix spans, padding included. */
+size_t l2r_elems(const l2r_matrix *A);
+
+/*
+ * Storage offset, in elements, of the A(i,j) the routine references, or -1
+ * for elements it does not read: outside the band or stored triangle, and
+ * the diagonal of a unit triangular matrix.
+ */
+long l2r_offset(const l2r_matrix *A, int i, int j);
+
+/* Rows [*lo, *hi) of column j that can hold referenced elements; a
+ * superset, l2r_offset() decides. */
+void l2r_rows(const l2r_matrix *A, int j, int *lo, int *hi);
+
+/* Logical A(i,j) as the routine sees it (mirrored, unit diagonal, ...). */
+void l2r_get(const l2r_matrix *A, int i, int j, double v[2]);
+
+/*
+ * y = op(A) * x and yabs = |op(A)| * |x|.  x and y are contiguous complex
+ * double (re, im pairs), of length cols and rows of op(A).
+ */
+void l2r_mv(const l2r_matrix *A, enum CBLAS_TRANSPOSE trans,
+            const double *x, double *y, double *yabs);
+
+/*
+ * Checks a rank update of A0 into A1 (the same storage before and after):
+ *
+ *     A1 = A0 + alpha * x * y'  [+ alpha' * y * x']
+ *
+ * where ' is the transpose, or the conjugate transpose with conj set, and the
+ * second term (two set) has alpha' = alpha, or conj(alpha) with conj.  For the
+ * Hermitian kinds the result diagonal must also be real.  Every referenced
+ * element is compared against a bound of tol times the sum of the absolute
+ * values of its terms.  Returns the largest error-to-bound ratio (above 1
+ * fails) and where it was seen.
+ */
+double l2r_check_update(const l2r_matrix *A0, const l2r_matrix *A1,
+                        const double alpha[2], const double *x,
+                        const double *y, int conj, int two, double tol,
+                        int *worst_i, int *worst_j);
+
+/* Reads n elements of x with increment inc (cblas semantics) as complex
+ * double. */
+void l2r_load(char prec, int n, const void *x, int inc, double *out);
+
+void l2r_set_num_threads(int n);
+
+#endif
@@ -0,0 +1,632 @@
+/*
+ * l2test - runner for the cases and benchmarks registered through l2test.h.
+ *
+ * Usage: l2test [options] [pattern ...]
+ *
+ *   pattern        run only cases whose "suite/case" name contains one of
+ *                  the patterns, e.g. gemv, test_trsv_l2/, sweep[avx2]
+ *   -p PRECS       only cases for these precisions (-p sd); cases covering
+ *                  every precision always match
+ *   -j N           cases run at once (default: L2TEST_JOBS, else all CPUs)
+ *   -v             show the output of passing cases too
+ *   -l             list the selected cases and exit
+ *   --json FILE    also write the results as JSON ("-" for stdout)
+ *   --timeout S    a case still running after S seconds fails (default 600,
+ *                  0 for none)
+ *   --no-fork      run the cases one by one inside this process (debugging)
+ *   --list-bench   list the benchmarks
+ *   --bench NAME [args ...]
+ *                  run benchmark NAME with the given arguments
+ *
+ * Each case runs in a forked child whose output goes to a temporary file and
+ * whose check counts go to shared memory, so a crash or a hang costs only that
+ * case and -j children keep all cores busy.  A suite's setup runs once, in
+ * this process before its first case is forked, and its children share the
+ * data copy-on-write instead of each building its own.  Benchmarks run in
+ * this process, one at a time, with output straight to the terminal.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <stdatomic.h>
+#ifndef _WIN32
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+#include "l2test.h"
+
+#define L2T_DEFAULT_TIMEOUT 600
+
+enum { ST_PASS, ST_FAIL, ST_SKIP, ST_CRASH, ST_TIMEOUT };
+
+static const char *const status_json[] = {
+    "pass", "fail", "skip", "crash", "timeout"
+};
+static const char *const status_line[] = {
+    "ok     ", "FAIL   ", "skip   ", "CRASH  ", "TIMEOUT"
+};
+
+typedef struct {
+    const char *suite, *name;
+    l2t_case_fn fn;
+    char prec;              /* 's', 'd', 'c', 'z', or 0 for all of them */
+} l2t_case;
+
+typedef struct {
+    const char *suite;
+    l2t_setup_fn fn;
+    int state;              /* 0 not run, 1 ready, -1 failed */
+} l2t_setup;
+
+typedef struct {
+    const char *name;
+    l2t_bench_fn fn;
+} l2t_bench;
+
+/* Check counts of one case; shared with the child that runs it. */
+typedef struct {
+    int passed, failed, skipped;
+} l2t_counts;
+
+typedef struct {
+    int status, signal;
+    double seconds;
+    char *output;
+} l2t_result;
+
+static l2t_case *cases;
+static int ncases, cases_cap;
+static l2t_setup *setups;
+static int nsetups, setups_cap;
+static l2t_bench *benches;
+static int nbenches, benches_cap;
+
+static l2t_counts *current;
+
+static void *grow(void *p, int *cap, int need, size_t elem) {
+    if (need <= *cap) return p;
+    *cap = *cap ? 2 * *cap : 64;
+    if (*cap < need) *cap = need;
+    p = realloc(p, (size_t)*cap * elem);
+    if (!p) {
+        fprintf(stderr, "l2test: out of memory while registering\n");
+        exit(2);
+    }
+    return p;
+}
+
+/* "dir/test_gemv.c" -> "test_gemv", likewise ".cpp"; the strings live for
+ * the whole run. */
+static const char *suite_name(const char *file) {
+    const char *base = strrchr(file, '/');
+    size_t len;
+    char *s;
+
+    base = base ? base + 1 : file;
+    len = strlen(base);
+    if (len > 2 && strcmp(base + len - 2, ".c") == 0) len -= 2;
+    else if (len > 4 && strcmp(base + len - 4, ".cpp") == 0) len -= 4;
+    s = malloc(len + 1);
+    if (!s) return base;
+    memcpy(s, base, len);
+    s[len] = '\0';
+    return s;
+}
+
+/*
+ * Precision of a case named test_<p><routine>..., e.g. test_zhemv_lower;
+ * sweeps and other cases without a routine prefix cover every precision.
+ */
+static char case_precision(const char *name) {
+    static const char *const routines[] = {
+        "gemv", "gbmv", "hemv", "hbmv", "hpmv", "symv", "sbmv", "spmv",
+        "trmv", "trsv", "tbmv", "tbsv", "tpmv", "tpsv", "ger", "syr", "spr",
+        "her", "hpr"
+    };
+
+    if (strncmp(name, "test_", 5) != 0 || !strchr("sdcz", name[5]) ||
+        !name[5])
+        return 0;
+    for (size_t i = 0; i < sizeof routines / sizeof routines[0]; i++)
+        if (strncmp(name + 6, routines[i], strlen(routines[i])) == 0)
+            return name[5];
+    return 0;
+}
+
+void l2t_register_test(const char *suite, const char *name, l2t_case_fn fn) {
+    cases = grow(cases, &cases_cap, ncases + 1, sizeof *cases);
+    cases[ncases].suite = suite_name(suite);
+    cases[ncases].name = name;
+    cases[ncases].fn = fn;
+    cases[ncases].prec = case_precision(name);
+    ncases++;
+}
+
+void l2t_register_setup(const char *suite, l2t_setup_fn fn) {
+    setups = grow(setups, &setups_cap, nsetups + 1, sizeof *setups);
+    setups[nsetups].suite = suite_name(suite);
+    setups[nsetups].fn = fn;
+    setups[nsetups].state = 0;
+    nsetups++;
+}
+
+void l2t_register_bench(const char *name, l2t_bench_fn fn) {
+    benches = grow(benches, &benches_cap, nbenches + 1, sizeof *benches);
+    benches[nbenches].name = name;
+    benches[nbenches].fn = fn;
+    nbenches++;
+}
+
+void l2t_check(int ok, const char *msg) {
+    static l2t_counts outside;
+    l2t_counts *c = current ? current : &outside;
+
+    if (ok) { printf("[PASS] %s\n", msg); c->passed++; }
+    else    { printf("[FAIL] %s\n", msg); c->failed++; }
+}
+
+void l2t_skip(const char *msg) {
+    static l2t_counts outside;
+    l2t_counts *c = current ? current : &outside;
+
+    printf("[SKIP] %s\n", msg);
+    c->skipped++;
+}
+
+/*
+ * Heap allocation counter.  With glibc the runner replaces the allocator's
+ * entry points for the whole process, OpenBLAS and every thread included,
+ * and forwards them to glibc's own; each allocation bumps one counter.
+ */
+#if defined(__GLIBC__) && !defined(_WIN32)
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *p, size_t size);
+extern void *__libc_memalign(size_t align, size_t size);
+extern void *__libc_valloc(size_t size);
+extern void *__libc_pvalloc(size_t size);
+
+static atomic_ulong alloc_count;
+
+long l2t_alloc_count(void) {
+    return (long)atomic_load_explicit(&alloc_count, memory_order_relaxed);
+}
+
+static void alloc_bump(void) {
+    atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+}
+
+void *malloc(size_t size) {
+    alloc_bump();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+    alloc_bump();
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *p, size_t size) {
+    alloc_bump();
+    return __libc_realloc(p, size);
+}
+
+void *memalign(size_t align, size_t size) {
+    alloc_bump();
+    return __libc_memalign(align, size);
+}
+
+void *aligned_alloc(size_t align, size_t size) {
+    alloc_bump();
+    return __libc_memalign(align, size);
+}
+
+int posix_memalign(void **p, size_t align, size_t size) {
+    void *q;
+
+    if (align < sizeof(void *) || (align & (align - 1)) != 0) return EINVAL;
+    alloc_bump();
+    q = __libc_memalign(align, size);
+    if (!q && size) return ENOMEM;
+    *p = q;
+    return 0;
+}
+
+void *valloc(size_t size) {
+    alloc_bump();
+    return __libc_valloc(size);
+}
+
+void *pvalloc(size_t size) {
+    alloc_bump();
+    return __libc_pvalloc(size);
+}
+#else
+long l2t_alloc_count(void) {
+    return -1;
+}
+#endif
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Run the setups of a suite not run yet in this process; 0 if one of them
+ * failed, now or before.
+ */
+static int suite_ready(const char *suite) {
+    for (int i = 0; i < nsetups; i++) {
+        if (strcmp(setups[i].suite, suite) != 0) continue;
+        if (setups[i].state == 0)
+            setups[i].state = setups[i].fn() ? 1 : -1;
+        if (setups[i].state < 0) return 0;
+    }
+    return 1;
+}
+
+/* Run the setups of the case's suite (once per process), then the case. */
+static void run_case(const l2t_case *c, l2t_counts *counts) {
+    current = counts;
+    if (!suite_ready(c->suite)) {
+        printf("[FAIL] %s: suite setup failed\n", c->suite);
+        counts->failed++;
+        current = NULL;
+        return;
+    }
+    c->fn();
+    fflush(stdout);
+    current = NULL;
+}
+
+static int counts_status(const l2t_counts *c) {
+    if (c->failed) return ST_FAIL;
+    if (!c->passed && c->skipped) return ST_SKIP;
+    return ST_PASS;
+}
+
+static void print_result(const l2t_case *c, const l2t_counts *k,
+                         const l2t_result *r, int verbose) {
+    printf("%s %s/%s  %d/%d checks  %.3f s", status_line[r->status],
+           c->suite, c->name, k->passed, k->passed + k->failed, r->seconds);
+    if (r->status == ST_CRASH) printf("  (signal %d)", r->signal);
+    printf("\n");
+    if (r->output && *r->output &&
+        (verbose || (r->status != ST_PASS && r->status != ST_SKIP))) {
+        const char *s = r->output;
+        while (*s) {
+            const char *e = strchr(s, '\n');
+            int len = e ? (int)(e - s) : (int)strlen(s);
+            printf("        %.*s\n", len, s);
+            s += len + (e != NULL);
+        }
+    }
+    fflush(stdout);
+}
+
+#ifndef _WIN32
+static char *read_all(FILE *f) {
+    long len;
+    char *s;
+
+    fflush(f);
+    if (fseek(f, 0, SEEK_END) != 0 || (len = ftell(f)) < 0) return NULL;
+    rewind(f);
+    s = malloc((size_t)len + 1);
+    if (!s) return NULL;
+    len = (long)fread(s, 1, (size_t)len, f);
+    s[len] = '\0';
+    return s;
+}
+
+typedef struct {
+    pid_t pid;
+    int sel;                /* index into the selection */
+    FILE *out;
+    double start;
+} l2t_child;
+
+static void run_forked(const int *sel, int nsel, int jobs, unsigned timeout,
+                       l2t_counts *counts, l2t_result *res, int verbose) {
+    l2t_child *kids = calloc((size_t)jobs, sizeof *kids);
+    int next = 0, running = 0;
+
+    if (!kids) {
+        fprintf(stderr, "l2test: out of memory\n");
+        exit(2);
+    }
+    while (next < nsel || running) {
+        while (running < jobs && next < nsel) {
+            l2t_child *k = NULL;
+            pid_t pid;
+
+            for (int j = 0; j < jobs; j++)
+                if (!kids[j].pid) { k = &kids[j]; break; }
+            k->sel = next++;
+            /* set up here, so that the suite's children share its data */
+            suite_ready(cases[sel[k->sel]].suite);
+            k->out = tmpfile();
+            k->start = now_seconds();
+            fflush(stdout);
+            fflush(stderr);
+            pid = fork();
+            if (pid == 0) {
+                const l2t_counts *c = &counts[k->sel];
+                if (k->out) {
+                    dup2(fileno(k->out), STDOUT_FILENO);
+                    dup2(fileno(k->out), STDERR_FILENO);
+                }
+                if (timeout) alarm(timeout);
+                run_case(&cases[sel[k->sel]], &counts[k->sel]);
+                fflush(stdout);
+                fflush(stderr);
+                _exit(c->failed ? 1 : 0);
+            }
+            if (pid < 0) {
+                perror("l2test: fork");
+                exit(2);
+            }
+            k->pid = pid;
+            running++;
+        }
+
+        {
+            int st;
+            pid_t pid = waitpid(-1, &st, 0);
+            l2t_child *k = NULL;
+            l2t_result *r;
+
+            if (pid < 0) {
+                perror("l2test: waitpid");
+                exit(2);
+            }
+            for (int j = 0; j < jobs; j++)
+                if (kids[j].pid == pid) { k = &kids[j]; break; }
+            if (!k) continue;
+            r = &res[k->sel];
+            r->seconds = now_seconds() - k->start;
+            r->status = counts_status(&counts[k->sel]);
+            if (WIFSIGNALED(st)) {
+                r->signal = WTERMSIG(st);
+                r->status = r->signal == SIGALRM ? ST_TIMEOUT : ST_CRASH;
+            } else if (WEXITSTATUS(st) != 0 && r->status != ST_FAIL) {
+                r->status = ST_FAIL;     /* exit() from inside the case */
+            }
+            if (k->out) {
+                r->output = read_all(k->out);
+                fclose(k->out);
+            }
+            print_result(&cases[sel[k->sel]], &counts[k->sel], r, verbose);
+            k->pid = 0;
+            running--;
+        }
+    }
+    free(kids);
+}
+#endif
+
+static void run_inline(const int *sel, int nsel, l2t_counts *counts,
+                       l2t_result *res, int verbose) {
+    for (int i = 0; i < nsel; i++) {
+        double t0 = now_seconds();
+        const l2t_case *c = &cases[sel[i]];
+
+        printf("------ %s/%s ------\n", c->suite, c->name);
+        run_case(c, &counts[i]);
+        res[i].seconds = now_seconds() - t0;
+        res[i].status = counts_status(&counts[i]);
+        print_result(c, &counts[i], &res[i], verbose);
+    }
+}
+
+static void json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; s && *s; s++) {
+        unsigned char ch = (unsigned char)*s;
+        if (ch == '"' || ch == '\\') fprintf(f, "\\%c", ch);
+        else if (ch == '\n') fputs("\\n", f);
+        else if (ch == '\t') fputs("\\t", f);
+        else if (ch < 0x20) fprintf(f, "\\u%04x", ch);
+        else fputc(ch, f);
+    }
+    fputc('"', f);
+}
+
+static int write_json(const char *path, const int *sel, int nsel,
+                      const l2t_counts *counts, const l2t_result *res,
+                      int jobs, double seconds, const int *totals) {
+    FILE *f = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+    int ok;
+
+    if (!f) return -1;
+    fprintf(f, "{\n  \"runner\": \"l2test\",\n  \"jobs\": %d,\n"
+            "  \"seconds\": %.6f,\n  \"passed\": %d,\n  \"failed\": %d,\n"
+            "  \"skipped\": %d,\n  \"cases\": [",
+            jobs, seconds, totals[ST_PASS],
+            totals[ST_FAIL] + totals[ST_CRASH] + totals[ST_TIMEOUT],
+            totals[ST_SKIP]);
+    for (int i = 0; i < nsel; i++) {
+        const l2t_case *c = &cases[sel[i]];
+        fprintf(f, "%s\n    {\"suite\": ", i ? "," : "");
+        json_string(f, c->suite);
+        fprintf(f, ", \"case\": ");
+        json_string(f, c->name);
+        fprintf(f, ", \"precision\": \"%s\", \"status\": \"%s\", "
+                "\"checks_passed\": %d, \"checks_failed\": %d, "
+                "\"seconds\": %.6f",
+                c->prec ? (char[]){c->prec, '\0'} : "all",
+                status_json[res[i].status], counts[i].passed,
+                counts[i].failed, res[i].seconds);
+        if (res[i].status == ST_CRASH)
+            fprintf(f, ", \"signal\": %d", res[i].signal);
+        if (res[i].status != ST_PASS && res[i].status != ST_SKIP &&
+            res[i].output) {
+            fprintf(f, ", \"output\": ");
+            json_string(f, res[i].output);
+        }
+        fprintf(f, "}");
+    }
+    fprintf(f, "%s]\n}\n", nsel ? "\n  " : "");
+    ok = !ferror(f);
+    if (f != stdout && fclose(f) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+static int default_jobs(void) {
+    const char *s = getenv("L2TEST_JOBS");
+    long n = s && *s ? strtol(s, NULL, 10) : 0;
+
+#ifndef _WIN32
+    if (n < 1) n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return n < 1 ? 1 : (int)n;
+}
+
+static int run_bench(const char *name, int argc, char **argv) {
+    for (int i = 0; i < nbenches; i++) {
+        if (strcmp(benches[i].name, name) != 0) continue;
+        argv[0] = (char *)benches[i].name;
+        return benches[i].fn(argc, argv);
+    }
+    fprintf(stderr, "l2test: no benchmark named %s (see --list-bench)\n",
+            name);
+    return 2;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: l2test [-p PRECS] [-j N] [-v] [-l] [--json FILE] "
+            "[--timeout S] [--no-fork] [pattern ...]\n"
+            "       l2test --list-bench\n"
+            "       l2test --bench NAME [args ...]\n");
+}
+
+int main(int argc, char **argv) {
+    const char *precs = NULL, *json = NULL;
+    const char **patterns = calloc((size_t)argc, sizeof *patterns);
+    int npatterns = 0, jobs = default_jobs(), verbose = 0, list = 0;
+    int inline_run = 0, nsel = 0, totals[5] = {0};
+    unsigned timeout = L2T_DEFAULT_TIMEOUT;
+    int *sel;
+    l2t_counts *counts;
+    l2t_result *res;
+    double t0;
+
+    /* l2test_prof has l2prof linked in for its suite; keep its exit
+     * report off unless asked for. */
+#ifndef _WIN32
+    setenv("L2PROF_OUTPUT", "none", 0);
+#endif
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (strcmp(a, "--bench") == 0) {
+            if (i + 1 >= argc) { usage(); return 2; }
+            return run_bench(argv[i + 1], argc - i - 1, argv + i + 1);
+        } else if (strcmp(a, "--list-bench") == 0) {
+            for (int b = 0; b < nbenches; b++) printf("%s\n", benches[b].name);
+            return 0;
+        } else if (strcmp(a, "-p") == 0 && i + 1 < argc) {
+            precs = argv[++i];
+        } else if (strcmp(a, "-j") == 0 && i + 1 < argc) {
+            jobs = atoi(argv[++i]);
+        } else if (strncmp(a, "-j", 2) == 0 && a[2]) {
+            jobs = atoi(a + 2);
+        } else if (strcmp(a, "-v") == 0) {
+            verbose = 1;
+        } else if (strcmp(a, "-l") == 0) {
+            list = 1;
+        } else if (strcmp(a, "--json") == 0 && i + 1 < argc) {
+            json = argv[++i];
+        } else if (strcmp(a, "--timeout") == 0 && i + 1 < argc) {
+            timeout = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(a, "--no-fork") == 0) {
+            inline_run = 1;
+        } else if (a[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            patterns[npatterns++] = a;
+        }
+    }
+    if (jobs < 1) jobs = 1;
+#ifdef _WIN32
+    inline_run = 1;
+#endif
+
+    sel = malloc(((size_t)ncases + 1) * sizeof *sel);
+    if (!sel || !patterns) {
+        fprintf(stderr, "l2test: out of memory\n");
+        return 2;
+    }
+    for (int i = 0; i < ncases; i++) {
+        char full[256];
+        int match = npatterns == 0;
+
+        if (precs && cases[i].prec && !strchr(precs, cases[i].prec))
+            continue;
+        snprintf(full, sizeof full, "%s/%s", cases[i].suite, cases[i].name);
+        for (int p = 0; p < npatterns && !match; p++)
+            match = strstr(full, patterns[p]) != NULL;
+        if (match) sel[nsel++] = i;
+    }
+    if (nsel == 0) {
+        fprintf(stderr, "l2test: no test cases match\n");
+        return 2;
+    }
+    if (list) {
+        for (int i = 0; i < nsel; i++)
+            printf("%s/%s\n", cases[sel[i]].suite, cases[sel[i]].name);
+        return 0;
+    }
+    if (jobs > nsel) jobs = nsel;
+
+    res = calloc((size_t)nsel + 1, sizeof *res);
+#ifndef _WIN32
+    counts = mmap(NULL, ((size_t)nsel + 1) * sizeof *counts,
+                  PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (counts == MAP_FAILED) counts = NULL;
+#else
+    counts = calloc((size_t)nsel + 1, sizeof *counts);
+#endif
+    if (!res || !counts) {
+        fprintf(stderr, "l2test: out of memory\n");
+        return 2;
+    }
+
+    printf("=== l2test: %d of %d cases, %d at a time ===\n\n", nsel, ncases,
+           inline_run ? 1 : jobs);
+    t0 = now_seconds();
+#ifndef _WIN32
+    if (!inline_run)
+        run_forked(sel, nsel, jobs, timeout, counts, res, verbose);
+    else
+#endif
+        run_inline(sel, nsel, counts, res, verbose);
+    t0 = now_seconds() - t0;
+
+    {
+        int checks_passed = 0, checks_failed = 0;
+        for (int i = 0; i < nsel; i++) {
+            totals[res[i].status]++;
+            checks_passed += counts[i].passed;
+            checks_failed += counts[i].failed;
+        }
+        printf("\n=== Results: %d cases passed, %d failed, %d skipped "
+               "(%d checks passed, %d failed) in %.2f s ===\n",
+               totals[ST_PASS],
+               totals[ST_FAIL] + totals[ST_CRASH] + totals[ST_TIMEOUT],
+               totals[ST_SKIP], checks_passed, checks_failed, t0);
+    }
+    if (json && write_json(json, sel, nsel, counts, res,
+                           inline_run ? 1 : jobs, t0, totals) != 0)
+        fprintf(stderr, "l2test: cannot write %s\n", json);
+
+    return totals[ST_FAIL] || totals[ST_CRASH] || totals[ST_TIMEOUT] ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Shared harness for the test_*.c suites and bench_*.c benchmarks.
+ *
+ * Every source registers what it contains from a constructor, and all of
+ * them link into the one l2test binary (l2test.c), which filters by name or
+ * precision, runs test cases in parallel and reports the results:
+ *
+ *     L2T_TEST(test_sgemv_basic) {
+ *         ...
+ *         CHECK(fabsf(y[0] - 5.0f) < TOL_FLOAT, "sgemv: basic");
+ *     }
+ *
+ * A case passes when none of its CHECKs failed.  Cases may run in separate
+ * processes, in any order, so they must not depend on each other; state a
+ * suite needs first belongs in an L2T_SETUP function.
+ */
+#ifndef L2TEST_H
+#define L2TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Suite name reported for the cases of this file; the Makefile sets it
+ * for sources that are built more than once. */
+#ifndef L2T_SUITE
+#define L2T_SUITE __FILE__
+#endif
+
+typedef void (*l2t_case_fn)(void);
+typedef int (*l2t_setup_fn)(void);
+typedef int (*l2t_bench_fn)(int argc, char **argv);
+
+void l2t_register_test(const char *suite, const char *name, l2t_case_fn fn);
+void l2t_register_setup(const char *suite, l2t_setup_fn fn);
+void l2t_register_bench(const char *name, l2t_bench_fn fn);
+
+/* Record one check of the running case; prints [PASS] or [FAIL] msg. */
+void l2t_check(int ok, const char *msg);
+/* Mark the running case as skipped (prints [SKIP] msg). */
+void l2t_skip(const char *msg);
+
+/*
+ * Heap allocations (malloc, calloc, realloc and the aligned forms) made so
+ * far by any thread of the process; the difference across a call is what
+ * the call allocated.  -1 where the runner cannot count them (not glibc).
+ */
+long l2t_alloc_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define CHECK(cond, msg) l2t_check((cond) != 0, (msg))
+
+#define L2T_TEST(name) \
+    static void name(void); \
+    __attribute__((constructor)) static void l2t_reg_##name(void) { \
+        l2t_register_test(L2T_SUITE, #name, name); \
+    } \
+    static void name(void)
+
+/*
+ * Suite setup, run once before the first case of the suite: in the runner
+ * itself, whose forked cases then share what it built, so it must not
+ * start threads.  Returns nonzero when the suite can run; on 0 its cases
+ * fail unrun.
+ */
+#define L2T_SETUP(name) \
+    static int name(void); \
+    __attribute__((constructor)) static void l2t_reg_##name(void) { \
+        l2t_register_setup(L2T_SUITE, name); \
+    } \
+    static int name(void)
+
+/*
+ * A case run once per l2blas kernel tier and registered as name[tier]; the
+ * body sees the tier as `core`.  Tiers the CPU lacks are skipped.  Needs
+ * l2blas.h.
+ */
+#define L2T_CORE_CASE(name, tier) \
+    static void name##_##tier(void) { \
+        if (l2_set_core(#tier) != 0) { \
+            l2t_skip(#tier " kernels not supported on this CPU"); \
+            return; \
+        } \
+        name(#tier); \
+        l2_set_core(NULL); \
+    } \
+    __attribute__((constructor)) static void l2t_reg_##name##_##tier(void) { \
+        l2t_register_test(L2T_SUITE, #name "[" #tier "]", name##_##tier); \
+    }
+
+#define L2T_CORE_TEST(name) \
+    static void name(const char *core); \
+    L2T_CORE_CASE(name, generic) \
+    L2T_CORE_CASE(name, avx2) \
+    L2T_CORE_CASE(name, avx512) \
+    static void name(const char *core)
+
+/* ---- test data ----------------------------------------------------------- */
+
+/*
+ * Deterministic inputs, as bench.h has them for the benchmarks.  Each suite
+ * keeps its own LCG state, so its data does not depend on which other
+ * suites are linked in or run.  Values lie in [-1, 1) on a 2^-23 grid,
+ * exact in float as well as in double.
+ */
+static inline double l2t_rand(unsigned *rng) {
+    *rng = *rng * 1664525u + 1013904223u;
+    return (double)((int)(*rng >> 8) - (1 << 23)) / (double)(1 << 23);
+}
+
+/* Uniform integer in [lo, hi]. */
+static inline int l2t_rand_int(unsigned *rng, int lo, int hi) {
+    *rng = *rng * 1664525u + 1013904223u;
+    return lo + (int)((*rng >> 8) % (unsigned)(hi - lo + 1));
+}
+
+/* n values of l2t_rand into d and the same values into s; either may be
+ * NULL. */
+static inline void l2t_fill(unsigned *rng, double *d, float *s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double v = l2t_rand(rng);
+        if (d) d[i] = v;
+        if (s) s[i] = (float)v;
+    }
+}
+
+/* n doubles into *d and n floats into *s from malloc; 0 if either fails.
+ * For L2T_SETUP functions, which run once per process. */
+static inline int l2t_alloc_sd(size_t n, double **d, float **s) {
+    *d = (double *)malloc(n * sizeof(double));
+    *s = (float *)malloc(n * sizeof(float));
+    return *d && *s;
+}
+
+/* The precision letters of case names and l2test -p. */
+static inline int l2t_is_single(char p) { return p == 's' || p == 'c'; }
+static inline int l2t_is_cplx(char p) { return p == 'c' || p == 'z'; }
+
+#endif
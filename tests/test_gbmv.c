@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "l2test.h"
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+/* A = [[2,1,0],[1,2,1],[0,1,2]], RowMajor band rows * 2 1 | 1 2 1 | 1 2 * */
+L2T_TEST(test_sgbmv_tridiagonal) {
+    float A[9] = {0.0f, 2.0f, 1.0f, 1.0f, 2.0f, 1.0f, 1.0f, 2.0f, 0.0f};
+    float x[3] = {1.0f, 1.0f, 1.0f};
+    float y[3] = {0.0f, 0.0f, 0.0f};
+
+    cblas_sgbmv(CblasRowMajor, CblasNoTrans, 3, 3, 1, 1, 1.0f, A, 3,
+                x, 1, 0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 3.0f) < TOL_FLOAT &&
+          fabsf(y[1] - 4.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 3.0f) < TOL_FLOAT,
+          "sgbmv: 3x3 tridiagonal, RowMajor");
+}
+
+/* 4x3 lower bidiagonal, ColMajor columns 1 2 | 3 4 | 5 6 (kl=1, ku=0) */
+L2T_TEST(test_sgbmv_rect_col_major) {
+    float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    float x[3] = {1.0f, 1.0f, 1.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    cblas_sgbmv(CblasColMajor, CblasNoTrans, 4, 3, 1, 0, 1.0f, A, 2,
+                x, 1, 0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(y[1] - 5.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 9.0f) < TOL_FLOAT &&
+          fabsf(y[3] - 6.0f) < TOL_FLOAT,
+          "sgbmv: 4x3 ColMajor, kl=1 ku=0");
+}
+
+L2T_TEST(test_sgbmv_rect_trans) {
+    float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    float x[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    float y[3] = {0.0f, 0.0f, 0.0f};
+
+    cblas_sgbmv(CblasColMajor, CblasTrans, 4, 3, 1, 0, 1.0f, A, 2,
+                x, 1, 0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 3.0f) < TOL_FLOAT &&
+          fabsf(y[1] - 7.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 11.0f) < TOL_FLOAT,
+          "sgbmv: 4x3 ColMajor, trans");
+}
+
+L2T_TEST(test_sgbmv_diagonal_incx) {
+    /* kl = ku = 0: y = 0.5*y + diag(1,2,3)*x */
+    float A[3] = {1.0f, 2.0f, 3.0f};
+    float x[6] = {1.0f, 99.0f, 1.0f, 99.0f, 1.0f, 99.0f};
+    float y[3] = {2.0f, 2.0f, 2.0f};
+
+    cblas_sgbmv(CblasColMajor, CblasNoTrans, 3, 3, 0, 0, 1.0f, A, 1,
+                x, 2, 0.5f, y, 1);
+
+    CHECK(fabsf(y[0] - 2.0f) < TOL_FLOAT &&
+          fabsf(y[1] - 3.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 4.0f) < TOL_FLOAT,
+          "sgbmv: diagonal band, incx=2, beta=0.5");
+}
+
+/* A = [[1,2,0],[3,4,5],[0,6,7]], ColMajor band columns * 1 3 | 2 4 6 | 5 7 * */
+L2T_TEST(test_dgbmv_alpha_beta_neg_incy) {
+    double A[9] = {0.0, 1.0, 3.0, 2.0, 4.0, 6.0, 5.0, 7.0, 0.0};
+    double x[3] = {1.0, 2.0, 3.0};
+    double y[3] = {1.0, 1.0, 1.0};
+
+    /* 2*A*x + y = 2*[5,26,33] + 1, stored backwards */
+    cblas_dgbmv(CblasColMajor, CblasNoTrans, 3, 3, 1, 1, 2.0, A, 3,
+                x, 1, 1.0, y, -1);
+
+    CHECK(fabs(y[0] - 67.0) < TOL_DOUBLE &&
+          fabs(y[1] - 53.0) < TOL_DOUBLE &&
+          fabs(y[2] - 11.0) < TOL_DOUBLE,
+          "dgbmv: alpha=2, beta=1, incy=-1");
+}
+
+L2T_TEST(test_dgbmv_trans) {
+    double A[9] = {0.0, 1.0, 3.0, 2.0, 4.0, 6.0, 5.0, 7.0, 0.0};
+    double x[3] = {1.0, 2.0, 3.0};
+    double y[3] = {99.0, 99.0, 99.0};
+
+    cblas_dgbmv(CblasColMajor, CblasTrans, 3, 3, 1, 1, 1.0, A, 3,
+                x, 1, 0.0, y, 1);
+
+    CHECK(fabs(y[0] - 7.0) < TOL_DOUBLE &&
+          fabs(y[1] - 28.0) < TOL_DOUBLE &&
+          fabs(y[2] - 31.0) < TOL_DOUBLE,
+          "dgbmv: 3x3 trans, beta=0");
+}
+
+L2T_TEST(test_cgbmv_conj_trans) {
+    /* A = [[1+i, 2],[0, i]] (kl=0, ku=1); A^H * [1,1] = [1-i, 2-i] */
+    float A[8] = {0.0f, 0.0f, 1.0f, 1.0f, 2.0f, 0.0f, 0.0f, 1.0f};
+    float x[4] = {1.0f, 0.0f, 1.0f, 0.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2] = {0.0f, 0.0f};
+
+    cblas_cgbmv(CblasColMajor, CblasConjTrans, 2, 2, 0, 1, alpha, A, 2,
+                x, 1, beta, y, 1);
+
+    CHECK(fabsf(y[0] - 1.0f) < TOL_FLOAT && fabsf(y[1] + 1.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 2.0f) < TOL_FLOAT && fabsf(y[3] + 1.0f) < TOL_FLOAT,
+          "cgbmv: ColMajor, conj-trans");
+}
+
+L2T_TEST(test_zgbmv_row_major) {
+    /* A = [[i,1],[1,i]], RowMajor rows * i 1 | 1 i *; A * [1, i] = [2i, 0] */
+    double A[12] = {0.0, 0.0, 0.0, 1.0, 1.0, 0.0,
+                    1.0, 0.0, 0.0, 1.0, 0.0, 0.0};
+    double x[4] = {1.0, 0.0, 0.0, 1.0};
+    double y[4] = {5.0, 5.0, 5.0, 5.0};
+    double alpha[2] = {1.0, 0.0};
+    double beta[2] = {0.0, 0.0};
+
+    cblas_zgbmv(CblasRowMajor, CblasNoTrans, 2, 2, 1, 1, alpha, A, 3,
+                x, 1, beta, y, 1);
+
+    CHECK(fabs(y[0]) < TOL_DOUBLE && fabs(y[1] - 2.0) < TOL_DOUBLE &&
+          fabs(y[2]) < TOL_DOUBLE && fabs(y[3]) < TOL_DOUBLE,
+          "zgbmv: RowMajor, complex band");
+}
@@ -2,21 +2,13 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
 
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-
-void test_sgemv_basic(void) {
+L2T_TEST(test_sgemv_basic) {
     float A[4] = {1.0f, 2.0f, 3.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {0.0f, 0.0f};
@@ -29,7 +21,7 @@ void test_sgemv_basic(void) {
           "sgemv: basic 2x2 NoTrans");
 }
 
-void test_sgemv_trans(void) {
+L2T_TEST(test_sgemv_trans) {
     float A[4] = {1.0f, 2.0f, 3.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {0.0f, 0.0f};
@@ -42,7 +34,7 @@ void test_sgemv_trans(void) {
           "sgemv: basic 2x2 Trans");
 }
 
-void test_sgemv_alpha_beta(void) {
+L2T_TEST(test_sgemv_alpha_beta) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[2] = {2.0f, 3.0f};
     float y[2] = {1.0f, 1.0f};
@@ -55,7 +47,7 @@ void test_sgemv_alpha_beta(void) {
           "sgemv: alpha=2, beta=3");
 }
 
-void test_sgemv_col_major(void) {
+L2T_TEST(test_sgemv_col_major) {
     float A[4] = {1.0f, 2.0f, 3.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {0.0f, 0.0f};
@@ -68,7 +60,7 @@ void test_sgemv_col_major(void) {
           "sgemv: ColMajor 2x2");
 }
 
-void test_sgemv_incx_incy(void) {
+L2T_TEST(test_sgemv_incx_incy) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[4] = {1.0f, 99.0f, 2.0f, 99.0f};
     float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
@@ -81,7 +73,7 @@ void test_sgemv_incx_incy(void) {
           "sgemv: incx=2, incy=2");
 }
 
-void test_sgemv_non_square(void) {
+L2T_TEST(test_sgemv_non_square) {
     float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
     float x[2] = {1.0f, 1.0f};
     float y[3] = {0.0f, 0.0f, 0.0f};
@@ -95,7 +87,7 @@ void test_sgemv_non_square(void) {
           "sgemv: non-square 3x2");
 }
 
-void test_dgemv_basic(void) {
+L2T_TEST(test_dgemv_basic) {
     double A[4] = {1.0, 2.0, 3.0, 4.0};
     double x[2] = {1.0, 1.0};
     double y[2] = {0.0, 0.0};
@@ -108,7 +100,7 @@ void test_dgemv_basic(void) {
           "dgemv: basic 2x2 NoTrans");
 }
 
-void test_dgemv_trans(void) {
+L2T_TEST(test_dgemv_trans) {
     double A[4] = {1.0, 2.0, 3.0, 4.0};
     double x[2] = {1.0, 1.0};
     double y[2] = {0.0, 0.0};
@@ -121,7 +113,7 @@ void test_dgemv_trans(void) {
           "dgemv: basic 2x2 Trans");
 }
 
-void test_dgemv_large(void) {
+L2T_TEST(test_dgemv_large) {
     int n = 4;
     double A[16] = {
         1,0,0,0,
@@ -141,7 +133,7 @@ void test_dgemv_large(void) {
     CHECK(ok, "dgemv: 4x4 identity");
 }
 
-void test_cgemv_basic(void) {
+L2T_TEST(test_cgemv_basic) {
     float A[8]  = {1,0, 0,0,  0,0, 1,0};
     float x[4]  = {1,0, 0,1};
     float y[4]  = {0,0, 0,0};
@@ -158,7 +150,7 @@ void test_cgemv_basic(void) {
           "cgemv: 2x2 complex identity NoTrans");
 }
 
-void test_cgemv_conj_trans(void) {
+L2T_TEST(test_cgemv_conj_trans) {
 
     float A[8] = {0,1, 0,0,  0,0, 0,1};
     float x[4] = {1,0, 1,0};
@@ -176,7 +168,7 @@ void test_cgemv_conj_trans(void) {
           "cgemv: 2x2 ConjTrans");
 }
 
-void test_zgemv_basic(void) {
+L2T_TEST(test_zgemv_basic) {
     double A[8]  = {2,0, 0,0,  0,0, 2,0};
     double x[4]  = {1,0, 1,0};
     double y[4]  = {0,0, 0,0};
@@ -190,26 +182,3 @@ void test_zgemv_basic(void) {
           fabs(y[2] - 2.0) < TOL_DOUBLE,
           "zgemv: 2x2 diagonal complex matrix");
 }
-
-int main(void) {
-    printf("=== cblas_?gemv interface tests ===\n\n");
-
-    test_sgemv_basic();
-    test_sgemv_trans();
-    test_sgemv_alpha_beta();
-    test_sgemv_col_major();
-    test_sgemv_incx_incy();
-    test_sgemv_non_square();
-
-    test_dgemv_basic();
-    test_dgemv_trans();
-    test_dgemv_large();
-
-    test_cgemv_basic();
-    test_cgemv_conj_trans();
-
-    test_zgemv_basic();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
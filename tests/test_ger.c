@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_sger_basic(void) {
+L2T_TEST(test_sger_basic) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 2.0f};
     float y[2] = {3.0f, 4.0f};
@@ -29,7 +21,7 @@ void test_sger_basic(void) {
           "sger: A=0, alpha=1, rank-1 update");
 }
 
-void test_sger_alpha(void) {
+L2T_TEST(test_sger_alpha) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {1.0f, 1.0f};
@@ -41,7 +33,7 @@ void test_sger_alpha(void) {
           "sger: alpha=2");
 }
 
-void test_sger_accumulate(void) {
+L2T_TEST(test_sger_accumulate) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[2] = {1.0f, 0.0f};
     float y[2] = {0.0f, 1.0f};
@@ -55,7 +47,7 @@ void test_sger_accumulate(void) {
           "sger: accumulate on existing A");
 }
 
-void test_sger_non_square(void) {
+L2T_TEST(test_sger_non_square) {
     float A[6] = {0,0, 0,0, 0,0};
     float x[3] = {1.0f, 2.0f, 3.0f};
     float y[2] = {1.0f, 1.0f};
@@ -68,7 +60,7 @@ void test_sger_non_square(void) {
           "sger: non-square 3x2");
 }
 
-void test_sger_incx_incy(void) {
+L2T_TEST(test_sger_incx_incy) {
     float A[4] = {0,0, 0,0};
     float x[4] = {1.0f, 99.0f, 2.0f, 99.0f};
     float y[4] = {3.0f, 99.0f, 4.0f, 99.0f};
@@ -80,7 +72,7 @@ void test_sger_incx_incy(void) {
           "sger: incx=2, incy=2");
 }
 
-void test_sger_col_major(void) {
+L2T_TEST(test_sger_col_major) {
     float A[4] = {0,0, 0,0};
     float x[2] = {1.0f, 2.0f};
     float y[2] = {3.0f, 4.0f};
@@ -94,7 +86,7 @@ void test_sger_col_major(void) {
           "sger: ColMajor");
 }
 
-void test_dger_basic(void) {
+L2T_TEST(test_dger_basic) {
     double A[4] = {0.0, 0.0, 0.0, 0.0};
     double x[2] = {1.0, 2.0};
     double y[2] = {3.0, 4.0};
@@ -108,7 +100,7 @@ void test_dger_basic(void) {
           "dger: basic rank-1 update");
 }
 
-void test_dger_negative_alpha(void) {
+L2T_TEST(test_dger_negative_alpha) {
     double A[4] = {2.0, 0.0, 0.0, 2.0};
     double x[2] = {1.0, 0.0};
     double y[2] = {1.0, 0.0};
@@ -119,20 +111,3 @@ void test_dger_negative_alpha(void) {
           fabs(A[3] - 2.0) < TOL_DOUBLE,
           "dger: alpha=-1 (subtract outer product)");
 }
-
-int main(void) {
-    printf("=== cblas_?ger interface tests ===\n\n");
-
-    test_sger_basic();
-    test_sger_alpha();
-    test_sger_accumulate();
-    test_sger_non_square();
-    test_sger_incx_incy();
-    test_sger_col_major();
-
-    test_dger_basic();
-    test_dger_negative_alpha();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_cgeru_basic(void) {
+L2T_TEST(test_cgeru_basic) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {1,0, 0,1};
     float y[4] = {1,0, 0,1};
@@ -34,7 +26,7 @@ void test_cgeru_basic(void) {
           "cgeru: A=0 + x*y^T (unconjugated)");
 }
 
-void test_cgeru_real(void) {
+L2T_TEST(test_cgeru_real) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {2,0, 3,0};
     float y[4] = {1,0, 4,0};
@@ -49,7 +41,7 @@ void test_cgeru_real(void) {
           "cgeru: real vectors, result matches dger");
 }
 
-void test_cgeru_alpha_complex(void) {
+L2T_TEST(test_cgeru_alpha_complex) {
     float A[2] = {0,0};
     float x[2] = {1,0};
     float y[2] = {1,0};
@@ -62,7 +54,7 @@ void test_cgeru_alpha_complex(void) {
           "cgeru: complex alpha");
 }
 
-void test_cgeru_incx_incy(void) {
+L2T_TEST(test_cgeru_incx_incy) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[8] = {1,0, 99,99, 0,1, 99,99};
     float y[8] = {1,0, 99,99, 0,1, 99,99};
@@ -75,7 +67,7 @@ void test_cgeru_incx_incy(void) {
           "cgeru: incx=2, incy=2");
 }
 
-void test_cgerc_basic(void) {
+L2T_TEST(test_cgerc_basic) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {1,0, 0,1};
     float y[4] = {1,0, 0,1};
@@ -94,7 +86,7 @@ void test_cgerc_basic(void) {
           "cgerc: A=0 + x*y^H (conjugated)");
 }
 
-void test_cgerc_vs_geru_real(void) {
+L2T_TEST(test_cgerc_vs_geru_real) {
     float A_u[8] = {0,0, 0,0, 0,0, 0,0};
     float A_c[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {1,0, 2,0};
@@ -110,7 +102,7 @@ void test_cgerc_vs_geru_real(void) {
     CHECK(ok, "cgerc vs cgeru: identical for real vectors");
 }
 
-void test_zgeru_basic(void) {
+L2T_TEST(test_zgeru_basic) {
     double A[8] = {0,0, 0,0, 0,0, 0,0};
     double x[4] = {1,0, 0,1};
     double y[4] = {1,0, 0,1};
@@ -123,7 +115,7 @@ void test_zgeru_basic(void) {
           "zgeru: basic complex");
 }
 
-void test_zgerc_basic(void) {
+L2T_TEST(test_zgerc_basic) {
     double A[8] = {0,0, 0,0, 0,0, 0,0};
     double x[4] = {1,0, 0,1};
     double y[4] = {1,0, 0,1};
@@ -136,21 +128,3 @@ void test_zgerc_basic(void) {
           fabs(A[6] - 1.0)  < TOL_DOUBLE,
           "zgerc: basic complex conjugated");
 }
-
-int main(void) {
-    printf("=== cblas_?geru / cblas_?gerc interface tests ===\n\n");
-
-    test_cgeru_basic();
-    test_cgeru_real();
-    test_cgeru_alpha_complex();
-    test_cgeru_incx_incy();
-
-    test_cgerc_basic();
-    test_cgerc_vs_geru_real();
-
-    test_zgeru_basic();
-    test_zgerc_basic();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
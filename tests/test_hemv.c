@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_chemv_identity(void) {
+L2T_TEST(test_chemv_identity) {
     float A[8] = {1,0, 0,0,  0,0, 1,0};
     float x[4] = {1,1, 2,-1};
     float y[4] = {0,0, 0,0};
@@ -32,7 +24,7 @@ void test_chemv_identity(void) {
           "chemv: identity upper, y=x");
 }
 
-void test_chemv_real_diagonal(void) {
+L2T_TEST(test_chemv_real_diagonal) {
     float A[8] = {3,0, 0,0,  0,0, 5,0};
     float x[4] = {1,0, 1,0};
     float y[4] = {0,0, 0,0};
@@ -49,7 +41,7 @@ void test_chemv_real_diagonal(void) {
           "chemv: real diagonal 2x2 upper");
 }
 
-void test_chemv_lower(void) {
+L2T_TEST(test_chemv_lower) {
     float A[8] = {3,0, 0,0,  0,0, 5,0};
     float x[4] = {1,0, 1,0};
     float y[4] = {0,0, 0,0};
@@ -64,7 +56,7 @@ void test_chemv_lower(void) {
           "chemv: real diagonal 2x2 lower");
 }
 
-void test_chemv_off_diagonal(void) {
+L2T_TEST(test_chemv_off_diagonal) {
     float A[8] = {2,0, 1,1,  1,-1, 3,0};
     float x[4] = {1,0, 0,1};
     float y[4] = {0,0, 0,0};
@@ -81,7 +73,7 @@ void test_chemv_off_diagonal(void) {
           "chemv: off-diagonal Hermitian 2x2");
 }
 
-void test_chemv_alpha_beta(void) {
+L2T_TEST(test_chemv_alpha_beta) {
     float A[8] = {1,0, 0,0,  0,0, 1,0};
     float x[4] = {1,0, 1,0};
     float y[4] = {1,0, 1,0};
@@ -96,7 +88,7 @@ void test_chemv_alpha_beta(void) {
           "chemv: alpha=2, beta=3");
 }
 
-void test_chemv_incx_incy(void) {
+L2T_TEST(test_chemv_incx_incy) {
     float A[8] = {1,0, 0,0,  0,0, 1,0};
     float x[8] = {1,0, 99,99, 2,0, 99,99};
     float y[8] = {0,0, 0,0,   0,0, 0,0};
@@ -111,7 +103,7 @@ void test_chemv_incx_incy(void) {
           "chemv: incx=2, incy=2");
 }
 
-void test_zhemv_basic(void) {
+L2T_TEST(test_zhemv_basic) {
     double A[8] = {4,0, 0,0,  0,0, 6,0};
     double x[4] = {1,0, 1,0};
     double y[4] = {0,0, 0,0};
@@ -126,7 +118,7 @@ void test_zhemv_basic(void) {
           "zhemv: real diagonal 2x2");
 }
 
-void test_zhemv_lower(void) {
+L2T_TEST(test_zhemv_lower) {
     double A[8] = {4,0, 0,0,  0,0, 6,0};
     double x[4] = {1,0, 1,0};
     double y[4] = {0,0, 0,0};
@@ -141,7 +133,7 @@ void test_zhemv_lower(void) {
           "zhemv: lower triangle 2x2");
 }
 
-void test_zhemv_off_diagonal(void) {
+L2T_TEST(test_zhemv_off_diagonal) {
     double A[8] = {1,0, 0,1,  0,-1, 1,0};
     double x[4] = {1,0, 1,0};
     double y[4] = {0,0, 0,0};
@@ -157,21 +149,3 @@ void test_zhemv_off_diagonal(void) {
           fabs(y[3] - (-1.0)) < TOL_DOUBLE,
           "zhemv: off-diagonal complex 2x2");
 }
-
-int main(void) {
-    printf("=== cblas_?hemv interface tests ===\n\n");
-
-    test_chemv_identity();
-    test_chemv_real_diagonal();
-    test_chemv_lower();
-    test_chemv_off_diagonal();
-    test_chemv_alpha_beta();
-    test_chemv_incx_incy();
-
-    test_zhemv_basic();
-    test_zhemv_lower();
-    test_zhemv_off_diagonal();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
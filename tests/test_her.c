@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_cher_upper_basic(void) {
+L2T_TEST(test_cher_upper_basic) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {1,0, 0,1};
 
@@ -29,7 +21,7 @@ void test_cher_upper_basic(void) {
           "cher: upper basic rank-1");
 }
 
-void test_cher_lower_basic(void) {
+L2T_TEST(test_cher_lower_basic) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {1,0, 0,1};
 
@@ -42,7 +34,7 @@ void test_cher_lower_basic(void) {
           "cher: lower basic rank-1");
 }
 
-void test_cher_real_vector(void) {
+L2T_TEST(test_cher_real_vector) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {2,0, 3,0};
 
@@ -54,7 +46,7 @@ void test_cher_real_vector(void) {
           "cher: real vector result");
 }
 
-void test_cher_alpha_scale(void) {
+L2T_TEST(test_cher_alpha_scale) {
     float A[2] = {0,0};
     float x[2] = {1,0};
 
@@ -64,7 +56,7 @@ void test_cher_alpha_scale(void) {
           "cher: alpha=2 scale");
 }
 
-void test_cher_accumulate(void) {
+L2T_TEST(test_cher_accumulate) {
     float A[8] = {1,0, 0,0, 0,0, 1,0};
     float x[4] = {1,0, 0,0};
 
@@ -75,7 +67,7 @@ void test_cher_accumulate(void) {
           "cher: accumulate on identity");
 }
 
-void test_cher_incx(void) {
+L2T_TEST(test_cher_incx) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[8] = {1,0, 99,99, 2,0, 99,99};
 
@@ -87,7 +79,7 @@ void test_cher_incx(void) {
           "cher: incx=2");
 }
 
-void test_zher_upper_basic(void) {
+L2T_TEST(test_zher_upper_basic) {
     double A[8] = {0,0, 0,0, 0,0, 0,0};
     double x[4] = {1,0, 0,1};
 
@@ -100,7 +92,7 @@ void test_zher_upper_basic(void) {
           "zher: upper basic rank-1");
 }
 
-void test_zher_lower(void) {
+L2T_TEST(test_zher_lower) {
     double A[8] = {0,0, 0,0, 0,0, 0,0};
     double x[4] = {1,0, 0,1};
 
@@ -111,20 +103,3 @@ void test_zher_lower(void) {
           fabs(A[6] - 1.0) < TOL_DOUBLE,
           "zher: lower basic rank-1");
 }
-
-int main(void) {
-    printf("=== cblas_?her interface tests ===\n\n");
-
-    test_cher_upper_basic();
-    test_cher_lower_basic();
-    test_cher_real_vector();
-    test_cher_alpha_scale();
-    test_cher_accumulate();
-    test_cher_incx();
-
-    test_zher_upper_basic();
-    test_zher_lower();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_cher2_real_upper(void) {
+L2T_TEST(test_cher2_real_upper) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {2,0, 3,0};
     float y[4] = {1,0, 4,0};
@@ -31,7 +23,7 @@ void test_cher2_real_upper(void) {
           "cher2: real vectors upper");
 }
 
-void test_cher2_lower_real(void) {
+L2T_TEST(test_cher2_lower_real) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[4] = {2,0, 3,0};
     float y[4] = {1,0, 4,0};
@@ -45,7 +37,7 @@ void test_cher2_lower_real(void) {
           "cher2: real vectors lower");
 }
 
-void test_cher2_complex_diagonal_real(void) {
+L2T_TEST(test_cher2_complex_diagonal_real) {
     float A[2] = {0,0};
     float x[2] = {1,1};
     float y[2] = {1,0};
@@ -58,7 +50,7 @@ void test_cher2_complex_diagonal_real(void) {
           "cher2: diagonal stays real for complex x,y");
 }
 
-void test_cher2_complex_alpha(void) {
+L2T_TEST(test_cher2_complex_alpha) {
     float A[2] = {0,0};
     float x[2] = {1,0};
     float y[2] = {1,0};
@@ -71,7 +63,7 @@ void test_cher2_complex_alpha(void) {
           "cher2: imaginary alpha, diagonal stays real (=0)");
 }
 
-void test_cher2_accumulate(void) {
+L2T_TEST(test_cher2_accumulate) {
     /*
      * A = identity, alpha=1
      * x=|(1+0i),(0+0i)|, y=|(0+0i),(1+0i)|
@@ -96,7 +88,7 @@ void test_cher2_accumulate(void) {
           "cher2: accumulate on identity");
 }
 
-void test_cher2_incx_incy(void) {
+L2T_TEST(test_cher2_incx_incy) {
     float A[8] = {0,0, 0,0, 0,0, 0,0};
     float x[8] = {2,0, 99,99, 3,0, 99,99};
     float y[8] = {1,0, 99,99, 4,0, 99,99};
@@ -110,7 +102,7 @@ void test_cher2_incx_incy(void) {
           "cher2: incx=2, incy=2");
 }
 
-void test_zher2_real_upper(void) {
+L2T_TEST(test_zher2_real_upper) {
     double A[8] = {0,0, 0,0, 0,0, 0,0};
     double x[4] = {2,0, 3,0};
     double y[4] = {1,0, 4,0};
@@ -124,7 +116,7 @@ void test_zher2_real_upper(void) {
           "zher2: real vectors upper");
 }
 
-void test_zher2_lower(void) {
+L2T_TEST(test_zher2_lower) {
     double A[8] = {0,0, 0,0, 0,0, 0,0};
     double x[4] = {2,0, 3,0};
     double y[4] = {1,0, 4,0};
@@ -137,20 +129,3 @@ void test_zher2_lower(void) {
           fabs(A[6] - 24.0) < TOL_DOUBLE,
           "zher2: real vectors lower");
 }
-
-int main(void) {
-    printf("=== cblas_?her2 interface tests ===\n\n");
-
-    test_cher2_real_upper();
-    test_cher2_lower_real();
-    test_cher2_complex_diagonal_real();
-    test_cher2_complex_alpha();
-    test_cher2_accumulate();
-    test_cher2_incx_incy();
-
-    test_zher2_real_upper();
-    test_zher2_lower();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
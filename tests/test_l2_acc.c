@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Deferred rank-k accumulation against the same updates issued one by one
+ * to OpenBLAS: a script of NUPD rank-1/rank-2 updates with mixed
+ * increments, queued in workspaces of 1, 3 and 16 slots (so the queue
+ * fills and flushes itself mid-script), for every kernel tier, both
+ * orders and, for the triangular kinds, both uplos.  The whole array is
+ * compared, so touching the unstored triangle or the lda padding shows up
+ * as a mismatch, and so does a nonzero imaginary part on a Hermitian
+ * diagonal.
+ */
+
+#define MAXN 700
+#define PAD 2
+#define NUPD 6
+
+static const int sizes[] = {1, 2, 5, 17, 64, 300};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int caps[] = {1, 3, 16};
+#define NCAPS ((int)(sizeof(caps) / sizeof(caps[0])))
+
+/* per-update increments: x, y */
+static const int incs[NUPD][2] = {{1, 1}, {2, -1}, {-1, 3}, {1, 2},
+                                  {-2, 1}, {1, -3}};
+
+static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+static const enum CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+static const char *order_name[2] = {"RowMajor", "ColMajor"};
+static const char *uplo_name[2] = {"Upper", "Lower"};
+static const char precs[] = {'s', 'd', 'c', 'z'};
+
+/* Matrices and vectors as reals; complex data interleaves (re, im). */
+static float  *sA0, *sA, *sAref, *sx, *sy, *swork;
+static double *dA0, *dA, *dAref, *dx, *dy, *dwork;
+
+static unsigned rng = 9001u;
+
+L2T_SETUP(alloc_inputs) {
+    size_t na = 2 * (size_t)(MAXN + PAD) * MAXN;
+    size_t nv = 2 * 3 * (size_t)MAXN * NUPD;
+    size_t nw = 2 * (size_t)L2_ACC_LWORK(MAXN, MAXN, 16);
+
+    if (!l2t_alloc_sd(na, &dA0, &sA0) || !l2t_alloc_sd(na, &dA, &sA) ||
+        !l2t_alloc_sd(na, &dAref, &sAref) || !l2t_alloc_sd(nv, &dx, &sx) ||
+        !l2t_alloc_sd(nv, &dy, &sy) || !l2t_alloc_sd(nw, &dwork, &swork))
+        return 0;
+    l2t_fill(&rng, dA0, sA0, na);
+    l2t_fill(&rng, dx, sx, nv);
+    l2t_fill(&rng, dy, sy, nv);
+    return 1;
+}
+
+/*
+ * kind: 0 general, 1 symmetric (s/d) or Hermitian (c/z).  Update u of the
+ * script alternates the two operations of its kind (ger/geru vs gerc,
+ * syr/her vs syr2/her2) and reads its vectors from slice u of x and y.
+ */
+static int acc_case(char p, int kind, enum CBLAS_ORDER o, enum CBLAS_UPLO up,
+                    int m, int n, int cap) {
+    static const float  c_alpha[2] = {0.6f, -0.3f};
+    static const double z_alpha[2] = {0.6, -0.3};
+    int cs = l2t_is_cplx(p) ? 2 : 1;
+    int lda = (o == CblasColMajor || kind ? m : n) + PAD;
+    size_t len = (size_t)lda * (o == CblasColMajor || kind ? n : m) * cs;
+    size_t slice = 2 * 3 * (size_t)MAXN;
+    int lwork = L2_ACC_LWORK(m, n, cap);
+    double eps = l2t_is_single(p) ? FLT_EPSILON : DBL_EPSILON;
+    l2_acc acc;
+
+    if (l2t_is_single(p)) {
+        memcpy(sA, sA0, len * sizeof(float));
+        memcpy(sAref, sA0, len * sizeof(float));
+    } else {
+        memcpy(dA, dA0, len * sizeof(double));
+        memcpy(dAref, dA0, len * sizeof(double));
+    }
+    switch (p) {
+    case 's':
+        if (kind) l2_sacc_init_sy(&acc, o, up, n, sA, lda, swork, lwork);
+        else      l2_sacc_init_ge(&acc, o, m, n, sA, lda, swork, lwork);
+        break;
+    case 'd':
+        if (kind) l2_dacc_init_sy(&acc, o, up, n, dA, lda, dwork, lwork);
+        else      l2_dacc_init_ge(&acc, o, m, n, dA, lda, dwork, lwork);
+        break;
+    case 'c':
+        if (kind) l2_cacc_init_he(&acc, o, up, n, sA, lda, swork, lwork);
+        else      l2_cacc_init_ge(&acc, o, m, n, sA, lda, swork, lwork);
+        break;
+    default:
+        if (kind) l2_zacc_init_he(&acc, o, up, n, dA, lda, dwork, lwork);
+        else      l2_zacc_init_ge(&acc, o, m, n, dA, lda, dwork, lwork);
+        break;
+    }
+
+    for (int u = 0; u < NUPD; u++) {
+        int ix = incs[u][0], iy = incs[u][1], alt = u & 1;
+        float *xs = sx + u * slice, *ys = sy + u * slice;
+        double *xd = dx + u * slice, *yd = dy + u * slice;
+        float sa = 0.5f - 0.2f * (float)u;
+        double da = 0.5 - 0.2 * (double)u;
+
+        switch (p * 4 + kind * 2 + alt) {
+        case 's' * 4 + 0: case 's' * 4 + 1:
+            l2_sacc_ger(&acc, sa, xs, ix, ys, iy);
+            cblas_sger(o, m, n, sa, xs, ix, ys, iy, sAref, lda);
+            break;
+        case 's' * 4 + 2:
+            l2_sacc_syr(&acc, sa, xs, ix);
+            cblas_ssyr(o, up, n, sa, xs, ix, sAref, lda);
+            break;
+        case 's' * 4 + 3:
+            l2_sacc_syr2(&acc, sa, xs, ix, ys, iy);
+            cblas_ssyr2(o, up, n, sa, xs, ix, ys, iy, sAref, lda);
+            break;
+        case 'd' * 4 + 0: case 'd' * 4 + 1:
+            l2_dacc_ger(&acc, da, xd, ix, yd, iy);
+            cblas_dger(o, m, n, da, xd, ix, yd, iy, dAref, lda);
+            break;
+        case 'd' * 4 + 2:
+            l2_dacc_syr(&acc, da, xd, ix);
+            cblas_dsyr(o, up, n, da, xd, ix, dAref, lda);
+            break;
+        case 'd' * 4 + 3:
+            l2_dacc_syr2(&acc, da, xd, ix, yd, iy);
+            cblas_dsyr2(o, up, n, da, xd, ix, yd, iy, dAref, lda);
+            break;
+        case 'c' * 4 + 0:
+            l2_cacc_geru(&acc, c_alpha, xs, ix, ys, iy);
+            cblas_cgeru(o, m, n, c_alpha, xs, ix, ys, iy, sAref, lda);
+            break;
+        case 'c' * 4 + 1:
+            l2_cacc_gerc(&acc, c_alpha, xs, ix, ys, iy);
+            cblas_cgerc(o, m, n, c_alpha, xs, ix, ys, iy, sAref, lda);
+            break;
+        case 'c' * 4 + 2:
+            l2_cacc_her(&acc, sa, xs, ix);
+            cblas_cher(o, up, n, sa, xs, ix, sAref, lda);
+            break;
+        case 'c' * 4 + 3:
+            l2_cacc_her2(&acc, c_alpha, xs, ix, ys, iy);
+            cblas_cher2(o, up, n, c_alpha, xs, ix, ys, iy, sAref, lda);
+            break;
+        case 'z' * 4 + 0:
+            l2_zacc_geru(&acc, z_alpha, xd, ix, yd, iy);
+            cblas_zgeru(o, m, n, z_alpha, xd, ix, yd, iy, dAref, lda);
+            break;
+        case 'z' * 4 + 1:
+            l2_zacc_gerc(&acc, z_alpha, xd, ix, yd, iy);
+            cblas_zgerc(o, m, n, z_alpha, xd, ix, yd, iy, dAref, lda);
+            break;
+        case 'z' * 4 + 2:
+            l2_zacc_her(&acc, da, xd, ix);
+            cblas_zher(o, up, n, da, xd, ix, dAref, lda);
+            break;
+        default:
+            l2_zacc_her2(&acc, z_alpha, xd, ix, yd, iy);
+            cblas_zher2(o, up, n, z_alpha, xd, ix, yd, iy, dAref, lda);
+            break;
+        }
+    }
+    switch (p) {
+    case 's': l2_sacc_flush(&acc); break;
+    case 'd': l2_dacc_flush(&acc); break;
+    case 'c': l2_cacc_flush(&acc); break;
+    default:  l2_zacc_flush(&acc); break;
+    }
+
+    /* |a| <= 1 plus at most 2 * NUPD terms of size <= 1.3 */
+    for (size_t i = 0; i < len; i++) {
+        double got = l2t_is_single(p) ? sA[i] : dA[i];
+        double ref = l2t_is_single(p) ? sAref[i] : dAref[i];
+        if (!(fabs(got - ref) <= 8.0 * (2 * NUPD + 2) * eps * 4.0))
+            return 0;
+    }
+    return 1;
+}
+
+L2T_CORE_TEST(test_acc_ge_sweep) {
+    char msg[128];
+
+    for (int p = 0; p < 4; p++)
+        for (int oi = 0; oi < 2; oi++) {
+            int ok = 1;
+            for (int a = 0; a < NSIZES; a++)
+                for (int b = 0; b < NSIZES; b++)
+                    for (int c = 0; c < NCAPS; c++)
+                        ok &= acc_case(precs[p], 0, orders[oi], CblasUpper,
+                                       sizes[a], sizes[b], caps[c]);
+            snprintf(msg, sizeof(msg),
+                     "l2_%cacc %s[%s]: %s matches one-by-one OpenBLAS",
+                     precs[p], p < 2 ? "ger" : "geru/gerc", core,
+                     order_name[oi]);
+            CHECK(ok, msg);
+        }
+}
+
+L2T_CORE_TEST(test_acc_sy_he_sweep) {
+    char msg[128];
+
+    for (int p = 0; p < 4; p++)
+        for (int oi = 0; oi < 2; oi++)
+            for (int ui = 0; ui < 2; ui++) {
+                int ok = 1;
+                for (int a = 0; a < NSIZES; a++)
+                    for (int c = 0; c < NCAPS; c++)
+                        ok &= acc_case(precs[p], 1, orders[oi], uplos[ui],
+                                       sizes[a], sizes[a], caps[c]);
+                snprintf(msg, sizeof(msg),
+                         "l2_%cacc %s[%s]: %s %s matches one-by-one OpenBLAS",
+                         precs[p], p < 2 ? "syr/syr2" : "her/her2", core,
+                         order_name[oi], uplo_name[ui]);
+                CHECK(ok, msg);
+            }
+}
+
+/* A flush large enough to be split over 4 threads. */
+L2T_TEST(test_acc_threads) {
+    int saved = l2_get_num_threads();
+    char msg[128];
+
+    l2_set_num_threads(4);
+    for (int p = 0; p < 4; p++) {
+        int ok = 1;
+        for (int oi = 0; oi < 2; oi++) {
+            ok &= acc_case(precs[p], 0, orders[oi], CblasUpper, MAXN, 430, 16);
+            for (int ui = 0; ui < 2; ui++)
+                ok &= acc_case(precs[p], 1, orders[oi], uplos[ui], MAXN,
+                               MAXN, 16);
+        }
+        snprintf(msg, sizeof(msg),
+                 "l2_%cacc: n=%d flushes with 4 threads match OpenBLAS",
+                 precs[p], MAXN);
+        CHECK(ok, msg);
+    }
+    l2_set_num_threads(saved);
+}
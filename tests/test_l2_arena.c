@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Arena variants (l2_?gemv_arena, l2_?symv_arena / l2_?hemv_arena,
+ * l2_?trsv_arena, l2_?trmv_arena) against OpenBLAS for all four
+ * precisions, both orders and every kernel tier, with unit, positive and
+ * negative increments.  Each case runs with an arena that stages every
+ * vector and with one too small for the larger sizes, which must fall back
+ * to the plain strided path.  Then the guarantee itself: after
+ * l2_arena_init no call allocates, on any thread.
+ */
+
+#define MAXN 600
+
+static const int sizes[] = {1, 2, 7, 17, 64, 257, 600};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 3}, {-1, -2}, {1, -3}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const char precs[] = {'s', 'd', 'c', 'z'};
+
+enum { K_GEMV, K_SYMV, K_TRSV, K_TRMV, NKINDS };
+static const char *kind_name[NKINDS] = {"gemv", "symv/hemv", "trsv",
+                                        "trmv"};
+
+/* Reals; complex data interleaves (re, im).  lda is MAXN throughout. */
+static float  *sA, *sx, *sy, *syref;
+static double *dA, *dx, *dy, *dyref;
+static void *big_work, *small_work;
+
+static unsigned rng = 5150u;
+
+L2T_SETUP(alloc_inputs) {
+    size_t na = 2 * (size_t)MAXN * MAXN, nv = 2 * 3 * (size_t)MAXN;
+
+    big_work = malloc(L2_ARENA_LWORK(MAXN));
+    small_work = malloc(L2_ARENA_LWORK(100));
+    if (!l2t_alloc_sd(na, &dA, &sA) || !l2t_alloc_sd(nv, &dx, &sx) ||
+        !l2t_alloc_sd(nv, &dy, &sy) || !l2t_alloc_sd(nv, &dyref, &syref) ||
+        !big_work || !small_work)
+        return 0;
+    /* a dominant diagonal for every n, so trsv stays well conditioned */
+    for (size_t i = 0; i < na; i++) {
+        dA[i] = l2t_rand(&rng) / MAXN;
+        sA[i] = (float)dA[i];
+    }
+    for (int cs = 1; cs <= 2; cs++)
+        for (size_t i = 0; i < MAXN; i++) {
+            size_t k = i * (MAXN + 1) * cs;
+            dA[k] = 2.0 + l2t_rand(&rng);
+            sA[k] = (float)dA[k];
+        }
+    l2t_fill(&rng, dx, sx, nv);
+    return 1;
+}
+
+/*
+ * One call of kind k: through the arena when ar is set, else OpenBLAS.  y
+ * is the output of gemv and symv and x the one of trsv and trmv.  gemv's A
+ * is n x (n/2 + 1) before op(), so x and y differ in length.
+ */
+static void call(int k, char p, l2_arena *ar, enum CBLAS_ORDER o,
+                 enum CBLAS_UPLO u, enum CBLAS_TRANSPOSE t, int n,
+                 void *x, int incx, void *y, int incy) {
+    static const float  c_alpha[2] = {0.7f, -0.3f}, c_beta[2] = {0.4f, 0.2f};
+    static const double z_alpha[2] = {0.7, -0.3},   z_beta[2] = {0.4, 0.2};
+    const enum CBLAS_DIAG d = CblasNonUnit;
+    int m = n / 2 + 1;
+    int pi = p == 's' ? 0 : p == 'd' ? 1 : p == 'c' ? 2 : 3;
+
+    switch (k * 4 + pi) {
+    case K_GEMV * 4 + 0:
+        if (ar) l2_sgemv_arena(ar, o, t, n, m, 0.7f, sA, MAXN, x, incx, 0.4f, y, incy);
+        else cblas_sgemv(o, t, n, m, 0.7f, sA, MAXN, x, incx, 0.4f, y, incy);
+        break;
+    case K_GEMV * 4 + 1:
+        if (ar) l2_dgemv_arena(ar, o, t, n, m, 0.7, dA, MAXN, x, incx, 0.4, y, incy);
+        else cblas_dgemv(o, t, n, m, 0.7, dA, MAXN, x, incx, 0.4, y, incy);
+        break;
+    case K_GEMV * 4 + 2:
+        if (ar) l2_cgemv_arena(ar, o, t, n, m, c_alpha, sA, MAXN, x, incx, c_beta, y, incy);
+        else cblas_cgemv(o, t, n, m, c_alpha, sA, MAXN, x, incx, c_beta, y, incy);
+        break;
+    case K_GEMV * 4 + 3:
+        if (ar) l2_zgemv_arena(ar, o, t, n, m, z_alpha, dA, MAXN, x, incx, z_beta, y, incy);
+        else cblas_zgemv(o, t, n, m, z_alpha, dA, MAXN, x, incx, z_beta, y, incy);
+        break;
+    case K_SYMV * 4 + 0:
+        if (ar) l2_ssymv_arena(ar, o, u, n, 0.7f, sA, MAXN, x, incx, 0.4f, y, incy);
+        else cblas_ssymv(o, u, n, 0.7f, sA, MAXN, x, incx, 0.4f, y, incy);
+        break;
+    case K_SYMV * 4 + 1:
+        if (ar) l2_dsymv_arena(ar, o, u, n, 0.7, dA, MAXN, x, incx, 0.4, y, incy);
+        else cblas_dsymv(o, u, n, 0.7, dA, MAXN, x, incx, 0.4, y, incy);
+        break;
+    case K_SYMV * 4 + 2:
+        if (ar) l2_chemv_arena(ar, o, u, n, c_alpha, sA, MAXN, x, incx, c_beta, y, incy);
+        else cblas_chemv(o, u, n, c_alpha, sA, MAXN, x, incx, c_beta, y, incy);
+        break;
+    case K_SYMV * 4 + 3:
+        if (ar) l2_zhemv_arena(ar, o, u, n, z_alpha, dA, MAXN, x, incx, z_beta, y, incy);
+        else cblas_zhemv(o, u, n, z_alpha, dA, MAXN, x, incx, z_beta, y, incy);
+        break;
+    case K_TRSV * 4 + 0:
+        if (ar) l2_strsv_arena(ar, o, u, t, d, n, sA, MAXN, x, incx);
+        else cblas_strsv(o, u, t, d, n, sA, MAXN, x, incx);
+        break;
+    case K_TRSV * 4 + 1:
+        if (ar) l2_dtrsv_arena(ar, o, u, t, d, n, dA, MAXN, x, incx);
+        else cblas_dtrsv(o, u, t, d, n, dA, MAXN, x, incx);
+        break;
+    case K_TRSV * 4 + 2:
+        if (ar) l2_ctrsv_arena(ar, o, u, t, d, n, sA, MAXN, x, incx);
+        else cblas_ctrsv(o, u, t, d, n, sA, MAXN, x, incx);
+        break;
+    case K_TRSV * 4 + 3:
+        if (ar) l2_ztrsv_arena(ar, o, u, t, d, n, dA, MAXN, x, incx);
+        else cblas_ztrsv(o, u, t, d, n, dA, MAXN, x, incx);
+        break;
+    case K_TRMV * 4 + 0:
+        if (ar) l2_strmv_arena(ar, o, u, t, d, n, sA, MAXN, x, incx);
+        else cblas_strmv(o, u, t, d, n, sA, MAXN, x, incx);
+        break;
+    case K_TRMV * 4 + 1:
+        if (ar) l2_dtrmv_arena(ar, o, u, t, d, n, dA, MAXN, x, incx);
+        else cblas_dtrmv(o, u, t, d, n, dA, MAXN, x, incx);
+        break;
+    case K_TRMV * 4 + 2:
+        if (ar) l2_ctrmv_arena(ar, o, u, t, d, n, sA, MAXN, x, incx);
+        else cblas_ctrmv(o, u, t, d, n, sA, MAXN, x, incx);
+        break;
+    default:
+        if (ar) l2_ztrmv_arena(ar, o, u, t, d, n, dA, MAXN, x, incx);
+        else cblas_ztrmv(o, u, t, d, n, dA, MAXN, x, incx);
+        break;
+    }
+}
+
+/*
+ * The arena call against OpenBLAS on the same inputs.  The whole output
+ * buffer is compared, so a strided copy-back that writes between the
+ * elements shows up too.
+ */
+static int arena_case(int k, char p, l2_arena *ar, enum CBLAS_ORDER o,
+                      enum CBLAS_UPLO u, enum CBLAS_TRANSPOSE t, int n,
+                      int incx, int incy) {
+    int single = l2t_is_single(p);
+    int tri = k == K_TRSV || k == K_TRMV;
+    size_t nv = 2 * 3 * (size_t)MAXN;
+    double eps = single ? FLT_EPSILON : DBL_EPSILON;
+    double ymax = 0.0, tol;
+
+    /* trsv and trmv work on x in place: on a copy of it in y */
+    for (size_t i = 0; i < nv; i++) {
+        if (single) syref[i] = sy[i] = tri ? sx[i] : 0.5f * sx[i];
+        else        dyref[i] = dy[i] = tri ? dx[i] : 0.5 * dx[i];
+    }
+    if (single) {
+        call(k, p, ar, o, u, t, n, tri ? sy : sx, incx, sy, incy);
+        call(k, p, NULL, o, u, t, n, tri ? syref : sx, incx, syref, incy);
+    } else {
+        call(k, p, ar, o, u, t, n, tri ? dy : dx, incx, dy, incy);
+        call(k, p, NULL, o, u, t, n, tri ? dyref : dx, incx, dyref, incy);
+    }
+
+    for (size_t i = 0; i < nv; i++) {
+        double r = single ? syref[i] : dyref[i];
+        if (fabs(r) > ymax) ymax = fabs(r);
+    }
+    tol = 16.0 * (n + 2) * eps * (ymax + 1.0);
+    for (size_t i = 0; i < nv; i++) {
+        double got = single ? sy[i] : dy[i];
+        double ref = single ? syref[i] : dyref[i];
+        if (!(fabs(got - ref) <= tol)) return 0;
+    }
+    return 1;
+}
+
+static int arena_sweep(int k, char p, l2_arena *ar, enum CBLAS_ORDER o) {
+    static const enum CBLAS_TRANSPOSE transes[3] =
+        {CblasNoTrans, CblasTrans, CblasConjTrans};
+    int ok = 1;
+
+    for (int s = 0; s < NSIZES; s++)
+        for (int c = 0; c < NINCS; c++)
+            for (int u = 0; u < 2; u++)
+                for (int t = 0; t < 3; t++) {
+                    if (k == K_SYMV && t > 0) continue;
+                    ok &= arena_case(k, p, ar, o, u ? CblasLower : CblasUpper,
+                                     transes[t], sizes[s], incs[c][0],
+                                     incs[c][1]);
+                }
+    return ok;
+}
+
+L2T_CORE_TEST(test_arena_sweep) {
+    l2_arena big, small;
+    char msg[128];
+
+    l2_arena_init(&big, big_work, L2_ARENA_LWORK(MAXN));
+    l2_arena_init(&small, small_work, L2_ARENA_LWORK(100));
+    for (int k = 0; k < NKINDS; k++)
+        for (int p = 0; p < 4; p++)
+            for (int o = 0; o < 2; o++) {
+                enum CBLAS_ORDER ord = o ? CblasColMajor : CblasRowMajor;
+                int ok = arena_sweep(k, precs[p], &big, ord) &&
+                         arena_sweep(k, precs[p], &small, ord);
+
+                snprintf(msg, sizeof(msg),
+                         "%c %s arena[%s]: %s, staged and fallback match "
+                         "OpenBLAS", precs[p], kind_name[k], core,
+                         o ? "ColMajor" : "RowMajor");
+                CHECK(ok, msg);
+            }
+}
+
+/* No work at all, or none usable: every call takes the plain path. */
+L2T_TEST(test_arena_without_work) {
+    l2_arena none, tiny;
+    int ok = 1;
+
+    l2_arena_init(&none, NULL, 0);
+    l2_arena_init(&tiny, small_work, 100);
+    for (int k = 0; k < NKINDS; k++)
+        for (int p = 0; p < 4; p++) {
+            ok &= arena_case(k, precs[p], &none, CblasColMajor, CblasLower,
+                             CblasNoTrans, 257, 2, -3);
+            ok &= arena_case(k, precs[p], &tiny, CblasRowMajor, CblasUpper,
+                             CblasTrans, 17, -1, 2);
+        }
+    CHECK(ok, "arena with no usable work matches OpenBLAS");
+}
+
+/*
+ * The guarantee: once the arena exists (and so the pool's workers), no
+ * call of any arena routine allocates, on the caller or a worker, staged
+ * or not, threaded trsv and trmv panels included.
+ */
+L2T_TEST(test_arena_no_alloc) {
+    static const int cases[][3] = {{MAXN, 1, 1}, {MAXN, 2, -3},
+                                   {100, -1, 2}, {7, 3, 1}};
+    int saved = l2_get_num_threads();
+    void *volatile probe;
+    l2_arena ar;
+    long before;
+    int ok = 1;
+
+    if (l2t_alloc_count() < 0) {
+        l2t_skip("allocation counter needs glibc");
+        return;
+    }
+    before = l2t_alloc_count();
+    probe = malloc(64);     /* volatile: the pair is not optimised away */
+    free(probe);
+    CHECK(l2t_alloc_count() == before + 1, "allocation counter sees malloc");
+
+    l2_set_num_threads(4);
+    l2_arena_init(&ar, big_work, L2_ARENA_LWORK(MAXN));
+    memcpy(sy, sx, 2 * 3 * (size_t)MAXN * sizeof(float));
+    memcpy(dy, dx, 2 * 3 * (size_t)MAXN * sizeof(double));
+    before = l2t_alloc_count();
+    for (int k = 0; k < NKINDS; k++)
+        for (int p = 0; p < 4; p++)
+            for (int c = 0; c < 4; c++) {
+                int single = precs[p] == 's' || precs[p] == 'c';
+                void *x = single ? (void *)sy : (void *)dy;
+                void *y = single ? (void *)syref : (void *)dyref;
+
+                call(k, precs[p], &ar, CblasColMajor, CblasLower,
+                     CblasNoTrans, cases[c][0], x, cases[c][1], y,
+                     cases[c][2]);
+            }
+    ok = l2t_alloc_count() == before;
+    l2_set_num_threads(saved);
+    CHECK(ok, "l2_?xxx_arena: no heap allocation after l2_arena_init, "
+              "4 threads");
+}
@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Differential tests: the band l2blas routines (?gbmv, ?sbmv/?hbmv, ?tbmv,
+ * ?tbsv) against OpenBLAS for all four precisions, both orders and
+ * triangles, every trans/diag, square and rectangular shapes, padded lda,
+ * mixed and negative increments, and every kernel tier.  The band widths
+ * cover both the diagonal kernels (narrow, unit stride) and the
+ * column-by-column path.
+ */
+
+#define MAXN   257
+#define MAXM   (MAXN + 3)
+#define MAXBW  48
+#define MAXINC 3
+
+static const int sizes[] = {1, 2, 3, 5, 8, 17, 33, 100, 257};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+/* (kl, ku) for gbmv; sbmv and tbxv use k = ku. */
+static const int bands[][2] = {{0, 0}, {1, 1}, {0, 3}, {4, 1}, {16, 16},
+                               {7, 40}};
+#define NBANDS ((int)(sizeof(bands) / sizeof(bands[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 1}, {1, -1}, {-2, 3}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const char precs[] = {'s', 'd', 'c', 'z'};
+
+static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+static const enum CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+static const enum CBLAS_TRANSPOSE transes[3] =
+    {CblasNoTrans, CblasTrans, CblasConjTrans};
+
+/* Inputs as doubles; each case copies them to the precision under test. */
+#define ALEN (2 * (MAXBW + 2) * MAXM)
+#define VLEN (2 * (1 + (MAXM - 1) * MAXINC))
+static double da[ALEN], dx[VLEN], dy[VLEN];
+static double got_d[VLEN], ref_d[VLEN];
+static float  sa[ALEN], sx[VLEN], sy[VLEN];
+static float  got_s[VLEN], ref_s[VLEN];
+
+static unsigned rng = 2718u;
+
+/*
+ * Fills ncols band columns of lda entries with values of size 1/width;
+ * diag >= 0 is the band row holding the diagonal, which gets a dominant
+ * real value.  Entries outside the matrix are filled too: both libraries
+ * must ignore them.
+ */
+static void fill_band(char p, int lda, int ncols, int width, int diag) {
+    int cs = l2t_is_cplx(p) ? 2 : 1;
+    size_t len = (size_t)lda * ncols * cs;
+
+    for (size_t i = 0; i < len; i++) da[i] = l2t_rand(&rng) / width;
+    if (diag >= 0)
+        for (int j = 0; j < ncols; j++) {
+            size_t k = (size_t)j * lda + diag;
+            da[k * cs] = 2.0 + l2t_rand(&rng);
+            if (cs == 2) da[k * cs + 1] = 0.0;
+        }
+    for (size_t i = 0; i < len; i++) sa[i] = (float)da[i];
+}
+
+L2T_SETUP(fill_vectors) {
+    l2t_fill(&rng, dx, sx, VLEN);
+    l2t_fill(&rng, dy, sy, VLEN);
+    return 1;
+}
+
+/* got vs ref over len reals, relative to the largest reference value. */
+static int compare(char p, size_t len, int n) {
+    double eps = l2t_is_single(p) ? FLT_EPSILON : DBL_EPSILON, rmax = 0.0, tol;
+
+    for (size_t i = 0; i < len; i++) {
+        double r = l2t_is_single(p) ? ref_s[i] : ref_d[i];
+        if (fabs(r) > rmax) rmax = fabs(r);
+    }
+    tol = 16.0 * (n + 2) * eps * (rmax + 1.0);
+    for (size_t i = 0; i < len; i++) {
+        double g = l2t_is_single(p) ? got_s[i] : got_d[i];
+        double r = l2t_is_single(p) ? ref_s[i] : ref_d[i];
+        if (!(fabs(g - r) <= tol)) return 0;
+    }
+    return 1;
+}
+
+static size_t vec_len(char p, int n, int inc) {
+    return (size_t)(1 + (n - 1) * abs(inc)) * (l2t_is_cplx(p) ? 2 : 1);
+}
+
+static void start_from(const float *s, const double *d) {
+    memcpy(got_s, s, sizeof(sy)); memcpy(ref_s, s, sizeof(sy));
+    memcpy(got_d, d, sizeof(dy)); memcpy(ref_d, d, sizeof(dy));
+}
+
+/* y := alpha * op(A) * x + beta * y for an m x n band */
+static int gbmv_case(char p, enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t,
+                     int m, int n, int kl, int ku, int lda, int incx,
+                     int incy) {
+    const float  salpha[2] = {0.7f, -0.3f}, sbeta[2] = {-0.5f, 0.25f};
+    const double dalpha[2] = {0.7, -0.3},   dbeta[2] = {-0.5, 0.25};
+    size_t len = vec_len(p, t == CblasNoTrans ? m : n, incy);
+
+    start_from(sy, dy);
+    switch (p) {
+    case 's':
+        l2_sgbmv(o, t, m, n, kl, ku, salpha[0], sa, lda, sx, incx, sbeta[0],
+                 got_s, incy);
+        cblas_sgbmv(o, t, m, n, kl, ku, salpha[0], sa, lda, sx, incx,
+                    sbeta[0], ref_s, incy);
+        break;
+    case 'd':
+        l2_dgbmv(o, t, m, n, kl, ku, dalpha[0], da, lda, dx, incx, dbeta[0],
+                 got_d, incy);
+        cblas_dgbmv(o, t, m, n, kl, ku, dalpha[0], da, lda, dx, incx,
+                    dbeta[0], ref_d, incy);
+        break;
+    case 'c':
+        l2_cgbmv(o, t, m, n, kl, ku, salpha, sa, lda, sx, incx, sbeta,
+                 got_s, incy);
+        cblas_cgbmv(o, t, m, n, kl, ku, salpha, sa, lda, sx, incx, sbeta,
+                    ref_s, incy);
+        break;
+    default:
+        l2_zgbmv(o, t, m, n, kl, ku, dalpha, da, lda, dx, incx, dbeta,
+                 got_d, incy);
+        cblas_zgbmv(o, t, m, n, kl, ku, dalpha, da, lda, dx, incx, dbeta,
+                    ref_d, incy);
+        break;
+    }
+    return compare(p, len, kl + ku + 1);
+}
+
+/* y := alpha * A * x + beta * y, A symmetric (Hermitian) band */
+static int sbmv_case(char p, enum CBLAS_ORDER o, enum CBLAS_UPLO u, int n,
+                     int k, int lda, int incx, int incy) {
+    const float  salpha[2] = {0.7f, -0.3f}, sbeta[2] = {-0.5f, 0.25f};
+    const double dalpha[2] = {0.7, -0.3},   dbeta[2] = {-0.5, 0.25};
+    size_t len = vec_len(p, n, incy);
+
+    start_from(sy, dy);
+    switch (p) {
+    case 's':
+        l2_ssbmv(o, u, n, k, salpha[0], sa, lda, sx, incx, sbeta[0], got_s,
+                 incy);
+        cblas_ssbmv(o, u, n, k, salpha[0], sa, lda, sx, incx, sbeta[0],
+                    ref_s, incy);
+        break;
+    case 'd':
+        l2_dsbmv(o, u, n, k, dalpha[0], da, lda, dx, incx, dbeta[0], got_d,
+                 incy);
+        cblas_dsbmv(o, u, n, k, dalpha[0], da, lda, dx, incx, dbeta[0],
+                    ref_d, incy);
+        break;
+    case 'c':
+        l2_chbmv(o, u, n, k, salpha, sa, lda, sx, incx, sbeta, got_s, incy);
+        cblas_chbmv(o, u, n, k, salpha, sa, lda, sx, incx, sbeta, ref_s,
+                    incy);
+        break;
+    default:
+        l2_zhbmv(o, u, n, k, dalpha, da, lda, dx, incx, dbeta, got_d, incy);
+        cblas_zhbmv(o, u, n, k, dalpha, da, lda, dx, incx, dbeta, ref_d,
+                    incy);
+        break;
+    }
+    return compare(p, len, 2 * k + 1);
+}
+
+/* x := op(A) * x, or x := op(A)^-1 * x when solve is set */
+static int tbxv_case(char p, int solve, enum CBLAS_ORDER o,
+                     enum CBLAS_UPLO u, enum CBLAS_TRANSPOSE t,
+                     enum CBLAS_DIAG d, int n, int k, int lda, int incx) {
+    size_t len = vec_len(p, n, incx);
+
+    start_from(sx, dx);
+    switch (p) {
+    case 's':
+        if (solve) {
+            l2_stbsv(o, u, t, d, n, k, sa, lda, got_s, incx);
+            cblas_stbsv(o, u, t, d, n, k, sa, lda, ref_s, incx);
+        } else {
+            l2_stbmv(o, u, t, d, n, k, sa, lda, got_s, incx);
+            cblas_stbmv(o, u, t, d, n, k, sa, lda, ref_s, incx);
+        }
+        break;
+    case 'd':
+        if (solve) {
+            l2_dtbsv(o, u, t, d, n, k, da, lda, got_d, incx);
+            cblas_dtbsv(o, u, t, d, n, k, da, lda, ref_d, incx);
+        } else {
+            l2_dtbmv(o, u, t, d, n, k, da, lda, got_d, incx);
+            cblas_dtbmv(o, u, t, d, n, k, da, lda, ref_d, incx);
+        }
+        break;
+    case 'c':
+        if (solve) {
+            l2_ctbsv(o, u, t, d, n, k, sa, lda, got_s, incx);
+            cblas_ctbsv(o, u, t, d, n, k, sa, lda, ref_s, incx);
+        } else {
+            l2_ctbmv(o, u, t, d, n, k, sa, lda, got_s, incx);
+            cblas_ctbmv(o, u, t, d, n, k, sa, lda, ref_s, incx);
+        }
+        break;
+    default:
+        if (solve) {
+            l2_ztbsv(o, u, t, d, n, k, da, lda, got_d, incx);
+            cblas_ztbsv(o, u, t, d, n, k, da, lda, ref_d, incx);
+        } else {
+            l2_ztbmv(o, u, t, d, n, k, da, lda, got_d, incx);
+            cblas_ztbmv(o, u, t, d, n, k, da, lda, ref_d, incx);
+        }
+        break;
+    }
+    return compare(p, len, n);
+}
+
+enum { GBMV, SBMV, TBMV, TBSV, NROUTINES };
+
+static const char *routine_name[2][NROUTINES] = {
+    {"gbmv", "sbmv", "tbmv", "tbsv"},
+    {"gbmv", "hbmv", "tbmv", "tbsv"},
+};
+
+/* m x n shapes for gbmv: square, tall, wide. */
+static int gbmv_rows(int shape, int n) {
+    return shape == 0 ? n : shape == 1 ? n + 3 : n / 2 + 1;
+}
+
+static int gbmv_sweep(char p) {
+    int ok = 1;
+
+    for (int oi = 0; oi < 2; oi++)
+        for (int s = 0; s < NSIZES; s++)
+            for (int sh = 0; sh < 3; sh++)
+                for (int b = 0; b < NBANDS; b++)
+                    for (int pad = 0; pad < 2; pad++) {
+                        int n = sizes[s], m = gbmv_rows(sh, n);
+                        int kl = bands[b][0], ku = bands[b][1];
+                        int lda = kl + ku + 1 + pad;
+                        /* RowMajor bands are stored by rows. */
+                        int ncols = orders[oi] == CblasColMajor ? n : m;
+
+                        fill_band(p, lda, ncols, kl + ku + 1, -1);
+                        for (int t = 0; t < 3; t++)
+                            for (int c = 0; c < NINCS; c++)
+                                ok &= gbmv_case(p, orders[oi], transes[t], m,
+                                                n, kl, ku, lda, incs[c][0],
+                                                incs[c][1]);
+                    }
+    return ok;
+}
+
+/* Every order, triangle, size, band width and increment for one routine. */
+static int sweep(char p, int r) {
+    static const enum CBLAS_DIAG diags[2] = {CblasNonUnit, CblasUnit};
+    int ok = 1;
+
+    if (r == GBMV) return gbmv_sweep(p);
+    for (int oi = 0; oi < 2; oi++)
+        for (int ui = 0; ui < 2; ui++)
+            for (int s = 0; s < NSIZES; s++)
+                for (int b = 0; b < NBANDS; b++)
+                    for (int pad = 0; pad < 2; pad++) {
+                        int n = sizes[s], k = bands[b][1], lda = k + 1 + pad;
+                        /* RowMajor Upper is laid out like ColMajor Lower. */
+                        int lower = (uplos[ui] == CblasLower) ==
+                                    (orders[oi] == CblasColMajor);
+
+                        fill_band(p, lda, n, k + 1, lower ? 0 : k);
+                        for (int c = 0; c < NINCS; c++) {
+                            int incx = incs[c][0], incy = incs[c][1];
+
+                            if (r == SBMV) {
+                                ok &= sbmv_case(p, orders[oi], uplos[ui], n, k,
+                                                lda, incx, incy);
+                                continue;
+                            }
+                            for (int t = 0; t < 3; t++)
+                                for (int d = 0; d < 2; d++)
+                                    ok &= tbxv_case(p, r == TBSV, orders[oi],
+                                                    uplos[ui], transes[t],
+                                                    diags[d], n, k, lda, incx);
+                        }
+                    }
+    return ok;
+}
+
+L2T_CORE_TEST(test_band_sweep) {
+    char msg[128];
+
+    for (int p = 0; p < 4; p++)
+        for (int r = 0; r < NROUTINES; r++) {
+            int ok = sweep(precs[p], r);
+            snprintf(msg, sizeof(msg),
+                     "l2_%c%s[%s]: all orders/uplos/bands/increments match OpenBLAS",
+                     precs[p], routine_name[l2t_is_cplx(precs[p])][r], core);
+            CHECK(ok, msg);
+        }
+}
@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Differential tests: l2_cgemv/l2_zgemv and l2_chemv/l2_zhemv against
+ * OpenBLAS for every kernel tier the CPU supports.  Sizes hit each
+ * split-complex vector tail and go past the row tile of the split kernels
+ * (2048 complex floats, 1024 complex doubles).  The tolerance is scaled by
+ * k*eps times the same product on |re|+|im| of every input.  For hemv the
+ * unreferenced triangle and the diagonal imaginary parts hold unrelated
+ * values, so reading them shows up as a mismatch.
+ */
+
+#define MAXN 2100
+
+static const int sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33,
+                            64, 100, 257, 530, 1030, 2100};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 3}, {-1, -2}, {1, -1}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+static const enum CBLAS_TRANSPOSE transes[4] =
+    {CblasNoTrans, CblasTrans, CblasConjTrans, CblasConjNoTrans};
+static const enum CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+static const char *order_name[2] = {"RowMajor", "ColMajor"};
+static const char *trans_name[4] =
+    {"NoTrans", "Trans", "ConjTrans", "ConjNoTrans"};
+static const char *uplo_name[2] = {"Upper", "Lower"};
+
+/* Complex arrays, interleaved; the *abs arrays hold |re|+|im| as reals. */
+static float  *cA, *cAabs, *cx, *cxabs, *cy0, *cyabs, *cy, *cyref, *cbound;
+static double *zA, *zAabs, *zx, *zxabs, *zy0, *zyabs, *zy, *zyref, *zbound;
+
+static unsigned rng = 777u;
+
+/* Fills n complex elements of d/s and their abs1 copies (zero imag). */
+static void fill(size_t n, double *d, double *dabs, float *s, float *sabs) {
+    l2t_fill(&rng, d, s, 2 * n);
+    for (size_t i = 0; i < n; i++) {
+        dabs[2 * i] = fabs(d[2 * i]) + fabs(d[2 * i + 1]);
+        dabs[2 * i + 1] = 0.0;
+        sabs[2 * i] = fabsf(s[2 * i]) + fabsf(s[2 * i + 1]);
+        sabs[2 * i + 1] = 0.0f;
+    }
+}
+
+L2T_SETUP(alloc_inputs) {
+    size_t na = 2 * (size_t)MAXN * MAXN, nv = 2 * 3 * (size_t)MAXN;
+
+    if (!l2t_alloc_sd(na, &zA, &cA) || !l2t_alloc_sd(na, &zAabs, &cAabs) ||
+        !l2t_alloc_sd(nv, &zx, &cx) || !l2t_alloc_sd(nv, &zxabs, &cxabs) ||
+        !l2t_alloc_sd(nv, &zy0, &cy0) || !l2t_alloc_sd(nv, &zyabs, &cyabs) ||
+        !l2t_alloc_sd(nv, &zy, &cy) || !l2t_alloc_sd(nv, &zyref, &cyref) ||
+        !l2t_alloc_sd(nv, &zbound, &cbound))
+        return 0;
+
+    fill(na / 2, zA, zAabs, cA, cAabs);
+    fill(nv / 2, zx, zxabs, cx, cxabs);
+    fill(nv / 2, zy0, zyabs, cy0, cyabs);
+    return 1;
+}
+
+static const float  c_alpha[2] = {0.7f, -0.4f}, c_beta[2] = {-1.3f, 0.2f};
+static const double z_alpha[2] = {0.7, -0.4},   z_beta[2] = {-1.3, 0.2};
+static const float  c_alpha_abs[2] = {1.1f, 0.0f}, c_beta_abs[2] = {1.5f, 0.0f};
+static const double z_alpha_abs[2] = {1.1, 0.0},   z_beta_abs[2] = {1.5, 0.0};
+
+static int c_close(size_t ylen, int k) {
+    for (size_t i = 0; i < ylen; i++) {
+        float tol = 8.0f * (float)(k + 2) * FLT_EPSILON * cbound[2 * i];
+        if (!(fabsf(cy[2 * i] - cyref[2 * i]) <= tol) ||
+            !(fabsf(cy[2 * i + 1] - cyref[2 * i + 1]) <= tol))
+            return 0;
+    }
+    return 1;
+}
+
+static int z_close(size_t ylen, int k) {
+    for (size_t i = 0; i < ylen; i++) {
+        double tol = 8.0 * (double)(k + 2) * DBL_EPSILON * zbound[2 * i];
+        if (!(fabs(zy[2 * i] - zyref[2 * i]) <= tol) ||
+            !(fabs(zy[2 * i + 1] - zyref[2 * i + 1]) <= tol))
+            return 0;
+    }
+    return 1;
+}
+
+static int cgemv_case(enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t,
+                      int m, int n, int incx, int incy) {
+    int plain = t == CblasNoTrans || t == CblasConjNoTrans;
+    int lda = o == CblasRowMajor ? n : m;
+    int leny = plain ? m : n, k = plain ? n : m;
+    size_t ylen = (size_t)leny * (size_t)abs(incy);
+
+    memcpy(cy, cy0, 2 * ylen * sizeof(float));
+    memcpy(cyref, cy0, 2 * ylen * sizeof(float));
+    memcpy(cbound, cyabs, 2 * ylen * sizeof(float));
+
+    l2_cgemv(o, t, m, n, c_alpha, cA, lda, cx, incx, c_beta, cy, incy);
+    cblas_cgemv(o, t, m, n, c_alpha, cA, lda, cx, incx, c_beta, cyref, incy);
+    cblas_cgemv(o, plain ? CblasNoTrans : CblasTrans, m, n, c_alpha_abs,
+                cAabs, lda, cxabs, incx, c_beta_abs, cbound, incy);
+    return c_close(ylen, k);
+}
+
+static int zgemv_case(enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t,
+                      int m, int n, int incx, int incy) {
+    int plain = t == CblasNoTrans || t == CblasConjNoTrans;
+    int lda = o == CblasRowMajor ? n : m;
+    int leny = plain ? m : n, k = plain ? n : m;
+    size_t ylen = (size_t)leny * (size_t)abs(incy);
+
+    memcpy(zy, zy0, 2 * ylen * sizeof(double));
+    memcpy(zyref, zy0, 2 * ylen * sizeof(double));
+    memcpy(zbound, zyabs, 2 * ylen * sizeof(double));
+
+    l2_zgemv(o, t, m, n, z_alpha, zA, lda, zx, incx, z_beta, zy, incy);
+    cblas_zgemv(o, t, m, n, z_alpha, zA, lda, zx, incx, z_beta, zyref, incy);
+    cblas_zgemv(o, plain ? CblasNoTrans : CblasTrans, m, n, z_alpha_abs,
+                zAabs, lda, zxabs, incx, z_beta_abs, zbound, incy);
+    return z_close(ylen, k);
+}
+
+static int chemv_case(enum CBLAS_ORDER o, enum CBLAS_UPLO u, int n,
+                      int incx, int incy) {
+    size_t ylen = (size_t)n * (size_t)abs(incy);
+
+    memcpy(cy, cy0, 2 * ylen * sizeof(float));
+    memcpy(cyref, cy0, 2 * ylen * sizeof(float));
+    memcpy(cbound, cyabs, 2 * ylen * sizeof(float));
+
+    l2_chemv(o, u, n, c_alpha, cA, n, cx, incx, c_beta, cy, incy);
+    cblas_chemv(o, u, n, c_alpha, cA, n, cx, incx, c_beta, cyref, incy);
+    cblas_chemv(o, u, n, c_alpha_abs, cAabs, n, cxabs, incx, c_beta_abs,
+                cbound, incy);
+    return c_close(ylen, n);
+}
+
+static int zhemv_case(enum CBLAS_ORDER o, enum CBLAS_UPLO u, int n,
+                      int incx, int incy) {
+    size_t ylen = (size_t)n * (size_t)abs(incy);
+
+    memcpy(zy, zy0, 2 * ylen * sizeof(double));
+    memcpy(zyref, zy0, 2 * ylen * sizeof(double));
+    memcpy(zbound, zyabs, 2 * ylen * sizeof(double));
+
+    l2_zhemv(o, u, n, z_alpha, zA, n, zx, incx, z_beta, zy, incy);
+    cblas_zhemv(o, u, n, z_alpha, zA, n, zx, incx, z_beta, zyref, incy);
+    cblas_zhemv(o, u, n, z_alpha_abs, zAabs, n, zxabs, incx, z_beta_abs,
+                zbound, incy);
+    return z_close(ylen, n);
+}
+
+L2T_CORE_TEST(test_cgemv_sweep) {
+    char msg[128];
+
+    for (int oi = 0; oi < 2; oi++) {
+        for (int ti = 0; ti < 4; ti++) {
+            int cok = 1, zok = 1;
+            for (int a = 0; a < NSIZES; a++)
+                for (int b = 0; b < NSIZES; b++)
+                    for (int c = 0; c < NINCS; c++) {
+                        int big = sizes[a] > 257 || sizes[b] > 257;
+                        int small = sizes[a] <= 64 || sizes[b] <= 64;
+                        /* past 257 only against a side of 257 or less,
+                         * strided only against 64 or less */
+                        if (big && (sizes[a] > 257) == (sizes[b] > 257))
+                            continue;
+                        if (big && c > 0 && !small) continue;
+                        cok &= cgemv_case(orders[oi], transes[ti], sizes[a],
+                                          sizes[b], incs[c][0], incs[c][1]);
+                        zok &= zgemv_case(orders[oi], transes[ti], sizes[a],
+                                          sizes[b], incs[c][0], incs[c][1]);
+                    }
+            snprintf(msg, sizeof(msg), "l2_cgemv[%s]: %s %s matches OpenBLAS",
+                     core, order_name[oi], trans_name[ti]);
+            CHECK(cok, msg);
+            snprintf(msg, sizeof(msg), "l2_zgemv[%s]: %s %s matches OpenBLAS",
+                     core, order_name[oi], trans_name[ti]);
+            CHECK(zok, msg);
+        }
+    }
+}
+
+L2T_CORE_TEST(test_hemv_sweep) {
+    char msg[128];
+
+    for (int oi = 0; oi < 2; oi++) {
+        for (int ui = 0; ui < 2; ui++) {
+            int cok = 1, zok = 1;
+            for (int a = 0; a < NSIZES; a++)
+                for (int c = 0; c < NINCS; c++) {
+                    if (sizes[a] > 257 && c > 1) continue;
+                    cok &= chemv_case(orders[oi], uplos[ui], sizes[a],
+                                      incs[c][0], incs[c][1]);
+                    zok &= zhemv_case(orders[oi], uplos[ui], sizes[a],
+                                      incs[c][0], incs[c][1]);
+                }
+            snprintf(msg, sizeof(msg), "l2_chemv[%s]: %s %s matches OpenBLAS",
+                     core, order_name[oi], uplo_name[ui]);
+            CHECK(cok, msg);
+            snprintf(msg, sizeof(msg), "l2_zhemv[%s]: %s %s matches OpenBLAS",
+                     core, order_name[oi], uplo_name[ui]);
+            CHECK(zok, msg);
+        }
+    }
+}
+
+/* Large calls with several threads, strided too: every slot has y tiles. */
+L2T_TEST(test_hemv_threads) {
+    static const int big[2] = {1030, 2100};
+    int saved = l2_get_num_threads();
+    int cok = 1, zok = 1;
+
+    l2_set_num_threads(4);
+    for (int o = 0; o < 2; o++)
+        for (int u = 0; u < 2; u++)
+            for (int b = 0; b < 2; b++)
+                for (int c = 0; c < 2; c++) {
+                    cok &= chemv_case(orders[o], uplos[u], big[b],
+                                      incs[c][0], incs[c][1]);
+                    zok &= zhemv_case(orders[o], uplos[u], big[b],
+                                      incs[c][0], incs[c][1]);
+                }
+    l2_set_num_threads(saved);
+    CHECK(cok, "l2_chemv: large calls with 4 threads match OpenBLAS");
+    CHECK(zok, "l2_zhemv: large calls with 4 threads match OpenBLAS");
+}
+
+L2T_CORE_TEST(test_hemv_beta_zero_ignores_nan) {
+    /* [[2, 1-i], [1+i, 3]], Upper stored; diagonal imaginary parts junk */
+    double A[8] = {2.0, 9.0, 1.0, -1.0, NAN, NAN, 3.0, -9.0};
+    double x[4] = {1.0, 0.0, 0.0, 1.0};
+    double y[4] = {NAN, NAN, NAN, NAN};
+    double alpha[2] = {1.0, 0.0}, beta[2] = {0.0, 0.0};
+    char msg[128];
+
+    l2_zhemv(CblasRowMajor, CblasUpper, 2, alpha, A, 2, x, 1, beta, y, 1);
+
+    /* y = [2 + (1-i)i, (1+i) + 3i] = [3 + i, 1 + 4i] */
+    snprintf(msg, sizeof(msg), "l2_zhemv[%s]: beta=0 overwrites NaN in y",
+             core);
+    CHECK(fabs(y[0] - 3.0) < 1e-12 && fabs(y[1] - 1.0) < 1e-12 &&
+          fabs(y[2] - 1.0) < 1e-12 && fabs(y[3] - 4.0) < 1e-12, msg);
+}
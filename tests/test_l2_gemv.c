@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Differential tests: l2_sgemv/l2_dgemv against OpenBLAS for every kernel
+ * tier the CPU supports, across sizes that hit each vector-width tail.
+ * The tolerance is scaled by n*eps times |alpha|*|A|*|x| + |beta|*|y|.
+ */
+
+#define MAXN 257
+
+static const int sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33,
+                            63, 64, 65, 100, 257};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 3}, {-1, -2}, {1, -1}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+static const enum CBLAS_TRANSPOSE transes[3] =
+    {CblasNoTrans, CblasTrans, CblasConjTrans};
+static const char *order_name[2] = {"RowMajor", "ColMajor"};
+static const char *trans_name[3] = {"NoTrans", "Trans", "ConjTrans"};
+
+static float  sA[MAXN * MAXN], sAabs[MAXN * MAXN];
+static float  sx[3 * MAXN], sxabs[3 * MAXN], sy0[3 * MAXN], syabs[3 * MAXN];
+static float  sy[3 * MAXN], syref[3 * MAXN], sbound[3 * MAXN];
+static double dA[MAXN * MAXN], dAabs[MAXN * MAXN];
+static double dx[3 * MAXN], dxabs[3 * MAXN], dy0[3 * MAXN], dyabs[3 * MAXN];
+static double dy[3 * MAXN], dyref[3 * MAXN], dbound[3 * MAXN];
+
+static unsigned rng = 12345u;
+
+L2T_SETUP(fill_inputs) {
+    l2t_fill(&rng, dA, sA, MAXN * MAXN);
+    l2t_fill(&rng, dx, sx, 3 * MAXN);
+    l2t_fill(&rng, dy0, sy0, 3 * MAXN);
+    for (int i = 0; i < MAXN * MAXN; i++) {
+        dAabs[i] = fabs(dA[i]);
+        sAabs[i] = fabsf(sA[i]);
+    }
+    for (int i = 0; i < 3 * MAXN; i++) {
+        dxabs[i] = fabs(dx[i]);
+        sxabs[i] = fabsf(sx[i]);
+        dyabs[i] = fabs(dy0[i]);
+        syabs[i] = fabsf(sy0[i]);
+    }
+    return 1;
+}
+
+static int sgemv_case(enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t,
+                      int m, int n, int incx, int incy) {
+    const float alpha = 0.7f, beta = -1.3f;
+    int lda = o == CblasRowMajor ? n : m;
+    int leny = t == CblasNoTrans ? m : n;
+    int k = t == CblasNoTrans ? n : m;
+    size_t ylen = (size_t)leny * (size_t)abs(incy);
+
+    memcpy(sy, sy0, ylen * sizeof(float));
+    memcpy(syref, sy0, ylen * sizeof(float));
+    memcpy(sbound, syabs, ylen * sizeof(float));
+
+    l2_sgemv(o, t, m, n, alpha, sA, lda, sx, incx, beta, sy, incy);
+    cblas_sgemv(o, t, m, n, alpha, sA, lda, sx, incx, beta, syref, incy);
+    cblas_sgemv(o, t, m, n, fabsf(alpha), sAabs, lda, sxabs, incx,
+                fabsf(beta), sbound, incy);
+
+    for (size_t i = 0; i < ylen; i++) {
+        float tol = 4.0f * (float)(k + 2) * FLT_EPSILON * sbound[i];
+        if (!(fabsf(sy[i] - syref[i]) <= tol)) return 0;
+    }
+    return 1;
+}
+
+static int dgemv_case(enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t,
+                      int m, int n, int incx, int incy) {
+    const double alpha = 0.7, beta = -1.3;
+    int lda = o == CblasRowMajor ? n : m;
+    int leny = t == CblasNoTrans ? m : n;
+    int k = t == CblasNoTrans ? n : m;
+    size_t ylen = (size_t)leny * (size_t)abs(incy);
+
+    memcpy(dy, dy0, ylen * sizeof(double));
+    memcpy(dyref, dy0, ylen * sizeof(double));
+    memcpy(dbound, dyabs, ylen * sizeof(double));
+
+    l2_dgemv(o, t, m, n, alpha, dA, lda, dx, incx, beta, dy, incy);
+    cblas_dgemv(o, t, m, n, alpha, dA, lda, dx, incx, beta, dyref, incy);
+    cblas_dgemv(o, t, m, n, fabs(alpha), dAabs, lda, dxabs, incx,
+                fabs(beta), dbound, incy);
+
+    for (size_t i = 0; i < ylen; i++) {
+        double tol = 4.0 * (double)(k + 2) * DBL_EPSILON * dbound[i];
+        if (!(fabs(dy[i] - dyref[i]) <= tol)) return 0;
+    }
+    return 1;
+}
+
+L2T_CORE_TEST(test_gemv_sweep) {
+    char msg[128];
+
+    for (int oi = 0; oi < 2; oi++) {
+        for (int ti = 0; ti < 3; ti++) {
+            int sok = 1, dok = 1;
+            for (int a = 0; a < NSIZES; a++)
+                for (int b = 0; b < NSIZES; b++)
+                    for (int c = 0; c < NINCS; c++) {
+                        sok &= sgemv_case(orders[oi], transes[ti], sizes[a],
+                                          sizes[b], incs[c][0], incs[c][1]);
+                        dok &= dgemv_case(orders[oi], transes[ti], sizes[a],
+                                          sizes[b], incs[c][0], incs[c][1]);
+                    }
+            snprintf(msg, sizeof(msg), "l2_sgemv[%s]: %s %s matches OpenBLAS",
+                     core, order_name[oi], trans_name[ti]);
+            CHECK(sok, msg);
+            snprintf(msg, sizeof(msg), "l2_dgemv[%s]: %s %s matches OpenBLAS",
+                     core, order_name[oi], trans_name[ti]);
+            CHECK(dok, msg);
+        }
+    }
+}
+
+L2T_CORE_TEST(test_gemv_beta_zero_ignores_nan) {
+    float A[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    float x[2] = {1.0f, 1.0f};
+    float y[2] = {NAN, NAN};
+    char msg[128];
+
+    l2_sgemv(CblasRowMajor, CblasNoTrans, 2, 2, 1.0f, A, 2, x, 1, 0.0f, y, 1);
+
+    snprintf(msg, sizeof(msg), "l2_sgemv[%s]: beta=0 overwrites NaN in y", core);
+    CHECK(fabsf(y[0] - 3.0f) < 1e-5f && fabsf(y[1] - 7.0f) < 1e-5f, msg);
+}
+
+L2T_CORE_TEST(test_gemv_alpha_zero) {
+    double A[4] = {NAN, NAN, NAN, NAN};
+    double x[2] = {1.0, 1.0};
+    double y[2] = {1.0, 2.0};
+    char msg[128];
+
+    l2_dgemv(CblasColMajor, CblasTrans, 2, 2, 0.0, A, 2, x, 1, 2.0, y, 1);
+
+    snprintf(msg, sizeof(msg), "l2_dgemv[%s]: alpha=0 only scales y", core);
+    CHECK(fabs(y[0] - 2.0) < 1e-10 && fabs(y[1] - 4.0) < 1e-10, msg);
+}
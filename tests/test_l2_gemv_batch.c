@@ -0,0 +1,518 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Batched gemv tests.  The first block replays the hand-checked cases of
+ * test_gemv.c as batches of identical problems, through both the strided
+ * and the grouped entry points.  The second runs large mixed batches
+ * against a loop of single OpenBLAS calls at several thread counts.
+ */
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+/* Copies of each hand-checked problem in one batch. */
+#define NCOPY 5
+/* Largest operand of the hand-checked problems, in reals. */
+#define MAXLEN 16
+
+static int vec_len(int len, int inc) {
+    return 1 + (len - 1) * abs(inc);
+}
+
+/*
+ * Runs one real problem NCOPY times through the strided form, then through
+ * the grouped form (two groups), and checks every copy of y against expect.
+ */
+static void sgemv_batch_case(const char *msg, enum CBLAS_ORDER o,
+                             enum CBLAS_TRANSPOSE t, int m, int n, float alpha,
+                             const float *A, int lda, const float *x, int incx,
+                             float beta, const float *y, int incy,
+                             const float *expect) {
+    int alen = (o == CblasRowMajor ? m : n) * lda;
+    int xlen = vec_len(t == CblasNoTrans ? n : m, incx);
+    int ylen = vec_len(t == CblasNoTrans ? m : n, incy);
+    float Ab[NCOPY * MAXLEN], xb[NCOPY * MAXLEN], yb[NCOPY * MAXLEN];
+    const float *ap[NCOPY], *xp[NCOPY];
+    float *yp[NCOPY];
+    enum CBLAS_TRANSPOSE tg[2] = {t, t};
+    blasint mg[2] = {m, m}, ng[2] = {n, n}, ldg[2] = {lda, lda};
+    blasint ixg[2] = {incx, incx}, iyg[2] = {incy, incy};
+    blasint size[2] = {2, NCOPY - 2};
+    float ag[2] = {alpha, alpha}, bg[2] = {beta, beta};
+    char name[128];
+
+    for (int form = 0; form < 2; form++) {
+        int ok = 1;
+
+        for (int c = 0; c < NCOPY; c++) {
+            memcpy(Ab + c * alen, A, alen * sizeof(float));
+            memcpy(xb + c * xlen, x, xlen * sizeof(float));
+            memcpy(yb + c * ylen, y, ylen * sizeof(float));
+            ap[c] = Ab + c * alen;
+            xp[c] = xb + c * xlen;
+            yp[c] = yb + c * ylen;
+        }
+        if (form == 0)
+            l2_sgemv_batch_strided(o, t, m, n, alpha, Ab, lda, alen,
+                                   xb, incx, xlen, beta, yb, incy, ylen, NCOPY);
+        else
+            l2_sgemv_batch(o, tg, mg, ng, ag, ap, ldg, xp, ixg, bg, yp, iyg,
+                           2, size);
+
+        for (int c = 0; c < NCOPY; c++)
+            for (int i = 0; i < ylen; i++)
+                if (fabsf(yb[c * ylen + i] - expect[i]) >= TOL_FLOAT) ok = 0;
+        snprintf(name, sizeof(name), "sgemv_batch %s: %s",
+                 form == 0 ? "strided" : "grouped", msg);
+        CHECK(ok, name);
+    }
+}
+
+static void dgemv_batch_case(const char *msg, enum CBLAS_ORDER o,
+                             enum CBLAS_TRANSPOSE t, int m, int n, double alpha,
+                             const double *A, int lda, const double *x,
+                             int incx, double beta, const double *y, int incy,
+                             const double *expect) {
+    int alen = (o == CblasRowMajor ? m : n) * lda;
+    int xlen = vec_len(t == CblasNoTrans ? n : m, incx);
+    int ylen = vec_len(t == CblasNoTrans ? m : n, incy);
+    double Ab[NCOPY * MAXLEN], xb[NCOPY * MAXLEN], yb[NCOPY * MAXLEN];
+    const double *ap[NCOPY], *xp[NCOPY];
+    double *yp[NCOPY];
+    enum CBLAS_TRANSPOSE tg[2] = {t, t};
+    blasint mg[2] = {m, m}, ng[2] = {n, n}, ldg[2] = {lda, lda};
+    blasint ixg[2] = {incx, incx}, iyg[2] = {incy, incy};
+    blasint size[2] = {2, NCOPY - 2};
+    double ag[2] = {alpha, alpha}, bg[2] = {beta, beta};
+    char name[128];
+
+    for (int form = 0; form < 2; form++) {
+        int ok = 1;
+
+        for (int c = 0; c < NCOPY; c++) {
+            memcpy(Ab + c * alen, A, alen * sizeof(double));
+            memcpy(xb + c * xlen, x, xlen * sizeof(double));
+            memcpy(yb + c * ylen, y, ylen * sizeof(double));
+            ap[c] = Ab + c * alen;
+            xp[c] = xb + c * xlen;
+            yp[c] = yb + c * ylen;
+        }
+        if (form == 0)
+            l2_dgemv_batch_strided(o, t, m, n, alpha, Ab, lda, alen,
+                                   xb, incx, xlen, beta, yb, incy, ylen, NCOPY);
+        else
+            l2_dgemv_batch(o, tg, mg, ng, ag, ap, ldg, xp, ixg, bg, yp, iyg,
+                           2, size);
+
+        for (int c = 0; c < NCOPY; c++)
+            for (int i = 0; i < ylen; i++)
+                if (fabs(yb[c * ylen + i] - expect[i]) >= TOL_DOUBLE) ok = 0;
+        snprintf(name, sizeof(name), "dgemv_batch %s: %s",
+                 form == 0 ? "strided" : "grouped", msg);
+        CHECK(ok, name);
+    }
+}
+
+/* Complex variant; lengths count complex elements, buffers hold reals. */
+static void cgemv_batch_case(const char *msg, enum CBLAS_ORDER o,
+                             enum CBLAS_TRANSPOSE t, int m, int n,
+                             const float *alpha, const float *A, int lda,
+                             const float *x, int incx, const float *beta,
+                             const float *y, int incy, const float *expect) {
+    int alen = (o == CblasRowMajor ? m : n) * lda;
+    int xlen = vec_len(t == CblasNoTrans ? n : m, incx);
+    int ylen = vec_len(t == CblasNoTrans ? m : n, incy);
+    float Ab[NCOPY * MAXLEN], xb[NCOPY * MAXLEN], yb[NCOPY * MAXLEN];
+    const void *ap[NCOPY], *xp[NCOPY];
+    void *yp[NCOPY];
+    enum CBLAS_TRANSPOSE tg[2] = {t, t};
+    blasint mg[2] = {m, m}, ng[2] = {n, n}, ldg[2] = {lda, lda};
+    blasint ixg[2] = {incx, incx}, iyg[2] = {incy, incy};
+    blasint size[2] = {2, NCOPY - 2};
+    float ag[4] = {alpha[0], alpha[1], alpha[0], alpha[1]};
+    float bg[4] = {beta[0], beta[1], beta[0], beta[1]};
+    char name[128];
+
+    for (int form = 0; form < 2; form++) {
+        int ok = 1;
+
+        for (int c = 0; c < NCOPY; c++) {
+            memcpy(Ab + 2 * c * alen, A, 2 * alen * sizeof(float));
+            memcpy(xb + 2 * c * xlen, x, 2 * xlen * sizeof(float));
+            memcpy(yb + 2 * c * ylen, y, 2 * ylen * sizeof(float));
+            ap[c] = Ab + 2 * c * alen;
+            xp[c] = xb + 2 * c * xlen;
+            yp[c] = yb + 2 * c * ylen;
+        }
+        if (form == 0)
+            l2_cgemv_batch_strided(o, t, m, n, alpha, Ab, lda, alen,
+                                   xb, incx, xlen, beta, yb, incy, ylen, NCOPY);
+        else
+            l2_cgemv_batch(o, tg, mg, ng, ag, ap, ldg, xp, ixg, bg, yp, iyg,
+                           2, size);
+
+        for (int c = 0; c < NCOPY; c++)
+            for (int i = 0; i < 2 * ylen; i++)
+                if (fabsf(yb[2 * c * ylen + i] - expect[i]) >= TOL_FLOAT) ok = 0;
+        snprintf(name, sizeof(name), "cgemv_batch %s: %s",
+                 form == 0 ? "strided" : "grouped", msg);
+        CHECK(ok, name);
+    }
+}
+
+static void zgemv_batch_case(const char *msg, enum CBLAS_ORDER o,
+                             enum CBLAS_TRANSPOSE t, int m, int n,
+                             const double *alpha, const double *A, int lda,
+                             const double *x, int incx, const double *beta,
+                             const double *y, int incy, const double *expect) {
+    int alen = (o == CblasRowMajor ? m : n) * lda;
+    int xlen = vec_len(t == CblasNoTrans ? n : m, incx);
+    int ylen = vec_len(t == CblasNoTrans ? m : n, incy);
+    double Ab[NCOPY * MAXLEN], xb[NCOPY * MAXLEN], yb[NCOPY * MAXLEN];
+    const void *ap[NCOPY], *xp[NCOPY];
+    void *yp[NCOPY];
+    enum CBLAS_TRANSPOSE tg[2] = {t, t};
+    blasint mg[2] = {m, m}, ng[2] = {n, n}, ldg[2] = {lda, lda};
+    blasint ixg[2] = {incx, incx}, iyg[2] = {incy, incy};
+    blasint size[2] = {2, NCOPY - 2};
+    double ag[4] = {alpha[0], alpha[1], alpha[0], alpha[1]};
+    double bg[4] = {beta[0], beta[1], beta[0], beta[1]};
+    char name[128];
+
+    for (int form = 0; form < 2; form++) {
+        int ok = 1;
+
+        for (int c = 0; c < NCOPY; c++) {
+            memcpy(Ab + 2 * c * alen, A, 2 * alen * sizeof(double));
+            memcpy(xb + 2 * c * xlen, x, 2 * xlen * sizeof(double));
+            memcpy(yb + 2 * c * ylen, y, 2 * ylen * sizeof(double));
+            ap[c] = Ab + 2 * c * alen;
+            xp[c] = xb + 2 * c * xlen;
+            yp[c] = yb + 2 * c * ylen;
+        }
+        if (form == 0)
+            l2_zgemv_batch_strided(o, t, m, n, alpha, Ab, lda, alen,
+                                   xb, incx, xlen, beta, yb, incy, ylen, NCOPY);
+        else
+            l2_zgemv_batch(o, tg, mg, ng, ag, ap, ldg, xp, ixg, bg, yp, iyg,
+                           2, size);
+
+        for (int c = 0; c < NCOPY; c++)
+            for (int i = 0; i < 2 * ylen; i++)
+                if (fabs(yb[2 * c * ylen + i] - expect[i]) >= TOL_DOUBLE) ok = 0;
+        snprintf(name, sizeof(name), "zgemv_batch %s: %s",
+                 form == 0 ? "strided" : "grouped", msg);
+        CHECK(ok, name);
+    }
+}
+
+/* ---- the test_gemv.c cases ----------------------------------------------- */
+
+L2T_TEST(test_sgemv_batch_basic) {
+    float A[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    float x[2] = {1.0f, 1.0f};
+    float y[2] = {0.0f, 0.0f};
+    float e[2] = {3.0f, 7.0f};
+
+    sgemv_batch_case("basic 2x2 NoTrans", CblasRowMajor, CblasNoTrans, 2, 2,
+                     1.0f, A, 2, x, 1, 0.0f, y, 1, e);
+}
+
+L2T_TEST(test_sgemv_batch_trans) {
+    float A[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    float x[2] = {1.0f, 1.0f};
+    float y[2] = {0.0f, 0.0f};
+    float e[2] = {4.0f, 6.0f};
+
+    sgemv_batch_case("basic 2x2 Trans", CblasRowMajor, CblasTrans, 2, 2,
+                     1.0f, A, 2, x, 1, 0.0f, y, 1, e);
+}
+
+L2T_TEST(test_sgemv_batch_alpha_beta) {
+    float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    float x[2] = {2.0f, 3.0f};
+    float y[2] = {1.0f, 1.0f};
+    float e[2] = {7.0f, 9.0f};
+
+    sgemv_batch_case("alpha=2, beta=3", CblasRowMajor, CblasNoTrans, 2, 2,
+                     2.0f, A, 2, x, 1, 3.0f, y, 1, e);
+}
+
+L2T_TEST(test_sgemv_batch_col_major) {
+    float A[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    float x[2] = {1.0f, 1.0f};
+    float y[2] = {0.0f, 0.0f};
+    float e[2] = {4.0f, 6.0f};
+
+    sgemv_batch_case("ColMajor 2x2", CblasColMajor, CblasNoTrans, 2, 2,
+                     1.0f, A, 2, x, 1, 0.0f, y, 1, e);
+}
+
+L2T_TEST(test_sgemv_batch_incx_incy) {
+    float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    float x[4] = {1.0f, 99.0f, 2.0f, 99.0f};
+    float y[3] = {0.0f, 0.0f, 0.0f};
+    float e[3] = {1.0f, 0.0f, 2.0f};
+
+    sgemv_batch_case("incx=2, incy=2", CblasRowMajor, CblasNoTrans, 2, 2,
+                     1.0f, A, 2, x, 2, 0.0f, y, 2, e);
+}
+
+L2T_TEST(test_sgemv_batch_non_square) {
+    float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    float x[2] = {1.0f, 1.0f};
+    float y[3] = {0.0f, 0.0f, 0.0f};
+    float e[3] = {3.0f, 7.0f, 11.0f};
+
+    sgemv_batch_case("non-square 3x2", CblasRowMajor, CblasNoTrans, 3, 2,
+                     1.0f, A, 2, x, 1, 0.0f, y, 1, e);
+}
+
+L2T_TEST(test_dgemv_batch_basic) {
+    double A[4] = {1.0, 2.0, 3.0, 4.0};
+    double x[2] = {1.0, 1.0};
+    double y[2] = {0.0, 0.0};
+    double e[2] = {3.0, 7.0};
+
+    dgemv_batch_case("basic 2x2 NoTrans", CblasRowMajor, CblasNoTrans, 2, 2,
+                     1.0, A, 2, x, 1, 0.0, y, 1, e);
+}
+
+L2T_TEST(test_dgemv_batch_trans) {
+    double A[4] = {1.0, 2.0, 3.0, 4.0};
+    double x[2] = {1.0, 1.0};
+    double y[2] = {0.0, 0.0};
+    double e[2] = {4.0, 6.0};
+
+    dgemv_batch_case("basic 2x2 Trans", CblasRowMajor, CblasTrans, 2, 2,
+                     1.0, A, 2, x, 1, 0.0, y, 1, e);
+}
+
+L2T_TEST(test_dgemv_batch_large) {
+    double A[16] = {
+        1,0,0,0,
+        0,1,0,0,
+        0,0,1,0,
+        0,0,0,1
+    };
+    double x[4] = {1.0, 2.0, 3.0, 4.0};
+    double y[4] = {0.0, 0.0, 0.0, 0.0};
+
+    dgemv_batch_case("4x4 identity", CblasRowMajor, CblasNoTrans, 4, 4,
+                     1.0, A, 4, x, 1, 0.0, y, 1, x);
+}
+
+L2T_TEST(test_cgemv_batch_basic) {
+    float A[8]  = {1,0, 0,0,  0,0, 1,0};
+    float x[4]  = {1,0, 0,1};
+    float y[4]  = {0,0, 0,0};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2]  = {0.0f, 0.0f};
+
+    cgemv_batch_case("2x2 complex identity NoTrans", CblasRowMajor,
+                     CblasNoTrans, 2, 2, alpha, A, 2, x, 1, beta, y, 1, x);
+}
+
+L2T_TEST(test_cgemv_batch_conj_trans) {
+    float A[8] = {0,1, 0,0,  0,0, 0,1};
+    float x[4] = {1,0, 1,0};
+    float y[4] = {0,0, 0,0};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2]  = {0.0f, 0.0f};
+    float e[4] = {0,-1, 0,-1};
+
+    cgemv_batch_case("2x2 ConjTrans", CblasRowMajor, CblasConjTrans, 2, 2,
+                     alpha, A, 2, x, 1, beta, y, 1, e);
+}
+
+L2T_TEST(test_zgemv_batch_basic) {
+    double A[8]  = {2,0, 0,0,  0,0, 2,0};
+    double x[4]  = {1,0, 1,0};
+    double y[4]  = {0,0, 0,0};
+    double alpha[2] = {1.0, 0.0};
+    double beta[2]  = {0.0, 0.0};
+    double e[4] = {2,0, 2,0};
+
+    zgemv_batch_case("2x2 diagonal complex matrix", CblasRowMajor,
+                     CblasNoTrans, 2, 2, alpha, A, 2, x, 1, beta, y, 1, e);
+}
+
+/* ---- mixed batches against a loop of OpenBLAS calls ---------------------- */
+
+#define NGROUPS  12
+#define MAXDIM   32
+#define MAXITEMS 1200
+
+static unsigned rng = 777u;
+
+/*
+ * One grouped batch of NGROUPS random groups (shapes 2..MAXDIM, every trans,
+ * unit and negative strides) in precision p, checked item by item against
+ * cblas_?gemv.  Values lie in [-1, 1), so |y| <= 2k+2 per real component.
+ */
+static int mixed_batch(char p, enum CBLAS_ORDER o) {
+    static const enum CBLAS_TRANSPOSE tr[3] =
+        {CblasNoTrans, CblasTrans, CblasConjTrans};
+    int cplx = l2t_is_cplx(p), dbl = !l2t_is_single(p);
+    size_t es = (size_t)(cplx ? 2 : 1) * (dbl ? sizeof(double) : sizeof(float));
+    size_t amax = (size_t)MAXDIM * (MAXDIM + 1);
+    size_t per = amax + 4 * MAXDIM;
+    char *buf = malloc(MAXITEMS * per * es);
+    char *ybuf = malloc(MAXITEMS * 2 * MAXDIM * es);
+    char *yref = malloc(MAXITEMS * 2 * MAXDIM * es);
+    const void **ap = malloc(MAXITEMS * sizeof(void *));
+    const void **xp = malloc(MAXITEMS * sizeof(void *));
+    void **yp = malloc(MAXITEMS * sizeof(void *));
+    enum CBLAS_TRANSPOSE tg[NGROUPS];
+    blasint mg[NGROUPS], ng[NGROUPS], ldg[NGROUPS], ixg[NGROUPS], iyg[NGROUPS];
+    blasint size[NGROUPS];
+    double alpha[2 * NGROUPS] = {0}, beta[2 * NGROUPS] = {0};
+    float salpha[2 * NGROUPS], sbeta[2 * NGROUPS];
+    int item = 0, ok = 1;
+
+    if (!buf || !ybuf || !yref || !ap || !xp || !yp) {
+        free(buf); free(ybuf); free(yref); free(ap); free(xp); free(yp);
+        return 0;
+    }
+    if (dbl) l2t_fill(&rng, (double *)buf, NULL, MAXITEMS * per * es / 8);
+    else     l2t_fill(&rng, NULL, (float *)buf, MAXITEMS * per * es / 4);
+    for (int g = 0; g < NGROUPS; g++) {
+        tg[g] = tr[g % 3];
+        mg[g] = l2t_rand_int(&rng, 2, MAXDIM);
+        ng[g] = l2t_rand_int(&rng, 2, MAXDIM);
+        ldg[g] = (o == CblasRowMajor ? ng[g] : mg[g]) + g % 2;
+        ixg[g] = g % 4 < 2 ? 1 : 2;
+        iyg[g] = g % 4 < 2 ? 1 : -1;
+        size[g] = l2t_rand_int(&rng, 60, MAXITEMS / NGROUPS);
+        if (cplx) {
+            alpha[2 * g] = l2t_rand(&rng); alpha[2 * g + 1] = l2t_rand(&rng);
+            beta[2 * g] = l2t_rand(&rng);  beta[2 * g + 1] = l2t_rand(&rng);
+        } else {
+            alpha[g] = l2t_rand(&rng);
+            beta[g] = l2t_rand(&rng);
+        }
+    }
+    for (int i = 0; i < 2 * NGROUPS; i++) {
+        salpha[i] = (float)alpha[i];
+        sbeta[i] = (float)beta[i];
+    }
+    for (int g = 0, it = 0; g < NGROUPS; g++) {
+        for (int i = 0; i < size[g]; i++, it++) {
+            char *base = buf + (size_t)it * per * es;
+            ap[it] = base;
+            xp[it] = base + amax * es;
+            yp[it] = ybuf + (size_t)it * 2 * MAXDIM * es;
+            memcpy(yref + (size_t)it * 2 * MAXDIM * es,
+                   base + (amax + 2 * MAXDIM) * es,
+                   2 * MAXDIM * es);
+            memcpy(yp[it], yref + (size_t)it * 2 * MAXDIM * es,
+                   2 * MAXDIM * es);
+        }
+    }
+
+    switch (p) {
+    case 's':
+        l2_sgemv_batch(o, tg, mg, ng, salpha, (const float **)ap, ldg,
+                       (const float **)xp, ixg, sbeta, (float **)yp, iyg,
+                       NGROUPS, size);
+        break;
+    case 'd':
+        l2_dgemv_batch(o, tg, mg, ng, alpha, (const double **)ap, ldg,
+                       (const double **)xp, ixg, beta, (double **)yp, iyg,
+                       NGROUPS, size);
+        break;
+    case 'c':
+        l2_cgemv_batch(o, tg, mg, ng, salpha, ap, ldg, xp, ixg, sbeta,
+                       yp, iyg, NGROUPS, size);
+        break;
+    default:
+        l2_zgemv_batch(o, tg, mg, ng, alpha, ap, ldg, xp, ixg, beta,
+                       yp, iyg, NGROUPS, size);
+        break;
+    }
+
+    for (int g = 0; g < NGROUPS; g++) {
+        int k = tg[g] == CblasNoTrans ? ng[g] : mg[g];
+        int ylen = vec_len(tg[g] == CblasNoTrans ? mg[g] : ng[g], iyg[g]);
+        int nreal = cplx ? 2 * ylen : ylen;
+        double eps = dbl ? DBL_EPSILON : FLT_EPSILON;
+        double tol = 4.0 * (k + 2) * eps * (2.0 * k + 2.0);
+
+        for (int i = 0; i < size[g]; i++, item++) {
+            void *yr = yref + (size_t)item * 2 * MAXDIM * es;
+
+            switch (p) {
+            case 's':
+                cblas_sgemv(o, tg[g], mg[g], ng[g], salpha[g], ap[item], ldg[g],
+                            xp[item], ixg[g], sbeta[g], yr, iyg[g]);
+                break;
+            case 'd':
+                cblas_dgemv(o, tg[g], mg[g], ng[g], alpha[g], ap[item], ldg[g],
+                            xp[item], ixg[g], beta[g], yr, iyg[g]);
+                break;
+            case 'c':
+                cblas_cgemv(o, tg[g], mg[g], ng[g], salpha + 2 * g, ap[item],
+                            ldg[g], xp[item], ixg[g], sbeta + 2 * g, yr, iyg[g]);
+                break;
+            default:
+                cblas_zgemv(o, tg[g], mg[g], ng[g], alpha + 2 * g, ap[item],
+                            ldg[g], xp[item], ixg[g], beta + 2 * g, yr, iyg[g]);
+                break;
+            }
+            for (int r = 0; r < nreal; r++) {
+                double got = dbl ? ((double *)yp[item])[r] : ((float *)yp[item])[r];
+                double ref = dbl ? ((double *)yr)[r] : ((float *)yr)[r];
+                if (!(fabs(got - ref) <= tol)) ok = 0;
+            }
+        }
+    }
+
+    free(buf); free(ybuf); free(yref); free(ap); free(xp); free(yp);
+    return ok;
+}
+
+L2T_TEST(test_gemv_batch_mixed) {
+    static const int threads[] = {1, 2, 4};
+    static const char precs[] = {'s', 'd', 'c', 'z'};
+    int saved = l2_get_num_threads();
+    char msg[128];
+
+    for (int t = 0; t < 3; t++) {
+        l2_set_num_threads(threads[t]);
+        for (int p = 0; p < 4; p++) {
+            int ok = mixed_batch(precs[p], CblasRowMajor) &&
+                     mixed_batch(precs[p], CblasColMajor);
+            snprintf(msg, sizeof(msg),
+                     "%cgemv_batch: %d mixed groups match OpenBLAS, %d thread(s)",
+                     precs[p], NGROUPS, threads[t]);
+            CHECK(ok, msg);
+        }
+    }
+    l2_set_num_threads(saved);
+}
+
+L2T_TEST(test_gemv_batch_illegal_group) {
+    double A[4] = {1.0, 2.0, 3.0, 4.0};
+    double x[2] = {1.0, 1.0};
+    double y0[2] = {5.0, 5.0}, y1[2] = {5.0, 5.0};
+    const double *ap[2] = {A, A}, *xp[2] = {x, x};
+    double *yp[2] = {y0, y1};
+    enum CBLAS_TRANSPOSE tg[2] = {CblasNoTrans, CblasNoTrans};
+    blasint mg[2] = {2, 2}, ng[2] = {2, 2}, ldg[2] = {2, 1};
+    blasint ixg[2] = {1, 1}, iyg[2] = {1, 1}, size[2] = {1, 1};
+    double ag[2] = {1.0, 1.0}, bg[2] = {0.0, 0.0};
+
+    /* lda of the second group is illegal: nothing may be computed. */
+    l2_dgemv_batch(CblasRowMajor, tg, mg, ng, ag, ap, ldg, xp, ixg, bg, yp,
+                   iyg, 2, size);
+
+    CHECK(y0[0] == 5.0 && y0[1] == 5.0 && y1[0] == 5.0 && y1[1] == 5.0,
+          "dgemv_batch: illegal lda in a later group leaves every y untouched");
+}
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Differential tests: l2_?ger, l2_?geru and l2_?gerc against OpenBLAS for
+ * every kernel tier and for 1 and 4 threads.  Sizes hit each vector tail
+ * of the four-column sweeps and go past the x row tile (1024 rows, 512 for
+ * complex double).  lda is the matrix's leading dimension plus 3, and the
+ * whole array is compared, so a write into the padding is a mismatch.
+ */
+
+#define MAXN 1100
+#define PAD 3
+
+static const int sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33,
+                            64, 100, 530, 1100};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 3}, {-1, -2}, {1, -1}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+static const char *order_name[2] = {"RowMajor", "ColMajor"};
+
+/* ops: 0 = ger (real) / geru (complex), 1 = gerc */
+static const char *op_name[4][2] = {{"sger", NULL}, {"dger", NULL},
+                                    {"cgeru", "cgerc"}, {"zgeru", "zgerc"}};
+static const char precs[] = {'s', 'd', 'c', 'z'};
+
+/* Matrices and vectors as reals; complex data interleaves (re, im). */
+static float  *sA0, *sA, *sAref, *sx, *sy;
+static double *dA0, *dA, *dAref, *dx, *dy;
+
+static unsigned rng = 4242u;
+
+L2T_SETUP(alloc_inputs) {
+    size_t na = 2 * (size_t)(MAXN + PAD) * (MAXN + PAD);
+    size_t nv = 2 * 3 * (size_t)MAXN;
+
+    if (!l2t_alloc_sd(na, &dA0, &sA0) || !l2t_alloc_sd(na, &dA, &sA) ||
+        !l2t_alloc_sd(na, &dAref, &sAref) || !l2t_alloc_sd(nv, &dx, &sx) ||
+        !l2t_alloc_sd(nv, &dy, &sy))
+        return 0;
+    l2t_fill(&rng, dA0, sA0, na);
+    l2t_fill(&rng, dx, sx, nv);
+    l2t_fill(&rng, dy, sy, nv);
+    return 1;
+}
+
+static const float  c_alpha[2] = {0.7f, -0.4f};
+static const double z_alpha[2] = {0.7, -0.4};
+
+static int ger_case(char p, int op, enum CBLAS_ORDER o, int m, int n,
+                    int incx, int incy) {
+    int cs = l2t_is_cplx(p) ? 2 : 1;
+    int lda = (o == CblasColMajor ? m : n) + PAD;
+    size_t len = (size_t)lda * (o == CblasColMajor ? n : m) * cs;
+    double eps = l2t_is_single(p) ? FLT_EPSILON : DBL_EPSILON;
+
+    if (l2t_is_single(p)) {
+        memcpy(sA, sA0, len * sizeof(float));
+        memcpy(sAref, sA0, len * sizeof(float));
+    } else {
+        memcpy(dA, dA0, len * sizeof(double));
+        memcpy(dAref, dA0, len * sizeof(double));
+    }
+    switch (p) {
+    case 's':
+        l2_sger(o, m, n, 0.7f, sx, incx, sy, incy, sA, lda);
+        cblas_sger(o, m, n, 0.7f, sx, incx, sy, incy, sAref, lda);
+        break;
+    case 'd':
+        l2_dger(o, m, n, 0.7, dx, incx, dy, incy, dA, lda);
+        cblas_dger(o, m, n, 0.7, dx, incx, dy, incy, dAref, lda);
+        break;
+    case 'c':
+        if (op) {
+            l2_cgerc(o, m, n, c_alpha, sx, incx, sy, incy, sA, lda);
+            cblas_cgerc(o, m, n, c_alpha, sx, incx, sy, incy, sAref, lda);
+        } else {
+            l2_cgeru(o, m, n, c_alpha, sx, incx, sy, incy, sA, lda);
+            cblas_cgeru(o, m, n, c_alpha, sx, incx, sy, incy, sAref, lda);
+        }
+        break;
+    default:
+        if (op) {
+            l2_zgerc(o, m, n, z_alpha, dx, incx, dy, incy, dA, lda);
+            cblas_zgerc(o, m, n, z_alpha, dx, incx, dy, incy, dAref, lda);
+        } else {
+            l2_zgeru(o, m, n, z_alpha, dx, incx, dy, incy, dA, lda);
+            cblas_zgeru(o, m, n, z_alpha, dx, incx, dy, incy, dAref, lda);
+        }
+        break;
+    }
+
+    /* |a| <= 1 and |alpha*x*y| <= 2 * 1.1 * 2: a handful of roundings */
+    for (size_t i = 0; i < len; i++) {
+        double got = l2t_is_single(p) ? sA[i] : dA[i];
+        double ref = l2t_is_single(p) ? sAref[i] : dAref[i];
+        if (!(fabs(got - ref) <= 32.0 * eps)) return 0;
+    }
+    return 1;
+}
+
+L2T_CORE_TEST(test_ger_sweep) {
+    char msg[128];
+
+    for (int p = 0; p < 4; p++)
+        for (int op = 0; op < (p < 2 ? 1 : 2); op++)
+            for (int oi = 0; oi < 2; oi++) {
+                int ok = 1;
+                for (int a = 0; a < NSIZES; a++)
+                    for (int b = 0; b < NSIZES; b++)
+                        for (int c = 0; c < NINCS; c++) {
+                            int big = sizes[a] > 100 || sizes[b] > 100;
+                            /* past 100 only against a side of 33 or less */
+                            if (big && sizes[a] > 33 && sizes[b] > 33)
+                                continue;
+                            ok &= ger_case(precs[p], op, orders[oi],
+                                           sizes[a], sizes[b], incs[c][0],
+                                           incs[c][1]);
+                        }
+                snprintf(msg, sizeof(msg), "l2_%s[%s]: %s matches OpenBLAS",
+                         op_name[p][op], core, order_name[oi]);
+                CHECK(ok, msg);
+            }
+}
+
+/*
+ * Several threads on large updates: column blocks, and row blocks when
+ * there are fewer columns (of the ColMajor view) than 4 per thread.
+ */
+L2T_TEST(test_ger_threads) {
+    static const int shapes[][2] = {{MAXN, 530}, {530, MAXN}, {MAXN, 9},
+                                    {9, MAXN}};
+    int saved = l2_get_num_threads();
+    char msg[128];
+
+    l2_set_num_threads(4);
+    for (int p = 0; p < 4; p++)
+        for (int op = 0; op < (p < 2 ? 1 : 2); op++) {
+            int ok = 1;
+            for (int oi = 0; oi < 2; oi++)
+                for (int s = 0; s < 4; s++)
+                    for (int c = 0; c < NINCS; c++)
+                        ok &= ger_case(precs[p], op, orders[oi], shapes[s][0],
+                                       shapes[s][1], incs[c][0], incs[c][1]);
+            snprintf(msg, sizeof(msg),
+                     "l2_%s: large updates with 4 threads match OpenBLAS",
+                     op_name[p][op]);
+            CHECK(ok, msg);
+        }
+    l2_set_num_threads(saved);
+}
+
+/* alpha = 0 is a quick return: A is not even read, NaNs included. */
+L2T_TEST(test_ger_alpha_zero_quick_return) {
+    static const float  c_zero[2] = {0.0f, 0.0f};
+    static const double z_zero[2] = {0.0, 0.0};
+    float  sa[8], sv[4] = {NAN, 1.0f, NAN, 2.0f};
+    double da[8], dv[4] = {NAN, 1.0, NAN, 2.0};
+    int ok = 1;
+
+    for (int i = 0; i < 8; i++) {
+        sa[i] = (float)i;
+        da[i] = (double)i;
+    }
+    l2_sger(CblasColMajor, 2, 2, 0.0f, sv, 1, sv, 1, sa, 2);
+    l2_dger(CblasRowMajor, 2, 2, 0.0, dv, 1, dv, 1, da, 2);
+    l2_cgeru(CblasColMajor, 2, 2, c_zero, sv, 1, sv, 1, sa, 2);
+    l2_cgerc(CblasRowMajor, 2, 2, c_zero, sv, 1, sv, 1, sa, 2);
+    l2_zgeru(CblasColMajor, 2, 2, z_zero, dv, 1, dv, 1, da, 2);
+    l2_zgerc(CblasRowMajor, 2, 2, z_zero, dv, 1, dv, 1, da, 2);
+    for (int i = 0; i < 8; i++)
+        ok &= sa[i] == (float)i && da[i] == (double)i;
+    CHECK(ok, "l2_?ger*: alpha=0 leaves A untouched");
+}
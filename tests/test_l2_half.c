@@ -0,0 +1,421 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dlfcn.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * bf16/fp16 storage with fp32 arithmetic (l2_sb*, l2_sh*).  The reference
+ * is computed in double from the stored values themselves (decoded through
+ * a 65536-entry table), and every element must meet the bound documented in
+ * l2blas.h:
+ *
+ *     |y(i) - ref(i)| <= (k + 2) * 2^-24 * (|alpha| sum |A||x| + |beta y|)
+ *
+ * with k the length of the sum.  Sizes pass L2_HALF_XB (1024, the x chunk
+ * of gemv) and L2_SYMV_NB(float) (2048, the symv block), trmv sizes its
+ * 32-row diagonal blocks.  One more case holds the result against the
+ * original float data with the storage rounding added, and cblas_sbgemv,
+ * otherwise untested, must agree with l2_sbgemv where the linked OpenBLAS
+ * has it.
+ */
+
+#define MAXN 2100
+#define PAD  3
+#define U32  (1.0 / 16777216.0)      /* 2^-24 */
+
+/*
+ * OpenBLAS only exports cblas_sbgemv when built with BUILD_BFLOAT16, so it
+ * is looked up at run time rather than linked; NULL without it.
+ */
+typedef void (*sbgemv_fn)(enum CBLAS_ORDER, enum CBLAS_TRANSPOSE, blasint,
+                          blasint, float, const bfloat16 *, blasint,
+                          const bfloat16 *, blasint, float, float *, blasint);
+
+static sbgemv_fn ob_sbgemv(void) {
+    return (sbgemv_fn)dlsym(RTLD_DEFAULT, "cblas_sbgemv");
+}
+
+enum { BF16 = 0, FP16 = 1 };
+static const char *fmt_name[2] = {"sbgemv", "shgemv"};
+
+static float    *fA, *fx, *fy0, *y, *y2;
+static uint16_t *hA[2], *hx[2];
+static double   *lut[2];
+
+static unsigned rng = 1877u;
+
+L2T_SETUP(alloc_inputs) {
+    size_t na = (size_t)(MAXN + PAD) * MAXN, nv = 3 * (size_t)MAXN;
+    static float tab[65536];
+    uint16_t all[65536];
+
+    fA = malloc(na * sizeof(float));
+    fx = malloc(nv * sizeof(float));
+    fy0 = malloc(nv * sizeof(float));
+    y = malloc(nv * sizeof(float));
+    y2 = malloc(nv * sizeof(float));
+    for (int f = 0; f < 2; f++) {
+        hA[f] = malloc(na * sizeof(uint16_t));
+        hx[f] = malloc(nv * sizeof(uint16_t));
+        lut[f] = malloc(65536 * sizeof(double));
+        if (!hA[f] || !hx[f] || !lut[f]) return 0;
+    }
+    if (!fA || !fx || !fy0 || !y || !y2) return 0;
+
+    l2t_fill(&rng, NULL, fA, na);
+    l2t_fill(&rng, NULL, fx, nv);
+    l2t_fill(&rng, NULL, fy0, nv);
+    l2_sbstobf16((blasint)na, fA, 1, hA[BF16], 1);
+    l2_sbstobf16((blasint)nv, fx, 1, hx[BF16], 1);
+    l2_shstofp16((blasint)na, fA, 1, hA[FP16], 1);
+    l2_shstofp16((blasint)nv, fx, 1, hx[FP16], 1);
+
+    for (int i = 0; i < 65536; i++) all[i] = (uint16_t)i;
+    l2_sbf16tos(65536, all, 1, tab, 1);
+    for (int i = 0; i < 65536; i++) lut[BF16][i] = tab[i];
+    l2_shfp16tos(65536, all, 1, tab, 1);
+    for (int i = 0; i < 65536; i++) lut[FP16][i] = tab[i];
+    return 1;
+}
+
+/* Storage index of logical element i of a length-len vector. */
+static size_t vidx(int i, int len, int inc) {
+    return inc > 0 ? (size_t)i * (size_t)inc
+                   : (size_t)(len - 1 - i) * (size_t)(-inc);
+}
+
+/* Logical A(i, j) of a matrix stored in order o. */
+static size_t aidx(enum CBLAS_ORDER o, int i, int j, int lda) {
+    return o == CblasColMajor ? (size_t)i + (size_t)j * lda
+                              : (size_t)i * lda + (size_t)j;
+}
+
+static int within(double got, double ref, int k, double bound) {
+    return fabs(got - ref) <= (double)(k + 2) * U32 * bound;
+}
+
+/* ---- gemv ---------------------------------------------------------------- */
+
+static void hgemv(int f, enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t, int m,
+                  int n, float alpha, int lda, int incx, float beta, float *yy,
+                  int incy) {
+    if (f == BF16)
+        l2_sbgemv(o, t, m, n, alpha, hA[f], lda, hx[f], incx, beta, yy, incy);
+    else
+        l2_shgemv(o, t, m, n, alpha, hA[f], lda, hx[f], incx, beta, yy, incy);
+}
+
+static int gemv_case(int f, enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t,
+                     int m, int n, int incx, int incy) {
+    const float alpha = 0.7f, beta = -1.3f;
+    int notrans = t == CblasNoTrans;
+    int leny = notrans ? m : n, lenx = notrans ? n : m;
+    int lda = (o == CblasColMajor ? m : n) + PAD;
+    size_t ylen = (size_t)leny * (size_t)abs(incy);
+    const double *v = lut[f];
+
+    memcpy(y, fy0, ylen * sizeof(float));
+    hgemv(f, o, t, m, n, alpha, lda, incx, beta, y, incy);
+
+    for (int i = 0; i < leny; i++) {
+        size_t yi = vidx(i, leny, incy);
+        double ref = beta * (double)fy0[yi], bound = fabs(beta * fy0[yi]);
+        double s = 0.0, sa = 0.0;
+
+        for (int k = 0; k < lenx; k++) {
+            double a = v[hA[f][notrans ? aidx(o, i, k, lda)
+                                       : aidx(o, k, i, lda)]];
+            double xk = v[hx[f][vidx(k, lenx, incx)]];
+            s += a * xk;
+            sa += fabs(a * xk);
+        }
+        ref += alpha * s;
+        bound += fabs(alpha) * sa;
+        if (!within(y[yi], ref, lenx, bound)) return 0;
+    }
+    return 1;
+}
+
+static const int shapes[][2] = {{1, 1}, {3, 5}, {17, 9}, {33, 64},
+                                {100, 257}, {257, 100}, {1030, 33},
+                                {33, 1030}, {2100, 2100}};
+#define NSHAPES ((int)(sizeof(shapes) / sizeof(shapes[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 3}, {-1, -2}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+L2T_CORE_TEST(test_half_gemv_sweep) {
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const enum CBLAS_TRANSPOSE trans[2] = {CblasNoTrans, CblasTrans};
+    static const char *order_name[2] = {"RowMajor", "ColMajor"};
+    static const char *trans_name[2] = {"NoTrans", "Trans"};
+    char msg[128];
+
+    for (int f = 0; f < 2; f++)
+        for (int oi = 0; oi < 2; oi++)
+            for (int ti = 0; ti < 2; ti++) {
+                int ok = 1;
+                for (int s = 0; s < NSHAPES; s++)
+                    for (int c = 0; c < NINCS; c++) {
+                        if (shapes[s][0] * shapes[s][1] > 100000 && c > 0)
+                            continue;
+                        ok &= gemv_case(f, orders[oi], trans[ti],
+                                        shapes[s][0], shapes[s][1],
+                                        incs[c][0], incs[c][1]);
+                    }
+                snprintf(msg, sizeof(msg),
+                         "l2_%s[%s]: %s %s within (k+2)*2^-24*|A||x|",
+                         fmt_name[f], core, order_name[oi], trans_name[ti]);
+                CHECK(ok, msg);
+            }
+}
+
+/* ---- symv ---------------------------------------------------------------- */
+
+static int symv_case(int f, enum CBLAS_ORDER o, enum CBLAS_UPLO u, int n,
+                     int incx, int incy) {
+    const float alpha = -0.6f, beta = 0.9f;
+    size_t ylen = (size_t)n * (size_t)abs(incy);
+    int lda = n + PAD;
+    const double *v = lut[f];
+
+    memcpy(y, fy0, ylen * sizeof(float));
+    if (f == BF16)
+        l2_sbsymv(o, u, n, alpha, hA[f], lda, hx[f], incx, beta, y, incy);
+    else
+        l2_shsymv(o, u, n, alpha, hA[f], lda, hx[f], incx, beta, y, incy);
+
+    for (int i = 0; i < n; i++) {
+        size_t yi = vidx(i, n, incy);
+        double s = 0.0, sa = 0.0;
+
+        for (int k = 0; k < n; k++) {
+            /* only the uplo triangle is stored */
+            int direct = (i <= k) == (u == CblasUpper);
+            double a = v[hA[f][direct ? aidx(o, i, k, lda)
+                                      : aidx(o, k, i, lda)]];
+            double xk = v[hx[f][vidx(k, n, incx)]];
+            s += a * xk;
+            sa += fabs(a * xk);
+        }
+        if (!within(y[yi], beta * (double)fy0[yi] + alpha * s, n,
+                    fabs(beta * fy0[yi]) + fabs(alpha) * sa))
+            return 0;
+    }
+    return 1;
+}
+
+L2T_CORE_TEST(test_half_symv_sweep) {
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const enum CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+    static const char *order_name[2] = {"RowMajor", "ColMajor"};
+    static const char *uplo_name[2] = {"Upper", "Lower"};
+    static const int n_sym[] = {1, 2, 3, 4, 5, 7, 16, 17, 33, 100, 257, 2100};
+    char msg[128];
+
+    for (int f = 0; f < 2; f++)
+        for (int oi = 0; oi < 2; oi++)
+            for (int ui = 0; ui < 2; ui++) {
+                int ok = 1;
+                for (int s = 0; s < (int)(sizeof(n_sym) / sizeof(int)); s++)
+                    for (int c = 0; c < NINCS; c++) {
+                        if (n_sym[s] > 257 && c > 0) continue;
+                        ok &= symv_case(f, orders[oi], uplos[ui], n_sym[s],
+                                        incs[c][0], incs[c][1]);
+                    }
+                snprintf(msg, sizeof(msg),
+                         "l2_s%csymv[%s]: %s %s within (n+2)*2^-24*|A||x|",
+                         f == BF16 ? 'b' : 'h', core, order_name[oi],
+                         uplo_name[ui]);
+                CHECK(ok, msg);
+            }
+}
+
+/* ---- trmv ---------------------------------------------------------------- */
+
+static int trmv_case(int f, enum CBLAS_ORDER o, enum CBLAS_UPLO u,
+                     enum CBLAS_TRANSPOSE t, enum CBLAS_DIAG d, int n,
+                     int incx) {
+    size_t xlen = (size_t)n * (size_t)abs(incx);
+    int lda = n + PAD;
+    const double *v = lut[f];
+
+    memcpy(y, fy0, xlen * sizeof(float));
+    if (f == BF16)
+        l2_sbtrmv(o, u, t, d, n, hA[f], lda, y, incx);
+    else
+        l2_shtrmv(o, u, t, d, n, hA[f], lda, y, incx);
+
+    for (int i = 0; i < n; i++) {
+        double s = 0.0, sa = 0.0;
+
+        for (int k = 0; k < n; k++) {
+            /* op(A)(i, k) = A(r, c) */
+            int r = t == CblasNoTrans ? i : k, c = t == CblasNoTrans ? k : i;
+            double a, xk = fy0[vidx(k, n, incx)];
+
+            if (u == CblasUpper ? r > c : r < c) continue;
+            a = r == c && d == CblasUnit ? 1.0 : v[hA[f][aidx(o, r, c, lda)]];
+            s += a * xk;
+            sa += fabs(a * xk);
+        }
+        if (!within(y[vidx(i, n, incx)], s, n, sa)) return 0;
+    }
+    return 1;
+}
+
+L2T_CORE_TEST(test_half_trmv_sweep) {
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const enum CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+    static const enum CBLAS_TRANSPOSE trans[2] = {CblasNoTrans, CblasTrans};
+    static const enum CBLAS_DIAG diags[2] = {CblasNonUnit, CblasUnit};
+    static const int n_tr[] = {1, 2, 5, 31, 32, 33, 64, 100, 1030};
+    static const int incx_tr[] = {1, 2, -3};
+    char msg[128];
+
+    for (int f = 0; f < 2; f++)
+        for (int oi = 0; oi < 2; oi++)
+            for (int ui = 0; ui < 2; ui++) {
+                int ok = 1;
+                for (int ti = 0; ti < 2; ti++)
+                    for (int di = 0; di < 2; di++)
+                        for (int s = 0; s < (int)(sizeof(n_tr) / sizeof(int));
+                             s++)
+                            for (int c = 0; c < 3; c++)
+                                ok &= trmv_case(f, orders[oi], uplos[ui],
+                                                trans[ti], diags[di], n_tr[s],
+                                                incx_tr[c]);
+                snprintf(msg, sizeof(msg),
+                         "l2_s%ctrmv[%s]: %s %s, all trans/diag, within "
+                         "(n+2)*2^-24*|A||x|", f == BF16 ? 'b' : 'h', core,
+                         oi ? "ColMajor" : "RowMajor",
+                         ui ? "Lower" : "Upper");
+                CHECK(ok, msg);
+            }
+}
+
+/* ---- against float data and OpenBLAS ------------------------------------- */
+
+/*
+ * The whole error against the float A and x the caller started from:
+ * storage rounding (2u + u^2 per product, u = 2^-8 bf16, 2^-11 fp16) on
+ * top of the fp32 bound.
+ */
+L2T_TEST(test_half_gemv_vs_float_data) {
+    const int n = MAXN, lda = n + PAD;
+    static const double us[2] = {1.0 / 256.0, 1.0 / 2048.0};
+    char msg[128];
+
+    for (int f = 0; f < 2; f++) {
+        int ok = 1;
+
+        hgemv(f, CblasColMajor, CblasNoTrans, n, n, 1.0f, lda, 1, 0.0f, y, 1);
+        for (int i = 0; i < n; i++) {
+            double s = 0.0, sa = 0.0;
+            for (int k = 0; k < n; k++) {
+                double p = (double)fA[(size_t)i + (size_t)k * lda] * fx[k];
+                s += p;
+                sa += fabs(p);
+            }
+            ok &= fabs(y[i] - s) <=
+                  ((n + 2) * U32 + 2 * us[f] + us[f] * us[f]) * sa;
+        }
+        snprintf(msg, sizeof(msg),
+                 "l2_%s: against the float data within storage rounding "
+                 "plus fp32 bound", fmt_name[f]);
+        CHECK(ok, msg);
+    }
+}
+
+L2T_TEST(test_sbgemv_matches_openblas) {
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const enum CBLAS_TRANSPOSE trans[2] = {CblasNoTrans, CblasTrans};
+    const float alpha = 1.1f, beta = 0.5f;
+    sbgemv_fn sbgemv = ob_sbgemv();
+    char msg[128];
+
+    if (!sbgemv) {
+        l2t_skip("cblas_sbgemv: linked OpenBLAS built without bfloat16");
+        return;
+    }
+    for (int oi = 0; oi < 2; oi++)
+        for (int ti = 0; ti < 2; ti++) {
+            int ok = 1;
+            for (int s = 0; s < NSHAPES; s++) {
+                int m = shapes[s][0], n = shapes[s][1];
+                int lda = (orders[oi] == CblasColMajor ? m : n) + PAD;
+                int leny = ti ? n : m, lenx = ti ? m : n;
+
+                memcpy(y, fy0, (size_t)leny * sizeof(float));
+                memcpy(y2, fy0, (size_t)leny * sizeof(float));
+                l2_sbgemv(orders[oi], trans[ti], m, n, alpha, hA[BF16], lda,
+                          hx[BF16], 1, beta, y, 1);
+                sbgemv(orders[oi], trans[ti], m, n, alpha, hA[BF16], lda,
+                       hx[BF16], 1, beta, y2, 1);
+                /* both within the bound of the exact result; |A|,|x| <= 1 */
+                for (int i = 0; i < leny; i++)
+                    ok &= fabs(y[i] - y2[i]) <=
+                          2.0 * (lenx + 2) * U32 *
+                          (fabs(alpha) * lenx + fabs(beta * fy0[i]));
+            }
+            snprintf(msg, sizeof(msg),
+                     "cblas_sbgemv: %s %s agrees with l2_sbgemv",
+                     oi ? "ColMajor" : "RowMajor", ti ? "Trans" : "NoTrans");
+            CHECK(ok, msg);
+        }
+}
+
+/* ---- fp16 conversion ----------------------------------------------------- */
+
+L2T_TEST(test_fp16_conversion) {
+    static const float special[] = {0.0f, -0.0f, 1.0f, 65504.0f, 65519.99f,
+                                    65520.0f, 1e9f, 0x1p-14f, 0x1p-24f,
+                                    0x1p-25f, 0x1.8p-25f, 0x1p-26f,
+                                    3.0f * 0x1p-25f, INFINITY, -INFINITY};
+    int round_trip = 1, rounding = 1, nan_ok = 1;
+    unsigned r = 99u;
+
+    /* every fp16 survives fp16 -> float -> fp16; NaNs stay NaN */
+    for (int i = 0; i < 65536; i++) {
+        uint16_t h = (uint16_t)i, back;
+        float f;
+
+        l2_shfp16tos(1, &h, 1, &f, 1);
+        l2_shstofp16(1, &f, 1, &back, 1);
+        if ((h & 0x7c00u) == 0x7c00u && (h & 0x3ffu))
+            nan_ok &= isnan(f) && (back & 0x7c00u) == 0x7c00u &&
+                      (back & 0x3ffu);
+        else
+            round_trip &= back == h;
+    }
+    CHECK(round_trip, "l2_shstofp16(l2_shfp16tos(h)) == h for every fp16");
+    CHECK(nan_ok, "fp16 NaNs convert to NaN and back");
+
+    /* float -> fp16 agrees with the compiler's _Float16 (round to even) */
+    for (int i = 0; i < 200000 + (int)(sizeof(special) / sizeof(float));
+         i++) {
+        float f;
+        _Float16 c;
+        uint16_t ours, theirs;
+
+        if (i < (int)(sizeof(special) / sizeof(float))) {
+            f = special[i];
+        } else {
+            uint32_t bits;
+            r = r * 1664525u + 1013904223u;
+            /* exponents around the fp16 range, random mantissa and sign */
+            bits = (r & 0x807fffffu) | ((uint32_t)(96 + (r >> 8) % 48) << 23);
+            memcpy(&f, &bits, sizeof(f));
+        }
+        c = (_Float16)f;
+        memcpy(&theirs, &c, sizeof(theirs));
+        l2_shstofp16(1, &f, 1, &ours, 1);
+        rounding &= ours == theirs;
+    }
+    CHECK(rounding, "l2_shstofp16 rounds like (_Float16)");
+}
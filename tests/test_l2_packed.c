@@ -0,0 +1,273 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Differential tests: the packed l2blas routines (?spmv/?hpmv, ?tpmv,
+ * ?tpsv, ?spr/?hpr, ?spr2/?hpr2) against OpenBLAS for all four precisions,
+ * both orders and triangles, every trans/diag, mixed and negative
+ * increments, and every kernel tier.
+ */
+
+#define MAXN   257
+#define MAXINC 3
+
+static const int sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 33, 64, 100, 257};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 1}, {1, -1}, {-2, 3}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const char precs[] = {'s', 'd', 'c', 'z'};
+
+static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+static const enum CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+
+/* Inputs as doubles; each case copies them to the precision under test. */
+#define PLEN (MAXN * (MAXN + 1))
+#define VLEN (2 * (1 + (MAXN - 1) * MAXINC))
+static double dap[PLEN], dx[VLEN], dy[VLEN];
+static double got_d[PLEN], ref_d[PLEN];
+static float  sap[PLEN], sx[VLEN], sy[VLEN];
+static float  got_s[PLEN], ref_s[PLEN];
+
+static unsigned rng = 4242u;
+
+/*
+ * Fills the packed triangle with off-diagonal entries of size 1/n and a
+ * dominant diagonal; a complex diagonal is real, as Hermitian data must be.
+ */
+static void fill_packed(char p, enum CBLAS_ORDER o, enum CBLAS_UPLO u, int n) {
+    int cs = l2t_is_cplx(p) ? 2 : 1;
+    /* RowMajor Upper is laid out like ColMajor Lower and vice versa. */
+    int lower = (u == CblasLower) == (o == CblasColMajor);
+    size_t len = (size_t)n * (n + 1) / 2 * cs;
+
+    for (size_t i = 0; i < len; i++) dap[i] = l2t_rand(&rng) / n;
+    for (int j = 0; j < n; j++) {
+        size_t k = lower ? (size_t)j * (2 * n - j + 1) / 2
+                         : (size_t)j * (j + 1) / 2 + j;
+        dap[k * cs] = 2.0 + l2t_rand(&rng);
+        if (cs == 2) dap[k * cs + 1] = 0.0;
+    }
+    for (size_t i = 0; i < len; i++) sap[i] = (float)dap[i];
+}
+
+L2T_SETUP(fill_vectors) {
+    l2t_fill(&rng, dx, sx, VLEN);
+    l2t_fill(&rng, dy, sy, VLEN);
+    return 1;
+}
+
+/* got vs ref over len reals, relative to the largest reference value. */
+static int compare(char p, size_t len, int n) {
+    double eps = l2t_is_single(p) ? FLT_EPSILON : DBL_EPSILON, rmax = 0.0, tol;
+
+    for (size_t i = 0; i < len; i++) {
+        double r = l2t_is_single(p) ? ref_s[i] : ref_d[i];
+        if (fabs(r) > rmax) rmax = fabs(r);
+    }
+    tol = 16.0 * (n + 2) * eps * (rmax + 1.0);
+    for (size_t i = 0; i < len; i++) {
+        double g = l2t_is_single(p) ? got_s[i] : got_d[i];
+        double r = l2t_is_single(p) ? ref_s[i] : ref_d[i];
+        if (!(fabs(g - r) <= tol)) return 0;
+    }
+    return 1;
+}
+
+static size_t vec_len(char p, int n, int inc) {
+    return (size_t)(1 + (n - 1) * abs(inc)) * (l2t_is_cplx(p) ? 2 : 1);
+}
+
+/* y := alpha * A * x + beta * y */
+static int spmv_case(char p, enum CBLAS_ORDER o, enum CBLAS_UPLO u, int n,
+                     int incx, int incy) {
+    const float  salpha[2] = {0.7f, -0.3f}, sbeta[2] = {-0.5f, 0.25f};
+    const double dalpha[2] = {0.7, -0.3},   dbeta[2] = {-0.5, 0.25};
+    size_t len = vec_len(p, n, incy);
+
+    memcpy(got_s, sy, sizeof(sy)); memcpy(ref_s, sy, sizeof(sy));
+    memcpy(got_d, dy, sizeof(dy)); memcpy(ref_d, dy, sizeof(dy));
+    switch (p) {
+    case 's':
+        l2_sspmv(o, u, n, salpha[0], sap, sx, incx, sbeta[0], got_s, incy);
+        cblas_sspmv(o, u, n, salpha[0], sap, sx, incx, sbeta[0], ref_s, incy);
+        break;
+    case 'd':
+        l2_dspmv(o, u, n, dalpha[0], dap, dx, incx, dbeta[0], got_d, incy);
+        cblas_dspmv(o, u, n, dalpha[0], dap, dx, incx, dbeta[0], ref_d, incy);
+        break;
+    case 'c':
+        l2_chpmv(o, u, n, salpha, sap, sx, incx, sbeta, got_s, incy);
+        cblas_chpmv(o, u, n, salpha, sap, sx, incx, sbeta, ref_s, incy);
+        break;
+    default:
+        l2_zhpmv(o, u, n, dalpha, dap, dx, incx, dbeta, got_d, incy);
+        cblas_zhpmv(o, u, n, dalpha, dap, dx, incx, dbeta, ref_d, incy);
+        break;
+    }
+    return compare(p, len, n);
+}
+
+/* x := op(A) * x, or x := op(A)^-1 * x when solve is set */
+static int tpxv_case(char p, int solve, enum CBLAS_ORDER o,
+                     enum CBLAS_UPLO u, enum CBLAS_TRANSPOSE t,
+                     enum CBLAS_DIAG d, int n, int incx) {
+    size_t len = vec_len(p, n, incx);
+
+    memcpy(got_s, sx, sizeof(sx)); memcpy(ref_s, sx, sizeof(sx));
+    memcpy(got_d, dx, sizeof(dx)); memcpy(ref_d, dx, sizeof(dx));
+    switch (p) {
+    case 's':
+        if (solve) {
+            l2_stpsv(o, u, t, d, n, sap, got_s, incx);
+            cblas_stpsv(o, u, t, d, n, sap, ref_s, incx);
+        } else {
+            l2_stpmv(o, u, t, d, n, sap, got_s, incx);
+            cblas_stpmv(o, u, t, d, n, sap, ref_s, incx);
+        }
+        break;
+    case 'd':
+        if (solve) {
+            l2_dtpsv(o, u, t, d, n, dap, got_d, incx);
+            cblas_dtpsv(o, u, t, d, n, dap, ref_d, incx);
+        } else {
+            l2_dtpmv(o, u, t, d, n, dap, got_d, incx);
+            cblas_dtpmv(o, u, t, d, n, dap, ref_d, incx);
+        }
+        break;
+    case 'c':
+        if (solve) {
+            l2_ctpsv(o, u, t, d, n, sap, got_s, incx);
+            cblas_ctpsv(o, u, t, d, n, sap, ref_s, incx);
+        } else {
+            l2_ctpmv(o, u, t, d, n, sap, got_s, incx);
+            cblas_ctpmv(o, u, t, d, n, sap, ref_s, incx);
+        }
+        break;
+    default:
+        if (solve) {
+            l2_ztpsv(o, u, t, d, n, dap, got_d, incx);
+            cblas_ztpsv(o, u, t, d, n, dap, ref_d, incx);
+        } else {
+            l2_ztpmv(o, u, t, d, n, dap, got_d, incx);
+            cblas_ztpmv(o, u, t, d, n, dap, ref_d, incx);
+        }
+        break;
+    }
+    return compare(p, len, n);
+}
+
+/* A := alpha * x * x^H + A, or alpha * x * y^H + conj(alpha) * y * x^H + A */
+static int spr_case(char p, int rank2, enum CBLAS_ORDER o, enum CBLAS_UPLO u,
+                    int n, int incx, int incy) {
+    const float  salpha[2] = {0.6f, 0.4f};
+    const double dalpha[2] = {0.6, 0.4};
+    size_t len = (size_t)n * (n + 1) / 2 * (l2t_is_cplx(p) ? 2 : 1);
+
+    memcpy(got_s, sap, sizeof(sap)); memcpy(ref_s, sap, sizeof(sap));
+    memcpy(got_d, dap, sizeof(dap)); memcpy(ref_d, dap, sizeof(dap));
+    switch (p) {
+    case 's':
+        if (rank2) {
+            l2_sspr2(o, u, n, salpha[0], sx, incx, sy, incy, got_s);
+            cblas_sspr2(o, u, n, salpha[0], sx, incx, sy, incy, ref_s);
+        } else {
+            l2_sspr(o, u, n, salpha[0], sx, incx, got_s);
+            cblas_sspr(o, u, n, salpha[0], sx, incx, ref_s);
+        }
+        break;
+    case 'd':
+        if (rank2) {
+            l2_dspr2(o, u, n, dalpha[0], dx, incx, dy, incy, got_d);
+            cblas_dspr2(o, u, n, dalpha[0], dx, incx, dy, incy, ref_d);
+        } else {
+            l2_dspr(o, u, n, dalpha[0], dx, incx, got_d);
+            cblas_dspr(o, u, n, dalpha[0], dx, incx, ref_d);
+        }
+        break;
+    case 'c':
+        if (rank2) {
+            l2_chpr2(o, u, n, salpha, sx, incx, sy, incy, got_s);
+            cblas_chpr2(o, u, n, salpha, sx, incx, sy, incy, ref_s);
+        } else {
+            l2_chpr(o, u, n, salpha[0], sx, incx, got_s);
+            cblas_chpr(o, u, n, salpha[0], sx, incx, ref_s);
+        }
+        break;
+    default:
+        if (rank2) {
+            l2_zhpr2(o, u, n, dalpha, dx, incx, dy, incy, got_d);
+            cblas_zhpr2(o, u, n, dalpha, dx, incx, dy, incy, ref_d);
+        } else {
+            l2_zhpr(o, u, n, dalpha[0], dx, incx, got_d);
+            cblas_zhpr(o, u, n, dalpha[0], dx, incx, ref_d);
+        }
+        break;
+    }
+    return compare(p, len, n);
+}
+
+enum { SPMV, TPMV, TPSV, SPR, SPR2, NROUTINES };
+
+static const char *routine_name[2][NROUTINES] = {
+    {"spmv", "tpmv", "tpsv", "spr", "spr2"},
+    {"hpmv", "tpmv", "tpsv", "hpr", "hpr2"},
+};
+
+/* Every order, triangle, size and increment pair for one routine. */
+static int sweep(char p, int r) {
+    static const enum CBLAS_TRANSPOSE transes[3] =
+        {CblasNoTrans, CblasTrans, CblasConjTrans};
+    static const enum CBLAS_DIAG diags[2] = {CblasNonUnit, CblasUnit};
+    int ok = 1;
+
+    for (int oi = 0; oi < 2; oi++)
+        for (int ui = 0; ui < 2; ui++)
+            for (int s = 0; s < NSIZES; s++) {
+                int n = sizes[s];
+
+                fill_packed(p, orders[oi], uplos[ui], n);
+                for (int c = 0; c < NINCS; c++) {
+                    int incx = incs[c][0], incy = incs[c][1];
+
+                    switch (r) {
+                    case SPMV:
+                        ok &= spmv_case(p, orders[oi], uplos[ui], n, incx, incy);
+                        break;
+                    case TPMV:
+                    case TPSV:
+                        for (int t = 0; t < 3; t++)
+                            for (int d = 0; d < 2; d++)
+                                ok &= tpxv_case(p, r == TPSV, orders[oi],
+                                                uplos[ui], transes[t],
+                                                diags[d], n, incx);
+                        break;
+                    default:
+                        ok &= spr_case(p, r == SPR2, orders[oi], uplos[ui],
+                                       n, incx, incy);
+                        break;
+                    }
+                }
+            }
+    return ok;
+}
+
+L2T_CORE_TEST(test_packed_sweep) {
+    char msg[128];
+
+    for (int p = 0; p < 4; p++)
+        for (int r = 0; r < NROUTINES; r++) {
+            int ok = sweep(precs[p], r);
+            snprintf(msg, sizeof(msg),
+                     "l2_%c%s[%s]: all orders/uplos/increments match OpenBLAS",
+                     precs[p], routine_name[l2t_is_cplx(precs[p])][r], core);
+            CHECK(ok, msg);
+        }
+}
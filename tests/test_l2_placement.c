@@ -0,0 +1,127 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Thread placement and first touch.  l2_first_touch must zero exactly the
+ * m x n elements of A for every order/trans and OpenBLAS thread count, and
+ * leave the lda padding alone.  l2_set_placement must pin the caller and
+ * every OpenBLAS thread to the CPU it reports for that gemv block (checked
+ * through openblas_getaffinity), spread the first blocks over distinct
+ * nodes, and NONE must give every thread its whole CPU mask back.
+ */
+
+#define PAD 5
+
+static const int ob_threads[] = {1, 3, 4};
+
+static int touch_case(enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t, int m,
+                      int n) {
+    int lines = o == CblasColMajor ? n : m, len = o == CblasColMajor ? m : n;
+    int lda = len + PAD;
+    size_t total = (size_t)lda * lines;
+    unsigned char *a = malloc(total * sizeof(double));
+    int ok = a != NULL;
+
+    if (!ok) return 0;
+    memset(a, 0xA5, total * sizeof(double));
+    l2_first_touch(o, t, m, n, a, lda, sizeof(double));
+    for (int l = 0; l < lines && ok; l++)
+        for (int i = 0; i < lda && ok; i++) {
+            const unsigned char *e = a + ((size_t)l * lda + i) * sizeof(double);
+            for (size_t b = 0; b < sizeof(double); b++)
+                ok &= e[b] == (i < len ? 0x00 : 0xA5);
+        }
+    free(a);
+    return ok;
+}
+
+L2T_TEST(test_first_touch_zeroes_matrix) {
+    static const int shapes[][2] = {{1, 1}, {3, 7}, {7, 3}, {100, 9},
+                                    {9, 100}, {513, 257}};
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const enum CBLAS_TRANSPOSE trans[2] = {CblasNoTrans, CblasTrans};
+    int saved = openblas_get_num_threads();
+    char msg[128];
+
+    for (int t = 0; t < 3; t++) {
+        int ok = 1;
+        openblas_set_num_threads(ob_threads[t]);
+        for (int oi = 0; oi < 2; oi++)
+            for (int ti = 0; ti < 2; ti++)
+                for (int s = 0; s < 6; s++)
+                    ok &= touch_case(orders[oi], trans[ti], shapes[s][0],
+                                     shapes[s][1]);
+        snprintf(msg, sizeof(msg),
+                 "l2_first_touch: A zeroed, padding kept, %d OpenBLAS "
+                 "thread(s)", ob_threads[t]);
+        CHECK(ok, msg);
+    }
+    openblas_set_num_threads(saved);
+}
+
+static int only_cpu(const cpu_set_t *set, int cpu) {
+    return cpu >= 0 && CPU_COUNT(set) == 1 && CPU_ISSET(cpu, set);
+}
+
+L2T_TEST(test_placement_pins_threads) {
+    static const enum L2_PLACEMENT policies[2] = {L2_PLACE_COMPACT,
+                                                  L2_PLACE_SPREAD};
+    static const char *policy_name[2] = {"COMPACT", "SPREAD"};
+    int saved = openblas_get_num_threads(), total_nodes = 0;
+    int node_seen[CPU_SETSIZE] = {0};
+    cpu_set_t initial, set;
+    char msg[128];
+
+    sched_getaffinity(0, sizeof(initial), &initial);
+    for (int c = 0; c < CPU_SETSIZE; c++)
+        if (CPU_ISSET(c, &initial)) {
+            int node = l2_cpu_node(c);
+            if (node >= 0 && node < CPU_SETSIZE && !node_seen[node]++)
+                total_nodes++;
+        }
+    openblas_set_num_threads(4);
+    for (int p = 0; p < 2; p++) {
+        int ok = l2_set_placement(policies[p]) == 0, seen[4];
+
+        sched_getaffinity(0, sizeof(set), &set);
+        ok &= only_cpu(&set, l2_get_placement_cpu(0));
+        for (int k = 1; k < 4; k++) {
+            ok &= openblas_getaffinity(k - 1, sizeof(set), &set) == 0;
+            ok &= only_cpu(&set, l2_get_placement_cpu(k));
+        }
+        for (int k = 0; k < 4; k++) {
+            int cpu = l2_get_placement_cpu(k);
+            ok &= cpu >= 0 && CPU_ISSET(cpu, &initial);
+            seen[k] = l2_cpu_node(cpu);
+            /* spread: the first blocks each on a node of their own */
+            if (policies[p] == L2_PLACE_SPREAD)
+                for (int i = 0; i < k && k < total_nodes; i++)
+                    ok &= seen[i] != seen[k];
+        }
+        snprintf(msg, sizeof(msg),
+                 "l2_set_placement(%s): caller and 3 OpenBLAS threads pinned",
+                 policy_name[p]);
+        CHECK(ok, msg);
+    }
+
+    {
+        int ok = l2_set_placement(L2_PLACE_NONE) == 0;
+        sched_getaffinity(0, sizeof(set), &set);
+        ok &= CPU_EQUAL(&set, &initial);
+        for (int k = 0; k < 4; k++)
+            ok &= l2_get_placement_cpu(k) == -1;
+        for (int k = 1; k < 4; k++) {
+            ok &= openblas_getaffinity(k - 1, sizeof(set), &set) == 0;
+            ok &= CPU_EQUAL(&set, &initial);
+        }
+        CHECK(ok, "l2_set_placement(NONE): every thread unpinned");
+    }
+    openblas_set_num_threads(saved);
+}
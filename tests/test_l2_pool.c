@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * The work-stealing pool, driven through l2_openblas_threads (the OpenBLAS
+ * callback, which runs its jobs as pool slots) and through threaded l2blas
+ * routines.  Every job must run exactly once with its own jobdata element,
+ * regions nested inside a job must complete, and any number of concurrent
+ * callers must share the pool: no more than l2_get_num_threads() - 1 new
+ * threads in the process, and no more distinct threads per region than it
+ * has slots.
+ */
+
+#define MAXJOBS 256
+#define NCALLERS 8
+#define GER_N 600
+#define GER_CALLS 6
+
+typedef struct {
+    int       runs;
+    pthread_t who;
+    char      pad[40];      /* jobdata elements wider than the fields used */
+} job;
+
+static job jobs[MAXJOBS];
+static pthread_mutex_t jobs_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int count_threads(void) {
+    DIR *d = opendir("/proc/self/task");
+    struct dirent *e;
+    int n = 0;
+
+    if (!d) return -1;
+    while ((e = readdir(d)))
+        n += e->d_name[0] != '.';
+    closedir(d);
+    return n;
+}
+
+static void record_job(int thread_num, void *jobdata, int dojob_data) {
+    job *j = jobdata;
+
+    pthread_mutex_lock(&jobs_lock);
+    if (j == &jobs[thread_num] && dojob_data == 77) j->runs++;
+    else                                             j->runs += 1000;
+    j->who = pthread_self();
+    pthread_mutex_unlock(&jobs_lock);
+}
+
+/* Distinct threads among jobs[0..n), or -1 if a job ran other than once. */
+static int check_jobs(int n) {
+    int distinct = 0;
+
+    for (int i = 0; i < n; i++) {
+        int seen = 0;
+        if (jobs[i].runs != 1) return -1;
+        for (int k = 0; k < i && !seen; k++)
+            seen = pthread_equal(jobs[k].who, jobs[i].who);
+        distinct += !seen;
+    }
+    return distinct;
+}
+
+L2T_TEST(test_pool_every_job_once) {
+    static const int counts[] = {1, 2, 3, 7, 64, 65, 200, MAXJOBS};
+    static const int threads[] = {1, 2, 4, 16};
+    int saved = l2_get_num_threads();
+    char msg[128];
+
+    for (int t = 0; t < 4; t++) {
+        int ok = 1, most = 0;
+        l2_set_num_threads(threads[t]);
+        for (int c = 0; c < 8; c++) {
+            int d;
+            memset(jobs, 0, sizeof(jobs));
+            l2_openblas_threads(1, record_job, counts[c], sizeof(job), jobs,
+                                77);
+            d = check_jobs(counts[c]);
+            ok &= d >= 1 &&
+                  (counts[c] == MAXJOBS || jobs[counts[c]].runs == 0);
+            if (d > most) most = d;
+        }
+        snprintf(msg, sizeof(msg),
+                 "l2_openblas_threads: every job once, %d thread(s), "
+                 "%d distinct", threads[t], most);
+        CHECK(ok && most <= threads[t], msg);
+    }
+    l2_set_num_threads(saved);
+}
+
+static int inner_sum;
+
+static void inner_job(int thread_num, void *jobdata, int dojob_data) {
+    (void)jobdata;
+    __atomic_fetch_add(&inner_sum, thread_num + dojob_data,
+                       __ATOMIC_RELAXED);
+}
+
+static void outer_job(int thread_num, void *jobdata, int dojob_data) {
+    (void)jobdata;
+    (void)dojob_data;
+    l2_openblas_threads(1, inner_job, 10, 0, NULL, thread_num);
+}
+
+/* A region opened from inside a slot, every slot at once. */
+L2T_TEST(test_pool_nested) {
+    int saved = l2_get_num_threads();
+    int want = 0;
+
+    for (int o = 0; o < 12; o++)
+        want += 45 + 10 * o;
+    l2_set_num_threads(4);
+    inner_sum = 0;
+    l2_openblas_threads(1, outer_job, 12, 0, NULL, 0);
+    CHECK(inner_sum == want, "l2_openblas_threads: 12 jobs x 10 nested jobs");
+    l2_set_num_threads(saved);
+}
+
+static double *ger_A0, *ger_ref, *ger_x, *ger_y;
+
+typedef struct {
+    double *A;
+    int ok;
+} caller;
+
+static void *caller_main(void *p) {
+    caller *c = p;
+    size_t len = (size_t)GER_N * GER_N;
+
+    c->ok = 1;
+    for (int k = 0; k < GER_CALLS; k++) {
+        memcpy(c->A, ger_A0, len * sizeof(double));
+        l2_dger(CblasColMajor, GER_N, GER_N, 0.5, ger_x, 1, ger_y, 1, c->A,
+                GER_N);
+        for (size_t i = 0; i < len; i++)
+            if (fabs(c->A[i] - ger_ref[i]) > 8 * DBL_EPSILON) {
+                c->ok = 0;
+                break;
+            }
+    }
+    return NULL;
+}
+
+/*
+ * NCALLERS application threads in threaded dger at once, 4 pool threads:
+ * results as from OpenBLAS alone, and the pool adds at most 3 threads
+ * however many callers there are.
+ */
+L2T_TEST(test_pool_concurrent_callers) {
+    size_t len = (size_t)GER_N * GER_N;
+    int saved = l2_get_num_threads();
+    caller c[NCALLERS];
+    pthread_t th[NCALLERS];
+    int before, after, started = 0, ok = 1;
+    unsigned rng = 99u;
+    char msg[128];
+
+    ger_A0 = malloc(len * sizeof(double));
+    ger_ref = malloc(len * sizeof(double));
+    ger_x = malloc(GER_N * sizeof(double));
+    ger_y = malloc(GER_N * sizeof(double));
+    for (int i = 0; i < NCALLERS; i++) {
+        c[i].A = malloc(len * sizeof(double));
+        ok &= c[i].A != NULL;
+    }
+    if (!ok || !ger_A0 || !ger_ref || !ger_x || !ger_y) {
+        CHECK(0, "test_pool_concurrent_callers: allocation failed");
+        return;
+    }
+    for (size_t i = 0; i < len; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        ger_A0[i] = (double)(rng >> 8) / (double)(1 << 24) - 0.5;
+    }
+    for (int i = 0; i < GER_N; i++) {
+        ger_x[i] = ger_A0[i];
+        ger_y[i] = ger_A0[len - 1 - i];
+    }
+    memcpy(ger_ref, ger_A0, len * sizeof(double));
+    cblas_dger(CblasColMajor, GER_N, GER_N, 0.5, ger_x, 1, ger_y, 1, ger_ref,
+               GER_N);
+
+    l2_set_num_threads(4);
+    before = count_threads();
+    for (int i = 0; i < NCALLERS; i++)
+        started += pthread_create(&th[i], NULL, caller_main, &c[i]) == 0;
+    for (int i = 0; i < started; i++) {
+        pthread_join(th[i], NULL);
+        ok &= c[i].ok;
+    }
+    after = count_threads();
+
+    snprintf(msg, sizeof(msg), "l2_dger: %d concurrent callers, 4 threads, "
+             "match OpenBLAS", started);
+    CHECK(ok && started == NCALLERS, msg);
+    snprintf(msg, sizeof(msg), "pool: %d new thread(s) for %d callers",
+             after - before, NCALLERS);
+    CHECK(before > 0 && after - before <= 3, msg);
+
+    for (int i = 0; i < NCALLERS; i++)
+        free(c[i].A);
+    free(ger_A0);
+    free(ger_ref);
+    free(ger_x);
+    free(ger_y);
+    l2_set_num_threads(saved);
+}
+
+/*
+ * Registered with OpenBLAS, threaded OpenBLAS Level 2 must still agree with
+ * l2blas.  Skipped where the library predates the callback hook.
+ */
+L2T_TEST(test_pool_openblas_hook) {
+    enum { N = 1500 };
+    double *A = malloc((size_t)N * N * sizeof(double));
+    double *x = malloc(N * sizeof(double)), *y = malloc(N * sizeof(double));
+    double *y2 = malloc(N * sizeof(double));
+    int ok = 1;
+
+    if (l2_set_openblas_threads(1) != 0) {
+        l2t_skip("linked OpenBLAS has no openblas_set_threads_callback_function");
+        free(A); free(x); free(y); free(y2);
+        return;
+    }
+    for (size_t i = 0; i < (size_t)N * N; i++)
+        A[i] = (double)(i % 97) / 97.0 - 0.5;
+    for (int i = 0; i < N; i++)
+        x[i] = (double)(i % 13) / 13.0;
+    openblas_set_num_threads(4);
+    memset(y, 0, N * sizeof(double));
+    memset(y2, 0, N * sizeof(double));
+    cblas_dgemv(CblasColMajor, CblasNoTrans, N, N, 1.0, A, N, x, 1, 0.0, y, 1);
+    l2_dgemv(CblasColMajor, CblasNoTrans, N, N, 1.0, A, N, x, 1, 0.0, y2, 1);
+    for (int i = 0; i < N; i++)
+        ok &= fabs(y[i] - y2[i]) <= 1e-12 * N;
+    l2_set_openblas_threads(0);
+    CHECK(ok, "cblas_dgemv on the l2blas pool matches l2_dgemv");
+    free(A); free(x); free(y); free(y2);
+}
@@ -0,0 +1,346 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * int8-weight gemv (l2_sq8_quantize, l2_sq8gemv).  Every element must meet
+ * the bound documented in l2blas.h against the float data,
+ *
+ *     |alpha| sum_j (s_ij |x(j)| + (|A(i,j)| + s_ij / 2) sx) / 2
+ *
+ * (sx = 0 for fp32 accumulation; the test takes sx from all of x, which
+ * bounds every chunk's), plus (k + 4) * 2^-24 of the magnitudes for float
+ * rounding.  Shapes cross L2_Q8_XB (4096, the x and y chunk) and the block
+ * sizes include one above it that a chunk boundary splits.  Integer data
+ * with 127 in every block quantizes exactly, so there all paths must give
+ * the exact product; and on smooth data the result is compared with
+ * cblas_sgemv as a whole vector.
+ */
+
+#define MAXELEMS (4300 * 300)
+#define MAXV     (3 * 4300)
+#define PAD      3
+#define U32      (1.0 / 16777216.0)      /* 2^-24 */
+
+static float *fA, *fx, *fy0, *y;
+static void  *work;
+static size_t lwork;
+
+static unsigned rng = 4099u;
+
+L2T_SETUP(alloc_inputs) {
+    fA = malloc((size_t)MAXELEMS * 2 * sizeof(float));
+    fx = malloc((size_t)MAXV * sizeof(float));
+    fy0 = malloc((size_t)MAXV * sizeof(float));
+    y = malloc((size_t)MAXV * sizeof(float));
+    lwork = L2_Q8_LWORK(4300, 4300, 32);
+    work = malloc(lwork);
+    if (!fA || !fx || !fy0 || !y || !work) return 0;
+
+    l2t_fill(&rng, NULL, fA, (size_t)MAXELEMS * 2);
+    l2t_fill(&rng, NULL, fx, MAXV);
+    l2t_fill(&rng, NULL, fy0, MAXV);
+    return 1;
+}
+
+/* Storage index of logical element i of a length-len vector. */
+static size_t vidx(int i, int len, int inc) {
+    return inc > 0 ? (size_t)i * (size_t)inc
+                   : (size_t)(len - 1 - i) * (size_t)(-inc);
+}
+
+/* Logical A(i, j) of a matrix stored in order o. */
+static size_t aidx(enum CBLAS_ORDER o, int i, int j, int lda) {
+    return o == CblasColMajor ? (size_t)i + (size_t)j * lda
+                              : (size_t)i * lda + (size_t)j;
+}
+
+/* Scale of A(i, j): the largest |A| of its block of row i, over 127. */
+static double block_scale(enum CBLAS_ORDER o, int n, int lda, int block,
+                          int i, int j) {
+    int j0 = block ? j / block * block : 0;
+    int j1 = block ? j0 + block : n;
+    double amax = 0.0;
+
+    if (j1 > n) j1 = n;
+    for (int c = j0; c < j1; c++)
+        amax = fmax(amax, fabs(fA[aidx(o, i, c, lda)]));
+    return amax / 127.0;
+}
+
+static int q8_case(enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t,
+                   enum L2_Q8_ACC acc, int m, int n, int block, int incx,
+                   int incy) {
+    const float alpha = 0.7f, beta = -1.3f;
+    int notrans = t == CblasNoTrans;
+    int leny = notrans ? m : n, lenx = notrans ? n : m;
+    int lda = (o == CblasColMajor ? m : n) + PAD;
+    size_t ylen = (size_t)leny * (size_t)abs(incy);
+    double sx = 0.0, *srow;  /* Trans: scales of row i, column by column */
+    l2_sq8mat qa;
+    int ok = 1;
+
+    if (notrans && acc == L2_Q8_INT32) {
+        for (int k = 0; k < lenx; k++)
+            sx = fmax(sx, fabs(fx[vidx(k, lenx, incx)]));
+        sx /= 127.0;
+    }
+    srow = malloc((size_t)n * sizeof(double));
+    if (!srow) return 0;
+
+    l2_sq8_quantize(&qa, o, m, n, fA, lda, block, work, lwork);
+    memcpy(y, fy0, ylen * sizeof(float));
+    l2_sq8gemv(t, acc, alpha, &qa, fx, incx, beta, y, incy);
+
+    if (notrans) {
+        for (int i = 0; i < m && ok; i++) {
+            size_t yi = vidx(i, m, incy);
+            double ref = beta * (double)fy0[yi], mag = fabs(beta * fy0[yi]);
+            double s = 0.0, err = 0.0, sij = 0.0;
+
+            for (int j = 0; j < n; j++) {
+                double a = fA[aidx(o, i, j, lda)];
+                double xj = fx[vidx(j, n, incx)];
+                if (j == 0 || (block && j % block == 0))
+                    sij = block_scale(o, n, lda, block, i, j);
+                s += a * xj;
+                err += (sij * fabs(xj) + (fabs(a) + sij / 2) * sx) / 2;
+                mag += fabs(alpha) * (fabs(a) + sij) * (fabs(xj) + sx);
+            }
+            ref += alpha * s;
+            if (fabs(y[yi] - ref) >
+                fabs(alpha) * err * (1.0 + 1e-5) + (n + 4) * U32 * mag)
+                ok = 0;
+        }
+    } else {
+        double *acc_err = calloc((size_t)n, sizeof(double));
+        double *ref = calloc((size_t)n, sizeof(double));
+        double *mag = calloc((size_t)n, sizeof(double));
+
+        if (!acc_err || !ref || !mag) ok = 0;
+        for (int i = 0; i < m && ok; i++) {
+            double xi = fx[vidx(i, m, incx)];
+            for (int j = 0; j < n; j++) {
+                double a = fA[aidx(o, i, j, lda)];
+                if (j == 0 || (block && j % block == 0))
+                    srow[j] = block_scale(o, n, lda, block, i, j);
+                else
+                    srow[j] = srow[j - 1];
+                ref[j] += a * xi;
+                acc_err[j] += srow[j] * fabs(xi) / 2;
+                mag[j] += fabs(alpha) * (fabs(a) + srow[j]) * fabs(xi);
+            }
+        }
+        for (int j = 0; j < n && ok; j++) {
+            size_t yj = vidx(j, n, incy);
+            double r = beta * (double)fy0[yj] + alpha * ref[j];
+            double g = mag[j] + fabs(beta * fy0[yj]);
+            if (fabs(y[yj] - r) >
+                fabs(alpha) * acc_err[j] * (1.0 + 1e-5) + (m + 4) * U32 * g)
+                ok = 0;
+        }
+        free(acc_err);
+        free(ref);
+        free(mag);
+    }
+    free(srow);
+    return ok;
+}
+
+static const int shapes[][2] = {{1, 1}, {5, 3}, {17, 40}, {33, 64},
+                                {100, 257}, {257, 100}, {7, 4200},
+                                {4200, 7}, {300, 300}};
+#define NSHAPES ((int)(sizeof(shapes) / sizeof(shapes[0])))
+
+/* per row, short blocks, blocks not dividing 64, one above L2_Q8_XB */
+static const int blocks[] = {0, 32, 96, 4160};
+#define NBLOCKS ((int)(sizeof(blocks) / sizeof(blocks[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 3}, {-1, -2}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+L2T_CORE_TEST(test_q8gemv_sweep) {
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const char *order_name[2] = {"RowMajor", "ColMajor"};
+    static const struct {
+        enum CBLAS_TRANSPOSE t;
+        enum L2_Q8_ACC acc;
+        const char *name;
+    } ops[3] = {{CblasNoTrans, L2_Q8_INT32, "NoTrans int32"},
+                {CblasNoTrans, L2_Q8_FP32,  "NoTrans fp32"},
+                {CblasTrans,   L2_Q8_FP32,  "Trans"}};
+    char msg[128];
+
+    for (int oi = 0; oi < 2; oi++)
+        for (int p = 0; p < 3; p++) {
+            int ok = 1;
+            for (int s = 0; s < NSHAPES; s++)
+                for (int b = 0; b < NBLOCKS; b++)
+                    for (int c = 0; c < NINCS; c++) {
+                        if (c > 0 && (b > 1 || shapes[s][0] *
+                                                   shapes[s][1] > 30000))
+                            continue;
+                        ok &= q8_case(orders[oi], ops[p].t, ops[p].acc,
+                                      shapes[s][0], shapes[s][1], blocks[b],
+                                      incs[c][0], incs[c][1]);
+                    }
+            snprintf(msg, sizeof(msg),
+                     "l2_sq8gemv[%s]: %s %s within the quantization bound",
+                     core, order_name[oi], ops[p].name);
+            CHECK(ok, msg);
+        }
+}
+
+/*
+ * Integers times a power of two per block, with 127 somewhere in every
+ * block of A and in x, round to themselves with scales 1, 2 and 4, and
+ * every partial sum stays below 2^24: the result is the exact product on
+ * every path, so a scale applied to the wrong block shows.
+ */
+L2T_CORE_TEST(test_q8gemv_exact_integers) {
+    enum { M = 37, N = 200 };
+    static const int exact_blocks[] = {0, 32, 64, 96};
+    static float Ai[M * N], A[M * N], x[M + N], yy[M + N];
+    char msg[128];
+
+    for (int i = 0; i < M; i++)
+        for (int j = 0; j < N; j++)
+            Ai[i * N + j] = (j % 32 == 5) ? 127.0f
+                          : (float)((int)(l2t_rand(&rng) * 127.0));
+    for (int k = 0; k < M + N; k++)
+        x[k] = k % 7 == 0 ? -127.0f : (float)((int)(l2t_rand(&rng) * 127.0));
+
+    for (int b = 0; b < 4; b++)
+        for (int p = 0; p < 3; p++) {
+            enum CBLAS_TRANSPOSE t = p == 2 ? CblasTrans : CblasNoTrans;
+            enum L2_Q8_ACC acc = p == 0 ? L2_Q8_INT32 : L2_Q8_FP32;
+            int leny = p == 2 ? N : M, lenx = p == 2 ? M : N, ok = 1;
+            l2_sq8mat qa;
+
+            for (int i = 0; i < M; i++)
+                for (int j = 0; j < N; j++) {
+                    int e = exact_blocks[b] ? j / exact_blocks[b] + i : i;
+                    A[i * N + j] = Ai[i * N + j] * (float)(1 << (e % 3));
+                }
+            l2_sq8_quantize(&qa, CblasRowMajor, M, N, A, N,
+                            exact_blocks[b], work, lwork);
+            l2_sq8gemv(t, acc, 1.0f, &qa, x, 1, 0.0f, yy, 1);
+            for (int i = 0; i < leny; i++) {
+                double s = 0.0;
+                for (int k = 0; k < lenx; k++)
+                    s += (double)(p == 2 ? A[k * N + i] : A[i * N + k]) *
+                         x[k];
+                ok &= (double)yy[i] == s;
+            }
+            snprintf(msg, sizeof(msg),
+                     "l2_sq8gemv[%s]: block %d, %s exact on integers", core,
+                     exact_blocks[b], p == 0 ? "int32" :
+                                      p == 1 ? "fp32" : "Trans");
+            CHECK(ok, msg);
+        }
+}
+
+/*
+ * A NaN or infinity has no int8 scale.  In x it sends its chunk through
+ * fp32, so it reaches every row of y as sgemv would; in A it makes its
+ * block's scale NaN, so the row (NoTrans) or the block's columns (Trans)
+ * come out NaN and everything else stays finite.
+ */
+L2T_CORE_TEST(test_q8gemv_nonfinite) {
+    enum { M = 8, N = 200, R = 3, C = 70 };
+    static float A[M * N], x[N], yy[N];
+    static const float bad[2] = {NAN, INFINITY};
+    char msg[128];
+
+    for (int k = 0; k < M * N; k++) A[k] = 1.0f + (float)l2t_rand(&rng);
+    for (int k = 0; k < N; k++) x[k] = 1.0f + (float)l2t_rand(&rng);
+
+    for (int v = 0; v < 2; v++) {
+        l2_sq8mat qa;
+        int ok = 1;
+
+        l2_sq8_quantize(&qa, CblasRowMajor, M, N, A, N, 32, work, lwork);
+        x[C] = bad[v];
+        for (int a = 0; a < 2; a++) {
+            l2_sq8gemv(CblasNoTrans, a ? L2_Q8_FP32 : L2_Q8_INT32, 1.0f, &qa,
+                       x, 1, 0.0f, yy, 1);
+            for (int i = 0; i < M; i++)
+                ok &= v == 0 ? isnan(yy[i]) : isinf(yy[i]) && yy[i] > 0;
+        }
+        x[C] = 1.0f;
+        snprintf(msg, sizeof(msg), "l2_sq8gemv[%s]: %s in x reaches every row",
+                 core, v ? "inf" : "NaN");
+        CHECK(ok, msg);
+
+        ok = 1;
+        A[R * N + C] = bad[v];
+        l2_sq8_quantize(&qa, CblasRowMajor, M, N, A, N, 32, work, lwork);
+        A[R * N + C] = 1.0f;
+        for (int a = 0; a < 2; a++) {
+            l2_sq8gemv(CblasNoTrans, a ? L2_Q8_FP32 : L2_Q8_INT32, 1.0f, &qa,
+                       x, 1, 0.0f, yy, 1);
+            for (int i = 0; i < M; i++)
+                ok &= i == R ? isnan(yy[i]) : isfinite(yy[i]);
+        }
+        l2_sq8gemv(CblasTrans, L2_Q8_FP32, 1.0f, &qa, x, 1, 0.0f, yy, 1);
+        for (int j = 0; j < N; j++)
+            ok &= j / 32 == C / 32 ? isnan(yy[j]) : isfinite(yy[j]);
+        snprintf(msg, sizeof(msg),
+                 "l2_sq8gemv[%s]: %s in A poisons its row and block only",
+                 core, v ? "inf" : "NaN");
+        CHECK(ok, msg);
+    }
+}
+
+/*
+ * Embedding-style scoring against cblas_sgemv: 4000 rows of 256 smooth
+ * values.  The relative 2-norm error is about 2^-8 with a scale per row and
+ * shrinks with per-block scales.
+ */
+L2T_TEST(test_q8gemv_vs_sgemv) {
+    enum { M = 4000, N = 256 };
+    static const int cmp_blocks[2] = {0, 32};
+    float *ys = malloc(M * sizeof(float)), *yq = malloc(M * sizeof(float));
+    double err[2][2];
+    char msg[160];
+
+    CHECK(ys && yq, "allocation");
+    if (!ys || !yq) return;
+    for (int i = 0; i < M; i++)
+        for (int j = 0; j < N; j++)
+            fA[i * N + j] = (float)(sin(0.37 * i + 0.11 * j * (1 + i % 5)) *
+                                    (1.0 + 0.5 * l2t_rand(&rng)));
+    cblas_sgemv(CblasRowMajor, CblasNoTrans, M, N, 1.0f, fA, N, fx, 1, 0.0f,
+                ys, 1);
+
+    for (int b = 0; b < 2; b++)
+        for (int a = 0; a < 2; a++) {
+            l2_sq8mat qa;
+            double num = 0.0, den = 0.0;
+
+            l2_sq8_quantize(&qa, CblasRowMajor, M, N, fA, N, cmp_blocks[b],
+                            work, lwork);
+            l2_sq8gemv(CblasNoTrans, a ? L2_Q8_FP32 : L2_Q8_INT32, 1.0f, &qa,
+                       fx, 1, 0.0f, yq, 1);
+            for (int i = 0; i < M; i++) {
+                num += ((double)yq[i] - ys[i]) * ((double)yq[i] - ys[i]);
+                den += (double)ys[i] * ys[i];
+            }
+            err[b][a] = sqrt(num / den);
+        }
+
+    snprintf(msg, sizeof(msg),
+             "row scales: relative error int32 %.2e, fp32 %.2e below 1e-2",
+             err[0][0], err[0][1]);
+    CHECK(err[0][0] < 1e-2 && err[0][1] < 1e-2, msg);
+    snprintf(msg, sizeof(msg),
+             "block 32: relative error int32 %.2e, fp32 %.2e no larger",
+             err[1][0], err[1][1]);
+    CHECK(err[1][0] <= err[0][0] && err[1][1] <= err[0][1], msg);
+    free(ys);
+    free(yq);
+}
@@ -0,0 +1,313 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas_small.hpp"
+#include "l2test.h"
+
+/*
+ * The fixed-size C++ kernels against OpenBLAS: every compile-time order
+ * 1..16 (gemv also a set of rectangular shapes), both storage orders, all
+ * trans/uplo/diag, negative and non-unit increments, padded lda, and
+ * alpha/beta of 0.  The unreferenced triangle and the lda padding hold NaN,
+ * as does y whenever beta is 0, so reading any of them fails the compare.
+ * The runtime-size overloads are checked past 16 as well, where they hand
+ * the call to cblas.
+ *
+ * The gemv kernels are explicit vector code whose widths follow the ISA
+ * they are compiled for, so the Makefile also builds this file with -mavx2
+ * and -mavx512f (test_l2_small_avx2, test_l2_small_avx512, defining
+ * L2T_SMALL_TIER); those builds leave out the scalar symv/trmv cases and
+ * skip on CPUs without the ISA.
+ */
+
+#define MAXN 20
+#define PAD 3
+
+static const int incs[][2] = {{1, 1}, {2, -1}, {-3, 2}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+/* alpha, beta */
+static const double scal[][2] = {{0.7, -1.3}, {1.0, 0.0}, {0.0, 0.5}};
+#define NSCAL ((int)(sizeof(scal) / sizeof(scal[0])))
+
+static const CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+static const CBLAS_TRANSPOSE transes[4] = {CblasNoTrans, CblasTrans,
+                                           CblasConjNoTrans, CblasConjTrans};
+static const CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+static const CBLAS_DIAG diags[2] = {CblasNonUnit, CblasUnit};
+
+static unsigned rng = 20200u;
+
+static bool isa_ok(void) {
+#if defined(__AVX512F__)
+    if (!__builtin_cpu_supports("avx512f")) {
+        l2t_skip("built for AVX-512F, which this CPU lacks");
+        return false;
+    }
+#elif defined(__AVX2__)
+    if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) {
+        l2t_skip("built for AVX2+FMA, which this CPU lacks");
+        return false;
+    }
+#endif
+    return true;
+}
+
+template <typename T> struct data {
+    T a[(MAXN + PAD) * MAXN], x[3 * MAXN], y[3 * MAXN], yref[3 * MAXN];
+};
+
+/* rows x cols matrix in order o; NaN in the lda padding and, when tri is
+ * set, outside the up triangle. */
+template <typename T>
+static void fill(data<T> &d, CBLAS_ORDER o, int rows, int cols, int lda,
+                 int tri, CBLAS_UPLO up) {
+    for (int i = 0; i < (MAXN + PAD) * MAXN; i++) d.a[i] = (T)NAN;
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++) {
+            bool keep = !tri || (up == CblasUpper ? i <= j : i >= j);
+            int at = o == CblasColMajor ? i + j * lda : i * lda + j;
+            d.a[at] = keep ? (T)l2t_rand(&rng) : (T)NAN;
+        }
+    for (int i = 0; i < 3 * MAXN; i++) {
+        d.x[i] = (T)l2t_rand(&rng);
+        d.y[i] = d.yref[i] = (T)l2t_rand(&rng);
+    }
+}
+
+template <typename T>
+static bool close_all(const T *got, const T *ref, int n, int k) {
+    double eps = sizeof(T) == sizeof(float) ? FLT_EPSILON : DBL_EPSILON;
+
+    for (int i = 0; i < n; i++) {
+        double g = got[i], r = ref[i];
+        if (isnan(r) ? !isnan(g) : !(fabs(g - r) <= 8.0 * (k + 2) * eps))
+            return false;
+    }
+    return true;
+}
+
+template <int M, int N, typename T>
+static bool gemv_cases(void) {
+    bool ok = true;
+    data<T> d;
+
+    for (int oi = 0; oi < 2; oi++)
+        for (int ti = 0; ti < 4; ti++)
+            for (int c = 0; c < NINCS; c++)
+                for (int s = 0; s < NSCAL; s++) {
+                    CBLAS_ORDER o = orders[oi];
+                    CBLAS_TRANSPOSE t = transes[ti];
+                    int lda = (o == CblasColMajor ? M : N) + PAD;
+                    int ylen = l2::small_detail::plain(t) ? M : N;
+                    int ix = incs[c][0], iy = incs[c][1];
+                    T alpha = (T)scal[s][0], beta = (T)scal[s][1];
+
+                    fill(d, o, M, N, lda, 0, CblasUpper);
+                    if (beta == 0)
+                        for (int i = 0; i < 3 * MAXN; i++)
+                            d.y[i] = d.yref[i] = (T)NAN;
+                    l2::gemv<M, N>(o, t, alpha, d.a, lda, d.x, ix, beta,
+                                   d.y, iy);
+                    l2::small_detail::cblas_gemv(o, t, M, N, alpha, d.a, lda,
+                                                 d.x, ix, beta, d.yref, iy);
+                    ok &= close_all(d.y, d.yref, ylen * abs(iy),
+                                    M > N ? M : N);
+                }
+    return ok;
+}
+
+template <int N, typename T>
+static bool symv_cases(void) {
+    bool ok = true;
+    data<T> d;
+
+    for (int oi = 0; oi < 2; oi++)
+        for (int ui = 0; ui < 2; ui++)
+            for (int c = 0; c < NINCS; c++)
+                for (int s = 0; s < NSCAL; s++) {
+                    CBLAS_ORDER o = orders[oi];
+                    CBLAS_UPLO u = uplos[ui];
+                    int ix = incs[c][0], iy = incs[c][1];
+                    T alpha = (T)scal[s][0], beta = (T)scal[s][1];
+                    /* the stored triangle of the caller's view */
+                    CBLAS_UPLO cm = (u == CblasUpper) == (o == CblasColMajor)
+                                        ? CblasUpper : CblasLower;
+
+                    fill(d, CblasColMajor, N, N, N + PAD, 1, cm);
+                    if (beta == 0)
+                        for (int i = 0; i < 3 * MAXN; i++)
+                            d.y[i] = d.yref[i] = (T)NAN;
+                    l2::symv<N>(o, u, alpha, d.a, N + PAD, d.x, ix, beta,
+                                d.y, iy);
+                    l2::small_detail::cblas_symv(o, u, N, alpha, d.a, N + PAD,
+                                                 d.x, ix, beta, d.yref, iy);
+                    ok &= close_all(d.y, d.yref, N * abs(iy), N);
+                }
+    return ok;
+}
+
+template <int N, typename T>
+static bool trmv_cases(void) {
+    bool ok = true;
+    data<T> d;
+
+    for (int oi = 0; oi < 2; oi++)
+        for (int ui = 0; ui < 2; ui++)
+            for (int ti = 0; ti < 4; ti++)
+                for (int di = 0; di < 2; di++)
+                    for (int c = 0; c < NINCS; c++) {
+                        CBLAS_ORDER o = orders[oi];
+                        CBLAS_UPLO u = uplos[ui];
+                        int ix = incs[c][0];
+                        CBLAS_UPLO cm =
+                            (u == CblasUpper) == (o == CblasColMajor)
+                                ? CblasUpper : CblasLower;
+
+                        fill(d, CblasColMajor, N, N, N + PAD, 1, cm);
+                        /* NaN on a unit diagonal must not be read either */
+                        if (diags[di] == CblasUnit)
+                            for (int i = 0; i < N; i++)
+                                d.a[i * (N + PAD + 1)] = (T)NAN;
+                        for (int i = 0; i < 3 * MAXN; i++) d.yref[i] = d.x[i];
+                        l2::trmv<N>(o, u, transes[ti], diags[di], d.a,
+                                    N + PAD, d.x, ix);
+                        l2::small_detail::cblas_trmv(o, u, transes[ti],
+                                                     diags[di], N, d.a,
+                                                     N + PAD, d.yref, ix);
+                        ok &= close_all(d.x, d.yref, N * abs(ix), N);
+                    }
+    return ok;
+}
+
+/* Runs F<n, T> for n = N..16 and ANDs the results. */
+template <template <int, typename> class F, int N, typename T>
+struct upto16 {
+    static bool run(void) {
+        return F<N, T>::run() & upto16<F, N + 1, T>::run();
+    }
+};
+template <template <int, typename> class F, typename T>
+struct upto16<F, 17, T> {
+    static bool run(void) { return true; }
+};
+
+template <int N, typename T> struct sq_gemv {
+    static bool run(void) { return gemv_cases<N, N, T>(); }
+};
+template <int N, typename T> struct sq_symv {
+    static bool run(void) { return symv_cases<N, T>(); }
+};
+template <int N, typename T> struct sq_trmv {
+    static bool run(void) { return trmv_cases<N, T>(); }
+};
+
+L2T_TEST(test_small_sgemv_fixed) {
+    if (!isa_ok()) return;
+    CHECK((upto16<sq_gemv, 1, float>::run()),
+          "l2::gemv<n, n, float>: n = 1..16 match cblas_sgemv");
+    CHECK((gemv_cases<2, 3, float>() && gemv_cases<3, 4, float>() &&
+           gemv_cases<4, 3, float>() && gemv_cases<1, 16, float>() &&
+           gemv_cases<16, 1, float>() && gemv_cases<6, 11, float>()),
+          "l2::gemv<m, n, float>: rectangular shapes match cblas_sgemv");
+}
+
+L2T_TEST(test_small_dgemv_fixed) {
+    if (!isa_ok()) return;
+    CHECK((upto16<sq_gemv, 1, double>::run()),
+          "l2::gemv<n, n, double>: n = 1..16 match cblas_dgemv");
+    CHECK((gemv_cases<2, 3, double>() && gemv_cases<3, 4, double>() &&
+           gemv_cases<4, 3, double>() && gemv_cases<1, 16, double>() &&
+           gemv_cases<16, 1, double>() && gemv_cases<6, 11, double>()),
+          "l2::gemv<m, n, double>: rectangular shapes match cblas_dgemv");
+}
+
+#ifndef L2T_SMALL_TIER
+L2T_TEST(test_small_ssymv_fixed) {
+    if (!isa_ok()) return;
+    CHECK((upto16<sq_symv, 1, float>::run()),
+          "l2::symv<n, float>: n = 1..16 match cblas_ssymv");
+}
+
+L2T_TEST(test_small_dsymv_fixed) {
+    if (!isa_ok()) return;
+    CHECK((upto16<sq_symv, 1, double>::run()),
+          "l2::symv<n, double>: n = 1..16 match cblas_dsymv");
+}
+
+L2T_TEST(test_small_strmv_fixed) {
+    if (!isa_ok()) return;
+    CHECK((upto16<sq_trmv, 1, float>::run()),
+          "l2::trmv<n, float>: n = 1..16 match cblas_strmv");
+}
+
+L2T_TEST(test_small_dtrmv_fixed) {
+    if (!isa_ok()) return;
+    CHECK((upto16<sq_trmv, 1, double>::run()),
+          "l2::trmv<n, double>: n = 1..16 match cblas_dtrmv");
+}
+#endif
+
+/* Runtime sizes 1..MAXN: fixed kernels up to 16, cblas beyond and for 1. */
+L2T_TEST(test_small_dispatch) {
+    bool ok = true;
+    data<double> d;
+
+    if (!isa_ok()) return;
+    for (int n = 1; n <= MAXN; n++) {
+        l2t_fill(&rng, d.a, NULL, (MAXN + PAD) * MAXN);
+        for (int i = 0; i < 3 * MAXN; i++) {
+            d.x[i] = l2t_rand(&rng);
+            d.y[i] = d.yref[i] = l2t_rand(&rng);
+        }
+        l2::gemv(CblasColMajor, CblasTrans, n, n, 0.5, d.a, n + PAD, d.x, 2,
+                 1.5, d.y, -1);
+        cblas_dgemv(CblasColMajor, CblasTrans, n, n, 0.5, d.a, n + PAD, d.x,
+                    2, 1.5, d.yref, -1);
+        ok &= close_all(d.y, d.yref, n, n);
+        l2::gemv(CblasRowMajor, CblasNoTrans, n, n + 1, 0.5, d.a, n + PAD,
+                 d.x, 1, 1.5, d.y, 1);
+        cblas_dgemv(CblasRowMajor, CblasNoTrans, n, n + 1, 0.5, d.a, n + PAD,
+                    d.x, 1, 1.5, d.yref, 1);
+        ok &= close_all(d.y, d.yref, n, n);
+        l2::symv(CblasRowMajor, CblasUpper, n, -1.0, d.a, n + PAD, d.x, 1,
+                 0.25, d.y, 3);
+        cblas_dsymv(CblasRowMajor, CblasUpper, n, -1.0, d.a, n + PAD, d.x, 1,
+                    0.25, d.yref, 3);
+        ok &= close_all(d.y, d.yref, 3 * n, n);
+        for (int i = 0; i < 3 * MAXN; i++) d.yref[i] = d.x[i];
+        l2::trmv(CblasColMajor, CblasLower, CblasNoTrans, CblasNonUnit, n,
+                 d.a, n + PAD, d.x, -2);
+        cblas_dtrmv(CblasColMajor, CblasLower, CblasNoTrans, CblasNonUnit, n,
+                    d.a, n + PAD, d.yref, -2);
+        ok &= close_all(d.x, d.yref, 2 * n, n);
+    }
+    CHECK(ok, "l2::gemv/symv/trmv runtime sizes 1..20 match cblas");
+}
+
+/* Values cblas does not define go to cblas, which rejects them untouched. */
+L2T_TEST(test_small_invalid_enums) {
+    bool ok = true;
+    data<double> d;
+    double x0[3 * MAXN];
+
+    if (!isa_ok()) return;
+    fill(d, CblasColMajor, 4, 4, 4, 0, CblasUpper);
+    for (int i = 0; i < 3 * MAXN; i++) d.y[i] = x0[i] = d.x[i];
+    l2::gemv<4, 4>(CblasColMajor, (CBLAS_TRANSPOSE)0, 1.0, d.a, 4, d.x, 1,
+                   0.0, d.y, 1);
+    l2::gemv<4, 4>((CBLAS_ORDER)0, CblasNoTrans, 1.0, d.a, 4, d.x, 1, 0.0,
+                   d.y, 1);
+    l2::symv<4>(CblasColMajor, (CBLAS_UPLO)0, 1.0, d.a, 4, d.x, 1, 0.0, d.y,
+                1);
+    l2::trmv<4>(CblasColMajor, CblasUpper, CblasNoTrans, (CBLAS_DIAG)0, d.a,
+                4, d.x, 1);
+    l2::trmv<4>(CblasColMajor, (CBLAS_UPLO)0, CblasNoTrans, CblasNonUnit,
+                d.a, 4, d.x, 1);
+    for (int i = 0; i < 3 * MAXN; i++)
+        ok &= d.x[i] == x0[i] && d.y[i] == x0[i];
+    CHECK(ok, "l2::gemv/symv/trmv: invalid order/trans/uplo/diag leave "
+              "x and y alone");
+}
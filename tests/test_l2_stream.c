@@ -0,0 +1,240 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Out-of-core gemv: l2_?gemv_mapped on a matrix in a temporary file
+ * against cblas_?gemv on the same matrix in memory, for both orders and
+ * transposes, positive and negative increments and lda > rows.  The matrix
+ * starts past a header that is not page aligned, and panels of one line,
+ * of a few lines not ending on a page and the default size all run, so
+ * panel seams and mapping offsets are covered.  Then the error returns,
+ * and which passes leave A in the page cache.
+ */
+
+#define MAXN   300
+#define LDPAD  3
+#define HEADER 1000     /* bytes before A: a multiple of 8, not of a page */
+
+static const int sizes[][2] = {{1, 1}, {1, 37}, {37, 1}, {37, 300},
+                               {300, 37}, {300, 300}};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int incs[][2] = {{1, 1}, {2, -3}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const size_t panels[] = {1, 5000, 0};
+#define NPANELS ((int)(sizeof(panels) / sizeof(panels[0])))
+
+/* A with lda = MAXN + LDPAD, as floats and doubles; both written to fd. */
+static float  *sA, *sx, *sy, *syref;
+static double *dA, *dx, *dy, *dyref;
+static int fd = -1;
+static long s_off, d_off;
+
+static unsigned rng = 2718u;
+
+static int write_all(const void *p, size_t bytes) {
+    const char *c = p;
+
+    while (bytes > 0) {
+        ssize_t w = write(fd, c, bytes);
+        if (w <= 0) return 0;
+        c += w;
+        bytes -= (size_t)w;
+    }
+    return 1;
+}
+
+L2T_SETUP(make_file) {
+    size_t na = (size_t)MAXN * (MAXN + LDPAD), nv = 3 * (size_t)MAXN;
+    const char *dir = getenv("TMPDIR");
+    char path[512], header[HEADER];
+
+    if (!l2t_alloc_sd(na, &dA, &sA) || !l2t_alloc_sd(nv, &dx, &sx) ||
+        !l2t_alloc_sd(nv, &dy, &sy) || !l2t_alloc_sd(nv, &dyref, &syref))
+        return 0;
+    l2t_fill(&rng, dA, sA, na);
+    l2t_fill(&rng, dx, sx, nv);
+
+    /* header, then the float matrix, then the double one; unlinked at once */
+    snprintf(path, sizeof(path), "%s/l2stream.XXXXXX",
+             dir && *dir ? dir : "/tmp");
+    fd = mkstemp(path);
+    if (fd < 0) return 0;
+    unlink(path);
+    memset(header, 0x7f, sizeof(header));
+    s_off = HEADER;
+    d_off = HEADER + (long)(na * sizeof(float));
+    /* synced, so that dropping the pages does not wait on writeback */
+    return write_all(header, sizeof(header)) &&
+           write_all(sA, na * sizeof(float)) &&
+           write_all(dA, na * sizeof(double)) && fdatasync(fd) == 0;
+}
+
+static int stream_case(char p, enum CBLAS_ORDER o, enum CBLAS_TRANSPOSE t,
+                       int m, int n, int incx, int incy) {
+    int lda = MAXN + LDPAD, plain = t == CblasNoTrans;
+    int leny = plain ? m : n, lenx = plain ? n : m;
+    size_t len = (size_t)(1 + (leny - 1) * abs(incy));
+    double eps = p == 's' ? FLT_EPSILON : DBL_EPSILON;
+    double ymax = 0.0, tol;
+    int rc;
+
+    for (size_t i = 0; i < len; i++) {
+        syref[i] = sy[i] = 0.5f * sx[i + 1];
+        dyref[i] = dy[i] = 0.5 * dx[i + 1];
+    }
+    if (p == 's') {
+        rc = l2_sgemv_mapped(o, t, m, n, 0.7f, fd, s_off, lda, sx, incx,
+                             -0.4f, sy, incy);
+        cblas_sgemv(o, t, m, n, 0.7f, sA, lda, sx, incx, -0.4f, syref, incy);
+    } else {
+        rc = l2_dgemv_mapped(o, t, m, n, 0.7, fd, d_off, lda, dx, incx,
+                             -0.4, dy, incy);
+        cblas_dgemv(o, t, m, n, 0.7, dA, lda, dx, incx, -0.4, dyref, incy);
+    }
+    if (rc != 0) return 0;
+
+    for (size_t i = 0; i < len; i++) {
+        double r = p == 's' ? syref[i] : dyref[i];
+        if (fabs(r) > ymax) ymax = fabs(r);
+    }
+    tol = 16.0 * (lenx + 2) * eps * (ymax + 1.0);
+    for (size_t i = 0; i < len; i++) {
+        double got = p == 's' ? sy[i] : dy[i];
+        double ref = p == 's' ? syref[i] : dyref[i];
+        if (!(fabs(got - ref) <= tol)) return 0;
+    }
+    return 1;
+}
+
+L2T_CORE_TEST(test_stream_sweep) {
+    static const char precs[2] = {'s', 'd'};
+    static const enum CBLAS_TRANSPOSE transes[2] = {CblasNoTrans, CblasTrans};
+    char msg[128];
+
+    for (int p = 0; p < 2; p++)
+        for (int o = 0; o < 2; o++)
+            for (int pb = 0; pb < NPANELS; pb++) {
+                enum CBLAS_ORDER ord = o ? CblasColMajor : CblasRowMajor;
+                int ok = 1;
+
+                l2_set_stream_panel(panels[pb]);
+                for (int s = 0; s < NSIZES; s++)
+                    for (int t = 0; t < 2; t++)
+                        for (int c = 0; c < NINCS; c++)
+                            ok &= stream_case(precs[p], ord, transes[t],
+                                              sizes[s][0], sizes[s][1],
+                                              incs[c][0], incs[c][1]);
+                snprintf(msg, sizeof(msg),
+                         "l2_%cgemv_mapped[%s]: %s, panel %zu bytes, matches "
+                         "OpenBLAS", precs[p], core,
+                         o ? "ColMajor" : "RowMajor", panels[pb]);
+                CHECK(ok, msg);
+            }
+    l2_set_stream_panel(0);
+}
+
+/* alpha = 0 never reads A; beta = 0 overwrites NaN in y. */
+L2T_TEST(test_stream_scalars) {
+    float y[3] = {1.0f, NAN, 3.0f};
+    double ys[3] = {NAN, NAN, NAN};
+    int ok;
+
+    ok = l2_sgemv_mapped(CblasColMajor, CblasNoTrans, 3, MAXN, 0.0f, fd,
+                         s_off, MAXN + LDPAD, sx, 1, 2.0f, y, 1) == 0 &&
+         y[0] == 2.0f && isnan(y[1]) && y[2] == 6.0f;
+    CHECK(ok, "l2_sgemv_mapped: alpha = 0 scales y by beta");
+
+    ok = l2_dgemv_mapped(CblasRowMajor, CblasTrans, 7, 3, 1.0, fd, d_off,
+                         MAXN + LDPAD, dx, 1, 0.0, ys, 1) == 0;
+    for (int i = 0; i < 3; i++) {
+        double r = 0;
+        for (int k = 0; k < 7; k++)
+            r += dA[(size_t)k * (MAXN + LDPAD) + i] * dx[k];
+        ok &= fabs(ys[i] - r) <= 1e-12;
+    }
+    CHECK(ok, "l2_dgemv_mapped: beta = 0 ignores NaN in y");
+}
+
+L2T_TEST(test_stream_errors) {
+    int lda = MAXN + LDPAD;
+    double y[MAXN];
+
+    errno = 0;
+    CHECK(l2_dgemv_mapped(CblasColMajor, CblasNoTrans, 4, 4, 1.0, -1, 0,
+                          lda, dx, 1, 0.0, y, 1) == -1 && errno == EINVAL,
+          "l2_dgemv_mapped: fd < 0 is EINVAL");
+    errno = 0;
+    CHECK(l2_dgemv_mapped(CblasColMajor, CblasNoTrans, 4, 4, 1.0, fd,
+                          d_off + 4, lda, dx, 1, 0.0, y, 1) == -1 &&
+          errno == EINVAL, "l2_dgemv_mapped: misaligned offset is EINVAL");
+    errno = 0;
+    CHECK(l2_dgemv_mapped(CblasColMajor, CblasNoTrans, MAXN, MAXN, 1.0, fd,
+                          d_off + 8 * lda, lda, dx, 1, 0.0, y, 1) == -1 &&
+          errno == EINVAL, "l2_dgemv_mapped: file too short is EINVAL");
+    errno = 0;
+    CHECK(l2_sgemv_mapped(CblasColMajor, CblasNoTrans, 4, 4, 1.0f, fd, s_off,
+                          2, sx, 1, 0.0f, sy, 1) == -1 && errno == EINVAL,
+          "l2_sgemv_mapped: lda < m is EINVAL");
+}
+
+/*
+ * Pages wholly inside the float matrix that are in the page cache, of how
+ * many, or -1 if mincore is not available.
+ */
+static long resident_pages(long *total) {
+    long page = sysconf(_SC_PAGESIZE);
+    long first = (s_off + page - 1) / page, last = d_off / page;
+    size_t len = (size_t)d_off;
+    unsigned char vec[MAXN * (MAXN + LDPAD) * sizeof(float) / 4096 + 4];
+    void *map = mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    long n = 0;
+
+    *total = last - first;
+    if (map == MAP_FAILED) return -1;
+    if ((long)((len + page - 1) / page) > (long)sizeof(vec) ||
+        mincore(map, len, vec) != 0) {
+        munmap(map, len);
+        return -1;
+    }
+    for (long i = first; i < last; i++) n += vec[i] & 1;
+    munmap(map, len);
+    return n;
+}
+
+/*
+ * A far below half of RAM stays cached after a pass; with the threshold
+ * below its size, the pass drops it.
+ */
+L2T_TEST(test_stream_evict) {
+    int lda = MAXN + LDPAD;
+    long total, kept, dropped;
+
+    l2_set_stream_evict(0);
+    l2_sgemv_mapped(CblasColMajor, CblasNoTrans, MAXN, MAXN, 1.0f, fd, s_off,
+                    lda, sx, 1, 0.0f, sy, 1);
+    kept = resident_pages(&total);
+    l2_set_stream_evict(1);
+    l2_sgemv_mapped(CblasColMajor, CblasNoTrans, MAXN, MAXN, 1.0f, fd, s_off,
+                    lda, sx, 1, 0.0f, sy, 1);
+    dropped = resident_pages(&total);
+    l2_set_stream_evict(0);
+    if (kept < 0 || dropped < 0) {
+        l2t_skip("mincore not available");
+        return;
+    }
+    CHECK(kept == total, "l2_sgemv_mapped: a small A stays in the page cache");
+    CHECK(dropped == 0,
+          "l2_sgemv_mapped: A above the l2_set_stream_evict threshold is "
+          "dropped");
+}
@@ -0,0 +1,294 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Differential tests: l2_?syr, l2_?her, l2_?syr2 and l2_?her2 against
+ * OpenBLAS for every kernel tier, both triangles and orders, and for 1 and
+ * 4 threads.  Sizes
+ * hit the four-column groups of the diagonal block, the vector tails, and
+ * go past one row tile (512 rows, 256 for complex double).  lda is n plus
+ * 3 and the whole array is compared, so a write into the other triangle
+ * or the padding is a mismatch.
+ */
+
+#define MAXN 1100
+#define PAD 3
+
+static const int sizes[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33,
+                            64, 100, 530};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int incs[][2] = {{1, 1}, {2, 3}, {-1, -2}, {1, -1}};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+static const char *order_name[2] = {"RowMajor", "ColMajor"};
+static const enum CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+static const char *uplo_name[2] = {"Upper", "Lower"};
+
+static const char *op_name[2][4] = {{"ssyr", "dsyr", "cher", "zher"},
+                                     {"ssyr2", "dsyr2", "cher2", "zher2"}};
+static const char precs[] = {'s', 'd', 'c', 'z'};
+
+/* Matrices and vectors as reals; complex data interleaves (re, im). */
+static float  *sA0, *sA, *sAref, *sx, *sy;
+static double *dA0, *dA, *dAref, *dx, *dy;
+
+static unsigned rng = 2727u;
+
+L2T_SETUP(alloc_inputs) {
+    size_t na = 2 * (size_t)(MAXN + PAD) * MAXN;
+    size_t nv = 2 * 3 * (size_t)MAXN;
+
+    if (!l2t_alloc_sd(na, &dA0, &sA0) || !l2t_alloc_sd(na, &dA, &sA) ||
+        !l2t_alloc_sd(na, &dAref, &sAref) || !l2t_alloc_sd(nv, &dx, &sx) ||
+        !l2t_alloc_sd(nv, &dy, &sy))
+        return 0;
+    l2t_fill(&rng, dA0, sA0, na);
+    l2t_fill(&rng, dx, sx, nv);
+    l2t_fill(&rng, dy, sy, nv);
+    return 1;
+}
+
+static const float  c_alpha[2] = {0.7f, -0.4f};
+static const double z_alpha[2] = {0.7, -0.4};
+
+/*
+ * The diagonal of A0 keeps its nonzero imaginary parts: her and her2 must
+ * come out with them zeroed, as OpenBLAS does.  rank 1 ignores y.
+ */
+static int syr_case(int rank, char p, enum CBLAS_ORDER o,
+                    enum CBLAS_UPLO u, int n, int incx, int incy) {
+    int cs = l2t_is_cplx(p) ? 2 : 1;
+    int lda = n + PAD;
+    size_t len = (size_t)lda * n * cs;
+    double eps = l2t_is_single(p) ? FLT_EPSILON : DBL_EPSILON;
+
+    if (l2t_is_single(p)) {
+        memcpy(sA, sA0, len * sizeof(float));
+        memcpy(sAref, sA0, len * sizeof(float));
+    } else {
+        memcpy(dA, dA0, len * sizeof(double));
+        memcpy(dAref, dA0, len * sizeof(double));
+    }
+    switch (rank == 1 ? p : p - 'a' + 'A') {
+    case 's':
+        l2_ssyr(o, u, n, 0.7f, sx, incx, sA, lda);
+        cblas_ssyr(o, u, n, 0.7f, sx, incx, sAref, lda);
+        break;
+    case 'd':
+        l2_dsyr(o, u, n, 0.7, dx, incx, dA, lda);
+        cblas_dsyr(o, u, n, 0.7, dx, incx, dAref, lda);
+        break;
+    case 'c':
+        l2_cher(o, u, n, 0.7f, sx, incx, sA, lda);
+        cblas_cher(o, u, n, 0.7f, sx, incx, sAref, lda);
+        break;
+    case 'z':
+        l2_zher(o, u, n, 0.7, dx, incx, dA, lda);
+        cblas_zher(o, u, n, 0.7, dx, incx, dAref, lda);
+        break;
+    case 'S':
+        l2_ssyr2(o, u, n, 0.7f, sx, incx, sy, incy, sA, lda);
+        cblas_ssyr2(o, u, n, 0.7f, sx, incx, sy, incy, sAref, lda);
+        break;
+    case 'D':
+        l2_dsyr2(o, u, n, 0.7, dx, incx, dy, incy, dA, lda);
+        cblas_dsyr2(o, u, n, 0.7, dx, incx, dy, incy, dAref, lda);
+        break;
+    case 'C':
+        l2_cher2(o, u, n, c_alpha, sx, incx, sy, incy, sA, lda);
+        cblas_cher2(o, u, n, c_alpha, sx, incx, sy, incy, sAref, lda);
+        break;
+    default:
+        l2_zher2(o, u, n, z_alpha, dx, incx, dy, incy, dA, lda);
+        cblas_zher2(o, u, n, z_alpha, dx, incx, dy, incy, dAref, lda);
+        break;
+    }
+
+    /* |a| <= 1 and each of the two terms <= 2 * 1.1: a few roundings */
+    for (size_t i = 0; i < len; i++) {
+        double got = l2t_is_single(p) ? sA[i] : dA[i];
+        double ref = l2t_is_single(p) ? sAref[i] : dAref[i];
+        if (!(fabs(got - ref) <= 32.0 * eps)) return 0;
+    }
+    return 1;
+}
+
+L2T_CORE_TEST(test_syr_sweep) {
+    char msg[128];
+
+    for (int r = 0; r < 2; r++)
+        for (int p = 0; p < 4; p++)
+            for (int oi = 0; oi < 2; oi++)
+                for (int ui = 0; ui < 2; ui++) {
+                    int ok = 1;
+                    for (int a = 0; a < NSIZES; a++)
+                        for (int c = 0; c < NINCS; c++)
+                            ok &= syr_case(r + 1, precs[p], orders[oi],
+                                           uplos[ui], sizes[a], incs[c][0],
+                                           incs[c][1]);
+                    snprintf(msg, sizeof(msg),
+                             "l2_%s[%s]: %s %s matches OpenBLAS",
+                             op_name[r][p], core, order_name[oi],
+                             uplo_name[ui]);
+                    CHECK(ok, msg);
+                }
+}
+
+/*
+ * Several threads: column blocks of equal cost, which for an upper
+ * triangle put the short first columns in one wide block and for a lower
+ * one the other way round; 1100 rows is more than one tile per block.
+ */
+L2T_TEST(test_syr_threads) {
+    static const int tn[] = {200, 530, MAXN};
+    int saved = l2_get_num_threads();
+    char msg[128];
+
+    l2_set_num_threads(4);
+    for (int r = 0; r < 2; r++)
+        for (int p = 0; p < 4; p++) {
+            int ok = 1;
+            for (int oi = 0; oi < 2; oi++)
+                for (int ui = 0; ui < 2; ui++)
+                    for (int s = 0; s < 3; s++)
+                        for (int c = 0; c < NINCS; c++)
+                            ok &= syr_case(r + 1, precs[p], orders[oi],
+                                           uplos[ui], tn[s], incs[c][0],
+                                           incs[c][1]);
+            snprintf(msg, sizeof(msg),
+                     "l2_%s: large updates with 4 threads match OpenBLAS",
+                     op_name[r][p]);
+            CHECK(ok, msg);
+        }
+    l2_set_num_threads(saved);
+}
+
+/* Cost of lines [lo, hi) of an n-line triangle: elements + c per line. */
+static double tri_cost(BLASLONG n, int grows, double c, BLASLONG lo,
+                       BLASLONG hi) {
+    double s = 0;
+
+    for (BLASLONG i = lo; i < hi; i++)
+        s += (grows ? i + 1 : n - i) + c;
+    return s;
+}
+
+/*
+ * The partitioner: bounds from 0 to n, monotone, on multiples of align,
+ * and every block within align of the longest lines of the mean cost (each
+ * bound is off by at most align / 2 lines), under 10% of it once the
+ * blocks span many alignments; with and without a cost per line.
+ */
+L2T_TEST(test_tri_split) {
+    static const BLASLONG ns[] = {1, 15, 16, 100, 1000, 4096, 10007};
+    static const int parts[] = {1, 2, 3, 4, 7, 16, 64};
+    static const BLASLONG costs[] = {0, 512};
+    int ok = 1, balanced = 1;
+
+    for (int a = 0; a < 7; a++)
+        for (int b = 0; b < 7; b++)
+            for (int g = 0; g < 4; g++) {
+                BLASLONG n = ns[a], align = 16, prev = 0, c = costs[g / 2];
+                double mean = tri_cost(n, g & 1, c, 0, n) / parts[b];
+
+                ok &= l2_tri_split(n, g & 1, c, 0, parts[b], align) == 0 &&
+                      l2_tri_split(n, g & 1, c, parts[b], parts[b],
+                                   align) == n;
+                for (int k = 1; k <= parts[b]; k++) {
+                    BLASLONG r = l2_tri_split(n, g & 1, c, k, parts[b],
+                                              align);
+                    double d = fabs(tri_cost(n, g & 1, c, prev, r) - mean);
+
+                    ok &= r >= prev && (r == n || r % align == 0);
+                    balanced &= d <= align * (double)(n + c);
+                    if (n >= 4096 && parts[b] <= 8)
+                        balanced &= d <= 0.10 * mean;
+                    prev = r;
+                }
+            }
+    CHECK(ok, "l2_tri_split: bounds 0..n, monotone, aligned");
+    CHECK(balanced, "l2_tri_split: blocks of equal cost");
+}
+
+/*
+ * Slot timing through the pool: one time per slot, and a threaded dsyr
+ * with equal-cost blocks keeps its slots within a factor of two of each
+ * other where equal column counts would give 1:3 and more.  CPU time per
+ * slot, so the bound holds on a loaded machine too.
+ */
+L2T_TEST(test_syr_slot_times) {
+    int saved = l2_get_num_threads();
+    double sec[4], lo, hi;
+    int ns;
+
+    l2_set_num_threads(4);
+    l2_set_slot_timing(1);
+    syr_case(1, 'd', CblasColMajor, CblasLower, MAXN, 1, 1);
+    ns = l2_get_slot_times(sec, 4);
+    l2_set_slot_timing(0);
+    l2_set_num_threads(saved);
+
+    CHECK(ns == 4, "l2_get_slot_times: one time per slot");
+    lo = hi = sec[0];
+    for (int t = 1; t < ns && t < 4; t++) {
+        lo = fmin(lo, sec[t]);
+        hi = fmax(hi, sec[t]);
+    }
+    CHECK(ns == 4 && lo > 0 && hi < 2.0 * lo,
+          "l2_dsyr: equal-area slots take comparable time");
+}
+
+/* her2 on x = y = (1+i): the diagonal gains 2 Re(alpha) |x|^2 and no more. */
+L2T_TEST(test_her2_diagonal_real) {
+    float  ca[2 * 9], cx[6], cal[2] = {0.5f, 3.0f};
+    double za[2 * 9], zx[6], zal[2] = {0.5, 3.0};
+    int ok = 1;
+
+    for (int i = 0; i < 18; i++) {
+        ca[i] = 1.0f;
+        za[i] = 1.0;
+    }
+    for (int i = 0; i < 6; i++) {
+        cx[i] = 1.0f;
+        zx[i] = 1.0;
+    }
+    l2_cher2(CblasColMajor, CblasLower, 3, cal, cx, 1, cx, 1, ca, 3);
+    l2_zher2(CblasRowMajor, CblasUpper, 3, zal, zx, 1, zx, 1, za, 3);
+    for (int j = 0; j < 3; j++)
+        ok &= ca[8 * j] == 3.0f && ca[8 * j + 1] == 0.0f &&
+              za[8 * j] == 3.0 && za[8 * j + 1] == 0.0;
+    CHECK(ok, "l2_?her2: diagonal is real, imaginary inputs dropped");
+}
+
+/* alpha = 0 is a quick return: A is not even read, NaNs included. */
+L2T_TEST(test_syr_alpha_zero_quick_return) {
+    static const float  c_zero[2] = {0.0f, 0.0f};
+    static const double z_zero[2] = {0.0, 0.0};
+    float  sa[8], sv[4] = {NAN, 1.0f, NAN, 2.0f};
+    double da[8], dv[4] = {NAN, 1.0, NAN, 2.0};
+    int ok = 1;
+
+    for (int i = 0; i < 8; i++) {
+        sa[i] = (float)i;
+        da[i] = (double)i;
+    }
+    l2_ssyr2(CblasColMajor, CblasUpper, 2, 0.0f, sv, 1, sv, 1, sa, 2);
+    l2_dsyr2(CblasRowMajor, CblasLower, 2, 0.0, dv, 1, dv, 1, da, 2);
+    l2_cher2(CblasColMajor, CblasLower, 2, c_zero, sv, 1, sv, 1, sa, 2);
+    l2_zher2(CblasRowMajor, CblasUpper, 2, z_zero, dv, 1, dv, 1, da, 2);
+    l2_ssyr(CblasRowMajor, CblasLower, 2, 0.0f, sv, 1, sa, 2);
+    l2_dsyr(CblasColMajor, CblasUpper, 2, 0.0, dv, 1, da, 2);
+    l2_cher(CblasColMajor, CblasUpper, 2, 0.0f, sv, 1, sa, 2);
+    l2_zher(CblasRowMajor, CblasLower, 2, 0.0, dv, 1, da, 2);
+    for (int i = 0; i < 8; i++)
+        ok &= sa[i] == (float)i && da[i] == (double)i;
+    CHECK(ok, "l2_?syr/her/syr2/her2: alpha=0 leaves A untouched");
+}
@@ -0,0 +1,262 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2test.h"
+
+/*
+ * Differential tests: l2_?trsv and l2_?trmv against OpenBLAS for all four
+ * precisions, every uplo/trans/diag, every kernel tier, and 1 and 4
+ * threads.  Sizes straddle the diagonal block order (256) and strip width
+ * (8); the threaded calls at MAXN take ztrmv over more than one band.  A
+ * is diagonally dominant so the solve is well conditioned; with CblasUnit
+ * the stored diagonal is still the dominant one and must be ignored.
+ */
+
+#define MAXN 2100
+
+static const int sizes[] = {1, 2, 3, 7, 8, 9, 17, 64, 255, 256, 257, 700};
+#define NSIZES ((int)(sizeof(sizes) / sizeof(sizes[0])))
+
+static const int incs[] = {1, 2, -1};
+#define NINCS ((int)(sizeof(incs) / sizeof(incs[0])))
+
+static const char precs[] = {'s', 'd', 'c', 'z'};
+
+/* Matrices and vectors as reals; complex data interleaves (re, im). */
+static float  *sA, *sb, *sx, *sxref;
+static double *dA, *db, *dx, *dxref;
+
+static unsigned rng = 31337u;
+
+L2T_SETUP(alloc_inputs) {
+    size_t na = 2 * (size_t)MAXN * MAXN, nv = 2 * 2 * (size_t)MAXN;
+
+    if (!l2t_alloc_sd(na, &dA, &sA) || !l2t_alloc_sd(nv, &db, &sb) ||
+        !l2t_alloc_sd(nv, &dx, &sx) || !l2t_alloc_sd(nv, &dxref, &sxref))
+        return 0;
+    for (size_t i = 0; i < na; i++) {
+        dA[i] = l2t_rand(&rng) / MAXN;
+        sA[i] = (float)dA[i];
+    }
+    l2t_fill(&rng, db, sb, nv);
+    return 1;
+}
+
+/*
+ * Makes the diagonal of the leading n x n (lda = n) matrix dominant, after
+ * returning the previous call's diagonal to off-diagonal magnitudes.
+ */
+static void set_diagonal(int n, int cplx) {
+    static int last_n = 0, last_cs = 1;
+
+    for (int i = 0; i < last_n; i++) {
+        size_t k = (size_t)i * (last_n + 1) * last_cs;
+        dA[k] = l2t_rand(&rng) / MAXN;
+        sA[k] = (float)dA[k];
+    }
+    last_n = n;
+    last_cs = cplx ? 2 : 1;
+    for (int i = 0; i < n; i++) {
+        size_t k = (size_t)i * (n + 1) * last_cs;
+        dA[k] = 2.0 + l2t_rand(&rng);
+        sA[k] = (float)dA[k];
+    }
+}
+
+/* One trsv (mv = 0) or trmv (mv = 1) call of each library, compared. */
+static int tr_case(int mv, char p, enum CBLAS_ORDER o, enum CBLAS_UPLO u,
+                   enum CBLAS_TRANSPOSE t, enum CBLAS_DIAG d, int n,
+                   int incx) {
+    int cplx = l2t_is_cplx(p);
+    size_t len = (size_t)(1 + (n - 1) * abs(incx)) * (cplx ? 2 : 1);
+    double eps = l2t_is_single(p) ? FLT_EPSILON : DBL_EPSILON;
+    double xmax = 0.0, tol;
+
+    if (l2t_is_single(p)) {
+        memcpy(sx, sb, len * sizeof(float));
+        memcpy(sxref, sb, len * sizeof(float));
+    } else {
+        memcpy(dx, db, len * sizeof(double));
+        memcpy(dxref, db, len * sizeof(double));
+    }
+    switch (mv ? p - 'a' + 'A' : p) {
+    case 'S':
+        l2_strmv(o, u, t, d, n, sA, n, sx, incx);
+        cblas_strmv(o, u, t, d, n, sA, n, sxref, incx);
+        break;
+    case 'D':
+        l2_dtrmv(o, u, t, d, n, dA, n, dx, incx);
+        cblas_dtrmv(o, u, t, d, n, dA, n, dxref, incx);
+        break;
+    case 'C':
+        l2_ctrmv(o, u, t, d, n, sA, n, sx, incx);
+        cblas_ctrmv(o, u, t, d, n, sA, n, sxref, incx);
+        break;
+    case 'Z':
+        l2_ztrmv(o, u, t, d, n, dA, n, dx, incx);
+        cblas_ztrmv(o, u, t, d, n, dA, n, dxref, incx);
+        break;
+    case 's':
+        l2_strsv(o, u, t, d, n, sA, n, sx, incx);
+        cblas_strsv(o, u, t, d, n, sA, n, sxref, incx);
+        break;
+    case 'd':
+        l2_dtrsv(o, u, t, d, n, dA, n, dx, incx);
+        cblas_dtrsv(o, u, t, d, n, dA, n, dxref, incx);
+        break;
+    case 'c':
+        l2_ctrsv(o, u, t, d, n, sA, n, sx, incx);
+        cblas_ctrsv(o, u, t, d, n, sA, n, sxref, incx);
+        break;
+    default:
+        l2_ztrsv(o, u, t, d, n, dA, n, dx, incx);
+        cblas_ztrsv(o, u, t, d, n, dA, n, dxref, incx);
+        break;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        double r = l2t_is_single(p) ? sxref[i] : dxref[i];
+        if (fabs(r) > xmax) xmax = fabs(r);
+    }
+    tol = 16.0 * (n + 2) * eps * (xmax + 1.0);
+    for (size_t i = 0; i < len; i++) {
+        double got = l2t_is_single(p) ? sx[i] : dx[i];
+        double ref = l2t_is_single(p) ? sxref[i] : dxref[i];
+        if (!(fabs(got - ref) <= tol)) return 0;
+    }
+    return 1;
+}
+
+/* Every trans and diag for one order/uplo, over all sizes and increments. */
+static int tr_sweep(int mv, char p, enum CBLAS_ORDER o, enum CBLAS_UPLO u,
+                    int max_n) {
+    static const enum CBLAS_TRANSPOSE transes[3] =
+        {CblasNoTrans, CblasTrans, CblasConjTrans};
+    static const enum CBLAS_DIAG diags[2] = {CblasNonUnit, CblasUnit};
+    int ok = 1;
+
+    for (int s = 0; s < NSIZES && sizes[s] <= max_n; s++) {
+        set_diagonal(sizes[s], l2t_is_cplx(p));
+        for (int c = 0; c < NINCS; c++) {
+            if (sizes[s] > 257 && c > 0) continue;
+            for (int t = 0; t < 3; t++)
+                for (int d = 0; d < 2; d++)
+                    ok &= tr_case(mv, p, o, u, transes[t], diags[d],
+                                  sizes[s], incs[c]);
+        }
+    }
+    return ok;
+}
+
+static void tr_sweep_all(int mv, const char *core) {
+    static const enum CBLAS_ORDER orders[2] = {CblasRowMajor, CblasColMajor};
+    static const enum CBLAS_UPLO uplos[2] = {CblasUpper, CblasLower};
+    static const char *order_name[2] = {"RowMajor", "ColMajor"};
+    static const char *uplo_name[2] = {"Upper", "Lower"};
+    char msg[128];
+
+    for (int p = 0; p < 4; p++)
+        for (int oi = 0; oi < 2; oi++)
+            for (int ui = 0; ui < 2; ui++) {
+                int ok = tr_sweep(mv, precs[p], orders[oi], uplos[ui], MAXN);
+                snprintf(msg, sizeof(msg),
+                         "l2_%ctr%sv[%s]: %s %s, all trans/diag match "
+                         "OpenBLAS", precs[p], mv ? "m" : "s", core,
+                         order_name[oi], uplo_name[ui]);
+                CHECK(ok, msg);
+            }
+}
+
+L2T_CORE_TEST(test_trsv_sweep) {
+    tr_sweep_all(0, core);
+}
+
+L2T_CORE_TEST(test_trmv_sweep) {
+    tr_sweep_all(1, core);
+}
+
+/* Large calls with several threads, so the panels really are split. */
+static void tr_threads(int mv) {
+    static const enum CBLAS_TRANSPOSE transes[3] =
+        {CblasNoTrans, CblasTrans, CblasConjTrans};
+    int saved = l2_get_num_threads();
+    char msg[128];
+
+    l2_set_num_threads(4);
+    for (int p = 0; p < 4; p++) {
+        int ok = 1;
+
+        set_diagonal(MAXN, precs[p] == 'c' || precs[p] == 'z');
+        for (int u = 0; u < 2; u++)
+            for (int t = 0; t < 3; t++)
+                ok &= tr_case(mv, precs[p], CblasColMajor,
+                              u ? CblasLower : CblasUpper, transes[t],
+                              CblasNonUnit, MAXN, 1);
+        snprintf(msg, sizeof(msg),
+                 "l2_%ctr%sv: n=%d with 4 threads matches OpenBLAS",
+                 precs[p], mv ? "m" : "s", MAXN);
+        CHECK(ok, msg);
+    }
+    l2_set_num_threads(saved);
+}
+
+L2T_TEST(test_trsv_threads) {
+    tr_threads(0);
+}
+
+L2T_TEST(test_trmv_threads) {
+    tr_threads(1);
+}
+
+/*
+ * trmv overwrites x in place without a heap buffer: no malloc of any kind,
+ * on any thread, across blocked and strided calls, threaded or not, once
+ * the pool has started.
+ */
+L2T_TEST(test_trmv_no_alloc) {
+    int saved = l2_get_num_threads();
+    void *volatile probe;
+    long before;
+    int ok = 1;
+
+    if (l2t_alloc_count() < 0) {
+        l2t_skip("allocation counter needs glibc");
+        return;
+    }
+    before = l2t_alloc_count();
+    probe = malloc(64);     /* volatile: the pair is not optimised away */
+    free(probe);
+    CHECK(l2t_alloc_count() == before + 1, "allocation counter sees malloc");
+
+    set_diagonal(MAXN, 1);
+    memcpy(sx, sb, 4 * (size_t)MAXN * sizeof(float));
+    memcpy(dx, db, 4 * (size_t)MAXN * sizeof(double));
+    for (int nt = 1; nt <= 4; nt += 3) {
+        l2_set_num_threads(nt);
+        l2_ztrmv(CblasColMajor, CblasLower, CblasNoTrans, CblasNonUnit,
+                 MAXN, dA, MAXN, dx, 1);    /* starts the workers */
+        before = l2t_alloc_count();
+        for (int u = 0; u < 2; u++)
+            for (int t = 0; t < 2; t++)
+                for (int c = 0; c < NINCS; c++) {
+                    enum CBLAS_UPLO up = u ? CblasLower : CblasUpper;
+                    enum CBLAS_TRANSPOSE tr = t ? CblasConjTrans
+                                                : CblasNoTrans;
+                    l2_strmv(CblasRowMajor, up, tr, CblasUnit, 700, sA, 700,
+                             sx, incs[c]);
+                    l2_dtrmv(CblasColMajor, up, tr, CblasNonUnit, MAXN, dA,
+                             MAXN, dx, incs[c]);
+                    l2_ctrmv(CblasColMajor, up, tr, CblasNonUnit, 700, sA,
+                             700, sx, incs[c]);
+                    l2_ztrmv(CblasRowMajor, up, tr, CblasNonUnit, MAXN, dA,
+                             MAXN, dx, incs[c]);
+                }
+        ok &= l2t_alloc_count() == before;
+    }
+    l2_set_num_threads(saved);
+    CHECK(ok, "l2_?trmv: no heap allocation, 1 and 4 threads");
+}
@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <cblas.h>
+#include "l2prof/l2prof.h"
+#include "l2test.h"
+
+/*
+ * l2prof linked straight into the test: its cblas_* definitions take the
+ * place of OpenBLAS's in this executable and forward to them through
+ * dlsym(RTLD_NEXT), exactly as under LD_PRELOAD.  The Makefile builds this
+ * suite into its own runner, l2test_prof, so no other test or benchmark
+ * goes through the profiler.
+ */
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+/* Only the explicit dumps below; nothing written at exit. */
+L2T_SETUP(quiet_exit_report) {
+    setenv("L2PROF_OUTPUT", "none", 1);
+    return 1;
+}
+
+/* Report text, read back after l2prof_dump(). */
+static char *report;
+
+static int take_report(void) {
+    char path[] = "/tmp/l2prof_testXXXXXX";
+    int fd = mkstemp(path);
+    FILE *f;
+    long len;
+
+    free(report);
+    report = NULL;
+    if (fd < 0) return 0;
+    close(fd);
+    if (l2prof_dump(path) != 0 || !(f = fopen(path, "r"))) {
+        unlink(path);
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    rewind(f);
+    report = calloc((size_t)len + 1, 1);
+    if (report && fread(report, 1, (size_t)len, f) != (size_t)len) {
+        free(report);
+        report = NULL;
+    }
+    fclose(f);
+    unlink(path);
+    return report != NULL;
+}
+
+/* Section of the report for one routine, up to the next routine. */
+static const char *routine_section(const char *name) {
+    char key[64];
+
+    snprintf(key, sizeof key, "\"%s\": {", name);
+    return report ? strstr(report, key) : NULL;
+}
+
+/* Integer after "key": in sec, searching no further than the section end. */
+static long long json_int(const char *sec, const char *key) {
+    char pat[64];
+    const char *end, *p;
+
+    if (!sec) return -1;
+    end = strstr(sec, "\"shapes_dropped\"");
+    snprintf(pat, sizeof pat, "\"%s\": ", key);
+    p = strstr(sec, pat);
+    if (!p || (end && p > end + strlen("\"shapes_dropped\"")))
+        return -1;
+    return strtoll(p + strlen(pat), NULL, 10);
+}
+
+/* Integer after "key": inside the "hist": {...} object of sec. */
+static long long hist_int(const char *sec, const char *hist, const char *key) {
+    char pat[64];
+    const char *h, *close, *p;
+
+    if (!sec) return -1;
+    snprintf(pat, sizeof pat, "\"%s\": {", hist);
+    if (!(h = strstr(sec, pat))) return -1;
+    close = strchr(h, '}');
+    snprintf(pat, sizeof pat, "\"%s\": ", key);
+    p = strstr(h + 1, pat);
+    if (!p || p > close) return 0;
+    return strtoll(p + strlen(pat), NULL, 10);
+}
+
+/* Whether text occurs inside the section of sec's routine. */
+static int section_has(const char *sec, const char *text) {
+    const char *end, *p;
+
+    if (!sec) return 0;
+    end = strstr(sec, "\"shapes_dropped\"");
+    p = strstr(sec, text);
+    return p && (!end || p < end);
+}
+
+static int braces_balanced(const char *s) {
+    int depth = 0;
+
+    for (; *s; s++) {
+        if (*s == '{' || *s == '[') depth++;
+        if (*s == '}' || *s == ']') depth--;
+        if (depth < 0) return 0;
+    }
+    return depth == 0;
+}
+
+L2T_TEST(test_forwarding) {
+    /* A = [[1,2],[3,4],[5,6]] ColMajor with lda = 4 */
+    double A[8] = {1.0, 3.0, 5.0, 0.0, 2.0, 4.0, 6.0, 0.0};
+    double x[2] = {1.0, 1.0};
+    double y[3] = {0.0, 0.0, 0.0};
+    float L[4] = {2.0f, 1.0f, 0.0f, 4.0f};      /* ColMajor [[2,0],[1,4]] */
+    float b[2] = {2.0f, 9.0f};
+
+    l2prof_reset();
+    cblas_dgemv(CblasColMajor, CblasNoTrans, 3, 2, 1.0, A, 4, x, 1,
+                0.0, y, 1);
+    CHECK(fabs(y[0] - 3.0) < TOL_DOUBLE && fabs(y[1] - 7.0) < TOL_DOUBLE &&
+          fabs(y[2] - 11.0) < TOL_DOUBLE,
+          "l2prof: dgemv result passes through");
+
+    cblas_strsv(CblasColMajor, CblasLower, CblasNoTrans, CblasNonUnit,
+                2, L, 2, b, 1);
+    CHECK(fabsf(b[0] - 1.0f) < TOL_FLOAT && fabsf(b[1] - 2.0f) < TOL_FLOAT,
+          "l2prof: strsv result passes through");
+}
+
+L2T_TEST(test_counts_and_histograms) {
+    double A[8] = {0}, x[4] = {1.0, 1.0, 1.0, 1.0}, y[4] = {0};
+    double Ap[6] = {0};
+    float B[12] = {0}, xs[8] = {0}, ys[8] = {0};
+    double zx[4] = {1.0, 0.0, 0.0, 1.0}, zA[8] = {0};
+    const char *sec;
+
+    l2prof_reset();
+    cblas_dgemv(CblasColMajor, CblasNoTrans, 3, 2, 1.0, A, 4, x, 1,
+                0.0, y, 1);
+    cblas_dgemv(CblasColMajor, CblasNoTrans, 3, 2, 1.0, A, 4, x, 1,
+                0.0, y, 1);
+    cblas_dgemv(CblasRowMajor, CblasTrans, 2, 2, 1.0, A, 2, x, 2,
+                0.0, y, -1);
+    cblas_sgbmv(CblasColMajor, CblasNoTrans, 4, 4, 1, 1, 1.0f, B, 3,
+                xs, 1, 0.0f, ys, 1);
+    cblas_dspr(CblasRowMajor, CblasUpper, 3, 1.0, x, 1, Ap);
+    cblas_zher(CblasColMajor, CblasLower, 2, 1.0, zx, 1, zA, 2);
+    if (!take_report()) {
+        CHECK(0, "l2prof: report written and read back");
+        return;
+    }
+    CHECK(braces_balanced(report), "l2prof: report brackets balance");
+
+    sec = routine_section("cblas_dgemv");
+    CHECK(json_int(sec, "calls") == 3, "l2prof: dgemv call count");
+    CHECK(hist_int(sec, "layout", "ColMajor") == 2 &&
+          hist_int(sec, "layout", "RowMajor") == 1,
+          "l2prof: dgemv layout histogram");
+    CHECK(hist_int(sec, "trans", "N") == 2 && hist_int(sec, "trans", "T") == 1,
+          "l2prof: dgemv trans histogram");
+    CHECK(hist_int(sec, "lda", "padded") == 2 &&
+          hist_int(sec, "lda", "tight") == 1,
+          "l2prof: dgemv lda tight/padded");
+    CHECK(hist_int(sec, "incx", "strided") == 1 &&
+          hist_int(sec, "incy", "negative") == 1,
+          "l2prof: dgemv increment classes");
+    CHECK(section_has(sec, "\"m_le\": 4, \"n_le\": 2, \"calls\": 2"),
+          "l2prof: dgemv size buckets");
+    CHECK(section_has(sec, "\"m\": 3, \"n\": 2, \"lda\": 4, \"incx\": 1, "
+                           "\"incy\": 1, \"calls\": 2"),
+          "l2prof: dgemv most frequent shape listed first");
+    CHECK(json_int(sec, "min") > 0 &&
+          json_int(sec, "min") <= json_int(sec, "p50") &&
+          json_int(sec, "p50") <= json_int(sec, "p99") &&
+          json_int(sec, "p99") <= json_int(sec, "max"),
+          "l2prof: dgemv latency percentiles ordered");
+
+    sec = routine_section("cblas_sgbmv");
+    CHECK(json_int(sec, "calls") == 1 && json_int(sec, "kl") == 1 &&
+          json_int(sec, "ku") == 1 && hist_int(sec, "lda", "tight") == 1,
+          "l2prof: sgbmv band shape");
+
+    sec = routine_section("cblas_dspr");
+    CHECK(json_int(sec, "calls") == 1 && hist_int(sec, "uplo", "U") == 1 &&
+          !section_has(sec, "\"lda\""),
+          "l2prof: packed dspr has no lda");
+
+    sec = routine_section("cblas_zher");
+    CHECK(json_int(sec, "calls") == 1 && hist_int(sec, "uplo", "L") == 1,
+          "l2prof: zher (real alpha) recorded");
+
+    CHECK(routine_section("cblas_ssymv") == NULL,
+          "l2prof: routines never called are left out");
+    CHECK(report && strstr(report, "\"calls\": 6,") != NULL,
+          "l2prof: total call count");
+}
+
+L2T_TEST(test_reset) {
+    float A[4] = {1.0f, 0.0f, 0.0f, 1.0f}, x[2] = {1.0f, 1.0f};
+
+    cblas_strmv(CblasColMajor, CblasUpper, CblasNoTrans, CblasUnit,
+                2, A, 2, x, 1);
+    l2prof_reset();
+    if (!take_report()) {
+        CHECK(0, "l2prof: report written after reset");
+        return;
+    }
+    CHECK(routine_section("cblas_strmv") == NULL &&
+          strstr(report, "\"calls\": 0,") != NULL,
+          "l2prof: reset clears every routine");
+}
+
+/* More distinct shapes than the table keeps: 96 x 96 gemv sizes. */
+L2T_TEST(test_many_shapes) {
+    static double A[96 * 96];
+    static double x[96], y[96];
+    const char *sec, *p;
+    int ok, listed = 0;
+
+    l2prof_reset();
+    for (int m = 1; m <= 96; m++)
+        for (int n = 1; n <= 96; n++)
+            cblas_dgemv(CblasColMajor, CblasNoTrans, m, n, 1.0, A, 96,
+                        x, 1, 0.0, y, 1);
+    setenv("L2PROF_TOP", "3", 1);
+    ok = take_report();
+    unsetenv("L2PROF_TOP");
+    sec = routine_section("cblas_dgemv");
+    CHECK(ok && json_int(sec, "calls") == 96 * 96,
+          "l2prof: 9216 distinct shapes all counted");
+    CHECK(json_int(sec, "shapes_dropped") > 0 &&
+          hist_int(sec, "lda", "padded") == 96 * 96 - 96,
+          "l2prof: shapes missing from the table still reach histograms");
+    for (p = sec ? strstr(sec, "\"shapes\": [") : NULL;
+         p && (p = strstr(p + 1, "\"m\": ")) != NULL &&
+         section_has(sec, p); )
+        listed++;
+    CHECK(listed == 3, "l2prof: L2PROF_TOP limits the shape list");
+}
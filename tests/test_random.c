@@ -0,0 +1,829 @@
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <cblas.h>
+#include "l2blas/l2blas.h"
+#include "l2ref/l2ref.h"
+#include "l2test.h"
+
+/*
+ * Randomized differential tests: every Level 2 routine against l2ref, on
+ * random shapes up to 8192, both layouts, every uplo/trans/diag, random
+ * leading-dimension padding, strides of either sign and random thread
+ * counts.  Unreferenced matrix elements and the gaps between strided vector
+ * elements hold NaN and must neither leak into results nor change.
+ *
+ * Results are checked componentwise against the standard bounds, with
+ * k the length of the longest inner product:
+ *
+ *   y = alpha op(A) x + beta y   |y - y*| <= c (k+2) eps (|alpha||op(A)||x|
+ *                                                          + |beta||y|)
+ *   op(A) x = b  (solves)        |op(A) x - b| <= c (k+2) eps (|op(A)||x| + |b|)
+ *   rank updates                 |A - A*| <= c 4 eps (|A| + |alpha||x||y| ...)
+ *
+ * Environment:
+ *   L2TEST_SEED            base seed (default 1); every case derives its own,
+ *                          so a case reproduces when run alone
+ *   L2TEST_RANDOM_TRIALS   trials per case (default 12)
+ *   L2TEST_RANDOM_MAXN     largest dimension (default 8192)
+ *   L2TEST_RANDOM_ELEMS    largest matrix, in referenced elements (default
+ *                          2^21: 8192 x 256, or triangles of order 2047;
+ *                          2^25 lets triangles reach 8192 too)
+ *   L2TEST_RANDOM_THREADS  highest thread count tried (default: CPUs, at
+ *                          least 2)
+ */
+
+#define DEFAULT_TRIALS 12
+#define DEFAULT_MAXN   8192
+#define DEFAULT_ELEMS  (1L << 21)
+
+enum family {
+    F_GEMV, F_GBMV, F_SYMV, F_SBMV, F_SPMV,
+    F_TRMV, F_TBMV, F_TPMV, F_TRSV, F_TBSV, F_TPSV,
+    F_GER, F_GERC, F_SYR, F_SYR2, F_SPR, F_SPR2
+};
+
+/* Routine names, real and complex. */
+static const char *const family_names[][2] = {
+    {"gemv", "gemv"}, {"gbmv", "gbmv"}, {"symv", "hemv"}, {"sbmv", "hbmv"},
+    {"spmv", "hpmv"}, {"trmv", "trmv"}, {"tbmv", "tbmv"}, {"tpmv", "tpmv"},
+    {"trsv", "trsv"}, {"tbsv", "tbsv"}, {"tpsv", "tpsv"}, {"ger", "geru"},
+    {"ger", "gerc"}, {"syr", "her"}, {"syr2", "her2"}, {"spr", "hpr"},
+    {"spr2", "hpr2"}
+};
+
+typedef struct {
+    char prec;
+    enum family f;
+    l2r_matrix A;
+    enum CBLAS_TRANSPOSE trans;
+    int nx, ny;                     /* logical vector lengths */
+    int incx, incy;
+    int threads;
+    double alpha[2], beta[2];
+    void *a, *x, *y;
+    size_t na, sx, sy;              /* storage lengths, in elements */
+} trial;
+
+/* ---- random numbers ------------------------------------------------------ */
+
+static unsigned long long splitmix(unsigned long long *s) {
+    unsigned long long z = (*s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double unit(unsigned long long *s) {
+    return (double)(splitmix(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int below(unsigned long long *s, int n) {
+    return n > 0 ? (int)(splitmix(s) % (unsigned long long)n) : 0;
+}
+
+/* Uniform in [-1, 1]. */
+static double uniform(unsigned long long *s) { return 2.0 * unit(s) - 1.0; }
+
+/* Log-uniform in [1, maxn], so small and large sizes are equally likely per
+ * octave; now and then 0. */
+static int rand_dim(unsigned long long *s, int maxn) {
+    int d;
+
+    if (below(s, 32) == 0) return 0;
+    d = (int)exp(unit(s) * log(maxn + 1.0));
+    return d < 1 ? 1 : d > maxn ? maxn : d;
+}
+
+/* Log-uniform bandwidth in [0, maxk]. */
+static int rand_k(unsigned long long *s, int maxk) {
+    int k;
+
+    if (maxk <= 0) return 0;
+    k = (int)exp(unit(s) * log(maxk + 2.0)) - 1;
+    return k < 0 ? 0 : k > maxk ? maxk : k;
+}
+
+static int rand_inc(unsigned long long *s) {
+    static const int incs[] = {1, 1, 1, 1, 1, 2, 3, -1, -1, -2, -5};
+    return incs[below(s, (int)(sizeof incs / sizeof incs[0]))];
+}
+
+/* Extra leading dimension: mostly none or a little, sometimes a lot. */
+static int rand_pad(unsigned long long *s) {
+    int r = below(s, 8);
+    return r < 4 ? 0 : r < 7 ? 1 + below(s, 16) : 1 + below(s, 300);
+}
+
+/* Alpha or beta: 0 and 1 (the quick paths) each one time in eight. */
+static void rand_scalar(unsigned long long *s, int cplx, double v[2]) {
+    int r = below(s, 8);
+
+    v[0] = r == 0 ? 0.0 : r == 1 ? 1.0 : uniform(s);
+    v[1] = r <= 1 || !cplx ? 0.0 : uniform(s);
+}
+
+static unsigned long long base_seed(void) {
+    const char *env = getenv("L2TEST_SEED");
+    return env ? strtoull(env, NULL, 0) : 1;
+}
+
+static unsigned long long case_seed(const char *name) {
+    unsigned long long s = base_seed();
+
+    for (; *name; name++)
+        s = (s ^ (unsigned char)*name) * 0x100000001B3ULL;
+    return s;
+}
+
+static long env_long(const char *name, long def) {
+    const char *env = getenv(name);
+    long v = env ? atol(env) : 0;
+    return v > 0 ? v : def;
+}
+
+/* ---- storage ------------------------------------------------------------- */
+
+static int is_complex(char p) { return p == 'c' || p == 'z'; }
+
+static size_t elem_size(char p) {
+    return p == 's' ? 4 : p == 'd' || p == 'c' ? 8 : 16;
+}
+
+static double eps_of(char p) {
+    return p == 's' || p == 'c' ? FLT_EPSILON : DBL_EPSILON;
+}
+
+static void store(char p, void *buf, size_t off, const double v[2]) {
+    switch (p) {
+    case 's': ((float *)buf)[off] = (float)v[0]; break;
+    case 'd': ((double *)buf)[off] = v[0]; break;
+    case 'c':
+        ((float *)buf)[2 * off] = (float)v[0];
+        ((float *)buf)[2 * off + 1] = (float)v[1];
+        break;
+    default:
+        ((double *)buf)[2 * off] = v[0];
+        ((double *)buf)[2 * off + 1] = v[1];
+        break;
+    }
+}
+
+/*
+ * Buffers of a case, kept from trial to trial and only ever grown: fresh
+ * pages for every large trial would cost more than the trial itself.
+ */
+enum { B_A, B_X, B_Y, B_ACOPY, B_XCOPY, B_YCOPY, B_XD, B_YD, B_REF, B_OUT,
+       B_REFABS, B_BOUND, B_MARK, NBUFS };
+
+static void *bufs[NBUFS];
+static size_t buf_bytes[NBUFS];
+
+static void *scratch(int b, size_t bytes) {
+    if (bytes > buf_bytes[b]) {
+        free(bufs[b]);
+        buf_bytes[b] = 0;
+        if (!(bufs[b] = malloc(bytes))) return NULL;
+        buf_bytes[b] = bytes;
+    }
+    return bufs[b];
+}
+
+static void free_scratch(void) {
+    for (int b = 0; b < NBUFS; b++) {
+        free(bufs[b]);
+        bufs[b] = NULL;
+        buf_bytes[b] = 0;
+    }
+}
+
+/* Buffer b of n elements, all NaN (all-ones bits, in either width). */
+static void *nan_buffer(int b, char p, size_t n) {
+    void *buf = scratch(b, n * elem_size(p));
+
+    if (buf) memset(buf, 0xff, n * elem_size(p));
+    return buf;
+}
+
+static size_t vec_storage(int len, int inc) {
+    return len > 0 ? 1 + (size_t)(len - 1) * (size_t)abs(inc) : 1;
+}
+
+/* Strided vector of random values in NaN-filled storage. */
+static void *rand_vector(unsigned long long *s, int b, char p, int len,
+                         int inc, size_t *elems) {
+    void *buf;
+
+    *elems = vec_storage(len, inc);
+    if (!(buf = nan_buffer(b, p, *elems))) return NULL;
+    for (int i = 0; i < len; i++) {
+        double v[2] = {uniform(s), uniform(s)};
+        store(p, buf, (size_t)i * (size_t)abs(inc), v);
+    }
+    return buf;
+}
+
+static int is_solve(enum family f) {
+    return f == F_TRSV || f == F_TBSV || f == F_TPSV;
+}
+
+static int is_update(enum family f) { return f >= F_GER; }
+
+/*
+ * Random referenced elements in NaN-filled storage.  Triangles to be solved
+ * are made diagonally dominant (off-diagonal row and column sums below 1/√2,
+ * |diagonal| >= 1) so that x stays O(1) at any order.  The imaginary part of
+ * a Hermitian diagonal is not referenced and stays NaN.
+ */
+static void *rand_matrix(unsigned long long *s, trial *t) {
+    l2r_matrix *A = &t->A;
+    int herm = A->kind == L2R_HE || A->kind == L2R_HB || A->kind == L2R_HP;
+    int kk = A->kind == L2R_TB ? A->kl : A->n - 1;
+    double scale = is_solve(t->f) ? 0.5 / (kk > 1 ? kk : 1) : 1.0;
+    void *buf;
+
+    t->na = l2r_elems(A);
+    if (t->na == 0) t->na = 1;
+    if (!(buf = nan_buffer(B_A, t->prec, t->na))) return NULL;
+    A->a = buf;
+    for (int j = 0; j < A->n; j++) {
+        int lo, hi;
+        l2r_rows(A, j, &lo, &hi);
+        for (int i = lo; i < hi; i++) {
+            long off = l2r_offset(A, i, j);
+            double v[2];
+
+            if (off < 0) continue;
+            v[0] = scale * uniform(s);
+            v[1] = scale * uniform(s);
+            if (i == j && is_solve(t->f)) {
+                v[0] = (1.0 + unit(s)) * (below(s, 2) ? 1.0 : -1.0);
+                v[1] = uniform(s);
+            }
+            if (i == j && herm) v[1] = NAN;
+            store(t->prec, buf, (size_t)off, v);
+        }
+    }
+    return buf;
+}
+
+/* ---- the routine under test ---------------------------------------------- */
+
+#define DISPATCH(p, s_call, d_call, c_call, z_call) \
+    switch (p) { \
+    case 's': s_call; break; \
+    case 'd': d_call; break; \
+    case 'c': c_call; break; \
+    default:  z_call; break; \
+    }
+
+static void call(const trial *t) {
+    const l2r_matrix *A = &t->A;
+    enum CBLAS_ORDER o = A->order;
+    enum CBLAS_UPLO u = A->uplo;
+    enum CBLAS_TRANSPOSE tr = t->trans;
+    enum CBLAS_DIAG dg = A->diag;
+    int m = A->m, n = A->n, kl = A->kl, ku = A->ku, k = A->kl, lda = A->lda;
+    int ix = t->incx, iy = t->incy;
+    float sa = (float)t->alpha[0], sb = (float)t->beta[0];
+    double da = t->alpha[0], db = t->beta[0];
+    float ca[2] = {(float)t->alpha[0], (float)t->alpha[1]};
+    float cb[2] = {(float)t->beta[0], (float)t->beta[1]};
+    const double *za = t->alpha, *zb = t->beta;
+    void *a = t->a, *x = t->x, *y = t->y;
+
+    switch (t->f) {
+    case F_GEMV:
+        DISPATCH(t->prec,
+            cblas_sgemv(o, tr, m, n, sa, a, lda, x, ix, sb, y, iy),
+            cblas_dgemv(o, tr, m, n, da, a, lda, x, ix, db, y, iy),
+            cblas_cgemv(o, tr, m, n, ca, a, lda, x, ix, cb, y, iy),
+            cblas_zgemv(o, tr, m, n, za, a, lda, x, ix, zb, y, iy))
+        break;
+    case F_GBMV:
+        DISPATCH(t->prec,
+            cblas_sgbmv(o, tr, m, n, kl, ku, sa, a, lda, x, ix, sb, y, iy),
+            cblas_dgbmv(o, tr, m, n, kl, ku, da, a, lda, x, ix, db, y, iy),
+            cblas_cgbmv(o, tr, m, n, kl, ku, ca, a, lda, x, ix, cb, y, iy),
+            cblas_zgbmv(o, tr, m, n, kl, ku, za, a, lda, x, ix, zb, y, iy))
+        break;
+    case F_SYMV:
+        DISPATCH(t->prec,
+            cblas_ssymv(o, u, n, sa, a, lda, x, ix, sb, y, iy),
+            cblas_dsymv(o, u, n, da, a, lda, x, ix, db, y, iy),
+            cblas_chemv(o, u, n, ca, a, lda, x, ix, cb, y, iy),
+            cblas_zhemv(o, u, n, za, a, lda, x, ix, zb, y, iy))
+        break;
+    case F_SBMV:
+        DISPATCH(t->prec,
+            cblas_ssbmv(o, u, n, k, sa, a, lda, x, ix, sb, y, iy),
+            cblas_dsbmv(o, u, n, k, da, a, lda, x, ix, db, y, iy),
+            cblas_chbmv(o, u, n, k, ca, a, lda, x, ix, cb, y, iy),
+            cblas_zhbmv(o, u, n, k, za, a, lda, x, ix, zb, y, iy))
+        break;
+    case F_SPMV:
+        DISPATCH(t->prec,
+            cblas_sspmv(o, u, n, sa, a, x, ix, sb, y, iy),
+            cblas_dspmv(o, u, n, da, a, x, ix, db, y, iy),
+            cblas_chpmv(o, u, n, ca, a, x, ix, cb, y, iy),
+            cblas_zhpmv(o, u, n, za, a, x, ix, zb, y, iy))
+        break;
+    case F_TRMV:
+        DISPATCH(t->prec,
+            cblas_strmv(o, u, tr, dg, n, a, lda, x, ix),
+            cblas_dtrmv(o, u, tr, dg, n, a, lda, x, ix),
+            cblas_ctrmv(o, u, tr, dg, n, a, lda, x, ix),
+            cblas_ztrmv(o, u, tr, dg, n, a, lda, x, ix))
+        break;
+    case F_TBMV:
+        DISPATCH(t->prec,
+            cblas_stbmv(o, u, tr, dg, n, k, a, lda, x, ix),
+            cblas_dtbmv(o, u, tr, dg, n, k, a, lda, x, ix),
+            cblas_ctbmv(o, u, tr, dg, n, k, a, lda, x, ix),
+            cblas_ztbmv(o, u, tr, dg, n, k, a, lda, x, ix))
+        break;
+    case F_TPMV:
+        DISPATCH(t->prec,
+            cblas_stpmv(o, u, tr, dg, n, a, x, ix),
+            cblas_dtpmv(o, u, tr, dg, n, a, x, ix),
+            cblas_ctpmv(o, u, tr, dg, n, a, x, ix),
+            cblas_ztpmv(o, u, tr, dg, n, a, x, ix))
+        break;
+    case F_TRSV:
+        DISPATCH(t->prec,
+            cblas_strsv(o, u, tr, dg, n, a, lda, x, ix),
+            cblas_dtrsv(o, u, tr, dg, n, a, lda, x, ix),
+            cblas_ctrsv(o, u, tr, dg, n, a, lda, x, ix),
+            cblas_ztrsv(o, u, tr, dg, n, a, lda, x, ix))
+        break;
+    case F_TBSV:
+        DISPATCH(t->prec,
+            cblas_stbsv(o, u, tr, dg, n, k, a, lda, x, ix),
+            cblas_dtbsv(o, u, tr, dg, n, k, a, lda, x, ix),
+            cblas_ctbsv(o, u, tr, dg, n, k, a, lda, x, ix),
+            cblas_ztbsv(o, u, tr, dg, n, k, a, lda, x, ix))
+        break;
+    case F_TPSV:
+        DISPATCH(t->prec,
+            cblas_stpsv(o, u, tr, dg, n, a, x, ix),
+            cblas_dtpsv(o, u, tr, dg, n, a, x, ix),
+            cblas_ctpsv(o, u, tr, dg, n, a, x, ix),
+            cblas_ztpsv(o, u, tr, dg, n, a, x, ix))
+        break;
+    case F_GER:
+        DISPATCH(t->prec,
+            cblas_sger(o, m, n, sa, x, ix, y, iy, a, lda),
+            cblas_dger(o, m, n, da, x, ix, y, iy, a, lda),
+            cblas_cgeru(o, m, n, ca, x, ix, y, iy, a, lda),
+            cblas_zgeru(o, m, n, za, x, ix, y, iy, a, lda))
+        break;
+    case F_GERC:
+        DISPATCH(t->prec,
+            cblas_sger(o, m, n, sa, x, ix, y, iy, a, lda),
+            cblas_dger(o, m, n, da, x, ix, y, iy, a, lda),
+            cblas_cgerc(o, m, n, ca, x, ix, y, iy, a, lda),
+            cblas_zgerc(o, m, n, za, x, ix, y, iy, a, lda))
+        break;
+    case F_SYR:
+        DISPATCH(t->prec,
+            cblas_ssyr(o, u, n, sa, x, ix, a, lda),
+            cblas_dsyr(o, u, n, da, x, ix, a, lda),
+            cblas_cher(o, u, n, sa, x, ix, a, lda),
+            cblas_zher(o, u, n, da, x, ix, a, lda))
+        break;
+    case F_SYR2:
+        DISPATCH(t->prec,
+            cblas_ssyr2(o, u, n, sa, x, ix, y, iy, a, lda),
+            cblas_dsyr2(o, u, n, da, x, ix, y, iy, a, lda),
+            cblas_cher2(o, u, n, ca, x, ix, y, iy, a, lda),
+            cblas_zher2(o, u, n, za, x, ix, y, iy, a, lda))
+        break;
+    case F_SPR:
+        DISPATCH(t->prec,
+            cblas_sspr(o, u, n, sa, x, ix, a),
+            cblas_dspr(o, u, n, da, x, ix, a),
+            cblas_chpr(o, u, n, sa, x, ix, a),
+            cblas_zhpr(o, u, n, da, x, ix, a))
+        break;
+    case F_SPR2:
+        DISPATCH(t->prec,
+            cblas_sspr2(o, u, n, sa, x, ix, y, iy, a),
+            cblas_dspr2(o, u, n, da, x, ix, y, iy, a),
+            cblas_chpr2(o, u, n, ca, x, ix, y, iy, a),
+            cblas_zhpr2(o, u, n, za, x, ix, y, iy, a))
+        break;
+    }
+}
+
+/* ---- one trial ------------------------------------------------------------ */
+
+static enum l2r_kind family_kind(enum family f, char p) {
+    int h = is_complex(p);
+
+    switch (f) {
+    case F_GEMV: case F_GER: case F_GERC: return L2R_GE;
+    case F_GBMV: return L2R_GB;
+    case F_SYMV: case F_SYR: case F_SYR2: return h ? L2R_HE : L2R_SY;
+    case F_SBMV: return h ? L2R_HB : L2R_SB;
+    case F_SPMV: case F_SPR: case F_SPR2: return h ? L2R_HP : L2R_SP;
+    case F_TRMV: case F_TRSV: return L2R_TR;
+    case F_TBMV: case F_TBSV: return L2R_TB;
+    default: return L2R_TP;
+    }
+}
+
+/* Random problem of family f within the size limits. */
+static void rand_shape(unsigned long long *s, trial *t, int maxn, long elems) {
+    l2r_matrix *A = &t->A;
+    enum l2r_kind kind = family_kind(t->f, t->prec);
+    int band = kind == L2R_GB || kind == L2R_SB || kind == L2R_HB ||
+               kind == L2R_TB;
+    int packed = kind == L2R_SP || kind == L2R_HP || kind == L2R_TP;
+
+    memset(A, 0, sizeof *A);
+    A->prec = t->prec;
+    A->kind = kind;
+    A->order = below(s, 2) ? CblasRowMajor : CblasColMajor;
+    A->uplo = below(s, 2) ? CblasLower : CblasUpper;
+    A->diag = below(s, 2) ? CblasUnit : CblasNonUnit;
+    t->trans = below(s, 3) == 0 ? CblasNoTrans
+             : below(s, 2) ? CblasTrans : CblasConjTrans;
+    if (kind != L2R_GE && kind != L2R_GB && kind != L2R_TR &&
+        kind != L2R_TB && kind != L2R_TP)
+        t->trans = CblasNoTrans;
+
+    if (kind == L2R_GE || kind == L2R_GB) {
+        A->m = rand_dim(s, maxn);
+        A->n = rand_dim(s, maxn);
+        if (kind == L2R_GB) {
+            A->kl = rand_k(s, A->m - 1);
+            A->ku = rand_k(s, A->n - 1);
+            while ((long)A->n * (A->kl + A->ku + 1) > elems) {
+                A->kl /= 2;
+                A->ku /= 2;
+            }
+        } else if ((long)A->m * A->n > elems) {
+            if (below(s, 2)) A->n = (int)(elems / A->m);
+            else A->m = (int)(elems / A->n);
+        }
+    } else {
+        A->n = A->m = rand_dim(s, maxn);
+        if (band) {
+            A->kl = A->ku = rand_k(s, A->n - 1);
+            while ((long)A->n * (A->kl + 1) > elems) A->kl = A->ku = A->kl / 2;
+        } else {
+            if ((long)A->n * (A->n + 1) / 2 > elems)
+                A->n = (int)sqrt(2.0 * (double)elems);
+            while ((long)A->n * (A->n + 1) / 2 > elems) A->n--;
+            A->m = A->n;
+        }
+    }
+
+    if (kind == L2R_GB)
+        A->lda = A->kl + A->ku + 1;
+    else if (band)
+        A->lda = A->kl + 1;
+    else if (kind == L2R_GE && A->order == CblasRowMajor)
+        A->lda = A->n > 1 ? A->n : 1;
+    else
+        A->lda = A->m > 1 ? A->m : 1;
+    if (!packed) A->lda += rand_pad(s);
+
+    /* Vector lengths: x is read along the columns of op(A) (or the rows of
+     * A for the rank updates), y along its rows. */
+    if (t->f == F_GEMV || t->f == F_GBMV) {
+        t->nx = t->trans == CblasNoTrans ? A->n : A->m;
+        t->ny = t->trans == CblasNoTrans ? A->m : A->n;
+    } else if (t->f == F_GER || t->f == F_GERC) {
+        t->nx = A->m;
+        t->ny = A->n;
+    } else {
+        t->nx = t->ny = A->n;
+    }
+    t->incx = rand_inc(s);
+    t->incy = rand_inc(s);
+    rand_scalar(s, is_complex(t->prec) && t->f != F_SYR && t->f != F_SPR,
+                t->alpha);
+    rand_scalar(s, is_complex(t->prec), t->beta);
+}
+
+static void describe(const trial *t, char *buf, size_t len) {
+    static const char *const kinds = "GGSSSHHHTTT";
+    const l2r_matrix *A = &t->A;
+    int n = snprintf(buf, len, "cblas_%c%s %s",
+                     t->prec, family_names[t->f][is_complex(t->prec)],
+                     A->order == CblasRowMajor ? "Row" : "Col");
+
+    if (kinds[A->kind] != 'G')
+        n += snprintf(buf + n, len - n, " %s",
+                      A->uplo == CblasUpper ? "Up" : "Lo");
+    if (t->f <= F_GBMV || kinds[A->kind] == 'T')
+        n += snprintf(buf + n, len - n, " %c",
+                      t->trans == CblasNoTrans ? 'N'
+                      : t->trans == CblasTrans ? 'T' : 'C');
+    if (kinds[A->kind] == 'T')
+        n += snprintf(buf + n, len - n, " %s",
+                      A->diag == CblasUnit ? "Unit" : "NonUnit");
+    n += snprintf(buf + n, len - n, " m=%d n=%d", A->m, A->n);
+    if (A->kind == L2R_GB)
+        n += snprintf(buf + n, len - n, " kl=%d ku=%d", A->kl, A->ku);
+    else if (A->kind == L2R_SB || A->kind == L2R_HB || A->kind == L2R_TB)
+        n += snprintf(buf + n, len - n, " k=%d", A->kl);
+    if (A->kind != L2R_SP && A->kind != L2R_HP && A->kind != L2R_TP)
+        n += snprintf(buf + n, len - n, " lda=%d", A->lda);
+    snprintf(buf + n, len - n, " incx=%d incy=%d threads=%d",
+             t->incx, t->incy, t->threads);
+}
+
+/* Whether every element of the vector storage outside the len elements at
+ * stride inc is bit-identical to copy. */
+static int gaps_intact(const trial *t, const void *buf, const void *copy,
+                       size_t elems, int len, int inc) {
+    size_t es = elem_size(t->prec), step = (size_t)abs(inc);
+
+    for (size_t i = 0; i < elems; i++) {
+        if (len > 0 && i % step == 0 && i / step < (size_t)len) continue;
+        if (memcmp((const char *)buf + i * es, (const char *)copy + i * es,
+                   es) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+/* Same for the matrix elements the routine does not reference. */
+static int unreferenced_intact(const trial *t, const void *copy) {
+    const l2r_matrix *A = &t->A;
+    size_t es = elem_size(t->prec);
+    unsigned char *mark = scratch(B_MARK, t->na);
+    int ok = 1;
+
+    if (!mark) return 0;
+    memset(mark, 0, t->na);
+    for (int j = 0; j < A->n; j++) {
+        int lo, hi;
+        l2r_rows(A, j, &lo, &hi);
+        for (int i = lo; i < hi; i++) {
+            long off = l2r_offset(A, i, j);
+            if (off >= 0) mark[off] = 1;
+        }
+    }
+    for (size_t i = 0; i < t->na && ok; i++)
+        if (!mark[i] && memcmp((const char *)t->a + i * es,
+                               (const char *)copy + i * es, es) != 0)
+            ok = 0;
+    return ok;
+}
+
+/* Largest componentwise error-to-bound ratio of got against want. */
+static double worst_ratio(int n, const double *got, const double *want,
+                          const double *bound, int *where) {
+    double worst = 0.0;
+
+    *where = -1;
+    for (int i = 0; i < n; i++) {
+        double err = fabs(got[2 * i] - want[2 * i]) +
+                     fabs(got[2 * i + 1] - want[2 * i + 1]);
+        double r = err != err ? INFINITY
+                 : bound[i] > 0.0 ? err / bound[i]
+                 : err == 0.0 ? 0.0 : INFINITY;
+        if (r > worst || *where < 0) {
+            worst = r;
+            *where = i;
+        }
+    }
+    return worst;
+}
+
+/*
+ * Runs trial t on fresh random data and checks it.  Returns the worst
+ * error-to-bound ratio (above 1 fails) and writes what failed, if
+ * anything, to why.
+ */
+static double run_trial(unsigned long long *s, trial *t, char *why,
+                        size_t len) {
+    const l2r_matrix *A = &t->A;
+    int cplx = is_complex(t->prec);
+    double c = cplx ? 8.0 : 4.0, eps = eps_of(t->prec);
+    void *acopy = NULL, *xcopy = NULL, *ycopy = NULL;
+    double *xd = NULL, *yd = NULL, *ref = NULL, *refabs = NULL, *out = NULL;
+    double worst = INFINITY, *bound = NULL;
+    int rows = t->ny, where = -1, wi, wj;
+
+    why[0] = '\0';
+    t->a = rand_matrix(s, t);
+    t->x = rand_vector(s, B_X, t->prec, t->nx, t->incx, &t->sx);
+    t->y = rand_vector(s, B_Y, t->prec, t->ny, t->incy, &t->sy);
+    acopy = scratch(B_ACOPY, t->na * elem_size(t->prec));
+    xcopy = scratch(B_XCOPY, t->sx * elem_size(t->prec));
+    ycopy = scratch(B_YCOPY, t->sy * elem_size(t->prec));
+    xd = scratch(B_XD, 2 * sizeof(double) * (size_t)(t->nx + 1));
+    yd = scratch(B_YD, 2 * sizeof(double) * (size_t)(t->ny + 1));
+    ref = scratch(B_REF, 2 * sizeof(double) * (size_t)(rows + 1));
+    out = scratch(B_OUT, 2 * sizeof(double) * (size_t)(rows + 1));
+    refabs = scratch(B_REFABS, sizeof(double) * (size_t)(rows + 1));
+    bound = scratch(B_BOUND, sizeof(double) * (size_t)(rows + 1));
+    if (!t->a || !t->x || !t->y || !acopy || !xcopy || !ycopy || !xd ||
+        !yd || !ref || !out || !refabs || !bound) {
+        snprintf(why, len, "out of memory");
+        goto done;
+    }
+    memcpy(acopy, t->a, t->na * elem_size(t->prec));
+    memcpy(xcopy, t->x, t->sx * elem_size(t->prec));
+    memcpy(ycopy, t->y, t->sy * elem_size(t->prec));
+    l2r_load(t->prec, t->nx, t->x, t->incx, xd);
+    l2r_load(t->prec, t->ny, t->y, t->incy, yd);
+
+    openblas_set_num_threads(t->threads);
+    l2_set_num_threads(t->threads);
+    call(t);
+
+    if (is_update(t->f)) {
+        l2r_matrix A0 = *A;
+        int conj = cplx && t->f != F_GER;
+        int two = t->f == F_SYR2 || t->f == F_SPR2;
+        const double *yv = t->f == F_SYR || t->f == F_SPR ? xd : yd;
+
+        A0.a = acopy;
+        /* alpha = 0 is a quick return: not even the Hermitian diagonal is
+         * made real. */
+        if (t->alpha[0] == 0.0 && t->alpha[1] == 0.0) {
+            worst = 0.0;
+            if (memcmp(acopy, t->a, t->na * elem_size(t->prec)) != 0)
+                snprintf(why, len, "A changed with alpha = 0");
+            goto done;
+        }
+        worst = l2r_check_update(&A0, A, t->alpha, xd, yv, conj, two,
+                                 4.0 * c * eps, &wi, &wj);
+        if (worst > 1.0)
+            snprintf(why, len, "A(%d,%d) off by %.3g of the bound", wi, wj,
+                     worst);
+        else if (!unreferenced_intact(t, acopy))
+            snprintf(why, len, "unreferenced matrix elements changed");
+        else if (memcmp(xcopy, t->x, t->sx * elem_size(t->prec)) != 0 ||
+                 memcmp(ycopy, t->y, t->sy * elem_size(t->prec)) != 0)
+            snprintf(why, len, "x or y changed");
+        goto done;
+    }
+
+    if (memcmp(acopy, t->a, t->na * elem_size(t->prec)) != 0) {
+        snprintf(why, len, "A changed");
+        goto done;
+    }
+
+    if (t->f >= F_TRMV) {
+        /* x <- op(A) x, or x <- op(A)^-1 x checked by its residual. */
+        int n = t->nx, k = A->kind == L2R_TB ? A->kl + 1 : n;
+        const double *b = xd;
+
+        l2r_load(t->prec, n, t->x, t->incx, out);
+        if (is_solve(t->f)) {
+            l2r_mv(A, t->trans, out, ref, refabs);
+            for (int i = 0; i < n; i++)
+                bound[i] = c * (k + 2) * eps *
+                           (refabs[i] + fabs(b[2 * i]) + fabs(b[2 * i + 1]));
+            worst = worst_ratio(n, ref, b, bound, &where);
+        } else {
+            l2r_mv(A, t->trans, xd, ref, refabs);
+            for (int i = 0; i < n; i++)
+                bound[i] = c * (k + 2) * eps * refabs[i];
+            worst = worst_ratio(n, out, ref, bound, &where);
+        }
+        if (worst > 1.0)
+            snprintf(why, len, "x[%d] off by %.3g of the bound", where, worst);
+        else if (!gaps_intact(t, t->x, xcopy, t->sx, t->nx, t->incx))
+            snprintf(why, len, "x changed between its strided elements");
+        goto done;
+    }
+
+    /* y <- alpha op(A) x + beta y */
+    {
+        int k = t->nx;
+        double aabs = fabs(t->alpha[0]) + fabs(t->alpha[1]);
+        double babs = fabs(t->beta[0]) + fabs(t->beta[1]);
+
+        if (A->kind == L2R_GB)
+            k = A->kl + A->ku + 1 < k ? A->kl + A->ku + 1 : k;
+        else if (A->kind == L2R_SB || A->kind == L2R_HB)
+            k = 2 * A->kl + 1 < k ? 2 * A->kl + 1 : k;
+        l2r_mv(A, t->trans, xd, ref, refabs);
+        /* m = 0 or n = 0 is a quick return: y is left alone, not scaled. */
+        if (A->m == 0 || A->n == 0) {
+            aabs = 0.0;
+            babs = 1.0;
+            memset(ref, 0, 2 * sizeof(double) * (size_t)rows);
+            memset(refabs, 0, sizeof(double) * (size_t)rows);
+        }
+        for (int i = 0; i < rows; i++) {
+            const double *r = ref + 2 * i, *y0 = yd + 2 * i;
+            double ar = t->alpha[0] * r[0] - t->alpha[1] * r[1];
+            double ai = t->alpha[0] * r[1] + t->alpha[1] * r[0];
+
+            bound[i] = c * (k + 2) * eps *
+                       (aabs * refabs[i] +
+                        babs * (fabs(y0[0]) + fabs(y0[1])));
+            if (A->m == 0 || A->n == 0) {
+                ref[2 * i]     = y0[0];
+                ref[2 * i + 1] = y0[1];
+                continue;
+            }
+            ref[2 * i]     = ar + t->beta[0] * y0[0] - t->beta[1] * y0[1];
+            ref[2 * i + 1] = ai + t->beta[0] * y0[1] + t->beta[1] * y0[0];
+        }
+        l2r_load(t->prec, rows, t->y, t->incy, out);
+        worst = worst_ratio(rows, out, ref, bound, &where);
+        if (worst > 1.0)
+            snprintf(why, len, "y[%d] off by %.3g of the bound", where, worst);
+        else if (!gaps_intact(t, t->y, ycopy, t->sy, t->ny, t->incy))
+            snprintf(why, len, "y changed between its strided elements");
+        else if (memcmp(xcopy, t->x, t->sx * elem_size(t->prec)) != 0)
+            snprintf(why, len, "x changed");
+    }
+
+done:
+    return why[0] ? (worst > 1.0 ? worst : INFINITY) : worst;
+}
+
+static void run_case(char prec, enum family f, const char *name) {
+    unsigned long long s = case_seed(name);
+    long trials = env_long("L2TEST_RANDOM_TRIALS", DEFAULT_TRIALS);
+    int maxn = (int)env_long("L2TEST_RANDOM_MAXN", DEFAULT_MAXN);
+    long elems = env_long("L2TEST_RANDOM_ELEMS", DEFAULT_ELEMS);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int maxthreads = (int)env_long("L2TEST_RANDOM_THREADS",
+                                   cpus > 2 ? cpus : 2);
+    int saved_openblas = openblas_get_num_threads();
+    int saved_l2 = l2_get_num_threads();
+
+    for (long i = 0; i < trials; i++) {
+        trial t;
+        char desc[256], why[128], msg[512];
+        double worst;
+
+        memset(&t, 0, sizeof t);
+        t.prec = prec;
+        t.f = f;
+        rand_shape(&s, &t, maxn, elems);
+        t.threads = 1 + below(&s, maxthreads);
+        describe(&t, desc, sizeof desc);
+        worst = run_trial(&s, &t, why, sizeof why);
+        if (why[0])
+            snprintf(msg, sizeof msg, "%s: %s (L2TEST_SEED=%llu, trial %ld)",
+                     desc, why, base_seed(), i);
+        else
+            snprintf(msg, sizeof msg, "%s (%.2f of bound)", desc, worst);
+        CHECK(!why[0], msg);
+    }
+    free_scratch();
+    openblas_set_num_threads(saved_openblas);
+    l2_set_num_threads(saved_l2);
+}
+
+#define RANDOM_TEST(p, name, f) \
+    L2T_TEST(test_##p##name##_random) { \
+        run_case(#p[0], f, "test_" #p #name "_random"); \
+    }
+
+#define REAL_TESTS(p) \
+    RANDOM_TEST(p, gemv, F_GEMV) \
+    RANDOM_TEST(p, gbmv, F_GBMV) \
+    RANDOM_TEST(p, symv, F_SYMV) \
+    RANDOM_TEST(p, sbmv, F_SBMV) \
+    RANDOM_TEST(p, spmv, F_SPMV) \
+    RANDOM_TEST(p, trmv, F_TRMV) \
+    RANDOM_TEST(p, tbmv, F_TBMV) \
+    RANDOM_TEST(p, tpmv, F_TPMV) \
+    RANDOM_TEST(p, trsv, F_TRSV) \
+    RANDOM_TEST(p, tbsv, F_TBSV) \
+    RANDOM_TEST(p, tpsv, F_TPSV) \
+    RANDOM_TEST(p, ger, F_GER) \
+    RANDOM_TEST(p, syr, F_SYR) \
+    RANDOM_TEST(p, syr2, F_SYR2) \
+    RANDOM_TEST(p, spr, F_SPR) \
+    RANDOM_TEST(p, spr2, F_SPR2)
+
+#define COMPLEX_TESTS(p) \
+    RANDOM_TEST(p, gemv, F_GEMV) \
+    RANDOM_TEST(p, gbmv, F_GBMV) \
+    RANDOM_TEST(p, hemv, F_SYMV) \
+    RANDOM_TEST(p, hbmv, F_SBMV) \
+    RANDOM_TEST(p, hpmv, F_SPMV) \
+    RANDOM_TEST(p, trmv, F_TRMV) \
+    RANDOM_TEST(p, tbmv, F_TBMV) \
+    RANDOM_TEST(p, tpmv, F_TPMV) \
+    RANDOM_TEST(p, trsv, F_TRSV) \
+    RANDOM_TEST(p, tbsv, F_TBSV) \
+    RANDOM_TEST(p, tpsv, F_TPSV) \
+    RANDOM_TEST(p, geru, F_GER) \
+    RANDOM_TEST(p, gerc, F_GERC) \
+    RANDOM_TEST(p, her, F_SYR) \
+    RANDOM_TEST(p, her2, F_SYR2) \
+    RANDOM_TEST(p, hpr, F_SPR) \
+    RANDOM_TEST(p, hpr2, F_SPR2)
+
+REAL_TESTS(s)
+REAL_TESTS(d)
+COMPLEX_TESTS(c)
+COMPLEX_TESTS(z)
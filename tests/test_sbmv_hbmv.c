@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "l2test.h"
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+/* A = [[2,1,0],[1,2,1],[0,1,2]], RowMajor Upper band rows 2 1 | 2 1 | 2 * */
+L2T_TEST(test_ssbmv_upper) {
+    float A[6] = {2.0f, 1.0f, 2.0f, 1.0f, 2.0f, 0.0f};
+    float x[3] = {1.0f, 1.0f, 1.0f};
+    float y[3] = {0.0f, 0.0f, 0.0f};
+
+    cblas_ssbmv(CblasRowMajor, CblasUpper, 3, 1, 1.0f, A, 2, x, 1,
+                0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 3.0f) < TOL_FLOAT &&
+          fabsf(y[1] - 4.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 3.0f) < TOL_FLOAT,
+          "ssbmv: tridiagonal, RowMajor upper");
+}
+
+/* A = [[1,2,0],[2,3,4],[0,4,5]], ColMajor Lower band columns 1 2 | 3 4 | 5 * */
+L2T_TEST(test_ssbmv_col_major_lower) {
+    float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 0.0f};
+    float x[3] = {1.0f, 2.0f, 3.0f};
+    float y[3] = {0.0f, 0.0f, 0.0f};
+
+    cblas_ssbmv(CblasColMajor, CblasLower, 3, 1, 1.0f, A, 2, x, 1,
+                0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 5.0f) < TOL_FLOAT &&
+          fabsf(y[1] - 20.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 23.0f) < TOL_FLOAT,
+          "ssbmv: ColMajor lower");
+}
+
+L2T_TEST(test_dsbmv_full_band_alpha_beta) {
+    /* A = [[1,2,6],[2,3,4],[6,4,5]], k = n-1, ColMajor Upper */
+    double A[9] = {0.0, 0.0, 1.0, 0.0, 2.0, 3.0, 6.0, 4.0, 5.0};
+    double x[3] = {1.0, 1.0, 1.0};
+    double y[3] = {1.0, 1.0, 1.0};
+
+    /* 0.5*[9,9,15] + 2*y */
+    cblas_dsbmv(CblasColMajor, CblasUpper, 3, 2, 0.5, A, 3, x, 1,
+                2.0, y, 1);
+
+    CHECK(fabs(y[0] - 6.5) < TOL_DOUBLE &&
+          fabs(y[1] - 6.5) < TOL_DOUBLE &&
+          fabs(y[2] - 9.5) < TOL_DOUBLE,
+          "dsbmv: k=n-1, alpha=0.5, beta=2");
+}
+
+L2T_TEST(test_dsbmv_neg_incx) {
+    double A[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 0.0};
+    double x[3] = {3.0, 2.0, 1.0};
+    double y[3] = {0.0, 0.0, 0.0};
+
+    cblas_dsbmv(CblasColMajor, CblasLower, 3, 1, 1.0, A, 2, x, -1,
+                0.0, y, 1);
+
+    CHECK(fabs(y[0] - 5.0) < TOL_DOUBLE &&
+          fabs(y[1] - 20.0) < TOL_DOUBLE &&
+          fabs(y[2] - 23.0) < TOL_DOUBLE,
+          "dsbmv: incx=-1");
+}
+
+/* A = [[2, 1-i],[1+i, 3]]: A * [1,1] = [3-i, 4+i] */
+L2T_TEST(test_chbmv_col_major_lower) {
+    float A[8] = {2.0f, 0.0f, 1.0f, 1.0f, 3.0f, 0.0f, 0.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 1.0f, 0.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2] = {0.0f, 0.0f};
+
+    cblas_chbmv(CblasColMajor, CblasLower, 2, 1, alpha, A, 2, x, 1,
+                beta, y, 1);
+
+    CHECK(fabsf(y[0] - 3.0f) < TOL_FLOAT && fabsf(y[1] + 1.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 4.0f) < TOL_FLOAT && fabsf(y[3] - 1.0f) < TOL_FLOAT,
+          "chbmv: ColMajor lower");
+}
+
+L2T_TEST(test_chbmv_row_major_upper) {
+    /* RowMajor Upper rows A00 A01 | A11 *; diagonal imaginary part ignored */
+    float A[8] = {2.0f, 5.0f, 1.0f, -1.0f, 3.0f, 0.0f, 0.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 1.0f, 0.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2] = {0.0f, 0.0f};
+
+    cblas_chbmv(CblasRowMajor, CblasUpper, 2, 1, alpha, A, 2, x, 1,
+                beta, y, 1);
+
+    CHECK(fabsf(y[0] - 3.0f) < TOL_FLOAT && fabsf(y[1] + 1.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 4.0f) < TOL_FLOAT && fabsf(y[3] - 1.0f) < TOL_FLOAT,
+          "chbmv: RowMajor upper, real diagonal");
+}
+
+L2T_TEST(test_zhbmv_complex_alpha) {
+    /* A = [[1, i],[-i, 1]], alpha = i: i * A * [1,0] = [i, 1] */
+    double A[8] = {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0};
+    double x[4] = {1.0, 0.0, 0.0, 0.0};
+    double y[4] = {7.0, 7.0, 7.0, 7.0};
+    double alpha[2] = {0.0, 1.0};
+    double beta[2] = {0.0, 0.0};
+
+    cblas_zhbmv(CblasColMajor, CblasUpper, 2, 1, alpha, A, 2, x, 1,
+                beta, y, 1);
+
+    CHECK(fabs(y[0]) < TOL_DOUBLE && fabs(y[1] - 1.0) < TOL_DOUBLE &&
+          fabs(y[2] - 1.0) < TOL_DOUBLE && fabs(y[3]) < TOL_DOUBLE,
+          "zhbmv: alpha=i, ColMajor upper");
+}
@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "l2test.h"
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+/* A = [[2,3],[3,4]]: RowMajor Upper packed is the rows 2 3 | 4 */
+L2T_TEST(test_sspmv_upper) {
+    float Ap[3] = {2.0f, 3.0f, 4.0f};
+    float x[2] = {1.0f, 1.0f};
+    float y[2] = {0.0f, 0.0f};
+
+    cblas_sspmv(CblasRowMajor, CblasUpper, 2,
+                1.0f, Ap, x, 1, 0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 5.0f) < TOL_FLOAT &&
+          fabsf(y[1] - 7.0f) < TOL_FLOAT,
+          "sspmv: 2x2 upper packed");
+}
+
+L2T_TEST(test_sspmv_lower) {
+    float Ap[3] = {2.0f, 3.0f, 4.0f};
+    float x[2] = {1.0f, 2.0f};
+    float y[2] = {0.0f, 0.0f};
+
+    cblas_sspmv(CblasRowMajor, CblasLower, 2,
+                1.0f, Ap, x, 1, 0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 8.0f)  < TOL_FLOAT &&
+          fabsf(y[1] - 11.0f) < TOL_FLOAT,
+          "sspmv: 2x2 lower packed");
+}
+
+L2T_TEST(test_sspmv_3x3) {
+    /* A = [[1,2,3],[2,4,5],[3,5,6]] */
+    float Ap[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    float x[3] = {1.0f, 1.0f, 1.0f};
+    float y[3] = {0.0f, 0.0f, 0.0f};
+
+    cblas_sspmv(CblasRowMajor, CblasUpper, 3,
+                1.0f, Ap, x, 1, 0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 6.0f)  < TOL_FLOAT &&
+          fabsf(y[1] - 11.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 14.0f) < TOL_FLOAT,
+          "sspmv: 3x3 upper packed");
+}
+
+L2T_TEST(test_sspmv_col_major) {
+    /* Same A; ColMajor Upper packs the columns 1 | 2 4 | 3 5 6 */
+    float Ap[6] = {1.0f, 2.0f, 4.0f, 3.0f, 5.0f, 6.0f};
+    float x[3] = {1.0f, 1.0f, 1.0f};
+    float y[3] = {0.0f, 0.0f, 0.0f};
+
+    cblas_sspmv(CblasColMajor, CblasUpper, 3,
+                1.0f, Ap, x, 1, 0.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 6.0f)  < TOL_FLOAT &&
+          fabsf(y[1] - 11.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 14.0f) < TOL_FLOAT,
+          "sspmv: 3x3 ColMajor upper packed");
+}
+
+L2T_TEST(test_sspmv_alpha_beta) {
+    float Ap[3] = {1.0f, 0.0f, 1.0f};
+    float x[2] = {1.0f, 1.0f};
+    float y[2] = {1.0f, 1.0f};
+
+    cblas_sspmv(CblasRowMajor, CblasUpper, 2,
+                2.0f, Ap, x, 1, 3.0f, y, 1);
+
+    CHECK(fabsf(y[0] - 5.0f) < TOL_FLOAT &&
+          fabsf(y[1] - 5.0f) < TOL_FLOAT,
+          "sspmv: alpha=2, beta=3");
+}
+
+L2T_TEST(test_sspmv_incx_incy) {
+    float Ap[3] = {2.0f, 3.0f, 4.0f};
+    float x[4] = {1.0f, 99.0f, 1.0f, 99.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    cblas_sspmv(CblasRowMajor, CblasUpper, 2,
+                1.0f, Ap, x, 2, 0.0f, y, 2);
+
+    CHECK(fabsf(y[0] - 5.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 7.0f) < TOL_FLOAT,
+          "sspmv: incx=2, incy=2");
+}
+
+L2T_TEST(test_dspmv_col_major_lower) {
+    /* A = [[1,2,3],[2,4,5],[3,5,6]], columns 1 2 3 | 4 5 | 6 */
+    double Ap[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    double x[3] = {1.0, 2.0, 3.0};
+    double y[3] = {0.0, 0.0, 0.0};
+
+    cblas_dspmv(CblasColMajor, CblasLower, 3,
+                1.0, Ap, x, 1, 0.0, y, 1);
+
+    CHECK(fabs(y[0] - 14.0) < TOL_DOUBLE &&
+          fabs(y[1] - 25.0) < TOL_DOUBLE &&
+          fabs(y[2] - 31.0) < TOL_DOUBLE,
+          "dspmv: 3x3 ColMajor lower packed");
+}
+
+L2T_TEST(test_dspmv_neg_incx) {
+    double Ap[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    double x[3] = {3.0, 2.0, 1.0};
+    double y[3] = {0.0, 0.0, 0.0};
+
+    cblas_dspmv(CblasColMajor, CblasLower, 3,
+                1.0, Ap, x, -1, 0.0, y, 1);
+
+    CHECK(fabs(y[0] - 14.0) < TOL_DOUBLE &&
+          fabs(y[1] - 25.0) < TOL_DOUBLE &&
+          fabs(y[2] - 31.0) < TOL_DOUBLE,
+          "dspmv: incx=-1");
+}
+
+/* A = [[2, 1+i],[1-i, 3]], x = [1, i]  ->  A*x = [1+i, 1+2i] */
+L2T_TEST(test_chpmv_upper) {
+    float Ap[6] = {2.0f, 0.0f, 1.0f, 1.0f, 3.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2] = {0.0f, 0.0f};
+
+    cblas_chpmv(CblasRowMajor, CblasUpper, 2,
+                alpha, Ap, x, 1, beta, y, 1);
+
+    CHECK(fabsf(y[0] - 1.0f) < TOL_FLOAT && fabsf(y[1] - 1.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 1.0f) < TOL_FLOAT && fabsf(y[3] - 2.0f) < TOL_FLOAT,
+          "chpmv: 2x2 upper packed");
+}
+
+L2T_TEST(test_chpmv_lower) {
+    float Ap[6] = {2.0f, 0.0f, 1.0f, -1.0f, 3.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2] = {0.0f, 0.0f};
+
+    cblas_chpmv(CblasRowMajor, CblasLower, 2,
+                alpha, Ap, x, 1, beta, y, 1);
+
+    CHECK(fabsf(y[0] - 1.0f) < TOL_FLOAT && fabsf(y[1] - 1.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 1.0f) < TOL_FLOAT && fabsf(y[3] - 2.0f) < TOL_FLOAT,
+          "chpmv: 2x2 lower packed");
+}
+
+L2T_TEST(test_chpmv_col_major) {
+    /* ColMajor Lower holds the same entries as RowMajor Upper, conjugated */
+    float Ap[6] = {2.0f, 0.0f, 1.0f, -1.0f, 3.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2] = {0.0f, 0.0f};
+
+    cblas_chpmv(CblasColMajor, CblasLower, 2,
+                alpha, Ap, x, 1, beta, y, 1);
+
+    CHECK(fabsf(y[0] - 1.0f) < TOL_FLOAT && fabsf(y[1] - 1.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 1.0f) < TOL_FLOAT && fabsf(y[3] - 2.0f) < TOL_FLOAT,
+          "chpmv: 2x2 ColMajor lower packed");
+}
+
+L2T_TEST(test_chpmv_imag_diagonal_ignored) {
+    float Ap[6] = {2.0f, 9.0f, 1.0f, 1.0f, 3.0f, -9.0f};
+    float x[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+    float beta[2] = {0.0f, 0.0f};
+
+    cblas_chpmv(CblasRowMajor, CblasUpper, 2,
+                alpha, Ap, x, 1, beta, y, 1);
+
+    CHECK(fabsf(y[0] - 1.0f) < TOL_FLOAT && fabsf(y[1] - 1.0f) < TOL_FLOAT &&
+          fabsf(y[2] - 1.0f) < TOL_FLOAT && fabsf(y[3] - 2.0f) < TOL_FLOAT,
+          "chpmv: imaginary part of diagonal ignored");
+}
+
+L2T_TEST(test_zhpmv_alpha_i) {
+    /* Same A, ColMajor Upper; alpha = i gives i*[1+i, 1+2i] */
+    double Ap[6] = {2.0, 0.0, 1.0, 1.0, 3.0, 0.0};
+    double x[4] = {1.0, 0.0, 0.0, 1.0};
+    double y[4] = {5.0, 5.0, 5.0, 5.0};
+    double alpha[2] = {0.0, 1.0};
+    double beta[2] = {0.0, 0.0};
+
+    cblas_zhpmv(CblasColMajor, CblasUpper, 2,
+                alpha, Ap, x, 1, beta, y, 1);
+
+    CHECK(fabs(y[0] + 1.0) < TOL_DOUBLE && fabs(y[1] - 1.0) < TOL_DOUBLE &&
+          fabs(y[2] + 2.0) < TOL_DOUBLE && fabs(y[3] - 1.0) < TOL_DOUBLE,
+          "zhpmv: alpha=i, beta=0");
+}
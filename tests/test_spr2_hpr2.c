@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "l2test.h"
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+L2T_TEST(test_sspr2_basic) {
+    /* x=[1,0], y=[0,1]: x*y^T + y*x^T = [[0,1],[1,0]] */
+    float Ap[3] = {0.0f, 0.0f, 0.0f};
+    float x[2] = {1.0f, 0.0f};
+    float y[2] = {0.0f, 1.0f};
+
+    cblas_sspr2(CblasRowMajor, CblasUpper, 2, 1.0f, x, 1, y, 1, Ap);
+
+    CHECK(fabsf(Ap[0]) < TOL_FLOAT &&
+          fabsf(Ap[1] - 1.0f) < TOL_FLOAT &&
+          fabsf(Ap[2]) < TOL_FLOAT,
+          "sspr2: basic 2x2 upper packed");
+}
+
+L2T_TEST(test_sspr2_col_major_lower) {
+    /* x=[1,2], y=[3,4]: x*y^T + y*x^T = [[6,10],[10,16]] */
+    float Ap[3] = {0.0f, 0.0f, 0.0f};
+    float x[2] = {1.0f, 2.0f};
+    float y[2] = {3.0f, 4.0f};
+
+    cblas_sspr2(CblasColMajor, CblasLower, 2, 1.0f, x, 1, y, 1, Ap);
+
+    CHECK(fabsf(Ap[0] - 6.0f)  < TOL_FLOAT &&
+          fabsf(Ap[1] - 10.0f) < TOL_FLOAT &&
+          fabsf(Ap[2] - 16.0f) < TOL_FLOAT,
+          "sspr2: ColMajor lower packed");
+}
+
+L2T_TEST(test_dspr2_alpha_inc) {
+    /* Logical y = [3,4] stored backwards; alpha=0.5 */
+    double Ap[3] = {1.0, 1.0, 1.0};
+    double x[4] = {1.0, 99.0, 2.0, 99.0};
+    double y[2] = {4.0, 3.0};
+
+    cblas_dspr2(CblasRowMajor, CblasUpper, 2, 0.5, x, 2, y, -1, Ap);
+
+    CHECK(fabs(Ap[0] - 4.0) < TOL_DOUBLE &&
+          fabs(Ap[1] - 6.0) < TOL_DOUBLE &&
+          fabs(Ap[2] - 9.0) < TOL_DOUBLE,
+          "dspr2: alpha=0.5, incx=2, incy=-1");
+}
+
+/* x=[1,i], y=[1,1]: x*y^H + y*x^H = [[2, 1-i],[1+i, 0]] */
+L2T_TEST(test_chpr2_col_major_upper) {
+    float Ap[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    float y[4] = {1.0f, 0.0f, 1.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+
+    cblas_chpr2(CblasColMajor, CblasUpper, 2, alpha, x, 1, y, 1, Ap);
+
+    CHECK(fabsf(Ap[0] - 2.0f) < TOL_FLOAT && fabsf(Ap[1]) < TOL_FLOAT &&
+          fabsf(Ap[2] - 1.0f) < TOL_FLOAT && fabsf(Ap[3] + 1.0f) < TOL_FLOAT &&
+          fabsf(Ap[4]) < TOL_FLOAT && fabsf(Ap[5]) < TOL_FLOAT,
+          "chpr2: ColMajor upper packed");
+}
+
+L2T_TEST(test_chpr2_row_major_lower) {
+    /* RowMajor Lower stores A(0,0) | A(1,0) A(1,1) */
+    float Ap[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    float y[4] = {1.0f, 0.0f, 1.0f, 0.0f};
+    float alpha[2] = {1.0f, 0.0f};
+
+    cblas_chpr2(CblasRowMajor, CblasLower, 2, alpha, x, 1, y, 1, Ap);
+
+    CHECK(fabsf(Ap[0] - 2.0f) < TOL_FLOAT && fabsf(Ap[1]) < TOL_FLOAT &&
+          fabsf(Ap[2] - 1.0f) < TOL_FLOAT && fabsf(Ap[3] - 1.0f) < TOL_FLOAT &&
+          fabsf(Ap[4]) < TOL_FLOAT && fabsf(Ap[5]) < TOL_FLOAT,
+          "chpr2: RowMajor lower packed");
+}
+
+L2T_TEST(test_zhpr2_complex_alpha) {
+    /* alpha=i, x=[1,0], y=[0,1]: [[0, i],[-i, 0]] */
+    double Ap[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    double x[4] = {1.0, 0.0, 0.0, 0.0};
+    double y[4] = {0.0, 0.0, 1.0, 0.0};
+    double alpha[2] = {0.0, 1.0};
+
+    cblas_zhpr2(CblasColMajor, CblasLower, 2, alpha, x, 1, y, 1, Ap);
+
+    CHECK(fabs(Ap[0]) < TOL_DOUBLE && fabs(Ap[1]) < TOL_DOUBLE &&
+          fabs(Ap[2]) < TOL_DOUBLE && fabs(Ap[3] + 1.0) < TOL_DOUBLE &&
+          fabs(Ap[4]) < TOL_DOUBLE && fabs(Ap[5]) < TOL_DOUBLE,
+          "zhpr2: alpha=i, ColMajor lower");
+}
@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "l2test.h"
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+/* x = [1,2]: x*x^T = [[1,2],[2,4]], packed 1 2 4 either way */
+L2T_TEST(test_sspr_upper) {
+    float Ap[3] = {0.0f, 0.0f, 0.0f};
+    float x[2] = {1.0f, 2.0f};
+
+    cblas_sspr(CblasRowMajor, CblasUpper, 2, 1.0f, x, 1, Ap);
+
+    CHECK(fabsf(Ap[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(Ap[1] - 2.0f) < TOL_FLOAT &&
+          fabsf(Ap[2] - 4.0f) < TOL_FLOAT,
+          "sspr: upper packed, x*x^T");
+}
+
+L2T_TEST(test_sspr_lower) {
+    float Ap[3] = {0.0f, 0.0f, 0.0f};
+    float x[2] = {1.0f, 2.0f};
+
+    cblas_sspr(CblasRowMajor, CblasLower, 2, 1.0f, x, 1, Ap);
+
+    CHECK(fabsf(Ap[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(Ap[1] - 2.0f) < TOL_FLOAT &&
+          fabsf(Ap[2] - 4.0f) < TOL_FLOAT,
+          "sspr: lower packed, x*x^T");
+}
+
+L2T_TEST(test_sspr_col_major_accumulate) {
+    /* A = ones + 2*x*x^T, x = [1,2,3], columns 1 | 2 4 | 3 6 9 */
+    float Ap[6] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+    float x[3] = {1.0f, 2.0f, 3.0f};
+    float expected[6] = {3.0f, 5.0f, 9.0f, 7.0f, 13.0f, 19.0f};
+    int ok = 1;
+
+    cblas_sspr(CblasColMajor, CblasUpper, 3, 2.0f, x, 1, Ap);
+    for (int i = 0; i < 6; i++)
+        if (fabsf(Ap[i] - expected[i]) > TOL_FLOAT) ok = 0;
+
+    CHECK(ok, "sspr: ColMajor upper, alpha=2, accumulate");
+}
+
+L2T_TEST(test_dspr_incx) {
+    double Ap[3] = {0.0, 0.0, 0.0};
+    double x[4] = {1.0, 99.0, 2.0, 99.0};
+
+    cblas_dspr(CblasRowMajor, CblasUpper, 2, 1.0, x, 2, Ap);
+
+    CHECK(fabs(Ap[0] - 1.0) < TOL_DOUBLE &&
+          fabs(Ap[1] - 2.0) < TOL_DOUBLE &&
+          fabs(Ap[2] - 4.0) < TOL_DOUBLE,
+          "dspr: incx=2");
+}
+
+L2T_TEST(test_dspr_neg_incx) {
+    /* Logical x = [1,2,3]; ColMajor Lower columns 1 2 3 | 4 6 | 9 */
+    double Ap[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    double x[3] = {3.0, 2.0, 1.0};
+    double expected[6] = {1.0, 2.0, 3.0, 4.0, 6.0, 9.0};
+    int ok = 1;
+
+    cblas_dspr(CblasColMajor, CblasLower, 3, 1.0, x, -1, Ap);
+    for (int i = 0; i < 6; i++)
+        if (fabs(Ap[i] - expected[i]) > TOL_DOUBLE) ok = 0;
+
+    CHECK(ok, "dspr: incx=-1");
+}
+
+/* x = [1, i]: x*x^H = [[1, -i],[i, 1]] */
+L2T_TEST(test_chpr_col_major_upper) {
+    float Ap[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+
+    cblas_chpr(CblasColMajor, CblasUpper, 2, 1.0f, x, 1, Ap);
+
+    CHECK(fabsf(Ap[0] - 1.0f) < TOL_FLOAT && fabsf(Ap[1]) < TOL_FLOAT &&
+          fabsf(Ap[2]) < TOL_FLOAT && fabsf(Ap[3] + 1.0f) < TOL_FLOAT &&
+          fabsf(Ap[4] - 1.0f) < TOL_FLOAT && fabsf(Ap[5]) < TOL_FLOAT,
+          "chpr: ColMajor upper, x*x^H");
+}
+
+L2T_TEST(test_chpr_row_major_upper) {
+    /* RowMajor Upper stores A(0,0) A(0,1) | A(1,1) */
+    float Ap[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+
+    cblas_chpr(CblasRowMajor, CblasUpper, 2, 1.0f, x, 1, Ap);
+
+    CHECK(fabsf(Ap[0] - 1.0f) < TOL_FLOAT && fabsf(Ap[1]) < TOL_FLOAT &&
+          fabsf(Ap[2]) < TOL_FLOAT && fabsf(Ap[3] + 1.0f) < TOL_FLOAT &&
+          fabsf(Ap[4] - 1.0f) < TOL_FLOAT && fabsf(Ap[5]) < TOL_FLOAT,
+          "chpr: RowMajor upper, x*x^H");
+}
+
+L2T_TEST(test_zhpr_lower_diagonal_real) {
+    /* Imaginary parts on the diagonal are cleared by the update */
+    double Ap[6] = {1.0, 5.0, 0.0, 0.0, 1.0, 7.0};
+    double x[4] = {1.0, 0.0, 0.0, 1.0};
+
+    cblas_zhpr(CblasColMajor, CblasLower, 2, 2.0, x, 1, Ap);
+
+    CHECK(fabs(Ap[0] - 3.0) < TOL_DOUBLE && fabs(Ap[1]) < TOL_DOUBLE &&
+          fabs(Ap[2]) < TOL_DOUBLE && fabs(Ap[3] - 2.0) < TOL_DOUBLE &&
+          fabs(Ap[4] - 3.0) < TOL_DOUBLE && fabs(Ap[5]) < TOL_DOUBLE,
+          "zhpr: ColMajor lower, alpha=2, real diagonal");
+}
@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_ssymv_identity(void) {
+L2T_TEST(test_ssymv_identity) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[2] = {1.0f, 2.0f};
     float y[2] = {0.0f, 0.0f};
@@ -28,7 +20,7 @@ void test_ssymv_identity(void) {
           "ssymv: identity upper, y=x");
 }
 
-void test_ssymv_diagonal(void) {
+L2T_TEST(test_ssymv_diagonal) {
     float A[4] = {3.0f, 0.0f, 0.0f, 5.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {0.0f, 0.0f};
@@ -41,7 +33,7 @@ void test_ssymv_diagonal(void) {
           "ssymv: diagonal 2x2");
 }
 
-void test_ssymv_off_diagonal(void) {
+L2T_TEST(test_ssymv_off_diagonal) {
     float A[4] = {2.0f, 3.0f, 0.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {0.0f, 0.0f};
@@ -54,7 +46,7 @@ void test_ssymv_off_diagonal(void) {
           "ssymv: off-diagonal 2x2 upper");
 }
 
-void test_ssymv_lower(void) {
+L2T_TEST(test_ssymv_lower) {
     float A[4] = {2.0f, 0.0f, 3.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {0.0f, 0.0f};
@@ -67,7 +59,7 @@ void test_ssymv_lower(void) {
           "ssymv: off-diagonal 2x2 lower");
 }
 
-void test_ssymv_alpha_beta(void) {
+L2T_TEST(test_ssymv_alpha_beta) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {1.0f, 1.0f};
@@ -80,7 +72,7 @@ void test_ssymv_alpha_beta(void) {
           "ssymv: alpha=2, beta=3");
 }
 
-void test_ssymv_incx_incy(void) {
+L2T_TEST(test_ssymv_incx_incy) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[4] = {1.0f, 99.0f, 2.0f, 99.0f};
     float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
@@ -93,7 +85,7 @@ void test_ssymv_incx_incy(void) {
           "ssymv: incx=2, incy=2");
 }
 
-void test_ssymv_3x3(void) {
+L2T_TEST(test_ssymv_3x3) {
     float A[9] = {
         1.0f, 2.0f, 3.0f,
         0.0f, 4.0f, 5.0f,
@@ -111,7 +103,7 @@ void test_ssymv_3x3(void) {
           "ssymv: 3x3 upper");
 }
 
-void test_dsymv_basic(void) {
+L2T_TEST(test_dsymv_basic) {
     double A[4] = {2.0, 3.0, 0.0, 4.0};
     double x[2] = {1.0, 1.0};
     double y[2] = {0.0, 0.0};
@@ -124,7 +116,7 @@ void test_dsymv_basic(void) {
           "dsymv: basic 2x2 upper");
 }
 
-void test_dsymv_lower(void) {
+L2T_TEST(test_dsymv_lower) {
     double A[4] = {2.0, 0.0, 3.0, 4.0};
     double x[2] = {1.0, 1.0};
     double y[2] = {0.0, 0.0};
@@ -137,7 +129,7 @@ void test_dsymv_lower(void) {
           "dsymv: basic 2x2 lower");
 }
 
-void test_dsymv_col_major(void) {
+L2T_TEST(test_dsymv_col_major) {
     double A[4] = {2.0, 3.0, 3.0, 4.0};
     double x[2] = {1.0, 1.0};
     double y[2] = {0.0, 0.0};
@@ -149,22 +141,3 @@ void test_dsymv_col_major(void) {
           fabs(y[1] - 7.0) < TOL_DOUBLE,
           "dsymv: ColMajor upper 2x2");
 }
-
-int main(void) {
-    printf("=== cblas_?symv interface tests ===\n\n");
-
-    test_ssymv_identity();
-    test_ssymv_diagonal();
-    test_ssymv_off_diagonal();
-    test_ssymv_lower();
-    test_ssymv_alpha_beta();
-    test_ssymv_incx_incy();
-    test_ssymv_3x3();
-
-    test_dsymv_basic();
-    test_dsymv_lower();
-    test_dsymv_col_major();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_ssyr_upper_basic(void) {
+L2T_TEST(test_ssyr_upper_basic) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 2.0f};
 
@@ -27,7 +19,7 @@ void test_ssyr_upper_basic(void) {
           "ssyr: upper A=0, alpha=1, x=|1,2|");
 }
 
-void test_ssyr_lower_basic(void) {
+L2T_TEST(test_ssyr_lower_basic) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 2.0f};
 
@@ -39,7 +31,7 @@ void test_ssyr_lower_basic(void) {
           "ssyr: lower A=0, alpha=1, x=|1,2|");
 }
 
-void test_ssyr_alpha(void) {
+L2T_TEST(test_ssyr_alpha) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 1.0f};
 
@@ -51,7 +43,7 @@ void test_ssyr_alpha(void) {
           "ssyr: alpha=3");
 }
 
-void test_ssyr_accumulate(void) {
+L2T_TEST(test_ssyr_accumulate) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[2] = {1.0f, 0.0f};
 
@@ -63,7 +55,7 @@ void test_ssyr_accumulate(void) {
           "ssyr: accumulate on identity");
 }
 
-void test_ssyr_incx(void) {
+L2T_TEST(test_ssyr_incx) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[4] = {1.0f, 99.0f, 3.0f, 99.0f};
 
@@ -75,7 +67,7 @@ void test_ssyr_incx(void) {
           "ssyr: incx=2");
 }
 
-void test_ssyr_3x3(void) {
+L2T_TEST(test_ssyr_3x3) {
     float A[9] = {0,0,0, 0,0,0, 0,0,0};
     float x[3] = {1.0f, 2.0f, 3.0f};
 
@@ -90,7 +82,7 @@ void test_ssyr_3x3(void) {
           "ssyr: 3x3 upper");
 }
 
-void test_ssyr_col_major(void) {
+L2T_TEST(test_ssyr_col_major) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 2.0f};
 
@@ -102,7 +94,7 @@ void test_ssyr_col_major(void) {
           "ssyr: ColMajor upper");
 }
 
-void test_dsyr_upper(void) {
+L2T_TEST(test_dsyr_upper) {
     double A[4] = {0.0, 0.0, 0.0, 0.0};
     double x[2] = {1.0, 2.0};
 
@@ -114,7 +106,7 @@ void test_dsyr_upper(void) {
           "dsyr: upper basic");
 }
 
-void test_dsyr_lower(void) {
+L2T_TEST(test_dsyr_lower) {
     double A[4] = {0.0, 0.0, 0.0, 0.0};
     double x[2] = {1.0, 2.0};
 
@@ -125,21 +117,3 @@ void test_dsyr_lower(void) {
           fabs(A[3] - 4.0) < TOL_DOUBLE,
           "dsyr: lower basic");
 }
-
-int main(void) {
-    printf("=== cblas_?syr interface tests ===\n\n");
-
-    test_ssyr_upper_basic();
-    test_ssyr_lower_basic();
-    test_ssyr_alpha();
-    test_ssyr_accumulate();
-    test_ssyr_incx();
-    test_ssyr_3x3();
-    test_ssyr_col_major();
-
-    test_dsyr_upper();
-    test_dsyr_lower();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
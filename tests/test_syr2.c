@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_ssyr2_upper_basic(void) {
+L2T_TEST(test_ssyr2_upper_basic) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 0.0f};
     float y[2] = {0.0f, 1.0f};
@@ -28,7 +20,7 @@ void test_ssyr2_upper_basic(void) {
           "ssyr2: upper A=0, e1,e2 vectors");
 }
 
-void test_ssyr2_upper_symmetric(void) {
+L2T_TEST(test_ssyr2_upper_symmetric) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 2.0f};
     float y[2] = {3.0f, 4.0f};
@@ -41,7 +33,7 @@ void test_ssyr2_upper_symmetric(void) {
           "ssyr2: upper x=|1,2|, y=|3,4|");
 }
 
-void test_ssyr2_lower(void) {
+L2T_TEST(test_ssyr2_lower) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 2.0f};
     float y[2] = {3.0f, 4.0f};
@@ -54,7 +46,7 @@ void test_ssyr2_lower(void) {
           "ssyr2: lower x=|1,2|, y=|3,4|");
 }
 
-void test_ssyr2_alpha(void) {
+L2T_TEST(test_ssyr2_alpha) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 0.0f};
     float y[2] = {0.0f, 1.0f};
@@ -65,7 +57,7 @@ void test_ssyr2_alpha(void) {
           "ssyr2: alpha=2");
 }
 
-void test_ssyr2_x_equals_y(void) {
+L2T_TEST(test_ssyr2_x_equals_y) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[2] = {1.0f, 1.0f};
     float y[2] = {1.0f, 1.0f};
@@ -78,7 +70,7 @@ void test_ssyr2_x_equals_y(void) {
           "ssyr2: x==y gives 2*syr result");
 }
 
-void test_ssyr2_accumulate(void) {
+L2T_TEST(test_ssyr2_accumulate) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[2] = {1.0f, 0.0f};
     float y[2] = {0.0f, 1.0f};
@@ -91,7 +83,7 @@ void test_ssyr2_accumulate(void) {
           "ssyr2: accumulate on identity");
 }
 
-void test_ssyr2_incx_incy(void) {
+L2T_TEST(test_ssyr2_incx_incy) {
     float A[4] = {0.0f, 0.0f, 0.0f, 0.0f};
     float x[4] = {1.0f, 99.0f, 2.0f, 99.0f};
     float y[4] = {3.0f, 99.0f, 4.0f, 99.0f};
@@ -104,7 +96,7 @@ void test_ssyr2_incx_incy(void) {
           "ssyr2: incx=2, incy=2");
 }
 
-void test_dsyr2_upper(void) {
+L2T_TEST(test_dsyr2_upper) {
     double A[4] = {0.0, 0.0, 0.0, 0.0};
     double x[2] = {1.0, 2.0};
     double y[2] = {3.0, 4.0};
@@ -117,7 +109,7 @@ void test_dsyr2_upper(void) {
           "dsyr2: upper basic");
 }
 
-void test_dsyr2_lower(void) {
+L2T_TEST(test_dsyr2_lower) {
     double A[4] = {0.0, 0.0, 0.0, 0.0};
     double x[2] = {1.0, 2.0};
     double y[2] = {3.0, 4.0};
@@ -129,21 +121,3 @@ void test_dsyr2_lower(void) {
           fabs(A[3] - 16.0) < TOL_DOUBLE,
           "dsyr2: lower basic");
 }
-
-int main(void) {
-    printf("=== cblas_?syr2 interface tests ===\n\n");
-
-    test_ssyr2_upper_basic();
-    test_ssyr2_upper_symmetric();
-    test_ssyr2_lower();
-    test_ssyr2_alpha();
-    test_ssyr2_x_equals_y();
-    test_ssyr2_accumulate();
-    test_ssyr2_incx_incy();
-
-    test_dsyr2_upper();
-    test_dsyr2_lower();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
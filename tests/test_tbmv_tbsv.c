@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "l2test.h"
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+/* A = [[1,2,0],[0,3,4],[0,0,5]], RowMajor Upper band rows 1 2 | 3 4 | 5 * */
+L2T_TEST(test_stbmv_upper_notrans) {
+    float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 0.0f};
+    float x[3] = {1.0f, 1.0f, 1.0f};
+
+    cblas_stbmv(CblasRowMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                3, 1, A, 2, x, 1);
+
+    CHECK(fabsf(x[0] - 3.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 7.0f) < TOL_FLOAT &&
+          fabsf(x[2] - 5.0f) < TOL_FLOAT,
+          "stbmv: upper, no-trans");
+}
+
+L2T_TEST(test_stbmv_upper_trans) {
+    float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 0.0f};
+    float x[3] = {1.0f, 1.0f, 1.0f};
+
+    cblas_stbmv(CblasRowMajor, CblasUpper, CblasTrans, CblasNonUnit,
+                3, 1, A, 2, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 5.0f) < TOL_FLOAT &&
+          fabsf(x[2] - 9.0f) < TOL_FLOAT,
+          "stbmv: upper, trans");
+}
+
+L2T_TEST(test_stbmv_lower_unit) {
+    /* L = [[1,0,0],[2,1,0],[0,3,1]]; stored diagonal (9) ignored */
+    float A[6] = {9.0f, 2.0f, 9.0f, 3.0f, 9.0f, 0.0f};
+    float x[3] = {1.0f, 1.0f, 1.0f};
+
+    cblas_stbmv(CblasColMajor, CblasLower, CblasNoTrans, CblasUnit,
+                3, 1, A, 2, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 3.0f) < TOL_FLOAT &&
+          fabsf(x[2] - 4.0f) < TOL_FLOAT,
+          "stbmv: ColMajor lower, unit diagonal");
+}
+
+L2T_TEST(test_dtbmv_full_band) {
+    /* A = [[1,2,3],[0,4,5],[0,0,6]], k = n-1, ColMajor Upper */
+    double A[9] = {0.0, 0.0, 1.0, 0.0, 2.0, 4.0, 3.0, 5.0, 6.0};
+    double x[3] = {1.0, 1.0, 1.0};
+
+    cblas_dtbmv(CblasColMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                3, 2, A, 3, x, 1);
+
+    CHECK(fabs(x[0] - 6.0) < TOL_DOUBLE &&
+          fabs(x[1] - 9.0) < TOL_DOUBLE &&
+          fabs(x[2] - 6.0) < TOL_DOUBLE,
+          "dtbmv: k=n-1, ColMajor upper");
+}
+
+L2T_TEST(test_ctbmv_conj_trans) {
+    /* L = [[1+i, 0],[2, i]], ColMajor Lower; L^H * [1,1] = [3-i, -i] */
+    float A[8] = {1.0f, 1.0f, 2.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 1.0f, 0.0f};
+
+    cblas_ctbmv(CblasColMajor, CblasLower, CblasConjTrans, CblasNonUnit,
+                2, 1, A, 2, x, 1);
+
+    CHECK(fabsf(x[0] - 3.0f) < TOL_FLOAT && fabsf(x[1] + 1.0f) < TOL_FLOAT &&
+          fabsf(x[2]) < TOL_FLOAT && fabsf(x[3] + 1.0f) < TOL_FLOAT,
+          "ctbmv: lower, conj-trans");
+}
+
+L2T_TEST(test_stbsv_upper_notrans) {
+    float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 0.0f};
+    float x[3] = {3.0f, 7.0f, 5.0f};
+
+    cblas_stbsv(CblasRowMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                3, 1, A, 2, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[2] - 1.0f) < TOL_FLOAT,
+          "stbsv: upper, no-trans");
+}
+
+L2T_TEST(test_stbsv_lower_trans) {
+    /* L = [[1,0,0],[2,3,0],[0,4,5]], L^T * [1,1,1] = [3,7,5] */
+    float A[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 0.0f};
+    float x[3] = {3.0f, 7.0f, 5.0f};
+
+    cblas_stbsv(CblasColMajor, CblasLower, CblasTrans, CblasNonUnit,
+                3, 1, A, 2, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[2] - 1.0f) < TOL_FLOAT,
+          "stbsv: ColMajor lower, trans");
+}
+
+L2T_TEST(test_dtbsv_unit_incx) {
+    /* U = [[1,2],[0,1]] with unit diagonal, U * [3,1] = [5,1] */
+    double A[4] = {0.0, 9.0, 2.0, 9.0};
+    double x[4] = {5.0, 99.0, 1.0, 99.0};
+
+    cblas_dtbsv(CblasColMajor, CblasUpper, CblasNoTrans, CblasUnit,
+                2, 1, A, 2, x, 2);
+
+    CHECK(fabs(x[0] - 3.0) < TOL_DOUBLE &&
+          fabs(x[2] - 1.0) < TOL_DOUBLE &&
+          fabs(x[1] - 99.0) < TOL_DOUBLE,
+          "dtbsv: upper, unit diagonal, incx=2");
+}
+
+L2T_TEST(test_ztbsv_lower) {
+    /* L = [[i,0],[1,2]], L * [1,1] = [i, 3] */
+    double A[8] = {0.0, 1.0, 1.0, 0.0, 2.0, 0.0, 0.0, 0.0};
+    double x[4] = {0.0, 1.0, 3.0, 0.0};
+
+    cblas_ztbsv(CblasColMajor, CblasLower, CblasNoTrans, CblasNonUnit,
+                2, 1, A, 2, x, 1);
+
+    CHECK(fabs(x[0] - 1.0) < TOL_DOUBLE && fabs(x[1]) < TOL_DOUBLE &&
+          fabs(x[2] - 1.0) < TOL_DOUBLE && fabs(x[3]) < TOL_DOUBLE,
+          "ztbsv: lower, complex diagonal");
+}
+
+L2T_TEST(test_dtbmv_tbsv_roundtrip) {
+    /* 5x5 RowMajor lower band, k = 2: tbsv undoes tbmv */
+    double A[15] = {0.0, 0.0, 2.0,  0.0, 1.0, 3.0,  -1.0, 0.5, 4.0,
+                    2.0, -2.0, 5.0,  1.0, 0.25, 3.0};
+    double x[5] = {1.0, -2.0, 3.0, 0.5, -1.5};
+    double x0[5] = {1.0, -2.0, 3.0, 0.5, -1.5};
+    int ok = 1;
+
+    cblas_dtbmv(CblasRowMajor, CblasLower, CblasNoTrans, CblasNonUnit,
+                5, 2, A, 3, x, 1);
+    cblas_dtbsv(CblasRowMajor, CblasLower, CblasNoTrans, CblasNonUnit,
+                5, 2, A, 3, x, 1);
+    for (int i = 0; i < 5; i++)
+        if (fabs(x[i] - x0[i]) > TOL_DOUBLE) ok = 0;
+
+    CHECK(ok, "dtbmv/dtbsv: solve undoes multiply");
+}
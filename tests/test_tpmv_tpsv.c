@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <cblas.h>
+#include "l2test.h"
+
+#define TOL_FLOAT  1e-5f
+#define TOL_DOUBLE 1e-10
+
+/* A = [[1,2],[0,3]]: RowMajor Upper packed is the rows 1 2 | 3 */
+L2T_TEST(test_stpmv_upper_notrans) {
+    float Ap[3] = {1.0f, 2.0f, 3.0f};
+    float x[2] = {1.0f, 1.0f};
+
+    cblas_stpmv(CblasRowMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                2, Ap, x, 1);
+
+    CHECK(fabsf(x[0] - 3.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 3.0f) < TOL_FLOAT,
+          "stpmv: upper, no-trans");
+}
+
+L2T_TEST(test_stpmv_upper_trans) {
+    float Ap[3] = {1.0f, 2.0f, 3.0f};
+    float x[2] = {1.0f, 1.0f};
+
+    cblas_stpmv(CblasRowMajor, CblasUpper, CblasTrans, CblasNonUnit,
+                2, Ap, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 5.0f) < TOL_FLOAT,
+          "stpmv: upper, trans");
+}
+
+L2T_TEST(test_stpmv_lower_unit) {
+    /* Stored diagonal (9) must be ignored with CblasUnit */
+    float Ap[3] = {9.0f, 2.0f, 9.0f};
+    float x[2] = {1.0f, 1.0f};
+
+    cblas_stpmv(CblasRowMajor, CblasLower, CblasNoTrans, CblasUnit,
+                2, Ap, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 3.0f) < TOL_FLOAT,
+          "stpmv: lower, unit diagonal");
+}
+
+L2T_TEST(test_dtpmv_col_major_upper) {
+    /* A = [[1,2,3],[0,4,5],[0,0,6]], columns 1 | 2 4 | 3 5 6 */
+    double Ap[6] = {1.0, 2.0, 4.0, 3.0, 5.0, 6.0};
+    double x[3] = {1.0, 1.0, 1.0};
+
+    cblas_dtpmv(CblasColMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                3, Ap, x, 1);
+
+    CHECK(fabs(x[0] - 6.0) < TOL_DOUBLE &&
+          fabs(x[1] - 9.0) < TOL_DOUBLE &&
+          fabs(x[2] - 6.0) < TOL_DOUBLE,
+          "dtpmv: 3x3 ColMajor upper");
+}
+
+L2T_TEST(test_dtpmv_col_major_lower_trans) {
+    /* L = [[1,0,0],[2,4,0],[3,5,6]], columns 1 2 3 | 4 5 | 6 */
+    double Ap[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    double x[3] = {1.0, 1.0, 1.0};
+
+    cblas_dtpmv(CblasColMajor, CblasLower, CblasTrans, CblasNonUnit,
+                3, Ap, x, 1);
+
+    CHECK(fabs(x[0] - 6.0) < TOL_DOUBLE &&
+          fabs(x[1] - 9.0) < TOL_DOUBLE &&
+          fabs(x[2] - 6.0) < TOL_DOUBLE,
+          "dtpmv: 3x3 ColMajor lower, trans");
+}
+
+L2T_TEST(test_ctpmv_conj_trans) {
+    /* A = [[1, i],[0, 2]], ColMajor Upper; A^H * [1,1] = [1, 2-i] */
+    float Ap[6] = {1.0f, 0.0f, 0.0f, 1.0f, 2.0f, 0.0f};
+    float x[4] = {1.0f, 0.0f, 1.0f, 0.0f};
+
+    cblas_ctpmv(CblasColMajor, CblasUpper, CblasConjTrans, CblasNonUnit,
+                2, Ap, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT && fabsf(x[1]) < TOL_FLOAT &&
+          fabsf(x[2] - 2.0f) < TOL_FLOAT && fabsf(x[3] + 1.0f) < TOL_FLOAT,
+          "ctpmv: upper, conj-trans");
+}
+
+L2T_TEST(test_stpsv_upper_notrans) {
+    float Ap[3] = {1.0f, 2.0f, 3.0f};
+    float x[2] = {3.0f, 3.0f};
+
+    cblas_stpsv(CblasRowMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                2, Ap, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 1.0f) < TOL_FLOAT,
+          "stpsv: upper, no-trans");
+}
+
+L2T_TEST(test_stpsv_lower_trans) {
+    /* L = [[2,0],[1,4]], L^T * [1,1] = [3,4] */
+    float Ap[3] = {2.0f, 1.0f, 4.0f};
+    float x[2] = {3.0f, 4.0f};
+
+    cblas_stpsv(CblasRowMajor, CblasLower, CblasTrans, CblasNonUnit,
+                2, Ap, x, 1);
+
+    CHECK(fabsf(x[0] - 1.0f) < TOL_FLOAT &&
+          fabsf(x[1] - 1.0f) < TOL_FLOAT,
+          "stpsv: lower, trans");
+}
+
+L2T_TEST(test_dtpsv_lower_unit) {
+    /* L = [[1,0,0],[2,1,0],[3,5,1]] with unit diagonal, L * [1,1,1] = [1,3,9] */
+    double Ap[6] = {9.0, 2.0, 3.0, 9.0, 5.0, 9.0};
+    double x[3] = {1.0, 3.0, 9.0};
+
+    cblas_dtpsv(CblasColMajor, CblasLower, CblasNoTrans, CblasUnit,
+                3, Ap, x, 1);
+
+    CHECK(fabs(x[0] - 1.0) < TOL_DOUBLE &&
+          fabs(x[1] - 1.0) < TOL_DOUBLE &&
+          fabs(x[2] - 1.0) < TOL_DOUBLE,
+          "dtpsv: 3x3 lower, unit diagonal");
+}
+
+L2T_TEST(test_dtpsv_incx) {
+    double Ap[3] = {1.0, 2.0, 3.0};
+    double x[4] = {3.0, 99.0, 3.0, 99.0};
+
+    cblas_dtpsv(CblasRowMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                2, Ap, x, 2);
+
+    CHECK(fabs(x[0] - 1.0) < TOL_DOUBLE &&
+          fabs(x[2] - 1.0) < TOL_DOUBLE &&
+          fabs(x[1] - 99.0) < TOL_DOUBLE,
+          "dtpsv: incx=2");
+}
+
+L2T_TEST(test_ztpsv_lower) {
+    /* L = [[i,0],[1,1]], L * [1,1] = [i, 2] */
+    double Ap[6] = {0.0, 1.0, 1.0, 0.0, 1.0, 0.0};
+    double x[4] = {0.0, 1.0, 2.0, 0.0};
+
+    cblas_ztpsv(CblasRowMajor, CblasLower, CblasNoTrans, CblasNonUnit,
+                2, Ap, x, 1);
+
+    CHECK(fabs(x[0] - 1.0) < TOL_DOUBLE && fabs(x[1]) < TOL_DOUBLE &&
+          fabs(x[2] - 1.0) < TOL_DOUBLE && fabs(x[3]) < TOL_DOUBLE,
+          "ztpsv: lower, complex diagonal");
+}
+
+L2T_TEST(test_dtpmv_tpsv_roundtrip) {
+    /* 4x4 upper, columns of (j+1) entries: tpsv undoes tpmv */
+    double Ap[10] = {2.0, 1.0, 3.0, -1.0, 0.5, 4.0, 2.0, -2.0, 1.0, 5.0};
+    double x[4] = {1.0, -2.0, 3.0, 0.5};
+    double x0[4] = {1.0, -2.0, 3.0, 0.5};
+    int ok = 1;
+
+    cblas_dtpmv(CblasColMajor, CblasUpper, CblasTrans, CblasNonUnit,
+                4, Ap, x, 1);
+    cblas_dtpsv(CblasColMajor, CblasUpper, CblasTrans, CblasNonUnit,
+                4, Ap, x, 1);
+    for (int i = 0; i < 4; i++)
+        if (fabs(x[i] - x0[i]) > TOL_DOUBLE) ok = 0;
+
+    CHECK(ok, "dtpmv/dtpsv: solve undoes multiply");
+}
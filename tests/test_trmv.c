@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_strmv_upper_notrans(void) {
+L2T_TEST(test_strmv_upper_notrans) {
     float A[4] = {2.0f, 3.0f, 0.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
 
@@ -27,7 +19,7 @@ void test_strmv_upper_notrans(void) {
           "strmv: upper NoTrans NonUnit");
 }
 
-void test_strmv_upper_trans(void) {
+L2T_TEST(test_strmv_upper_trans) {
     float A[4] = {2.0f, 3.0f, 0.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
 
@@ -39,7 +31,7 @@ void test_strmv_upper_trans(void) {
           "strmv: upper Trans NonUnit");
 }
 
-void test_strmv_lower_notrans(void) {
+L2T_TEST(test_strmv_lower_notrans) {
     float A[4] = {2.0f, 0.0f, 3.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
 
@@ -51,7 +43,7 @@ void test_strmv_lower_notrans(void) {
           "strmv: lower NoTrans NonUnit");
 }
 
-void test_strmv_unit_diagonal(void) {
+L2T_TEST(test_strmv_unit_diagonal) {
     float A[4] = {99.0f, 5.0f, 0.0f, 99.0f};
     float x[2] = {1.0f, 1.0f};
 
@@ -63,7 +55,7 @@ void test_strmv_unit_diagonal(void) {
           "strmv: upper NoTrans Unit");
 }
 
-void test_strmv_incx(void) {
+L2T_TEST(test_strmv_incx) {
     float A[4] = {1.0f, 0.0f, 0.0f, 1.0f};
     float x[4] = {3.0f, 99.0f, 4.0f, 99.0f};
 
@@ -75,7 +67,7 @@ void test_strmv_incx(void) {
           "strmv: incx=2");
 }
 
-void test_strmv_col_major(void) {
+L2T_TEST(test_strmv_col_major) {
     float A[4] = {2.0f, 0.0f, 3.0f, 4.0f};
     float x[2] = {1.0f, 1.0f};
 
@@ -87,7 +79,7 @@ void test_strmv_col_major(void) {
           "strmv: ColMajor upper NoTrans");
 }
 
-void test_dtrmv_upper(void) {
+L2T_TEST(test_dtrmv_upper) {
     double A[4] = {2.0, 3.0, 0.0, 4.0};
     double x[2] = {1.0, 1.0};
 
@@ -99,7 +91,7 @@ void test_dtrmv_upper(void) {
           "dtrmv: upper NoTrans NonUnit");
 }
 
-void test_dtrmv_lower(void) {
+L2T_TEST(test_dtrmv_lower) {
     double A[4] = {2.0, 0.0, 3.0, 4.0};
     double x[2] = {1.0, 1.0};
 
@@ -111,7 +103,7 @@ void test_dtrmv_lower(void) {
           "dtrmv: lower NoTrans NonUnit");
 }
 
-void test_ctrmv_upper(void) {
+L2T_TEST(test_ctrmv_upper) {
     float A[8] = {2,0, 1,1,  0,0, 3,0};
     float x[4] = {1,0, 0,1};
 
@@ -125,7 +117,7 @@ void test_ctrmv_upper(void) {
           "ctrmv: complex upper NoTrans");
 }
 
-void test_ztrmv_upper(void) {
+L2T_TEST(test_ztrmv_upper) {
     double A[8] = {2,0, 3,0,  0,0, 4,0};
     double x[4] = {1,0, 1,0};
 
@@ -136,23 +128,3 @@ void test_ztrmv_upper(void) {
           fabs(x[2] - 4.0) < TOL_DOUBLE,
           "ztrmv: double complex upper NoTrans");
 }
-
-int main(void) {
-    printf("=== cblas_?trmv interface tests ===\n\n");
-
-    test_strmv_upper_notrans();
-    test_strmv_upper_trans();
-    test_strmv_lower_notrans();
-    test_strmv_unit_diagonal();
-    test_strmv_incx();
-    test_strmv_col_major();
-
-    test_dtrmv_upper();
-    test_dtrmv_lower();
-
-    test_ctrmv_upper();
-    test_ztrmv_upper();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file
@@ -2,20 +2,12 @@
 #include <stdlib.h>
 #include <math.h>
 #include <cblas.h>
+#include "l2test.h"
 
 #define TOL_FLOAT  1e-5f
 #define TOL_DOUBLE 1e-10
 
-static int fail_count = 0;
-static int pass_count = 0;
-
-#define CHECK(cond, msg) \
-    do { \
-        if (cond) { printf("[PASS] %s\n", msg); pass_count++; } \
-        else      { printf("[FAIL] %s\n", msg); fail_count++; } \
-    } while(0)
-
-void test_strsv_upper_notrans(void) {
+L2T_TEST(test_strsv_upper_notrans) {
     float A[4] = {2.0f, 4.0f, 0.0f, 3.0f};
     float x[2] = {10.0f, 6.0f};
 
@@ -27,7 +19,7 @@ void test_strsv_upper_notrans(void) {
           "strsv: upper NoTrans NonUnit");
 }
 
-void test_strsv_lower_notrans(void) {
+L2T_TEST(test_strsv_lower_notrans) {
     float A[4] = {2.0f, 0.0f, 3.0f, 5.0f};
     float x[2] = {4.0f, 13.0f};
 
@@ -39,7 +31,7 @@ void test_strsv_lower_notrans(void) {
           "strsv: lower NoTrans NonUnit");
 }
 
-void test_strsv_upper_trans(void) {
+L2T_TEST(test_strsv_upper_trans) {
     float A[4] = {2.0f, 4.0f, 0.0f, 3.0f};
     float x[2] = {2.0f, 11.0f};
 
@@ -51,7 +43,7 @@ void test_strsv_upper_trans(void) {
           "strsv: upper Trans NonUnit");
 }
 
-void test_strsv_unit_diagonal(void) {
+L2T_TEST(test_strsv_unit_diagonal) {
     float A[4] = {99.0f, 2.0f, 0.0f, 99.0f};
     float x[2] = {5.0f, 3.0f};
 
@@ -63,7 +55,7 @@ void test_strsv_unit_diagonal(void) {
           "strsv: upper NoTrans Unit");
 }
 
-void test_strsv_incx(void) {
+L2T_TEST(test_strsv_incx) {
     float A[4] = {2.0f, 0.0f, 0.0f, 2.0f};
     float x[4] = {4.0f, 99.0f, 6.0f, 99.0f};
 
@@ -75,7 +67,7 @@ void test_strsv_incx(void) {
           "strsv: incx=2");
 }
 
-void test_strsv_3x3(void) {
+L2T_TEST(test_strsv_3x3) {
     float A[9] = {
         1.0f, 2.0f, 3.0f,
         0.0f, 1.0f, 2.0f,
@@ -92,7 +84,7 @@ void test_strsv_3x3(void) {
           "strsv: 3x3 upper NonUnit");
 }
 
-void test_dtrsv_upper(void) {
+L2T_TEST(test_dtrsv_upper) {
     double A[4] = {2.0, 4.0, 0.0, 3.0};
     double x[2] = {10.0, 6.0};
 
@@ -104,7 +96,7 @@ void test_dtrsv_upper(void) {
           "dtrsv: upper NoTrans NonUnit");
 }
 
-void test_dtrsv_lower(void) {
+L2T_TEST(test_dtrsv_lower) {
     double A[4] = {2.0, 0.0, 3.0, 5.0};
     double x[2] = {4.0, 13.0};
 
@@ -116,7 +108,7 @@ void test_dtrsv_lower(void) {
           "dtrsv: lower NoTrans NonUnit");
 }
 
-void test_ctrsv_upper(void) {
+L2T_TEST(test_ctrsv_upper) {
     float A[8] = {2,0, 0,0,  0,0, 2,0};
     float x[4] = {4,0, 6,0};
     float alpha[2] = {1.0f, 0.0f};
@@ -129,7 +121,7 @@ void test_ctrsv_upper(void) {
           "ctrsv: complex upper NoTrans");
 }
 
-void test_ztrsv_upper(void) {
+L2T_TEST(test_ztrsv_upper) {
     double A[8] = {3,0, 0,0,  0,0, 3,0};
     double x[4] = {6,0, 9,0};
 
@@ -140,23 +132,3 @@ void test_ztrsv_upper(void) {
           fabs(x[2] - 3.0) < TOL_DOUBLE,
           "ztrsv: double complex upper NoTrans");
 }
-
-int main(void) {
-    printf("=== cblas_?trsv interface tests ===\n\n");
-
-    test_strsv_upper_notrans();
-    test_strsv_lower_notrans();
-    test_strsv_upper_trans();
-    test_strsv_unit_diagonal();
-    test_strsv_incx();
-    test_strsv_3x3();
-
-    test_dtrsv_upper();
-    test_dtrsv_lower();
-
-    test_ctrsv_upper();
-    test_ztrsv_upper();
-
-    printf("\n=== Results: %d passed, %d failed ===\n", pass_count, fail_count);
-    return fail_count ? 1 : 0;
-}
\ No newline at end of file